@@ -111,6 +111,17 @@ extern "C" {
 #endif
 
 
+/** \brief  Compiler barrier
+ *    Keeps the compiler from moving memory accesses across it, e.g. the filling of
+ *    a buffer past the volatile index which publishes it to an interrupt handler.
+ */
+#if defined (__GNUC__) || defined (__ICCARM__)
+#define COMPILER_BARRIER() __asm volatile ("" : : : "memory")
+#else
+#define COMPILER_BARRIER() __asm("dmb")
+#endif
+
+
 /** \brief  Reverse byte order in a word.
  */
 #if defined (__GNUC__) || defined (__ICCARM__) || defined (__ghs__)
@@ -129,6 +140,25 @@ extern "C" {
                                 | ((a & 0xFF00U) >> 8U) | ((a & 0xFFU) << 8U))
 #endif
 
+/** \brief  Count the leading zero bits in a word (32 for a zero word).
+ */
+#if (defined (__GNUC__) && defined (__arm__)) || defined (__ICCARM__) || defined (__ghs__)
+#define COUNT_LEADING_ZEROS_32(a, b) __asm volatile ("clz %0, %1" : "=r" (b) : "r" (a))
+#elif defined (__GNUC__)
+/* GCC compatible compiler for another architecture: __builtin_clz(0) is undefined */
+#define COUNT_LEADING_ZEROS_32(a, b) ((b) = (((uint32_t)(a)) == 0U) ? 32U : (uint32_t)__builtin_clz((uint32_t)(a)))
+#else
+#define COUNT_LEADING_ZEROS_32(a, b) do { \
+                                         uint32_t clzWord = (a); \
+                                         (b) = 32U; \
+                                         while (clzWord != 0U) \
+                                         { \
+                                             clzWord >>= 1U; \
+                                             (b)--; \
+                                         } \
+                                     } while (0)
+#endif
+
 /** \brief  Places a function in RAM.
  */
 #if defined ( __GNUC__ )
@@ -82,6 +82,23 @@ CMD_BOOT_FAILURE is called the bit is erased. */
 activated. */
 #define CSEC_STATUS_INT_DEBUGGER      (0x80U)
 
+/*! @brief Number of bytes added by a seal operation to the plain text: the
+MAC followed by the IV. */
+#define CSEC_SEAL_OVERHEAD_SIZE       (32U)
+/*! @brief Maximum number of plain text bytes of a seal operation, so that the
+IV and the cipher text fit in CSE_PRAM together. */
+#define CSEC_SEAL_MAX_DATA_SIZE       (96U)
+
+/*! @brief Size of a random block of the RND pool, in bytes. */
+#define CSEC_RND_BLOCK_SIZE           (16U)
+
+/*! @brief Number of priority classes of the job queue. */
+#define CSEC_JOB_PRIORITY_COUNT       (3U)
+
+/*! @brief Number of message bytes sent to the CSEc by each command of a MAC
+session; all the commands but the last carry exactly this many bytes. */
+#define CSEC_MAC_CHUNK_SIZE           (112U)
+
 /*!
  * @brief Represents the status of the CSEc module. Provides one bit for each
  * status code as per SHE specification. CSEC_STATUS_* masks can be used for
@@ -174,6 +191,190 @@ typedef enum {
     CSEC_BOOT_NOT_DEFINED
 } csec_boot_flavor_t;
 
+/*!
+ * @brief RND pool low-water mark callback type.
+ *
+ * Invoked with the number of random blocks left in the pool.
+ *
+ * Implements : csec_rnd_pool_callback_t_Class
+ */
+typedef void (*csec_rnd_pool_callback_t)(uint32_t available, void *callbackParam);
+
+/*!
+ * @brief RND pool configuration.
+ *
+ * Implements : csec_rnd_pool_config_t_Class
+ */
+typedef struct {
+    uint8_t *blocks;                   /*!< Storage of the pool, of size * CSEC_RND_BLOCK_SIZE bytes */
+    uint32_t size;                     /*!< Number of random blocks kept ready */
+    uint32_t lowWaterMark;             /*!< Number of blocks left at which the callback is invoked */
+    csec_rnd_pool_callback_t callback; /*!< Low-water mark callback (may be NULL) */
+    void *callbackParam;               /*!< User parameter for the low-water mark callback */
+} csec_rnd_pool_config_t;
+
+/*!
+ * @brief RND pool statistics.
+ *
+ * Implements : csec_rnd_pool_stats_t_Class
+ */
+typedef struct {
+    uint32_t available;                /*!< Number of random blocks ready in the pool */
+    uint32_t hits;                     /*!< Requests served from the pool */
+    uint32_t misses;                   /*!< Requests which found the pool empty */
+    status_t refillStatus;             /*!< Status of the last refill command */
+} csec_rnd_pool_stats_t;
+
+/*!
+ * @brief RND pool state.
+ *
+ * @note The contents of this structure are internal to the driver and should not be
+ *      modified by users.
+ *
+ * Implements : csec_rnd_pool_t_Class
+ */
+typedef struct {
+    csec_rnd_pool_config_t config;     /*!< Pool configuration */
+    volatile uint32_t head;            /*!< Index of the next block to be taken */
+    volatile uint32_t count;           /*!< Number of blocks ready */
+    uint32_t hits;                     /*!< Requests served from the pool */
+    uint32_t misses;                   /*!< Requests which found the pool empty */
+    status_t refillStatus;             /*!< Status of the last refill command */
+} csec_rnd_pool_t;
+
+/*!
+ * @brief Priority classes of the job queue, from the most urgent.
+ *
+ * Implements : csec_job_priority_t_Class
+ */
+typedef enum {
+    CSEC_JOB_PRIORITY_HIGH = 0U,       /*!< E.g. verification of received messages */
+    CSEC_JOB_PRIORITY_NORMAL,          /*!< E.g. MAC generation of sent messages */
+    CSEC_JOB_PRIORITY_LOW              /*!< E.g. bulk encryption */
+} csec_job_priority_t;
+
+struct CsecJob;
+
+/*!
+ * @brief Job completion callback type.
+ *
+ * Invoked from the FTFC interrupt with the completed job, whose status field
+ * holds the error code of the job.
+ *
+ * Implements : csec_job_callback_t_Class
+ */
+typedef void (*csec_job_callback_t)(struct CsecJob *job, void *callbackParam);
+
+/*!
+ * @brief Job of the command queue.
+ *
+ * The fields up to callbackParam are filled in by the user before the job is
+ * submitted. The job is not copied: the structure and the buffers it points to
+ * must stay valid until the job completes.
+ *
+ * Implements : csec_job_t_Class
+ */
+typedef struct CsecJob {
+    csec_cmd_t cmd;               /*!< CSEC_CMD_ENC_ECB, CSEC_CMD_DEC_ECB, CSEC_CMD_ENC_CBC, CSEC_CMD_DEC_CBC,
+                                       CSEC_CMD_GENERATE_MAC or CSEC_CMD_VERIFY_MAC */
+    csec_key_id_t keyId;          /*!< Key used for the command */
+    csec_job_priority_t priority; /*!< Priority class of the job */
+    const uint8_t *input;         /*!< Plain/cipher text or message */
+    uint32_t length;              /*!< Size of the plain/cipher text in bytes (multiple of 16), or size of
+                                       the message in bits */
+    const uint8_t *iv;            /*!< Initialization vector (CBC mode only) */
+    uint8_t *output;              /*!< Cipher/plain text, or MAC for CSEC_CMD_GENERATE_MAC */
+    const uint8_t *mac;           /*!< MAC to be verified (CSEC_CMD_VERIFY_MAC only) */
+    uint16_t macLen;              /*!< Number of bits of the MAC to be verified (CSEC_CMD_VERIFY_MAC only) */
+    bool *verifStatus;            /*!< Result of the verification (CSEC_CMD_VERIFY_MAC only) */
+    csec_job_callback_t callback; /*!< Completion callback (may be NULL) */
+    void *callbackParam;          /*!< User parameter for the completion callback */
+    volatile status_t status;     /*!< STATUS_BUSY while the job is queued or in execution, then its error code */
+    struct CsecJob *next;         /*!< Next job of the same priority class (internal) */
+} csec_job_t;
+
+struct CsecMacSession;
+
+/*!
+ * @brief MAC session step completion callback type.
+ *
+ * Invoked from the FTFC interrupt when an update or the final step of the
+ * session completes, with its error code in the status field of the session.
+ *
+ * Implements : csec_mac_callback_t_Class
+ */
+typedef void (*csec_mac_callback_t)(struct CsecMacSession *session, void *callbackParam);
+
+/*!
+ * @brief Incremental MAC generation or verification.
+ *
+ * The callback fields are filled in by the user before the session is
+ * started; the other fields are internal to the driver. The structure must
+ * stay valid until the session ends.
+ *
+ * Implements : csec_mac_session_t_Class
+ */
+typedef struct CsecMacSession {
+    csec_mac_callback_t callback; /*!< Step completion callback (may be NULL) */
+    void *callbackParam;          /*!< User parameter for the step completion callback */
+    volatile status_t status;     /*!< STATUS_BUSY while a step is in execution, then its error code */
+    const uint8_t *input;         /*!< Message bytes of the update in execution */
+    uint32_t inputSize;           /*!< Number of bytes of the update in execution */
+    uint32_t inputIndex;          /*!< Number of bytes of the update already consumed */
+    uint8_t buffer[CSEC_MAC_CHUNK_SIZE]; /*!< Message bytes waiting for a full chunk, or for the final step */
+    uint32_t bufferLen;           /*!< Number of bytes in the buffer */
+    bool final;                   /*!< Specifies if the final step was started */
+} csec_mac_session_t;
+
+/*!
+ * @brief Image check completion callback type.
+ *
+ * Invoked by CSEC_DRV_RunImageCheck at the end of each verification of the
+ * image, with the error code of the verification and its result.
+ *
+ * Implements : csec_image_check_callback_t_Class
+ */
+typedef void (*csec_image_check_callback_t)(status_t status, bool verifStatus, void *callbackParam);
+
+/*!
+ * @brief Periodic image check configuration.
+ *
+ * Implements : csec_image_check_config_t_Class
+ */
+typedef struct {
+    csec_key_id_t keyId;          /*!< Key of the MAC, e.g. CSEC_BOOT_MAC_KEY */
+    const uint8_t *image;         /*!< Start of the image in flash */
+    uint32_t msgLen;              /*!< Size of the image in bits */
+    const uint8_t *mac;           /*!< Reference MAC of the image */
+    uint16_t macLen;              /*!< Number of bits of the MAC to be compared; 0 compares all 128 bits */
+    uint32_t sliceSize;           /*!< Maximum number of image bytes processed per call of CSEC_DRV_RunImageCheck */
+    uint32_t period;              /*!< Number of calls of CSEC_DRV_RunImageCheck between two verifications */
+    uint32_t maxCalls;            /*!< Maximum number of calls of CSEC_DRV_RunImageCheck a verification may
+                                       span before it is cancelled; 0 for no limit */
+    csec_image_check_callback_t callback; /*!< Verification completion callback (may be NULL) */
+    void *callbackParam;          /*!< User parameter for the verification completion callback */
+} csec_image_check_config_t;
+
+/*!
+ * @brief Periodic image check state.
+ *
+ * @note The contents of this structure are internal to the driver and should not be
+ *      modified by users.
+ *
+ * Implements : csec_image_check_t_Class
+ */
+typedef struct {
+    csec_image_check_config_t config; /*!< Check configuration */
+    csec_mac_session_t session;   /*!< MAC session of the verification in progress */
+    bool running;                 /*!< Specifies if a verification is in progress */
+    uint32_t offset;              /*!< Number of image bytes passed to the session */
+    uint32_t delay;               /*!< Number of calls left before the next verification */
+    uint32_t calls;               /*!< Number of calls spanned by the verification in progress */
+    bool verifStatus;             /*!< Result of the verification in progress */
+    uint32_t passed;              /*!< Number of verifications which matched the reference MAC */
+    uint32_t failed;              /*!< Number of verifications which did not match the reference MAC */
+} csec_image_check_t;
+
 /*!
  * @brief Internal driver state information.
  *
@@ -202,6 +403,14 @@ typedef struct {
     uint32_t macLen;              /*!< Specifies the number of bits of the MAC to be verified for a MAC verification command */
     security_callback_t callback; /*!< The callback invoked when an asynchronous command is completed */
     void *callbackParam;          /*!< User parameter for the command completion callback */
+    bool seal;                    /*!< Specifies if the command in execution is a step of a seal operation */
+    csec_rnd_pool_t *rndPool;     /*!< The RND pool refilled when the CSEc is idle */
+    volatile bool rndRefill;      /*!< Specifies if the command in execution is an RND pool refill */
+    csec_job_t *job;              /*!< The job in execution, if any */
+    csec_job_t *jobHead[CSEC_JOB_PRIORITY_COUNT]; /*!< First queued job of each priority class */
+    csec_job_t *jobTail[CSEC_JOB_PRIORITY_COUNT]; /*!< Last queued job of each priority class */
+    csec_mac_session_t *macSession; /*!< The open MAC session, if any */
+    bool addrMode;                /*!< Specifies if the command in execution uses the pointer method */
 } csec_state_t;
 
 
@@ -482,6 +691,36 @@ status_t CSEC_DRV_ExtendSeed(const uint8_t *entropy);
  */
 status_t CSEC_DRV_GenerateRND(uint8_t *rnd);
 
+/*!
+ * @brief Encrypts and authenticates a message in one operation.
+ *
+ * This function chains the RND, ENC_CBC and GENERATE_MAC commands: the plain
+ * text is encrypted in CBC mode under a fresh random IV, then the MAC of the IV
+ * followed by the cipher text is computed. The random IV is left by the RND
+ * command in CSE_PRAM where ENC_CBC expects it and the cipher text is left
+ * where GENERATE_MAC expects the end of the message, so only the plain text
+ * and the IV page are written between the commands. The random number
+ * generator has to be initialized by calling CSEC_DRV_InitRNG first.
+ *
+ * The payload is laid out as the MAC (16 bytes), the IV (16 bytes) and the
+ * cipher text (length bytes).
+ *
+ * @param[in] keyId KeyID used for the encryption and the MAC.
+ * @param[in] plainText Pointer to the plain text buffer.
+ * @param[in] length Number of bytes of plain text. It should be a non-zero
+ * multiple of 16 bytes, up to CSEC_SEAL_MAX_DATA_SIZE.
+ * @param[out] payload Pointer to the payload buffer, of length +
+ * CSEC_SEAL_OVERHEAD_SIZE bytes.
+ * @param[in] timeout Timeout in milliseconds.
+ * @return Error Code after command execution. Output parameters are valid if
+ * the error code is STATUS_SUCCESS.
+ */
+status_t CSEC_DRV_Seal(csec_key_id_t keyId,
+                       const uint8_t *plainText,
+                       uint32_t length,
+                       uint8_t *payload,
+                       uint32_t timeout);
+
 /*!
  * @brief Signals a failure detected during later stages of the boot process.
  *
@@ -730,6 +969,29 @@ status_t CSEC_DRV_VerifyMACAsync(csec_key_id_t keyId,
                                           uint16_t macLen,
                                           bool *verifStatus);
 
+/*!
+ * @brief Asynchronously encrypts and authenticates a message in one operation.
+ *
+ * This function performs the same operation as CSEC_DRV_Seal, in an
+ * asynchronous manner: each command is launched from the FTFC interrupt of the
+ * previous one. The callback is invoked once, after the GENERATE_MAC command,
+ * with CSEC_CMD_GENERATE_MAC as the completed command.
+ *
+ * @param[in] keyId KeyID used for the encryption and the MAC.
+ * @param[in] plainText Pointer to the plain text buffer.
+ * @param[in] length Number of bytes of plain text. It should be a non-zero
+ * multiple of 16 bytes, up to CSEC_SEAL_MAX_DATA_SIZE.
+ * @param[out] payload Pointer to the payload buffer, of length +
+ * CSEC_SEAL_OVERHEAD_SIZE bytes.
+ * @return STATUS_SUCCESS if the command was successfully launched, STATUS_BUSY if
+ * another command was already launched. CSEC_DRV_GetAsyncCmdStatus can be used
+ * in order to check the execution status.
+ */
+status_t CSEC_DRV_SealAsync(csec_key_id_t keyId,
+                            const uint8_t *plainText,
+                            uint32_t length,
+                            uint8_t *payload);
+
 /*!
  * @brief Checks the status of the execution of an asynchronous command.
  *
@@ -751,9 +1013,272 @@ void CSEC_DRV_InstallCallback(security_callback_t callbackFunc, void *callbackPa
 
 /*!
  * @brief Cancels a previously launched asynchronous command.
+ *
+ * If the command belongs to a queued job, the job completes with STATUS_ERROR,
+ * without invoking its callback, and the next queued job is started. An open
+ * MAC session ends the same way, even between two steps.
  */
 void CSEC_DRV_CancelCommand(void);
 
+/*!
+ * @brief Sets up a pool of random blocks refilled when the CSEc is idle.
+ *
+ * The pool keeps up to config->size blocks of 128 random bits ready, so that
+ * CSEC_DRV_TakeRND returns an IV or a nonce without waiting for the CSEc. The
+ * pool is refilled one RND command at a time from the FTFC interrupt, whenever
+ * no other command is in progress: after an asynchronous command completes,
+ * after a block is taken, and when CSEC_DRV_RefillRNDPool is called. A refill
+ * never makes another command fail: the driver functions wait for the RND
+ * command in execution, if any, and stop the refill until the CSEc is idle
+ * again.
+ *
+ * The random number generator has to be initialized by calling
+ * CSEC_DRV_InitRNG before the pool is set up. The filling starts right away.
+ *
+ * @param[in] pool Pointer to the pool state; it must stay valid while the
+ * driver is initialized.
+ * @param[in] config The pool configuration.
+ */
+void CSEC_DRV_InitRNDPool(csec_rnd_pool_t *pool,
+                          const csec_rnd_pool_config_t *config);
+
+/*!
+ * @brief Takes a block of 128 random bits from the RND pool.
+ *
+ * When the pool is empty, the block is generated by a CSEC_DRV_GenerateRND
+ * call and the request counts as a miss. The low-water mark callback is
+ * invoked when the blocks left in the pool reach the low-water mark, and the
+ * refill is started if the CSEc is idle.
+ *
+ * @param[out] rnd Pointer to a 128-bit buffer where the random bits are stored.
+ * @return STATUS_SUCCESS if the block was taken from the pool; the error code
+ * of CSEC_DRV_GenerateRND otherwise.
+ */
+status_t CSEC_DRV_TakeRND(uint8_t *rnd);
+
+/*!
+ * @brief Starts the refill of the RND pool if the CSEc is idle.
+ *
+ * Only needed after synchronous commands, or to resume after a failed refill
+ * command; the completion of the asynchronous commands resumes the refill.
+ */
+void CSEC_DRV_RefillRNDPool(void);
+
+/*!
+ * @brief Gets the statistics of the RND pool.
+ *
+ * @param[out] stats The number of blocks ready, the hits and misses of
+ * CSEC_DRV_TakeRND and the status of the last refill command.
+ */
+void CSEC_DRV_GetRNDPoolStats(csec_rnd_pool_stats_t *stats);
+
+/*!
+ * @brief Queues an encryption, decryption, MAC generation or MAC verification
+ * job.
+ *
+ * Instead of failing with STATUS_BUSY while another command is in progress,
+ * the job waits in the queue of its priority class. The jobs are started one
+ * after the other from the FTFC interrupt, without polling: the highest
+ * priority class first, in submission order within a class. A job in
+ * execution is never preempted, since the CSEc keeps the chaining state of
+ * its commands; split bulk data into several jobs to bound the wait of the
+ * urgent ones. Queued jobs are started before the RND pool refills, and the
+ * direct asynchronous functions return STATUS_BUSY while a job runs.
+ *
+ * The function can be called from any context, including the job callbacks.
+ * As for the other asynchronous functions, the synchronous driver functions
+ * must not be called while jobs are pending.
+ *
+ * @param[in] job The job to be queued; its status is set to STATUS_BUSY until
+ * it completes and its callback is invoked.
+ */
+void CSEC_DRV_SubmitJob(csec_job_t *job);
+
+/*!
+ * @brief Asynchronously calculates the MAC of a message stored in Flash memory
+ * using CMAC with AES-128.
+ *
+ * This function performs the same operation as CSEC_DRV_GenerateMACAddrMode,
+ * in an asynchronous manner. The CSEc reads the whole message in a single
+ * command, during which the Flash memory is not available to the CPU.
+ *
+ * @param[in] keyId KeyID used to perform the cryptographic operation.
+ * @param[in] msg Pointer to the message in Flash memory.
+ * @param[in] msgLen Number of bits of message on which CMAC will be computed.
+ * @param[out] cmac Pointer to the buffer containing the result of the CMAC
+ * computation.
+ * @return STATUS_SUCCESS if the command was successfully launched, STATUS_BUSY if
+ * another command was already launched. CSEC_DRV_GetAsyncCmdStatus can be used
+ * in order to check the execution status.
+ */
+status_t CSEC_DRV_GenerateMACAddrModeAsync(csec_key_id_t keyId,
+                                           const uint8_t *msg,
+                                           uint32_t msgLen,
+                                           uint8_t *cmac);
+
+/*!
+ * @brief Asynchronously verifies the MAC of a message stored in Flash memory
+ * using CMAC with AES-128.
+ *
+ * This function performs the same operation as CSEC_DRV_VerifyMACAddrMode,
+ * in an asynchronous manner. The CSEc reads the whole message in a single
+ * command, during which the Flash memory is not available to the CPU.
+ *
+ * @param[in] keyId KeyID used to perform the cryptographic operation.
+ * @param[in] msg Pointer to the message in Flash memory.
+ * @param[in] msgLen Number of bits of message on which CMAC will be computed.
+ * @param[in] mac Pointer to the buffer containing the CMAC to be verified.
+ * @param[in] macLen Number of bits of the CMAC to be compared. A macLength
+ * value of zero indicates that all 128-bits are compared.
+ * @param[out] verifStatus Status of MAC verification command (true:
+ * verification operation passed, false: verification operation failed).
+ * @return STATUS_SUCCESS if the command was successfully launched, STATUS_BUSY if
+ * another command was already launched. CSEC_DRV_GetAsyncCmdStatus can be used
+ * in order to check the execution status.
+ */
+status_t CSEC_DRV_VerifyMACAddrModeAsync(csec_key_id_t keyId,
+                                         const uint8_t *msg,
+                                         uint32_t msgLen,
+                                         const uint8_t *mac,
+                                         uint16_t macLen,
+                                         bool *verifStatus);
+
+/*!
+ * @brief Starts an incremental MAC generation.
+ *
+ * The message is then passed in pieces of any size with CSEC_DRV_UpdateMAC,
+ * and the MAC is obtained with CSEC_DRV_FinishGenerateMAC. The CSEc processes
+ * the message CSEC_MAC_CHUNK_SIZE bytes per command, launched from the FTFC
+ * interrupt, so the CPU and the Flash memory are never held for longer than
+ * one command. The pieces are read in place, so they may be located in Flash
+ * memory.
+ *
+ * The CSEc keeps the chaining state between the commands, so it is reserved
+ * for the session until it ends: the other driver functions return
+ * STATUS_BUSY, the queued jobs wait and the RND pool is not refilled.
+ *
+ * @param[in] session The session state; its callback fields must be set.
+ * @param[in] keyId KeyID used to perform the cryptographic operation.
+ * @param[in] msgLen Number of bits of the whole message; it must not be zero.
+ * @return STATUS_SUCCESS if the session was started, STATUS_BUSY if another
+ * command was already launched.
+ */
+status_t CSEC_DRV_InitGenerateMAC(csec_mac_session_t *session,
+                                  csec_key_id_t keyId,
+                                  uint32_t msgLen);
+
+/*!
+ * @brief Starts an incremental MAC verification.
+ *
+ * Works like CSEC_DRV_InitGenerateMAC; the MAC to be verified is passed to
+ * CSEC_DRV_FinishVerifyMAC.
+ *
+ * @param[in] session The session state; its callback fields must be set.
+ * @param[in] keyId KeyID used to perform the cryptographic operation.
+ * @param[in] msgLen Number of bits of the whole message; it must not be zero.
+ * @param[in] macLen Number of bits of the CMAC to be compared. A macLength
+ * value of zero indicates that all 128-bits are compared.
+ * @return STATUS_SUCCESS if the session was started, STATUS_BUSY if another
+ * command was already launched.
+ */
+status_t CSEC_DRV_InitVerifyMAC(csec_mac_session_t *session,
+                                csec_key_id_t keyId,
+                                uint32_t msgLen,
+                                uint16_t macLen);
+
+/*!
+ * @brief Passes the next piece of the message to a MAC session.
+ *
+ * The full chunks are processed from the FTFC interrupt. The bytes left over,
+ * and the chunk holding the end of the message, are copied in the session
+ * until the next step. The session status is STATUS_BUSY until the piece is
+ * consumed; the callback is invoked if any command was needed. The whole
+ * message must not exceed the size given when the session was started.
+ *
+ * @param[in] session The session state.
+ * @param[in] msg Pointer to the piece of the message; it must stay valid
+ * until the step completes.
+ * @param[in] length Number of bytes of the piece.
+ * @return STATUS_SUCCESS if the step was started, STATUS_BUSY if the previous
+ * step is still in execution, STATUS_ERROR if the session has ended.
+ */
+status_t CSEC_DRV_UpdateMAC(csec_mac_session_t *session,
+                            const uint8_t *msg,
+                            uint32_t length);
+
+/*!
+ * @brief Completes an incremental MAC generation and ends the session.
+ *
+ * The whole message must have been passed. The session status is STATUS_BUSY
+ * until the MAC is written, then the callback is invoked.
+ *
+ * @param[in] session The session state.
+ * @param[out] cmac Pointer to the buffer containing the result of the CMAC
+ * computation.
+ * @return STATUS_SUCCESS if the step was started, STATUS_BUSY if the previous
+ * step is still in execution, STATUS_ERROR if the session has ended.
+ */
+status_t CSEC_DRV_FinishGenerateMAC(csec_mac_session_t *session,
+                                    uint8_t *cmac);
+
+/*!
+ * @brief Completes an incremental MAC verification and ends the session.
+ *
+ * The whole message must have been passed. The session status is STATUS_BUSY
+ * until the verification status is written, then the callback is invoked.
+ *
+ * @param[in] session The session state.
+ * @param[in] mac Pointer to the buffer containing the CMAC to be verified.
+ * @param[out] verifStatus Status of MAC verification command (true:
+ * verification operation passed, false: verification operation failed).
+ * @return STATUS_SUCCESS if the step was started, STATUS_BUSY if the previous
+ * step is still in execution, STATUS_ERROR if the session has ended.
+ */
+status_t CSEC_DRV_FinishVerifyMAC(csec_mac_session_t *session,
+                                  const uint8_t *mac,
+                                  bool *verifStatus);
+
+/*!
+ * @brief Sets up the periodic verification of an image in Flash memory.
+ *
+ * The image is verified in the background by CSEC_DRV_RunImageCheck, in a
+ * MAC session of its own.
+ *
+ * The session holds the CSEc from the start of a verification to its end,
+ * across all the calls of CSEC_DRV_RunImageCheck in between, and not only
+ * while a slice is in execution: meanwhile, the other asynchronous functions
+ * return STATUS_BUSY, the synchronous functions must not be called, and the
+ * queued jobs and the RND pool refills wait. A verification spans about
+ * image size / config->sliceSize calls; set config->maxCalls to bound the
+ * time the CSEc is held. A verification reaching the bound is cancelled, the
+ * callback is invoked with STATUS_TIMEOUT and the next verification starts
+ * config->period calls later.
+ *
+ * @param[in] check Pointer to the check state; it must stay valid while the
+ * check runs.
+ * @param[in] config The check configuration.
+ */
+void CSEC_DRV_InitImageCheck(csec_image_check_t *check,
+                             const csec_image_check_config_t *config);
+
+/*!
+ * @brief Advances the periodic verification of an image.
+ *
+ * Meant to be called periodically, e.g. from a timer interrupt or a low
+ * priority task. Each call passes at most config->sliceSize bytes of the image
+ * to the session, which bounds the CPU time and the CSEc time spent per
+ * period; a call finding the previous slice still in execution does nothing.
+ * The CSEc is reserved from the first slice to the end of the verification:
+ * pick the slice size so that the image is verified in an acceptable time, and
+ * config->maxCalls to bound it (see CSEC_DRV_InitImageCheck).
+ * When the CSEc is busy, the verification starts on a later call. After each
+ * verification, the callback is invoked and the next one starts
+ * config->period calls later.
+ *
+ * @param[in] check Pointer to the check state.
+ */
+void CSEC_DRV_RunImageCheck(csec_image_check_t *check);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -258,6 +258,41 @@ typedef enum {
  */
 typedef void (*edma_callback_t)(void *parameter, edma_chn_status_t status);
 
+/*! @brief Latency class requested for a dynamically allocated channel.
+ *
+ * With fixed priority arbitration, the channel priority follows the channel number:
+ * the critical channels are taken from the top, the bulk ones from the bottom, and
+ * the normal ones from the middle downwards; the upper half goes to the normal
+ * channels only once the lower half is full.
+ * Implements : edma_latency_class_t_Class
+ */
+typedef enum {
+    EDMA_LATENCY_BULK = 0U,         /*!< Lowest priorities; preemptible, cannot preempt. */
+    EDMA_LATENCY_NORMAL,            /*!< Priorities from the middle downwards; preemptible, can preempt
+                                         the bulk channels. */
+    EDMA_LATENCY_CRITICAL           /*!< Highest priorities; not preemptible, can preempt the others. */
+} edma_latency_class_t;
+
+/*! @brief Activity counters of an eDMA channel.
+ *
+ * The transfers and bytes are counted in software from the major loop interrupts,
+ * with the size of the configured transfer. A scatter/gather list or a pooled
+ * chain counts as one transfer, on the interrupt of its last descriptor.
+ * Implements : edma_chn_stats_t_Class
+ */
+typedef struct {
+    uint32_t bytes;                      /*!< Bytes moved by the completed transfers. */
+    uint32_t transfers;                  /*!< Completed transfers. */
+    uint32_t errors;                     /*!< Channel errors. */
+    uint32_t busyTime;                   /*!< Time the channel had its requests enabled, in ticks of the
+                                              timestamp source (0 without timestamp source). */
+} edma_chn_stats_t;
+
+/*! @brief Free-running timestamp source of the channel accounting.
+ * Implements : edma_timestamp_t_Class
+ */
+typedef uint32_t (*edma_timestamp_t)(void);
+
 /*! @brief Data structure for the eDMA channel state.
  * Implements : edma_chn_state_t_Class
  */
@@ -268,6 +303,14 @@ typedef struct {
                                               error. */
     void *parameter;                     /*!< Parameter for the callback function pointer. */
     volatile edma_chn_status_t status;   /*!< eDMA channel status. */
+    struct EDMAStcdChain *stcdChain;     /*!< Pooled descriptor chain loaded in the channel (NULL if none). */
+    edma_chn_stats_t stats;              /*!< Activity counters. */
+    uint32_t busyStart;                  /*!< Timestamp of the start of the current busy period. */
+    bool busy;                           /*!< The requests of the channel are enabled. */
+    uint32_t transferBytes;              /*!< Bytes of the configured transfer (0: read from the TCD). */
+    uint16_t halfIterations;             /*!< Major count left at the half interrupt (0 if disabled). */
+    uint8_t transferInterrupts;          /*!< Major loop interrupts of the configured transfer. */
+    uint8_t interruptCount;              /*!< Major loop interrupts of the current transfer so far. */
 } edma_chn_state_t;
 
 /*!
@@ -322,6 +365,10 @@ typedef struct {
  */
 typedef struct {
     edma_chn_state_t * volatile virtChnState[(uint32_t)FEATURE_DMA_VIRTUAL_CHANNELS];   /*!< Pointer array storing channel state. */
+#ifdef FEATURE_DMA_SEPARATE_IRQ_LINES_PER_CHN
+    volatile bool coalescedIrq;                                                         /*!< Coalesced completion interrupt handling */
+    uint32_t coalescedChannels[(uint32_t)FEATURE_DMA_VIRTUAL_CHANNELS];                 /*!< Channels serviced by each line in coalesced mode */
+#endif
 } edma_state_t;
 
 /*!
@@ -418,6 +465,141 @@ typedef struct {
     #error "Endianness not defined!"
 #endif
 
+/*! @brief Events reported to the callback of a stream.
+ * Implements : edma_stream_event_t_Class
+ */
+typedef enum {
+    EDMA_STREAM_HALF_COMPLETE = 0U,         /*!< A half of the buffer was filled (or emptied) and is handed
+                                                 to the application. */
+    EDMA_STREAM_OVERRUN,                    /*!< The eDMA entered a half which was not released in time. */
+    EDMA_STREAM_ERROR                       /*!< An error occurred in the eDMA channel. */
+} edma_stream_event_t;
+
+/*! @brief Callback of a stream, called from the eDMA channel interrupt.
+ * Implements : edma_stream_callback_t_Class
+ */
+typedef void (*edma_stream_callback_t)(void *parameter, edma_stream_event_t event, uint8_t *half);
+
+/*!
+ * @brief Configuration of a double-buffered stream.
+ *
+ * The buffer holds two halves of halfSize bytes; the eDMA fills (or empties) one of
+ * them while the application processes the other.
+ * Implements : edma_stream_config_t_Class
+ */
+typedef struct {
+    uint32_t periphAddr;                    /*!< Peripheral data register. */
+    edma_transfer_size_t transferSize;      /*!< Size of the data register accesses. */
+    bool toPeripheral;                      /*!< Stream the buffer to the peripheral instead of capturing
+                                                 from it. */
+    uint8_t *buffer;                        /*!< Buffer of 2 * halfSize bytes. */
+    uint32_t halfSize;                      /*!< Size of a half, in bytes. */
+    edma_stream_callback_t callback;        /*!< Stream callback. */
+    void *callbackParam;                    /*!< Parameter passed to the stream callback. */
+} edma_stream_config_t;
+
+/*!
+ * @brief Runtime information of a stream.
+ *
+ * @note The contents of this structure are internal to the driver, except overruns,
+ *      and should not be modified by users.
+ * Implements : edma_stream_t_Class
+ */
+typedef struct {
+    uint8_t virtChn;                        /*!< Virtual channel of the stream. */
+    uint8_t *buffer;                        /*!< Buffer of the stream. */
+    uint32_t halfSize;                      /*!< Size of a half, in bytes. */
+    uint32_t halfCount;                     /*!< Major loop iterations of a half. */
+    volatile uint8_t owned;                 /*!< Bit n set while half n is held by the application. */
+    volatile uint8_t nextHalf;              /*!< Half expected to complete next. */
+    volatile uint32_t overruns;             /*!< Number of overruns. */
+    edma_stream_callback_t callback;        /*!< Stream callback. */
+    void *callbackParam;                    /*!< Parameter passed to the stream callback. */
+} edma_stream_t;
+
+/*! @brief Maximum number of descriptors in a software TCD pool */
+#define EDMA_STCD_POOL_MAX_SIZE     32U
+
+/*!
+ * @brief Pool of 32-byte aligned software TCDs.
+ *
+ * @note The contents of this structure are internal to the driver and should not
+ *      be modified by users.
+ * Implements : edma_stcd_pool_t_Class
+ */
+typedef struct {
+    edma_software_tcd_t *stcds;             /*!< Aligned descriptors of the pool. */
+    uint8_t count;                          /*!< Number of descriptors. */
+    volatile uint32_t freeMask;             /*!< Bit n set while descriptor n is free. */
+} edma_stcd_pool_t;
+
+/*!
+ * @brief Chain of software TCDs taken from a pool.
+ *
+ * The descriptors of a chain are contiguous in the pool and linked through their
+ * scatter/gather address. A chain is built once and re-armed by patching its
+ * addresses; when releaseOnComplete is set, the descriptors go back to the pool
+ * from the interrupt of the last one.
+ * Implements : edma_stcd_chain_t_Class
+ */
+typedef struct EDMAStcdChain {
+    edma_stcd_pool_t *pool;                 /*!< Pool the descriptors come from. */
+    edma_software_tcd_t *stcds;             /*!< First descriptor of the chain. */
+    uint8_t first;                          /*!< Index of the first descriptor in the pool. */
+    uint8_t count;                          /*!< Number of descriptors (0 when the chain is free). */
+    bool releaseOnComplete;                 /*!< Give the descriptors back to the pool when the chain
+                                                 completes. */
+} edma_stcd_chain_t;
+
+/*! @brief Marks a pipeline stage which does not start another stage */
+#define EDMA_PIPELINE_NO_LINK       0xFFU
+
+/*!
+ * @brief eDMA pipeline stage configuration.
+ *
+ * Each stage of a pipeline runs on its own channel. A stage is started by its DMA
+ * request source and by the channel links of the other stages; the links name the
+ * stages by their index in the stage array, the channels being assigned when the
+ * pipeline is built.
+ * Implements : edma_pipeline_stage_t_Class
+ */
+typedef struct {
+    uint32_t srcAddr;                       /*!< Source address of the stage. */
+    uint32_t destAddr;                      /*!< Destination address of the stage. */
+    edma_transfer_size_t srcTransferSize;   /*!< Source data transfer size. */
+    edma_transfer_size_t destTransferSize;  /*!< Destination data transfer size. */
+    int16_t srcOffset;                      /*!< Offset applied to the source address after each read. */
+    int16_t destOffset;                     /*!< Offset applied to the destination address after each write. */
+    int32_t srcLastAddrAdjust;              /*!< Source address adjustment on major loop completion. */
+    int32_t destLastAddrAdjust;             /*!< Destination address adjustment on major loop completion. */
+    edma_modulo_t srcModulo;                /*!< Source address modulo (ring buffer size). */
+    edma_modulo_t destModulo;               /*!< Destination address modulo (ring buffer size). */
+    uint32_t minorByteTransferCount;        /*!< Number of bytes moved each time the stage is started. */
+    uint32_t majorLoopIterationCount;       /*!< Number of minor loops in the major loop. */
+    dma_request_source_t source;            /*!< DMA request starting the stage; EDMA_REQ_DISABLED for the
+                                                 stages started by channel links only. */
+    uint8_t minorLinkStage;                 /*!< Stage started when a minor loop completes, except the last
+                                                 one of the major loop, or EDMA_PIPELINE_NO_LINK. */
+    uint8_t majorLinkStage;                 /*!< Stage started when the major loop completes, or
+                                                 EDMA_PIPELINE_NO_LINK. */
+    bool disableReqOnCompletion;            /*!< Disable the DMA request of the stage when the major loop
+                                                 completes. */
+    bool interruptEnable;                   /*!< Enable the interrupt request when the major loop completes. */
+} edma_pipeline_stage_t;
+
+/*!
+ * @brief Runtime information of an eDMA pipeline.
+ *
+ * @note The contents of this structure are filled by EDMA_DRV_BuildPipeline and
+ *      should not be modified by users.
+ * Implements : edma_pipeline_t_Class
+ */
+typedef struct {
+    const edma_pipeline_stage_t *stages;            /*!< Stages of the pipeline. */
+    uint8_t stageCount;                             /*!< Number of stages. */
+    uint8_t virtChannels[FEATURE_DMA_CHANNELS];     /*!< Virtual channel running each stage. */
+} edma_pipeline_t;
+
 /*******************************************************************************
  * API
  ******************************************************************************/
@@ -496,6 +678,29 @@ status_t EDMA_DRV_Deinit(void);
 status_t EDMA_DRV_ChannelInit(edma_chn_state_t *edmaChannelState,
                               const edma_channel_config_t *edmaChannelConfig);
 
+/*!
+ * @brief Allocates a free eDMA channel according to a latency class.
+ *
+ * Instead of a channel number fixed in the configuration, the driver picks a free
+ * channel whose priority matches the latency class, configures its preemption
+ * (ECP/DPA) and initializes it as EDMA_DRV_ChannelInit does. The priorities only
+ * matter with fixed priority channel arbitration, which must keep the default
+ * priority of each channel (its number).
+ *
+ * @param edmaChannelState Pointer to the eDMA channel state structure; the memory must
+ * be kept valid until the channel is released.
+ * @param edmaChannelConfig Channel configuration; virtChnConfig and channelPriority
+ * are not used.
+ * @param latency Latency class of the channel.
+ * @param virtualChannel Receives the allocated virtual channel.
+ *
+ * @return STATUS_SUCCESS if successful; STATUS_BUSY if no channel is free.
+ */
+status_t EDMA_DRV_AllocChannel(edma_chn_state_t *edmaChannelState,
+                               const edma_channel_config_t *edmaChannelConfig,
+                               edma_latency_class_t latency,
+                               uint8_t *virtualChannel);
+
 /*!
  * @brief Releases an eDMA channel.
  *
@@ -696,7 +901,9 @@ status_t EDMA_DRV_StartChannel(uint8_t virtualChannel);
 /*!
  * @brief Stops the eDMA channel.
  *
- * This function disables the eDMA channel DMA request.
+ * This function disables the eDMA channel DMA request. A chain of pooled
+ * descriptors loaded in the channel is detached from it and no longer released
+ * on completion; the caller frees it with EDMA_DRV_FreeSTCDChain.
  *
  * @param virtualChannel eDMA virtual channel number.
  *
@@ -928,12 +1135,304 @@ status_t EDMA_DRV_InstallCallback(uint8_t virtualChannel,
                                   edma_callback_t callback,
                                   void *parameter);
 
+#ifdef FEATURE_DMA_SEPARATE_IRQ_LINES_PER_CHN
+/*!
+ * @brief Enables or disables the coalesced completion interrupt handling.
+ *
+ * By default, each channel interrupt line services its own channel only, so
+ * channels which complete close together enter the interrupt handler once each.
+ * In coalesced mode, the first channel interrupt taken reads the interrupt
+ * request register once and services, in a single pass and in ascending channel
+ * order, every requesting channel of the eDMA instance whose interrupt line has
+ * the priority of its own line. The flag and then the pending interrupt of each
+ * channel serviced this way are cleared, so it doesn't enter the handler again;
+ * a channel which completes after the register was read raises its own
+ * interrupt as usual.
+ *
+ * Since the lines of a group share a priority, none of them preempts another:
+ * each callback runs at the priority of its own channel line, and a channel is
+ * never serviced twice. A channel line of a higher priority is taken before the
+ * line of a lower one, and services its own group.
+ *
+ * The priorities of the channel lines are read by this function: enable the
+ * coalesced handling again after changing them.
+ *
+ * On a Cortex-M4, each interrupt taken back to back costs a tail-chain of 6
+ * cycles, plus the prologue and the dispatch of the handler, while each
+ * coalesced channel costs a write to the NVIC, and the pass a read of the
+ * interrupt request register: the coalescing pays off from 3 channels
+ * completing together (see test/edma_bench.c).
+ *
+ * @param enable Enables (true) or disables (false) the coalesced handling.
+ */
+void EDMA_DRV_SetCoalescedInterrupts(bool enable);
+#endif
+
+/*! @} */
+
+/*!
+  * @name eDMA double-buffered streaming functions
+  * @{
+  */
+
+/*!
+ * @brief Starts a double-buffered stream on a channel.
+ *
+ * The channel moves one data register access per DMA request, cycling over the two
+ * halves of the buffer with no gap: the half and major loop interrupts hand the
+ * completed half to the application through the EDMA_STREAM_HALF_COMPLETE event,
+ * while the eDMA goes on with the other half. The application gives a half back with
+ * EDMA_DRV_ReleaseStreamHalf; if the eDMA enters a half which was not released, or
+ * a half completion is missed because the interrupt was serviced too late, an
+ * EDMA_STREAM_OVERRUN event is reported. A half overwritten this way stays with the
+ * application until it is released, and is not handed over again meanwhile.
+ * The stream replaces the channel callback.
+ *
+ * @param virtualChannel eDMA virtual channel number.
+ * @param stream Pointer to the stream runtime structure; it must be kept valid until
+ * the stream is stopped.
+ * @param config The stream configuration.
+ *
+ * @return STATUS_SUCCESS if successful; STATUS_ERROR if the buffer is not aligned on
+ * the transfer size or its halves are too large for the major loop count.
+ */
+status_t EDMA_DRV_StartStream(uint8_t virtualChannel,
+                              edma_stream_t *stream,
+                              const edma_stream_config_t *config);
+
+/*!
+ * @brief Gives a half of the stream buffer back to the eDMA.
+ *
+ * Each EDMA_STREAM_HALF_COMPLETE event is answered by exactly one release.
+ *
+ * @param stream Pointer to the stream runtime structure.
+ * @param half The half, as reported by the EDMA_STREAM_HALF_COMPLETE event.
+ */
+void EDMA_DRV_ReleaseStreamHalf(edma_stream_t *stream,
+                                const uint8_t *half);
+
+/*!
+ * @brief Stops a stream.
+ *
+ * Disables the requests of the channel and removes the stream callback.
+ *
+ * @param virtualChannel eDMA virtual channel number.
+ *
+ * @return STATUS_SUCCESS.
+ */
+status_t EDMA_DRV_StopStream(uint8_t virtualChannel);
+
+/*! @} */
+
+/*!
+  * @name eDMA software TCD pool functions
+  * @{
+  */
+
+/*!
+ * @brief Initializes a pool of software TCDs.
+ *
+ * The descriptors are carved from the buffer once, aligned on 32 bytes, so that
+ * the alignment slack is paid per pool instead of per transfer. A buffer of
+ * STCD_SIZE(n + 1U) bytes holds n descriptors whatever its alignment.
+ *
+ * @param pool Pointer to the pool structure.
+ * @param buffer Memory of the descriptors; it must be kept valid while the pool is used.
+ * @param bufferSize Size of the buffer, in bytes.
+ */
+void EDMA_DRV_InitSTCDPool(edma_stcd_pool_t *pool,
+                           void *buffer,
+                           uint32_t bufferSize);
+
+/*!
+ * @brief Takes a chain of contiguous descriptors from a pool.
+ *
+ * @param pool Pointer to the pool structure.
+ * @param chain Pointer to the chain structure receiving the descriptors.
+ * @param count Number of descriptors of the chain.
+ *
+ * @return STATUS_SUCCESS if successful; STATUS_BUSY if the pool has no room for
+ * the chain.
+ */
+status_t EDMA_DRV_AllocSTCDChain(edma_stcd_pool_t *pool,
+                                 edma_stcd_chain_t *chain,
+                                 uint8_t count);
+
+/*!
+ * @brief Gives the descriptors of a chain back to their pool.
+ *
+ * The chain must not be loaded in a running channel. A stopped channel still
+ * holding the chain is detached from it.
+ *
+ * @param chain Pointer to the chain structure.
+ */
+void EDMA_DRV_FreeSTCDChain(edma_stcd_chain_t *chain);
+
+/*!
+ * @brief Configures a scatter/gather transfer on a chain of pooled descriptors.
+ *
+ * Builds one descriptor per memory block, as EDMA_DRV_ConfigScatterGatherTransfer
+ * does, and loads the first one in the channel. Only the last descriptor raises an
+ * interrupt; on it, the channel callback is called and, if releaseOnComplete is
+ * set, the chain goes back to the pool.
+ *
+ * @param virtualChannel eDMA virtual channel number.
+ * @param chain Chain allocated with one descriptor per memory block.
+ * @param transferSize The number of bytes to be transferred on every DMA write/read.
+ * @param bytesOnEachRequest Bytes to be transferred in each DMA request.
+ * @param srcList Address, length and type of the source memory blocks.
+ * @param destList Address, length and type of the destination memory blocks.
+ *
+ * @return STATUS_ERROR or STATUS_SUCCESS
+ */
+status_t EDMA_DRV_ConfigPooledScatterGather(uint8_t virtualChannel,
+                                            edma_stcd_chain_t *chain,
+                                            edma_transfer_size_t transferSize,
+                                            uint32_t bytesOnEachRequest,
+                                            const edma_scatter_gather_list_t *srcList,
+                                            const edma_scatter_gather_list_t *destList);
+
+/*!
+ * @brief Re-arms a chain of pooled descriptors for a transfer of the same shape.
+ *
+ * Only the source and destination addresses of the descriptors are patched, then
+ * the first descriptor is loaded in the channel again. The previous transfer of the
+ * chain must be complete. Configuring the channel for another transfer, or stopping
+ * it, detaches the chain from the channel.
+ *
+ * @param virtualChannel eDMA virtual channel number.
+ * @param chain Chain configured by EDMA_DRV_ConfigPooledScatterGather.
+ * @param srcAddrs New source address of each descriptor, or NULL to keep them.
+ * @param destAddrs New destination address of each descriptor, or NULL to keep them.
+ *
+ * @return STATUS_ERROR if the chain was released; STATUS_SUCCESS otherwise.
+ */
+status_t EDMA_DRV_RearmSTCDChain(uint8_t virtualChannel,
+                                 edma_stcd_chain_t *chain,
+                                 const uint32_t *srcAddrs,
+                                 const uint32_t *destAddrs);
+
+/*! @} */
+
+/*!
+  * @name eDMA channel-linking pipeline functions
+  * @{
+  */
+
+/*!
+ * @brief Computes the software TCDs of a pipeline.
+ *
+ * Validates the stages and translates each of them into a TCD, the stage links
+ * becoming the minor loop (CITER/BITER ELINK) and major loop (CSR MAJORELINK)
+ * channel links. The following constraints are checked: valid transfer sizes;
+ * addresses, offsets and last adjustments aligned on the transfer size; minor byte
+ * count multiple of both transfer sizes; modulo range at least as large as the
+ * transfer size and the offset, and address aligned on it; major loop count fitting
+ * the CITER field (511 with a minor link, 32767 without); links naming existing
+ * stages. The driver state is not used, so the TCDs can be computed and checked
+ * off-target.
+ *
+ * @param stages The stages of the pipeline.
+ * @param stageCount Number of stages (at most FEATURE_DMA_CHANNELS).
+ * @param channels The eDMA channel (within the eDMA instance) running each stage.
+ * @param stcds Array of stageCount software TCDs receiving the result.
+ *
+ * @return STATUS_SUCCESS if the stages are valid; STATUS_ERROR otherwise.
+ */
+status_t EDMA_DRV_ComputePipelineTcds(const edma_pipeline_stage_t *stages,
+                                      uint8_t stageCount,
+                                      const uint8_t *channels,
+                                      edma_software_tcd_t *stcds);
+
+/*!
+ * @brief Builds a pipeline of linked eDMA channels.
+ *
+ * Allocates a free channel for each stage, all of them in the same eDMA instance
+ * since the channel links cannot cross instances, routes the DMA request source of
+ * each stage through the DMAMUX and loads the computed TCDs into the channels.
+ * Once started, the stages run each other through the channel links with no CPU
+ * involvement.
+ *
+ * @param pipeline Pointer to the pipeline runtime structure.
+ * @param chnStates Array of stageCount channel states; the memory must be kept valid
+ * until the pipeline is released.
+ * @param stages The stages of the pipeline; the array must be kept valid until the
+ * pipeline is released.
+ * @param stageCount Number of stages.
+ *
+ * @return STATUS_SUCCESS if successful; STATUS_ERROR if a stage is invalid;
+ * STATUS_BUSY if not enough channels are free.
+ */
+status_t EDMA_DRV_BuildPipeline(edma_pipeline_t *pipeline,
+                                edma_chn_state_t *chnStates,
+                                const edma_pipeline_stage_t *stages,
+                                uint8_t stageCount);
+
+/*!
+ * @brief Starts a pipeline.
+ *
+ * Enables the DMA requests of the stages having a request source, then starts by
+ * software the stages which have neither a request source nor an incoming link.
+ *
+ * @param pipeline Pointer to the pipeline runtime structure.
+ *
+ * @return STATUS_SUCCESS.
+ */
+status_t EDMA_DRV_StartPipeline(const edma_pipeline_t *pipeline);
+
+/*!
+ * @brief Stops a pipeline.
+ *
+ * Disables the DMA requests of all stages. A stage already started by a channel
+ * link completes its current minor loop.
+ *
+ * @param pipeline Pointer to the pipeline runtime structure.
+ *
+ * @return STATUS_SUCCESS.
+ */
+status_t EDMA_DRV_StopPipeline(const edma_pipeline_t *pipeline);
+
+/*!
+ * @brief Releases the channels of a pipeline.
+ *
+ * @param pipeline Pointer to the pipeline runtime structure.
+ *
+ * @return STATUS_SUCCESS.
+ */
+status_t EDMA_DRV_ReleasePipeline(edma_pipeline_t *pipeline);
+
 /*! @} */
 
 /*!
   * @name eDMA Peripheral driver miscellaneous functions
   * @{
   */
+/*!
+ * @brief Sets the timestamp source of the channel busy time accounting.
+ *
+ * @param timestamp Free-running counter read when the channels start, complete and
+ * stop, or NULL to stop accounting the busy time.
+ */
+void EDMA_DRV_SetTimestampSource(edma_timestamp_t timestamp);
+
+/*!
+ * @brief Gets the activity counters of an eDMA channel.
+ *
+ * The engine load is obtained by adding the counters of the channels.
+ *
+ * @param virtualChannel eDMA virtual channel number.
+ * @param stats Receives the counters.
+ */
+void EDMA_DRV_GetChannelStats(uint8_t virtualChannel,
+                              edma_chn_stats_t *stats);
+
+/*!
+ * @brief Clears the activity counters of an eDMA channel.
+ *
+ * @param virtualChannel eDMA virtual channel number.
+ */
+void EDMA_DRV_ResetChannelStats(uint8_t virtualChannel);
+
 /*!
  * @brief Gets the eDMA channel status.
  *
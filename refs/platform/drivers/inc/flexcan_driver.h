@@ -24,6 +24,9 @@
 #if FEATURE_CAN_HAS_DMA_ENABLE
 #include "edma_driver.h"
 #endif
+#if FEATURE_CAN_HAS_PRETENDED_NETWORKING
+#include "power_manager.h"
+#endif
 
 /*!
  * @defgroup flexcan_driver FlexCAN Driver
@@ -36,6 +39,9 @@
  * Definitions
  ******************************************************************************/
 
+/*! @brief Message buffer handle used for the Rx FIFO transfers */
+#define FLEXCAN_MB_HANDLE_RXFIFO    0U
+
 /*! @brief The type of the RxFIFO transfer (interrupts/DMA).
  * Implements : flexcan_rxfifo_transfer_type_t_Class
  */
@@ -64,7 +70,9 @@ typedef enum {
 typedef enum {
     FLEXCAN_MB_IDLE,      /*!< The MB is not used by any transfer. */
     FLEXCAN_MB_RX_BUSY,   /*!< The MB is used for a reception. */
-    FLEXCAN_MB_TX_BUSY    /*!< The MB is used for a transmission. */
+    FLEXCAN_MB_TX_BUSY,   /*!< The MB is used for a transmission. */
+    FLEXCAN_MB_RX_RING,   /*!< The MB is used for a continuous reception into a ring buffer. */
+    FLEXCAN_MB_TX_PREPARED /*!< The MB holds a frame loaded by FLEXCAN_DRV_PrepareSend. */
 } flexcan_mb_state_t;
 
 /*! @brief FlexCAN Message Buffer ID type
@@ -83,19 +91,213 @@ typedef struct {
     uint32_t msgId;                     /*!< Message Buffer ID*/
     uint8_t data[64];                   /*!< Data bytes of the FlexCAN message*/
     uint8_t dataLen;                    /*!< Length of data in bytes */
+    uint64_t timestamp;                 /*!< Time of the frame on the bus, in time base ticks
+                                             (0 if no time base is installed) */
 } flexcan_msgbuff_t;
 
+/*! @brief Single-producer/single-consumer ring of received frames.
+ *
+ * The producer is the FlexCAN interrupt handler, which only advances head; the
+ * consumer is the application, which only advances tail. Both indexes are free
+ * running and the ring size must be a power of two.
+ * Implements : flexcan_rx_ring_t_Class
+ */
+typedef struct {
+    flexcan_msgbuff_t *buffer;       /*!< Storage for the ring entries */
+    uint32_t size;                   /*!< Number of entries in the ring (power of two) */
+    uint32_t head;                   /*!< Number of frames written by the interrupt handler */
+    uint32_t tail;                   /*!< Number of frames consumed by the application */
+    uint32_t ringOverflows;          /*!< Frames dropped because the ring was full */
+    uint32_t hwOverruns;             /*!< Frames lost in hardware (MB overrun or Rx FIFO overflow) */
+} flexcan_rx_ring_t;
+
 /*! @brief Information needed for internal handling of a given MB.
  * Implements : flexcan_mb_handle_t_Class
  */
 typedef struct {
     flexcan_msgbuff_t *mb_message;   /*!< The FlexCAN MB structure */
     semaphore_t mbSema;              /*!< Semaphore used for signaling completion of a blocking transfer */
-    flexcan_mb_state_t state;        /*!< The state of the current MB (idle/Rx busy/Tx busy) */
+    flexcan_mb_state_t state;        /*!< The state of the current MB (idle/Rx busy/Tx busy/Rx ring) */
     bool isBlocking;                 /*!< True if the transfer is blocking */
     bool isRemote;                   /*!< True if the frame is a remote frame */
+    flexcan_rx_ring_t rxRing;        /*!< Ring used when the MB is in continuous reception */
+    uint64_t timestamp;              /*!< Time of the last frame received or sent by the MB */
+    uint64_t startTime;              /*!< Time the frame being sent was handed to the driver */
+    uint32_t txCs;                   /*!< CODE/status word written by FLEXCAN_DRV_SendPrepared */
 } flexcan_mb_handle_t;
 
+/*! @brief FlexCAN data info from user
+ * Implements : flexcan_data_info_t_Class
+ */
+typedef struct {
+    flexcan_msgbuff_id_type_t msg_id_type;  /*!< Type of message ID (standard or extended)*/
+    uint32_t data_length;                   /*!< Length of Data in Bytes*/
+    bool fd_enable;                         /*!< Enable or disable FD*/
+    uint8_t fd_padding;                     /*!< Set a value for padding. It will be used when the data length code (DLC)
+                                                 specifies a bigger payload size than data_length to fill the MB */
+    bool enable_brs;                        /*!< Enable bit rate switch inside a CAN FD format frame*/
+    bool is_remote;                         /*!< Specifies if the frame is standard or remote */
+} flexcan_data_info_t;
+
+/*! @brief Frame waiting in the transmit queue.
+ * Implements : flexcan_tx_frame_t_Class
+ */
+typedef struct {
+    flexcan_data_info_t txInfo;      /*!< Data info of the frame */
+    uint32_t msgId;                  /*!< ID of the frame */
+    uint8_t data[64];                /*!< Data bytes of the frame */
+    uint64_t queuedTime;             /*!< Time the frame was queued */
+} flexcan_tx_frame_t;
+
+/*! @brief Transmit queue serviced by a pool of consecutive Tx MBs.
+ *
+ * FLEXCAN_DRV_SendQueued is the only producer. The interrupt handler loads
+ * queued frames into the MBs of the pool as they complete; FLEXCAN_DRV_SendQueued
+ * and FLEXCAN_DRV_AbortTransfer load them into the pool MBs left idle, with the
+ * interrupts disabled. Both indexes are free running and the queue size must
+ * be a power of two.
+ * Implements : flexcan_tx_queue_t_Class
+ */
+typedef struct {
+    flexcan_tx_frame_t *frames;      /*!< Storage for the queued frames (NULL if the queue is not used) */
+    uint32_t size;                   /*!< Number of frames in the queue (power of two) */
+    volatile uint32_t head;          /*!< Number of frames accepted in the queue */
+    volatile uint32_t tail;          /*!< Number of frames loaded into the pool MBs */
+    uint8_t firstMb;                 /*!< Index of the first MB of the pool */
+    uint8_t mbCount;                 /*!< Number of MBs in the pool */
+    uint8_t nextPrio;                /*!< Local priority of the next frame loaded into the pool */
+    volatile status_t loadStatus;    /*!< Result of the last load of a queued frame into a pool MB */
+} flexcan_tx_queue_t;
+
+#if FEATURE_CAN_HAS_DMA_ENABLE
+/*! @brief Maximum number of Tx MBs loaded by one eDMA batch */
+#define FLEXCAN_TX_DMA_MAX_MBS    8U
+
+/*! @brief Size, in bytes, of the software TCD storage of a Tx DMA pool of mbCount MBs */
+#define FLEXCAN_TX_DMA_STCD_SIZE(mbCount)    STCD_SIZE(2U * (mbCount))
+
+/*! @brief Pre-formatted frame sent through the eDMA.
+ *
+ * Built by FLEXCAN_DRV_PrepareTxDmaFrame; the eDMA channel copies the image
+ * into a Tx MB as is.
+ * Implements : flexcan_tx_dma_frame_t_Class
+ */
+typedef struct {
+    uint32_t image[18];              /*!< CODE/status word, ID word and payload words in MB byte order */
+    uint32_t length;                 /*!< Number of words of the image */
+} flexcan_tx_dma_frame_t;
+
+/*! @brief Transmission of frame chains through the eDMA.
+ *
+ * The frames are sent in batches of up to mbCount frames: a scatter/gather
+ * chain copies each frame into the next MB of the pool, the CODE/status word
+ * last, and the interrupt of the last MB of the batch starts the next one.
+ * Implements : flexcan_tx_dma_t_Class
+ */
+typedef struct {
+    flexcan_tx_dma_frame_t *frames;  /*!< Chain being sent (NULL if no chain is being sent) */
+    uint32_t count;                  /*!< Number of frames of the chain */
+    volatile uint32_t next;          /*!< Number of frames handed to the eDMA channel */
+    edma_software_tcd_t *stcd;       /*!< Software TCD storage (NULL if the eDMA path is not used) */
+    uint8_t dmaChannel;              /*!< eDMA channel loading the MBs */
+    uint8_t firstMb;                 /*!< Index of the first MB of the pool */
+    uint8_t mbCount;                 /*!< Number of MBs in the pool */
+    uint8_t lastMb;                  /*!< MB of the last frame of the current batch */
+    volatile bool error;             /*!< The last chain was ended by an eDMA error */
+} flexcan_tx_dma_t;
+#endif
+
+/*! @brief Monotonic time base used to extend the 16-bit frame timestamps.
+ *
+ * The FlexCAN free running timer counts CAN bits and wraps every 65536 bits;
+ * the time base gives the 64-bit time, for instance from a timing_pal channel.
+ * Implements : flexcan_time_base_t_Class
+ */
+typedef struct {
+    uint64_t (*getTime)(void *param); /*!< Returns the current time, in ticks */
+    void *param;                      /*!< Parameter passed to getTime */
+    uint32_t ticksPerBit;             /*!< Duration of a nominal CAN bit, in ticks */
+} flexcan_time_base_t;
+
+/*! @brief Number of bins of a latency histogram */
+#define FLEXCAN_LATENCY_BINS  24U
+
+/*! @brief Latency histogram of a message buffer.
+ *
+ * Bin n counts the latencies in [2^n, 2^(n+1)) ticks (bin 0 also counts the
+ * null latencies) and the last bin counts all the longer ones.
+ * Implements : flexcan_latency_hist_t_Class
+ */
+typedef struct {
+    uint32_t bins[FLEXCAN_LATENCY_BINS]; /*!< Number of frames per latency range */
+    uint32_t count;                      /*!< Number of frames measured */
+    uint64_t maxLatency;                 /*!< Longest latency measured, in ticks */
+} flexcan_latency_hist_t;
+
+/*! @brief Fault confinement state of a FlexCAN node.
+ * Implements : flexcan_fault_state_t_Class
+ */
+typedef enum {
+    FLEXCAN_FAULT_ERROR_ACTIVE,     /*!< The node takes part in bus communication normally. */
+    FLEXCAN_FAULT_ERROR_PASSIVE,    /*!< An error counter reached 128, the node sends passive error flags. */
+    FLEXCAN_FAULT_BUS_OFF           /*!< The transmit error counter exceeded 255, the node is off the bus. */
+} flexcan_fault_state_t;
+
+/*! @brief Fault confinement state callback function type
+ * Implements : flexcan_fault_callback_t_Class
+ */
+typedef void (*flexcan_fault_callback_t)(uint8_t instance, flexcan_fault_state_t previousState,
+                                         flexcan_fault_state_t newState, void *param);
+
+/*! @brief Error manager configuration
+ * Implements : flexcan_error_config_t_Class
+ */
+typedef struct {
+    bool autoRecovery;                  /*!< Restart the node after bus-off, or wait for
+                                             FLEXCAN_DRV_RecoverBusOff */
+    uint32_t recoveryDelayMs;           /*!< Time spent in bus-off before the first restart, in ms */
+    uint32_t maxRecoveryDelayMs;        /*!< Upper bound of the delay, doubled at each restart; the
+                                             delay is reset once the node stayed error-active this long */
+    flexcan_fault_callback_t callback;  /*!< Fault confinement state callback (may be NULL) */
+    void *callbackParam;                /*!< Parameter passed to the callback */
+} flexcan_error_config_t;
+
+/*! @brief Error counters of a FlexCAN node.
+ *
+ * An error kind is counted once per error interrupt (or error manager run)
+ * which found it flagged in ESR1.
+ * Implements : flexcan_error_counters_t_Class
+ */
+typedef struct {
+    uint32_t bitErrors;                 /*!< Bit0 and bit1 errors */
+    uint32_t stuffErrors;               /*!< Stuffing errors */
+    uint32_t crcErrors;                 /*!< CRC errors */
+    uint32_t formErrors;                /*!< Form errors */
+    uint32_t ackErrors;                 /*!< Acknowledge errors */
+    uint32_t errorPassiveCount;         /*!< Transitions from error-active to error-passive */
+    uint32_t busOffCount;               /*!< Transitions to bus-off */
+    uint32_t busOffTimeMs;              /*!< Total time spent in bus-off, in ms */
+    uint32_t lastBusOffTimeMs;          /*!< Duration of the last bus-off, in ms */
+    uint8_t txErrorCount;               /*!< TEC at the last update */
+    uint8_t rxErrorCount;               /*!< REC at the last update */
+    uint8_t txErrorPeak;                /*!< Highest TEC seen */
+    uint8_t rxErrorPeak;                /*!< Highest REC seen */
+} flexcan_error_counters_t;
+
+/*! @brief Error manager runtime information.
+ * Implements : flexcan_error_manager_t_Class
+ */
+typedef struct {
+    flexcan_error_config_t config;      /*!< Error manager configuration */
+    bool enabled;                       /*!< The error manager is configured */
+    volatile flexcan_fault_state_t faultState; /*!< Current fault confinement state */
+    flexcan_error_counters_t counters;  /*!< Error counters */
+    uint32_t busOffStart;               /*!< Start of the current bus-off, in ms */
+    uint32_t activeStart;               /*!< End of the last bus-off, in ms */
+    uint32_t recoveryDelay;             /*!< Delay before the next restart, in ms */
+    volatile bool recoveryRequested;    /*!< The node is leaving bus-off */
+} flexcan_error_manager_t;
+
 /*!
  * @brief Internal driver state information.
  *
@@ -113,21 +315,19 @@ typedef struct FlexCANState {
     uint8_t rxFifoDMAChannel;                      /*!< DMA channel number used for transfers. */
 #endif
     flexcan_rxfifo_transfer_type_t transferType;   /*!< Type of RxFIFO transfer. */
+    uint32_t rxFifoBatchSize;                      /*!< Capacity of the pending Rx FIFO batch (0 for a single frame). */
+    uint32_t *rxFifoBatchCount;                    /*!< Number of frames stored by the pending Rx FIFO batch. */
+    volatile uint32_t *mbRegions[FEATURE_CAN_MAX_MB_NUM]; /*!< Start address of each MB for the configured payload size. */
+    flexcan_tx_queue_t txQueue;                    /*!< Transmit queue and its pool of Tx MBs. */
+#if FEATURE_CAN_HAS_DMA_ENABLE
+    flexcan_tx_dma_t txDma;                        /*!< Frame chain sent through the eDMA and its pool of Tx MBs. */
+#endif
+    const flexcan_time_base_t *timeBase;           /*!< Time base of the frame timestamps (NULL if not used). */
+    flexcan_latency_hist_t *latencyHist;           /*!< Latency histogram of each MB (NULL if not used). */
+    uint32_t latencyHistCount;                     /*!< Number of MBs with a latency histogram. */
+    flexcan_error_manager_t errorManager;          /*!< Fault confinement tracking and bus-off recovery. */
 } flexcan_state_t;
 
-/*! @brief FlexCAN data info from user
- * Implements : flexcan_data_info_t_Class
- */
-typedef struct {
-    flexcan_msgbuff_id_type_t msg_id_type;  /*!< Type of message ID (standard or extended)*/
-    uint32_t data_length;                   /*!< Length of Data in Bytes*/
-    bool fd_enable;                         /*!< Enable or disable FD*/
-    uint8_t fd_padding;                     /*!< Set a value for padding. It will be used when the data length code (DLC)
-                                                 specifies a bigger payload size than data_length to fill the MB */
-    bool enable_brs;                        /*!< Enable bit rate switch inside a CAN FD format frame*/
-    bool is_remote;                         /*!< Specifies if the frame is standard or remote */
-} flexcan_data_info_t;
-
 /*! @brief FlexCAN Rx FIFO filters number
  * Implements : flexcan_rx_fifo_id_filter_num_t_Class
  */
@@ -178,6 +378,44 @@ typedef struct {
     uint32_t *idFilter;      /*!< Rx FIFO ID filter elements*/
 } flexcan_id_table_t;
 
+/*! @brief Maximum number of frames of a Rx FIFO batch, the largest eDMA major
+ * loop count without channel linking (CITER is 15 bits wide). */
+#define FLEXCAN_RX_FIFO_BATCH_MAX  (0x7FFFU)
+
+/*! @brief Maximum number of Rx FIFO ID filter elements that fit in the MB area
+ * (the Rx FIFO uses MBs 0-5 and every 8 filter elements take 2 more MBs). */
+#define FLEXCAN_RX_FIFO_MAX_FILTER_ELEMENTS  (((FEATURE_CAN_MAX_MB_NUM - 6U) / 2U) * 8U)
+/*! @brief Size of the hash set of the IDs accepted in software by a compiled filter program. */
+#define FLEXCAN_RX_FILTER_SW_IDS             64U
+
+/*! @brief Range of IDs accepted by the Rx FIFO filter compiler
+ * Implements : flexcan_id_range_t_Class
+ */
+typedef struct {
+    flexcan_msgbuff_id_type_t idType;  /*!< Standard or extended IDs */
+    uint32_t firstId;                  /*!< First accepted ID */
+    uint32_t lastId;                   /*!< Last accepted ID (equal to firstId for a single ID) */
+} flexcan_id_range_t;
+
+/*! @brief Rx FIFO filter program built by FLEXCAN_DRV_CompileRxFifoFilters.
+ *
+ * The elements are format A filter table elements and each one has its own
+ * acceptance mask. The IDs which did not fit in the filter table are kept in a
+ * hash set and accepted in hardware by a wider element; the frames hitting that
+ * element must be checked with FLEXCAN_DRV_IsRxFifoIdAccepted.
+ * Implements : flexcan_rx_filter_program_t_Class
+ */
+typedef struct {
+    uint32_t idFilter[FLEXCAN_RX_FIFO_MAX_FILTER_ELEMENTS]; /*!< Format A ID filter table elements */
+    uint32_t idMask[FLEXCAN_RX_FIFO_MAX_FILTER_ELEMENTS];   /*!< Acceptance mask of each element */
+    uint32_t numElements;                                   /*!< Number of elements used by the program */
+    flexcan_rx_fifo_id_filter_num_t num_id_filters;         /*!< Number of Rx FIFO ID filters to configure */
+    uint8_t swElements[2];                                  /*!< Elements accepting the software checked IDs */
+    uint8_t numSwElements;                                  /*!< Number of elements in swElements */
+    uint32_t swIds[FLEXCAN_RX_FILTER_SW_IDS];               /*!< Hash set of the software checked IDs */
+    uint32_t numSwIds;                                      /*!< Number of IDs in the hash set */
+} flexcan_rx_filter_program_t;
+
 /*! @brief FlexCAN operation modes
  * Implements : flexcan_operation_modes_t_Class
  */
@@ -210,6 +448,16 @@ typedef struct {
     uint32_t rJumpwidth;      /*!< Resync jump width*/
 } flexcan_time_segment_t;
 
+/*! @brief FlexCAN bit timing computed for a pair of bitrates
+ * Implements : flexcan_bit_timing_t_Class
+ */
+typedef struct {
+    flexcan_time_segment_t bitrate;     /*!< Time segments for standard frames or the arbitration phase of FD frames */
+    flexcan_time_segment_t bitrate_cbt; /*!< Time segments for the data phase of FD frames */
+    bool tdcEnable;                     /*!< Transceiver Delay Compensation is needed by the data phase */
+    uint8_t tdcOffset;                  /*!< Transceiver Delay Compensation Offset, in PE clock cycles */
+} flexcan_bit_timing_t;
+
 /*! @brief FlexCAN configuration
  * @internal gui name="Common configuration" id="flexcanCfg"
  * Implements : flexcan_user_config_t_Class
@@ -285,6 +533,28 @@ typedef struct {
     flexcan_pn_payload_filter_t payloadFilter;        /*!< The configuration of the payload filter. */
 } flexcan_pn_config_t;
 
+/*! @brief Pretended Networking wake rule: the classical data frames which should
+ * wake the system up.
+ * Implements : flexcan_pn_wake_rule_t_Class
+ */
+typedef struct {
+    bool extendedId;            /*!< Specifies if the IDs are standard or extended. */
+    uint32_t idLow;             /*!< Lowest accepted ID. */
+    uint32_t idHigh;            /*!< Highest accepted ID (idLow for a single ID). */
+    uint8_t dlcLow;             /*!< Lowest accepted payload size. */
+    uint8_t dlcHigh;            /*!< Highest accepted payload size. */
+    uint8_t payloadMask[8U];    /*!< Bits of the payload compared (all zero if the payload is not checked). */
+    uint8_t payloadValue[8U];   /*!< Expected value of the compared bits. */
+} flexcan_pn_wake_rule_t;
+
+/*! @brief Data of the Pretended Networking power manager callback
+ * Implements : flexcan_pn_power_config_t_Class
+ */
+typedef struct {
+    uint8_t instance;                       /*!< FlexCAN instance kept listening in the stop modes. */
+    const flexcan_pn_config_t *pnConfig;    /*!< Wake filter used in the stop modes. */
+} flexcan_pn_power_config_t;
+
 #endif /* FEATURE_CAN_HAS_PRETENDED_NETWORKING */
 
 /*! @brief FlexCAN Driver callback function type
@@ -338,6 +608,59 @@ void FLEXCAN_DRV_GetBitrate(uint8_t instance, flexcan_time_segment_t *bitrate);
  */
 void FLEXCAN_DRV_GetBitrateFD(uint8_t instance, flexcan_time_segment_t *bitrate);
 
+/*!
+ * @brief Computes the time segments for the requested bitrates.
+ *
+ * Enumerates every prescaler and time segment combination the CTRL1/CBT and
+ * FDCBT registers can hold and returns the one whose sample points are closest
+ * to the requested one. Only exact bitrates are considered. On ties, a data
+ * phase prescaler equal to the arbitration phase one is preferred, then the
+ * smallest prescaler (the most time quanta per bit). For data bitrates above
+ * 1 Mbit/s the Transceiver Delay Compensation is enabled, with the offset set
+ * to the data phase sample point and saturated to the TDC offset range.
+ *
+ * The returned time segments use the register encoding expected by
+ * FLEXCAN_DRV_SetBitrate and FLEXCAN_DRV_SetBitrateCbt.
+ *
+ * @param   peClock         Frequency of the Protocol Engine clock, in Hz
+ * @param   nominalBitrate  Bitrate of standard frames or of the arbitration phase, in bit/s
+ * @param   dataBitrate     Bitrate of the data phase of FD frames, in bit/s, or 0 for
+ *                          classical CAN
+ * @param   samplePoint     Requested sample point, in tenths of a percent (875 = 87.5%)
+ * @param   timing          The computed bit timing
+ * @return  STATUS_SUCCESS if successful;<br>
+ *          STATUS_ERROR if no legal timing produces the requested bitrates.
+ */
+status_t FLEXCAN_DRV_ComputeBitTiming(uint32_t peClock,
+                                      uint32_t nominalBitrate,
+                                      uint32_t dataBitrate,
+                                      uint32_t samplePoint,
+                                      flexcan_bit_timing_t *timing);
+
+/*!
+ * @brief Computes and applies the bit timing for the requested bitrates.
+ *
+ * Reads the frequency of the clock selected for the Protocol Engine with
+ * CLOCK_SYS_GetFreq, computes the time segments with FLEXCAN_DRV_ComputeBitTiming
+ * and programs the arbitration phase, the data phase and the Transceiver Delay
+ * Compensation. A data bitrate can only be given when FD is enabled.
+ *
+ * @param   instance        A FlexCAN instance number
+ * @param   nominalBitrate  Bitrate of standard frames or of the arbitration phase, in bit/s
+ * @param   dataBitrate     Bitrate of the data phase of FD frames, in bit/s, or 0 for
+ *                          classical CAN
+ * @param   samplePoint     Requested sample point, in tenths of a percent (875 = 87.5%)
+ * @param   timing          A pointer to a variable for returning the applied bit timing
+ * @return  STATUS_SUCCESS if successful;<br>
+ *          STATUS_ERROR if the clock is not available or no legal timing produces
+ *          the requested bitrates.
+ */
+status_t FLEXCAN_DRV_ConfigBitTiming(uint8_t instance,
+                                     uint32_t nominalBitrate,
+                                     uint32_t dataBitrate,
+                                     uint32_t samplePoint,
+                                     flexcan_bit_timing_t *timing);
+
 /*@}*/
 
 /*!
@@ -420,6 +743,73 @@ status_t FLEXCAN_DRV_SetRxIndividualMask(
 
 /*@}*/
 
+/*!
+ * @name Rx FIFO filter compiler
+ * @{
+ */
+
+/*!
+ * @brief Compiles a list of accepted IDs into an Rx FIFO filter program.
+ *
+ * The ranges are split in aligned blocks which are merged into as few
+ * (ID, mask) pairs as possible. The pairs are placed in format A elements
+ * using the individual masks, and the single IDs are placed in the elements
+ * following them. When the filter table is too small, the IDs that do not fit
+ * are moved to a software hash set, accepted in hardware by one element per ID
+ * type covering all of them: the narrowest ranges first when the individual
+ * masks run out, the single IDs first when the elements run out. Only data
+ * frames are accepted.
+ * The number of Rx FIFO ID filters of the program must be used in the
+ * flexcan_user_config_t of the instance.
+ *
+ * @param   ranges      Accepted standard and extended ID ranges.
+ * @param   rangeCount  Number of ranges.
+ * @param   program     The compiled filter program.
+ * @return  STATUS_SUCCESS if successful;
+ *          STATUS_ERROR if the IDs do not fit in the filter table and the
+ *          software hash set
+ */
+status_t FLEXCAN_DRV_CompileRxFifoFilters(
+    const flexcan_id_range_t *ranges,
+    uint32_t rangeCount,
+    flexcan_rx_filter_program_t *program);
+
+/*!
+ * @brief Programs a compiled filter program in the Rx FIFO.
+ *
+ * The function writes the filter table, the individual masks and the global
+ * mask of the Rx FIFO and enables the individual masking. Rx MBs placed after
+ * the filter table share the individual mask register of the filter element
+ * with the same index.
+ *
+ * @param   instance    A FlexCAN instance number
+ * @param   program     The compiled filter program.
+ * @return  STATUS_SUCCESS if successful;
+ *          STATUS_ERROR if the Rx FIFO is disabled or it was configured with
+ *          a different number of ID filters
+ */
+status_t FLEXCAN_DRV_ConfigRxFifoFilters(
+    uint8_t instance,
+    const flexcan_rx_filter_program_t *program);
+
+/*!
+ * @brief Checks a frame received by the Rx FIFO against the software stage of
+ * a filter program.
+ *
+ * The check is needed only when the program has software checked IDs; the
+ * frames not hitting the element which accepts them return true without a
+ * lookup.
+ *
+ * @param   program     The compiled filter program.
+ * @param   frame       The frame read from the Rx FIFO.
+ * @return  true if the frame is accepted by the program, false otherwise
+ */
+bool FLEXCAN_DRV_IsRxFifoIdAccepted(
+    const flexcan_rx_filter_program_t *program,
+    const flexcan_msgbuff_t *frame);
+
+/*@}*/
+
 /*!
  * @name Initialization and Shutdown
  * @{
@@ -576,7 +966,229 @@ status_t FLEXCAN_DRV_Send(
     uint32_t msg_id,
     const uint8_t *mb_data);
 
+/*!
+ * @brief Loads a CAN frame into a message buffer without sending it.
+ *
+ * The ID and the payload are written into the MB, which is left inactive
+ * until FLEXCAN_DRV_SendPrepared writes its CODE. Until then, the MB is busy
+ * for the other send and receive functions; FLEXCAN_DRV_AbortTransfer
+ * discards the frame.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   mb_idx     Index of the message buffer
+ * @param   tx_info    Data info
+ * @param   msg_id     ID of the message to transmit
+ * @param   mb_data    Bytes of the FlexCAN message.
+ * @return  STATUS_SUCCESS if successful;
+ *          STATUS_FLEXCAN_MB_OUT_OF_RANGE if the index of a message buffer is invalid;
+ *          STATUS_BUSY if a resource is busy
+ */
+status_t FLEXCAN_DRV_PrepareSend(
+    uint8_t instance,
+    uint8_t mb_idx,
+    const flexcan_data_info_t *tx_info,
+    uint32_t msg_id,
+    const uint8_t *mb_data);
+
+/*!
+ * @brief Sends the frame loaded by FLEXCAN_DRV_PrepareSend.
+ *
+ * Only the CODE/status word of the MB is written, so the transmission starts
+ * after a constant, short delay; this suits time-triggered transmissions.
+ * Completion is reported like for FLEXCAN_DRV_Send.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   mb_idx     Index of the message buffer
+ * @return  STATUS_SUCCESS if successful;
+ *          STATUS_ERROR if no frame was prepared in the MB
+ */
+status_t FLEXCAN_DRV_SendPrepared(uint8_t instance, uint8_t mb_idx);
+
+/*@}*/
+
+/*!
+ * @name Transmit queue
+ * @{
+ */
+
+/*!
+ * @brief Sets up a transmit queue served by a pool of consecutive Tx MBs.
+ *
+ * Frames handed to FLEXCAN_DRV_SendQueued are loaded into a free MB of the
+ * pool, or kept in the queue until the interrupt handler finds one of the
+ * pool MBs completed. The Local Priority feature is enabled and the queue
+ * loads the pool MBs with a rising PRIO, which takes precedence over the ID
+ * and the MB number during the internal Tx arbitration: the frames leave in
+ * the order they were queued. PRIO has 8 values, so after 8 loads the next
+ * frame waits until the pool drained. Frames of the other MBs with a lower
+ * PRIO, e.g. 0 from the other send functions, win the internal arbitration
+ * over the pool whatever their ID. The pool MBs must not be
+ * used with the other send functions until the queue is released with
+ * FLEXCAN_DRV_ReleaseTxQueue.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   firstMb    Index of the first MB of the pool
+ * @param   mbCount    Number of MBs in the pool
+ * @param   frames     Storage for the queue; it must hold queueSize frames and
+ *                     stay valid while the queue is used
+ * @param   queueSize  Number of frames in the queue (must be a power of two)
+ * @return  STATUS_SUCCESS if successful;
+ *          STATUS_BUSY if a MB of the pool is in use
+ */
+status_t FLEXCAN_DRV_ConfigTxQueue(
+    uint8_t instance,
+    uint8_t firstMb,
+    uint8_t mbCount,
+    flexcan_tx_frame_t *frames,
+    uint32_t queueSize);
+
+/*!
+ * @brief Sends a CAN frame through the transmit queue.
+ *
+ * The frame is copied, so the caller's buffer can be reused as soon as this
+ * function returns. Frames are loaded into the pool MBs in the order they were
+ * queued; a TX_COMPLETE event is reported for every frame sent. Remote frames
+ * are not supported by the queue.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   tx_info    Data info of the frame
+ * @param   msg_id     ID of the frame
+ * @param   mb_data    Bytes of the frame
+ * @return  STATUS_SUCCESS if the frame was loaded into a MB or queued;
+ *          STATUS_BUSY if the queue is full
+ */
+status_t FLEXCAN_DRV_SendQueued(
+    uint8_t instance,
+    const flexcan_data_info_t *tx_info,
+    uint32_t msg_id,
+    const uint8_t *mb_data);
+
+/*!
+ * @brief Returns the number of frames waiting in the transmit queue.
+ *
+ * Frames already loaded into the pool MBs are not counted.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @return  The number of queued frames
+ */
+uint32_t FLEXCAN_DRV_GetTxQueuePending(uint8_t instance);
+
+/*!
+ * @brief Returns the result of the last load of a queued frame into a pool MB.
+ *
+ * A queued frame that cannot be loaded into a MB stays at the head of the
+ * queue. It is loaded again when another pool MB completes, when a frame is
+ * queued and when a pool MB is aborted.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @return  STATUS_SUCCESS if the last load succeeded;
+ *          the error returned by FLEXCAN_DRV_Send otherwise
+ */
+status_t FLEXCAN_DRV_GetTxQueueStatus(uint8_t instance);
+
+/*!
+ * @brief Releases the transmit queue.
+ *
+ * The frames still in the queue are discarded, the pool MBs still
+ * transmitting are aborted and the Local Priority feature is disabled, so
+ * the pool MBs can be used with the other send functions again.
+ *
+ * @param   instance   A FlexCAN instance number
+ */
+void FLEXCAN_DRV_ReleaseTxQueue(uint8_t instance);
+
+/*@}*/
+
+#if FEATURE_CAN_HAS_DMA_ENABLE
+/*!
+ * @name Transmit through eDMA
+ * @{
+ */
+
+/*!
+ * @brief Sets up the transmission of frame chains through an eDMA channel.
+ *
+ * FlexCAN has no transmit DMA request, so the channel is routed to an always
+ * enabled request source and loads the MBs of the pool as fast as it can; the
+ * frames of a batch leave in pool order thanks to the Local Priority feature,
+ * which is enabled here. The channel must be initialized with the eDMA driver;
+ * its callback is replaced by the one ending the chain on an eDMA error. The
+ * pool MBs must not be used with the other send functions while the eDMA path
+ * is configured.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   dmaChannel eDMA virtual channel loading the MBs
+ * @param   firstMb    Index of the first MB of the pool
+ * @param   mbCount    Number of MBs in the pool (up to FLEXCAN_TX_DMA_MAX_MBS)
+ * @param   stcd       Storage for the software TCDs; it must hold
+ *                     FLEXCAN_TX_DMA_STCD_SIZE(mbCount) bytes and stay valid
+ *                     while the eDMA path is used
+ * @return  STATUS_SUCCESS if successful;
+ *          STATUS_CAN_BUFF_OUT_OF_RANGE if a MB of the pool is invalid;
+ *          STATUS_BUSY if a MB of the pool is in use
+ */
+status_t FLEXCAN_DRV_ConfigTxDma(
+    uint8_t instance,
+    uint8_t dmaChannel,
+    uint8_t firstMb,
+    uint8_t mbCount,
+    edma_software_tcd_t *stcd);
+
+/*!
+ * @brief Formats a CAN frame for FLEXCAN_DRV_SendDmaChain.
+ *
+ * The frame is formatted once and can be sent any number of times. Remote
+ * frames are not supported by the eDMA path.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   tx_info    Data info of the frame
+ * @param   msg_id     ID of the frame
+ * @param   mb_data    Bytes of the frame
+ * @param   frame      The formatted frame
+ */
+void FLEXCAN_DRV_PrepareTxDmaFrame(
+    uint8_t instance,
+    const flexcan_data_info_t *tx_info,
+    uint32_t msg_id,
+    const uint8_t *mb_data,
+    flexcan_tx_dma_frame_t *frame);
+
+/*!
+ * @brief Sends a chain of formatted frames through the eDMA.
+ *
+ * The frames are sent in order, without CPU copies: the CPU only takes one
+ * interrupt per batch of mbCount frames, to start the next batch. The local
+ * priority of the ID words is overwritten by the position of the frames in
+ * their batch. A TX_COMPLETE event is reported for the last MB of the pool
+ * used once the whole chain was sent. The frames must stay valid until then.
+ * An eDMA error ends the chain without event, the frames of the batch which
+ * did not leave are taken back and FLEXCAN_DRV_GetTxDmaChainStatus reports the
+ * error; FLEXCAN_DRV_AbortTransfer on a MB of the pool ends the chain as well.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   frames     The frames, formatted by FLEXCAN_DRV_PrepareTxDmaFrame
+ * @param   count      Number of frames
+ * @return  STATUS_SUCCESS if successful;
+ *          STATUS_BUSY if a chain is being sent or a MB of the pool is in use;
+ *          STATUS_ERROR if the eDMA channel could not be configured
+ */
+status_t FLEXCAN_DRV_SendDmaChain(
+    uint8_t instance,
+    flexcan_tx_dma_frame_t *frames,
+    uint32_t count);
+
+/*!
+ * @brief Returns whether a frame chain is being sent through the eDMA.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @return  STATUS_SUCCESS if no chain is being sent;
+ *          STATUS_BUSY if a chain is being sent;
+ *          STATUS_ERROR if the last chain was ended by an eDMA error
+ */
+status_t FLEXCAN_DRV_GetTxDmaChainStatus(uint8_t instance);
+
 /*@}*/
+#endif /* FEATURE_CAN_HAS_DMA_ENABLE */
 
 /*!
  * @name Receive configuration
@@ -688,6 +1300,116 @@ status_t FLEXCAN_DRV_RxFifo(
     uint8_t instance,
     flexcan_msgbuff_t *data);
 
+/*!
+ * @brief Receives a batch of CAN frames using the message FIFO.
+ *
+ * This function returns immediately. When using interrupts, the handler drains
+ * every frame available in the Rx FIFO, up to maxFrames, in a single pass and
+ * then completes the transfer and invokes the callback once. When using DMA,
+ * the channel moves one frame per DMA request and the transfer completes after
+ * maxFrames frames, so the channel is programmed only once per batch.
+ * The number of frames stored in the buffer is written to count when the
+ * transfer completes (see FLEXCAN_DRV_GetTransferStatus).
+ *
+ * @param   instance    A FlexCAN instance number
+ * @param   frames      Buffer of maxFrames FlexCAN message buffers.
+ * @param   maxFrames   Maximum number of frames of the batch, at most
+ *                      FLEXCAN_RX_FIFO_BATCH_MAX.
+ * @param   count       Number of frames received in the buffer.
+ * @return  STATUS_SUCCESS if successful;
+ *          STATUS_BUSY if a resource is busy;
+ *          STATUS_ERROR if other error occurred
+ */
+status_t FLEXCAN_DRV_RxFifoBatch(
+    uint8_t instance,
+    flexcan_msgbuff_t *frames,
+    uint32_t maxFrames,
+    uint32_t *count);
+
+/*@}*/
+
+/*!
+ * @name Continuous reception
+ * @{
+ */
+
+/*!
+ * @brief Starts a continuous reception into a ring buffer using the specified message buffer.
+ *
+ * Unlike FLEXCAN_DRV_Receive, the message buffer interrupt is not disabled after
+ * each frame: the interrupt handler keeps appending received frames to the ring
+ * until the reception is stopped with FLEXCAN_DRV_AbortTransfer. Frames are
+ * retrieved with FLEXCAN_DRV_ReadRxRing. If a callback is installed, it is
+ * invoked with FLEXCAN_EVENT_RX_COMPLETE after every frame added to the ring.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   mb_idx     Index of the message buffer
+ * @param   buffer     Storage for the ring; it must hold ringSize frames and stay
+ *                     valid until the reception is stopped
+ * @param   ringSize   Number of frames in the ring (must be a power of two)
+ * @return  STATUS_SUCCESS if successful;
+ *          STATUS_FLEXCAN_MB_OUT_OF_RANGE if the index of a message buffer is invalid;
+ *          STATUS_BUSY if a resource is busy
+ */
+status_t FLEXCAN_DRV_ReceiveContinuous(
+    uint8_t instance,
+    uint8_t mb_idx,
+    flexcan_msgbuff_t *buffer,
+    uint32_t ringSize);
+
+/*!
+ * @brief Starts a continuous reception into a ring buffer using the Rx FIFO.
+ *
+ * Every frame available in the Rx FIFO is moved to the ring by the interrupt
+ * handler, without disabling the Rx FIFO interrupts. Frames are retrieved with
+ * FLEXCAN_DRV_ReadRxRing, using FLEXCAN_MB_HANDLE_RXFIFO as message buffer index.
+ * Only available when the Rx FIFO uses interrupts.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   buffer     Storage for the ring; it must hold ringSize frames and stay
+ *                     valid until the reception is stopped
+ * @param   ringSize   Number of frames in the ring (must be a power of two)
+ * @return  STATUS_SUCCESS if successful;
+ *          STATUS_BUSY if a resource is busy;
+ *          STATUS_ERROR if the Rx FIFO is disabled or uses DMA
+ */
+status_t FLEXCAN_DRV_RxFifoContinuous(
+    uint8_t instance,
+    flexcan_msgbuff_t *buffer,
+    uint32_t ringSize);
+
+/*!
+ * @brief Copies frames out of a continuous reception ring.
+ *
+ * This function may be called from thread context while the interrupt handler
+ * keeps filling the ring; no critical section is needed.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   mb_idx     Index of the message buffer (FLEXCAN_MB_HANDLE_RXFIFO for the Rx FIFO)
+ * @param   frames     Array receiving the frames, in reception order
+ * @param   maxFrames  Capacity of the frames array
+ * @return  The number of frames copied into frames
+ */
+uint32_t FLEXCAN_DRV_ReadRxRing(
+    uint8_t instance,
+    uint8_t mb_idx,
+    flexcan_msgbuff_t *frames,
+    uint32_t maxFrames);
+
+/*!
+ * @brief Returns the overflow counters of a continuous reception ring.
+ *
+ * @param   instance      A FlexCAN instance number
+ * @param   mb_idx        Index of the message buffer (FLEXCAN_MB_HANDLE_RXFIFO for the Rx FIFO)
+ * @param   ringOverflows Frames dropped because the ring was full (may be NULL)
+ * @param   hwOverruns    Frames lost in hardware before they were read (may be NULL)
+ */
+void FLEXCAN_DRV_GetRxRingOverflows(
+    uint8_t instance,
+    uint8_t mb_idx,
+    uint32_t *ringOverflows,
+    uint32_t *hwOverruns);
+
 /*@}*/
 
 /*!
@@ -698,6 +1420,10 @@ status_t FLEXCAN_DRV_RxFifo(
 /*!
  * @brief Ends a non-blocking FlexCAN transfer early.
  *
+ * A frame waiting in a Tx MB is taken back: the MB is made inactive and its
+ * flag cleared, so that the frame does not complete the next transfer. A MB of
+ * the eDMA pool ends the whole chain being sent (see FLEXCAN_DRV_SendDmaChain).
+ *
  * @param   instance   A FlexCAN instance number
  * @param   mb_idx     The index of the message buffer
  * @return  STATUS_SUCCESS if successful;
@@ -720,6 +1446,138 @@ status_t FLEXCAN_DRV_GetTransferStatus(uint8_t instance, uint8_t mb_idx);
 
 /*@}*/
 
+/*!
+ * @name Error management
+ * @{
+ */
+
+/*!
+ * @brief Sets up the tracking of the bus errors and of the bus-off recovery.
+ *
+ * The error, bus-off and bus-off done interrupts are kept enabled, and the
+ * hardware recovery from bus-off is disabled: the node stays off the bus until
+ * the error manager, or FLEXCAN_DRV_RecoverBusOff, lets it recover. The error
+ * counters are cleared.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   config     The error manager configuration
+ */
+void FLEXCAN_DRV_ConfigErrorManager(uint8_t instance, const flexcan_error_config_t *config);
+
+/*!
+ * @brief Runs the time-dependent part of the error manager.
+ *
+ * Updates the fault confinement state, which goes back to error-active without
+ * interrupt, and restarts the node once the bus-off recovery delay expired. It
+ * should be called periodically, for instance every 10 ms.
+ *
+ * @param   instance   A FlexCAN instance number
+ */
+void FLEXCAN_DRV_ErrorMainFunction(uint8_t instance);
+
+/*!
+ * @brief Lets the node leave bus-off.
+ *
+ * The node goes back to error-active after 128 occurrences of 11 consecutive
+ * recessive bits on the bus.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @return  STATUS_SUCCESS if the recovery was started;
+ *          STATUS_ERROR if the node is not in bus-off
+ */
+status_t FLEXCAN_DRV_RecoverBusOff(uint8_t instance);
+
+/*!
+ * @brief Returns the fault confinement state of the node.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @return  The fault confinement state seen at the last update
+ */
+flexcan_fault_state_t FLEXCAN_DRV_GetFaultState(uint8_t instance);
+
+/*!
+ * @brief Reads the error counters of the node.
+ *
+ * The counters are copied with the interrupts disabled, the traffic is not
+ * stopped.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   counters   The error counters
+ */
+void FLEXCAN_DRV_GetErrorCounters(uint8_t instance, flexcan_error_counters_t *counters);
+
+/*@}*/
+
+/*!
+ * @name Timestamps and latency
+ * @{
+ */
+
+/*!
+ * @brief Installs the time base used to timestamp the frames.
+ *
+ * Once installed, the 16-bit timestamp of every received or sent frame is
+ * extended to a 64-bit time of the time base: the age of the frame is read from
+ * the free running timer, so a frame must be serviced less than 65536 bit times
+ * after it was on the bus. The frames of a Rx FIFO batch moved by the eDMA are
+ * dated from the last one, each from the frame following it, so for them the
+ * limit applies to the gap between consecutive frames; an older frame is
+ * never dated after a newer one. Received frames carry the time in their timestamp
+ * field and the time of the last frame of a MB is returned by
+ * FLEXCAN_DRV_GetMsgBuffTimestamp. The getTime function is called from the
+ * interrupt handler.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   timeBase   The time base, or NULL to stop timestamping
+ */
+void FLEXCAN_DRV_InstallTimeBase(uint8_t instance, const flexcan_time_base_t *timeBase);
+
+/*!
+ * @brief Returns the time of the last frame received or sent by a message buffer.
+ *
+ * For a Tx MB this is the time the frame started on the bus; it is valid from
+ * the FLEXCAN_EVENT_TX_COMPLETE callback on.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   mb_idx     The index of the message buffer
+ * @return  The time of the frame in time base ticks, 0 if no time base is installed
+ */
+uint64_t FLEXCAN_DRV_GetMsgBuffTimestamp(uint8_t instance, uint8_t mb_idx);
+
+/*!
+ * @brief Starts the latency histograms of the message buffers.
+ *
+ * The interrupt handler records, for the first count MBs, the queue-to-wire
+ * latency of the sent frames (from the send request, or from the transmit queue,
+ * to the start of the frame on the bus) and the wire-to-callback latency of the
+ * received frames (the Rx FIFO uses the histogram of MB 0). A time base must be
+ * installed.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   hist       Storage for count histograms, or NULL to stop recording
+ * @param   count      Number of histograms
+ */
+void FLEXCAN_DRV_ConfigLatencyHistograms(
+    uint8_t instance,
+    flexcan_latency_hist_t *hist,
+    uint32_t count);
+
+/*!
+ * @brief Reads the latency histogram of a message buffer.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   mb_idx     The index of the message buffer
+ * @param   hist       A consistent copy of the histogram
+ * @return  STATUS_SUCCESS if successful;
+ *          STATUS_ERROR if the MB has no latency histogram
+ */
+status_t FLEXCAN_DRV_GetLatencyHistogram(
+    uint8_t instance,
+    uint8_t mb_idx,
+    flexcan_latency_hist_t *hist);
+
+/*@}*/
+
 /*!
  * @name IRQ handler callback
  * @{
@@ -763,6 +1621,70 @@ void FLEXCAN_DRV_ConfigPN(uint8_t instance, bool enable, const flexcan_pn_config
  */
 void FLEXCAN_DRV_GetWMB(uint8_t instance, uint8_t wmbIndex, flexcan_msgbuff_t *wmb);
 
+/*!
+ * @brief Compiles wake rules into a Pretended Networking configuration.
+ *
+ * The ID ranges of the rules are merged into the ID filter (a range, or an
+ * exact match with a mask if it accepts fewer IDs) and their payload
+ * conditions into the DLC range and the masked payload filter. The filter
+ * wakes up on the first matching frame. When the hardware filter accepts more
+ * frames than the rules, exact is false and the wake-up frames should be
+ * checked with FLEXCAN_DRV_IsPNWakeRuleMatched.
+ *
+ * @param   rules         The wake rules
+ * @param   ruleCount     Number of rules
+ * @param   matchTimeout  Timeout, in units of 64 CAN bit times, after which the
+ *                        system wakes up without match (0 to disable it)
+ * @param   pnConfig      The Pretended Networking configuration
+ * @param   exact         Set to true if the configuration accepts exactly the
+ *                        frames matching the rules
+ * @return  STATUS_SUCCESS if successful;
+ *          STATUS_ERROR if the rules mix standard and extended IDs, or check
+ *          payload bytes beyond their lowest payload size
+ */
+status_t FLEXCAN_DRV_CompilePNWakeRules(const flexcan_pn_wake_rule_t *rules,
+                                        uint32_t ruleCount,
+                                        uint16_t matchTimeout,
+                                        flexcan_pn_config_t *pnConfig,
+                                        bool *exact);
+
+/*!
+ * @brief Checks a frame against wake rules.
+ *
+ * @param   rules      The wake rules
+ * @param   ruleCount  Number of rules
+ * @param   frame      The frame, for instance read with FLEXCAN_DRV_GetWMB
+ * @return  true if the frame matches one of the rules
+ */
+bool FLEXCAN_DRV_IsPNWakeRuleMatched(const flexcan_pn_wake_rule_t *rules,
+                                     uint32_t ruleCount,
+                                     const flexcan_msgbuff_t *frame);
+
+/*!
+ * @brief Reads the frames which matched the Pretended Networking filter.
+ *
+ * @param   instance  The FlexCAN instance number.
+ * @param   frames    Storage for the frames; it must hold CAN_WMB_COUNT frames
+ * @return  The number of frames read
+ */
+uint8_t FLEXCAN_DRV_GetWakeUpFrames(uint8_t instance, flexcan_msgbuff_t *frames);
+
+/*!
+ * @brief Power manager callback keeping a FlexCAN instance listening in the stop modes.
+ *
+ * Register it with POWER_MANAGER_CALLBACK_BEFORE_AFTER and a
+ * flexcan_pn_power_config_t as callback data. Pretended Networking is enabled
+ * with the configured filter before the system enters a stop mode, and
+ * disabled when it is back in a run mode or when the mode change is aborted,
+ * so the application can answer the wake-up frames right away.
+ *
+ * @param   notify   The power manager notification
+ * @param   dataPtr  The flexcan_pn_power_config_t of the instance
+ * @return  STATUS_SUCCESS
+ */
+status_t FLEXCAN_DRV_PNPowerCallback(power_manager_notify_struct_t *notify,
+                                     power_manager_callback_data_t *dataPtr);
+
 /*@}*/
 
 #endif /* FEATURE_CAN_HAS_PRETENDED_NETWORKING */
@@ -0,0 +1,248 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FLEXCAN_ISOTP_H
+#define FLEXCAN_ISOTP_H
+
+#include "flexcan_driver.h"
+
+/*!
+ * @defgroup flexcan_isotp FlexCAN ISO-TP
+ * @ingroup flexcan
+ * @addtogroup flexcan_isotp
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Default N_As/N_Ar/N_Bs/N_Cr timeout, in milliseconds */
+#define FLEXCAN_ISOTP_TIMEOUT_MS    1000U
+
+/*! @brief The type of the event which occurred when the ISO-TP callback was invoked.
+ * Implements : flexcan_isotp_event_t_Class
+ */
+typedef enum {
+    FLEXCAN_ISOTP_EVENT_TX_COMPLETE,    /*!< The message handed to FLEXCAN_ISOTP_Send was sent. */
+    FLEXCAN_ISOTP_EVENT_RX_COMPLETE,    /*!< A message was reassembled in the channel Rx buffer. */
+    FLEXCAN_ISOTP_EVENT_TX_ERROR,       /*!< The transmission was aborted (timeout, overflow or bad flow control). */
+    FLEXCAN_ISOTP_EVENT_RX_ERROR        /*!< The reception was aborted (timeout, sequence error or overflow). */
+} flexcan_isotp_event_t;
+
+/*! @brief Transmit state of an ISO-TP channel.
+ * Implements : flexcan_isotp_tx_state_t_Class
+ */
+typedef enum {
+    FLEXCAN_ISOTP_TX_IDLE,              /*!< No message is being sent. */
+    FLEXCAN_ISOTP_TX_READY,             /*!< The next consecutive frame can be sent. */
+    FLEXCAN_ISOTP_TX_SENDING,           /*!< A single, first or consecutive frame is in the Tx MB. */
+    FLEXCAN_ISOTP_TX_WAIT_FC,           /*!< Waiting for a flow control frame of the receiver. */
+    FLEXCAN_ISOTP_TX_WAIT_STMIN         /*!< Waiting for the separation time of the receiver. */
+} flexcan_isotp_tx_state_t;
+
+/*! @brief ISO-TP channel configuration
+ * Implements : flexcan_isotp_channel_config_t_Class
+ */
+typedef struct {
+    uint32_t txId;                      /*!< ID of the frames sent by the channel */
+    uint32_t rxId;                      /*!< ID of the frames received by the channel */
+    flexcan_msgbuff_id_type_t idType;   /*!< Type of the IDs (standard or extended) */
+    uint8_t txMb;                       /*!< MB used for the data and flow control frames sent */
+    uint8_t rxMb;                       /*!< MB used for the frames received */
+    uint8_t txDataLength;               /*!< Size of the frames sent (TX_DL): 8 for classical CAN,
+                                             12, 16, 20, 24, 32, 48 or 64 for CAN FD */
+    bool enableBrs;                     /*!< Enable bit rate switch for the CAN FD frames */
+    uint8_t padding;                    /*!< Value of the unused bytes of the frames sent */
+    uint8_t blockSize;                  /*!< Block size advertised to the sender (0: no limit) */
+    uint8_t stMin;                      /*!< Separation time advertised to the sender (ISO 15765-2 encoding) */
+    uint8_t *rxBuffer;                  /*!< Reassembly buffer of the received messages */
+    uint32_t rxBufferSize;              /*!< Size of the reassembly buffer, in bytes */
+    uint32_t timeoutMs;                 /*!< N_As, N_Ar, N_Bs and N_Cr timeout, in milliseconds */
+} flexcan_isotp_channel_config_t;
+
+/*!
+ * @brief ISO-TP channel runtime information.
+ *
+ * @note The contents of this structure are internal to the ISO-TP layer, except
+ *      rxLength which gives the size of the message reported by the
+ *      FLEXCAN_ISOTP_EVENT_RX_COMPLETE event.
+ * Implements : flexcan_isotp_channel_t_Class
+ */
+typedef struct {
+    const flexcan_isotp_channel_config_t *config; /*!< Channel configuration */
+    volatile flexcan_isotp_tx_state_t txState;    /*!< Transmit state */
+    const uint8_t *txData;              /*!< Message being sent */
+    uint32_t txLength;                  /*!< Size of the message being sent */
+    uint32_t txOffset;                  /*!< Bytes of the message loaded into frames */
+    uint32_t txTime;                    /*!< Start of the current timeout or separation time, in ms */
+    uint32_t txStMin;                   /*!< Separation time requested by the receiver, in ms */
+    uint8_t txSeqNum;                   /*!< Sequence number of the next consecutive frame */
+    uint8_t txBlockSize;                /*!< Block size requested by the receiver */
+    uint8_t txBlockLeft;                /*!< Consecutive frames left in the current block */
+    bool txMbBusy;                      /*!< A frame is in the Tx MB */
+    uint32_t txMbTime;                  /*!< Time the frame was loaded into the Tx MB (N_As/N_Ar), in ms */
+    bool txFcLatched;                   /*!< A flow control frame arrived before the end of its block was sent */
+    uint8_t txFc[3];                    /*!< The latched flow control frame */
+    bool fcPending;                     /*!< A flow control frame waits for the Tx MB */
+    uint8_t fcStatus;                   /*!< Flow status of the pending flow control frame */
+    volatile bool rxActive;             /*!< A segmented message is being received */
+    uint32_t rxLength;                  /*!< Size of the message being received */
+    uint32_t rxOffset;                  /*!< Bytes of the message received */
+    uint32_t rxTime;                    /*!< Start of the current N_Cr timeout, in ms */
+    uint8_t rxDataLength;               /*!< Size of the frames of the sender (RX_DL) */
+    uint8_t rxSeqNum;                   /*!< Sequence number of the next consecutive frame */
+    uint8_t rxBlockLeft;                /*!< Consecutive frames left before the next flow control */
+    flexcan_msgbuff_t rxFrame;          /*!< Frame read from the Rx MB */
+    uint8_t txFrame[64];                /*!< Frame being sent */
+} flexcan_isotp_channel_t;
+
+struct FlexCANIsoTpState;
+
+/*! @brief ISO-TP callback function type
+ * Implements : flexcan_isotp_callback_t_Class
+ */
+typedef void (*flexcan_isotp_callback_t)(uint8_t instance, flexcan_isotp_event_t eventType,
+                                         uint32_t channel, struct FlexCANIsoTpState *isotpState);
+
+/*!
+ * @brief ISO-TP layer state information.
+ *
+ * @note The contents of this structure are internal to the ISO-TP layer and should
+ *      not be modified by users.
+ * Implements : flexcan_isotp_state_t_Class
+ */
+typedef struct FlexCANIsoTpState {
+    uint8_t instance;                   /*!< FlexCAN instance the channels belong to */
+    flexcan_isotp_channel_t *channels;  /*!< Channels of the instance */
+    uint32_t channelCount;              /*!< Number of channels */
+    uint8_t mbChannel[FEATURE_CAN_MAX_MB_NUM]; /*!< Channel using each MB */
+    flexcan_isotp_callback_t callback;  /*!< ISO-TP event callback */
+    void *callbackParam;                /*!< Parameter used to pass user data when invoking the callback */
+    flexcan_callback_t canCallback;     /*!< Callback of the events of the MBs not used by the channels */
+} flexcan_isotp_state_t;
+
+/*! @brief ISO-TP layer configuration
+ * Implements : flexcan_isotp_user_config_t_Class
+ */
+typedef struct {
+    const flexcan_isotp_channel_config_t *channelConfigs; /*!< Configuration of each channel */
+    uint32_t channelCount;              /*!< Number of channels */
+    flexcan_isotp_callback_t callback;  /*!< ISO-TP event callback (may be NULL) */
+    void *callbackParam;                /*!< Parameter passed to the ISO-TP callback through the state */
+    flexcan_callback_t canCallback;     /*!< Callback of the events of the MBs not used by the channels
+                                             (may be NULL) */
+} flexcan_isotp_user_config_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*!
+ * @name ISO-TP
+ * @{
+ */
+
+/*!
+ * @brief Sets up the ISO 15765-2 transport layer on an initialized FlexCAN instance.
+ *
+ * Each channel sends segmented messages to txId and reassembles the ones received
+ * on rxId, both at the same time. The Rx MBs are configured and armed here, and
+ * the ISO-TP layer installs itself as the FlexCAN event callback: the frames are
+ * segmented from the TX_COMPLETE events and reassembled from the RX_COMPLETE
+ * events. The events of the other MBs are forwarded to canCallback, with the
+ * callback parameter of the FlexCAN state pointing to the ISO-TP state.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   state      Pointer to the ISO-TP state structure; it must stay valid
+ *                     while the layer is used
+ * @param   channels   Storage for the channels; it must hold config->channelCount
+ *                     entries and stay valid while the layer is used
+ * @param   config     The ISO-TP configuration
+ * @return  STATUS_SUCCESS if successful;
+ *          STATUS_CAN_BUFF_OUT_OF_RANGE if the index of a message buffer is invalid;
+ *          STATUS_BUSY if a MB of a channel is in use
+ */
+status_t FLEXCAN_ISOTP_Init(uint8_t instance,
+                            flexcan_isotp_state_t *state,
+                            flexcan_isotp_channel_t *channels,
+                            const flexcan_isotp_user_config_t *config);
+
+/*!
+ * @brief Sends a message on an ISO-TP channel.
+ *
+ * Messages which fit in one frame are sent as a single frame; the longer ones
+ * are segmented into a first frame and consecutive frames, paced by the flow
+ * control frames of the receiver. The message is not copied and must stay
+ * valid until the FLEXCAN_ISOTP_EVENT_TX_COMPLETE or FLEXCAN_ISOTP_EVENT_TX_ERROR
+ * event is reported.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   channel    Index of the channel
+ * @param   data       The message
+ * @param   length     Size of the message, in bytes
+ * @return  STATUS_SUCCESS if successful;
+ *          STATUS_BUSY if the channel is already sending a message
+ */
+status_t FLEXCAN_ISOTP_Send(uint8_t instance,
+                            uint32_t channel,
+                            const uint8_t *data,
+                            uint32_t length);
+
+/*!
+ * @brief Returns the state of the last message sent on an ISO-TP channel.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   channel    Index of the channel
+ * @return  STATUS_SUCCESS if the channel is not sending;
+ *          STATUS_BUSY if a message is being sent
+ */
+status_t FLEXCAN_ISOTP_GetTransferStatus(uint8_t instance, uint32_t channel);
+
+/*!
+ * @brief Runs the time-dependent part of the ISO-TP channels.
+ *
+ * Resumes the transmissions waiting for a non-zero separation time and aborts
+ * the transfers whose N_Bs or N_Cr timeout expired. A frame which did not
+ * leave the Tx MB within the timeout (N_As, or N_Ar for a flow control frame)
+ * is taken back from the MB, and the message it belongs to is aborted with a
+ * FLEXCAN_ISOTP_EVENT_TX_ERROR or FLEXCAN_ISOTP_EVENT_RX_ERROR event. It should
+ * be called periodically, at least once per millisecond when the receivers
+ * request a separation time; the transfers without separation time are driven
+ * by the FlexCAN interrupts only.
+ *
+ * @param   instance   A FlexCAN instance number
+ */
+void FLEXCAN_ISOTP_MainFunction(uint8_t instance);
+
+/*@}*/
+
+#if defined(__cplusplus)
+}
+#endif
+
+/*! @}*/
+
+#endif /* FLEXCAN_ISOTP_H */
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
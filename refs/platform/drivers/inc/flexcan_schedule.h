@@ -0,0 +1,198 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FLEXCAN_SCHEDULE_H
+#define FLEXCAN_SCHEDULE_H
+
+#include "flexcan_driver.h"
+#include "lpit_driver.h"
+
+/*!
+ * @defgroup flexcan_schedule FlexCAN time-triggered schedule
+ * @ingroup flexcan
+ * @addtogroup flexcan_schedule
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Fills the payload of the frame of a slot.
+ *
+ * The function writes the data_length bytes of the slot frame into data and
+ * returns true, or returns false to leave the slot empty for this cycle.
+ * Implements : flexcan_sched_producer_t_Class
+ */
+typedef bool (*flexcan_sched_producer_t)(uint8_t instance, uint32_t slot, uint8_t *data, void *param);
+
+/*! @brief Slot of a time-triggered schedule
+ * Implements : flexcan_sched_slot_config_t_Class
+ */
+typedef struct {
+    uint32_t offset;                    /*!< Start of the slot from the start of the cycle, in LPIT counts */
+    uint8_t mbIdx;                      /*!< Tx MB the frame is sent from */
+    uint32_t msgId;                     /*!< ID of the frame */
+    flexcan_data_info_t txInfo;         /*!< Data info of the frame */
+    flexcan_sched_producer_t producer;  /*!< Fills the payload of the frame */
+    void *producerParam;                /*!< Parameter passed to the producer */
+} flexcan_sched_slot_config_t;
+
+/*! @brief Time-triggered schedule configuration
+ * Implements : flexcan_sched_config_t_Class
+ */
+typedef struct {
+    const flexcan_sched_slot_config_t *slots; /*!< Slots, sorted by increasing offset */
+    uint32_t slotCount;                 /*!< Number of slots */
+    uint32_t cycleLength;               /*!< Length of the cycle, in LPIT counts */
+    uint32_t lpitInstance;              /*!< LPIT instance timing the slots */
+    uint32_t lpitChannel;               /*!< LPIT channel timing the slots */
+} flexcan_sched_config_t;
+
+/*!
+ * @brief Slot runtime information and statistics.
+ *
+ * The latency is the delay between the start of the slot, when the LPIT
+ * channel expires, and the write of the MB CODE; its spread (maxLatency -
+ * minLatency) is the jitter of the slot.
+ * Implements : flexcan_sched_slot_t_Class
+ */
+typedef struct {
+    volatile bool loaded;               /*!< The frame of the slot is loaded into its MB */
+    uint32_t sent;                      /*!< Frames sent at the slot time */
+    uint32_t empty;                     /*!< Cycles the producer left the slot empty */
+    uint32_t missed;                    /*!< Cycles the frame was not ready at the slot time */
+    uint32_t lastLatency;               /*!< Latency of the last frame sent, in LPIT counts */
+    uint32_t minLatency;                /*!< Lowest latency, in LPIT counts */
+    uint32_t maxLatency;                /*!< Highest latency, in LPIT counts */
+} flexcan_sched_slot_t;
+
+/*!
+ * @brief Time-triggered schedule state information.
+ *
+ * @note The contents of this structure are internal to the schedule and should
+ *      not be modified by users.
+ * Implements : flexcan_sched_state_t_Class
+ */
+typedef struct {
+    const flexcan_sched_config_t *config; /*!< Schedule configuration */
+    flexcan_sched_slot_t *slots;        /*!< Runtime information of the slots */
+    volatile uint32_t fireSlot;         /*!< Slot started at the next LPIT expiry */
+    volatile uint32_t loadSlot;         /*!< Next slot whose frame is produced */
+    volatile uint32_t pending;          /*!< Slots produced and not started yet */
+    volatile uint32_t cycles;           /*!< Cycles completed since the start */
+} flexcan_sched_state_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*!
+ * @name Time-triggered schedule
+ * @{
+ */
+
+/*!
+ * @brief Sets up a time-triggered transmit schedule on an initialized FlexCAN instance.
+ *
+ * Each slot sends one frame per cycle from its MB. The producers fill the
+ * frames ahead of their slot from FLEXCAN_SCHED_MainFunction, and the frames
+ * are loaded into the MBs; at the slot time, the LPIT interrupt only writes
+ * the MB CODE. The LPIT module must be initialized with LPIT_DRV_Init; the
+ * channel is configured here, and its interrupt handler must call
+ * FLEXCAN_SCHED_IRQHandler. Two consecutive slots should be further apart
+ * than the latency of the LPIT interrupt.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   state      Pointer to the schedule state structure; it must stay
+ *                     valid while the schedule is used
+ * @param   slots      Storage for the slots; it must hold config->slotCount
+ *                     entries and stay valid while the schedule is used
+ * @param   config     The schedule configuration
+ * @return  STATUS_SUCCESS if successful;
+ *          STATUS_ERROR if the LPIT channel could not be configured
+ */
+status_t FLEXCAN_SCHED_Init(uint8_t instance,
+                            flexcan_sched_state_t *state,
+                            flexcan_sched_slot_t *slots,
+                            const flexcan_sched_config_t *config);
+
+/*!
+ * @brief Starts the schedule.
+ *
+ * The first cycle starts one slot gap after this call, the gap between the
+ * last slot of a cycle and the first slot of the next one. Calling
+ * FLEXCAN_SCHED_MainFunction before loads the first frames.
+ *
+ * @param   instance   A FlexCAN instance number
+ */
+void FLEXCAN_SCHED_Start(uint8_t instance);
+
+/*!
+ * @brief Stops the schedule and discards the frames loaded into the MBs.
+ *
+ * @param   instance   A FlexCAN instance number
+ */
+void FLEXCAN_SCHED_Stop(uint8_t instance);
+
+/*!
+ * @brief Produces the frames of the next slots.
+ *
+ * Calls the producers of the next slots, in the slot order, and loads their
+ * frames into the MBs, up to one cycle ahead. A slot waits for the frame of
+ * the previous slot using its MB to be sent. It should be called from the
+ * background, often enough to keep the frames ready for their slots.
+ *
+ * @param   instance   A FlexCAN instance number
+ */
+void FLEXCAN_SCHED_MainFunction(uint8_t instance);
+
+/*!
+ * @brief Starts the slot of the LPIT expiry.
+ *
+ * This function must be called from the interrupt handler of the LPIT channel.
+ *
+ * @param   instance   A FlexCAN instance number
+ */
+void FLEXCAN_SCHED_IRQHandler(uint8_t instance);
+
+/*!
+ * @brief Reads the statistics of a slot.
+ *
+ * @param   instance   A FlexCAN instance number
+ * @param   slot       Index of the slot
+ * @param   stats      The statistics of the slot
+ */
+void FLEXCAN_SCHED_GetSlotStats(uint8_t instance, uint32_t slot, flexcan_sched_slot_t *stats);
+
+/*@}*/
+
+#if defined(__cplusplus)
+}
+#endif
+
+/*! @}*/
+
+#endif /* FLEXCAN_SCHEDULE_H */
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
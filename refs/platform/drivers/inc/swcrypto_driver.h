@@ -0,0 +1,219 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SWCRYPTO_DRV_H
+#define SWCRYPTO_DRV_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "device_registers.h"
+#include "status.h"
+
+/*! @file */
+
+/*!
+ * @defgroup swcrypto_driver Software Crypto Driver
+ * @ingroup security_pal
+ * @brief Software implementation of the AES-128 and CMAC services of the CSEc.
+ *
+ * The cipher is bitsliced: it uses neither lookup tables nor branches that
+ * depend on the keys or the data, so its timing does not leak them, on the
+ * Cortex-M4 as well as on a host CPU. Two blocks are processed at once, which
+ * doubles the throughput of ECB and of CBC decryption.
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Size of an AES block and of an AES-128 key, in bytes. */
+#define SWCRYPTO_BLOCK_SIZE           (16U)
+/*! @brief Number of key slots; the key IDs of the CSEc are valid slot numbers. */
+#define SWCRYPTO_KEY_SLOTS            (32U)
+/*! @brief Key slot matching the RAM key of the CSEc. */
+#define SWCRYPTO_RAM_KEY              (0xFU)
+/*! @brief Number of AES-128 rounds. */
+#define SWCRYPTO_AES_ROUNDS           (10U)
+
+/*!
+ * @brief Internal driver state information.
+ *
+ * @note The contents of this structure are internal to the driver and should not be
+ *      modified by users.
+ *
+ * Implements : swcrypto_state_t_Class
+ */
+typedef struct {
+    uint8_t keys[SWCRYPTO_KEY_SLOTS][SWCRYPTO_BLOCK_SIZE]; /*!< Key of each slot */
+    uint32_t loadedKeys;          /*!< Specifies which slots hold a key (one bit per slot) */
+    uint32_t roundKeys[(SWCRYPTO_AES_ROUNDS + 1U) * 8U]; /*!< Bitsliced round keys of the last key used */
+    uint32_t roundKeysId;         /*!< Specifies the slot of the round keys */
+    bool roundKeysValid;          /*!< Specifies if the round keys match the key of their slot */
+} swcrypto_state_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*!
+ * @brief Initializes the internal state of the driver.
+ *
+ * All the key slots are empty after the initialization.
+ *
+ * @param[in] state Pointer to the state structure which will be used for holding
+ * the internal state of the driver.
+ */
+void SWCRYPTO_DRV_Init(swcrypto_state_t *state);
+
+/*!
+ * @brief Clears the internal state of the driver, keys included.
+ */
+void SWCRYPTO_DRV_Deinit(void);
+
+/*!
+ * @brief Loads a plain 128-bit key in a key slot.
+ *
+ * There is no key update protocol: the slots are meant to be provisioned by the
+ * application, e.g. with the RAM key also loaded in the CSEc, or with test keys
+ * on a host.
+ *
+ * @param[in] keyId Slot of the key.
+ * @param[in] key Pointer to the 128-bit key.
+ */
+void SWCRYPTO_DRV_LoadKey(uint32_t keyId, const uint8_t *key);
+
+/*!
+ * @brief Performs the AES-128 encryption in ECB mode.
+ *
+ * @param[in] keyId Slot of the key used to perform the operation.
+ * @param[in] plainText Pointer to the plain text buffer.
+ * @param[in] length Number of bytes of plain text message to be encrypted.
+ * It should be multiple of 16 bytes.
+ * @param[out] cipherText Pointer to the cipher text buffer; it may be the plain
+ * text buffer.
+ * @return STATUS_SUCCESS, or STATUS_SEC_KEY_EMPTY if the slot holds no key.
+ */
+status_t SWCRYPTO_DRV_EncryptECB(uint32_t keyId,
+                                 const uint8_t *plainText,
+                                 uint32_t length,
+                                 uint8_t *cipherText);
+
+/*!
+ * @brief Performs the AES-128 decryption in ECB mode.
+ *
+ * @param[in] keyId Slot of the key used to perform the operation.
+ * @param[in] cipherText Pointer to the cipher text buffer.
+ * @param[in] length Number of bytes of cipher text message to be decrypted.
+ * It should be multiple of 16 bytes.
+ * @param[out] plainText Pointer to the plain text buffer; it may be the cipher
+ * text buffer.
+ * @return STATUS_SUCCESS, or STATUS_SEC_KEY_EMPTY if the slot holds no key.
+ */
+status_t SWCRYPTO_DRV_DecryptECB(uint32_t keyId,
+                                 const uint8_t *cipherText,
+                                 uint32_t length,
+                                 uint8_t *plainText);
+
+/*!
+ * @brief Performs the AES-128 encryption in CBC mode.
+ *
+ * @param[in] keyId Slot of the key used to perform the operation.
+ * @param[in] plainText Pointer to the plain text buffer.
+ * @param[in] length Number of bytes of plain text message to be encrypted.
+ * It should be multiple of 16 bytes.
+ * @param[in] iv Pointer to the initialization vector buffer.
+ * @param[out] cipherText Pointer to the cipher text buffer; it may be the plain
+ * text buffer.
+ * @return STATUS_SUCCESS, or STATUS_SEC_KEY_EMPTY if the slot holds no key.
+ */
+status_t SWCRYPTO_DRV_EncryptCBC(uint32_t keyId,
+                                 const uint8_t *plainText,
+                                 uint32_t length,
+                                 const uint8_t *iv,
+                                 uint8_t *cipherText);
+
+/*!
+ * @brief Performs the AES-128 decryption in CBC mode.
+ *
+ * @param[in] keyId Slot of the key used to perform the operation.
+ * @param[in] cipherText Pointer to the cipher text buffer.
+ * @param[in] length Number of bytes of cipher text message to be decrypted.
+ * It should be multiple of 16 bytes.
+ * @param[in] iv Pointer to the initialization vector buffer.
+ * @param[out] plainText Pointer to the plain text buffer; it may be the cipher
+ * text buffer.
+ * @return STATUS_SUCCESS, or STATUS_SEC_KEY_EMPTY if the slot holds no key.
+ */
+status_t SWCRYPTO_DRV_DecryptCBC(uint32_t keyId,
+                                 const uint8_t *cipherText,
+                                 uint32_t length,
+                                 const uint8_t *iv,
+                                 uint8_t *plainText);
+
+/*!
+ * @brief Calculates the MAC of a given message using CMAC with AES-128.
+ *
+ * @param[in] keyId Slot of the key used to perform the operation.
+ * @param[in] msg Pointer to the message buffer.
+ * @param[in] msgLen Number of bits of message on which CMAC will be computed.
+ * @param[out] cmac Pointer to the buffer containing the result of the CMAC
+ * computation.
+ * @return STATUS_SUCCESS, or STATUS_SEC_KEY_EMPTY if the slot holds no key.
+ */
+status_t SWCRYPTO_DRV_GenerateMAC(uint32_t keyId,
+                                  const uint8_t *msg,
+                                  uint32_t msgLen,
+                                  uint8_t *cmac);
+
+/*!
+ * @brief Verifies the MAC of a given message using CMAC with AES-128.
+ *
+ * The MAC is compared in constant time.
+ *
+ * @param[in] keyId Slot of the key used to perform the operation.
+ * @param[in] msg Pointer to the message buffer.
+ * @param[in] msgLen Number of bits of message on which CMAC will be computed.
+ * @param[in] mac Pointer to the buffer containing the CMAC to be verified.
+ * @param[in] macLen Number of bits of the CMAC to be compared. A macLength
+ * value of zero indicates that all 128-bits are compared.
+ * @param[out] verifStatus Status of MAC verification (true: verification
+ * operation passed, false: verification operation failed).
+ * @return STATUS_SUCCESS, or STATUS_SEC_KEY_EMPTY if the slot holds no key.
+ */
+status_t SWCRYPTO_DRV_VerifyMAC(uint32_t keyId,
+                                const uint8_t *msg,
+                                uint32_t msgLen,
+                                const uint8_t *mac,
+                                uint16_t macLen,
+                                bool *verifStatus);
+
+#if defined(__cplusplus)
+}
+#endif
+
+/*! @}*/
+
+#endif /* SWCRYPTO_DRV_H */
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
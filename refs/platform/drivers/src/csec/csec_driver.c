@@ -118,6 +118,23 @@ static void CSEC_DRV_StartGenMACCmd(void);
 static void CSEC_DRV_ContinueGenMACCmd(void);
 static void CSEC_DRV_StartVerifMACCmd(void);
 static void CSEC_DRV_ContinueVerifMACCmd(void);
+static void CSEC_DRV_InitSealState(csec_key_id_t keyId,
+                                   const uint8_t * plainText,
+                                   uint32_t length,
+                                   uint8_t * payload);
+static void CSEC_DRV_ContinueSealCmd(void);
+static bool CSEC_DRV_IsCmdInProgress(void);
+static void CSEC_DRV_StartRNDRefillCmd(void);
+static void CSEC_DRV_ContinueRNDRefillCmd(void);
+static void CSEC_DRV_StartNextJob(void);
+static void CSEC_DRV_InitMACSession(csec_mac_session_t * session,
+                                    csec_cmd_t cmd,
+                                    csec_key_id_t keyId,
+                                    uint32_t msgLen);
+static void CSEC_DRV_RunMACSession(csec_mac_session_t * session);
+static bool CSEC_DRV_StartMACSessionCmd(void);
+static void CSEC_DRV_ContinueMACSessionCmd(void);
+static void CSEC_DRV_ContinueAddrModeMACCmd(void);
 
 /*******************************************************************************
  * Code
@@ -133,10 +150,23 @@ static void CSEC_DRV_ContinueVerifMACCmd(void);
  * END**************************************************************************/
 void CSEC_DRV_Init(csec_state_t * state)
 {
+    uint32_t prio;
+
     DEV_ASSERT(state != NULL);
 
     g_csecStatePtr = state;
     g_csecStatePtr->cmdInProgress = false;
+    g_csecStatePtr->seal = false;
+    g_csecStatePtr->rndPool = NULL;
+    g_csecStatePtr->rndRefill = false;
+    g_csecStatePtr->job = NULL;
+    for (prio = 0U; prio < CSEC_JOB_PRIORITY_COUNT; prio++)
+    {
+        g_csecStatePtr->jobHead[prio] = NULL;
+        g_csecStatePtr->jobTail[prio] = NULL;
+    }
+    g_csecStatePtr->macSession = NULL;
+    g_csecStatePtr->addrMode = false;
 
     INT_SYS_EnableIRQ(FTFC_IRQn);
 
@@ -179,7 +209,7 @@ status_t CSEC_DRV_EncryptECB(csec_key_id_t keyId,
     uint32_t startTime = 0;
     uint32_t crtTime = 0;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -232,7 +262,7 @@ status_t CSEC_DRV_DecryptECB(csec_key_id_t keyId,
     uint32_t startTime = 0;
     uint32_t crtTime = 0;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -286,7 +316,7 @@ status_t CSEC_DRV_EncryptCBC(csec_key_id_t keyId,
     uint32_t startTime = 0;
     uint32_t crtTime = 0;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -342,7 +372,7 @@ status_t CSEC_DRV_DecryptCBC(csec_key_id_t keyId,
     uint32_t startTime = 0;
     uint32_t crtTime = 0;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -396,7 +426,7 @@ status_t CSEC_DRV_GenerateMAC(csec_key_id_t keyId,
     uint32_t startTime = 0;
     uint32_t crtTime = 0;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -450,7 +480,7 @@ status_t CSEC_DRV_GenerateMACAddrMode(csec_key_id_t keyId,
 
     status_t stat;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -500,7 +530,7 @@ status_t CSEC_DRV_VerifyMAC(csec_key_id_t keyId,
     uint32_t startTime = 0;
     uint32_t crtTime = 0;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -561,7 +591,7 @@ status_t CSEC_DRV_VerifyMACAddrMode(csec_key_id_t keyId,
 
     status_t stat;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -616,7 +646,7 @@ status_t CSEC_DRV_LoadKey(csec_key_id_t keyId,
     DEV_ASSERT(m5 != NULL);
     DEV_ASSERT(g_csecStatePtr != NULL);
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -661,7 +691,7 @@ status_t CSEC_DRV_LoadPlainKey(const uint8_t * plainKey)
 
     status_t stat;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -706,7 +736,7 @@ status_t CSEC_DRV_ExportRAMKey(uint8_t * m1,
 
     status_t stat;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -749,7 +779,7 @@ status_t CSEC_DRV_InitRNG()
 
     status_t stat;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -787,7 +817,7 @@ status_t CSEC_DRV_ExtendSeed(const uint8_t * entropy)
 
     status_t stat;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -825,7 +855,7 @@ status_t CSEC_DRV_GenerateRND(uint8_t * rnd)
 
     status_t stat;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -850,6 +880,63 @@ status_t CSEC_DRV_GenerateRND(uint8_t * rnd)
     return stat;
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_Seal
+ * Description   : This function encrypts a message in CBC mode under a random
+ * IV and computes the CMAC of the IV and the cipher text, chaining the RND,
+ * ENC_CBC and GENERATE_MAC commands.
+ *
+ * Implements    : CSEC_DRV_Seal_Activity
+ * END**************************************************************************/
+status_t CSEC_DRV_Seal(csec_key_id_t keyId,
+                       const uint8_t * plainText,
+                       uint32_t length,
+                       uint8_t * payload,
+                       uint32_t timeout)
+{
+    DEV_ASSERT(plainText != NULL);
+    DEV_ASSERT(payload != NULL);
+    DEV_ASSERT((length > 0U) && (length <= CSEC_SEAL_MAX_DATA_SIZE));
+    DEV_ASSERT((length & (CSEC_PAGE_SIZE_IN_BYTES - 1U)) == 0U);
+    DEV_ASSERT(g_csecStatePtr != NULL);
+
+    uint32_t startTime = 0;
+    uint32_t crtTime = 0;
+
+    if (CSEC_DRV_IsCmdInProgress())
+    {
+        return STATUS_BUSY;
+    }
+
+    /* Initialize the internal state of the driver */
+    CSEC_DRV_InitSealState(keyId, plainText, length, payload);
+
+    startTime = OSIF_GetMilliseconds();
+
+    /* Write the command header. This will trigger the command execution. */
+    CSEC_WriteCommandHeader(CSEC_CMD_RND, CSEC_FUNC_FORMAT_COPY, CSEC_CALL_SEQ_FIRST, CSEC_SECRET_KEY);
+
+    while (g_csecStatePtr->cmdInProgress)
+    {
+        /* Wait until the execution of the command is complete */
+        CSEC_WaitCommandCompletion();
+
+        crtTime = OSIF_GetMilliseconds();
+        if (crtTime > (startTime + timeout))
+        {
+            CSEC_DRV_CancelCommand();
+
+            g_csecStatePtr->errCode = STATUS_TIMEOUT;
+            break;
+        }
+
+        CSEC_DRV_ContinueSealCmd();
+    }
+
+    return g_csecStatePtr->errCode;
+}
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : CSEC_DRV_BootFailure
@@ -864,7 +951,7 @@ status_t CSEC_DRV_BootFailure()
 
     status_t stat;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -898,7 +985,7 @@ status_t CSEC_DRV_BootOK()
 
     status_t stat;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -934,7 +1021,7 @@ status_t CSEC_DRV_BootDefine(uint32_t bootSize,
     uint8_t flavor = (uint8_t)bootFlavor;
     status_t stat;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -978,7 +1065,7 @@ status_t CSEC_DRV_GetID(const uint8_t * challenge,
 
     status_t stat;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -1024,7 +1111,7 @@ status_t CSEC_DRV_DbgChal(uint8_t * challenge)
 
     status_t stat;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -1064,7 +1151,7 @@ status_t CSEC_DRV_DbgAuth(const uint8_t * authorization)
 
     status_t stat;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -1110,7 +1197,7 @@ status_t CSEC_DRV_MPCompress(const uint8_t * msg,
     uint32_t index = 0;
     uint16_t numPagesLeft = msgLen;
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -1187,7 +1274,7 @@ status_t CSEC_DRV_EncryptECBAsync(csec_key_id_t keyId,
     DEV_ASSERT(cipherText != NULL);
     DEV_ASSERT(g_csecStatePtr != NULL);
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -1219,7 +1306,7 @@ status_t CSEC_DRV_DecryptECBAsync(csec_key_id_t keyId,
     DEV_ASSERT(cipherText != NULL);
     DEV_ASSERT(g_csecStatePtr != NULL);
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -1253,7 +1340,7 @@ status_t CSEC_DRV_EncryptCBCAsync(csec_key_id_t keyId,
     DEV_ASSERT(iv != NULL);
     DEV_ASSERT(g_csecStatePtr != NULL);
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -1288,7 +1375,7 @@ status_t CSEC_DRV_DecryptCBCAsync(csec_key_id_t keyId,
     DEV_ASSERT(iv != NULL);
     DEV_ASSERT(g_csecStatePtr != NULL);
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -1321,7 +1408,7 @@ status_t CSEC_DRV_GenerateMACAsync(csec_key_id_t keyId,
     DEV_ASSERT(cmac != NULL);
     DEV_ASSERT(g_csecStatePtr != NULL);
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -1357,7 +1444,7 @@ status_t CSEC_DRV_VerifyMACAsync(csec_key_id_t keyId,
     DEV_ASSERT(verifStatus != NULL);
     DEV_ASSERT(g_csecStatePtr != NULL);
 
-    if (g_csecStatePtr->cmdInProgress)
+    if (CSEC_DRV_IsCmdInProgress())
     {
         return STATUS_BUSY;
     }
@@ -1377,6 +1464,42 @@ status_t CSEC_DRV_VerifyMACAsync(csec_key_id_t keyId,
     return STATUS_SUCCESS;
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_SealAsync
+ * Description   : This function starts the encryption of a message in CBC mode
+ * under a random IV followed by the CMAC computation of the IV and the cipher
+ * text, in an asynchronous manner.
+ *
+ * Implements    : CSEC_DRV_SealAsync_Activity
+ * END**************************************************************************/
+status_t CSEC_DRV_SealAsync(csec_key_id_t keyId,
+                            const uint8_t * plainText,
+                            uint32_t length,
+                            uint8_t * payload)
+{
+    DEV_ASSERT(plainText != NULL);
+    DEV_ASSERT(payload != NULL);
+    DEV_ASSERT((length > 0U) && (length <= CSEC_SEAL_MAX_DATA_SIZE));
+    DEV_ASSERT((length & (CSEC_PAGE_SIZE_IN_BYTES - 1U)) == 0U);
+    DEV_ASSERT(g_csecStatePtr != NULL);
+
+    if (CSEC_DRV_IsCmdInProgress())
+    {
+        return STATUS_BUSY;
+    }
+
+    CSEC_DRV_InitSealState(keyId, plainText, length, payload);
+
+    /* Write the command header. This will trigger the command execution. */
+    CSEC_WriteCommandHeader(CSEC_CMD_RND, CSEC_FUNC_FORMAT_COPY, CSEC_CALL_SEQ_FIRST, CSEC_SECRET_KEY);
+
+    /* Enable interrupt */
+    CSEC_SetInterrupt(true);
+
+    return STATUS_SUCCESS;
+}
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : CSEC_DRV_GetAsyncCmdStatus
@@ -1389,7 +1512,8 @@ status_t CSEC_DRV_GetAsyncCmdStatus()
 {
     DEV_ASSERT(g_csecStatePtr != NULL);
 
-    if (!g_csecStatePtr->cmdInProgress)
+    /* A pool refill does not change the status of the last command */
+    if ((!g_csecStatePtr->cmdInProgress) || g_csecStatePtr->rndRefill)
     {
         return g_csecStatePtr->errCode;
     }
@@ -1420,6 +1544,27 @@ static void CSEC_DRV_InitState(csec_key_id_t keyId,
     g_csecStatePtr->index = 0U;
     g_csecStatePtr->errCode = STATUS_SUCCESS;
     g_csecStatePtr->seq = CSEC_CALL_SEQ_FIRST;
+    g_csecStatePtr->seal = false;
+    g_csecStatePtr->addrMode = false;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_InitSealState
+ * Description   : Initializes the internal state of the driver for a seal
+ * operation, starting with the RND command.
+ *
+ * END**************************************************************************/
+static void CSEC_DRV_InitSealState(csec_key_id_t keyId,
+                                   const uint8_t * plainText,
+                                   uint32_t length,
+                                   uint8_t * payload)
+{
+    CSEC_DRV_InitState(keyId, CSEC_CMD_RND, plainText, payload, length);
+    g_csecStatePtr->seal = true;
+    /* Each step is a single command, so there is no call sequence to break
+     * when the operation is cancelled */
+    g_csecStatePtr->partSize = length;
 }
 
 /*FUNCTION**********************************************************************
@@ -1432,11 +1577,42 @@ static void CSEC_DRV_InitState(csec_key_id_t keyId,
 void FTFC_IRQHandler(void)
 {
     uint8_t fstat = (uint8_t)(FTFC->FSTAT & FTFC_FSTAT_CCIF_MASK);
+    bool completed = false;
+    bool wasRefill = false;
+    bool stepDone = false;
+    csec_job_t * job = NULL;
+    csec_mac_session_t * session = NULL;
+    csec_cmd_t cmd = CSEC_CMD_ENC_ECB;
+
+    /* Keep the jobs submitted from higher priority interrupts from starting
+     * until the completed command is accounted for */
+    INT_SYS_DisableIRQGlobal();
 
     /* Previous command execution ended, continue execution */
     if ((fstat != 0U) && g_csecStatePtr->cmdInProgress)
     {
-        if ((g_csecStatePtr->cmd == CSEC_CMD_ENC_ECB) || (g_csecStatePtr->cmd == CSEC_CMD_DEC_ECB))
+        wasRefill = g_csecStatePtr->rndRefill;
+        job = g_csecStatePtr->job;
+        session = g_csecStatePtr->macSession;
+
+        if (wasRefill)
+        {
+            CSEC_DRV_ContinueRNDRefillCmd();
+        }
+        else if (session != NULL)
+        {
+            CSEC_DRV_ContinueMACSessionCmd();
+            stepDone = (session->status != STATUS_BUSY);
+        }
+        else if (g_csecStatePtr->addrMode)
+        {
+            CSEC_DRV_ContinueAddrModeMACCmd();
+        }
+        else if (g_csecStatePtr->seal)
+        {
+            CSEC_DRV_ContinueSealCmd();
+        }
+        else if ((g_csecStatePtr->cmd == CSEC_CMD_ENC_ECB) || (g_csecStatePtr->cmd == CSEC_CMD_DEC_ECB))
         {
             CSEC_DRV_ContinueEncDecECBCmd();
         }
@@ -1460,13 +1636,63 @@ void FTFC_IRQHandler(void)
         /* If finished processing, disable interrupt */
         if (!g_csecStatePtr->cmdInProgress)
         {
+            completed = true;
+            cmd = g_csecStatePtr->cmd;
+
+            CSEC_SetInterrupt(false);
+
+            if (job != NULL)
+            {
+                g_csecStatePtr->job = NULL;
+                job->status = g_csecStatePtr->errCode;
+            }
+
+            /* Start the next queued job before the callbacks, so the CSEc does
+             * not idle while they run */
+            CSEC_DRV_StartNextJob();
+        }
+        else if (stepDone)
+        {
+            /* The MAC session waits for the next step */
             CSEC_SetInterrupt(false);
+        }
+        else
+        {
+            /* The command in execution continues */
+        }
+    }
+
+    INT_SYS_EnableIRQGlobal();
+
+    if (stepDone && (session->callback != NULL))
+    {
+        session->callback(session, session->callbackParam);
+    }
 
-            if (g_csecStatePtr->callback != NULL)
+    if (completed)
+    {
+        if (job != NULL)
+        {
+            if (job->callback != NULL)
             {
-                g_csecStatePtr->callback((uint32_t)g_csecStatePtr->cmd, g_csecStatePtr->callbackParam);
+                job->callback(job, job->callbackParam);
             }
         }
+        else if ((!wasRefill) && (session == NULL) && (g_csecStatePtr->callback != NULL))
+        {
+            g_csecStatePtr->callback((uint32_t)cmd, g_csecStatePtr->callbackParam);
+        }
+        else
+        {
+            /* No global callback for the RND pool refills and the MAC sessions */
+        }
+
+        /* Top up the RND pool while the CSEc is idle; after a failed refill
+         * command, wait for the next explicit request */
+        if ((!wasRefill) || (g_csecStatePtr->rndPool->refillStatus == STATUS_SUCCESS))
+        {
+            CSEC_DRV_StartRNDRefillCmd();
+        }
     }
 }
 
@@ -1752,6 +1978,62 @@ static void CSEC_DRV_ContinueVerifMACCmd(void)
     }
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_ContinueSealCmd
+ * Description   : Continues the execution of a seal operation. Reads the
+ * result of the completed step into the payload and launches the next command
+ * (RND, then ENC_CBC, then GENERATE_MAC), reusing the data it left in CSE_PRAM.
+ *
+ * END**************************************************************************/
+static void CSEC_DRV_ContinueSealCmd(void)
+{
+    uint8_t * payload = g_csecStatePtr->outputBuff;
+    uint8_t numBytes = (uint8_t)g_csecStatePtr->fullSize;
+
+    /* Read the status of the execution */
+    g_csecStatePtr->errCode = CSEC_ReadErrorBits();
+    if (g_csecStatePtr->errCode != STATUS_SUCCESS)
+    {
+        /* Do not continue launching commands if an error occurred */
+        g_csecStatePtr->cmdInProgress = false;
+        return;
+    }
+
+    if (g_csecStatePtr->cmd == CSEC_CMD_RND)
+    {
+        /* The random bytes are in page 1, where ENC_CBC expects the IV */
+        CSEC_ReadCommandBytes(FEATURE_CSEC_PAGE_1_OFFSET, &payload[CSEC_PAGE_SIZE_IN_BYTES], CSEC_PAGE_SIZE_IN_BYTES);
+
+        /* Write the plain text and its size (in pages) */
+        CSEC_WriteCommandBytes(FEATURE_CSEC_PAGE_2_OFFSET, g_csecStatePtr->inputBuff, numBytes);
+        CSEC_WriteCommandHalfWord(FEATURE_CSEC_PAGE_LENGTH_OFFSET, (uint16_t)(g_csecStatePtr->fullSize >> CSEC_BYTES_TO_FROM_PAGES_SHIFT));
+
+        g_csecStatePtr->cmd = CSEC_CMD_ENC_CBC;
+        CSEC_WriteCommandHeader(CSEC_CMD_ENC_CBC, CSEC_FUNC_FORMAT_COPY, CSEC_CALL_SEQ_FIRST, g_csecStatePtr->keyId);
+    }
+    else if (g_csecStatePtr->cmd == CSEC_CMD_ENC_CBC)
+    {
+        /* The cipher text stays in pages 2 onwards, as the end of the message to authenticate */
+        CSEC_ReadCommandBytes(FEATURE_CSEC_PAGE_2_OFFSET, &payload[CSEC_SEAL_OVERHEAD_SIZE], numBytes);
+
+        /* Page 1 is only specified as an input of ENC_CBC: put the IV back in front of the cipher text */
+        CSEC_WriteCommandBytes(FEATURE_CSEC_PAGE_1_OFFSET, &payload[CSEC_PAGE_SIZE_IN_BYTES], CSEC_PAGE_SIZE_IN_BYTES);
+
+        /* Write the size of the message (in bits) */
+        g_csecStatePtr->msgLen = (g_csecStatePtr->fullSize + CSEC_PAGE_SIZE_IN_BYTES) << CSEC_BYTES_TO_FROM_BITS_SHIFT;
+        CSEC_WriteCommandWords(FEATURE_CSEC_MESSAGE_LENGTH_OFFSET, &g_csecStatePtr->msgLen, 1U);
+
+        g_csecStatePtr->cmd = CSEC_CMD_GENERATE_MAC;
+        CSEC_WriteCommandHeader(CSEC_CMD_GENERATE_MAC, CSEC_FUNC_FORMAT_COPY, CSEC_CALL_SEQ_FIRST, g_csecStatePtr->keyId);
+    }
+    else
+    {
+        g_csecStatePtr->cmdInProgress = false;
+        CSEC_ReadCommandBytes(FEATURE_CSEC_PAGE_2_OFFSET, payload, CSEC_PAGE_SIZE_IN_BYTES);
+    }
+}
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : CSEC_DRV_InstallCallback
@@ -1779,7 +2061,8 @@ void CSEC_DRV_CancelCommand(void)
 {
     DEV_ASSERT(g_csecStatePtr != NULL);
 
-    if (g_csecStatePtr->cmdInProgress)
+    /* An RND pool refill is completed rather than cancelled */
+    if (CSEC_DRV_IsCmdInProgress())
     {
         CSEC_SetInterrupt(false);
 
@@ -1788,8 +2071,9 @@ void CSEC_DRV_CancelCommand(void)
 
         if ((g_csecStatePtr->cmd != CSEC_CMD_ENC_ECB) && (g_csecStatePtr->cmd != CSEC_CMD_DEC_ECB))
         {
-            /* Was there any command already launched? If so, break the sequence */
-            if (g_csecStatePtr->fullSize != g_csecStatePtr->partSize)
+            /* Was there any command already launched? If so, break the sequence.
+             * A MAC session which launched no command yet has no sequence either. */
+            if ((g_csecStatePtr->fullSize != g_csecStatePtr->partSize) && (g_csecStatePtr->partSize != 0U))
             {
                 /* Write the command header. CallSeq is set to 0 in order to trigger a command
                  * that will generate a sequence error, breaking the chain of calls. */
@@ -1801,7 +2085,952 @@ void CSEC_DRV_CancelCommand(void)
         }
 
         g_csecStatePtr->cmdInProgress = false;
+
+        /* A cancelled job or MAC session completes with an error; the queue
+         * goes on */
+        INT_SYS_DisableIRQGlobal();
+        if (g_csecStatePtr->job != NULL)
+        {
+            g_csecStatePtr->job->status = STATUS_ERROR;
+            g_csecStatePtr->job = NULL;
+        }
+        if (g_csecStatePtr->macSession != NULL)
+        {
+            g_csecStatePtr->macSession->status = STATUS_ERROR;
+            g_csecStatePtr->macSession = NULL;
+        }
+        CSEC_DRV_StartNextJob();
+        INT_SYS_EnableIRQGlobal();
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_InitRNDPool
+ * Description   : Sets up a pool of random blocks, refilled from the FTFC
+ * interrupt whenever the CSEc is idle, and starts filling it.
+ *
+ * Implements    : CSEC_DRV_InitRNDPool_Activity
+ * END**************************************************************************/
+void CSEC_DRV_InitRNDPool(csec_rnd_pool_t * pool,
+                          const csec_rnd_pool_config_t * config)
+{
+    DEV_ASSERT(pool != NULL);
+    DEV_ASSERT(config != NULL);
+    DEV_ASSERT(config->blocks != NULL);
+    DEV_ASSERT(config->size > 0U);
+    DEV_ASSERT(config->lowWaterMark < config->size);
+    DEV_ASSERT(g_csecStatePtr != NULL);
+
+    /* Complete the refill of the previous pool, if any */
+    (void)CSEC_DRV_IsCmdInProgress();
+
+    pool->config = *config;
+    pool->head = 0U;
+    pool->count = 0U;
+    pool->hits = 0U;
+    pool->misses = 0U;
+    pool->refillStatus = STATUS_SUCCESS;
+
+    g_csecStatePtr->rndPool = pool;
+
+    CSEC_DRV_StartRNDRefillCmd();
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_TakeRND
+ * Description   : Copies the oldest block of the RND pool, or generates one
+ * if the pool is empty, and restarts the refill.
+ *
+ * Implements    : CSEC_DRV_TakeRND_Activity
+ * END**************************************************************************/
+status_t CSEC_DRV_TakeRND(uint8_t * rnd)
+{
+    DEV_ASSERT(rnd != NULL);
+    DEV_ASSERT(g_csecStatePtr != NULL);
+    DEV_ASSERT(g_csecStatePtr->rndPool != NULL);
+
+    csec_rnd_pool_t * pool = g_csecStatePtr->rndPool;
+    const uint8_t * block;
+    uint32_t available;
+    uint8_t i;
+    status_t stat = STATUS_SUCCESS;
+
+    if (pool->count == 0U)
+    {
+        /* An RND command in execution for the pool completes sooner than a new one */
+        (void)CSEC_DRV_IsCmdInProgress();
+    }
+
+    if (pool->count > 0U)
+    {
+        /* The refill only writes the blocks which are not counted */
+        block = &pool->config.blocks[pool->head * CSEC_RND_BLOCK_SIZE];
+        for (i = 0U; i < CSEC_RND_BLOCK_SIZE; i++)
+        {
+            rnd[i] = block[i];
+        }
+
+        INT_SYS_DisableIRQGlobal();
+        pool->head = (pool->head + 1U) % pool->config.size;
+        pool->count--;
+        available = pool->count;
+        INT_SYS_EnableIRQGlobal();
+
+        pool->hits++;
+
+        if ((available == pool->config.lowWaterMark) && (pool->config.callback != NULL))
+        {
+            pool->config.callback(available, pool->config.callbackParam);
+        }
+    }
+    else
+    {
+        pool->misses++;
+
+        stat = CSEC_DRV_GenerateRND(rnd);
+    }
+
+    CSEC_DRV_StartRNDRefillCmd();
+
+    return stat;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_RefillRNDPool
+ * Description   : Starts the refill of the RND pool if the CSEc is idle.
+ *
+ * Implements    : CSEC_DRV_RefillRNDPool_Activity
+ * END**************************************************************************/
+void CSEC_DRV_RefillRNDPool(void)
+{
+    DEV_ASSERT(g_csecStatePtr != NULL);
+    DEV_ASSERT(g_csecStatePtr->rndPool != NULL);
+
+    CSEC_DRV_StartRNDRefillCmd();
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_GetRNDPoolStats
+ * Description   : Returns the number of blocks ready in the RND pool and its
+ * hit and miss counters.
+ *
+ * Implements    : CSEC_DRV_GetRNDPoolStats_Activity
+ * END**************************************************************************/
+void CSEC_DRV_GetRNDPoolStats(csec_rnd_pool_stats_t * stats)
+{
+    DEV_ASSERT(stats != NULL);
+    DEV_ASSERT(g_csecStatePtr != NULL);
+    DEV_ASSERT(g_csecStatePtr->rndPool != NULL);
+
+    const csec_rnd_pool_t * pool = g_csecStatePtr->rndPool;
+
+    stats->available = pool->count;
+    stats->hits = pool->hits;
+    stats->misses = pool->misses;
+    stats->refillStatus = pool->refillStatus;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_SubmitJob
+ * Description   : Appends a job to the queue of its priority class and starts
+ * it right away if the CSEc is idle. Otherwise, the job is started from the
+ * FTFC interrupt when its turn comes.
+ *
+ * Implements    : CSEC_DRV_SubmitJob_Activity
+ * END**************************************************************************/
+void CSEC_DRV_SubmitJob(csec_job_t * job)
+{
+    DEV_ASSERT(job != NULL);
+    DEV_ASSERT(job->input != NULL);
+    DEV_ASSERT((uint32_t)job->priority < CSEC_JOB_PRIORITY_COUNT);
+    DEV_ASSERT((job->cmd == CSEC_CMD_ENC_ECB) || (job->cmd == CSEC_CMD_DEC_ECB) ||
+               (job->cmd == CSEC_CMD_ENC_CBC) || (job->cmd == CSEC_CMD_DEC_CBC) ||
+               (job->cmd == CSEC_CMD_GENERATE_MAC) || (job->cmd == CSEC_CMD_VERIFY_MAC));
+    DEV_ASSERT((job->cmd == CSEC_CMD_VERIFY_MAC) || (job->output != NULL));
+    DEV_ASSERT(((job->cmd != CSEC_CMD_ENC_CBC) && (job->cmd != CSEC_CMD_DEC_CBC)) || (job->iv != NULL));
+    DEV_ASSERT((job->cmd != CSEC_CMD_VERIFY_MAC) || ((job->mac != NULL) && (job->verifStatus != NULL)));
+    DEV_ASSERT(g_csecStatePtr != NULL);
+
+    job->status = STATUS_BUSY;
+    job->next = NULL;
+
+    INT_SYS_DisableIRQGlobal();
+
+    if (g_csecStatePtr->jobTail[job->priority] == NULL)
+    {
+        g_csecStatePtr->jobHead[job->priority] = job;
+    }
+    else
+    {
+        g_csecStatePtr->jobTail[job->priority]->next = job;
     }
+    g_csecStatePtr->jobTail[job->priority] = job;
+
+    /* An RND pool refill in execution is completed first */
+    if (!CSEC_DRV_IsCmdInProgress())
+    {
+        CSEC_DRV_StartNextJob();
+    }
+
+    INT_SYS_EnableIRQGlobal();
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_GenerateMACAddrModeAsync
+ * Description   : This function starts the computation of the MAC of a message
+ * stored in Flash memory using CMAC with AES-128, in an asynchronous manner.
+ *
+ * Implements    : CSEC_DRV_GenerateMACAddrModeAsync_Activity
+ * END**************************************************************************/
+status_t CSEC_DRV_GenerateMACAddrModeAsync(csec_key_id_t keyId,
+                                           const uint8_t * msg,
+                                           uint32_t msgLen,
+                                           uint8_t * cmac)
+{
+    DEV_ASSERT(msg != NULL);
+    DEV_ASSERT(cmac != NULL);
+    DEV_ASSERT(g_csecStatePtr != NULL);
+
+    if (CSEC_DRV_IsCmdInProgress())
+    {
+        return STATUS_BUSY;
+    }
+
+    /* A single command, there is no sequence to break on cancel */
+    CSEC_DRV_InitState(keyId, CSEC_CMD_GENERATE_MAC, msg, cmac, 0U);
+    g_csecStatePtr->partSize = 0U;
+    g_csecStatePtr->msgLen = msgLen;
+    g_csecStatePtr->addrMode = true;
+
+    /* Write the address of the message */
+    CSEC_WriteCommandWords(FEATURE_CSEC_FLASH_START_ADDRESS_OFFSET, (uint32_t *)&msg, 1U);
+    /* Write the size of the message (in bits) */
+    CSEC_WriteCommandWords(FEATURE_CSEC_MESSAGE_LENGTH_OFFSET, &msgLen, 1U);
+    /* Write the command header. This will trigger the command execution. */
+    CSEC_WriteCommandHeader(CSEC_CMD_GENERATE_MAC, CSEC_FUNC_FORMAT_ADDR, CSEC_CALL_SEQ_FIRST, keyId);
+
+    /* Enable interrupt */
+    CSEC_SetInterrupt(true);
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_VerifyMACAddrModeAsync
+ * Description   : This function starts the verification of the MAC of a
+ * message stored in Flash memory using CMAC with AES-128, in an asynchronous
+ * manner.
+ *
+ * Implements    : CSEC_DRV_VerifyMACAddrModeAsync_Activity
+ * END**************************************************************************/
+status_t CSEC_DRV_VerifyMACAddrModeAsync(csec_key_id_t keyId,
+                                         const uint8_t * msg,
+                                         uint32_t msgLen,
+                                         const uint8_t * mac,
+                                         uint16_t macLen,
+                                         bool * verifStatus)
+{
+    DEV_ASSERT(msg != NULL);
+    DEV_ASSERT(mac != NULL);
+    DEV_ASSERT(verifStatus != NULL);
+    DEV_ASSERT(g_csecStatePtr != NULL);
+
+    if (CSEC_DRV_IsCmdInProgress())
+    {
+        return STATUS_BUSY;
+    }
+
+    /* A single command, there is no sequence to break on cancel */
+    CSEC_DRV_InitState(keyId, CSEC_CMD_VERIFY_MAC, msg, NULL, 0U);
+    g_csecStatePtr->partSize = 0U;
+    g_csecStatePtr->msgLen = msgLen;
+    g_csecStatePtr->verifStatus = verifStatus;
+    g_csecStatePtr->addrMode = true;
+
+    /* Write the address of the message */
+    CSEC_WriteCommandWords(FEATURE_CSEC_FLASH_START_ADDRESS_OFFSET, (uint32_t *)&msg, 1U);
+    /* Write the MAC to be verified */
+    CSEC_WriteCommandBytes(FEATURE_CSEC_PAGE_2_OFFSET, mac, CSEC_PAGE_SIZE_IN_BYTES);
+    /* Write the size of the message (in bits) */
+    CSEC_WriteCommandWords(FEATURE_CSEC_MESSAGE_LENGTH_OFFSET, &msgLen, 1U);
+    /* Write the number of bits of the MAC to be compared */
+    CSEC_WriteCommandHalfWord(FEATURE_CSEC_MAC_LENGTH_OFFSET, macLen);
+    /* Write the command header. This will trigger the command execution. */
+    CSEC_WriteCommandHeader(CSEC_CMD_VERIFY_MAC, CSEC_FUNC_FORMAT_ADDR, CSEC_CALL_SEQ_FIRST, keyId);
+
+    /* Enable interrupt */
+    CSEC_SetInterrupt(true);
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_InitGenerateMAC
+ * Description   : Opens a MAC session for the generation of the MAC of a
+ * message passed in pieces, and reserves the CSEc for it.
+ *
+ * Implements    : CSEC_DRV_InitGenerateMAC_Activity
+ * END**************************************************************************/
+status_t CSEC_DRV_InitGenerateMAC(csec_mac_session_t * session,
+                                  csec_key_id_t keyId,
+                                  uint32_t msgLen)
+{
+    DEV_ASSERT(session != NULL);
+    DEV_ASSERT(msgLen > 0U);
+    DEV_ASSERT(g_csecStatePtr != NULL);
+
+    if (CSEC_DRV_IsCmdInProgress())
+    {
+        return STATUS_BUSY;
+    }
+
+    CSEC_DRV_InitMACSession(session, CSEC_CMD_GENERATE_MAC, keyId, msgLen);
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_InitVerifyMAC
+ * Description   : Opens a MAC session for the verification of the MAC of a
+ * message passed in pieces, and reserves the CSEc for it.
+ *
+ * Implements    : CSEC_DRV_InitVerifyMAC_Activity
+ * END**************************************************************************/
+status_t CSEC_DRV_InitVerifyMAC(csec_mac_session_t * session,
+                                csec_key_id_t keyId,
+                                uint32_t msgLen,
+                                uint16_t macLen)
+{
+    DEV_ASSERT(session != NULL);
+    DEV_ASSERT(msgLen > 0U);
+    DEV_ASSERT(g_csecStatePtr != NULL);
+
+    if (CSEC_DRV_IsCmdInProgress())
+    {
+        return STATUS_BUSY;
+    }
+
+    CSEC_DRV_InitMACSession(session, CSEC_CMD_VERIFY_MAC, keyId, msgLen);
+    g_csecStatePtr->macLen = macLen;
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_UpdateMAC
+ * Description   : Passes the next piece of the message to a MAC session and
+ * launches the commands for the full chunks it completes.
+ *
+ * Implements    : CSEC_DRV_UpdateMAC_Activity
+ * END**************************************************************************/
+status_t CSEC_DRV_UpdateMAC(csec_mac_session_t * session,
+                            const uint8_t * msg,
+                            uint32_t length)
+{
+    DEV_ASSERT(session != NULL);
+    DEV_ASSERT((msg != NULL) || (length == 0U));
+    DEV_ASSERT(g_csecStatePtr != NULL);
+
+    if (g_csecStatePtr->macSession != session)
+    {
+        return STATUS_ERROR;
+    }
+    if (session->status == STATUS_BUSY)
+    {
+        return STATUS_BUSY;
+    }
+
+    DEV_ASSERT((g_csecStatePtr->index + session->bufferLen + length) <= g_csecStatePtr->fullSize);
+
+    session->input = msg;
+    session->inputSize = length;
+    session->inputIndex = 0U;
+
+    CSEC_DRV_RunMACSession(session);
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_FinishGenerateMAC
+ * Description   : Launches the last command of a MAC generation session.
+ *
+ * Implements    : CSEC_DRV_FinishGenerateMAC_Activity
+ * END**************************************************************************/
+status_t CSEC_DRV_FinishGenerateMAC(csec_mac_session_t * session,
+                                    uint8_t * cmac)
+{
+    DEV_ASSERT(session != NULL);
+    DEV_ASSERT(cmac != NULL);
+    DEV_ASSERT(g_csecStatePtr != NULL);
+
+    if (g_csecStatePtr->macSession != session)
+    {
+        return STATUS_ERROR;
+    }
+    if (session->status == STATUS_BUSY)
+    {
+        return STATUS_BUSY;
+    }
+
+    DEV_ASSERT(g_csecStatePtr->cmd == CSEC_CMD_GENERATE_MAC);
+    DEV_ASSERT((g_csecStatePtr->index + session->bufferLen) == g_csecStatePtr->fullSize);
+
+    g_csecStatePtr->outputBuff = cmac;
+    session->inputSize = 0U;
+    session->inputIndex = 0U;
+    session->final = true;
+
+    CSEC_DRV_RunMACSession(session);
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_FinishVerifyMAC
+ * Description   : Launches the last command of a MAC verification session,
+ * along with the MAC to be verified.
+ *
+ * Implements    : CSEC_DRV_FinishVerifyMAC_Activity
+ * END**************************************************************************/
+status_t CSEC_DRV_FinishVerifyMAC(csec_mac_session_t * session,
+                                  const uint8_t * mac,
+                                  bool * verifStatus)
+{
+    DEV_ASSERT(session != NULL);
+    DEV_ASSERT(mac != NULL);
+    DEV_ASSERT(verifStatus != NULL);
+    DEV_ASSERT(g_csecStatePtr != NULL);
+
+    if (g_csecStatePtr->macSession != session)
+    {
+        return STATUS_ERROR;
+    }
+    if (session->status == STATUS_BUSY)
+    {
+        return STATUS_BUSY;
+    }
+
+    DEV_ASSERT(g_csecStatePtr->cmd == CSEC_CMD_VERIFY_MAC);
+    DEV_ASSERT((g_csecStatePtr->index + session->bufferLen) == g_csecStatePtr->fullSize);
+
+    g_csecStatePtr->mac = mac;
+    g_csecStatePtr->verifStatus = verifStatus;
+    session->inputSize = 0U;
+    session->inputIndex = 0U;
+    session->final = true;
+
+    CSEC_DRV_RunMACSession(session);
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_InitImageCheck
+ * Description   : Sets up the periodic verification of an image; the first
+ * verification starts on the next call of CSEC_DRV_RunImageCheck. A
+ * verification holds the CSEc (cmdInProgress) across the calls it spans, up
+ * to config->maxCalls calls.
+ *
+ * Implements    : CSEC_DRV_InitImageCheck_Activity
+ * END**************************************************************************/
+void CSEC_DRV_InitImageCheck(csec_image_check_t * check,
+                             const csec_image_check_config_t * config)
+{
+    DEV_ASSERT(check != NULL);
+    DEV_ASSERT(config != NULL);
+    DEV_ASSERT(config->image != NULL);
+    DEV_ASSERT(config->mac != NULL);
+    DEV_ASSERT(config->msgLen > 0U);
+    DEV_ASSERT(config->sliceSize > 0U);
+
+    check->config = *config;
+    check->session.callback = NULL;
+    check->session.callbackParam = NULL;
+    check->running = false;
+    check->offset = 0U;
+    check->delay = 0U;
+    check->calls = 0U;
+    check->verifStatus = false;
+    check->passed = 0U;
+    check->failed = 0U;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_RunImageCheck
+ * Description   : Passes the next slice of the image to the MAC session of
+ * the check, or starts or completes a verification. A verification which
+ * reaches config->maxCalls calls is cancelled and completes with
+ * STATUS_TIMEOUT.
+ *
+ * Implements    : CSEC_DRV_RunImageCheck_Activity
+ * END**************************************************************************/
+void CSEC_DRV_RunImageCheck(csec_image_check_t * check)
+{
+    DEV_ASSERT(check != NULL);
+    DEV_ASSERT(g_csecStatePtr != NULL);
+
+    csec_mac_session_t * session = &check->session;
+    uint32_t imageSize = CSEC_DRV_RoundTo(check->config.msgLen, 0x8) >> CSEC_BYTES_TO_FROM_BITS_SHIFT;
+    uint32_t numBytes;
+    status_t stat;
+
+    if (!check->running)
+    {
+        if (check->delay > 0U)
+        {
+            check->delay--;
+            return;
+        }
+
+        /* Retry on the next call if the CSEc is in use */
+        if (CSEC_DRV_InitVerifyMAC(session, check->config.keyId, check->config.msgLen, check->config.macLen) != STATUS_SUCCESS)
+        {
+            return;
+        }
+
+        check->running = true;
+        check->offset = 0U;
+        check->calls = 0U;
+    }
+
+    check->calls++;
+
+    if ((check->config.maxCalls > 0U) && (check->calls > check->config.maxCalls) &&
+        (g_csecStatePtr->macSession == session))
+    {
+        /* Give the CSEc back, breaking the sequence of the session */
+        CSEC_DRV_CancelCommand();
+        session->status = STATUS_TIMEOUT;
+    }
+    else if (session->status == STATUS_BUSY)
+    {
+        /* The previous slice is still in execution */
+        return;
+    }
+    else if ((session->status == STATUS_SUCCESS) && (!session->final))
+    {
+        if (check->offset < imageSize)
+        {
+            numBytes = imageSize - check->offset;
+            if (numBytes > check->config.sliceSize)
+            {
+                numBytes = check->config.sliceSize;
+            }
+
+            (void)CSEC_DRV_UpdateMAC(session, &check->config.image[check->offset], numBytes);
+            check->offset += numBytes;
+        }
+        else
+        {
+            (void)CSEC_DRV_FinishVerifyMAC(session, check->config.mac, &check->verifStatus);
+        }
+        return;
+    }
+    else
+    {
+        /* The verification completed, or the session ended with an error */
+    }
+
+    stat = session->status;
+    if (stat == STATUS_SUCCESS)
+    {
+        if (check->verifStatus)
+        {
+            check->passed++;
+        }
+        else
+        {
+            check->failed++;
+        }
+    }
+
+    check->running = false;
+    check->delay = check->config.period;
+
+    if (check->config.callback != NULL)
+    {
+        check->config.callback(stat, (stat == STATUS_SUCCESS) && check->verifStatus, check->config.callbackParam);
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_IsCmdInProgress
+ * Description   : Checks if a command is in progress before launching a new
+ * one. An RND pool refill in execution is waited for and stopped, so it never
+ * makes the new command fail.
+ *
+ * END**************************************************************************/
+static bool CSEC_DRV_IsCmdInProgress(void)
+{
+    if (g_csecStatePtr->rndRefill)
+    {
+        /* Keep the interrupt from resuming the refill, then check again in
+         * case it completed the refill in the meantime */
+        CSEC_SetInterrupt(false);
+
+        if (g_csecStatePtr->rndRefill)
+        {
+            /* Wait until the execution of the command is complete */
+            CSEC_WaitCommandCompletion();
+
+            CSEC_DRV_ContinueRNDRefillCmd();
+        }
+    }
+
+    return g_csecStatePtr->cmdInProgress;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_StartRNDRefillCmd
+ * Description   : Launches an RND command for the RND pool if the CSEc is idle
+ * and the pool is not full. The test of cmdInProgress and the command launch
+ * are done with the interrupts disabled, so that a job started from the FTFC
+ * interrupt cannot write its header in between.
+ *
+ * END**************************************************************************/
+static void CSEC_DRV_StartRNDRefillCmd(void)
+{
+    const csec_rnd_pool_t * pool = g_csecStatePtr->rndPool;
+
+    INT_SYS_DisableIRQGlobal();
+
+    if ((pool != NULL) && (!g_csecStatePtr->cmdInProgress) && (pool->count < pool->config.size))
+    {
+        g_csecStatePtr->cmdInProgress = true;
+        g_csecStatePtr->rndRefill = true;
+
+        /* Write the command header. This will trigger the command execution. */
+        CSEC_WriteCommandHeader(CSEC_CMD_RND, CSEC_FUNC_FORMAT_COPY, CSEC_CALL_SEQ_FIRST, CSEC_SECRET_KEY);
+
+        /* Enable interrupt */
+        CSEC_SetInterrupt(true);
+    }
+
+    INT_SYS_EnableIRQGlobal();
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_ContinueRNDRefillCmd
+ * Description   : Completes an RND pool refill command. Adds the random block
+ * to the pool if the command succeeded.
+ *
+ * END**************************************************************************/
+static void CSEC_DRV_ContinueRNDRefillCmd(void)
+{
+    csec_rnd_pool_t * pool = g_csecStatePtr->rndPool;
+    uint32_t tail;
+
+    /* Read the status of the execution */
+    pool->refillStatus = CSEC_ReadErrorBits();
+    if (pool->refillStatus == STATUS_SUCCESS)
+    {
+        tail = (pool->head + pool->count) % pool->config.size;
+        CSEC_ReadCommandBytes(FEATURE_CSEC_PAGE_1_OFFSET, &pool->config.blocks[tail * CSEC_RND_BLOCK_SIZE], CSEC_RND_BLOCK_SIZE);
+        pool->count++;
+    }
+
+    g_csecStatePtr->rndRefill = false;
+    g_csecStatePtr->cmdInProgress = false;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_StartNextJob
+ * Description   : Launches the first command of the most urgent queued job, if
+ * the CSEc is idle. Must be called with the interrupts disabled.
+ *
+ * END**************************************************************************/
+static void CSEC_DRV_StartNextJob(void)
+{
+    csec_job_t * job = NULL;
+    uint32_t prio;
+
+    if (g_csecStatePtr->cmdInProgress)
+    {
+        return;
+    }
+
+    for (prio = 0U; (prio < CSEC_JOB_PRIORITY_COUNT) && (job == NULL); prio++)
+    {
+        job = g_csecStatePtr->jobHead[prio];
+        if (job != NULL)
+        {
+            g_csecStatePtr->jobHead[prio] = job->next;
+            if (job->next == NULL)
+            {
+                g_csecStatePtr->jobTail[prio] = NULL;
+            }
+        }
+    }
+
+    if (job == NULL)
+    {
+        return;
+    }
+
+    g_csecStatePtr->job = job;
+
+    switch (job->cmd)
+    {
+        case CSEC_CMD_ENC_ECB:
+        case CSEC_CMD_DEC_ECB:
+            CSEC_DRV_InitState(job->keyId, job->cmd, job->input, job->output, job->length);
+            CSEC_DRV_StartEncDecECBCmd();
+            break;
+        case CSEC_CMD_ENC_CBC:
+        case CSEC_CMD_DEC_CBC:
+            CSEC_DRV_InitState(job->keyId, job->cmd, job->input, job->output, job->length);
+            g_csecStatePtr->iv = job->iv;
+            CSEC_DRV_StartEncDecCBCCmd();
+            break;
+        case CSEC_CMD_GENERATE_MAC:
+            CSEC_DRV_InitState(job->keyId, job->cmd, job->input, job->output, CSEC_DRV_RoundTo(job->length, 0x8) >> CSEC_BYTES_TO_FROM_BITS_SHIFT);
+            g_csecStatePtr->msgLen = job->length;
+            CSEC_DRV_StartGenMACCmd();
+            break;
+        default:
+            CSEC_DRV_InitState(job->keyId, job->cmd, job->input, NULL, CSEC_DRV_RoundTo(job->length, 0x8) >> CSEC_BYTES_TO_FROM_BITS_SHIFT);
+            g_csecStatePtr->msgLen = job->length;
+            g_csecStatePtr->verifStatus = job->verifStatus;
+            g_csecStatePtr->macWritten = false;
+            g_csecStatePtr->mac = job->mac;
+            g_csecStatePtr->macLen = job->macLen;
+            CSEC_DRV_StartVerifMACCmd();
+            break;
+    }
+
+    /* Enable interrupt */
+    CSEC_SetInterrupt(true);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_InitMACSession
+ * Description   : Initializes the internal state of the driver for a MAC
+ * session, and marks the CSEc as in use until the session ends.
+ *
+ * END**************************************************************************/
+static void CSEC_DRV_InitMACSession(csec_mac_session_t * session,
+                                    csec_cmd_t cmd,
+                                    csec_key_id_t keyId,
+                                    uint32_t msgLen)
+{
+    CSEC_DRV_InitState(keyId, cmd, NULL, NULL, CSEC_DRV_RoundTo(msgLen, 0x8) >> CSEC_BYTES_TO_FROM_BITS_SHIFT);
+    g_csecStatePtr->partSize = 0U;
+    g_csecStatePtr->msgLen = msgLen;
+    g_csecStatePtr->macWritten = false;
+    g_csecStatePtr->macSession = session;
+
+    session->status = STATUS_SUCCESS;
+    session->input = NULL;
+    session->inputSize = 0U;
+    session->inputIndex = 0U;
+    session->bufferLen = 0U;
+    session->final = false;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_RunMACSession
+ * Description   : Launches the first command of a MAC session step, or
+ * completes the step right away if the data only fills the session buffer.
+ *
+ * END**************************************************************************/
+static void CSEC_DRV_RunMACSession(csec_mac_session_t * session)
+{
+    session->status = STATUS_BUSY;
+
+    if (CSEC_DRV_StartMACSessionCmd())
+    {
+        /* Enable interrupt */
+        CSEC_SetInterrupt(true);
+    }
+    else
+    {
+        session->status = STATUS_SUCCESS;
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_StartMACSessionCmd
+ * Description   : Launches the command for the next chunk of a MAC session,
+ * if the chunk is complete. The chunk is taken in place from the update data
+ * when possible, and gathered in the session buffer otherwise. The chunk
+ * holding the end of the message waits for the final step.
+ *
+ * END**************************************************************************/
+static bool CSEC_DRV_StartMACSessionCmd(void)
+{
+    csec_mac_session_t * session = g_csecStatePtr->macSession;
+    uint32_t left = g_csecStatePtr->fullSize - g_csecStatePtr->index;
+    uint32_t inputLeft = session->inputSize - session->inputIndex;
+    uint32_t numBytes = (left > CSEC_MAC_CHUNK_SIZE) ? CSEC_MAC_CHUNK_SIZE : left;
+    uint32_t copied;
+    const uint8_t * chunk;
+    uint8_t macOffset;
+
+    if ((session->bufferLen == 0U) && (numBytes > 0U) && (inputLeft >= numBytes) && ((numBytes < left) || session->final))
+    {
+        chunk = &session->input[session->inputIndex];
+        session->inputIndex += numBytes;
+    }
+    else
+    {
+        /* Gather the chunk in the session buffer */
+        copied = numBytes - session->bufferLen;
+        if (copied > inputLeft)
+        {
+            copied = inputLeft;
+        }
+        while (copied > 0U)
+        {
+            session->buffer[session->bufferLen] = session->input[session->inputIndex];
+            session->bufferLen++;
+            session->inputIndex++;
+            copied--;
+        }
+
+        if ((session->bufferLen < numBytes) || ((numBytes == left) && (!session->final)))
+        {
+            return false;
+        }
+
+        chunk = session->buffer;
+        session->bufferLen = 0U;
+    }
+
+    /* Write the message chunk */
+    CSEC_WriteCommandBytes(FEATURE_CSEC_PAGE_1_OFFSET, chunk, (uint8_t)numBytes);
+    /* Write the size of the message (in bits) */
+    CSEC_WriteCommandWords(FEATURE_CSEC_MESSAGE_LENGTH_OFFSET, &g_csecStatePtr->msgLen, 1U);
+
+    if (g_csecStatePtr->cmd == CSEC_CMD_VERIFY_MAC)
+    {
+        /* Write the number of bits of the MAC to be compared */
+        CSEC_WriteCommandHalfWord(FEATURE_CSEC_MAC_LENGTH_OFFSET, (uint16_t)g_csecStatePtr->macLen);
+
+        /* If there is available space in CSE_PRAM, write the MAC to be verified
+         * after the last chunk */
+        macOffset = (uint8_t)CSEC_DRV_RoundTo(numBytes, 0x10);
+        if ((numBytes == left) && ((macOffset + CSEC_PAGE_SIZE_IN_BYTES) < CSEC_DATA_BYTES_AVAILABLE))
+        {
+            CSEC_WriteCommandBytes(FEATURE_CSEC_PAGE_1_OFFSET + macOffset, g_csecStatePtr->mac, CSEC_PAGE_SIZE_IN_BYTES);
+            g_csecStatePtr->macWritten = true;
+        }
+    }
+
+    g_csecStatePtr->partSize = numBytes;
+
+    /* Write the command header. This will trigger the command execution. */
+    CSEC_WriteCommandHeader(g_csecStatePtr->cmd, CSEC_FUNC_FORMAT_COPY, g_csecStatePtr->seq, g_csecStatePtr->keyId);
+
+    return true;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_ContinueMACSessionCmd
+ * Description   : Continues the execution of a MAC session step. Launches the
+ * command for the next chunk, if complete, or marks the step as done. Ends the
+ * session after the last command or an error.
+ *
+ * END**************************************************************************/
+static void CSEC_DRV_ContinueMACSessionCmd(void)
+{
+    csec_mac_session_t * session = g_csecStatePtr->macSession;
+    bool done = false;
+
+    /* Read the status of the execution */
+    g_csecStatePtr->errCode = CSEC_ReadErrorBits();
+    if (g_csecStatePtr->errCode != STATUS_SUCCESS)
+    {
+        /* The CSEc broke the sequence, the session is over */
+        done = true;
+    }
+    else
+    {
+        g_csecStatePtr->seq = CSEC_CALL_SEQ_SUBSEQUENT;
+        g_csecStatePtr->index += g_csecStatePtr->partSize;
+
+        if (g_csecStatePtr->index >= g_csecStatePtr->fullSize)
+        {
+            if (g_csecStatePtr->cmd == CSEC_CMD_GENERATE_MAC)
+            {
+                CSEC_ReadCommandBytes(FEATURE_CSEC_PAGE_2_OFFSET, g_csecStatePtr->outputBuff, CSEC_PAGE_SIZE_IN_BYTES);
+                done = true;
+            }
+            else if (g_csecStatePtr->macWritten)
+            {
+                *(g_csecStatePtr->verifStatus) = (CSEC_ReadCommandHalfWord(FEATURE_CSEC_VERIFICATION_STATUS_OFFSET) == 0U);
+                done = true;
+            }
+            else
+            {
+                /* The MAC to be verified did not fit after the last chunk */
+            }
+        }
+    }
+
+    if (done)
+    {
+        g_csecStatePtr->macSession = NULL;
+        g_csecStatePtr->cmdInProgress = false;
+        session->status = g_csecStatePtr->errCode;
+    }
+    else if (!CSEC_DRV_StartMACSessionCmd())
+    {
+        /* Wait for the next piece of the message */
+        session->status = STATUS_SUCCESS;
+    }
+    else
+    {
+        /* The next chunk is in execution */
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CSEC_DRV_ContinueAddrModeMACCmd
+ * Description   : Completes a MAC generation or verification command using the
+ * pointer method. Reads the resulted CMAC or the verification status.
+ *
+ * END**************************************************************************/
+static void CSEC_DRV_ContinueAddrModeMACCmd(void)
+{
+    /* Read the status of the execution */
+    g_csecStatePtr->errCode = CSEC_ReadErrorBits();
+    if (g_csecStatePtr->errCode == STATUS_SUCCESS)
+    {
+        if (g_csecStatePtr->cmd == CSEC_CMD_GENERATE_MAC)
+        {
+            CSEC_ReadCommandBytes(FEATURE_CSEC_PAGE_2_OFFSET, g_csecStatePtr->outputBuff, CSEC_PAGE_SIZE_IN_BYTES);
+        }
+        else
+        {
+            *(g_csecStatePtr->verifStatus) = (CSEC_ReadCommandHalfWord(FEATURE_CSEC_VERIFICATION_STATUS_OFFSET) == 0U);
+        }
+    }
+
+    g_csecStatePtr->cmdInProgress = false;
 }
 
 /******************************************************************************
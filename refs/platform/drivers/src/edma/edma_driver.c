@@ -94,6 +94,9 @@ static const clock_names_t s_dmamuxClockNames[DMAMUX_INSTANCE_COUNT] = FEATURE_D
 /*! @brief EDMA global structure to maintain eDMA state */
 static edma_state_t * s_virtEdmaState;
 
+/*! @brief Timestamp source of the channel busy time accounting */
+static edma_timestamp_t s_edmaTimestamp;
+
 /*******************************************************************************
  * PROTOTYPES
  ******************************************************************************/
@@ -101,10 +104,33 @@ static status_t EDMA_DRV_RequestChannel(uint8_t virtualChannel,
                                         dma_request_source_t reqSrc,
                                         edma_chn_state_t *reqChn);
 static void EDMA_DRV_ClearIntStatus(uint8_t virtualChannel);
+static void EDMA_DRV_ServiceChannel(uint8_t virtualChannel);
 static void EDMA_DRV_ClearSoftwareTCD(edma_software_tcd_t *stcd);
-#ifdef DEV_ERROR_DETECT
-static bool EDMA_DRV_ValidTransferSize(edma_transfer_size_t size);
+#ifdef FEATURE_DMA_SEPARATE_IRQ_LINES_PER_CHN
+static void EDMA_DRV_CoalescedIRQHandler(uint8_t virtualChannel);
 #endif
+static bool EDMA_DRV_ValidTransferSize(edma_transfer_size_t size);
+static void EDMA_DRV_SetScatterGatherOffsets(edma_transfer_type_t type,
+                                             int16_t transferOffset,
+                                             edma_transfer_config_t *config);
+static void EDMA_DRV_StreamCallback(void *parameter,
+                                    edma_chn_status_t status);
+static void EDMA_DRV_UpdateBusyTime(edma_chn_state_t *chnState,
+                                    bool busy);
+static void EDMA_DRV_DetachSTCDChain(uint8_t virtualChannel);
+static void EDMA_DRV_SetTransferAccounting(uint8_t virtualChannel,
+                                           uint32_t bytes,
+                                           uint8_t interrupts,
+                                           uint16_t halfIterations);
+static bool EDMA_DRV_CheckPipelineStage(const edma_pipeline_stage_t *stage,
+                                        uint8_t stageCount);
+static bool EDMA_DRV_CheckPipelineModulo(uint32_t address,
+                                         int16_t offset,
+                                         uint32_t transferSize,
+                                         edma_modulo_t modulo);
+static void EDMA_DRV_PipelineStageToSTCD(const edma_pipeline_stage_t *stage,
+                                         const uint8_t *channels,
+                                         edma_software_tcd_t *stcd);
 
 /*******************************************************************************
  * Code
@@ -326,6 +352,92 @@ status_t EDMA_DRV_ChannelInit(edma_chn_state_t *edmaChannelState,
     return retStatus;
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_AllocChannel
+ * Description   : Pick a free channel matching the latency class and
+ * initialize it.
+ *
+ * Implements    : EDMA_DRV_AllocChannel_Activity
+ *END**************************************************************************/
+status_t EDMA_DRV_AllocChannel(edma_chn_state_t *edmaChannelState,
+                               const edma_channel_config_t *edmaChannelConfig,
+                               edma_latency_class_t latency,
+                               uint8_t *virtualChannel)
+{
+    edma_channel_config_t chnConfig = *edmaChannelConfig;
+    status_t retStatus = STATUS_BUSY;
+    uint32_t dmaInstance;
+    uint32_t step;
+    uint32_t channel;
+    uint32_t candidate = 0U;
+    bool found = false;
+
+    /* Check the state and configuration structure pointers are valid */
+    DEV_ASSERT((edmaChannelState != NULL) && (edmaChannelConfig != NULL) && (virtualChannel != NULL));
+
+    /* Check if the module is initialized */
+    DEV_ASSERT(s_virtEdmaState != NULL);
+
+    /* The channel could be taken between the search and the allocation */
+    INT_SYS_DisableIRQGlobal();
+
+    for (dmaInstance = 0U; (dmaInstance < (uint32_t)DMA_INSTANCE_COUNT) && !found; dmaInstance++)
+    {
+        for (step = 0U; (step < (uint32_t)FEATURE_DMA_CHANNELS) && !found; step++)
+        {
+            /* Critical channels from the top, bulk ones from the bottom, normal ones
+             * from the middle downwards, so that they run into the bulk band before
+             * taking the priorities above the middle, left to the critical ones */
+            switch (latency)
+            {
+                case EDMA_LATENCY_CRITICAL:
+                    channel = (uint32_t)FEATURE_DMA_CHANNELS - 1U - step;
+                    break;
+                case EDMA_LATENCY_NORMAL:
+                    if (step < ((uint32_t)FEATURE_DMA_CHANNELS / 2U))
+                    {
+                        channel = ((uint32_t)FEATURE_DMA_CHANNELS / 2U) - 1U - step;
+                    }
+                    else
+                    {
+                        channel = step;
+                    }
+                    break;
+                default:
+                    channel = step;
+                    break;
+            }
+
+            candidate = (dmaInstance * (uint32_t)FEATURE_DMA_CHANNELS) + channel;
+            if (s_virtEdmaState->virtChnState[candidate] == NULL)
+            {
+                found = true;
+            }
+        }
+    }
+
+    if (found)
+    {
+        chnConfig.virtChnConfig = (uint8_t)candidate;
+        chnConfig.channelPriority = EDMA_CHN_DEFAULT_PRIORITY;
+        retStatus = EDMA_DRV_ChannelInit(edmaChannelState, &chnConfig);
+    }
+
+    INT_SYS_EnableIRQGlobal();
+
+    if (retStatus == STATUS_SUCCESS)
+    {
+        EDMA_SetChannelPreemption(s_edmaBase[FEATURE_DMA_VCH_TO_INSTANCE(candidate)],
+                                  (uint8_t)FEATURE_DMA_VCH_TO_CH(candidate),
+                                  latency != EDMA_LATENCY_CRITICAL,
+                                  latency != EDMA_LATENCY_BULK);
+        *virtualChannel = (uint8_t)candidate;
+    }
+
+    return retStatus;
+}
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : EDMA_DRV_InstallCallback
@@ -349,6 +461,50 @@ status_t EDMA_DRV_InstallCallback(uint8_t virtualChannel,
     return STATUS_SUCCESS;
 }
 
+#ifdef FEATURE_DMA_SEPARATE_IRQ_LINES_PER_CHN
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_SetCoalescedInterrupts
+ * Description   : Selects whether a channel interrupt services its own channel
+ * only or every requesting channel whose line has its priority.
+ *
+ * Implements    : EDMA_DRV_SetCoalescedInterrupts_Activity
+ *END**************************************************************************/
+void EDMA_DRV_SetCoalescedInterrupts(bool enable)
+{
+    uint8_t priorities[(uint32_t)FEATURE_DMA_VIRTUAL_CHANNELS];
+    uint32_t virtualChannel;
+    uint32_t other;
+    uint32_t channels;
+
+    /* Check the eDMA module is initialized */
+    DEV_ASSERT(s_virtEdmaState != NULL);
+
+    s_virtEdmaState->coalescedIrq = false;
+    for (virtualChannel = 0U; virtualChannel < (uint32_t)FEATURE_DMA_VIRTUAL_CHANNELS; virtualChannel++)
+    {
+        priorities[virtualChannel] = INT_SYS_GetPriority(s_edmaIrqId[virtualChannel]);
+    }
+
+    /* A line services the channels of its instance whose lines have its
+     * priority, which can't preempt it */
+    for (virtualChannel = 0U; virtualChannel < (uint32_t)FEATURE_DMA_VIRTUAL_CHANNELS; virtualChannel++)
+    {
+        channels = 0U;
+        for (other = 0U; other < (uint32_t)FEATURE_DMA_VIRTUAL_CHANNELS; other++)
+        {
+            if ((FEATURE_DMA_VCH_TO_INSTANCE(other) == FEATURE_DMA_VCH_TO_INSTANCE(virtualChannel)) &&
+                (priorities[other] == priorities[virtualChannel]))
+            {
+                channels |= 1UL << FEATURE_DMA_VCH_TO_CH(other);
+            }
+        }
+        s_virtEdmaState->coalescedChannels[virtualChannel] = channels;
+    }
+    s_virtEdmaState->coalescedIrq = enable;
+}
+#endif
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : EDMA_DRV_RequestChannel
@@ -443,6 +599,9 @@ status_t EDMA_DRV_ReleaseChannel(uint8_t virtualChannel)
     /* Stop edma channel. */
     EDMA_SetDmaRequestCmd(edmaRegBase, dmaChannel, false);
 
+    /* Restore the default preemption, which EDMA_DRV_AllocChannel may have changed */
+    EDMA_SetChannelPreemption(edmaRegBase, dmaChannel, false, true);
+
     /* Reset the channel state structure to default value. */
     uint8_t *clearStructPtr = (uint8_t *)chnState;
     size_t clearSize = sizeof(edma_chn_state_t);
@@ -502,12 +661,64 @@ static void EDMA_DRV_ClearSoftwareTCD(edma_software_tcd_t *stcd)
  *END**************************************************************************/
 void EDMA_DRV_IRQHandler(uint8_t virtualChannel)
 {
-    const edma_chn_state_t *chnState = s_virtEdmaState->virtChnState[virtualChannel];
-
     EDMA_DRV_ClearIntStatus(virtualChannel);
+    EDMA_DRV_ServiceChannel(virtualChannel);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_ServiceChannel
+ * Description   : Accounts for the interrupt of a channel whose flag was
+ * cleared, gives back its completed pooled chain and calls its callback.
+ * This is not a public API as it is called from other driver functions.
+ *END**************************************************************************/
+static void EDMA_DRV_ServiceChannel(uint8_t virtualChannel)
+{
+    edma_chn_state_t *chnState = s_virtEdmaState->virtChnState[virtualChannel];
+    edma_stcd_chain_t *chain;
+
+    /* Get DMA instance from virtual channel */
+    uint8_t dmaInstance = (uint8_t)FEATURE_DMA_VCH_TO_INSTANCE(virtualChannel);
+
+    /* Get DMA channel from virtual channel*/
+    uint8_t dmaChannel = (uint8_t)FEATURE_DMA_VCH_TO_CH(virtualChannel);
+
+    DMA_Type *edmaRegBase = s_edmaBase[dmaInstance];
+    bool majorDone;
 
     if (chnState != NULL)
     {
+        /* The transfers are counted in software, as configured: the eDMA does not
+         * set DONE when a major loop ends by loading the next descriptor. A half
+         * interrupt leaves the count in the second half of the major loop. */
+        majorDone = (chnState->halfIterations == 0U) ||
+                    (EDMA_TCDGetCurrentMajorCount(edmaRegBase, dmaChannel) > chnState->halfIterations);
+        if (majorDone)
+        {
+            chnState->interruptCount++;
+            if (chnState->interruptCount >= chnState->transferInterrupts)
+            {
+                chnState->interruptCount = 0U;
+                chnState->stats.transfers++;
+                /* A TCD written field by field is measured at its completion */
+                chnState->stats.bytes += (chnState->transferBytes != 0U) ? chnState->transferBytes :
+                                         EDMA_TCDGetMajorLoopBytes(edmaRegBase, dmaChannel);
+            }
+            if (chnState->busy)
+            {
+                EDMA_DRV_UpdateBusyTime(chnState, EDMA_GetDmaRequestStatus(edmaRegBase, dmaChannel));
+            }
+        }
+
+        /* A pooled chain only interrupts on its last descriptor; give it back to
+         * the pool before the callback, which may build the next one */
+        chain = chnState->stcdChain;
+        if ((chain != NULL) && chain->releaseOnComplete)
+        {
+            chnState->stcdChain = NULL;
+            EDMA_DRV_FreeSTCDChain(chain);
+        }
+
         if (chnState->callback != NULL)
         {
             chnState->callback(chnState->parameter, chnState->status);
@@ -515,6 +726,65 @@ void EDMA_DRV_IRQHandler(uint8_t virtualChannel)
     }
 }
 
+#ifdef FEATURE_DMA_SEPARATE_IRQ_LINES_PER_CHN
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_ChannelIRQHandler
+ * Description   : EDMA channel interrupt line handler; services the channel of
+ * the line, or every requesting channel in coalesced mode.
+ *END**************************************************************************/
+void EDMA_DRV_ChannelIRQHandler(uint8_t virtualChannel)
+{
+    if (s_virtEdmaState->coalescedIrq)
+    {
+        EDMA_DRV_CoalescedIRQHandler(virtualChannel);
+    }
+    else
+    {
+        EDMA_DRV_IRQHandler(virtualChannel);
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_CoalescedIRQHandler
+ * Description   : Reads the interrupt requests of an eDMA instance once and
+ * services each requesting channel whose line has the priority of the entering
+ * line, lowest channel first. No other line services these channels, since
+ * they can't preempt each other and the lines of other priorities service their
+ * own groups. The flag of each channel is cleared before its pending interrupt,
+ * since the line stays raised while the flag is set; a completion which happens
+ * while the channel is serviced sets the flag, and raises the interrupt, again.
+ * The pending interrupt of the entering line was cleared by its entry.
+ * This is not a public API as it is called from other driver functions.
+ *END**************************************************************************/
+static void EDMA_DRV_CoalescedIRQHandler(uint8_t virtualChannel)
+{
+    uint32_t dmaInstance = FEATURE_DMA_VCH_TO_INSTANCE((uint32_t)virtualChannel);
+    const DMA_Type *edmaRegBase = s_edmaBase[dmaInstance];
+    uint32_t flags = EDMA_GetIntStatusFlags(edmaRegBase) & s_virtEdmaState->coalescedChannels[virtualChannel];
+    uint32_t lowestFlag;
+    uint32_t leadingZeros;
+    uint8_t channel;
+
+    while (flags != 0U)
+    {
+        lowestFlag = flags & (0U - flags);
+        COUNT_LEADING_ZEROS_32(lowestFlag, leadingZeros);
+        channel = (uint8_t)((dmaInstance << (uint32_t)FEATURE_DMA_CH_WIDTH) + (31U - leadingZeros));
+
+        EDMA_DRV_ClearIntStatus(channel);
+        if (channel != virtualChannel)
+        {
+            INT_SYS_ClearPending(s_edmaIrqId[channel]);
+        }
+        EDMA_DRV_ServiceChannel(channel);
+
+        flags &= ~lowestFlag;
+    }
+}
+#endif
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : EDMA_DRV_ErrorIRQHandler
@@ -536,6 +806,8 @@ void EDMA_DRV_ErrorIRQHandler(uint8_t virtualChannel)
         EDMA_DRV_ClearIntStatus(virtualChannel);
         EDMA_ClearErrorIntStatusFlag(edmaRegBase, dmaChannel);
         chnState->status = EDMA_CHN_ERROR;
+        chnState->stats.errors++;
+        EDMA_DRV_UpdateBusyTime(chnState, false);
         if (chnState->callback != NULL)
         {
             chnState->callback(chnState->parameter, chnState->status);
@@ -600,6 +872,8 @@ status_t EDMA_DRV_ConfigSingleBlockTransfer(uint8_t virtualChannel,
 
     if (retStatus == STATUS_SUCCESS)
     {
+        EDMA_DRV_DetachSTCDChain(virtualChannel);
+
         /* Clear transfer control descriptor for the current channel */
         EDMA_TCDClearReg(edmaRegBase, dmaChannel);
 
@@ -642,6 +916,8 @@ status_t EDMA_DRV_ConfigSingleBlockTransfer(uint8_t virtualChannel,
 
         /* Enable interrupt when the transfer completes */
         EDMA_TCDSetMajorCompleteIntCmd(edmaRegBase, dmaChannel, true);
+
+        EDMA_DRV_SetTransferAccounting(virtualChannel, dataBufferSize, 1U, 0U);
     }
 
     return retStatus;
@@ -686,6 +962,7 @@ status_t EDMA_DRV_ConfigMultiBlockTransfer(uint8_t virtualChannel,
 
         /* Set the number of data blocks */
         EDMA_TCDSetMajorCount(edmaRegBase, dmaChannel, blockCount);
+        EDMA_DRV_SetTransferAccounting(virtualChannel, blockSize * blockCount, 1U, 0U);
 
         /* Enable/disable requests upon completion */
         EDMA_TCDSetDisableDmaRequestAfterTCDDoneCmd(edmaRegBase, dmaChannel, disableReqOnCompletion);
@@ -780,6 +1057,7 @@ status_t EDMA_DRV_ConfigScatterGatherTransfer(uint8_t virtualChannel,
 #endif
 
     uint8_t i = 0U;
+    uint32_t totalBytes = 0U;
     uint16_t transferOffset = 0U;
     uint32_t stcdAlignedAddr = STCD_ADDR(stcd);
     edma_software_tcd_t *edmaSwTcdAddr = (edma_software_tcd_t *)stcdAlignedAddr;
@@ -850,36 +1128,7 @@ status_t EDMA_DRV_ConfigScatterGatherTransfer(uint8_t virtualChannel,
         }
         edmaTransferConfig.loopTransferConfig->majorLoopIterationCount = srcList[i].length/bytesOnEachRequest;
 
-        switch (srcList[i].type)
-        {
-            case EDMA_TRANSFER_PERIPH2MEM:
-                /* Configure Source Read. */
-                edmaTransferConfig.srcOffset = 0;
-                /* Configure Dest Write. */
-                edmaTransferConfig.destOffset = (int16_t) transferOffset;
-                break;
-            case EDMA_TRANSFER_MEM2PERIPH:
-                /* Configure Source Read. */
-                edmaTransferConfig.srcOffset = (int16_t) transferOffset;
-                /* Configure Dest Write. */
-                edmaTransferConfig.destOffset = 0;
-                break;
-            case EDMA_TRANSFER_MEM2MEM:
-                /* Configure Source Read. */
-                edmaTransferConfig.srcOffset = (int16_t) transferOffset;
-                /* Configure Dest Write. */
-                edmaTransferConfig.destOffset = (int16_t) transferOffset;
-                break;
-            case EDMA_TRANSFER_PERIPH2PERIPH:
-                /* Configure Source Read. */
-                edmaTransferConfig.srcOffset = 0;
-                /* Configure Dest Write. */
-                edmaTransferConfig.destOffset = 0;
-                break;
-            default:
-                /* This should never be reached - all the possible values have been handled. */
-                break;
-        }
+        EDMA_DRV_SetScatterGatherOffsets(srcList[i].type, (int16_t) transferOffset, &edmaTransferConfig);
 
         /* Configure the pointer to next software TCD structure; for the last one, this address should be 0 */
         if (i == ((uint8_t)(tcdCount - 1U)))
@@ -902,6 +1151,13 @@ status_t EDMA_DRV_ConfigScatterGatherTransfer(uint8_t virtualChannel,
             /* Copy configuration to software TCD structure */
             EDMA_DRV_PushConfigToSTCD(&edmaTransferConfig, &edmaSwTcdAddr[i - 1U]);
         }
+        totalBytes += srcList[i].length;
+    }
+
+    /* Every descriptor interrupts; the list completes on the last one */
+    if (retStatus == STATUS_SUCCESS)
+    {
+        EDMA_DRV_SetTransferAccounting(virtualChannel, totalBytes, tcdCount, 0U);
     }
 
     return retStatus;
@@ -909,12 +1165,15 @@ status_t EDMA_DRV_ConfigScatterGatherTransfer(uint8_t virtualChannel,
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : EDMA_DRV_StartChannel
- * Description   : Starts an eDMA channel.
+ * Function Name : EDMA_DRV_StartStream
+ * Description   : Configure the channel for a circular transfer over the two
+ * halves of a buffer, with half and major loop interrupts.
  *
- * Implements    : EDMA_DRV_StartChannel_Activity
+ * Implements    : EDMA_DRV_StartStream_Activity
  *END**************************************************************************/
-status_t EDMA_DRV_StartChannel(uint8_t virtualChannel)
+status_t EDMA_DRV_StartStream(uint8_t virtualChannel,
+                              edma_stream_t *stream,
+                              const edma_stream_config_t *config)
 {
     /* Check that virtual channel number is valid */
     DEV_ASSERT(virtualChannel < FEATURE_DMA_VIRTUAL_CHANNELS);
@@ -925,122 +1184,236 @@ status_t EDMA_DRV_StartChannel(uint8_t virtualChannel)
     /* Check that virtual channel is initialized */
     DEV_ASSERT(s_virtEdmaState->virtChnState[virtualChannel] != NULL);
 
+    DEV_ASSERT((stream != NULL) && (config != NULL) && (config->buffer != NULL));
+    DEV_ASSERT(EDMA_DRV_ValidTransferSize(config->transferSize));
+
     /* Get DMA instance from virtual channel */
     uint8_t dmaInstance = (uint8_t)FEATURE_DMA_VCH_TO_INSTANCE(virtualChannel);
 
     /* Get DMA channel from virtual channel*/
     uint8_t dmaChannel = (uint8_t)FEATURE_DMA_VCH_TO_CH(virtualChannel);
 
-    /* Enable requests for current channel */
     DMA_Type *edmaRegBase = s_edmaBase[dmaInstance];
-    EDMA_SetDmaRequestCmd(edmaRegBase, dmaChannel, true);
+    uint32_t accessSize = ((uint32_t)1U) << (uint32_t)config->transferSize;
+    uint32_t bufferAddr = (uint32_t)config->buffer;
+    int16_t memOffset = (int16_t)accessSize;
+    int32_t memLastAdjust = -(int32_t)(2U * config->halfSize);
+    edma_software_tcd_t stcd;
+    status_t retStatus = STATUS_SUCCESS;
 
-    return STATUS_SUCCESS;
+    /* Each request moves one access; both halves make a single major loop */
+    if ((config->halfSize == 0U) || ((config->halfSize % accessSize) != 0U) || ((bufferAddr % accessSize) != 0U) ||
+        (((2U * config->halfSize) / accessSize) > DMA_TCD_CITER_ELINKNO_CITER_MASK))
+    {
+        retStatus = STATUS_ERROR;
+    }
+    else
+    {
+        stream->virtChn = virtualChannel;
+        stream->buffer = config->buffer;
+        stream->halfSize = config->halfSize;
+        stream->halfCount = config->halfSize / accessSize;
+        stream->owned = 0U;
+        stream->nextHalf = 0U;
+        stream->overruns = 0U;
+        stream->callback = config->callback;
+        stream->callbackParam = config->callbackParam;
+
+        EDMA_DRV_ClearSoftwareTCD(&stcd);
+        stcd.ATTR = (uint16_t)(DMA_TCD_ATTR_SSIZE(config->transferSize) | DMA_TCD_ATTR_DSIZE(config->transferSize));
+        stcd.NBYTES = accessSize;
+        if (config->toPeripheral)
+        {
+            stcd.SADDR = bufferAddr;
+            stcd.SOFF = memOffset;
+            stcd.SLAST = memLastAdjust;
+            stcd.DADDR = config->periphAddr;
+        }
+        else
+        {
+            stcd.SADDR = config->periphAddr;
+            stcd.DADDR = bufferAddr;
+            stcd.DOFF = memOffset;
+            stcd.DLAST_SGA = memLastAdjust;
+        }
+        stcd.CITER = (uint16_t)DMA_TCD_CITER_ELINKNO_CITER(2U * stream->halfCount);
+        stcd.BITER = (uint16_t)DMA_TCD_BITER_ELINKNO_BITER(2U * stream->halfCount);
+        stcd.CSR = (uint16_t)(DMA_TCD_CSR_INTHALF(1U) | DMA_TCD_CSR_INTMAJOR(1U));
+
+        EDMA_DRV_DetachSTCDChain(virtualChannel);
+        EDMA_DRV_SetTransferAccounting(virtualChannel, 2U * config->halfSize, 1U, (uint16_t)stream->halfCount);
+        (void)EDMA_DRV_InstallCallback(virtualChannel, EDMA_DRV_StreamCallback, stream);
+        EDMA_TCDLoad(edmaRegBase, dmaChannel, &stcd);
+        (void)EDMA_DRV_StartChannel(virtualChannel);
+    }
+
+    return retStatus;
 }
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : EDMA_DRV_StopChannel
- * Description   : Stops an eDMA channel.
+ * Function Name : EDMA_DRV_ReleaseStreamHalf
+ * Description   : Give a half of the stream buffer back to the eDMA.
  *
- * Implements    : EDMA_DRV_StopChannel_Activity
+ * Implements    : EDMA_DRV_ReleaseStreamHalf_Activity
  *END**************************************************************************/
-status_t EDMA_DRV_StopChannel(uint8_t virtualChannel)
+void EDMA_DRV_ReleaseStreamHalf(edma_stream_t *stream,
+                                const uint8_t *half)
 {
-    /* Check that virtual channel number is valid */
-    DEV_ASSERT(virtualChannel < FEATURE_DMA_VIRTUAL_CHANNELS);
-
-    /* Check that eDMA module is initialized */
-    DEV_ASSERT(s_virtEdmaState != NULL);
+    DEV_ASSERT((stream != NULL) && (half != NULL));
+    DEV_ASSERT((half == stream->buffer) || (half == &stream->buffer[stream->halfSize]));
 
-    /* Check that virtual channel is initialized */
-    DEV_ASSERT(s_virtEdmaState->virtChnState[virtualChannel] != NULL);
+    uint8_t halfMask = (half == stream->buffer) ? 1U : 2U;
 
-    /* Get DMA instance from virtual channel */
-    uint8_t dmaInstance = (uint8_t)FEATURE_DMA_VCH_TO_INSTANCE(virtualChannel);
+    /* Only the application clears the bit: each half is released once per hand-over */
+    DEV_ASSERT((stream->owned & halfMask) != 0U);
 
-    /* Get DMA channel from virtual channel*/
-    uint8_t dmaChannel = (uint8_t)FEATURE_DMA_VCH_TO_CH(virtualChannel);
+    /* The channel interrupt updates the other bit */
+    INT_SYS_DisableIRQGlobal();
+    stream->owned &= (uint8_t)~halfMask;
+    INT_SYS_EnableIRQGlobal();
+}
 
-    /* Disable requests for current channel */
-    DMA_Type *edmaRegBase = s_edmaBase[dmaInstance];
-    EDMA_SetDmaRequestCmd(edmaRegBase, dmaChannel, false);
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_StopStream
+ * Description   : Stop the requests of a stream and remove its callback.
+ *
+ * Implements    : EDMA_DRV_StopStream_Activity
+ *END**************************************************************************/
+status_t EDMA_DRV_StopStream(uint8_t virtualChannel)
+{
+    (void)EDMA_DRV_StopChannel(virtualChannel);
 
-    return STATUS_SUCCESS;
+    return EDMA_DRV_InstallCallback(virtualChannel, NULL, NULL);
 }
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : EDMA_DRV_SetChannelRequest
- * Description   : Configures the DMA request for the eDMA channel.
+ * Function Name : EDMA_DRV_InitSTCDPool
+ * Description   : Carve 32-byte aligned software TCDs from a buffer.
  *
- * Implements    : EDMA_DRV_SetChannelRequest_Activity
+ * Implements    : EDMA_DRV_InitSTCDPool_Activity
  *END**************************************************************************/
-status_t EDMA_DRV_SetChannelRequest(uint8_t virtualChannel,
-                                    uint8_t req)
+void EDMA_DRV_InitSTCDPool(edma_stcd_pool_t *pool,
+                           void *buffer,
+                           uint32_t bufferSize)
 {
-    /* Check the mux channel number is valid */
-    DEV_ASSERT(virtualChannel < (uint32_t)FEATURE_DMA_VIRTUAL_CHANNELS);
+    uint32_t alignedAddr = STCD_ADDR(buffer);
+    uint32_t slack = alignedAddr - (uint32_t)buffer;
+    uint32_t count = 0U;
 
-    /* Check that eDMA module is initialized */
-    DEV_ASSERT(s_virtEdmaState != NULL);
+    DEV_ASSERT((pool != NULL) && (buffer != NULL));
 
-    /* Retrieve the DMAMUX instance serving this request */
-    uint8_t dmaMuxInstance = (uint8_t)FEATURE_DMAMUX_REQ_SRC_TO_INSTANCE(req);
+    if (bufferSize > slack)
+    {
+        count = (bufferSize - slack) / (uint32_t)sizeof(edma_software_tcd_t);
+    }
+    if (count > EDMA_STCD_POOL_MAX_SIZE)
+    {
+        count = EDMA_STCD_POOL_MAX_SIZE;
+    }
 
-    /* Get request source index for the corresponding DMAMUX instance */
-    uint8_t dmaMuxRequest = (uint8_t)FEATURE_DMAMUX_REQ_SRC_TO_CH(req);
+    pool->stcds = (edma_software_tcd_t *)alignedAddr;
+    pool->count = (uint8_t)count;
+    pool->freeMask = (count == EDMA_STCD_POOL_MAX_SIZE) ? 0xFFFFFFFFUL : ((1UL << count) - 1UL);
+}
 
-    /* Get DMAMUX channel for the selected request source */
-    uint8_t dmaMuxChannel = (uint8_t)FEATURE_DMAMUX_DMA_CH_TO_CH(virtualChannel);
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_AllocSTCDChain
+ * Description   : Take a run of contiguous free descriptors from the pool.
+ *
+ * Implements    : EDMA_DRV_AllocSTCDChain_Activity
+ *END**************************************************************************/
+status_t EDMA_DRV_AllocSTCDChain(edma_stcd_pool_t *pool,
+                                 edma_stcd_chain_t *chain,
+                                 uint8_t count)
+{
+    uint32_t mask;
+    uint32_t first;
+    status_t retStatus = STATUS_BUSY;
 
-    /* Retrieve the appropriate DMAMUX instance */
-    DMAMUX_Type *dmaMuxRegBase = s_dmaMuxBase[dmaMuxInstance];
+    DEV_ASSERT((pool != NULL) && (chain != NULL));
+    DEV_ASSERT((count > 0U) && (count <= EDMA_STCD_POOL_MAX_SIZE));
 
-    /* Set the request */
-    DMAMUX_SetChannelSource(dmaMuxRegBase, dmaMuxChannel, dmaMuxRequest);
+    mask = (count == EDMA_STCD_POOL_MAX_SIZE) ? 0xFFFFFFFFUL : ((1UL << count) - 1UL);
 
-    return STATUS_SUCCESS;
+    /* The descriptors are given back from the eDMA interrupts */
+    INT_SYS_DisableIRQGlobal();
+
+    for (first = 0U; ((first + count) <= pool->count) && (retStatus != STATUS_SUCCESS); first++)
+    {
+        if ((pool->freeMask & (mask << first)) == (mask << first))
+        {
+            pool->freeMask &= ~(mask << first);
+            chain->pool = pool;
+            chain->stcds = &pool->stcds[first];
+            chain->first = (uint8_t)first;
+            chain->count = count;
+            retStatus = STATUS_SUCCESS;
+        }
+    }
+
+    INT_SYS_EnableIRQGlobal();
+
+    return retStatus;
 }
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : EDMA_DRV_ClearTCD
- * Description   : Clears all registers to 0 for the hardware TCD.
+ * Function Name : EDMA_DRV_FreeSTCDChain
+ * Description   : Give the descriptors of a chain back to the pool.
  *
- * Implements    : EDMA_DRV_ClearTCD_Activity
+ * Implements    : EDMA_DRV_FreeSTCDChain_Activity
  *END**************************************************************************/
-void EDMA_DRV_ClearTCD(uint8_t virtualChannel)
+void EDMA_DRV_FreeSTCDChain(edma_stcd_chain_t *chain)
 {
-    /* Check that virtual channel number is valid */
-    DEV_ASSERT(virtualChannel < FEATURE_DMA_VIRTUAL_CHANNELS);
+    uint32_t mask;
+    uint8_t virtualChannel;
+    edma_chn_state_t *chnState;
 
-    /* Check that eDMA module is initialized */
-    DEV_ASSERT(s_virtEdmaState != NULL);
+    DEV_ASSERT(chain != NULL);
 
-    /* Check that virtual channel is initialized */
-    DEV_ASSERT(s_virtEdmaState->virtChnState[virtualChannel] != NULL);
+    INT_SYS_DisableIRQGlobal();
 
-    /* Get DMA instance from virtual channel */
-    uint8_t dmaInstance = (uint8_t)FEATURE_DMA_VCH_TO_INSTANCE(virtualChannel);
+    /* A channel still holding the chain must not free it again on its next interrupt */
+    if (s_virtEdmaState != NULL)
+    {
+        for (virtualChannel = 0U; virtualChannel < (uint8_t)FEATURE_DMA_VIRTUAL_CHANNELS; virtualChannel++)
+        {
+            chnState = s_virtEdmaState->virtChnState[virtualChannel];
+            if ((chnState != NULL) && (chnState->stcdChain == chain))
+            {
+                chnState->stcdChain = NULL;
+            }
+        }
+    }
 
-    /* Get DMA channel from virtual channel*/
-    uint8_t dmaChannel = (uint8_t)FEATURE_DMA_VCH_TO_CH(virtualChannel);
+    if (chain->count != 0U)
+    {
+        mask = (chain->count == EDMA_STCD_POOL_MAX_SIZE) ? 0xFFFFFFFFUL : ((1UL << chain->count) - 1UL);
+        chain->pool->freeMask |= mask << chain->first;
+        chain->count = 0U;
+    }
 
-    /* Clear the TCD memory */
-    DMA_Type *edmaRegBase = s_edmaBase[dmaInstance];
-    EDMA_TCDClearReg(edmaRegBase, dmaChannel);
+    INT_SYS_EnableIRQGlobal();
 }
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : EDMA_DRV_SetSrcAddr
- * Description   : Configures the source address for the eDMA channel.
+ * Function Name : EDMA_DRV_ConfigPooledScatterGather
+ * Description   : Build a scatter/gather chain in pooled descriptors and load
+ * its first descriptor in the channel.
  *
- * Implements    : EDMA_DRV_SetSrcAddr_Activity
+ * Implements    : EDMA_DRV_ConfigPooledScatterGather_Activity
  *END**************************************************************************/
-void EDMA_DRV_SetSrcAddr(uint8_t virtualChannel,
-                         uint32_t address)
+status_t EDMA_DRV_ConfigPooledScatterGather(uint8_t virtualChannel,
+                                            edma_stcd_chain_t *chain,
+                                            edma_transfer_size_t transferSize,
+                                            uint32_t bytesOnEachRequest,
+                                            const edma_scatter_gather_list_t *srcList,
+                                            const edma_scatter_gather_list_t *destList)
 {
     /* Check that virtual channel number is valid */
     DEV_ASSERT(virtualChannel < FEATURE_DMA_VIRTUAL_CHANNELS);
@@ -1051,16 +1424,317 @@ void EDMA_DRV_SetSrcAddr(uint8_t virtualChannel,
     /* Check that virtual channel is initialized */
     DEV_ASSERT(s_virtEdmaState->virtChnState[virtualChannel] != NULL);
 
-    /* Get DMA instance from virtual channel */
-    uint8_t dmaInstance = (uint8_t)FEATURE_DMA_VCH_TO_INSTANCE(virtualChannel);
+    /* Check the chain and the input arrays are valid */
+    DEV_ASSERT((chain != NULL) && (chain->count != 0U) && (srcList != NULL) && (destList != NULL));
 
-    /* Get DMA channel from virtual channel*/
-    uint8_t dmaChannel = (uint8_t)FEATURE_DMA_VCH_TO_CH(virtualChannel);
+    /* Check if the value passed for 'transferSize' is valid */
+    DEV_ASSERT(EDMA_DRV_ValidTransferSize(transferSize));
 
-    /* Set channel TCD source address */
-    DMA_Type *edmaRegBase = s_edmaBase[dmaInstance];
-    EDMA_TCDSetSrcAddr(edmaRegBase, dmaChannel, address);
-}
+    uint8_t i;
+    uint16_t transferOffset = (uint16_t) (1UL << ((uint16_t)transferSize));
+    edma_loop_transfer_config_t edmaLoopConfig;
+    edma_transfer_config_t edmaTransferConfig;
+    status_t retStatus = STATUS_SUCCESS;
+
+    /* The number of bytes to be transferred on each request must
+     * be a multiple of the source read/destination write size
+     */
+    if ((bytesOnEachRequest % transferOffset) != 0U)
+    {
+        retStatus = STATUS_ERROR;
+    }
+
+    edmaLoopConfig.srcOffsetEnable = false;
+    edmaLoopConfig.dstOffsetEnable = false;
+    edmaLoopConfig.minorLoopOffset = 0;
+    edmaLoopConfig.minorLoopChnLinkEnable = false;
+    edmaLoopConfig.minorLoopChnLinkNumber = 0U;
+    edmaLoopConfig.majorLoopChnLinkEnable = false;
+    edmaLoopConfig.majorLoopChnLinkNumber = 0U;
+
+    edmaTransferConfig.srcLastAddrAdjust = 0;
+    edmaTransferConfig.destLastAddrAdjust = 0;
+    edmaTransferConfig.srcModulo = EDMA_MODULO_OFF;
+    edmaTransferConfig.destModulo = EDMA_MODULO_OFF;
+    edmaTransferConfig.srcTransferSize = transferSize;
+    edmaTransferConfig.destTransferSize = transferSize;
+    edmaTransferConfig.minorByteTransferCount = bytesOnEachRequest;
+    edmaTransferConfig.loopTransferConfig = &edmaLoopConfig;
+
+    for (i = 0U; (i < chain->count) && (retStatus == STATUS_SUCCESS); i++)
+    {
+        if ((srcList[i].length != destList[i].length) || (srcList[i].type != destList[i].type))
+        {
+            retStatus = STATUS_ERROR;
+        }
+        else
+        {
+            edmaTransferConfig.srcAddr = srcList[i].address;
+            edmaTransferConfig.destAddr = destList[i].address;
+            edmaLoopConfig.majorLoopIterationCount = srcList[i].length / bytesOnEachRequest;
+            EDMA_DRV_SetScatterGatherOffsets(srcList[i].type, (int16_t) transferOffset, &edmaTransferConfig);
+
+            /* Only the last descriptor ends the chain and raises the interrupt */
+            if (i == (uint8_t)(chain->count - 1U))
+            {
+                edmaTransferConfig.scatterGatherEnable = false;
+                edmaTransferConfig.scatterGatherNextDescAddr = 0U;
+                edmaTransferConfig.interruptEnable = true;
+            }
+            else
+            {
+                edmaTransferConfig.scatterGatherEnable = true;
+                edmaTransferConfig.scatterGatherNextDescAddr = (uint32_t) &chain->stcds[i + 1U];
+                edmaTransferConfig.interruptEnable = false;
+            }
+
+            EDMA_DRV_PushConfigToSTCD(&edmaTransferConfig, &chain->stcds[i]);
+        }
+    }
+
+    if (retStatus == STATUS_SUCCESS)
+    {
+        retStatus = EDMA_DRV_RearmSTCDChain(virtualChannel, chain, NULL, NULL);
+    }
+
+    return retStatus;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_RearmSTCDChain
+ * Description   : Patch the addresses of a pooled chain and load its first
+ * descriptor in the channel.
+ *
+ * Implements    : EDMA_DRV_RearmSTCDChain_Activity
+ *END**************************************************************************/
+status_t EDMA_DRV_RearmSTCDChain(uint8_t virtualChannel,
+                                 edma_stcd_chain_t *chain,
+                                 const uint32_t *srcAddrs,
+                                 const uint32_t *destAddrs)
+{
+    /* Check that virtual channel number is valid */
+    DEV_ASSERT(virtualChannel < FEATURE_DMA_VIRTUAL_CHANNELS);
+
+    /* Check that eDMA module is initialized */
+    DEV_ASSERT(s_virtEdmaState != NULL);
+
+    /* Check that virtual channel is initialized */
+    DEV_ASSERT(s_virtEdmaState->virtChnState[virtualChannel] != NULL);
+
+    DEV_ASSERT(chain != NULL);
+
+    /* Get DMA instance from virtual channel */
+    uint8_t dmaInstance = (uint8_t)FEATURE_DMA_VCH_TO_INSTANCE(virtualChannel);
+
+    /* Get DMA channel from virtual channel*/
+    uint8_t dmaChannel = (uint8_t)FEATURE_DMA_VCH_TO_CH(virtualChannel);
+
+    status_t retStatus = STATUS_SUCCESS;
+    uint32_t totalBytes = 0U;
+    uint8_t i;
+
+    if (chain->count == 0U)
+    {
+        retStatus = STATUS_ERROR;
+    }
+    else
+    {
+        for (i = 0U; i < chain->count; i++)
+        {
+            totalBytes += chain->stcds[i].NBYTES * ((uint32_t)chain->stcds[i].BITER & DMA_TCD_BITER_ELINKNO_BITER_MASK);
+            if (srcAddrs != NULL)
+            {
+                chain->stcds[i].SADDR = srcAddrs[i];
+            }
+            if (destAddrs != NULL)
+            {
+                chain->stcds[i].DADDR = destAddrs[i];
+            }
+        }
+
+        s_virtEdmaState->virtChnState[virtualChannel]->stcdChain = chain;
+
+        /* Only the last descriptor interrupts, once for the whole chain */
+        EDMA_DRV_SetTransferAccounting(virtualChannel, totalBytes, 1U, 0U);
+
+        /* The channel runs the first descriptor from its registers */
+        EDMA_TCDLoad(s_edmaBase[dmaInstance], dmaChannel, &chain->stcds[0]);
+    }
+
+    return retStatus;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_StartChannel
+ * Description   : Starts an eDMA channel.
+ *
+ * Implements    : EDMA_DRV_StartChannel_Activity
+ *END**************************************************************************/
+status_t EDMA_DRV_StartChannel(uint8_t virtualChannel)
+{
+    /* Check that virtual channel number is valid */
+    DEV_ASSERT(virtualChannel < FEATURE_DMA_VIRTUAL_CHANNELS);
+
+    /* Check that eDMA module is initialized */
+    DEV_ASSERT(s_virtEdmaState != NULL);
+
+    /* Check that virtual channel is initialized */
+    DEV_ASSERT(s_virtEdmaState->virtChnState[virtualChannel] != NULL);
+
+    /* Get DMA instance from virtual channel */
+    uint8_t dmaInstance = (uint8_t)FEATURE_DMA_VCH_TO_INSTANCE(virtualChannel);
+
+    /* Get DMA channel from virtual channel*/
+    uint8_t dmaChannel = (uint8_t)FEATURE_DMA_VCH_TO_CH(virtualChannel);
+
+    /* Start the busy period of the channel */
+    edma_chn_state_t *chnState = s_virtEdmaState->virtChnState[virtualChannel];
+    if (!chnState->busy)
+    {
+        EDMA_DRV_UpdateBusyTime(chnState, true);
+    }
+
+    /* Enable requests for current channel */
+    DMA_Type *edmaRegBase = s_edmaBase[dmaInstance];
+    EDMA_SetDmaRequestCmd(edmaRegBase, dmaChannel, true);
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_StopChannel
+ * Description   : Stops an eDMA channel.
+ *
+ * Implements    : EDMA_DRV_StopChannel_Activity
+ *END**************************************************************************/
+status_t EDMA_DRV_StopChannel(uint8_t virtualChannel)
+{
+    /* Check that virtual channel number is valid */
+    DEV_ASSERT(virtualChannel < FEATURE_DMA_VIRTUAL_CHANNELS);
+
+    /* Check that eDMA module is initialized */
+    DEV_ASSERT(s_virtEdmaState != NULL);
+
+    /* Check that virtual channel is initialized */
+    DEV_ASSERT(s_virtEdmaState->virtChnState[virtualChannel] != NULL);
+
+    /* Get DMA instance from virtual channel */
+    uint8_t dmaInstance = (uint8_t)FEATURE_DMA_VCH_TO_INSTANCE(virtualChannel);
+
+    /* Get DMA channel from virtual channel*/
+    uint8_t dmaChannel = (uint8_t)FEATURE_DMA_VCH_TO_CH(virtualChannel);
+
+    /* Disable requests for current channel */
+    DMA_Type *edmaRegBase = s_edmaBase[dmaInstance];
+    EDMA_SetDmaRequestCmd(edmaRegBase, dmaChannel, false);
+
+    /* End the busy period of the channel */
+    EDMA_DRV_UpdateBusyTime(s_virtEdmaState->virtChnState[virtualChannel], false);
+
+    /* A pooled chain stopped halfway is left to the caller to free */
+    EDMA_DRV_DetachSTCDChain(virtualChannel);
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_SetChannelRequest
+ * Description   : Configures the DMA request for the eDMA channel.
+ *
+ * Implements    : EDMA_DRV_SetChannelRequest_Activity
+ *END**************************************************************************/
+status_t EDMA_DRV_SetChannelRequest(uint8_t virtualChannel,
+                                    uint8_t req)
+{
+    /* Check the mux channel number is valid */
+    DEV_ASSERT(virtualChannel < (uint32_t)FEATURE_DMA_VIRTUAL_CHANNELS);
+
+    /* Check that eDMA module is initialized */
+    DEV_ASSERT(s_virtEdmaState != NULL);
+
+    /* Retrieve the DMAMUX instance serving this request */
+    uint8_t dmaMuxInstance = (uint8_t)FEATURE_DMAMUX_REQ_SRC_TO_INSTANCE(req);
+
+    /* Get request source index for the corresponding DMAMUX instance */
+    uint8_t dmaMuxRequest = (uint8_t)FEATURE_DMAMUX_REQ_SRC_TO_CH(req);
+
+    /* Get DMAMUX channel for the selected request source */
+    uint8_t dmaMuxChannel = (uint8_t)FEATURE_DMAMUX_DMA_CH_TO_CH(virtualChannel);
+
+    /* Retrieve the appropriate DMAMUX instance */
+    DMAMUX_Type *dmaMuxRegBase = s_dmaMuxBase[dmaMuxInstance];
+
+    /* Set the request */
+    DMAMUX_SetChannelSource(dmaMuxRegBase, dmaMuxChannel, dmaMuxRequest);
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_ClearTCD
+ * Description   : Clears all registers to 0 for the hardware TCD.
+ *
+ * Implements    : EDMA_DRV_ClearTCD_Activity
+ *END**************************************************************************/
+void EDMA_DRV_ClearTCD(uint8_t virtualChannel)
+{
+    /* Check that virtual channel number is valid */
+    DEV_ASSERT(virtualChannel < FEATURE_DMA_VIRTUAL_CHANNELS);
+
+    /* Check that eDMA module is initialized */
+    DEV_ASSERT(s_virtEdmaState != NULL);
+
+    /* Check that virtual channel is initialized */
+    DEV_ASSERT(s_virtEdmaState->virtChnState[virtualChannel] != NULL);
+
+    /* Get DMA instance from virtual channel */
+    uint8_t dmaInstance = (uint8_t)FEATURE_DMA_VCH_TO_INSTANCE(virtualChannel);
+
+    /* Get DMA channel from virtual channel*/
+    uint8_t dmaChannel = (uint8_t)FEATURE_DMA_VCH_TO_CH(virtualChannel);
+
+    EDMA_DRV_DetachSTCDChain(virtualChannel);
+    EDMA_DRV_SetTransferAccounting(virtualChannel, 0U, 1U, 0U);
+
+    /* Clear the TCD memory */
+    DMA_Type *edmaRegBase = s_edmaBase[dmaInstance];
+    EDMA_TCDClearReg(edmaRegBase, dmaChannel);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_SetSrcAddr
+ * Description   : Configures the source address for the eDMA channel.
+ *
+ * Implements    : EDMA_DRV_SetSrcAddr_Activity
+ *END**************************************************************************/
+void EDMA_DRV_SetSrcAddr(uint8_t virtualChannel,
+                         uint32_t address)
+{
+    /* Check that virtual channel number is valid */
+    DEV_ASSERT(virtualChannel < FEATURE_DMA_VIRTUAL_CHANNELS);
+
+    /* Check that eDMA module is initialized */
+    DEV_ASSERT(s_virtEdmaState != NULL);
+
+    /* Check that virtual channel is initialized */
+    DEV_ASSERT(s_virtEdmaState->virtChnState[virtualChannel] != NULL);
+
+    /* Get DMA instance from virtual channel */
+    uint8_t dmaInstance = (uint8_t)FEATURE_DMA_VCH_TO_INSTANCE(virtualChannel);
+
+    /* Get DMA channel from virtual channel*/
+    uint8_t dmaChannel = (uint8_t)FEATURE_DMA_VCH_TO_CH(virtualChannel);
+
+    /* Set channel TCD source address */
+    DMA_Type *edmaRegBase = s_edmaBase[dmaInstance];
+    EDMA_TCDSetSrcAddr(edmaRegBase, dmaChannel, address);
+}
 
 /*FUNCTION**********************************************************************
  *
@@ -1460,6 +2134,9 @@ void EDMA_DRV_ConfigureInterrupt(uint8_t virtualChannel,
         case EDMA_CHN_HALF_MAJOR_LOOP_INT:
             /* Enable channel interrupt request when major iteration count reaches halfway point */
             EDMA_TCDSetMajorHalfCompleteIntCmd(edmaRegBase, dmaChannel, enable);
+            /* The count of the configured major loop tells the half interrupts apart */
+            s_virtEdmaState->virtChnState[virtualChannel]->halfIterations =
+                enable ? (uint16_t)(EDMA_TCDGetCurrentMajorCount(edmaRegBase, dmaChannel) / 2U) : 0U;
             break;
         case EDMA_CHN_MAJOR_LOOP_INT:
             /* Enable channel interrupt request when major iteration count reaches zero */
@@ -1603,6 +2280,8 @@ void EDMA_DRV_PushConfigToReg(uint8_t virtualChannel,
 
     DMA_Type *edmaRegBase = s_edmaBase[dmaInstance];
 
+    EDMA_DRV_DetachSTCDChain(virtualChannel);
+
     /* Clear TCD registers */
     EDMA_TCDClearReg(edmaRegBase, dmaChannel);
 
@@ -1652,19 +2331,557 @@ void EDMA_DRV_PushConfigToReg(uint8_t virtualChannel,
     {
         EDMA_TCDSetNbytes(edmaRegBase, dmaChannel, tcd->minorByteTransferCount);
     }
+
+    EDMA_DRV_SetTransferAccounting(virtualChannel, EDMA_TCDGetMajorLoopBytes(edmaRegBase, dmaChannel), 1U, 0U);
 }
 
-#ifdef DEV_ERROR_DETECT
 /*FUNCTION**********************************************************************
  *
- * Function Name : EDMA_DRV_ValidTransferSize
- * Description   : Check if the transfer size value is legal (0/1/2/4/5).
+ * Function Name : EDMA_DRV_ComputePipelineTcds
+ * Description   : Validate the stages of a pipeline and compute their software
+ * TCDs, with the stage links translated into channel links.
  *
+ * Implements    : EDMA_DRV_ComputePipelineTcds_Activity
  *END**************************************************************************/
-static bool EDMA_DRV_ValidTransferSize(edma_transfer_size_t size)
+status_t EDMA_DRV_ComputePipelineTcds(const edma_pipeline_stage_t *stages,
+                                      uint8_t stageCount,
+                                      const uint8_t *channels,
+                                      edma_software_tcd_t *stcds)
 {
-    bool isValid;
-    switch (size)
+    status_t retStatus = STATUS_SUCCESS;
+    uint8_t index;
+
+    DEV_ASSERT((stages != NULL) && (channels != NULL) && (stcds != NULL));
+
+    if ((stageCount == 0U) || (stageCount > FEATURE_DMA_CHANNELS))
+    {
+        retStatus = STATUS_ERROR;
+    }
+
+    for (index = 0U; (index < stageCount) && (retStatus == STATUS_SUCCESS); index++)
+    {
+        DEV_ASSERT(channels[index] < FEATURE_DMA_CHANNELS);
+
+        if (EDMA_DRV_CheckPipelineStage(&stages[index], stageCount))
+        {
+            EDMA_DRV_PipelineStageToSTCD(&stages[index], channels, &stcds[index]);
+        }
+        else
+        {
+            retStatus = STATUS_ERROR;
+        }
+    }
+
+    return retStatus;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_BuildPipeline
+ * Description   : Allocate a channel of the same eDMA instance for each stage
+ * and load the TCDs of the pipeline into them.
+ *
+ * Implements    : EDMA_DRV_BuildPipeline_Activity
+ *END**************************************************************************/
+status_t EDMA_DRV_BuildPipeline(edma_pipeline_t *pipeline,
+                                edma_chn_state_t *chnStates,
+                                const edma_pipeline_stage_t *stages,
+                                uint8_t stageCount)
+{
+    uint8_t channels[FEATURE_DMA_CHANNELS];
+    edma_channel_config_t chnConfig;
+    edma_software_tcd_t stcd;
+    status_t retStatus = STATUS_SUCCESS;
+    uint32_t dmaInstance;
+    uint32_t virtualChannel;
+    uint8_t found = 0U;
+    uint8_t index;
+
+    DEV_ASSERT((pipeline != NULL) && (chnStates != NULL) && (stages != NULL));
+
+    /* Check that eDMA module is initialized */
+    DEV_ASSERT(s_virtEdmaState != NULL);
+
+    pipeline->stages = stages;
+    pipeline->stageCount = 0U;
+
+    if ((stageCount == 0U) || (stageCount > FEATURE_DMA_CHANNELS))
+    {
+        retStatus = STATUS_ERROR;
+    }
+
+    for (index = 0U; (index < stageCount) && (retStatus == STATUS_SUCCESS); index++)
+    {
+        if (!EDMA_DRV_CheckPipelineStage(&stages[index], stageCount))
+        {
+            retStatus = STATUS_ERROR;
+        }
+    }
+
+    /* Look for an instance with enough free channels; the channel links only
+     * reach the channels of the same instance */
+    for (dmaInstance = 0U; (dmaInstance < (uint32_t)DMA_INSTANCE_COUNT) && (retStatus == STATUS_SUCCESS) &&
+                           (found < stageCount); dmaInstance++)
+    {
+        found = 0U;
+        for (index = 0U; (index < FEATURE_DMA_CHANNELS) && (found < stageCount); index++)
+        {
+            virtualChannel = (dmaInstance * (uint32_t)FEATURE_DMA_CHANNELS) + index;
+            if (s_virtEdmaState->virtChnState[virtualChannel] == NULL)
+            {
+                pipeline->virtChannels[found] = (uint8_t)virtualChannel;
+                channels[found] = index;
+                found++;
+            }
+        }
+    }
+
+    if ((retStatus == STATUS_SUCCESS) && (found < stageCount))
+    {
+        retStatus = STATUS_BUSY;
+    }
+
+    for (index = 0U; (index < stageCount) && (retStatus == STATUS_SUCCESS); index++)
+    {
+        chnConfig.channelPriority = EDMA_CHN_DEFAULT_PRIORITY;
+        chnConfig.virtChnConfig = pipeline->virtChannels[index];
+        chnConfig.source = stages[index].source;
+        chnConfig.callback = NULL;
+        chnConfig.callbackParam = NULL;
+#if FEATURE_DMA_CHANNEL_GROUP_COUNT > 0x1U
+#ifdef FEATURE_DMA_HWV3
+        chnConfig.groupPriority = EDMA_CHN_GROUP_0;
+#endif
+#endif
+        retStatus = EDMA_DRV_ChannelInit(&chnStates[index], &chnConfig);
+        if (retStatus == STATUS_SUCCESS)
+        {
+            pipeline->stageCount++;
+        }
+    }
+
+    if (retStatus == STATUS_SUCCESS)
+    {
+        for (index = 0U; index < stageCount; index++)
+        {
+            EDMA_DRV_PipelineStageToSTCD(&stages[index], channels, &stcd);
+            EDMA_TCDLoad(s_edmaBase[FEATURE_DMA_VCH_TO_INSTANCE(pipeline->virtChannels[index])],
+                         channels[index], &stcd);
+        }
+    }
+    else
+    {
+        /* Give back the channels allocated before the failure */
+        (void)EDMA_DRV_ReleasePipeline(pipeline);
+    }
+
+    return retStatus;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_StartPipeline
+ * Description   : Enable the requests of the pipeline stages and start the
+ * stages which are neither requested nor linked.
+ *
+ * Implements    : EDMA_DRV_StartPipeline_Activity
+ *END**************************************************************************/
+status_t EDMA_DRV_StartPipeline(const edma_pipeline_t *pipeline)
+{
+    const edma_pipeline_stage_t *stage;
+    bool linked;
+    uint8_t index;
+    uint8_t other;
+
+    DEV_ASSERT(pipeline != NULL);
+
+    for (index = 0U; index < pipeline->stageCount; index++)
+    {
+        if (pipeline->stages[index].source != EDMA_REQ_DISABLED)
+        {
+            (void)EDMA_DRV_StartChannel(pipeline->virtChannels[index]);
+        }
+    }
+
+    for (index = 0U; index < pipeline->stageCount; index++)
+    {
+        linked = false;
+        for (other = 0U; other < pipeline->stageCount; other++)
+        {
+            stage = &pipeline->stages[other];
+            if ((other != index) && ((stage->minorLinkStage == index) || (stage->majorLinkStage == index)))
+            {
+                linked = true;
+            }
+        }
+
+        if ((pipeline->stages[index].source == EDMA_REQ_DISABLED) && !linked)
+        {
+            EDMA_DRV_TriggerSwRequest(pipeline->virtChannels[index]);
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_StopPipeline
+ * Description   : Disable the requests of all the pipeline stages.
+ *
+ * Implements    : EDMA_DRV_StopPipeline_Activity
+ *END**************************************************************************/
+status_t EDMA_DRV_StopPipeline(const edma_pipeline_t *pipeline)
+{
+    uint8_t index;
+
+    DEV_ASSERT(pipeline != NULL);
+
+    for (index = 0U; index < pipeline->stageCount; index++)
+    {
+        (void)EDMA_DRV_StopChannel(pipeline->virtChannels[index]);
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_ReleasePipeline
+ * Description   : Free the channels of the pipeline stages.
+ *
+ * Implements    : EDMA_DRV_ReleasePipeline_Activity
+ *END**************************************************************************/
+status_t EDMA_DRV_ReleasePipeline(edma_pipeline_t *pipeline)
+{
+    uint8_t index;
+
+    DEV_ASSERT(pipeline != NULL);
+
+    for (index = 0U; index < pipeline->stageCount; index++)
+    {
+        (void)EDMA_DRV_ReleaseChannel(pipeline->virtChannels[index]);
+    }
+    pipeline->stageCount = 0U;
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_CheckPipelineStage
+ * Description   : Check the alignment, modulo, loop count and link constraints
+ * of a pipeline stage.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static bool EDMA_DRV_CheckPipelineStage(const edma_pipeline_stage_t *stage,
+                                        uint8_t stageCount)
+{
+    uint32_t srcSize;
+    uint32_t destSize;
+    uint32_t maxCount;
+    bool isValid = EDMA_DRV_ValidTransferSize(stage->srcTransferSize) &&
+                   EDMA_DRV_ValidTransferSize(stage->destTransferSize);
+
+    if (isValid)
+    {
+        srcSize = ((uint32_t)1U) << (uint32_t)stage->srcTransferSize;
+        destSize = ((uint32_t)1U) << (uint32_t)stage->destTransferSize;
+
+        /* Addresses, offsets and last adjustments are aligned on the transfer size */
+        isValid = ((stage->srcAddr % srcSize) == 0U) && ((stage->destAddr % destSize) == 0U) &&
+                  (((uint32_t)stage->srcOffset % srcSize) == 0U) && (((uint32_t)stage->destOffset % destSize) == 0U) &&
+                  (((uint32_t)stage->srcLastAddrAdjust % srcSize) == 0U) &&
+                  (((uint32_t)stage->destLastAddrAdjust % destSize) == 0U);
+
+        /* Minor loops move whole source reads and destination writes; NBYTES keeps
+         * 30 bits when minor loop mapping is enabled */
+        isValid = isValid && (stage->minorByteTransferCount != 0U) &&
+                  (stage->minorByteTransferCount <= 0x3FFFFFFFU) &&
+                  ((stage->minorByteTransferCount % srcSize) == 0U) &&
+                  ((stage->minorByteTransferCount % destSize) == 0U);
+
+        /* The modulo range holds whole transfers, the ring starts on a range
+         * boundary and one offset step stays inside the ring */
+        isValid = isValid && EDMA_DRV_CheckPipelineModulo(stage->srcAddr, stage->srcOffset, srcSize, stage->srcModulo) &&
+                  EDMA_DRV_CheckPipelineModulo(stage->destAddr, stage->destOffset, destSize, stage->destModulo);
+
+        /* A minor link takes 6 bits of the major loop count */
+        maxCount = (stage->minorLinkStage != EDMA_PIPELINE_NO_LINK) ?
+                   DMA_TCD_CITER_ELINKYES_CITER_LE_MASK : DMA_TCD_CITER_ELINKNO_CITER_MASK;
+        isValid = isValid && (stage->majorLoopIterationCount != 0U) && (stage->majorLoopIterationCount <= maxCount);
+
+        isValid = isValid &&
+                  ((stage->minorLinkStage == EDMA_PIPELINE_NO_LINK) || (stage->minorLinkStage < stageCount)) &&
+                  ((stage->majorLinkStage == EDMA_PIPELINE_NO_LINK) || (stage->majorLinkStage < stageCount));
+    }
+
+    return isValid;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_CheckPipelineModulo
+ * Description   : Check the modulo setting of one side of a pipeline stage.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static bool EDMA_DRV_CheckPipelineModulo(uint32_t address,
+                                         int16_t offset,
+                                         uint32_t transferSize,
+                                         edma_modulo_t modulo)
+{
+    uint32_t range;
+    uint32_t step;
+    bool isValid = true;
+
+    if (modulo != EDMA_MODULO_OFF)
+    {
+        range = ((uint32_t)1U) << (uint32_t)modulo;
+        step = (offset < 0) ? (uint32_t)(-(int32_t)offset) : (uint32_t)offset;
+        isValid = (range >= transferSize) && (step < range) && ((address % range) == 0U);
+    }
+
+    return isValid;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_PipelineStageToSTCD
+ * Description   : Translate a validated pipeline stage into a software TCD.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void EDMA_DRV_PipelineStageToSTCD(const edma_pipeline_stage_t *stage,
+                                         const uint8_t *channels,
+                                         edma_software_tcd_t *stcd)
+{
+    uint16_t csr;
+
+    EDMA_DRV_ClearSoftwareTCD(stcd);
+
+    stcd->SADDR = stage->srcAddr;
+    stcd->SOFF = stage->srcOffset;
+    stcd->ATTR = (uint16_t)(DMA_TCD_ATTR_SMOD(stage->srcModulo) | DMA_TCD_ATTR_SSIZE(stage->srcTransferSize) |
+                            DMA_TCD_ATTR_DMOD(stage->destModulo) | DMA_TCD_ATTR_DSIZE(stage->destTransferSize));
+    stcd->NBYTES = stage->minorByteTransferCount;
+    stcd->SLAST = stage->srcLastAddrAdjust;
+    stcd->DADDR = stage->destAddr;
+    stcd->DOFF = stage->destOffset;
+    stcd->DLAST_SGA = stage->destLastAddrAdjust;
+
+    if (stage->minorLinkStage != EDMA_PIPELINE_NO_LINK)
+    {
+        stcd->CITER = (uint16_t)(DMA_TCD_CITER_ELINKYES_ELINK(1U) |
+                                 DMA_TCD_CITER_ELINKYES_LINKCH(channels[stage->minorLinkStage]) |
+                                 DMA_TCD_CITER_ELINKYES_CITER_LE(stage->majorLoopIterationCount));
+        stcd->BITER = (uint16_t)(DMA_TCD_BITER_ELINKYES_ELINK(1U) |
+                                 DMA_TCD_BITER_ELINKYES_LINKCH(channels[stage->minorLinkStage]) |
+                                 DMA_TCD_BITER_ELINKYES_BITER(stage->majorLoopIterationCount));
+    }
+    else
+    {
+        stcd->CITER = (uint16_t)DMA_TCD_CITER_ELINKNO_CITER(stage->majorLoopIterationCount);
+        stcd->BITER = (uint16_t)DMA_TCD_BITER_ELINKNO_BITER(stage->majorLoopIterationCount);
+    }
+
+    csr = (uint16_t)(DMA_TCD_CSR_INTMAJOR(stage->interruptEnable ? 1U : 0U) |
+                     DMA_TCD_CSR_DREQ(stage->disableReqOnCompletion ? 1U : 0U));
+    if (stage->majorLinkStage != EDMA_PIPELINE_NO_LINK)
+    {
+        csr |= (uint16_t)(DMA_TCD_CSR_MAJORELINK(1U) | DMA_TCD_CSR_MAJORLINKCH(channels[stage->majorLinkStage]));
+    }
+    stcd->CSR = csr;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_StreamCallback
+ * Description   : Hand the completed half of a stream to the application and
+ * detect the overruns. The completed half is derived from the current major
+ * loop count, so that a late interrupt covering both completions is noticed.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void EDMA_DRV_StreamCallback(void *parameter,
+                                    edma_chn_status_t status)
+{
+    edma_stream_t *stream = (edma_stream_t *)parameter;
+    uint32_t remaining;
+    uint8_t done;
+    uint8_t writing;
+
+    if (status == EDMA_CHN_ERROR)
+    {
+        if (stream->callback != NULL)
+        {
+            stream->callback(stream->callbackParam, EDMA_STREAM_ERROR, NULL);
+        }
+    }
+    else
+    {
+        /* The count is reloaded at the end of the second half */
+        remaining = EDMA_DRV_GetRemainingMajorIterationsCount(stream->virtChn);
+        done = (remaining > stream->halfCount) ? 1U : 0U;
+        writing = (uint8_t)(1U - done);
+
+        /* The eDMA now works on the other half: it must have been released and
+         * its own completion must have been reported. A half the application
+         * still holds stays with it; taking it back here would let its late
+         * release give away the next hand-over of the same half. */
+        if (((stream->owned & (1U << writing)) != 0U) || (done != stream->nextHalf))
+        {
+            stream->overruns++;
+            if (stream->callback != NULL)
+            {
+                stream->callback(stream->callbackParam, EDMA_STREAM_OVERRUN,
+                                 &stream->buffer[(uint32_t)writing * stream->halfSize]);
+            }
+        }
+
+        stream->nextHalf = writing;
+
+        /* A half overwritten while the application held it is not handed over
+         * again; its data was lost with the overrun */
+        if ((stream->owned & (1U << done)) == 0U)
+        {
+            stream->owned |= (uint8_t)(1U << done);
+            if (stream->callback != NULL)
+            {
+                stream->callback(stream->callbackParam, EDMA_STREAM_HALF_COMPLETE,
+                                 &stream->buffer[(uint32_t)done * stream->halfSize]);
+            }
+        }
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_UpdateBusyTime
+ * Description   : Add the elapsed part of the busy period of a channel to its
+ * counters and start a new period if the channel stays busy.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void EDMA_DRV_UpdateBusyTime(edma_chn_state_t *chnState,
+                                    bool busy)
+{
+    uint32_t now = 0U;
+
+    /* The channel interrupt and the thread code both end busy periods: the
+     * timestamp and the update must not be split by one of them */
+    INT_SYS_DisableIRQGlobal();
+
+    if (s_edmaTimestamp != NULL)
+    {
+        now = s_edmaTimestamp();
+    }
+
+    if (chnState->busy)
+    {
+        chnState->stats.busyTime += now - chnState->busyStart;
+    }
+
+    chnState->busy = busy;
+    chnState->busyStart = now;
+
+    INT_SYS_EnableIRQGlobal();
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_DetachSTCDChain
+ * Description   : Forget the pooled chain loaded in a channel, once the channel
+ * is given another transfer or stopped, so that a later interrupt of the channel
+ * does not give the chain back to its pool.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void EDMA_DRV_DetachSTCDChain(uint8_t virtualChannel)
+{
+    s_virtEdmaState->virtChnState[virtualChannel]->stcdChain = NULL;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_SetTransferAccounting
+ * Description   : Record the size of the transfer configured in a channel, the
+ * number of major loop interrupts it raises, and the major count left at its
+ * half interrupt (0 without half interrupt). The channel interrupt counts the
+ * transfer from them.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void EDMA_DRV_SetTransferAccounting(uint8_t virtualChannel,
+                                           uint32_t bytes,
+                                           uint8_t interrupts,
+                                           uint16_t halfIterations)
+{
+    edma_chn_state_t *chnState = s_virtEdmaState->virtChnState[virtualChannel];
+
+    INT_SYS_DisableIRQGlobal();
+    chnState->transferBytes = bytes;
+    chnState->transferInterrupts = interrupts;
+    chnState->interruptCount = 0U;
+    chnState->halfIterations = halfIterations;
+    INT_SYS_EnableIRQGlobal();
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_SetScatterGatherOffsets
+ * Description   : Set the source and destination offsets of a scatter/gather
+ * descriptor according to the transfer type.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void EDMA_DRV_SetScatterGatherOffsets(edma_transfer_type_t type,
+                                             int16_t transferOffset,
+                                             edma_transfer_config_t *config)
+{
+    switch (type)
+    {
+        case EDMA_TRANSFER_PERIPH2MEM:
+            /* Configure Source Read. */
+            config->srcOffset = 0;
+            /* Configure Dest Write. */
+            config->destOffset = transferOffset;
+            break;
+        case EDMA_TRANSFER_MEM2PERIPH:
+            /* Configure Source Read. */
+            config->srcOffset = transferOffset;
+            /* Configure Dest Write. */
+            config->destOffset = 0;
+            break;
+        case EDMA_TRANSFER_MEM2MEM:
+            /* Configure Source Read. */
+            config->srcOffset = transferOffset;
+            /* Configure Dest Write. */
+            config->destOffset = transferOffset;
+            break;
+        case EDMA_TRANSFER_PERIPH2PERIPH:
+            /* Configure Source Read. */
+            config->srcOffset = 0;
+            /* Configure Dest Write. */
+            config->destOffset = 0;
+            break;
+        default:
+            /* This should never be reached - all the possible values have been handled. */
+            break;
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_ValidTransferSize
+ * Description   : Check if the transfer size value is legal (0/1/2/4/5).
+ *
+ *END**************************************************************************/
+static bool EDMA_DRV_ValidTransferSize(edma_transfer_size_t size)
+{
+    bool isValid;
+    switch (size)
     {
 #ifdef FEATURE_DMA_HWV3
         case EDMA_TRANSFER_SIZE_1B:
@@ -1694,7 +2911,78 @@ static bool EDMA_DRV_ValidTransferSize(edma_transfer_size_t size)
     }
     return isValid;
 }
-#endif
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_SetTimestampSource
+ * Description   : Set the timestamp source of the busy time accounting.
+ *
+ * Implements    : EDMA_DRV_SetTimestampSource_Activity
+ *END**************************************************************************/
+void EDMA_DRV_SetTimestampSource(edma_timestamp_t timestamp)
+{
+    s_edmaTimestamp = timestamp;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_GetChannelStats
+ * Description   : Returns the activity counters of the eDMA channel.
+ *
+ * Implements    : EDMA_DRV_GetChannelStats_Activity
+ *END**************************************************************************/
+void EDMA_DRV_GetChannelStats(uint8_t virtualChannel,
+                              edma_chn_stats_t *stats)
+{
+    /* Check that virtual channel number is valid */
+    DEV_ASSERT(virtualChannel < FEATURE_DMA_VIRTUAL_CHANNELS);
+
+    /* Check that eDMA module is initialized */
+    DEV_ASSERT(s_virtEdmaState != NULL);
+
+    /* Check that virtual channel is initialized */
+    DEV_ASSERT(s_virtEdmaState->virtChnState[virtualChannel] != NULL);
+
+    DEV_ASSERT(stats != NULL);
+
+    /* The counters are updated from the channel interrupts */
+    INT_SYS_DisableIRQGlobal();
+    *stats = s_virtEdmaState->virtChnState[virtualChannel]->stats;
+    INT_SYS_EnableIRQGlobal();
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_DRV_ResetChannelStats
+ * Description   : Clears the activity counters of the eDMA channel.
+ *
+ * Implements    : EDMA_DRV_ResetChannelStats_Activity
+ *END**************************************************************************/
+void EDMA_DRV_ResetChannelStats(uint8_t virtualChannel)
+{
+    /* Check that virtual channel number is valid */
+    DEV_ASSERT(virtualChannel < FEATURE_DMA_VIRTUAL_CHANNELS);
+
+    /* Check that eDMA module is initialized */
+    DEV_ASSERT(s_virtEdmaState != NULL);
+
+    /* Check that virtual channel is initialized */
+    DEV_ASSERT(s_virtEdmaState->virtChnState[virtualChannel] != NULL);
+
+    edma_chn_state_t *chnState = s_virtEdmaState->virtChnState[virtualChannel];
+
+    INT_SYS_DisableIRQGlobal();
+    chnState->stats.bytes = 0U;
+    chnState->stats.transfers = 0U;
+    chnState->stats.errors = 0U;
+    chnState->stats.busyTime = 0U;
+    if (chnState->busy)
+    {
+        EDMA_DRV_UpdateBusyTime(chnState, true);
+        chnState->stats.busyTime = 0U;
+    }
+    INT_SYS_EnableIRQGlobal();
+}
 
 /*FUNCTION**********************************************************************
  *
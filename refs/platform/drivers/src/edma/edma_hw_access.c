@@ -249,6 +249,34 @@ void EDMA_TCDClearReg(DMA_Type * base, uint8_t channel)
     base->TCD[channel].BITER.ELINKNO = 0U;
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : EDMA_TCDLoad
+ * Description   : Copy a software TCD to the hardware TCD of eDMA channel.
+ *END**************************************************************************/
+void EDMA_TCDLoad(DMA_Type * base, uint8_t channel, const edma_software_tcd_t *stcd)
+{
+#ifdef DEV_ERROR_DETECT
+    DEV_ASSERT(channel < FEATURE_DMA_CHANNELS);
+#endif
+    base->TCD[channel].CSR = 0U;
+    base->TCD[channel].SADDR = stcd->SADDR;
+    base->TCD[channel].SOFF = (uint16_t)stcd->SOFF;
+    base->TCD[channel].ATTR = stcd->ATTR;
+#ifdef FEATURE_DMA_HWV3
+    base->TCD[channel].NBYTES.MLOFFNO = stcd->NBYTES;
+#else
+    base->TCD[channel].NBYTES.MLNO = stcd->NBYTES;
+#endif
+    base->TCD[channel].SLAST = (uint32_t)stcd->SLAST;
+    base->TCD[channel].DADDR = stcd->DADDR;
+    base->TCD[channel].DOFF = (uint16_t)stcd->DOFF;
+    base->TCD[channel].CITER.ELINKNO = stcd->CITER;
+    base->TCD[channel].DLASTSGA = (uint32_t)stcd->DLAST_SGA;
+    base->TCD[channel].BITER.ELINKNO = stcd->BITER;
+    base->TCD[channel].CSR = stcd->CSR;
+}
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : EDMA_TCDSetAttribute
@@ -157,6 +157,38 @@ static inline void EDMA_SetChannelPriority(DMA_Type * base, uint8_t channel, edm
 #endif
 }
 
+/*!
+ * @brief Configures the preemption of the eDMA channel.
+ *
+ * Preemption only applies when the channel arbitration uses fixed priorities.
+ *
+ * @param base Register base address for eDMA module.
+ * @param channel eDMA channel number.
+ * @param preemptible The channel can be suspended by a higher priority channel (ECP).
+ * @param canPreempt The channel can suspend a lower priority channel (inverse of DPA).
+ */
+static inline void EDMA_SetChannelPreemption(DMA_Type * base, uint8_t channel, bool preemptible, bool canPreempt)
+{
+#ifdef DEV_ERROR_DETECT
+    DEV_ASSERT(channel < FEATURE_DMA_CHANNELS);
+#endif
+
+#ifdef FEATURE_DMA_HWV3
+    uint32_t regValTemp;
+    regValTemp = base->TCD[channel].CH_PRI;
+    regValTemp &= (uint32_t)~(DMA_TCD_CH_PRI_ECP_MASK | DMA_TCD_CH_PRI_DPA_MASK);
+    regValTemp |= (uint32_t)(DMA_TCD_CH_PRI_ECP(preemptible ? 1UL : 0UL) | DMA_TCD_CH_PRI_DPA(canPreempt ? 0UL : 1UL));
+    base->TCD[channel].CH_PRI = regValTemp;
+#else
+    uint8_t regValTemp;
+    uint8_t index = (uint8_t)FEATURE_DMA_CHN_TO_DCHPRI_INDEX(channel);
+    regValTemp = base->DCHPRI[index];
+    regValTemp &= (uint8_t)~(DMA_DCHPRI_ECP_MASK | DMA_DCHPRI_DPA_MASK);
+    regValTemp |= (uint8_t)(DMA_DCHPRI_ECP(preemptible ? 1U : 0U) | DMA_DCHPRI_DPA(canPreempt ? 0U : 1U));
+    base->DCHPRI[index] = regValTemp;
+#endif
+}
+
 /*!
  * @brief Sets the channel arbitration algorithm.
  *
@@ -350,6 +382,44 @@ static inline void EDMA_ClearDoneStatusFlag(DMA_Type * base, uint8_t channel)
 #endif
 }
 
+/*!
+ * @brief Returns the done status of the eDMA channel (major loop completed).
+ *
+ * @param base Register base address for eDMA module.
+ * @param channel Channel indicator.
+ * @return true if the major loop completed since the flag was last cleared.
+ */
+static inline bool EDMA_GetDoneStatusFlag(const DMA_Type * base, uint8_t channel)
+{
+#ifdef DEV_ERROR_DETECT
+    DEV_ASSERT(channel < FEATURE_DMA_CHANNELS);
+#endif
+#ifdef FEATURE_DMA_HWV3
+    return ((base->TCD[channel].CH_CSR & DMA_TCD_CH_CSR_DONE_MASK) != 0U);
+#else
+    return ((base->TCD[channel].CSR & DMA_TCD_CSR_DONE_MASK) != 0U);
+#endif
+}
+
+/*!
+ * @brief Returns whether the DMA requests of the eDMA channel are enabled.
+ *
+ * @param base Register base address for eDMA module.
+ * @param channel Channel indicator.
+ * @return true if the requests are enabled.
+ */
+static inline bool EDMA_GetDmaRequestStatus(const DMA_Type * base, uint8_t channel)
+{
+#ifdef DEV_ERROR_DETECT
+    DEV_ASSERT(channel < FEATURE_DMA_CHANNELS);
+#endif
+#ifdef FEATURE_DMA_HWV3
+    return ((base->TCD[channel].CH_CSR & DMA_TCD_CH_CSR_ERQ_MASK) != 0U);
+#else
+    return (((base->ERQ >> channel) & 1U) != 0U);
+#endif
+}
+
 /*!
  * @brief Triggers the eDMA channel.
  *
@@ -386,6 +456,20 @@ static inline void EDMA_ClearIntStatusFlag(DMA_Type * base, uint8_t channel)
 #endif
 }
 
+#ifndef FEATURE_DMA_HWV3
+/*!
+ * @brief Gets the eDMA interrupt request status of all the channels.
+ *
+ * @param base Register base address for eDMA module.
+ * @return 32 bit variable indicating the channels requesting an interrupt. If channel n
+ * requests an interrupt, the bit n of this variable is '1'. If not, it is '0'.
+ */
+static inline uint32_t EDMA_GetIntStatusFlags(const DMA_Type * base)
+{
+    return base->INT;
+}
+#endif
+
 /*! @} */
 
 /*!
@@ -401,6 +485,18 @@ static inline void EDMA_ClearIntStatusFlag(DMA_Type * base, uint8_t channel)
  */
 void EDMA_TCDClearReg(DMA_Type * base, uint8_t channel);
 
+/*!
+ * @brief Copies a software TCD to the hardware TCD.
+ *
+ * The control and status word is written last, so that the channel sees a
+ * complete descriptor when its links are enabled.
+ *
+ * @param base Register base address for eDMA module.
+ * @param channel eDMA channel number.
+ * @param stcd The software TCD.
+ */
+void EDMA_TCDLoad(DMA_Type * base, uint8_t channel, const edma_software_tcd_t *stcd);
+
 /*!
  * @brief Configures the source address for the hardware TCD.
  *
@@ -828,6 +924,57 @@ void EDMA_TCDSetChannelMinorLink(DMA_Type * base, uint8_t channel, uint32_t link
  */
 void EDMA_TCDSetMajorCount(DMA_Type * base, uint8_t channel, uint32_t count);
 
+/*!
+ * @brief Returns the number of bytes moved by a complete major loop of the hardware TCD.
+ *
+ * The minor byte count is decoded according to the minor loop mapping settings and
+ * multiplied by the beginning major iteration count.
+ *
+ * @param base Register base address for eDMA module.
+ * @param channel eDMA channel number.
+ * @return bytes of a major loop
+ */
+static inline uint32_t EDMA_TCDGetMajorLoopBytes(const DMA_Type * base, uint8_t channel)
+{
+#ifdef DEV_ERROR_DETECT
+    DEV_ASSERT(channel < FEATURE_DMA_CHANNELS);
+#endif
+#ifdef FEATURE_DMA_HWV3
+    uint32_t nbytes = base->TCD[channel].NBYTES.MLOFFNO;
+    if ((nbytes & (DMA_TCD_NBYTES_MLOFFNO_SMLOE_MASK | DMA_TCD_NBYTES_MLOFFNO_DMLOE_MASK)) != 0U)
+    {
+        nbytes &= DMA_TCD_NBYTES_MLOFFYES_NBYTES_MASK;
+    }
+    else
+    {
+        nbytes &= DMA_TCD_NBYTES_MLOFFNO_NBYTES_MASK;
+    }
+#else
+    uint32_t nbytes = base->TCD[channel].NBYTES.MLNO;
+    if (((base->CR >> DMA_CR_EMLM_SHIFT) & 1U) != 0U)
+    {
+        if ((nbytes & (DMA_TCD_NBYTES_MLOFFYES_SMLOE_MASK | DMA_TCD_NBYTES_MLOFFYES_DMLOE_MASK)) != 0U)
+        {
+            nbytes &= DMA_TCD_NBYTES_MLOFFYES_NBYTES_MASK;
+        }
+        else
+        {
+            nbytes &= DMA_TCD_NBYTES_MLOFFNO_NBYTES_MASK;
+        }
+    }
+#endif
+    uint16_t biter = base->TCD[channel].BITER.ELINKNO;
+    if ((biter & DMA_TCD_BITER_ELINKNO_ELINK_MASK) != 0U)
+    {
+        biter &= (uint16_t)DMA_TCD_BITER_ELINKYES_BITER_MASK;
+    }
+    else
+    {
+        biter &= (uint16_t)DMA_TCD_BITER_ELINKNO_BITER_MASK;
+    }
+    return nbytes * (uint32_t)biter;
+}
+
 /*!
  * @brief Returns the current major iteration count.
  *
@@ -207,192 +207,192 @@ void DMA16_31_IRQHandler(void)
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA0_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(0U);
+    EDMA_DRV_ChannelIRQHandler(0U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA1_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(1U);
+    EDMA_DRV_ChannelIRQHandler(1U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA2_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(2U);
+    EDMA_DRV_ChannelIRQHandler(2U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA3_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(3U);
+    EDMA_DRV_ChannelIRQHandler(3U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA4_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(4U);
+    EDMA_DRV_ChannelIRQHandler(4U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA5_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(5U);
+    EDMA_DRV_ChannelIRQHandler(5U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA6_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(6U);
+    EDMA_DRV_ChannelIRQHandler(6U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA7_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(7U);
+    EDMA_DRV_ChannelIRQHandler(7U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA8_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(8U);
+    EDMA_DRV_ChannelIRQHandler(8U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA9_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(9U);
+    EDMA_DRV_ChannelIRQHandler(9U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA10_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(10U);
+    EDMA_DRV_ChannelIRQHandler(10U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA11_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(11U);
+    EDMA_DRV_ChannelIRQHandler(11U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA12_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(12U);
+    EDMA_DRV_ChannelIRQHandler(12U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA13_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(13U);
+    EDMA_DRV_ChannelIRQHandler(13U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA14_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(14U);
+    EDMA_DRV_ChannelIRQHandler(14U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA15_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(15U);
+    EDMA_DRV_ChannelIRQHandler(15U);
 }
 #if (FEATURE_DMA_CHANNELS > 16U)
 void DMA16_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(16U);
+    EDMA_DRV_ChannelIRQHandler(16U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA17_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(17U);
+    EDMA_DRV_ChannelIRQHandler(17U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA18_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(18U);
+    EDMA_DRV_ChannelIRQHandler(18U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA19_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(19U);
+    EDMA_DRV_ChannelIRQHandler(19U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA20_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(20U);
+    EDMA_DRV_ChannelIRQHandler(20U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA21_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(21U);
+    EDMA_DRV_ChannelIRQHandler(21U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA22_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(22U);
+    EDMA_DRV_ChannelIRQHandler(22U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA23_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(23U);
+    EDMA_DRV_ChannelIRQHandler(23U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA24_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(24U);
+    EDMA_DRV_ChannelIRQHandler(24U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA25_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(25U);
+    EDMA_DRV_ChannelIRQHandler(25U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA26_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(26U);
+    EDMA_DRV_ChannelIRQHandler(26U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA27_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(27U);
+    EDMA_DRV_ChannelIRQHandler(27U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA28_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(28U);
+    EDMA_DRV_ChannelIRQHandler(28U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA29_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(29U);
+    EDMA_DRV_ChannelIRQHandler(29U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA30_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(30U);
+    EDMA_DRV_ChannelIRQHandler(30U);
 }
 
 /*! @brief DMA IRQ handler with the same name in the startup code*/
 void DMA31_IRQHandler(void)
 {
-    EDMA_DRV_IRQHandler(31U);
+    EDMA_DRV_ChannelIRQHandler(31U);
 }
 #endif
 #endif
@@ -403,17 +403,16 @@ void DMA_Error_IRQHandler(void)
 {
 	const DMA_Type * edmaRegBase = EDMA_DRV_GetDmaRegBaseAddr(0U);
     uint32_t error = EDMA_GetErrorIntStatusFlag(edmaRegBase);
-    uint8_t virtualChannel = 0U;
+    uint32_t lowestError;
+    uint32_t leadingZeros;
 
-    for (virtualChannel = 0U;
-         virtualChannel < FEATURE_DMA_VIRTUAL_CHANNELS;
-         virtualChannel++)
+    /* Visit the channels in error only, lowest channel first */
+    while (error != 0U)
     {
-        if((error & EDMA_ERR_LSB_MASK) != 0UL)
-        {
-            EDMA_DRV_ErrorIRQHandler(virtualChannel);
-        }
-        error = error >> 1U;
+        lowestError = error & (0U - error);
+        COUNT_LEADING_ZEROS_32(lowestError, leadingZeros);
+        EDMA_DRV_ErrorIRQHandler((uint8_t)(31U - leadingZeros));
+        error &= ~lowestError;
     }
 }
 #endif
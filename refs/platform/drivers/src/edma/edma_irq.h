@@ -32,6 +32,10 @@ void EDMA_DRV_ErrorIRQHandler(uint8_t virtualChannel);
 #else
 /*! @brief DMA channel interrupt handler, implemented in driver c file. */
 void EDMA_DRV_IRQHandler(uint8_t virtualChannel);
+#ifdef FEATURE_DMA_SEPARATE_IRQ_LINES_PER_CHN
+/*! @brief DMA channel interrupt line handler, implemented in driver c file. */
+void EDMA_DRV_ChannelIRQHandler(uint8_t virtualChannel);
+#endif
 #ifdef FEATURE_DMA_HAS_ERROR_IRQ
 /*! @brief DMA error interrupt handler, implemented in driver c file. */
 void EDMA_DRV_ErrorIRQHandler(uint8_t virtualChannel);
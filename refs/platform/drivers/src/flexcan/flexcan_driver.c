@@ -69,12 +69,50 @@
 #include "flexcan_hw_access.h"
 #include "flexcan_irq.h"
 #include "interrupt_manager.h"
+#include "clock_manager.h"
 
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
 
-#define FLEXCAN_MB_HANDLE_RXFIFO    0U
+/* Register ranges of a bit timing, in time quanta */
+typedef struct
+{
+    uint32_t maxPreDivider;
+    uint32_t minQuanta;
+    uint32_t maxQuanta;
+    uint32_t minPropSeg;
+    uint32_t maxPropSeg;
+    uint32_t maxPhaseSeg1;
+    uint32_t maxPhaseSeg2;
+    uint32_t maxRJumpwidth;
+    uint32_t propSegOffset;     /* Register value = propagation segment - offset */
+} flexcan_bit_timing_limits_t;
+
+/* Sample point error of an impossible bit timing */
+#define FLEXCAN_BIT_TIMING_NONE         0xFFFFFFFFU
+/* Data phase bitrates above which the transceiver loop delay is compensated */
+#define FLEXCAN_BIT_TIMING_TDC_BITRATE  1000000U
+#define FLEXCAN_BIT_TIMING_TDC_MAX      ((1UL << CAN_FDCTRL_TDCOFF_WIDTH) - 1UL)
+
+/* Layout of the format A Rx FIFO ID filter elements and masks */
+#define FLEXCAN_RX_FILTER_RTR_MASK      0x80000000U
+#define FLEXCAN_RX_FILTER_IDE_MASK      0x40000000U
+#define FLEXCAN_RX_FILTER_STD_SHIFT     19U
+#define FLEXCAN_RX_FILTER_STD_MASK      0x3FF80000U
+#define FLEXCAN_RX_FILTER_EXT_SHIFT     1U
+#define FLEXCAN_RX_FILTER_EXT_MASK      0x3FFFFFFEU
+#define FLEXCAN_RX_FILTER_STD_ID_MAX    0x7FFU
+#define FLEXCAN_RX_FILTER_EXT_ID_MAX    0x1FFFFFFFU
+/* Global mask of the elements without individual mask: exact match */
+#define FLEXCAN_RX_FILTER_GLOBAL_MASK   (FLEXCAN_RX_FILTER_RTR_MASK | FLEXCAN_RX_FILTER_IDE_MASK | \
+                                         FLEXCAN_RX_FILTER_EXT_MASK)
+/* Elements which can use an individual mask */
+#define FLEXCAN_RX_FILTER_MASKED_ELEMENTS ((CAN_RXIMR_COUNT < FLEXCAN_RX_FIFO_MAX_FILTER_ELEMENTS) ? \
+                                           CAN_RXIMR_COUNT : FLEXCAN_RX_FIFO_MAX_FILTER_ELEMENTS)
+/* Empty slot and load limit of the software ID hash set */
+#define FLEXCAN_RX_FILTER_SW_EMPTY      0xFFFFFFFFU
+#define FLEXCAN_RX_FILTER_SW_MAX_IDS    ((FLEXCAN_RX_FILTER_SW_IDS * 3U) / 4U)
 
 /*******************************************************************************
  * Variables
@@ -83,6 +121,41 @@
 /* Table of base addresses for CAN instances. */
 static CAN_Type * const g_flexcanBase[] = CAN_BASE_PTRS;
 
+/* Bit timing ranges of CTRL1 (classical CAN), CBT (arbitration phase) and FDCBT (data phase) */
+static const flexcan_bit_timing_limits_t g_flexcanNominalLimits = {
+    .maxPreDivider = 1UL << CAN_CTRL1_PRESDIV_WIDTH,
+    .minQuanta = 8U,
+    .maxQuanta = 25U,
+    .minPropSeg = 1U,
+    .maxPropSeg = 1UL << CAN_CTRL1_PROPSEG_WIDTH,
+    .maxPhaseSeg1 = 1UL << CAN_CTRL1_PSEG1_WIDTH,
+    .maxPhaseSeg2 = 1UL << CAN_CTRL1_PSEG2_WIDTH,
+    .maxRJumpwidth = 1UL << CAN_CTRL1_RJW_WIDTH,
+    .propSegOffset = 1U
+};
+static const flexcan_bit_timing_limits_t g_flexcanExtendedLimits = {
+    .maxPreDivider = 1UL << CAN_CBT_EPRESDIV_WIDTH,
+    .minQuanta = 8U,
+    .maxQuanta = 129U,
+    .minPropSeg = 1U,
+    .maxPropSeg = 1UL << CAN_CBT_EPROPSEG_WIDTH,
+    .maxPhaseSeg1 = 1UL << CAN_CBT_EPSEG1_WIDTH,
+    .maxPhaseSeg2 = 1UL << CAN_CBT_EPSEG2_WIDTH,
+    .maxRJumpwidth = 1UL << CAN_CBT_ERJW_WIDTH,
+    .propSegOffset = 1U
+};
+static const flexcan_bit_timing_limits_t g_flexcanDataLimits = {
+    .maxPreDivider = 1UL << CAN_FDCBT_FPRESDIV_WIDTH,
+    .minQuanta = 5U,
+    .maxQuanta = 48U,
+    .minPropSeg = 0U,
+    .maxPropSeg = (1UL << CAN_FDCBT_FPROPSEG_WIDTH) - 1UL,
+    .maxPhaseSeg1 = 1UL << CAN_FDCBT_FPSEG1_WIDTH,
+    .maxPhaseSeg2 = 1UL << CAN_FDCBT_FPSEG2_WIDTH,
+    .maxRJumpwidth = 1UL << CAN_FDCBT_FRJW_WIDTH,
+    .propSegOffset = 0U
+};
+
 /* Tables to save CAN IRQ enum numbers defined in CMSIS header file. */
 #if FEATURE_CAN_HAS_WAKE_UP_IRQ
 static const IRQn_Type g_flexcanWakeUpIrqId[] = CAN_Wake_Up_IRQS;
@@ -98,6 +171,7 @@ static flexcan_state_t * g_flexcanStatePtr[CAN_INSTANCE_COUNT] = { NULL };
 /*******************************************************************************
  * Private Functions
  ******************************************************************************/
+static volatile uint32_t * FLEXCAN_GetMsgBuffAddr(const flexcan_state_t * state, uint32_t mb_idx);
 static status_t FLEXCAN_StartSendData(
                     uint8_t instance,
                     uint8_t mb_idx,
@@ -115,12 +189,64 @@ static status_t FLEXCAN_StartRxMessageBufferData(
 static status_t FLEXCAN_StartRxMessageFifoData(
                     uint8_t instance,
                     flexcan_msgbuff_t *data,
+                    uint32_t batchSize,
                     bool isBlocking
                     );
 static void FLEXCAN_CompleteTransfer(uint8_t instance, uint32_t mb_idx);
 static void FLEXCAN_CompleteRxMessageFifoData(uint8_t instance);
+static void FLEXCAN_ReadRxFifoBatch(uint8_t instance);
+static void FLEXCAN_CompleteRxRingMessageBuffer(uint8_t instance, uint32_t mb_idx);
+static void FLEXCAN_CompleteRxRingFifo(uint8_t instance);
+static void FLEXCAN_StopRxRing(uint8_t instance, uint32_t mb_idx);
+static void FLEXCAN_ServiceMsgBuff(uint8_t instance, uint32_t mb_idx);
+static status_t FLEXCAN_LoadTxQueueMb(uint8_t instance,
+                                      uint32_t mb_idx,
+                                      const flexcan_data_info_t *tx_info,
+                                      uint32_t msg_id,
+                                      const uint8_t *mb_data);
+static status_t FLEXCAN_ServiceTxQueue(uint8_t instance, uint32_t mb_idx);
+static void FLEXCAN_KickTxQueue(uint8_t instance);
+static uint64_t FLEXCAN_ExtendTimestamp(uint8_t instance, uint32_t cs, uint64_t *now);
+static void FLEXCAN_StampRxFrame(uint8_t instance, uint32_t mb_idx, flexcan_msgbuff_t *frame);
+#if FEATURE_CAN_HAS_DMA_ENABLE
+static void FLEXCAN_StampRxFifoBatch(uint8_t instance, flexcan_msgbuff_t *frames, uint32_t count);
+#endif
+static void FLEXCAN_StampTxFrame(uint8_t instance, uint32_t mb_idx);
+static void FLEXCAN_RecordLatency(flexcan_state_t *state, uint32_t mb_idx, uint64_t latency);
+static void FLEXCAN_DisableErrInt(uint8_t instance);
+static bool FLEXCAN_UpdateFaultState(uint8_t instance, flexcan_fault_state_t *previousState);
+#if FEATURE_CAN_HAS_PRETENDED_NETWORKING
+static uint32_t FLEXCAN_CountPNWakeIds(const flexcan_pn_wake_rule_t *rules, uint32_t ruleCount);
+static bool FLEXCAN_IsPNStopMode(power_manager_modes_t mode);
+#endif
+static uint32_t FLEXCAN_EncodeRxFifoId(bool isExtended, uint32_t id);
+static uint32_t FLEXCAN_GetRxFilterFullMask(uint32_t idFilter);
+static status_t FLEXCAN_InsertRxFilter(flexcan_rx_filter_program_t *program, uint32_t idFilter, uint32_t idMask);
+static void FLEXCAN_RemoveRxFilter(flexcan_rx_filter_program_t *program, uint32_t idx);
+static status_t FLEXCAN_MoveRxFilterToSoftware(flexcan_rx_filter_program_t *program,
+                                               uint32_t idFilter, uint32_t idMask);
+static status_t FLEXCAN_FitRxFilters(flexcan_rx_filter_program_t *program);
+static void FLEXCAN_PlaceRxFilters(flexcan_rx_filter_program_t *program);
+static uint32_t FLEXCAN_GetRxFilterSwSlot(uint32_t key);
+static status_t FLEXCAN_AddRxFilterSwId(flexcan_rx_filter_program_t *program, uint32_t key);
+static bool FLEXCAN_FindRxFilterSwId(const flexcan_rx_filter_program_t *program, uint32_t key);
+static uint32_t FLEXCAN_ComputePhaseTiming(const flexcan_bit_timing_limits_t *limits,
+                                           uint32_t clocksPerBit,
+                                           uint32_t preDivider,
+                                           uint32_t samplePoint,
+                                           flexcan_time_segment_t *timeSeg);
+static uint32_t FLEXCAN_ComputeDataTiming(uint32_t clocksPerBit,
+                                          uint32_t preDivider,
+                                          uint32_t samplePoint,
+                                          bool tdcEnable,
+                                          flexcan_bit_timing_t *timing);
 #if FEATURE_CAN_HAS_DMA_ENABLE
 static void FLEXCAN_CompleteRxFifoDataDMA(void *parameter, edma_chn_status_t status);
+static status_t FLEXCAN_StartTxDmaBatch(uint8_t instance);
+static bool FLEXCAN_ServiceTxDma(uint8_t instance, uint32_t mb_idx);
+static bool FLEXCAN_StopTxDma(uint8_t instance);
+static void FLEXCAN_CompleteTxDmaError(void *parameter, edma_chn_status_t status);
+static void FLEXCAN_UnpackRxFifoDMAFrame(flexcan_msgbuff_t *fifo_message, const uint32_t *mb_image);
 #endif
 /*******************************************************************************
  * Code
@@ -233,6 +359,285 @@ void  FLEXCAN_DRV_GetBitrateFD(uint8_t instance, flexcan_time_segment_t *bitrate
     FLEXCAN_ExitFreezeMode(base);
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ComputePhaseTiming
+ * Description   : Computes the time segments of one phase for a given prescaler.
+ * The sample point is placed as close as the register ranges allow to the
+ * requested one. Returns the distance between the two, in thousandths of a
+ * percent, or FLEXCAN_BIT_TIMING_NONE if the prescaler cannot produce the bitrate.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static uint32_t FLEXCAN_ComputePhaseTiming(const flexcan_bit_timing_limits_t *limits,
+                                           uint32_t clocksPerBit,
+                                           uint32_t preDivider,
+                                           uint32_t samplePoint,
+                                           flexcan_time_segment_t *timeSeg)
+{
+    uint32_t quanta, tseg1, phaseSeg1, phaseSeg2, achieved;
+
+    if ((preDivider > limits->maxPreDivider) || ((clocksPerBit % preDivider) != 0U))
+    {
+        return FLEXCAN_BIT_TIMING_NONE;
+    }
+
+    quanta = clocksPerBit / preDivider;
+    if ((quanta < limits->minQuanta) || (quanta > limits->maxQuanta))
+    {
+        return FLEXCAN_BIT_TIMING_NONE;
+    }
+
+    /* Time quanta after the sample point, within the phase segment 2 range */
+    phaseSeg2 = quanta - (((quanta * samplePoint) + 500U) / 1000U);
+    if (phaseSeg2 < 2U)
+    {
+        phaseSeg2 = 2U;
+    }
+    if (phaseSeg2 > limits->maxPhaseSeg2)
+    {
+        phaseSeg2 = limits->maxPhaseSeg2;
+    }
+
+    /* Propagation and phase segment 1 fill the rest of the bit after the sync segment */
+    tseg1 = quanta - 1U - phaseSeg2;
+    if (tseg1 > (limits->maxPropSeg + limits->maxPhaseSeg1))
+    {
+        tseg1 = limits->maxPropSeg + limits->maxPhaseSeg1;
+        phaseSeg2 = quanta - 1U - tseg1;
+    }
+    if ((tseg1 < (limits->minPropSeg + 1U)) || (phaseSeg2 > limits->maxPhaseSeg2))
+    {
+        return FLEXCAN_BIT_TIMING_NONE;
+    }
+
+    /* Keep phase segment 1 as long as phase segment 2 to allow the widest resync jump */
+    phaseSeg1 = (phaseSeg2 < limits->maxPhaseSeg1) ? phaseSeg2 : limits->maxPhaseSeg1;
+    if (phaseSeg1 > (tseg1 - limits->minPropSeg))
+    {
+        phaseSeg1 = tseg1 - limits->minPropSeg;
+    }
+    if ((tseg1 - phaseSeg1) > limits->maxPropSeg)
+    {
+        phaseSeg1 = tseg1 - limits->maxPropSeg;
+    }
+
+    timeSeg->preDivider = preDivider - 1U;
+    timeSeg->propSeg = (tseg1 - phaseSeg1) - limits->propSegOffset;
+    timeSeg->phaseSeg1 = phaseSeg1 - 1U;
+    timeSeg->phaseSeg2 = phaseSeg2 - 1U;
+    timeSeg->rJumpwidth = ((phaseSeg1 < phaseSeg2) ? phaseSeg1 : phaseSeg2);
+    if (timeSeg->rJumpwidth > limits->maxRJumpwidth)
+    {
+        timeSeg->rJumpwidth = limits->maxRJumpwidth;
+    }
+    timeSeg->rJumpwidth -= 1U;
+
+    achieved = ((tseg1 + 1U) * 100000U) / quanta;
+    return (achieved > (samplePoint * 100U)) ? (achieved - (samplePoint * 100U)) :
+                                               ((samplePoint * 100U) - achieved);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ComputeDataTiming
+ * Description   : Computes the data phase time segments for a given prescaler.
+ * When the Transceiver Delay Compensation is needed, the secondary sample point
+ * is placed at the data phase sample point, or as close as the TDC offset allows.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static uint32_t FLEXCAN_ComputeDataTiming(uint32_t clocksPerBit,
+                                          uint32_t preDivider,
+                                          uint32_t samplePoint,
+                                          bool tdcEnable,
+                                          flexcan_bit_timing_t *timing)
+{
+    uint32_t error, offset;
+
+    error = FLEXCAN_ComputePhaseTiming(&g_flexcanDataLimits, clocksPerBit, preDivider,
+                                       samplePoint, &timing->bitrate_cbt);
+    if (error == FLEXCAN_BIT_TIMING_NONE)
+    {
+        return error;
+    }
+
+    /* PE clock cycles from the start of the bit to the sample point */
+    offset = preDivider * (timing->bitrate_cbt.propSeg + timing->bitrate_cbt.phaseSeg1 + 2U);
+    if (offset > FLEXCAN_BIT_TIMING_TDC_MAX)
+    {
+        offset = FLEXCAN_BIT_TIMING_TDC_MAX;
+    }
+
+    timing->tdcEnable = tdcEnable;
+    timing->tdcOffset = tdcEnable ? (uint8_t) offset : 0U;
+
+    return error;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_ComputeBitTiming
+ * Description   : Computes the time segments for the requested bitrates.
+ * This function will go through all prescalers and pick the time segments whose
+ * sample points are closest to the requested one.
+ *
+ * Implements    : FLEXCAN_DRV_ComputeBitTiming_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_ComputeBitTiming(uint32_t peClock,
+                                      uint32_t nominalBitrate,
+                                      uint32_t dataBitrate,
+                                      uint32_t samplePoint,
+                                      flexcan_bit_timing_t *timing)
+{
+    DEV_ASSERT(timing != NULL);
+    DEV_ASSERT((samplePoint > 0U) && (samplePoint < 1000U));
+
+    const flexcan_bit_timing_limits_t *nominalLimits;
+    flexcan_bit_timing_t candidate, shared, independent;
+    uint32_t nominalClocks, dataClocks = 0U;
+    uint32_t nominalError, sharedError, independentError = FLEXCAN_BIT_TIMING_NONE;
+    uint32_t bestError = FLEXCAN_BIT_TIMING_NONE;
+    uint32_t preDivider, error;
+    bool tdcEnable = (dataBitrate > FLEXCAN_BIT_TIMING_TDC_BITRATE);
+    bool bestShared = false;
+
+    if ((nominalBitrate == 0U) || ((peClock % nominalBitrate) != 0U))
+    {
+        return STATUS_ERROR;
+    }
+    nominalClocks = peClock / nominalBitrate;
+
+    if (dataBitrate != 0U)
+    {
+        if ((peClock % dataBitrate) != 0U)
+        {
+            return STATUS_ERROR;
+        }
+        dataClocks = peClock / dataBitrate;
+
+        /* Best data phase on its own, for arbitration prescalers it cannot share */
+        for (preDivider = 1U; preDivider <= g_flexcanDataLimits.maxPreDivider; preDivider++)
+        {
+            error = FLEXCAN_ComputeDataTiming(dataClocks, preDivider, samplePoint, tdcEnable, &candidate);
+            if (error < independentError)
+            {
+                independentError = error;
+                independent = candidate;
+            }
+        }
+        if (independentError == FLEXCAN_BIT_TIMING_NONE)
+        {
+            return STATUS_ERROR;
+        }
+    }
+
+    /* The CBT register holds the arbitration phase of FD frames */
+    nominalLimits = (dataBitrate != 0U) ? &g_flexcanExtendedLimits : &g_flexcanNominalLimits;
+
+    for (preDivider = 1U; preDivider <= nominalLimits->maxPreDivider; preDivider++)
+    {
+        nominalError = FLEXCAN_ComputePhaseTiming(nominalLimits, nominalClocks, preDivider,
+                                                  samplePoint, &candidate.bitrate);
+        if (nominalError == FLEXCAN_BIT_TIMING_NONE)
+        {
+            continue;
+        }
+
+        if (dataBitrate == 0U)
+        {
+            if (nominalError < bestError)
+            {
+                bestError = nominalError;
+                timing->bitrate = candidate.bitrate;
+                timing->bitrate_cbt = candidate.bitrate;
+                timing->tdcEnable = false;
+                timing->tdcOffset = 0U;
+            }
+            continue;
+        }
+
+        /* Same prescaler in both phases, preferred on equal sample point errors */
+        sharedError = FLEXCAN_ComputeDataTiming(dataClocks, preDivider, samplePoint, tdcEnable, &shared);
+        if (sharedError != FLEXCAN_BIT_TIMING_NONE)
+        {
+            error = nominalError + sharedError;
+            if ((error < bestError) || ((error == bestError) && !bestShared))
+            {
+                bestError = error;
+                bestShared = true;
+                *timing = shared;
+                timing->bitrate = candidate.bitrate;
+            }
+        }
+
+        error = nominalError + independentError;
+        if (error < bestError)
+        {
+            bestError = error;
+            bestShared = false;
+            *timing = independent;
+            timing->bitrate = candidate.bitrate;
+        }
+    }
+
+    return (bestError != FLEXCAN_BIT_TIMING_NONE) ? STATUS_SUCCESS : STATUS_ERROR;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_ConfigBitTiming
+ * Description   : Computes and applies the bit timing for the requested bitrates.
+ * This function will read the Protocol Engine clock frequency, compute the time
+ * segments and program both phases and the Transceiver Delay Compensation.
+ *
+ * Implements    : FLEXCAN_DRV_ConfigBitTiming_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_ConfigBitTiming(uint8_t instance,
+                                     uint32_t nominalBitrate,
+                                     uint32_t dataBitrate,
+                                     uint32_t samplePoint,
+                                     flexcan_bit_timing_t *timing)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(timing != NULL);
+
+    const CAN_Type * base = g_flexcanBase[instance];
+    clock_names_t peClockName = CORE_CLK;
+    uint32_t peClock = 0U;
+    status_t status;
+
+    DEV_ASSERT(FLEXCAN_IsFDEnabled(base) || (dataBitrate == 0U));
+
+#if FEATURE_CAN_HAS_PE_CLKSRC_SELECT
+    if (FLEXCAN_GetClock(base) == FLEXCAN_CLK_SOURCE_SOSCDIV2)
+    {
+        peClockName = SOSCDIV2_CLK;
+    }
+#endif
+
+    status = CLOCK_SYS_GetFreq(peClockName, &peClock);
+    if ((status != STATUS_SUCCESS) || (peClock == 0U))
+    {
+        return STATUS_ERROR;
+    }
+
+    status = FLEXCAN_DRV_ComputeBitTiming(peClock, nominalBitrate, dataBitrate, samplePoint, timing);
+    if (status != STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    FLEXCAN_DRV_SetBitrate(instance, &timing->bitrate);
+    if (dataBitrate != 0U)
+    {
+        FLEXCAN_DRV_SetBitrateCbt(instance, &timing->bitrate_cbt);
+        FLEXCAN_DRV_SetTDCOffset(instance, timing->tdcEnable, timing->tdcOffset);
+    }
+
+    return STATUS_SUCCESS;
+}
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : FLEXCAN_DRV_SetMasktype
@@ -446,247 +851,2523 @@ status_t FLEXCAN_DRV_SetRxIndividualMask(
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_DRV_Init
- * Description   : Initialize FlexCAN driver.
- * This function will select a source clock, reset FlexCAN module, set maximum
- * number of message buffers, initialize all message buffers as inactive, enable
- * RX FIFO if needed, mask all mask bits, disable all MB interrupts, enable
- * FlexCAN normal mode, and enable all the error interrupts if needed.
+ * Function Name : FLEXCAN_DRV_CompileRxFifoFilters
+ * Description   : Compiles a list of accepted ID ranges into format A Rx FIFO
+ * filter elements with individual masks. The ranges are split in aligned power
+ * of two blocks which are merged into as few (ID, mask) pairs as possible. The
+ * IDs that do not fit in the filter table are moved to a software hash set.
  *
- * Implements    : FLEXCAN_DRV_Init_Activity
+ * Implements    : FLEXCAN_DRV_CompileRxFifoFilters_Activity
  *END**************************************************************************/
-status_t FLEXCAN_DRV_Init(
-   uint8_t instance,
-   flexcan_state_t *state,
-   const flexcan_user_config_t *data)
+status_t FLEXCAN_DRV_CompileRxFifoFilters(
+    const flexcan_id_range_t *ranges,
+    uint32_t rangeCount,
+    flexcan_rx_filter_program_t *program)
 {
-    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
-    DEV_ASSERT(state != NULL);
+    DEV_ASSERT(ranges != NULL);
+    DEV_ASSERT(rangeCount > 0U);
+    DEV_ASSERT(program != NULL);
 
-    status_t result;
-    CAN_Type * base = g_flexcanBase[instance];
-    flexcan_time_segment_t bitrate;
-    status_t osifStat;
-    uint32_t i, j;
+    status_t result = STATUS_SUCCESS;
+    uint32_t i, first, last, idLimit, blockSize, shift;
+    bool isExtended;
 
-    FLEXCAN_Disable(base);
+    program->numElements = 0U;
+    program->numSwElements = 0U;
+    program->numSwIds = 0U;
+    for (i = 0U; i < FLEXCAN_RX_FILTER_SW_IDS; i++)
+    {
+        program->swIds[i] = FLEXCAN_RX_FILTER_SW_EMPTY;
+    }
 
-#if FEATURE_CAN_HAS_PE_CLKSRC_SELECT
-    /* Select a source clock for the FlexCAN engine */
-    FLEXCAN_SelectClock(base, data->pe_clock);
-#endif
+    for (i = 0U; (i < rangeCount) && (result == STATUS_SUCCESS); i++)
+    {
+        isExtended = (ranges[i].idType == FLEXCAN_MSG_ID_EXT);
+        idLimit = isExtended ? FLEXCAN_RX_FILTER_EXT_ID_MAX : FLEXCAN_RX_FILTER_STD_ID_MAX;
+        shift = isExtended ? FLEXCAN_RX_FILTER_EXT_SHIFT : FLEXCAN_RX_FILTER_STD_SHIFT;
+        first = ranges[i].firstId;
+        last = ranges[i].lastId;
 
-    /* Enable the CAN clock */
-    FLEXCAN_Enable(base);
+        DEV_ASSERT(first <= last);
+        DEV_ASSERT(last <= idLimit);
 
-    FLEXCAN_EnterFreezeMode(base);
+        /* Split the range in blocks aligned on their size */
+        while ((first <= last) && (result == STATUS_SUCCESS))
+        {
+            blockSize = (first == 0U) ? (idLimit + 1U) : (first & (~first + 1U));
+            while ((blockSize - 1U) > (last - first))
+            {
+                blockSize >>= 1U;
+            }
 
-    /* Initialize FLEXCAN device */
-    FLEXCAN_Init(base);
+            result = FLEXCAN_InsertRxFilter(program,
+                                            FLEXCAN_EncodeRxFifoId(isExtended, first),
+                                            FLEXCAN_GetRxFilterFullMask(FLEXCAN_EncodeRxFifoId(isExtended, first)) &
+                                            ~((blockSize - 1U) << shift));
+            first += blockSize;
+        }
+    }
 
-    /* Enable/Disable FD and check FD was set as expected. Setting FD as enabled
-     * might fail if the current CAN instance does not support FD. */
-    FLEXCAN_SetFDEnabled(base, data->fd_enable);
-    if (FLEXCAN_IsFDEnabled(base) != data->fd_enable)
+    if (result == STATUS_SUCCESS)
     {
-        return STATUS_ERROR;
+        result = FLEXCAN_FitRxFilters(program);
     }
 
-    /* If the FD feature is enabled, enable the Stuff Bit Count, in order to be
-     * ISO-compliant. */
-    FLEXCAN_SetStuffBitCount(base, data->fd_enable);
+    if (result == STATUS_SUCCESS)
+    {
+        FLEXCAN_PlaceRxFilters(program);
+    }
 
-    /* Disable the self reception feature if FlexCAN is not in loopback mode. */
-    if (data->flexcanMode != FLEXCAN_LOOPBACK_MODE)
+    return result;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_ConfigRxFifoFilters
+ * Description   : Programs the filter table, the individual masks and the
+ * global mask of the Rx FIFO from a compiled filter program. The Rx FIFO must
+ * be configured with the number of ID filters of the program.
+ *
+ * Implements    : FLEXCAN_DRV_ConfigRxFifoFilters_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_ConfigRxFifoFilters(
+    uint8_t instance,
+    const flexcan_rx_filter_program_t *program)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(program != NULL);
+
+    CAN_Type * base = g_flexcanBase[instance];
+    uint32_t numOfFilters = (((base->CTRL2) & CAN_CTRL2_RFFN_MASK) >> CAN_CTRL2_RFFN_SHIFT);
+
+    if ((!FLEXCAN_IsRxFifoEnabled(base)) || (numOfFilters != (uint32_t)program->num_id_filters))
     {
-        FLEXCAN_SetSelfReception(base, false);
+        return STATUS_ERROR;
     }
 
-    /* Enable RxFIFO feature, if requested. This might fail if the FD mode is
-     * enabled. */
-    if (data->is_rx_fifo_needed)
+    FLEXCAN_EnterFreezeMode(base);
+
+    FLEXCAN_SetRxMaskType(base, FLEXCAN_RX_MASK_INDIVIDUAL);
+    FLEXCAN_SetRxFifoFilterTable(base, program->idFilter, program->idMask, FLEXCAN_RX_FILTER_GLOBAL_MASK);
+
+    FLEXCAN_ExitFreezeMode(base);
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_IsRxFifoIdAccepted
+ * Description   : Checks a frame received by the Rx FIFO against the software
+ * stage of a filter program. Only the frames hitting an element that accepts
+ * software checked IDs are looked up, and they are rejected unless they are in
+ * the hash set or match another element of the program.
+ *
+ * Implements    : FLEXCAN_DRV_IsRxFifoIdAccepted_Activity
+ *END**************************************************************************/
+bool FLEXCAN_DRV_IsRxFifoIdAccepted(
+    const flexcan_rx_filter_program_t *program,
+    const flexcan_msgbuff_t *frame)
+{
+    DEV_ASSERT(program != NULL);
+    DEV_ASSERT(frame != NULL);
+
+    uint32_t key = FLEXCAN_EncodeRxFifoId((frame->cs & CAN_CS_IDE_MASK) != 0U, frame->msgId);
+    uint32_t i, elem;
+    bool swHit = false;
+    bool accepted = true;
+
+    for (i = 0U; i < program->numSwElements; i++)
     {
-        result = FLEXCAN_EnableRxFifo(base, (uint32_t)data->num_id_filters);
-        if (result != STATUS_SUCCESS)
+        elem = program->swElements[i];
+        if ((key & program->idMask[elem]) == program->idFilter[elem])
         {
-            return result;
+            swHit = true;
         }
     }
 
-#if FEATURE_CAN_HAS_DMA_ENABLE
-    /* Enable DMA support for RxFIFO transfer, if requested. */
-    if (data->transfer_type == FLEXCAN_RXFIFO_USING_DMA)
+    if (swHit && !FLEXCAN_FindRxFilterSwId(program, key))
     {
-        if (FLEXCAN_IsRxFifoEnabled(base))
-        {
-            FLEXCAN_SetRxFifoDMA(base, true);
-        }
-        else
+        /* The wide element may overlap the exact ones */
+        accepted = false;
+        for (i = 0U; (i < program->numElements) && !accepted; i++)
         {
-            return STATUS_ERROR;
+            if (((key & program->idMask[i]) == program->idFilter[i]) &&
+                ((program->numSwElements == 0U) || (i < program->swElements[0]) ||
+                 (i >= ((uint32_t)program->swElements[0] + program->numSwElements))))
+            {
+                accepted = true;
+            }
         }
     }
-#endif
 
-    /* Select mode */
-    FLEXCAN_SetOperationMode(base, data->flexcanMode);
+    return accepted;
+}
 
-    /* Set payload size. */
-    FLEXCAN_SetPayloadSize(base, data->payload);
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ExtendTimestamp
+ * Description   : Converts the 16-bit timestamp of a CS word to a time of the
+ * time base. The free running timer gives the age of the frame in bits, which
+ * is taken back from the current time, returned in now.
+ * Reading the free running timer unlocks the MBs, so no MB must be locked.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static uint64_t FLEXCAN_ExtendTimestamp(uint8_t instance, uint32_t cs, uint64_t *now)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
 
-    result = FLEXCAN_SetMaxMsgBuffNum(base, data->max_num_mb);
-    if (result != STATUS_SUCCESS)
-    {
-        return result;
-    }
+    const CAN_Type * base = g_flexcanBase[instance];
+    const flexcan_time_base_t * timeBase = g_flexcanStatePtr[instance]->timeBase;
+    uint32_t ageBits = ((base->TIMER & CAN_TIMER_TIMER_MASK) - (cs & CAN_CS_TIME_STAMP_MASK)) & CAN_TIMER_TIMER_MASK;
+    uint64_t age = (uint64_t)ageBits * timeBase->ticksPerBit;
 
-    /* Set bit rate. */
-    if (FLEXCAN_IsFDEnabled(base))
-    {
-        bitrate = data->bitrate;
-        FLEXCAN_SetExtendedTimeSegments(base, &bitrate);
-        bitrate = data->bitrate_cbt;
-        FLEXCAN_SetFDTimeSegments(base, &bitrate);
-    }
-    else
-    {
-        bitrate = data->bitrate;
+    *now = timeBase->getTime(timeBase->param);
+
+    return (age < *now) ? (*now - age) : 0U;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_StampRxFrame
+ * Description   : Sets the time of a received frame and records its latency,
+ * as the frame is handed to the callback right after.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_StampRxFrame(uint8_t instance, uint32_t mb_idx, flexcan_msgbuff_t *frame)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    uint64_t now;
+
+    if (state->timeBase != NULL)
+    {
+        frame->timestamp = FLEXCAN_ExtendTimestamp(instance, frame->cs, &now);
+        state->mbs[mb_idx].timestamp = frame->timestamp;
+        FLEXCAN_RecordLatency(state, mb_idx, now - frame->timestamp);
+    }
+    else
+    {
+        frame->timestamp = 0U;
+    }
+}
+
+#if FEATURE_CAN_HAS_DMA_ENABLE
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_StampRxFifoBatch
+ * Description   : Sets the time of the frames of a Rx FIFO batch moved by the
+ * eDMA and records their latency. The batch completes long after its first
+ * frames were on the bus, beyond the range of the free running timer, so only
+ * the last frame is dated from the timer and every other frame is dated from
+ * the one following it.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_StampRxFifoBatch(uint8_t instance, flexcan_msgbuff_t *frames, uint32_t count)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(count > 0U);
+
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    uint32_t frame = count - 1U;
+    uint64_t now, gap;
+
+    if (state->timeBase != NULL)
+    {
+        frames[frame].timestamp = FLEXCAN_ExtendTimestamp(instance, frames[frame].cs, &now);
+        state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].timestamp = frames[frame].timestamp;
+        FLEXCAN_RecordLatency(state, FLEXCAN_MB_HANDLE_RXFIFO, now - frames[frame].timestamp);
+
+        while (frame > 0U)
+        {
+            frame--;
+            gap = (uint64_t)((frames[frame + 1U].cs - frames[frame].cs) & CAN_CS_TIME_STAMP_MASK) *
+                  state->timeBase->ticksPerBit;
+            frames[frame].timestamp = (gap < frames[frame + 1U].timestamp) ? (frames[frame + 1U].timestamp - gap) : 0U;
+            FLEXCAN_RecordLatency(state, FLEXCAN_MB_HANDLE_RXFIFO, now - frames[frame].timestamp);
+        }
+    }
+    else
+    {
+        for (frame = 0U; frame < count; frame++)
+        {
+            frames[frame].timestamp = 0U;
+        }
+    }
+}
+#endif
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_StampTxFrame
+ * Description   : Gets the time a sent frame started on the bus from the MB
+ * and records the latency since the frame was handed to the driver.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_StampTxFrame(uint8_t instance, uint32_t mb_idx)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    uint64_t now, timestamp;
+
+    if (state->timeBase != NULL)
+    {
+        timestamp = FLEXCAN_ExtendTimestamp(instance, *FLEXCAN_GetMsgBuffAddr(state, mb_idx), &now);
+        state->mbs[mb_idx].timestamp = timestamp;
+        FLEXCAN_RecordLatency(state, mb_idx,
+                              (timestamp > state->mbs[mb_idx].startTime) ?
+                              (timestamp - state->mbs[mb_idx].startTime) : 0U);
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_RecordLatency
+ * Description   : Adds a latency to the histogram of a message buffer, if the
+ * MB has one.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_RecordLatency(flexcan_state_t *state, uint32_t mb_idx, uint64_t latency)
+{
+    flexcan_latency_hist_t * hist;
+    uint32_t bin = 0U;
+
+    if ((state->latencyHist != NULL) && (mb_idx < state->latencyHistCount))
+    {
+        hist = &state->latencyHist[mb_idx];
+
+        /* Bin of the most significant bit of the latency */
+        while ((bin < (FLEXCAN_LATENCY_BINS - 1U)) && ((latency >> (bin + 1U)) != 0U))
+        {
+            bin++;
+        }
+
+        hist->bins[bin]++;
+        hist->count++;
+        if (latency > hist->maxLatency)
+        {
+            hist->maxLatency = latency;
+        }
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_EncodeRxFifoId
+ * Description   : Builds the format A filter element accepting a data frame
+ * with the given ID.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static uint32_t FLEXCAN_EncodeRxFifoId(bool isExtended, uint32_t id)
+{
+    uint32_t idFilter;
+
+    if (isExtended)
+    {
+        idFilter = FLEXCAN_RX_FILTER_IDE_MASK | ((id << FLEXCAN_RX_FILTER_EXT_SHIFT) & FLEXCAN_RX_FILTER_EXT_MASK);
+    }
+    else
+    {
+        idFilter = (id << FLEXCAN_RX_FILTER_STD_SHIFT) & FLEXCAN_RX_FILTER_STD_MASK;
+    }
+
+    return idFilter;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_GetRxFilterFullMask
+ * Description   : Returns the mask matching a single ID of the same type as
+ * the given filter element.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static uint32_t FLEXCAN_GetRxFilterFullMask(uint32_t idFilter)
+{
+    uint32_t idMask = FLEXCAN_RX_FILTER_RTR_MASK | FLEXCAN_RX_FILTER_IDE_MASK;
+
+    if ((idFilter & FLEXCAN_RX_FILTER_IDE_MASK) != 0U)
+    {
+        idMask |= FLEXCAN_RX_FILTER_EXT_MASK;
+    }
+    else
+    {
+        idMask |= FLEXCAN_RX_FILTER_STD_MASK;
+    }
+
+    return idMask;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_InsertRxFilter
+ * Description   : Adds an (ID, mask) pair to a filter program. Pairs covered by
+ * another one are dropped, and two pairs with the same mask and a single
+ * different ID bit are merged into one, until no more merge is possible. When
+ * the filter table is full the IDs of the pair go to the software hash set.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static status_t FLEXCAN_InsertRxFilter(flexcan_rx_filter_program_t *program, uint32_t idFilter, uint32_t idMask)
+{
+    uint32_t i = 0U;
+    uint32_t diff;
+    uint32_t filter = idFilter;
+    uint32_t mask = idMask;
+
+    while (i < program->numElements)
+    {
+        diff = (filter ^ program->idFilter[i]) & mask;
+
+        if (((mask & program->idMask[i]) == program->idMask[i]) &&
+            ((filter & program->idMask[i]) == program->idFilter[i]))
+        {
+            /* Already accepted */
+            return STATUS_SUCCESS;
+        }
+        else if (((program->idMask[i] & mask) == mask) && ((program->idFilter[i] & mask) == filter))
+        {
+            /* The element is covered by the new pair */
+            FLEXCAN_RemoveRxFilter(program, i);
+        }
+        else if ((program->idMask[i] == mask) && ((diff & (diff - 1U)) == 0U) &&
+                 ((diff & FLEXCAN_RX_FILTER_IDE_MASK) == 0U))
+        {
+            /* Merge the pairs and look again for the wider one */
+            FLEXCAN_RemoveRxFilter(program, i);
+            mask &= ~diff;
+            filter &= mask;
+            i = 0U;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    if (program->numElements < FLEXCAN_RX_FIFO_MAX_FILTER_ELEMENTS)
+    {
+        program->idFilter[program->numElements] = filter;
+        program->idMask[program->numElements] = mask;
+        program->numElements++;
+
+        return STATUS_SUCCESS;
+    }
+
+    return FLEXCAN_MoveRxFilterToSoftware(program, filter, mask);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_RemoveRxFilter
+ * Description   : Removes an element of a filter program, moving the last
+ * element in its place.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_RemoveRxFilter(flexcan_rx_filter_program_t *program, uint32_t idx)
+{
+    program->numElements--;
+    program->idFilter[idx] = program->idFilter[program->numElements];
+    program->idMask[idx] = program->idMask[program->numElements];
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_MoveRxFilterToSoftware
+ * Description   : Adds every ID accepted by an (ID, mask) pair to the software
+ * hash set of a filter program.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static status_t FLEXCAN_MoveRxFilterToSoftware(flexcan_rx_filter_program_t *program,
+                                               uint32_t idFilter, uint32_t idMask)
+{
+    uint32_t freeBits = FLEXCAN_GetRxFilterFullMask(idFilter) & ~idMask;
+    uint32_t subset = 0U;
+    status_t result;
+
+    /* Enumerate the combinations of the masked out ID bits */
+    do
+    {
+        result = FLEXCAN_AddRxFilterSwId(program, idFilter | subset);
+        subset = (subset - freeBits) & freeBits;
+    }
+    while ((subset != 0U) && (result == STATUS_SUCCESS));
+
+    return result;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_FitRxFilters
+ * Description   : Moves elements to the software hash set until the elements
+ * with a mask, plus one element per ID type of the software checked IDs, fit
+ * in the individual masks and all the elements fit in the filter table. The
+ * narrowest masked elements go first when the masks run out, single IDs when
+ * the table does, or the narrowest masked element if no single ID is left.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static status_t FLEXCAN_FitRxFilters(flexcan_rx_filter_program_t *program)
+{
+    status_t result = STATUS_SUCCESS;
+    uint32_t i, numMasked, numSwTypes, victim, victimBits, bits, tmp;
+    bool hasStd, hasExt;
+    bool fits = false;
+
+    while ((!fits) && (result == STATUS_SUCCESS))
+    {
+        hasStd = false;
+        hasExt = false;
+        for (i = 0U; i < FLEXCAN_RX_FILTER_SW_IDS; i++)
+        {
+            if (program->swIds[i] != FLEXCAN_RX_FILTER_SW_EMPTY)
+            {
+                if ((program->swIds[i] & FLEXCAN_RX_FILTER_IDE_MASK) != 0U)
+                {
+                    hasExt = true;
+                }
+                else
+                {
+                    hasStd = true;
+                }
+            }
+        }
+        numSwTypes = (hasStd ? 1U : 0U) + (hasExt ? 1U : 0U);
+
+        numMasked = 0U;
+        victim = program->numElements;
+        victimBits = 0U;
+        for (i = 0U; i < program->numElements; i++)
+        {
+            if (program->idMask[i] != FLEXCAN_GetRxFilterFullMask(program->idFilter[i]))
+            {
+                numMasked++;
+                /* The mask with the most bits set accepts the fewest IDs */
+                bits = 0U;
+                for (tmp = program->idMask[i]; tmp != 0U; tmp &= (tmp - 1U))
+                {
+                    bits++;
+                }
+                if (bits > victimBits)
+                {
+                    victim = i;
+                    victimBits = bits;
+                }
+            }
+        }
+
+        if ((numMasked + numSwTypes) > FLEXCAN_RX_FILTER_MASKED_ELEMENTS)
+        {
+            /* Not enough individual masks */
+        }
+        else if ((program->numElements + numSwTypes) > FLEXCAN_RX_FIFO_MAX_FILTER_ELEMENTS)
+        {
+            /* Not enough elements, move a single ID. Without any, the
+             * narrowest masked element found above is moved instead. */
+            for (i = 0U; i < program->numElements; i++)
+            {
+                if (program->idMask[i] == FLEXCAN_GetRxFilterFullMask(program->idFilter[i]))
+                {
+                    victim = i;
+                }
+            }
+        }
+        else
+        {
+            fits = true;
+        }
+
+        if ((!fits) && (victim < program->numElements))
+        {
+            uint32_t idFilter = program->idFilter[victim];
+            uint32_t idMask = program->idMask[victim];
+
+            FLEXCAN_RemoveRxFilter(program, victim);
+            result = FLEXCAN_MoveRxFilterToSoftware(program, idFilter, idMask);
+        }
+        else if (!fits)
+        {
+            result = STATUS_ERROR;
+        }
+        else
+        {
+            /* The elements fit */
+        }
+    }
+
+    return result;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_PlaceRxFilters
+ * Description   : Orders the elements of a filter program: the masked
+ * elements first, so they use the individual masks, then the elements
+ * accepting the software checked IDs, then the single standard and extended
+ * IDs. Selects the number of ID filters and fills the rest of the table with
+ * copies of the first element.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_PlaceRxFilters(flexcan_rx_filter_program_t *program)
+{
+    uint32_t i, j, pass, pos, tmp, numMasked;
+    uint32_t swFilter, swMask, key;
+    bool isSingle, isExtended, found;
+
+    /* Masked elements, then single standard IDs, then single extended IDs */
+    pos = 0U;
+    for (pass = 0U; pass < 3U; pass++)
+    {
+        for (i = pos; i < program->numElements; i++)
+        {
+            isSingle = (program->idMask[i] == FLEXCAN_GetRxFilterFullMask(program->idFilter[i]));
+            isExtended = ((program->idFilter[i] & FLEXCAN_RX_FILTER_IDE_MASK) != 0U);
+            if (((pass == 0U) && !isSingle) ||
+                ((pass == 1U) && isSingle && !isExtended) ||
+                ((pass == 2U) && isSingle && isExtended))
+            {
+                tmp = program->idFilter[i];
+                program->idFilter[i] = program->idFilter[pos];
+                program->idFilter[pos] = tmp;
+                tmp = program->idMask[i];
+                program->idMask[i] = program->idMask[pos];
+                program->idMask[pos] = tmp;
+                pos++;
+            }
+        }
+        if (pass == 0U)
+        {
+            numMasked = pos;
+        }
+    }
+
+    /* One element per ID type covering all the software checked IDs */
+    for (pass = 0U; pass < 2U; pass++)
+    {
+        found = false;
+        swFilter = 0U;
+        swMask = 0U;
+        for (i = 0U; i < FLEXCAN_RX_FILTER_SW_IDS; i++)
+        {
+            key = program->swIds[i];
+            if ((key != FLEXCAN_RX_FILTER_SW_EMPTY) &&
+                (((key & FLEXCAN_RX_FILTER_IDE_MASK) != 0U) == (pass == 1U)))
+            {
+                if (!found)
+                {
+                    swFilter = key;
+                    swMask = FLEXCAN_GetRxFilterFullMask(key);
+                    found = true;
+                }
+                swMask &= ~(key ^ swFilter);
+            }
+        }
+
+        if (found)
+        {
+            for (j = program->numElements; j > numMasked; j--)
+            {
+                program->idFilter[j] = program->idFilter[j - 1U];
+                program->idMask[j] = program->idMask[j - 1U];
+            }
+            j = numMasked;
+            program->idFilter[j] = swFilter & swMask;
+            program->idMask[j] = swMask;
+            program->swElements[program->numSwElements] = (uint8_t)j;
+            program->numSwElements++;
+            program->numElements++;
+            numMasked++;
+        }
+    }
+
+    /* Smallest table holding the elements, padded with copies of the first one */
+    tmp = (program->numElements + 7U) / 8U;
+    program->num_id_filters = (flexcan_rx_fifo_id_filter_num_t)(tmp - 1U);
+    for (i = program->numElements; i < (tmp * 8U); i++)
+    {
+        program->idFilter[i] = program->idFilter[0];
+        program->idMask[i] = program->idMask[0];
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_GetRxFilterSwSlot
+ * Description   : Returns the first slot probed for a key in the software ID
+ * hash set.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static uint32_t FLEXCAN_GetRxFilterSwSlot(uint32_t key)
+{
+    return ((key * 0x9E3779B1U) >> 16U) & (FLEXCAN_RX_FILTER_SW_IDS - 1U);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_AddRxFilterSwId
+ * Description   : Adds a format A element of a single ID to the software ID
+ * hash set, using linear probing.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static status_t FLEXCAN_AddRxFilterSwId(flexcan_rx_filter_program_t *program, uint32_t key)
+{
+    uint32_t slot = FLEXCAN_GetRxFilterSwSlot(key);
+
+    while (program->swIds[slot] != FLEXCAN_RX_FILTER_SW_EMPTY)
+    {
+        if (program->swIds[slot] == key)
+        {
+            return STATUS_SUCCESS;
+        }
+        slot = (slot + 1U) & (FLEXCAN_RX_FILTER_SW_IDS - 1U);
+    }
+
+    if (program->numSwIds >= FLEXCAN_RX_FILTER_SW_MAX_IDS)
+    {
+        return STATUS_ERROR;
+    }
+
+    program->swIds[slot] = key;
+    program->numSwIds++;
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_FindRxFilterSwId
+ * Description   : Looks up a format A element of a single ID in the software
+ * ID hash set.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static bool FLEXCAN_FindRxFilterSwId(const flexcan_rx_filter_program_t *program, uint32_t key)
+{
+    uint32_t slot = FLEXCAN_GetRxFilterSwSlot(key);
+    bool found = false;
+
+    while ((!found) && (program->swIds[slot] != FLEXCAN_RX_FILTER_SW_EMPTY))
+    {
+        found = (program->swIds[slot] == key);
+        slot = (slot + 1U) & (FLEXCAN_RX_FILTER_SW_IDS - 1U);
+    }
+
+    return found;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_Init
+ * Description   : Initialize FlexCAN driver.
+ * This function will select a source clock, reset FlexCAN module, set maximum
+ * number of message buffers, initialize all message buffers as inactive, enable
+ * RX FIFO if needed, mask all mask bits, disable all MB interrupts, enable
+ * FlexCAN normal mode, and enable all the error interrupts if needed.
+ *
+ * Implements    : FLEXCAN_DRV_Init_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_Init(
+   uint8_t instance,
+   flexcan_state_t *state,
+   const flexcan_user_config_t *data)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(state != NULL);
+
+    status_t result;
+    CAN_Type * base = g_flexcanBase[instance];
+    flexcan_time_segment_t bitrate;
+    status_t osifStat;
+    uint32_t i, j;
+
+    FLEXCAN_Disable(base);
+
+#if FEATURE_CAN_HAS_PE_CLKSRC_SELECT
+    /* Select a source clock for the FlexCAN engine */
+    FLEXCAN_SelectClock(base, data->pe_clock);
+#endif
+
+    /* Enable the CAN clock */
+    FLEXCAN_Enable(base);
+
+    FLEXCAN_EnterFreezeMode(base);
+
+    /* Initialize FLEXCAN device */
+    FLEXCAN_Init(base);
+
+    /* Enable/Disable FD and check FD was set as expected. Setting FD as enabled
+     * might fail if the current CAN instance does not support FD. */
+    FLEXCAN_SetFDEnabled(base, data->fd_enable);
+    if (FLEXCAN_IsFDEnabled(base) != data->fd_enable)
+    {
+        return STATUS_ERROR;
+    }
+
+    /* If the FD feature is enabled, enable the Stuff Bit Count, in order to be
+     * ISO-compliant. */
+    FLEXCAN_SetStuffBitCount(base, data->fd_enable);
+
+    /* Disable the self reception feature if FlexCAN is not in loopback mode. */
+    if (data->flexcanMode != FLEXCAN_LOOPBACK_MODE)
+    {
+        FLEXCAN_SetSelfReception(base, false);
+    }
+
+    /* Enable RxFIFO feature, if requested. This might fail if the FD mode is
+     * enabled. */
+    if (data->is_rx_fifo_needed)
+    {
+        result = FLEXCAN_EnableRxFifo(base, (uint32_t)data->num_id_filters);
+        if (result != STATUS_SUCCESS)
+        {
+            return result;
+        }
+    }
+
+#if FEATURE_CAN_HAS_DMA_ENABLE
+    /* Enable DMA support for RxFIFO transfer, if requested. */
+    if (data->transfer_type == FLEXCAN_RXFIFO_USING_DMA)
+    {
+        if (FLEXCAN_IsRxFifoEnabled(base))
+        {
+            FLEXCAN_SetRxFifoDMA(base, true);
+        }
+        else
+        {
+            return STATUS_ERROR;
+        }
+    }
+#endif
+
+    /* Select mode */
+    FLEXCAN_SetOperationMode(base, data->flexcanMode);
+
+    /* Set payload size. */
+    FLEXCAN_SetPayloadSize(base, data->payload);
+
+    /* The MB addresses only depend on the payload size, compute them once */
+    FLEXCAN_InitMsgBuffRegions(base, state->mbRegions, FEATURE_CAN_MAX_MB_NUM);
+
+    result = FLEXCAN_SetMaxMsgBuffNum(base, data->max_num_mb);
+    if (result != STATUS_SUCCESS)
+    {
+        return result;
+    }
+
+    /* Set bit rate. */
+    if (FLEXCAN_IsFDEnabled(base))
+    {
+        bitrate = data->bitrate;
+        FLEXCAN_SetExtendedTimeSegments(base, &bitrate);
+        bitrate = data->bitrate_cbt;
+        FLEXCAN_SetFDTimeSegments(base, &bitrate);
+    }
+    else
+    {
+        bitrate = data->bitrate;
         FLEXCAN_SetTimeSegments(base, &bitrate);
     }
 
-    FLEXCAN_ExitFreezeMode(base);
+    FLEXCAN_ExitFreezeMode(base);
+
+    /* Enable FlexCAN interrupts.*/
+#if FEATURE_CAN_HAS_WAKE_UP_IRQ
+    if (g_flexcanWakeUpIrqId[instance] != NotAvail_IRQn)
+    {
+        INT_SYS_EnableIRQ(g_flexcanWakeUpIrqId[instance]);
+    }
+#endif
+    INT_SYS_EnableIRQ(g_flexcanErrorIrqId[instance]);
+    INT_SYS_EnableIRQ(g_flexcanBusOffIrqId[instance]);
+    for (i = 0; i < FEATURE_CAN_MB_IRQS_MAX_COUNT; i++)
+    {
+        if (g_flexcanOredMessageBufferIrqId[i][instance] != NotAvail_IRQn)
+        {
+            INT_SYS_EnableIRQ(g_flexcanOredMessageBufferIrqId[i][instance]);
+        }
+    }
+
+    for (i = 0; i < FEATURE_CAN_MAX_MB_NUM; i++)
+    {
+        osifStat = OSIF_SemaCreate(&state->mbs[i].mbSema, 0U);
+        if (osifStat != STATUS_SUCCESS)
+        {
+            for (j = 0; j < i; j++)
+            {
+                (void)OSIF_SemaDestroy(&state->mbs[j].mbSema);
+            }
+            return STATUS_ERROR;
+        }
+        state->mbs[i].isBlocking = false;
+        state->mbs[i].mb_message = NULL;
+        state->mbs[i].state = FLEXCAN_MB_IDLE;
+        state->mbs[i].rxRing.buffer = NULL;
+        state->mbs[i].rxRing.size = 0U;
+        state->mbs[i].rxRing.head = 0U;
+        state->mbs[i].rxRing.tail = 0U;
+        state->mbs[i].rxRing.ringOverflows = 0U;
+        state->mbs[i].rxRing.hwOverruns = 0U;
+        state->mbs[i].timestamp = 0U;
+        state->mbs[i].startTime = 0U;
+        state->mbs[i].txCs = 0U;
+    }
+
+    /* Frames are not timestamped until FLEXCAN_DRV_InstallTimeBase is called */
+    state->timeBase = NULL;
+    state->latencyHist = NULL;
+    state->latencyHistCount = 0U;
+
+    /* The transmit queue is not used until FLEXCAN_DRV_ConfigTxQueue is called */
+    state->rxFifoBatchSize = 0U;
+    state->rxFifoBatchCount = NULL;
+    state->txQueue.frames = NULL;
+    state->txQueue.size = 0U;
+    state->txQueue.head = 0U;
+    state->txQueue.tail = 0U;
+    state->txQueue.firstMb = 0U;
+    state->txQueue.mbCount = 0U;
+    state->txQueue.loadStatus = STATUS_SUCCESS;
+#if FEATURE_CAN_HAS_DMA_ENABLE
+    state->txDma.frames = NULL;
+    state->txDma.stcd = NULL;
+    state->txDma.error = false;
+#endif
+
+    /* Bus errors are not tracked until FLEXCAN_DRV_ConfigErrorManager is called */
+    state->errorManager.enabled = false;
+    state->errorManager.faultState = FLEXCAN_FAULT_ERROR_ACTIVE;
+
+    /* Store transfer type and DMA channel number used in transfer */
+    state->transferType = data->transfer_type;
+#if FEATURE_CAN_HAS_DMA_ENABLE
+    state->rxFifoDMAChannel = data->rxFifoDMAChannel;
+#endif
+
+    /* Save runtime structure pointers so irq handler can point to the correct state structure */
+    g_flexcanStatePtr[instance] = state;
+
+    return (STATUS_SUCCESS);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_ConfigTxMb
+ * Description   : Configure a Tx message buffer.
+ * This function will first check if RX FIFO is enabled. If RX FIFO is enabled,
+ * the function will make sure if the MB requested is not occupied by RX FIFO
+ * and ID filter table. Then this function will set up the message buffer fields,
+ * configure the message buffer code for Tx buffer as INACTIVE, and enable the
+ * Message Buffer interrupt.
+ *
+ * Implements    : FLEXCAN_DRV_ConfigTxMb_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_ConfigTxMb(
+    uint8_t instance,
+    uint8_t mb_idx,
+    const flexcan_data_info_t *tx_info,
+    uint32_t msg_id)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(tx_info != NULL);
+
+    flexcan_msgbuff_code_status_t cs;
+    const flexcan_state_t * state = g_flexcanStatePtr[instance];
+    CAN_Type * base = g_flexcanBase[instance];
+
+    /* Initialize transmit mb*/
+    cs.dataLen = tx_info->data_length;
+    cs.msgIdType = tx_info->msg_id_type;
+    if (tx_info->is_remote)
+    {
+        cs.code = (uint32_t)FLEXCAN_TX_REMOTE;
+    }
+    else
+    {
+        cs.code = (uint32_t)FLEXCAN_TX_INACTIVE;
+    }
+    return FLEXCAN_SetTxMsgBuff(base, mb_idx, FLEXCAN_GetMsgBuffAddr(state, mb_idx), &cs, msg_id, NULL);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_SendBlocking
+ * Description   : This function sends a CAN frame using a configured message
+ * buffer. The function blocks until either the frame was sent, or the specified
+ * timeout expired.
+ *
+ * Implements    : FLEXCAN_DRV_SendBlocking_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_SendBlocking(
+    uint8_t instance,
+    uint8_t mb_idx,
+    const flexcan_data_info_t *tx_info,
+    uint32_t msg_id,
+    const uint8_t *mb_data,
+    uint32_t timeout_ms)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(tx_info != NULL);
+
+    status_t result;
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    CAN_Type * base  = g_flexcanBase[instance];
+
+    result = FLEXCAN_StartSendData(instance, mb_idx, tx_info, msg_id, mb_data, true);
+
+    if (result == STATUS_SUCCESS)
+    {
+        status_t status;
+
+        /* Enable message buffer interrupt*/
+        (void)FLEXCAN_SetMsgBuffIntCmd(base, mb_idx, true);
+        /* Enable error interrupts */
+        FLEXCAN_SetErrIntCmd(base,FLEXCAN_INT_ERR,true);
+
+        status = OSIF_SemaWait(&state->mbs[mb_idx].mbSema, timeout_ms);
+
+        if (status == STATUS_TIMEOUT)
+        {
+            /* Disable message buffer interrupt */
+            (void)FLEXCAN_SetMsgBuffIntCmd(base, mb_idx, false);
+            /* Disable error interrupts */
+            FLEXCAN_DisableErrInt(instance);
+
+            result = STATUS_TIMEOUT;
+        }
+
+        state->mbs[mb_idx].state = FLEXCAN_MB_IDLE;
+    }
+
+    return result;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_Send
+ * Description   : This function sends a CAN frame using a configured message
+ * buffer. The function returns immediately. If a callback is installed, it will
+ * be invoked after the frame was sent.
+ *
+ * Implements    : FLEXCAN_DRV_Send_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_Send(
+    uint8_t instance,
+    uint8_t mb_idx,
+    const flexcan_data_info_t *tx_info,
+    uint32_t msg_id,
+    const uint8_t *mb_data)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(tx_info != NULL);
+
+    status_t result;
+    CAN_Type * base = g_flexcanBase[instance];
+
+    result = FLEXCAN_StartSendData(instance, mb_idx, tx_info, msg_id, mb_data, false);
+    if(result == STATUS_SUCCESS)
+    {
+        /* Enable message buffer interrupt*/
+        result = FLEXCAN_SetMsgBuffIntCmd(base, mb_idx, true);
+        /* Enable error interrupts */
+        FLEXCAN_SetErrIntCmd(base,FLEXCAN_INT_ERR,true);
+    }
+
+    return result;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_PrepareSend
+ * Description   : Loads the ID and the payload of a frame into a message
+ * buffer, leaving it inactive, and keeps the CODE/status word which starts
+ * the transmission for FLEXCAN_DRV_SendPrepared. The interrupts are enabled
+ * here, so that sending only takes one write.
+ *
+ * Implements    : FLEXCAN_DRV_PrepareSend_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_PrepareSend(
+    uint8_t instance,
+    uint8_t mb_idx,
+    const flexcan_data_info_t *tx_info,
+    uint32_t msg_id,
+    const uint8_t *mb_data)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(mb_idx < FEATURE_CAN_MAX_MB_NUM);
+    DEV_ASSERT(tx_info != NULL);
+
+    status_t result;
+    flexcan_msgbuff_code_status_t cs;
+    uint32_t image[18U];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    CAN_Type * base = g_flexcanBase[instance];
+
+    if (state->mbs[mb_idx].state != FLEXCAN_MB_IDLE)
+    {
+        return STATUS_BUSY;
+    }
+    state->mbs[mb_idx].state = FLEXCAN_MB_TX_PREPARED;
+    state->mbs[mb_idx].isBlocking = false;
+    state->mbs[mb_idx].isRemote = tx_info->is_remote;
+
+    cs.dataLen = tx_info->data_length;
+    cs.msgIdType = tx_info->msg_id_type;
+    cs.fd_enable = tx_info->fd_enable;
+    cs.fd_padding = tx_info->fd_padding;
+    cs.enable_brs = tx_info->enable_brs;
+    cs.code = (uint32_t)FLEXCAN_TX_INACTIVE;
+    result = FLEXCAN_SetTxMsgBuff(base, mb_idx, FLEXCAN_GetMsgBuffAddr(state, mb_idx), &cs, msg_id, mb_data);
+
+    if (result == STATUS_SUCCESS)
+    {
+        if (tx_info->is_remote)
+        {
+            cs.code = (uint32_t)FLEXCAN_TX_REMOTE;
+        }
+        else
+        {
+            cs.code = (uint32_t)FLEXCAN_TX_DATA;
+        }
+        (void)FLEXCAN_BuildTxMsgBuffImage(&cs, msg_id, NULL, image);
+        state->mbs[mb_idx].txCs = image[0];
+
+        /* Enable message buffer interrupt*/
+        result = FLEXCAN_SetMsgBuffIntCmd(base, mb_idx, true);
+        /* Enable error interrupts */
+        FLEXCAN_SetErrIntCmd(base,FLEXCAN_INT_ERR,true);
+    }
+
+    if (result != STATUS_SUCCESS)
+    {
+        state->mbs[mb_idx].state = FLEXCAN_MB_IDLE;
+    }
+
+    return result;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_SendPrepared
+ * Description   : Starts the transmission of the frame loaded by
+ * FLEXCAN_DRV_PrepareSend by writing the CODE/status word of the MB.
+ *
+ * Implements    : FLEXCAN_DRV_SendPrepared_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_SendPrepared(uint8_t instance, uint8_t mb_idx)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(mb_idx < FEATURE_CAN_MAX_MB_NUM);
+
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+
+    if (state->mbs[mb_idx].state != FLEXCAN_MB_TX_PREPARED)
+    {
+        return STATUS_ERROR;
+    }
+    state->mbs[mb_idx].state = FLEXCAN_MB_TX_BUSY;
+
+    /* Writing the CODE starts the transmission */
+    *FLEXCAN_GetMsgBuffAddr(state, mb_idx) = state->mbs[mb_idx].txCs;
+
+    if (state->timeBase != NULL)
+    {
+        state->mbs[mb_idx].startTime = state->timeBase->getTime(state->timeBase->param);
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_ConfigTxQueue
+ * Description   : Sets up a transmit queue served by a pool of consecutive Tx
+ * MBs and enables the Local Priority feature.
+ *
+ * Implements    : FLEXCAN_DRV_ConfigTxQueue_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_ConfigTxQueue(
+    uint8_t instance,
+    uint8_t firstMb,
+    uint8_t mbCount,
+    flexcan_tx_frame_t *frames,
+    uint32_t queueSize)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(frames != NULL);
+    DEV_ASSERT((queueSize != 0U) && ((queueSize & (queueSize - 1U)) == 0U));
+    DEV_ASSERT((mbCount != 0U) && (((uint32_t)firstMb + mbCount) <= FEATURE_CAN_MAX_MB_NUM));
+
+    CAN_Type * base = g_flexcanBase[instance];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    uint32_t i;
+
+    for (i = firstMb; i < ((uint32_t)firstMb + mbCount); i++)
+    {
+        if (state->mbs[i].state != FLEXCAN_MB_IDLE)
+        {
+            return STATUS_BUSY;
+        }
+    }
+
+    state->txQueue.frames = frames;
+    state->txQueue.size = queueSize;
+    state->txQueue.head = 0U;
+    state->txQueue.tail = 0U;
+    state->txQueue.firstMb = firstMb;
+    state->txQueue.mbCount = mbCount;
+    state->txQueue.nextPrio = 0U;
+    state->txQueue.loadStatus = STATUS_SUCCESS;
+
+    FLEXCAN_EnterFreezeMode(base);
+
+    /* Let the PRIO field of the Tx MBs take part in the internal arbitration */
+    FLEXCAN_SetLocalPrio(base, true);
+
+    FLEXCAN_ExitFreezeMode(base);
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_SendQueued
+ * Description   : Sends a CAN frame through the transmit queue. The frame is
+ * loaded into a free MB of the pool if nothing is queued yet, otherwise it is
+ * appended to the queue and loaded by the interrupt handler.
+ *
+ * Implements    : FLEXCAN_DRV_SendQueued_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_SendQueued(
+    uint8_t instance,
+    const flexcan_data_info_t *tx_info,
+    uint32_t msg_id,
+    const uint8_t *mb_data)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(tx_info != NULL);
+    DEV_ASSERT(!tx_info->is_remote);
+    DEV_ASSERT(tx_info->data_length <= 64U);
+
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    flexcan_tx_queue_t * queue = &state->txQueue;
+    uint32_t frameId = msg_id & ~CAN_ID_PRIO_MASK;
+    flexcan_tx_frame_t * frame;
+    status_t result = STATUS_BUSY;
+    uint32_t i;
+
+    DEV_ASSERT(queue->frames != NULL);
+
+    /* The interrupt handler also loads the pool MBs */
+    INT_SYS_DisableIRQGlobal();
+
+    /* Earlier frames must leave first, so use a free MB only if nothing is queued */
+    if (queue->head == queue->tail)
+    {
+        for (i = queue->firstMb; i < ((uint32_t)queue->firstMb + queue->mbCount); i++)
+        {
+            if (state->mbs[i].state == FLEXCAN_MB_IDLE)
+            {
+                result = FLEXCAN_LoadTxQueueMb(instance, i, tx_info, frameId, mb_data);
+                break;
+            }
+        }
+    }
+
+    if ((result == STATUS_BUSY) && ((queue->head - queue->tail) < queue->size))
+    {
+        frame = &queue->frames[queue->head & (queue->size - 1U)];
+        frame->txInfo = *tx_info;
+        frame->msgId = frameId;
+        for (i = 0U; (mb_data != NULL) && (i < tx_info->data_length); i++)
+        {
+            frame->data[i] = mb_data[i];
+        }
+        frame->queuedTime = (state->timeBase != NULL) ? state->timeBase->getTime(state->timeBase->param) : 0U;
+        queue->head++;
+        result = STATUS_SUCCESS;
+
+        /* A pool MB may have been left idle with frames queued, by an abort or
+         * a failed load: retry the oldest frames on it */
+        FLEXCAN_KickTxQueue(instance);
+    }
+
+    INT_SYS_EnableIRQGlobal();
+
+    return result;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_ReleaseTxQueue
+ * Description   : Discards the queued frames, aborts the pool MBs still
+ * transmitting and disables the Local Priority feature.
+ *
+ * Implements    : FLEXCAN_DRV_ReleaseTxQueue_Activity
+ *END**************************************************************************/
+void FLEXCAN_DRV_ReleaseTxQueue(uint8_t instance)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    CAN_Type * base = g_flexcanBase[instance];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    flexcan_tx_queue_t * queue = &state->txQueue;
+    uint32_t firstMb = queue->firstMb;
+    uint32_t mbCount = queue->mbCount;
+    uint32_t i;
+
+    /* Without frames the interrupt handler no longer reloads the pool MBs */
+    INT_SYS_DisableIRQGlobal();
+    queue->frames = NULL;
+    queue->size = 0U;
+    queue->head = 0U;
+    queue->tail = 0U;
+    queue->firstMb = 0U;
+    queue->mbCount = 0U;
+    queue->nextPrio = 0U;
+    queue->loadStatus = STATUS_SUCCESS;
+    INT_SYS_EnableIRQGlobal();
+
+    for (i = firstMb; i < (firstMb + mbCount); i++)
+    {
+        (void)FLEXCAN_DRV_AbortTransfer(instance, (uint8_t)i);
+    }
+
+    FLEXCAN_EnterFreezeMode(base);
+
+    FLEXCAN_SetLocalPrio(base, false);
+
+    FLEXCAN_ExitFreezeMode(base);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_GetTxQueueStatus
+ * Description   : Returns the result of the last load of a queued frame into
+ * a pool MB.
+ *
+ * Implements    : FLEXCAN_DRV_GetTxQueueStatus_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_GetTxQueueStatus(uint8_t instance)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    const flexcan_state_t * state = g_flexcanStatePtr[instance];
+
+    return state->txQueue.loadStatus;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_GetTxQueuePending
+ * Description   : Returns the number of frames waiting in the transmit queue.
+ *
+ * Implements    : FLEXCAN_DRV_GetTxQueuePending_Activity
+ *END**************************************************************************/
+uint32_t FLEXCAN_DRV_GetTxQueuePending(uint8_t instance)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    const flexcan_state_t * state = g_flexcanStatePtr[instance];
+
+    return state->txQueue.head - state->txQueue.tail;
+}
+
+#if FEATURE_CAN_HAS_DMA_ENABLE
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_ConfigTxDma
+ * Description   : Sets up the transmission of frame chains through an eDMA
+ * channel: the pool MBs are made inactive, the channel is routed to an always
+ * enabled request source, its callback ends the chain on an eDMA error and the
+ * Local Priority feature is enabled.
+ *
+ * Implements    : FLEXCAN_DRV_ConfigTxDma_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_ConfigTxDma(
+    uint8_t instance,
+    uint8_t dmaChannel,
+    uint8_t firstMb,
+    uint8_t mbCount,
+    edma_software_tcd_t *stcd)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(stcd != NULL);
+    DEV_ASSERT((mbCount != 0U) && (mbCount <= FLEXCAN_TX_DMA_MAX_MBS));
+    DEV_ASSERT(((uint32_t)firstMb + mbCount) <= FEATURE_CAN_MAX_MB_NUM);
+
+    CAN_Type * base = g_flexcanBase[instance];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    flexcan_data_info_t inactiveInfo = { FLEXCAN_MSG_ID_STD, 0U, false, 0U, false, false };
+    status_t result = STATUS_SUCCESS;
+    uint32_t i;
+
+    if (state->txDma.frames != NULL)
+    {
+        return STATUS_BUSY;
+    }
+
+    for (i = firstMb; i < ((uint32_t)firstMb + mbCount); i++)
+    {
+        if (state->mbs[i].state != FLEXCAN_MB_IDLE)
+        {
+            return STATUS_BUSY;
+        }
+    }
+
+    /* The eDMA channel only writes the MBs, they are made inactive here */
+    for (i = firstMb; (i < ((uint32_t)firstMb + mbCount)) && (result == STATUS_SUCCESS); i++)
+    {
+        result = FLEXCAN_DRV_ConfigTxMb(instance, (uint8_t)i, &inactiveInfo, 0U);
+    }
+
+    if (result == STATUS_SUCCESS)
+    {
+        state->txDma.stcd = stcd;
+        state->txDma.dmaChannel = dmaChannel;
+        state->txDma.firstMb = firstMb;
+        state->txDma.mbCount = mbCount;
+
+        /* There is no Tx request, the channel runs as long as its requests are enabled */
+        (void)EDMA_DRV_SetChannelRequest(dmaChannel, (uint8_t)EDMA_REQ_DMAMUX_ALWAYS_ENABLED0);
+        (void)EDMA_DRV_InstallCallback(dmaChannel, FLEXCAN_CompleteTxDmaError, (void *)((uint32_t)instance));
+
+        FLEXCAN_EnterFreezeMode(base);
+
+        /* Let the PRIO field of the Tx MBs take part in the internal arbitration */
+        FLEXCAN_SetLocalPrio(base, true);
+
+        FLEXCAN_ExitFreezeMode(base);
+    }
+
+    return result;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_PrepareTxDmaFrame
+ * Description   : Formats a CAN frame as the image of a Tx MB, ready to be
+ * copied by the eDMA channel.
+ *
+ * Implements    : FLEXCAN_DRV_PrepareTxDmaFrame_Activity
+ *END**************************************************************************/
+void FLEXCAN_DRV_PrepareTxDmaFrame(
+    uint8_t instance,
+    const flexcan_data_info_t *tx_info,
+    uint32_t msg_id,
+    const uint8_t *mb_data,
+    flexcan_tx_dma_frame_t *frame)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(tx_info != NULL);
+    DEV_ASSERT(!tx_info->is_remote);
+    DEV_ASSERT(tx_info->data_length <= 64U);
+    DEV_ASSERT(frame != NULL);
+
+    CAN_Type * base = g_flexcanBase[instance];
+    flexcan_msgbuff_code_status_t cs;
+
+    cs.code = (uint32_t)FLEXCAN_TX_DATA;
+    cs.msgIdType = tx_info->msg_id_type;
+    cs.dataLen = tx_info->data_length;
+    cs.fd_enable = tx_info->fd_enable;
+    cs.fd_padding = tx_info->fd_padding;
+    cs.enable_brs = tx_info->enable_brs;
+
+    /* Make sure the BRS bit will not be ignored */
+    if (FLEXCAN_IsFDEnabled(base) && tx_info->enable_brs)
+    {
+        base->FDCTRL = (base->FDCTRL & ~CAN_FDCTRL_FDRATE_MASK) | CAN_FDCTRL_FDRATE(1U);
+    }
+
+    frame->length = FLEXCAN_BuildTxMsgBuffImage(&cs, msg_id, mb_data, frame->image);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_SendDmaChain
+ * Description   : Sends a chain of formatted frames through the eDMA channel,
+ * in batches of up to the number of MBs of the pool.
+ *
+ * Implements    : FLEXCAN_DRV_SendDmaChain_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_SendDmaChain(
+    uint8_t instance,
+    flexcan_tx_dma_frame_t *frames,
+    uint32_t count)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(frames != NULL);
+    DEV_ASSERT(count != 0U);
+
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    flexcan_tx_dma_t * txDma = &state->txDma;
+    status_t result = STATUS_SUCCESS;
+    uint32_t i;
+
+    DEV_ASSERT(txDma->stcd != NULL);
+
+    if (txDma->frames != NULL)
+    {
+        return STATUS_BUSY;
+    }
+
+    for (i = txDma->firstMb; i < ((uint32_t)txDma->firstMb + txDma->mbCount); i++)
+    {
+        if (state->mbs[i].state != FLEXCAN_MB_IDLE)
+        {
+            return STATUS_BUSY;
+        }
+    }
+
+    txDma->frames = frames;
+    txDma->count = count;
+    txDma->next = 0U;
+    txDma->error = false;
+
+    result = FLEXCAN_StartTxDmaBatch(instance);
+    if (result != STATUS_SUCCESS)
+    {
+        txDma->frames = NULL;
+    }
+
+    return result;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_GetTxDmaChainStatus
+ * Description   : Returns whether a frame chain is being sent through the
+ * eDMA channel, or whether the last one was ended by an eDMA error.
+ *
+ * Implements    : FLEXCAN_DRV_GetTxDmaChainStatus_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_GetTxDmaChainStatus(uint8_t instance)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    const flexcan_state_t * state = g_flexcanStatePtr[instance];
+    status_t result = STATUS_SUCCESS;
+
+    if (state->txDma.frames != NULL)
+    {
+        result = STATUS_BUSY;
+    }
+    else if (state->txDma.error)
+    {
+        result = STATUS_ERROR;
+    }
+    else
+    {
+        /* The last chain was sent or aborted */
+    }
+
+    return result;
+}
+#endif /* FEATURE_CAN_HAS_DMA_ENABLE */
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_ConfigMb
+ * Description   : Configure a Rx message buffer.
+ * This function will first check if RX FIFO is enabled. If RX FIFO is enabled,
+ * the function will make sure if the MB requested is not occupied by RX FIFO
+ * and ID filter table. Then this function will set up the message buffer fields,
+ * configure the message buffer code for Rx message buffer as NOT_USED, enable
+ * the Message Buffer interrupt, configure the message buffer code for Rx
+ * message buffer as INACTIVE, copy user's buffer into the message buffer data
+ * area, and configure the message buffer code for Rx message buffer as EMPTY.
+ *
+ * Implements    : FLEXCAN_DRV_ConfigRxMb_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_ConfigRxMb(
+    uint8_t instance,
+    uint8_t mb_idx,
+    const flexcan_data_info_t *rx_info,
+    uint32_t msg_id)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(rx_info != NULL);
+
+    status_t result;
+    flexcan_msgbuff_code_status_t cs;
+    const flexcan_state_t * state = g_flexcanStatePtr[instance];
+    CAN_Type * base = g_flexcanBase[instance];
+
+    cs.dataLen = rx_info->data_length;
+    cs.msgIdType = rx_info->msg_id_type;
+    cs.fd_enable = rx_info->fd_enable;
+    /* Initialize rx mb*/
+    cs.code = (uint32_t)FLEXCAN_RX_NOT_USED;
+    result = FLEXCAN_SetRxMsgBuff(base, mb_idx, FLEXCAN_GetMsgBuffAddr(state, mb_idx), &cs, msg_id);
+    if (result != STATUS_SUCCESS)
+    {
+         return result;
+    }
+
+    /* Initialize receive MB*/
+    cs.code = (uint32_t)FLEXCAN_RX_INACTIVE;
+    result = FLEXCAN_SetRxMsgBuff(base, mb_idx, FLEXCAN_GetMsgBuffAddr(state, mb_idx), &cs, msg_id);
+    if (result != STATUS_SUCCESS)
+    {
+         return result;
+    }
+
+    /* Set up FlexCAN message buffer fields for receiving data*/
+    cs.code = (uint32_t)FLEXCAN_RX_EMPTY;
+    return FLEXCAN_SetRxMsgBuff(base, mb_idx, FLEXCAN_GetMsgBuffAddr(state, mb_idx), &cs, msg_id);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_ConfigRxFifo
+ * Description   : Confgure RX FIFO ID filter table elements.
+ * This function will confgure RX FIFO ID filter table elements, and enable RX
+ * FIFO interrupts.
+ *
+ * Implements    : FLEXCAN_DRV_ConfigRxFifo_Activity
+ *END**************************************************************************/
+void FLEXCAN_DRV_ConfigRxFifo(
+    uint8_t instance,
+    flexcan_rx_fifo_id_element_format_t id_format,
+    const flexcan_id_table_t *id_filter_table)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    CAN_Type * base = g_flexcanBase[instance];
+
+    FLEXCAN_EnterFreezeMode(base);
+
+    /* Initialize rx fifo*/
+    FLEXCAN_SetRxFifoFilter(base, id_format, id_filter_table);
+
+    FLEXCAN_ExitFreezeMode(base);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_ReceiveBlocking
+ * Description   : This function receives a CAN frame into a configured message
+ * buffer. The function blocks until either a frame was received, or the
+ * specified timeout expired.
+ *
+ * Implements    : FLEXCAN_DRV_ReceiveBlocking_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_ReceiveBlocking(
+    uint8_t instance,
+    uint8_t mb_idx,
+    flexcan_msgbuff_t *data,
+    uint32_t timeout_ms)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    status_t result;
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    CAN_Type * base = g_flexcanBase[instance];
+
+    result = FLEXCAN_StartRxMessageBufferData(instance, mb_idx, data, true);
+
+    if(result == STATUS_SUCCESS)
+    {
+        status_t status;
+
+        status = OSIF_SemaWait(&state->mbs[mb_idx].mbSema, timeout_ms);
+
+        if (status == STATUS_SUCCESS)
+        {
+            result = FLEXCAN_GetMsgBuff(base, mb_idx, FLEXCAN_GetMsgBuffAddr(state, mb_idx), data);
+        }
+        else
+        {
+            /* Disable message buffer interrupt */
+            (void)FLEXCAN_SetMsgBuffIntCmd(base, mb_idx, false);
+            /* Disable error interrupts */
+            FLEXCAN_DisableErrInt(instance);
+
+            result = STATUS_TIMEOUT;
+        }
+
+        state->mbs[mb_idx].state = FLEXCAN_MB_IDLE;
+    }
+
+    return result;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_Receive
+ * Description   : This function receives a CAN frame into a configured message
+ * buffer. The function returns immediately. If a callback is installed, it will
+ * be invoked after the frame was received and read into the specified buffer.
+ *
+ * Implements    : FLEXCAN_DRV_Receive_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_Receive(
+    uint8_t instance,
+    uint8_t mb_idx,
+    flexcan_msgbuff_t *data)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    status_t result;
+
+    result = FLEXCAN_StartRxMessageBufferData(instance, mb_idx, data, false);
+
+    return result;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_RxFifoBlocking
+ * Description   : This function receives a CAN frame using the Rx FIFO. The
+ * function blocks until either a frame was received, or the specified timeout
+ * expired.
+ *
+ * Implements    : FLEXCAN_DRV_RxFifoBlocking_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_RxFifoBlocking(
+    uint8_t instance,
+    flexcan_msgbuff_t *data,
+    uint32_t timeout_ms)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    status_t result;
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    CAN_Type * base = g_flexcanBase[instance];
+
+    result = FLEXCAN_StartRxMessageFifoData(instance, data, 0U, true);
+
+    if (result == STATUS_SUCCESS)
+    {
+        result = OSIF_SemaWait(&state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].mbSema, timeout_ms);
+
+        if (result == STATUS_TIMEOUT)
+        {
+            /* Disable RX FIFO interrupts*/
+            (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_FRAME_AVAILABLE, false);
+            (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_WARNING, false);
+            (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_OVERFLOW, false);
+
+            /* Disable error interrupts */
+            FLEXCAN_DisableErrInt(instance);
+
+            result = STATUS_TIMEOUT;
+        }
+
+        state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].state = FLEXCAN_MB_IDLE;
+    }
+
+    return result;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_RxFifo
+ * Description   : This function receives a CAN frame using the Rx FIFO. The
+ * function returns immediately. If a callback is installed, it will be invoked
+ * after the frame was received and read into the specified buffer.
+ *
+ * Implements    : FLEXCAN_DRV_RxFifo_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_RxFifo(
+    uint8_t instance,
+    flexcan_msgbuff_t *data)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    status_t result;
+
+    result = FLEXCAN_StartRxMessageFifoData(instance, data, 0U, false);
+
+    return result;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_RxFifoBatch
+ * Description   : This function receives up to maxFrames CAN frames using the
+ * Rx FIFO. The function returns immediately. The interrupt handler drains all
+ * the frames available in the FIFO at once, while in DMA mode a single major
+ * loop moves the whole batch. The number of received frames is written to
+ * count when the transfer completes.
+ *
+ * Implements    : FLEXCAN_DRV_RxFifoBatch_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_RxFifoBatch(
+    uint8_t instance,
+    flexcan_msgbuff_t *frames,
+    uint32_t maxFrames,
+    uint32_t *count)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(frames != NULL);
+    DEV_ASSERT(count != NULL);
+    DEV_ASSERT(maxFrames > 0U);
+    /* In DMA mode the whole batch is a single major loop */
+    DEV_ASSERT(maxFrames <= FLEXCAN_RX_FIFO_BATCH_MAX);
+
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    status_t result;
+
+    if (state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].state != FLEXCAN_MB_IDLE)
+    {
+        return STATUS_BUSY;
+    }
+
+    *count = 0U;
+    state->rxFifoBatchCount = count;
+
+    result = FLEXCAN_StartRxMessageFifoData(instance, frames, maxFrames, false);
+
+    return result;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_ReceiveContinuous
+ * Description   : This function starts a continuous reception using the given
+ * message buffer. Every received frame is appended to the ring by the interrupt
+ * handler, without disabling the message buffer interrupt, until the reception
+ * is stopped with FLEXCAN_DRV_AbortTransfer.
+ *
+ * Implements    : FLEXCAN_DRV_ReceiveContinuous_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_ReceiveContinuous(
+    uint8_t instance,
+    uint8_t mb_idx,
+    flexcan_msgbuff_t *buffer,
+    uint32_t ringSize)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(mb_idx < FEATURE_CAN_MAX_MB_NUM);
+    DEV_ASSERT(buffer != NULL);
+    DEV_ASSERT((ringSize != 0U) && ((ringSize & (ringSize - 1U)) == 0U));
+
+    status_t result;
+    CAN_Type * base = g_flexcanBase[instance];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+
+    if (state->mbs[mb_idx].state != FLEXCAN_MB_IDLE)
+    {
+        return STATUS_BUSY;
+    }
+    state->mbs[mb_idx].state = FLEXCAN_MB_RX_RING;
+    state->mbs[mb_idx].isBlocking = false;
+    state->mbs[mb_idx].mb_message = NULL;
+    state->mbs[mb_idx].rxRing.buffer = buffer;
+    state->mbs[mb_idx].rxRing.size = ringSize;
+    state->mbs[mb_idx].rxRing.head = 0U;
+    state->mbs[mb_idx].rxRing.tail = 0U;
+    state->mbs[mb_idx].rxRing.ringOverflows = 0U;
+    state->mbs[mb_idx].rxRing.hwOverruns = 0U;
+
+    /* Enable MB interrupt*/
+    result = FLEXCAN_SetMsgBuffIntCmd(base, mb_idx, true);
+    /* Enable error interrupts */
+    FLEXCAN_SetErrIntCmd(base,FLEXCAN_INT_ERR,true);
+
+    if (result != STATUS_SUCCESS)
+    {
+        state->mbs[mb_idx].state = FLEXCAN_MB_IDLE;
+    }
+
+    return result;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_RxFifoContinuous
+ * Description   : This function starts a continuous reception using the Rx
+ * FIFO. Every frame available in the Rx FIFO is appended to the ring by the
+ * interrupt handler until the reception is stopped with
+ * FLEXCAN_DRV_AbortTransfer. Only available for interrupt based Rx FIFO
+ * transfers.
+ *
+ * Implements    : FLEXCAN_DRV_RxFifoContinuous_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_RxFifoContinuous(
+    uint8_t instance,
+    flexcan_msgbuff_t *buffer,
+    uint32_t ringSize)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(buffer != NULL);
+    DEV_ASSERT((ringSize != 0U) && ((ringSize & (ringSize - 1U)) == 0U));
+
+    CAN_Type * base = g_flexcanBase[instance];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+
+    if (state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].state != FLEXCAN_MB_IDLE)
+    {
+        return STATUS_BUSY;
+    }
+    /* Check if RxFIFO feature is enabled and serviced by interrupts */
+    if ((!FLEXCAN_IsRxFifoEnabled(base)) || (state->transferType != FLEXCAN_RXFIFO_USING_INTERRUPTS))
+    {
+        return STATUS_ERROR;
+    }
+
+    state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].state = FLEXCAN_MB_RX_RING;
+    state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].isBlocking = false;
+    state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].mb_message = NULL;
+    state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].rxRing.buffer = buffer;
+    state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].rxRing.size = ringSize;
+    state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].rxRing.head = 0U;
+    state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].rxRing.tail = 0U;
+    state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].rxRing.ringOverflows = 0U;
+    state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].rxRing.hwOverruns = 0U;
+
+    /* Enable RX FIFO interrupts*/
+    (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_FRAME_AVAILABLE, true);
+    (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_WARNING, true);
+    (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_OVERFLOW, true);
+
+    /* Enable error interrupts */
+    FLEXCAN_SetErrIntCmd(base,FLEXCAN_INT_ERR,true);
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_ReadRxRing
+ * Description   : Copies up to maxFrames frames out of the ring of a continuous
+ * reception. The interrupt handler only advances the head index and this
+ * function only advances the tail index, so no critical section is needed.
+ *
+ * Implements    : FLEXCAN_DRV_ReadRxRing_Activity
+ *END**************************************************************************/
+uint32_t FLEXCAN_DRV_ReadRxRing(
+    uint8_t instance,
+    uint8_t mb_idx,
+    flexcan_msgbuff_t *frames,
+    uint32_t maxFrames)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(mb_idx < FEATURE_CAN_MAX_MB_NUM);
+    DEV_ASSERT((frames != NULL) || (maxFrames == 0U));
+
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    volatile flexcan_rx_ring_t * ring = &state->mbs[mb_idx].rxRing;
+    uint32_t head = ring->head;
+    uint32_t tail = ring->tail;
+    uint32_t count = 0U;
+
+    if (ring->buffer == NULL)
+    {
+        return 0U;
+    }
+
+    /* The frames up to head are read after head */
+    COMPILER_BARRIER();
+
+    while ((tail != head) && (count < maxFrames))
+    {
+        frames[count] = ring->buffer[tail & (ring->size - 1U)];
+        tail++;
+        count++;
+    }
+
+    /* Release the slots to the interrupt handler, once the frames are copied */
+    COMPILER_BARRIER();
+    ring->tail = tail;
+
+    return count;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_GetRxRingOverflows
+ * Description   : Returns the number of frames dropped because the ring was
+ * full and the number of frames lost in hardware since the continuous
+ * reception was started.
+ *
+ * Implements    : FLEXCAN_DRV_GetRxRingOverflows_Activity
+ *END**************************************************************************/
+void FLEXCAN_DRV_GetRxRingOverflows(
+    uint8_t instance,
+    uint8_t mb_idx,
+    uint32_t *ringOverflows,
+    uint32_t *hwOverruns)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(mb_idx < FEATURE_CAN_MAX_MB_NUM);
+
+    const flexcan_state_t * state = g_flexcanStatePtr[instance];
+
+    if (ringOverflows != NULL)
+    {
+        *ringOverflows = state->mbs[mb_idx].rxRing.ringOverflows;
+    }
+    if (hwOverruns != NULL)
+    {
+        *hwOverruns = state->mbs[mb_idx].rxRing.hwOverruns;
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_Deinit
+ * Description   : Shutdown a FlexCAN module.
+ * This function will disable all FlexCAN interrupts, and disable the FlexCAN.
+ *
+ * Implements    : FLEXCAN_DRV_Deinit_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_Deinit(uint8_t instance)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
 
-    /* Enable FlexCAN interrupts.*/
+    const flexcan_state_t * state = g_flexcanStatePtr[instance];
+    status_t result = STATUS_SUCCESS;
+    status_t osifStat;
+    uint32_t i;
+
+    /* Disable FlexCAN interrupts.*/
 #if FEATURE_CAN_HAS_WAKE_UP_IRQ
     if (g_flexcanWakeUpIrqId[instance] != NotAvail_IRQn)
     {
-        INT_SYS_EnableIRQ(g_flexcanWakeUpIrqId[instance]);
+        INT_SYS_DisableIRQ(g_flexcanWakeUpIrqId[instance]);
     }
 #endif
-    INT_SYS_EnableIRQ(g_flexcanErrorIrqId[instance]);
-    INT_SYS_EnableIRQ(g_flexcanBusOffIrqId[instance]);
+    INT_SYS_DisableIRQ(g_flexcanErrorIrqId[instance]);
+    INT_SYS_DisableIRQ(g_flexcanBusOffIrqId[instance]);
     for (i = 0; i < FEATURE_CAN_MB_IRQS_MAX_COUNT; i++)
     {
-        if (g_flexcanOredMessageBufferIrqId[i][instance] != NotAvail_IRQn)
+        if (g_flexcanOredMessageBufferIrqId[i][instance] != NotAvail_IRQn)
+        {
+            INT_SYS_DisableIRQ(g_flexcanOredMessageBufferIrqId[i][instance]);
+        }
+    }
+
+    /* Disable FlexCAN.*/
+    FLEXCAN_Disable(g_flexcanBase[instance]);
+
+    for (i = 0; i < FEATURE_CAN_MAX_MB_NUM; i++)
+    {
+        osifStat = OSIF_SemaDestroy(&state->mbs[i].mbSema);
+        if (osifStat != STATUS_SUCCESS)
+        {
+            result = STATUS_ERROR;
+        }
+    }
+
+    return result;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_SetTDCOffset
+ * Description   : Enables/Disables the Transceiver Delay Compensation feature and sets
+ * the Transceiver Delay Compensation Offset.
+ *
+ * Implements    : FLEXCAN_DRV_SetTDCOffset_Activity
+ *END**************************************************************************/
+void FLEXCAN_DRV_SetTDCOffset(uint8_t instance, bool enable, uint8_t offset)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    CAN_Type * base = g_flexcanBase[instance];
+
+    FLEXCAN_EnterFreezeMode(base);
+
+    /* Enable/Disable TDC and set the TDC Offset */
+    FLEXCAN_SetTDCOffset(base, enable, offset);
+
+    FLEXCAN_ExitFreezeMode(base);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_GetTDCValue
+ * Description   : Gets the value of the Transceiver Delay Compensation.
+ *
+ * Implements    : FLEXCAN_DRV_GetTDCValue_Activity
+ *END**************************************************************************/
+uint8_t FLEXCAN_DRV_GetTDCValue(uint8_t instance)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    const CAN_Type * base = g_flexcanBase[instance];
+
+    return (uint8_t)((base->FDCTRL & CAN_FDCTRL_TDCVAL_MASK) >> CAN_FDCTRL_TDCVAL_SHIFT);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_GetTDCFail
+ * Description   : Gets the value of the TDC Fail flag.
+ *
+ * Implements    : FLEXCAN_DRV_GetTDCFail_Activity
+ *END**************************************************************************/
+bool FLEXCAN_DRV_GetTDCFail(uint8_t instance)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    const CAN_Type * base = g_flexcanBase[instance];
+
+    return (((base->FDCTRL & CAN_FDCTRL_TDCFAIL_MASK) >> CAN_FDCTRL_TDCFAIL_SHIFT) != 0U);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_ClearTDCFail
+ * Description   : Clears the TDC Fail flag.
+ *
+ * Implements    : FLEXCAN_DRV_ClearTDCFail_Activity
+ *END**************************************************************************/
+void FLEXCAN_DRV_ClearTDCFail(uint8_t instance)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    CAN_Type * base = g_flexcanBase[instance];
+
+    base->FDCTRL = base->FDCTRL | CAN_FDCTRL_TDCFAIL_MASK;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_IRQHandler
+ * Description   : Interrupt handler for FLEXCAN.
+ * This handler reads each IFLAG register once, masked by the matching IMASK
+ * register, and services every pending MB (or the Rx FIFO) in a single
+ * invocation, in ascending MB order. The pending MBs are found by isolating the
+ * lowest set flag and counting its leading zeros.
+ * This is not a public API as it is called whenever an interrupt occurs.
+ *
+ *END**************************************************************************/
+void FLEXCAN_IRQHandler(uint8_t instance)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    CAN_Type * base = g_flexcanBase[instance];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    flexcan_fault_state_t previousState;
+    uint32_t regIdx;
+    uint32_t flags;
+    uint32_t lowestFlag;
+    uint32_t leadingZeros;
+    uint8_t i;
+
+    for (regIdx = 0U; regIdx < FLEXCAN_MB_FLAG_REG_COUNT; regIdx++)
+    {
+        /* Get the interrupts that are enabled and ready */
+        flags = FLEXCAN_GetMsgBuffIntStatusFlags(base, regIdx);
+
+        while (flags != 0U)
+        {
+            lowestFlag = flags & (0U - flags);
+            COUNT_LEADING_ZEROS_32(lowestFlag, leadingZeros);
+
+            FLEXCAN_ServiceMsgBuff(instance, (regIdx << 5U) + (31U - leadingZeros));
+
+            flags &= ~lowestFlag;
+        }
+    }
+
+    /* The MB lines are level-sensitive: the other line of the instance may have
+     * been pended by flags serviced above, which would enter the handler again
+     * for nothing. A line still asserted by a newer flag stays pending. */
+    for (i = 0U; i < FEATURE_CAN_MB_IRQS_MAX_COUNT; i++)
+    {
+        if (g_flexcanOredMessageBufferIrqId[i][instance] != NotAvail_IRQn)
+        {
+            INT_SYS_ClearPending(g_flexcanOredMessageBufferIrqId[i][instance]);
+        }
+    }
+
+    /* Account for the bus errors before their flags are cleared */
+    if (state->errorManager.enabled)
+    {
+        if (FLEXCAN_UpdateFaultState(instance, &previousState) && (state->errorManager.config.callback != NULL))
+        {
+            state->errorManager.config.callback(instance, previousState, state->errorManager.faultState,
+                                                state->errorManager.config.callbackParam);
+        }
+    }
+
+    /* Clear all other interrupts in ERRSTAT register (Error, Busoff, Wakeup) */
+    FLEXCAN_ClearErrIntStatusFlag(base);
+
+    return;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ServiceMsgBuff
+ * Description   : Handles the pending interrupt of one MB (or of the Rx FIFO):
+ * reads the received frame or completes the transmission, clears the interrupt
+ * flag and invokes the callback.
+ * This is not a public API as it is called from FLEXCAN_IRQHandler.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_ServiceMsgBuff(uint8_t instance, uint32_t mb_idx)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    CAN_Type * base = g_flexcanBase[instance];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    status_t result = STATUS_SUCCESS;
+    bool rxfifoEnabled = FLEXCAN_IsRxFifoEnabled(base);
+
+    if ((mb_idx >= FEATURE_CAN_RXFIFO_FRAME_AVAILABLE) && (mb_idx <= FEATURE_CAN_RXFIFO_OVERFLOW) &&
+        rxfifoEnabled && (state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].state == FLEXCAN_MB_RX_RING))
+    {
+        /* Move the frame to the ring and account for the FIFO warning/overflow */
+        FLEXCAN_CompleteRxRingFifo(instance);
+    }
+    else if ((mb_idx == FEATURE_CAN_RXFIFO_FRAME_AVAILABLE) && rxfifoEnabled)
+    {
+        if (state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].state == FLEXCAN_MB_RX_BUSY)
+        {
+            if (state->rxFifoBatchSize != 0U)
+            {
+                /* Drain the FIFO into the batch, the flag is cleared per frame */
+                FLEXCAN_ReadRxFifoBatch(instance);
+
+                /* Complete receive data */
+                FLEXCAN_CompleteRxMessageFifoData(instance);
+            }
+            else
+            {
+                /* Get RX FIFO field values */
+                FLEXCAN_ReadRxFifo(base, state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].mb_message);
+                FLEXCAN_StampRxFrame(instance, FLEXCAN_MB_HANDLE_RXFIFO, state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].mb_message);
+
+                /* Complete receive data */
+                FLEXCAN_CompleteRxMessageFifoData(instance);
+                FLEXCAN_ClearMsgBuffIntStatusFlag(base, mb_idx);
+            }
+
+            /* Invoke callback */
+            if (state->callback != NULL)
+            {
+                state->callback(instance,
+                                FLEXCAN_EVENT_RXFIFO_COMPLETE,
+                                FLEXCAN_MB_HANDLE_RXFIFO,
+                                state);
+            }
+        }
+    }
+    else if (state->mbs[mb_idx].state == FLEXCAN_MB_RX_RING)
+    {
+        /* Append the frame to the ring, the MB stays armed */
+        FLEXCAN_CompleteRxRingMessageBuffer(instance, mb_idx);
+    }
+    else
+    {
+        /* Check mailbox completed reception */
+        if (state->mbs[mb_idx].state == FLEXCAN_MB_RX_BUSY)
+        {
+            /* Lock RX message buffer and RX FIFO*/
+            result = FLEXCAN_LockRxMsgBuff(base, mb_idx, FLEXCAN_GetMsgBuffAddr(state, mb_idx));
+            if (result == STATUS_SUCCESS)
+            {
+                /* Get RX MB field values*/
+                result = FLEXCAN_GetMsgBuff(base, mb_idx, FLEXCAN_GetMsgBuffAddr(state, mb_idx), state->mbs[mb_idx].mb_message);
+            }
+            if (result == STATUS_SUCCESS)
+            {
+                /* Unlock RX message buffer and RX FIFO*/
+                FLEXCAN_UnlockRxMsgBuff(base);
+                FLEXCAN_StampRxFrame(instance, mb_idx, state->mbs[mb_idx].mb_message);
+
+                /* Complete receive data */
+                FLEXCAN_CompleteTransfer(instance, mb_idx);
+                FLEXCAN_ClearMsgBuffIntStatusFlag(base, mb_idx);
+
+                /* Invoke callback */
+                if (state->callback != NULL)
+                {
+                    state->callback(instance, FLEXCAN_EVENT_RX_COMPLETE, mb_idx, state);
+                }
+            }
+        }
+    }
+
+    /* Check mailbox completed transmission */
+    if (state->mbs[mb_idx].state == FLEXCAN_MB_TX_BUSY)
+    {
+        /* Complete transmit data */
+        FLEXCAN_CompleteTransfer(instance, mb_idx);
+
+        if (state->mbs[mb_idx].isRemote)
+        {
+            /* If the frame was a remote frame, clear the flag only if the response was
+             * not received yet. If the response was received, leave the flag set in order
+             * to be handled when the user calls FLEXCAN_DRV_RxMessageBuffer. */
+            flexcan_msgbuff_t mb;
+            (void) FLEXCAN_LockRxMsgBuff(base, mb_idx, FLEXCAN_GetMsgBuffAddr(state, mb_idx));
+            (void) FLEXCAN_GetMsgBuff(base, mb_idx, FLEXCAN_GetMsgBuffAddr(state, mb_idx), &mb);
+            FLEXCAN_UnlockRxMsgBuff(base);
+
+            if (((mb.cs & CAN_CS_CODE_MASK) >> CAN_CS_CODE_SHIFT) == (uint32_t)FLEXCAN_RX_EMPTY)
+            {
+                FLEXCAN_ClearMsgBuffIntStatusFlag(base, mb_idx);
+            }
+        }
+        else
+        {
+            FLEXCAN_ClearMsgBuffIntStatusFlag(base, mb_idx);
+        }
+
+        FLEXCAN_StampTxFrame(instance, mb_idx);
+
+#if FEATURE_CAN_HAS_DMA_ENABLE
+        /* Start the next batch of the eDMA chain, only the end of the chain is reported */
+        if (FLEXCAN_ServiceTxDma(instance, mb_idx))
+        {
+            return;
+        }
+#endif
+
+        /* Invoke callback */
+        if (state->callback != NULL)
+        {
+            state->callback(instance, FLEXCAN_EVENT_TX_COMPLETE, mb_idx, state);
+        }
+
+        /* Reload the idle MBs of the transmit queue pool */
+        FLEXCAN_KickTxQueue(instance);
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_LoadTxQueueMb
+ * Description   : Loads a frame of the transmit queue into an idle MB of the
+ * pool, with a PRIO above the one of every frame pending in the pool, so that
+ * the older frames win the internal arbitration whatever their ID and MB.
+ * Once PRIO reached its maximum, the next frame waits until the pool drained
+ * and PRIO starts again from 0.
+ * This is not a public API as it is called with the interrupts disabled from
+ * other driver functions.
+ *
+ *END**************************************************************************/
+static status_t FLEXCAN_LoadTxQueueMb(uint8_t instance,
+                                      uint32_t mb_idx,
+                                      const flexcan_data_info_t *tx_info,
+                                      uint32_t msg_id,
+                                      const uint8_t *mb_data)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    flexcan_tx_queue_t * queue = &state->txQueue;
+    bool poolIdle = true;
+    uint32_t i;
+    status_t result;
+
+    for (i = queue->firstMb; i < ((uint32_t)queue->firstMb + queue->mbCount); i++)
+    {
+        if (state->mbs[i].state != FLEXCAN_MB_IDLE)
         {
-            INT_SYS_EnableIRQ(g_flexcanOredMessageBufferIrqId[i][instance]);
+            poolIdle = false;
+            break;
         }
     }
 
-    for (i = 0; i < FEATURE_CAN_MAX_MB_NUM; i++)
+    if (poolIdle)
     {
-        osifStat = OSIF_SemaCreate(&state->mbs[i].mbSema, 0U);
-        if (osifStat != STATUS_SUCCESS)
-        {
-            for (j = 0; j < i; j++)
-            {
-                (void)OSIF_SemaDestroy(&state->mbs[j].mbSema);
-            }
-            return STATUS_ERROR;
-        }
-        state->mbs[i].isBlocking = false;
-        state->mbs[i].mb_message = NULL;
-        state->mbs[i].state = FLEXCAN_MB_IDLE;
+        queue->nextPrio = 0U;
+    }
+    else if (queue->nextPrio > (CAN_ID_PRIO_MASK >> CAN_ID_PRIO_SHIFT))
+    {
+        return STATUS_BUSY;
+    }
+    else
+    {
+        /* The pending frames all have a lower PRIO */
     }
 
-    /* Store transfer type and DMA channel number used in transfer */
-    state->transferType = data->transfer_type;
-#if FEATURE_CAN_HAS_DMA_ENABLE
-    state->rxFifoDMAChannel = data->rxFifoDMAChannel;
-#endif
-
-    /* Save runtime structure pointers so irq handler can point to the correct state structure */
-    g_flexcanStatePtr[instance] = state;
+    result = FLEXCAN_DRV_Send(instance, (uint8_t)mb_idx, tx_info,
+                              msg_id | ((uint32_t)queue->nextPrio << CAN_ID_PRIO_SHIFT), mb_data);
+    if (result == STATUS_SUCCESS)
+    {
+        queue->nextPrio++;
+    }
 
-    return (STATUS_SUCCESS);
+    return result;
 }
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_DRV_ConfigTxMb
- * Description   : Configure a Tx message buffer.
- * This function will first check if RX FIFO is enabled. If RX FIFO is enabled,
- * the function will make sure if the MB requested is not occupied by RX FIFO
- * and ID filter table. Then this function will set up the message buffer fields,
- * configure the message buffer code for Tx buffer as INACTIVE, and enable the
- * Message Buffer interrupt.
+ * Function Name : FLEXCAN_ServiceTxQueue
+ * Description   : Loads the oldest queued frame into an idle MB of the transmit
+ * queue pool. A frame that fails to load stays at the head of the queue and
+ * the error is kept for FLEXCAN_DRV_GetTxQueueStatus; a frame waiting for the
+ * pool to drain is not an error.
+ * This is not a public API as it is called from FLEXCAN_ServiceMsgBuff and
+ * with the interrupts disabled from other driver functions.
  *
- * Implements    : FLEXCAN_DRV_ConfigTxMb_Activity
  *END**************************************************************************/
-status_t FLEXCAN_DRV_ConfigTxMb(
-    uint8_t instance,
-    uint8_t mb_idx,
-    const flexcan_data_info_t *tx_info,
-    uint32_t msg_id)
+static status_t FLEXCAN_ServiceTxQueue(uint8_t instance, uint32_t mb_idx)
 {
     DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
-    DEV_ASSERT(tx_info != NULL);
 
-    flexcan_msgbuff_code_status_t cs;
-    CAN_Type * base = g_flexcanBase[instance];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    flexcan_tx_queue_t * queue = &state->txQueue;
+    const flexcan_tx_frame_t * frame;
+    status_t result = STATUS_SUCCESS;
 
-    /* Initialize transmit mb*/
-    cs.dataLen = tx_info->data_length;
-    cs.msgIdType = tx_info->msg_id_type;
-    if (tx_info->is_remote)
+    if ((queue->frames != NULL) &&
+        (mb_idx >= queue->firstMb) && (mb_idx < ((uint32_t)queue->firstMb + queue->mbCount)) &&
+        (state->mbs[mb_idx].state == FLEXCAN_MB_IDLE) && (queue->head != queue->tail))
     {
-        cs.code = (uint32_t)FLEXCAN_TX_REMOTE;
+        frame = &queue->frames[queue->tail & (queue->size - 1U)];
+        result = FLEXCAN_LoadTxQueueMb(instance, mb_idx, &frame->txInfo, frame->msgId, frame->data);
+        if (result == STATUS_SUCCESS)
+        {
+            /* The latency of the frame starts when it was queued */
+            state->mbs[mb_idx].startTime = frame->queuedTime;
+            queue->tail++;
+        }
+        if (result != STATUS_BUSY)
+        {
+            queue->loadStatus = result;
+        }
     }
-    else
+
+    return result;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_KickTxQueue
+ * Description   : Loads queued frames into every idle MB of the transmit queue
+ * pool, stopping at the first frame that fails to load.
+ * This is not a public API as it is called with the interrupts disabled from
+ * other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_KickTxQueue(uint8_t instance)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    const flexcan_tx_queue_t * queue = &g_flexcanStatePtr[instance]->txQueue;
+    uint32_t i;
+
+    for (i = queue->firstMb; (i < ((uint32_t)queue->firstMb + queue->mbCount)) && (queue->head != queue->tail); i++)
     {
-        cs.code = (uint32_t)FLEXCAN_TX_INACTIVE;
+        if (FLEXCAN_ServiceTxQueue(instance, i) != STATUS_SUCCESS)
+        {
+            break;
+        }
     }
-    return FLEXCAN_SetTxMsgBuff(base, mb_idx, &cs, msg_id, NULL);
 }
 
+#if FEATURE_CAN_HAS_DMA_ENABLE
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_DRV_SendBlocking
- * Description   : This function sends a CAN frame using a configured message
- * buffer. The function blocks until either the frame was sent, or the specified
- * timeout expired.
+ * Function Name : FLEXCAN_StartTxDmaBatch
+ * Description   : Hands the next batch of the eDMA chain to the channel. Each
+ * frame takes two scatter/gather descriptors: the ID and payload words first,
+ * then the CODE/status word which starts the transmission. Only the interrupt
+ * of the last MB of the batch is enabled and the last descriptor disables the
+ * channel requests.
+ * This is not a public API as it is called from other driver functions.
  *
- * Implements    : FLEXCAN_DRV_SendBlocking_Activity
  *END**************************************************************************/
-status_t FLEXCAN_DRV_SendBlocking(
-    uint8_t instance,
-    uint8_t mb_idx,
-    const flexcan_data_info_t *tx_info,
-    uint32_t msg_id,
-    const uint8_t *mb_data,
-    uint32_t timeout_ms)
+static status_t FLEXCAN_StartTxDmaBatch(uint8_t instance)
 {
     DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
-    DEV_ASSERT(tx_info != NULL);
 
-    status_t result;
+    CAN_Type * base = g_flexcanBase[instance];
     flexcan_state_t * state = g_flexcanStatePtr[instance];
-    CAN_Type * base  = g_flexcanBase[instance];
+    flexcan_tx_dma_t * txDma = &state->txDma;
+    edma_scatter_gather_list_t srcList[2U * FLEXCAN_TX_DMA_MAX_MBS];
+    edma_scatter_gather_list_t destList[2U * FLEXCAN_TX_DMA_MAX_MBS];
+    edma_software_tcd_t * stcd = (edma_software_tcd_t *)STCD_ADDR(txDma->stcd);
+    flexcan_tx_dma_frame_t * frame;
+    volatile uint32_t * mbAddr;
+    uint64_t now = 0U;
+    uint32_t batchSize = txDma->count - txDma->next;
+    uint32_t tcdCount;
+    uint32_t mb_idx;
+    uint32_t i;
+    status_t result;
 
-    result = FLEXCAN_StartSendData(instance, mb_idx, tx_info, msg_id, mb_data, true);
+    if (batchSize > txDma->mbCount)
+    {
+        batchSize = txDma->mbCount;
+    }
+    tcdCount = 2U * batchSize;
 
-    if (result == STATUS_SUCCESS)
+    if (state->timeBase != NULL)
     {
-        status_t status;
+        now = state->timeBase->getTime(state->timeBase->param);
+    }
 
-        /* Enable message buffer interrupt*/
-        (void)FLEXCAN_SetMsgBuffIntCmd(base, mb_idx, true);
-        /* Enable error interrupts */
-        FLEXCAN_SetErrIntCmd(base,FLEXCAN_INT_ERR,true);
+    for (i = 0U; i < batchSize; i++)
+    {
+        mb_idx = (uint32_t)txDma->firstMb + i;
+        mbAddr = FLEXCAN_GetMsgBuffAddr(state, mb_idx);
+        frame = &txDma->frames[txDma->next + i];
+
+        /* The frames of the batch leave in pool order */
+        frame->image[1] = (frame->image[1] & ~CAN_ID_PRIO_MASK) | ((i << CAN_ID_PRIO_SHIFT) & CAN_ID_PRIO_MASK);
+
+        srcList[2U * i].address = (uint32_t)&frame->image[1];
+        srcList[2U * i].length = (frame->length - 1U) << 2U;
+        srcList[2U * i].type = EDMA_TRANSFER_MEM2MEM;
+        destList[2U * i].address = (uint32_t)&mbAddr[1];
+        destList[2U * i].length = srcList[2U * i].length;
+        destList[2U * i].type = EDMA_TRANSFER_MEM2MEM;
+
+        srcList[(2U * i) + 1U].address = (uint32_t)&frame->image[0];
+        srcList[(2U * i) + 1U].length = 4U;
+        srcList[(2U * i) + 1U].type = EDMA_TRANSFER_MEM2MEM;
+        destList[(2U * i) + 1U].address = (uint32_t)&mbAddr[0];
+        destList[(2U * i) + 1U].length = 4U;
+        destList[(2U * i) + 1U].type = EDMA_TRANSFER_MEM2MEM;
+
+        state->mbs[mb_idx].state = FLEXCAN_MB_TX_BUSY;
+        state->mbs[mb_idx].isBlocking = false;
+        state->mbs[mb_idx].isRemote = false;
+        state->mbs[mb_idx].startTime = now;
+        FLEXCAN_ClearMsgBuffIntStatusFlag(base, mb_idx);
+    }
 
-        status = OSIF_SemaWait(&state->mbs[mb_idx].mbSema, timeout_ms);
+    txDma->lastMb = (uint8_t)(txDma->firstMb + batchSize - 1U);
+    (void)FLEXCAN_SetMsgBuffIntCmd(base, txDma->lastMb, true);
 
-        if (status == STATUS_TIMEOUT)
+    result = EDMA_DRV_ConfigScatterGatherTransfer(txDma->dmaChannel, txDma->stcd, EDMA_TRANSFER_SIZE_4B, 4U,
+                                                  srcList, destList, (uint8_t)tcdCount);
+    if (result == STATUS_SUCCESS)
+    {
+        /* No eDMA interrupt is needed, the last MB reports the end of the batch */
+        EDMA_DRV_ConfigureInterrupt(txDma->dmaChannel, EDMA_CHN_MAJOR_LOOP_INT, false);
+        for (i = 0U; i < (tcdCount - 1U); i++)
         {
-            /* Disable message buffer interrupt */
-            (void)FLEXCAN_SetMsgBuffIntCmd(base, mb_idx, false);
-            /* Disable error interrupts */
-            FLEXCAN_SetErrIntCmd(base,FLEXCAN_INT_ERR,false);
-
-            result = STATUS_TIMEOUT;
+            stcd[i].CSR &= (uint16_t)~DMA_TCD_CSR_INTMAJOR_MASK;
         }
+        /* The last descriptor ends the batch instead of loading one from address 0 */
+        stcd[tcdCount - 2U].CSR = (uint16_t)((stcd[tcdCount - 2U].CSR & ~DMA_TCD_CSR_ESG_MASK) | DMA_TCD_CSR_DREQ_MASK);
 
-        state->mbs[mb_idx].state = FLEXCAN_MB_IDLE;
+        txDma->next += batchSize;
+        result = EDMA_DRV_StartChannel(txDma->dmaChannel);
+    }
+
+    if (result != STATUS_SUCCESS)
+    {
+        (void)FLEXCAN_SetMsgBuffIntCmd(base, txDma->lastMb, false);
+        for (i = 0U; i < batchSize; i++)
+        {
+            state->mbs[(uint32_t)txDma->firstMb + i].state = FLEXCAN_MB_IDLE;
+        }
+        result = STATUS_ERROR;
     }
 
     return result;
@@ -694,579 +3375,609 @@ status_t FLEXCAN_DRV_SendBlocking(
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_DRV_Send
- * Description   : This function sends a CAN frame using a configured message
- * buffer. The function returns immediately. If a callback is installed, it will
- * be invoked after the frame was sent.
+ * Function Name : FLEXCAN_ServiceTxDma
+ * Description   : Handles the end of a batch of the eDMA chain: releases the
+ * pool MBs and starts the next batch. Returns true if the chain goes on.
+ * This is not a public API as it is called from FLEXCAN_ServiceMsgBuff.
  *
- * Implements    : FLEXCAN_DRV_Send_Activity
  *END**************************************************************************/
-status_t FLEXCAN_DRV_Send(
-    uint8_t instance,
-    uint8_t mb_idx,
-    const flexcan_data_info_t *tx_info,
-    uint32_t msg_id,
-    const uint8_t *mb_data)
+static bool FLEXCAN_ServiceTxDma(uint8_t instance, uint32_t mb_idx)
 {
     DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
-    DEV_ASSERT(tx_info != NULL);
 
-    status_t result;
     CAN_Type * base = g_flexcanBase[instance];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    flexcan_tx_dma_t * txDma = &state->txDma;
+    bool chainPending = false;
+    uint32_t i;
 
-    result = FLEXCAN_StartSendData(instance, mb_idx, tx_info, msg_id, mb_data, false);
-    if(result == STATUS_SUCCESS)
+    if ((txDma->frames != NULL) && (mb_idx == txDma->lastMb))
     {
-        /* Enable message buffer interrupt*/
-        result = FLEXCAN_SetMsgBuffIntCmd(base, mb_idx, true);
-        /* Enable error interrupts */
-        FLEXCAN_SetErrIntCmd(base,FLEXCAN_INT_ERR,true);
+        /* The frames of the batch were sent before the last one */
+        for (i = txDma->firstMb; i < mb_idx; i++)
+        {
+            FLEXCAN_ClearMsgBuffIntStatusFlag(base, i);
+            state->mbs[i].state = FLEXCAN_MB_IDLE;
+        }
+
+        if ((txDma->next < txDma->count) && (FLEXCAN_StartTxDmaBatch(instance) == STATUS_SUCCESS))
+        {
+            chainPending = true;
+        }
+        else
+        {
+            txDma->frames = NULL;
+        }
     }
 
-    return result;
+    return chainPending;
 }
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_DRV_ConfigMb
- * Description   : Configure a Rx message buffer.
- * This function will first check if RX FIFO is enabled. If RX FIFO is enabled,
- * the function will make sure if the MB requested is not occupied by RX FIFO
- * and ID filter table. Then this function will set up the message buffer fields,
- * configure the message buffer code for Rx message buffer as NOT_USED, enable
- * the Message Buffer interrupt, configure the message buffer code for Rx
- * message buffer as INACTIVE, copy user's buffer into the message buffer data
- * area, and configure the message buffer code for Rx message buffer as EMPTY.
+ * Function Name : FLEXCAN_StopTxDma
+ * Description   : Ends the eDMA chain being sent: stops the channel and takes
+ * back the frames of the batch that did not leave yet, so that the pool MBs
+ * are idle again. Returns false if no chain was being sent.
+ * This is not a public API as it is called with the interrupts disabled from
+ * other driver functions.
  *
- * Implements    : FLEXCAN_DRV_ConfigRxMb_Activity
  *END**************************************************************************/
-status_t FLEXCAN_DRV_ConfigRxMb(
-    uint8_t instance,
-    uint8_t mb_idx,
-    const flexcan_data_info_t *rx_info,
-    uint32_t msg_id)
+static bool FLEXCAN_StopTxDma(uint8_t instance)
 {
     DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
-    DEV_ASSERT(rx_info != NULL);
 
-    status_t result;
-    flexcan_msgbuff_code_status_t cs;
     CAN_Type * base = g_flexcanBase[instance];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    flexcan_tx_dma_t * txDma = &state->txDma;
+    volatile uint32_t * mbAddr;
+    uint32_t i;
 
-    cs.dataLen = rx_info->data_length;
-    cs.msgIdType = rx_info->msg_id_type;
-    cs.fd_enable = rx_info->fd_enable;
-    /* Initialize rx mb*/
-    cs.code = (uint32_t)FLEXCAN_RX_NOT_USED;
-    result = FLEXCAN_SetRxMsgBuff(base, mb_idx, &cs, msg_id);
-    if (result != STATUS_SUCCESS)
+    if (txDma->frames == NULL)
     {
-         return result;
+        return false;
     }
 
-    /* Initialize receive MB*/
-    cs.code = (uint32_t)FLEXCAN_RX_INACTIVE;
-    result = FLEXCAN_SetRxMsgBuff(base, mb_idx, &cs, msg_id);
-    if (result != STATUS_SUCCESS)
+    /* The channel stops before the MBs it loads are deactivated */
+    (void)EDMA_DRV_StopChannel(txDma->dmaChannel);
+
+    for (i = txDma->firstMb; i < ((uint32_t)txDma->firstMb + txDma->mbCount); i++)
     {
-         return result;
+        if (state->mbs[i].state == FLEXCAN_MB_TX_BUSY)
+        {
+            mbAddr = FLEXCAN_GetMsgBuffAddr(state, i);
+            *mbAddr = (*mbAddr & ~CAN_CS_CODE_MASK) | (((uint32_t)FLEXCAN_TX_INACTIVE << CAN_CS_CODE_SHIFT) & CAN_CS_CODE_MASK);
+            FLEXCAN_ClearMsgBuffIntStatusFlag(base, i);
+            FLEXCAN_CompleteTransfer(instance, i);
+        }
     }
 
-    /* Set up FlexCAN message buffer fields for receiving data*/
-    cs.code = (uint32_t)FLEXCAN_RX_EMPTY;
-    return FLEXCAN_SetRxMsgBuff(base, mb_idx, &cs, msg_id);
+    txDma->frames = NULL;
+
+    return true;
 }
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_DRV_ConfigRxFifo
- * Description   : Confgure RX FIFO ID filter table elements.
- * This function will confgure RX FIFO ID filter table elements, and enable RX
- * FIFO interrupts.
+ * Function Name : FLEXCAN_CompleteTxDmaError
+ * Description   : Callback of the eDMA channel of the Tx chains. The chain
+ * descriptors raise no interrupt, so the channel only calls it on an error:
+ * the chain is ended, without TX_COMPLETE event, and the error is kept for
+ * FLEXCAN_DRV_GetTxDmaChainStatus.
+ * This is not a public API as it is called from the eDMA driver.
  *
- * Implements    : FLEXCAN_DRV_ConfigRxFifo_Activity
  *END**************************************************************************/
-void FLEXCAN_DRV_ConfigRxFifo(
-    uint8_t instance,
-    flexcan_rx_fifo_id_element_format_t id_format,
-    const flexcan_id_table_t *id_filter_table)
+static void FLEXCAN_CompleteTxDmaError(void *parameter, edma_chn_status_t status)
 {
-    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
-
-    CAN_Type * base = g_flexcanBase[instance];
-
-    FLEXCAN_EnterFreezeMode(base);
-
-    /* Initialize rx fifo*/
-    FLEXCAN_SetRxFifoFilter(base, id_format, id_filter_table);
+    uint8_t instance = (uint8_t)((uint32_t)parameter);
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
 
-    FLEXCAN_ExitFreezeMode(base);
+    if (status == EDMA_CHN_ERROR)
+    {
+        /* The FlexCAN interrupt may start the next batch meanwhile */
+        INT_SYS_DisableIRQGlobal();
+        if (FLEXCAN_StopTxDma(instance))
+        {
+            state->txDma.error = true;
+        }
+        INT_SYS_EnableIRQGlobal();
+    }
 }
+#endif /* FEATURE_CAN_HAS_DMA_ENABLE */
+
+#if FEATURE_CAN_HAS_WAKE_UP_IRQ
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_DRV_ReceiveBlocking
- * Description   : This function receives a CAN frame into a configured message
- * buffer. The function blocks until either a frame was received, or the
- * specified timeout expired.
+ * Function Name : FLEXCAN_WakeUpHandler
+ * Description   : Wake up handler for FLEXCAN.
+ * This handler verifies the event which caused the wake up and invokes the
+ * user callback, if configured.
+ * This is not a public API as it is called whenever an wake up event occurs.
  *
- * Implements    : FLEXCAN_DRV_ReceiveBlocking_Activity
  *END**************************************************************************/
-status_t FLEXCAN_DRV_ReceiveBlocking(
-    uint8_t instance,
-    uint8_t mb_idx,
-    flexcan_msgbuff_t *data,
-    uint32_t timeout_ms)
+void FLEXCAN_WakeUpHandler(uint8_t instance)
 {
     DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
 
-    status_t result;
-    flexcan_state_t * state = g_flexcanStatePtr[instance];
     CAN_Type * base = g_flexcanBase[instance];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
 
-    result = FLEXCAN_StartRxMessageBufferData(instance, mb_idx, data, true);
-
-    if(result == STATUS_SUCCESS)
+    /* Invoke callback */
+    if (state->callback != NULL)
     {
-        status_t status;
-
-        status = OSIF_SemaWait(&state->mbs[mb_idx].mbSema, timeout_ms);
-
-        if (status == STATUS_SUCCESS)
+#if FEATURE_CAN_HAS_PRETENDED_NETWORKING
+        if (FLEXCAN_IsPNEnabled(base))
         {
-            result = FLEXCAN_GetMsgBuff(base, mb_idx, data);
+            if (FLEXCAN_GetWTOF(base) != 0U)
+            {
+                FLEXCAN_ClearWTOF(base);
+                state->callback(instance, FLEXCAN_EVENT_WAKEUP_TIMEOUT, 0U, state);
+            }
+            if (FLEXCAN_GetWUMF(base) != 0U)
+            {
+                FLEXCAN_ClearWUMF(base);
+                state->callback(instance, FLEXCAN_EVENT_WAKEUP_MATCH, 0U, state);
+            }
         }
-        else
-        {
-            /* Disable message buffer interrupt */
-            (void)FLEXCAN_SetMsgBuffIntCmd(base, mb_idx, false);
-            /* Disable error interrupts */
-            FLEXCAN_SetErrIntCmd(base,FLEXCAN_INT_ERR,false);
+#endif
 
-            result = STATUS_TIMEOUT;
+#if FEATURE_CAN_HAS_SELF_WAKE_UP
+        if (FLEXCAN_IsSelfWakeUpEnabled(base))
+        {
+            if (FLEXCAN_GetWAKINT(base) != 0U)
+            {
+                FLEXCAN_ClearWAKINT(base);
+                state->callback(instance, FLEXCAN_EVENT_SELF_WAKEUP, 0U, state);
+            }
         }
-
-        state->mbs[mb_idx].state = FLEXCAN_MB_IDLE;
+#endif
     }
-
-    return result;
 }
+#endif /* FEATURE_CAN_HAS_WAKE_UP_IRQ */
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_DRV_Receive
- * Description   : This function receives a CAN frame into a configured message
- * buffer. The function returns immediately. If a callback is installed, it will
- * be invoked after the frame was received and read into the specified buffer.
+ * Function Name : FLEXCAN_DRV_GetTransferStatus
+ * Description   : This function returns whether the previous FLEXCAN receive is
+ *                 completed.
+ * When performing a non-blocking receive, the user can call this function to
+ * ascertain the state of the current receive progress: in progress (or busy)
+ * or complete (success).
  *
- * Implements    : FLEXCAN_DRV_Receive_Activity
+ * Implements    : FLEXCAN_DRV_GetTransferStatus_Activity
  *END**************************************************************************/
-status_t FLEXCAN_DRV_Receive(
-    uint8_t instance,
-    uint8_t mb_idx,
-    flexcan_msgbuff_t *data)
+status_t FLEXCAN_DRV_GetTransferStatus(uint8_t instance, uint8_t mb_idx)
 {
     DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
 
-    status_t result;
+    const flexcan_state_t * state = g_flexcanStatePtr[instance];
+    status_t status;
 
-    result = FLEXCAN_StartRxMessageBufferData(instance, mb_idx, data, false);
+    if (state->mbs[mb_idx].state == FLEXCAN_MB_IDLE)
+    {
+        status = STATUS_SUCCESS;
+    }
+    else
+    {
+        status = STATUS_BUSY;
+    }
 
-    return result;
+    return status;
 }
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_DRV_RxFifoBlocking
- * Description   : This function receives a CAN frame using the Rx FIFO. The
- * function blocks until either a frame was received, or the specified timeout
- * expired.
+ * Function Name : FLEXCAN_DRV_ConfigErrorManager
+ * Description   : Sets up the tracking of the bus errors: the error, bus-off
+ * and bus-off done interrupts are enabled and the node is held in bus-off
+ * until the error manager lets it recover.
  *
- * Implements    : FLEXCAN_DRV_RxFifoBlocking_Activity
+ * Implements    : FLEXCAN_DRV_ConfigErrorManager_Activity
  *END**************************************************************************/
-status_t FLEXCAN_DRV_RxFifoBlocking(
-    uint8_t instance,
-    flexcan_msgbuff_t *data,
-    uint32_t timeout_ms)
+void FLEXCAN_DRV_ConfigErrorManager(uint8_t instance, const flexcan_error_config_t *config)
 {
     DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(config != NULL);
+    DEV_ASSERT(config->recoveryDelayMs <= config->maxRecoveryDelayMs);
 
-    status_t result;
-    flexcan_state_t * state = g_flexcanStatePtr[instance];
     CAN_Type * base = g_flexcanBase[instance];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    flexcan_error_manager_t * manager = &state->errorManager;
+    flexcan_fault_state_t previousState;
+    uint8_t * counterBytes = (uint8_t *)&manager->counters;
+    uint32_t i;
 
-    result = FLEXCAN_StartRxMessageFifoData(instance, data, true);
-
-    if (result == STATUS_SUCCESS)
-    {
-        result = OSIF_SemaWait(&state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].mbSema, timeout_ms);
+    FLEXCAN_EnterFreezeMode(base);
 
-        if (result == STATUS_TIMEOUT)
-        {
-            /* Disable RX FIFO interrupts*/
-            (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_FRAME_AVAILABLE, false);
-            (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_WARNING, false);
-            (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_OVERFLOW, false);
+    /* The error manager decides when the node leaves bus-off */
+    FLEXCAN_SetAutoBusOffRecovery(base, false);
+    FLEXCAN_SetErrIntCmd(base, FLEXCAN_INT_ERR, true);
+    FLEXCAN_SetErrIntCmd(base, FLEXCAN_INT_BUSOFF, true);
+    FLEXCAN_SetBusOffDoneIntCmd(base, true);
 
-            /* Disable error interrupts */
-            FLEXCAN_SetErrIntCmd(base,FLEXCAN_INT_ERR,false);
+    FLEXCAN_ExitFreezeMode(base);
 
-            result = STATUS_TIMEOUT;
-        }
+    INT_SYS_DisableIRQGlobal();
 
-        state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].state = FLEXCAN_MB_IDLE;
+    manager->config = *config;
+    for (i = 0U; i < sizeof(manager->counters); i++)
+    {
+        counterBytes[i] = 0U;
     }
+    manager->faultState = FLEXCAN_FAULT_ERROR_ACTIVE;
+    manager->recoveryDelay = config->recoveryDelayMs;
+    manager->recoveryRequested = false;
+    manager->activeStart = OSIF_GetMilliseconds();
+    manager->enabled = true;
 
-    return result;
+    /* Take the state the node is already in */
+    (void)FLEXCAN_UpdateFaultState(instance, &previousState);
+
+    INT_SYS_EnableIRQGlobal();
 }
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_DRV_RxFifo
- * Description   : This function receives a CAN frame using the Rx FIFO. The
- * function returns immediately. If a callback is installed, it will be invoked
- * after the frame was received and read into the specified buffer.
+ * Function Name : FLEXCAN_DRV_ErrorMainFunction
+ * Description   : Updates the fault confinement state, restarts the node once
+ * the bus-off recovery delay expired and resets the delay once the node stayed
+ * error-active long enough.
  *
- * Implements    : FLEXCAN_DRV_RxFifo_Activity
+ * Implements    : FLEXCAN_DRV_ErrorMainFunction_Activity
  *END**************************************************************************/
-status_t FLEXCAN_DRV_RxFifo(
-    uint8_t instance,
-    flexcan_msgbuff_t *data)
+void FLEXCAN_DRV_ErrorMainFunction(uint8_t instance)
 {
     DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
 
-    status_t result;
+    CAN_Type * base = g_flexcanBase[instance];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    flexcan_error_manager_t * manager = &state->errorManager;
+    flexcan_fault_state_t previousState;
+    bool changed;
+    uint32_t now;
 
-    result = FLEXCAN_StartRxMessageFifoData(instance, data, false);
+    DEV_ASSERT(manager->enabled);
 
-    return result;
-}
+    /* The interrupt handler also updates the state */
+    INT_SYS_DisableIRQGlobal();
 
-/*FUNCTION**********************************************************************
- *
- * Function Name : FLEXCAN_DRV_Deinit
- * Description   : Shutdown a FlexCAN module.
- * This function will disable all FlexCAN interrupts, and disable the FlexCAN.
- *
- * Implements    : FLEXCAN_DRV_Deinit_Activity
- *END**************************************************************************/
-status_t FLEXCAN_DRV_Deinit(uint8_t instance)
-{
-    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    changed = FLEXCAN_UpdateFaultState(instance, &previousState);
+    now = OSIF_GetMilliseconds();
 
-    const flexcan_state_t * state = g_flexcanStatePtr[instance];
-    status_t result = STATUS_SUCCESS;
-    status_t osifStat;
-    uint32_t i;
+    if ((manager->faultState == FLEXCAN_FAULT_BUS_OFF) && manager->config.autoRecovery &&
+        !manager->recoveryRequested && ((now - manager->busOffStart) >= manager->recoveryDelay))
+    {
+        manager->recoveryRequested = true;
+        FLEXCAN_SetAutoBusOffRecovery(base, true);
 
-    /* Disable FlexCAN interrupts.*/
-#if FEATURE_CAN_HAS_WAKE_UP_IRQ
-    if (g_flexcanWakeUpIrqId[instance] != NotAvail_IRQn)
+        /* Back off if the node goes bus-off again soon */
+        manager->recoveryDelay <<= 1U;
+        if (manager->recoveryDelay > manager->config.maxRecoveryDelayMs)
+        {
+            manager->recoveryDelay = manager->config.maxRecoveryDelayMs;
+        }
+    }
+    else if ((manager->faultState == FLEXCAN_FAULT_ERROR_ACTIVE) &&
+             ((now - manager->activeStart) >= manager->config.maxRecoveryDelayMs))
     {
-        INT_SYS_DisableIRQ(g_flexcanWakeUpIrqId[instance]);
+        manager->recoveryDelay = manager->config.recoveryDelayMs;
     }
-#endif
-    INT_SYS_DisableIRQ(g_flexcanErrorIrqId[instance]);
-    INT_SYS_DisableIRQ(g_flexcanBusOffIrqId[instance]);
-    for (i = 0; i < FEATURE_CAN_MB_IRQS_MAX_COUNT; i++)
+    else
     {
-        if (g_flexcanOredMessageBufferIrqId[i][instance] != NotAvail_IRQn)
-        {
-            INT_SYS_DisableIRQ(g_flexcanOredMessageBufferIrqId[i][instance]);
-        }
+        /* Nothing to do */
     }
 
-    /* Disable FlexCAN.*/
-    FLEXCAN_Disable(g_flexcanBase[instance]);
+    INT_SYS_EnableIRQGlobal();
 
-    for (i = 0; i < FEATURE_CAN_MAX_MB_NUM; i++)
+    if (changed && (manager->config.callback != NULL))
     {
-        osifStat = OSIF_SemaDestroy(&state->mbs[i].mbSema);
-        if (osifStat != STATUS_SUCCESS)
-        {
-            result = STATUS_ERROR;
-        }
+        manager->config.callback(instance, previousState, manager->faultState, manager->config.callbackParam);
     }
-
-    return result;
 }
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_DRV_SetTDCOffset
- * Description   : Enables/Disables the Transceiver Delay Compensation feature and sets
- * the Transceiver Delay Compensation Offset.
+ * Function Name : FLEXCAN_DRV_RecoverBusOff
+ * Description   : Lets the node leave bus-off, after 128 occurrences of 11
+ * consecutive recessive bits.
  *
- * Implements    : FLEXCAN_DRV_SetTDCOffset_Activity
+ * Implements    : FLEXCAN_DRV_RecoverBusOff_Activity
  *END**************************************************************************/
-void FLEXCAN_DRV_SetTDCOffset(uint8_t instance, bool enable, uint8_t offset)
+status_t FLEXCAN_DRV_RecoverBusOff(uint8_t instance)
 {
     DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
 
     CAN_Type * base = g_flexcanBase[instance];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    status_t result = STATUS_ERROR;
 
-    FLEXCAN_EnterFreezeMode(base);
-
-    /* Enable/Disable TDC and set the TDC Offset */
-    FLEXCAN_SetTDCOffset(base, enable, offset);
+    DEV_ASSERT(state->errorManager.enabled);
 
-    FLEXCAN_ExitFreezeMode(base);
-}
+    INT_SYS_DisableIRQGlobal();
 
-/*FUNCTION**********************************************************************
- *
- * Function Name : FLEXCAN_DRV_GetTDCValue
- * Description   : Gets the value of the Transceiver Delay Compensation.
- *
- * Implements    : FLEXCAN_DRV_GetTDCValue_Activity
- *END**************************************************************************/
-uint8_t FLEXCAN_DRV_GetTDCValue(uint8_t instance)
-{
-    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    if (state->errorManager.faultState == FLEXCAN_FAULT_BUS_OFF)
+    {
+        state->errorManager.recoveryRequested = true;
+        FLEXCAN_SetAutoBusOffRecovery(base, true);
+        result = STATUS_SUCCESS;
+    }
 
-    const CAN_Type * base = g_flexcanBase[instance];
+    INT_SYS_EnableIRQGlobal();
 
-    return (uint8_t)((base->FDCTRL & CAN_FDCTRL_TDCVAL_MASK) >> CAN_FDCTRL_TDCVAL_SHIFT);
+    return result;
 }
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_DRV_GetTDCFail
- * Description   : Gets the value of the TDC Fail flag.
+ * Function Name : FLEXCAN_DRV_GetFaultState
+ * Description   : Returns the fault confinement state seen at the last update
+ * of the error manager.
  *
- * Implements    : FLEXCAN_DRV_GetTDCFail_Activity
+ * Implements    : FLEXCAN_DRV_GetFaultState_Activity
  *END**************************************************************************/
-bool FLEXCAN_DRV_GetTDCFail(uint8_t instance)
+flexcan_fault_state_t FLEXCAN_DRV_GetFaultState(uint8_t instance)
 {
     DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
 
-    const CAN_Type * base = g_flexcanBase[instance];
+    const flexcan_state_t * state = g_flexcanStatePtr[instance];
 
-    return (((base->FDCTRL & CAN_FDCTRL_TDCFAIL_MASK) >> CAN_FDCTRL_TDCFAIL_SHIFT) != 0U);
+    return state->errorManager.faultState;
 }
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_DRV_ClearTDCFail
- * Description   : Clears the TDC Fail flag.
+ * Function Name : FLEXCAN_DRV_GetErrorCounters
+ * Description   : Copies the error counters of the node.
  *
- * Implements    : FLEXCAN_DRV_ClearTDCFail_Activity
+ * Implements    : FLEXCAN_DRV_GetErrorCounters_Activity
  *END**************************************************************************/
-void FLEXCAN_DRV_ClearTDCFail(uint8_t instance)
+void FLEXCAN_DRV_GetErrorCounters(uint8_t instance, flexcan_error_counters_t *counters)
 {
     DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(counters != NULL);
 
-    CAN_Type * base = g_flexcanBase[instance];
+    const flexcan_state_t * state = g_flexcanStatePtr[instance];
 
-    base->FDCTRL = base->FDCTRL | CAN_FDCTRL_TDCFAIL_MASK;
+    INT_SYS_DisableIRQGlobal();
+    *counters = state->errorManager.counters;
+    INT_SYS_EnableIRQGlobal();
 }
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_IRQHandler
- * Description   : Interrupt handler for FLEXCAN.
- * This handler read data from MB or FIFO, and then clear the interrupt flags.
- * This is not a public API as it is called whenever an interrupt occurs.
+ * Function Name : FLEXCAN_UpdateFaultState
+ * Description   : Reads ESR1 and ECR once: counts the error kinds flagged
+ * since the previous read, records the error counters and follows the fault
+ * confinement state. On the end of a bus-off, the node is held in bus-off
+ * again for the next one. Returns true if the state changed.
+ * This is not a public API as it is called from other driver functions.
  *
  *END**************************************************************************/
-void FLEXCAN_IRQHandler(uint8_t instance)
+static bool FLEXCAN_UpdateFaultState(uint8_t instance, flexcan_fault_state_t *previousState)
 {
     DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
 
-    uint32_t flag_reg = 0;
     CAN_Type * base = g_flexcanBase[instance];
     flexcan_state_t * state = g_flexcanStatePtr[instance];
-    status_t result = STATUS_SUCCESS;
+    flexcan_error_manager_t * manager = &state->errorManager;
+    flexcan_error_counters_t * counters = &manager->counters;
+    uint32_t esr = FLEXCAN_GetErrStatus(base);
+    uint32_t fltConf = (esr & CAN_ESR1_FLTCONF_MASK) >> CAN_ESR1_FLTCONF_SHIFT;
+    flexcan_fault_state_t newState;
+    uint32_t now;
+
+    if ((esr & (CAN_ESR1_BIT0ERR_MASK | CAN_ESR1_BIT1ERR_MASK)) != 0U)
+    {
+        counters->bitErrors++;
+    }
+    if ((esr & CAN_ESR1_STFERR_MASK) != 0U)
+    {
+        counters->stuffErrors++;
+    }
+    if ((esr & CAN_ESR1_CRCERR_MASK) != 0U)
+    {
+        counters->crcErrors++;
+    }
+    if ((esr & CAN_ESR1_FRMERR_MASK) != 0U)
+    {
+        counters->formErrors++;
+    }
+    if ((esr & CAN_ESR1_ACKERR_MASK) != 0U)
+    {
+        counters->ackErrors++;
+    }
 
-    /* Get the interrupts that are enabled and ready */
-    uint32_t mb_idx = 0;
-    flag_reg = FLEXCAN_GetMsgBuffIntStatusFlag(base, mb_idx);
+    counters->txErrorCount = FLEXCAN_GetTxErrorCounter(base);
+    counters->rxErrorCount = FLEXCAN_GetRxErrorCounter(base);
+    if (counters->txErrorCount > counters->txErrorPeak)
+    {
+        counters->txErrorPeak = counters->txErrorCount;
+    }
+    if (counters->rxErrorCount > counters->rxErrorPeak)
+    {
+        counters->rxErrorPeak = counters->rxErrorCount;
+    }
 
-    while ((flag_reg & 1U) == 0U)
+    if ((esr & CAN_ESR1_BOFFDONEINT_MASK) != 0U)
     {
-        mb_idx++;
-        flag_reg = FLEXCAN_GetMsgBuffIntStatusFlag(base, mb_idx);
+        FLEXCAN_ClearBusOffDoneIntStatusFlag(base);
+    }
 
-        if (mb_idx > FEATURE_CAN_MAX_MB_NUM)
-        {
-            break;
-        }
+    /* FLTCONF: 0 error-active, 1 error-passive, 2 or 3 bus-off */
+    if (fltConf == 0U)
+    {
+        newState = FLEXCAN_FAULT_ERROR_ACTIVE;
+    }
+    else if (fltConf == 1U)
+    {
+        newState = FLEXCAN_FAULT_ERROR_PASSIVE;
+    }
+    else
+    {
+        newState = FLEXCAN_FAULT_BUS_OFF;
     }
 
-    /* Check Tx/Rx interrupt flag and clear the interrupt */
-    if(flag_reg != 0U)
+    *previousState = manager->faultState;
+    if (newState == manager->faultState)
     {
-        bool rxfifoEnabled = FLEXCAN_IsRxFifoEnabled(base);
-        if ((mb_idx == FEATURE_CAN_RXFIFO_FRAME_AVAILABLE) && rxfifoEnabled)
-        {
-            if (state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].state == FLEXCAN_MB_RX_BUSY)
-            {
-                /* Get RX FIFO field values */
-                FLEXCAN_ReadRxFifo(base, state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].mb_message);
+        return false;
+    }
 
-                /* Complete receive data */
-                FLEXCAN_CompleteRxMessageFifoData(instance);
-                FLEXCAN_ClearMsgBuffIntStatusFlag(base, mb_idx);
+    now = OSIF_GetMilliseconds();
+    if (newState == FLEXCAN_FAULT_BUS_OFF)
+    {
+        counters->busOffCount++;
+        manager->busOffStart = now;
+        manager->recoveryRequested = false;
+    }
+    else if (manager->faultState == FLEXCAN_FAULT_BUS_OFF)
+    {
+        counters->lastBusOffTimeMs = now - manager->busOffStart;
+        counters->busOffTimeMs += counters->lastBusOffTimeMs;
+        manager->activeStart = now;
+        manager->recoveryRequested = false;
+        /* Hold the node in bus-off again the next time */
+        FLEXCAN_SetAutoBusOffRecovery(base, false);
+    }
+    else
+    {
+        /* Error-active and error-passive transitions only change the state */
+    }
 
-                /* Invoke callback */
-                if (state->callback != NULL)
-                {
-                    state->callback(instance,
-                    		        FLEXCAN_EVENT_RXFIFO_COMPLETE,
-									FLEXCAN_MB_HANDLE_RXFIFO,
-									state);
-                }
-            }
-        }
-        else
-        {
-            /* Check mailbox completed reception */
-            if (state->mbs[mb_idx].state == FLEXCAN_MB_RX_BUSY)
-            {
-                /* Lock RX message buffer and RX FIFO*/
-                result = FLEXCAN_LockRxMsgBuff(base, mb_idx);
-                if (result == STATUS_SUCCESS)
-                {
-                    /* Get RX MB field values*/
-                    result = FLEXCAN_GetMsgBuff(base, mb_idx, state->mbs[mb_idx].mb_message);
-                }
-                if (result == STATUS_SUCCESS)
-                {
-                    /* Unlock RX message buffer and RX FIFO*/
-                    FLEXCAN_UnlockRxMsgBuff(base);
+    if ((newState == FLEXCAN_FAULT_ERROR_PASSIVE) && (manager->faultState == FLEXCAN_FAULT_ERROR_ACTIVE))
+    {
+        counters->errorPassiveCount++;
+    }
+
+    manager->faultState = newState;
+
+    return true;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DisableErrInt
+ * Description   : Disables the error interrupt at the end of a transfer, unless
+ * the error manager keeps it enabled.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_DisableErrInt(uint8_t instance)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
 
-                    /* Complete receive data */
-                    FLEXCAN_CompleteTransfer(instance, mb_idx);
-                    FLEXCAN_ClearMsgBuffIntStatusFlag(base, mb_idx);
+    if (!g_flexcanStatePtr[instance]->errorManager.enabled)
+    {
+        FLEXCAN_SetErrIntCmd(g_flexcanBase[instance], FLEXCAN_INT_ERR, false);
+    }
+}
 
-                    /* Invoke callback */
-                    if (state->callback != NULL)
-                    {
-                        state->callback(instance, FLEXCAN_EVENT_RX_COMPLETE, mb_idx, state);
-                    }
-                }
-            }
-        }
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_InstallTimeBase
+ * Description   : Installs the time base used to extend the 16-bit timestamps
+ * of the received and sent frames to 64-bit times.
+ *
+ * Implements    : FLEXCAN_DRV_InstallTimeBase_Activity
+ *END**************************************************************************/
+void FLEXCAN_DRV_InstallTimeBase(uint8_t instance, const flexcan_time_base_t *timeBase)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT((timeBase == NULL) || (timeBase->getTime != NULL));
 
-        /* Check mailbox completed transmission */
-        if (state->mbs[mb_idx].state == FLEXCAN_MB_TX_BUSY)
-        {
-            /* Complete transmit data */
-            FLEXCAN_CompleteTransfer(instance, mb_idx);
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
 
-            if (state->mbs[mb_idx].isRemote)
-            {
-                /* If the frame was a remote frame, clear the flag only if the response was
-                 * not received yet. If the response was received, leave the flag set in order
-                 * to be handled when the user calls FLEXCAN_DRV_RxMessageBuffer. */
-                flexcan_msgbuff_t mb;
-                (void) FLEXCAN_LockRxMsgBuff(base, mb_idx);
-                (void) FLEXCAN_GetMsgBuff(base, mb_idx, &mb);
-                FLEXCAN_UnlockRxMsgBuff(base);
+    state->timeBase = timeBase;
+}
 
-                if (((mb.cs & CAN_CS_CODE_MASK) >> CAN_CS_CODE_SHIFT) == (uint32_t)FLEXCAN_RX_EMPTY)
-                {
-                    FLEXCAN_ClearMsgBuffIntStatusFlag(base, mb_idx);
-                }
-            }
-            else
-            {
-                FLEXCAN_ClearMsgBuffIntStatusFlag(base, mb_idx);
-            }
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_GetMsgBuffTimestamp
+ * Description   : Returns the time of the last frame received or sent by a
+ * message buffer.
+ *
+ * Implements    : FLEXCAN_DRV_GetMsgBuffTimestamp_Activity
+ *END**************************************************************************/
+uint64_t FLEXCAN_DRV_GetMsgBuffTimestamp(uint8_t instance, uint8_t mb_idx)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(mb_idx < FEATURE_CAN_MAX_MB_NUM);
 
-            /* Invoke callback */
-            if (state->callback != NULL)
-            {
-                state->callback(instance, FLEXCAN_EVENT_TX_COMPLETE, mb_idx, state);
-            }
-        }
-    }
+    const flexcan_state_t * state = g_flexcanStatePtr[instance];
+    uint64_t timestamp;
 
-    /* Clear all other interrupts in ERRSTAT register (Error, Busoff, Wakeup) */
-    FLEXCAN_ClearErrIntStatusFlag(base);
+    /* The interrupt handler updates the timestamp */
+    INT_SYS_DisableIRQGlobal();
+    timestamp = state->mbs[mb_idx].timestamp;
+    INT_SYS_EnableIRQGlobal();
 
-    return;
+    return timestamp;
 }
 
-#if FEATURE_CAN_HAS_WAKE_UP_IRQ
-
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_WakeUpHandler
- * Description   : Wake up handler for FLEXCAN.
- * This handler verifies the event which caused the wake up and invokes the
- * user callback, if configured.
- * This is not a public API as it is called whenever an wake up event occurs.
+ * Function Name : FLEXCAN_DRV_ConfigLatencyHistograms
+ * Description   : Clears the given latency histograms and starts recording the
+ * latency of the frames of the first count message buffers.
  *
+ * Implements    : FLEXCAN_DRV_ConfigLatencyHistograms_Activity
  *END**************************************************************************/
-void FLEXCAN_WakeUpHandler(uint8_t instance)
+void FLEXCAN_DRV_ConfigLatencyHistograms(
+    uint8_t instance,
+    flexcan_latency_hist_t *hist,
+    uint32_t count)
 {
     DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(count <= FEATURE_CAN_MAX_MB_NUM);
 
-    CAN_Type * base = g_flexcanBase[instance];
     flexcan_state_t * state = g_flexcanStatePtr[instance];
+    uint32_t i, bin;
 
-    /* Invoke callback */
-    if (state->callback != NULL)
+    for (i = 0U; (hist != NULL) && (i < count); i++)
     {
-#if FEATURE_CAN_HAS_PRETENDED_NETWORKING
-        if (FLEXCAN_IsPNEnabled(base))
-        {
-            if (FLEXCAN_GetWTOF(base) != 0U)
-            {
-                FLEXCAN_ClearWTOF(base);
-                state->callback(instance, FLEXCAN_EVENT_WAKEUP_TIMEOUT, 0U, state);
-            }
-            if (FLEXCAN_GetWUMF(base) != 0U)
-            {
-                FLEXCAN_ClearWUMF(base);
-                state->callback(instance, FLEXCAN_EVENT_WAKEUP_MATCH, 0U, state);
-            }
-        }
-#endif
-
-#if FEATURE_CAN_HAS_SELF_WAKE_UP
-        if (FLEXCAN_IsSelfWakeUpEnabled(base))
+        for (bin = 0U; bin < FLEXCAN_LATENCY_BINS; bin++)
         {
-            if (FLEXCAN_GetWAKINT(base) != 0U)
-            {
-                FLEXCAN_ClearWAKINT(base);
-                state->callback(instance, FLEXCAN_EVENT_SELF_WAKEUP, 0U, state);
-            }
+            hist[i].bins[bin] = 0U;
         }
-#endif
+        hist[i].count = 0U;
+        hist[i].maxLatency = 0U;
     }
+
+    INT_SYS_DisableIRQGlobal();
+    state->latencyHist = hist;
+    state->latencyHistCount = (hist != NULL) ? count : 0U;
+    INT_SYS_EnableIRQGlobal();
 }
-#endif /* FEATURE_CAN_HAS_WAKE_UP_IRQ */
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_DRV_GetTransferStatus
- * Description   : This function returns whether the previous FLEXCAN receive is
- *                 completed.
- * When performing a non-blocking receive, the user can call this function to
- * ascertain the state of the current receive progress: in progress (or busy)
- * or complete (success).
+ * Function Name : FLEXCAN_DRV_GetLatencyHistogram
+ * Description   : Copies the latency histogram of a message buffer, with the
+ * interrupts disabled so the copy is consistent.
  *
- * Implements    : FLEXCAN_DRV_GetTransferStatus_Activity
+ * Implements    : FLEXCAN_DRV_GetLatencyHistogram_Activity
  *END**************************************************************************/
-status_t FLEXCAN_DRV_GetTransferStatus(uint8_t instance, uint8_t mb_idx)
+status_t FLEXCAN_DRV_GetLatencyHistogram(
+    uint8_t instance,
+    uint8_t mb_idx,
+    flexcan_latency_hist_t *hist)
 {
     DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(hist != NULL);
 
     const flexcan_state_t * state = g_flexcanStatePtr[instance];
-    status_t status;
+    status_t result = STATUS_ERROR;
 
-    if (state->mbs[mb_idx].state == FLEXCAN_MB_IDLE)
-    {
-        status = STATUS_SUCCESS;
-    }
-    else
+    INT_SYS_DisableIRQGlobal();
+    if ((state->latencyHist != NULL) && (mb_idx < state->latencyHistCount))
     {
-        status = STATUS_BUSY;
+        *hist = state->latencyHist[mb_idx];
+        result = STATUS_SUCCESS;
     }
+    INT_SYS_EnableIRQGlobal();
 
-    return status;
+    return result;
 }
 
 /*FUNCTION**********************************************************************
@@ -1284,6 +3995,22 @@ status_t FLEXCAN_DRV_AbortTransfer(uint8_t instance, uint8_t mb_idx)
     DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
 
     const flexcan_state_t * state = g_flexcanStatePtr[instance];
+    volatile uint32_t *flexcan_mb;
+#if FEATURE_CAN_HAS_DMA_ENABLE
+    bool chainStopped = false;
+
+    /* The channel loads the MBs of the eDMA pool: the whole chain is ended */
+    if ((mb_idx >= state->txDma.firstMb) && ((uint32_t)mb_idx < ((uint32_t)state->txDma.firstMb + state->txDma.mbCount)))
+    {
+        INT_SYS_DisableIRQGlobal();
+        chainStopped = FLEXCAN_StopTxDma(instance);
+        INT_SYS_EnableIRQGlobal();
+    }
+    if (chainStopped)
+    {
+        return STATUS_SUCCESS;
+    }
+#endif
 
     /* Check if a transfer is running. */
     if (state->mbs[mb_idx].state == FLEXCAN_MB_IDLE)
@@ -1292,11 +4019,51 @@ status_t FLEXCAN_DRV_AbortTransfer(uint8_t instance, uint8_t mb_idx)
     }
 
     /* Stop the running transfer. */
-    FLEXCAN_CompleteTransfer(instance, mb_idx);
+    if (state->mbs[mb_idx].state == FLEXCAN_MB_RX_RING)
+    {
+        FLEXCAN_StopRxRing(instance, mb_idx);
+    }
+    else if (state->mbs[mb_idx].state == FLEXCAN_MB_TX_BUSY)
+    {
+        /* Deactivate the MB and drop a completion the frame already reported */
+        flexcan_mb = FLEXCAN_GetMsgBuffAddr(state, mb_idx);
+        *flexcan_mb = (*flexcan_mb & ~CAN_CS_CODE_MASK) | (((uint32_t)FLEXCAN_TX_INACTIVE << CAN_CS_CODE_SHIFT) & CAN_CS_CODE_MASK);
+        FLEXCAN_ClearMsgBuffIntStatusFlag(g_flexcanBase[instance], mb_idx);
+        FLEXCAN_CompleteTransfer(instance, mb_idx);
+    }
+    else
+    {
+        FLEXCAN_CompleteTransfer(instance, mb_idx);
+    }
+
+    /* A pool MB of the transmit queue goes on with the queued frames */
+    INT_SYS_DisableIRQGlobal();
+    FLEXCAN_KickTxQueue(instance);
+    INT_SYS_EnableIRQGlobal();
 
     return STATUS_SUCCESS;
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_GetMsgBuffAddr
+ * Description   : Returns the start address of a MB from the table computed at
+ * initialization, or NULL if the index is out of range.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static volatile uint32_t * FLEXCAN_GetMsgBuffAddr(const flexcan_state_t * state, uint32_t mb_idx)
+{
+    volatile uint32_t * mbAddr = NULL;
+
+    if (mb_idx < FEATURE_CAN_MAX_MB_NUM)
+    {
+        mbAddr = state->mbRegions[mb_idx];
+    }
+
+    return mbAddr;
+}
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : FLEXCAN_DRV_StartSendData
@@ -1329,6 +4096,10 @@ static status_t FLEXCAN_StartSendData(
     state->mbs[mb_idx].state = FLEXCAN_MB_TX_BUSY;
     state->mbs[mb_idx].isBlocking = isBlocking;
     state->mbs[mb_idx].isRemote = tx_info->is_remote;
+    if (state->timeBase != NULL)
+    {
+        state->mbs[mb_idx].startTime = state->timeBase->getTime(state->timeBase->param);
+    }
 
     cs.dataLen = tx_info->data_length;
     cs.msgIdType = tx_info->msg_id_type;
@@ -1344,7 +4115,7 @@ static status_t FLEXCAN_StartSendData(
     {
         cs.code = (uint32_t)FLEXCAN_TX_DATA;
     }
-    result = FLEXCAN_SetTxMsgBuff(base, mb_idx, &cs, msg_id, mb_data);
+    result = FLEXCAN_SetTxMsgBuff(base, mb_idx, FLEXCAN_GetMsgBuffAddr(state, mb_idx), &cs, msg_id, mb_data);
 
     if (result != STATUS_SUCCESS)
     {
@@ -1409,6 +4180,7 @@ static status_t FLEXCAN_StartRxMessageBufferData(
 static status_t FLEXCAN_StartRxMessageFifoData(
                     uint8_t instance,
                     flexcan_msgbuff_t *data,
+                    uint32_t batchSize,
                     bool isBlocking
                     )
 {
@@ -1437,6 +4209,7 @@ static status_t FLEXCAN_StartRxMessageFifoData(
 
     /* This will get filled by the interrupt handler */
     state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].mb_message = data;
+    state->rxFifoBatchSize = batchSize;
 
 #if FEATURE_CAN_HAS_DMA_ENABLE
     if (state->transferType == FLEXCAN_RXFIFO_USING_DMA)
@@ -1453,12 +4226,51 @@ static status_t FLEXCAN_StartRxMessageFifoData(
             return STATUS_ERROR;
         }
 
-        edmaStatus = EDMA_DRV_ConfigSingleBlockTransfer(state->rxFifoDMAChannel,
-                                                        EDMA_TRANSFER_MEM2MEM,
-                                                        (uint32_t)(base->RAMn),
-                                                        (uint32_t)(state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].mb_message),
-                                                        EDMA_TRANSFER_SIZE_4B,
-                                                        16U);
+        if (batchSize != 0U)
+        {
+            edma_loop_transfer_config_t loopConfig;
+            edma_transfer_config_t transferConfig;
+
+            /* Each DMA request moves the 16 bytes image of the FIFO output
+             * (CS, ID and the 8 data bytes) to the next 16 bytes of the buffer
+             * and rewinds the source, so the whole batch is a single major
+             * loop */
+            loopConfig.majorLoopIterationCount = batchSize;
+            loopConfig.srcOffsetEnable = true;
+            loopConfig.dstOffsetEnable = false;
+            loopConfig.minorLoopOffset = -16;
+            loopConfig.minorLoopChnLinkEnable = false;
+            loopConfig.minorLoopChnLinkNumber = 0U;
+            loopConfig.majorLoopChnLinkEnable = false;
+            loopConfig.majorLoopChnLinkNumber = 0U;
+
+            transferConfig.srcAddr = (uint32_t)(base->RAMn);
+            transferConfig.destAddr = (uint32_t)(state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].mb_message);
+            transferConfig.srcTransferSize = EDMA_TRANSFER_SIZE_4B;
+            transferConfig.destTransferSize = EDMA_TRANSFER_SIZE_4B;
+            transferConfig.srcOffset = 4;
+            transferConfig.destOffset = 4;
+            transferConfig.srcLastAddrAdjust = -16;
+            transferConfig.destLastAddrAdjust = 0;
+            transferConfig.srcModulo = EDMA_MODULO_OFF;
+            transferConfig.destModulo = EDMA_MODULO_OFF;
+            transferConfig.minorByteTransferCount = 16U;
+            transferConfig.scatterGatherEnable = false;
+            transferConfig.scatterGatherNextDescAddr = 0U;
+            transferConfig.interruptEnable = true;
+            transferConfig.loopTransferConfig = &loopConfig;
+
+            edmaStatus = EDMA_DRV_ConfigLoopTransfer(state->rxFifoDMAChannel, &transferConfig);
+        }
+        else
+        {
+            edmaStatus = EDMA_DRV_ConfigSingleBlockTransfer(state->rxFifoDMAChannel,
+                                                            EDMA_TRANSFER_MEM2MEM,
+                                                            (uint32_t)(base->RAMn),
+                                                            (uint32_t)(state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].mb_message),
+                                                            EDMA_TRANSFER_SIZE_4B,
+                                                            16U);
+        }
 
         if (edmaStatus != STATUS_SUCCESS)
         {
@@ -1475,116 +4287,344 @@ static status_t FLEXCAN_StartRxMessageFifoData(
     }
 #endif
 
-    /* Enable RX FIFO interrupts*/
-    (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_FRAME_AVAILABLE, true);
-    (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_WARNING, true);
-    (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_OVERFLOW, true);
+    /* Enable RX FIFO interrupts*/
+    (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_FRAME_AVAILABLE, true);
+    (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_WARNING, true);
+    (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_OVERFLOW, true);
+
+    /* Enable error interrupts */
+    FLEXCAN_SetErrIntCmd(base,FLEXCAN_INT_ERR,true);
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_CompleteTransfer
+ * Description   : Finish up a transmit by completing the process of sending
+ * data and disabling the interrupt.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_CompleteTransfer(uint8_t instance, uint32_t mb_idx)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    CAN_Type * base = g_flexcanBase[instance];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+
+    /* Disable the transmitter data register empty interrupt */
+    (void)FLEXCAN_SetMsgBuffIntCmd(base, mb_idx, false);
+    /* Disable error interrupts */
+    FLEXCAN_DisableErrInt(instance);
+
+    /* Update the information of the module driver state */
+    if (state->mbs[mb_idx].isBlocking)
+    {
+        (void)OSIF_SemaPost(&state->mbs[mb_idx].mbSema);
+    }
+    state->mbs[mb_idx].state = FLEXCAN_MB_IDLE;
+}
+
+#if FEATURE_CAN_HAS_DMA_ENABLE
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_CompleteRxFifoDataDMA
+ * Description   : Finish up a DMA transfer (this is just a wrapper over
+ * FLEXCAN_DRV_CompleteRxMessageFifoData).
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_CompleteRxFifoDataDMA(void *parameter, edma_chn_status_t status)
+{
+    uint32_t instance = (uint32_t)parameter;
+    (void)status;
+
+    FLEXCAN_CompleteRxMessageFifoData((uint8_t)instance);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_UnpackRxFifoDMAFrame
+ * Description   : Converts the MB image stored by the DMA channel into a
+ * FlexCAN message buffer. The image words are read before the message is
+ * written, so the image may overlap the message.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_UnpackRxFifoDMAFrame(flexcan_msgbuff_t *fifo_message, const uint32_t *mb_image)
+{
+    uint32_t cs = mb_image[0];
+    uint32_t msgId = mb_image[1];
+    uint32_t data0 = mb_image[2];
+    uint32_t data1 = mb_image[3];
+    uint32_t *msgData_32 = (uint32_t *)fifo_message->data;
+
+    /* Adjust the ID if it is not extended */
+    if ((cs & CAN_CS_IDE_MASK) == 0U)
+    {
+        msgId = msgId >> CAN_ID_STD_SHIFT;
+    }
+    fifo_message->cs = cs;
+    fifo_message->msgId = msgId;
+    /* Reverse the endianness */
+    FlexcanSwapBytesInWord(data0, msgData_32[0]);
+    FlexcanSwapBytesInWord(data1, msgData_32[1]);
+    /* Extract the data length */
+    fifo_message->dataLen = (uint8_t)((cs & CAN_CS_DLC_MASK) >> CAN_CS_DLC_SHIFT);
+}
+#endif
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_CompleteRxMessageFifoData
+ * Description   : Finish up a receive by completing the process of receiving
+ * data and disabling the interrupt.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_CompleteRxMessageFifoData(uint8_t instance)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    CAN_Type * base = g_flexcanBase[instance];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+
+    if (state->transferType == FLEXCAN_RXFIFO_USING_INTERRUPTS)
+    {
+        /* Disable RX FIFO interrupts*/
+        (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_FRAME_AVAILABLE, false);
+        (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_WARNING, false);
+        (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_OVERFLOW, false);
+
+        /* Disable error interrupts */
+        FLEXCAN_DisableErrInt(instance);
+    }
+#if FEATURE_CAN_HAS_DMA_ENABLE
+    else
+    {
+        flexcan_msgbuff_t *fifo_message = state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].mb_message;
+        const uint32_t *mb_images = (const uint32_t *)fifo_message;
+        uint32_t frame = state->rxFifoBatchSize;
+
+        (void) EDMA_DRV_StopChannel(state->rxFifoDMAChannel);
+        if (frame != 0U)
+        {
+            /* The DMA channel stored the batch as consecutive 16 bytes FIFO
+             * output images. Unpack them from the last one, as a message never
+             * overlaps the images placed before its own. */
+            while (frame > 0U)
+            {
+                frame--;
+                FLEXCAN_UnpackRxFifoDMAFrame(&fifo_message[frame], &mb_images[frame * 4U]);
+            }
+            FLEXCAN_StampRxFifoBatch(instance, fifo_message, state->rxFifoBatchSize);
+            *state->rxFifoBatchCount = state->rxFifoBatchSize;
+        }
+        else
+        {
+            FLEXCAN_UnpackRxFifoDMAFrame(fifo_message, mb_images);
+            FLEXCAN_StampRxFrame(instance, FLEXCAN_MB_HANDLE_RXFIFO, fifo_message);
+        }
+    }
+#endif
+    /* Clear fifo message*/
+    state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].mb_message = NULL;
+
+    /* Update status for receive by using fifo*/
+    if (state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].isBlocking)
+    {
+        (void)OSIF_SemaPost(&state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].mbSema);
+    }
+    state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].state = FLEXCAN_MB_IDLE;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ReadRxFifoBatch
+ * Description   : Reads the frames available in the Rx FIFO into the batch
+ * buffer, until the FIFO is empty or the batch is full. Clearing the frame
+ * available flag releases the FIFO output, so the flag is cleared after each
+ * frame and no frame is dropped when the batch fills up.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_ReadRxFifoBatch(uint8_t instance)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    CAN_Type * base = g_flexcanBase[instance];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    flexcan_msgbuff_t *frames = state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].mb_message;
+    uint32_t count = 0U;
 
-    /* Enable error interrupts */
-    FLEXCAN_SetErrIntCmd(base,FLEXCAN_INT_ERR,true);
+    do
+    {
+        FLEXCAN_ReadRxFifo(base, &frames[count]);
+        FLEXCAN_StampRxFrame(instance, FLEXCAN_MB_HANDLE_RXFIFO, &frames[count]);
+        count++;
+        FLEXCAN_ClearMsgBuffIntStatusFlag(base, FEATURE_CAN_RXFIFO_FRAME_AVAILABLE);
+    }
+    while ((count < state->rxFifoBatchSize) &&
+           (FLEXCAN_GetMsgBuffIntStatusFlag(base, FEATURE_CAN_RXFIFO_FRAME_AVAILABLE) != 0U));
 
-    return STATUS_SUCCESS;
+    *state->rxFifoBatchCount = count;
 }
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_DRV_CompleteTransfer
- * Description   : Finish up a transmit by completing the process of sending
- * data and disabling the interrupt.
+ * Function Name : FLEXCAN_CompleteRxRingMessageBuffer
+ * Description   : Appends the frame received in a message buffer to the ring of
+ * a continuous reception. The MB interrupt is left enabled so the MB keeps
+ * receiving; frames are dropped and counted when the ring is full.
  * This is not a public API as it is called from other driver functions.
  *
  *END**************************************************************************/
-static void FLEXCAN_CompleteTransfer(uint8_t instance, uint32_t mb_idx)
+static void FLEXCAN_CompleteRxRingMessageBuffer(uint8_t instance, uint32_t mb_idx)
 {
     DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
 
     CAN_Type * base = g_flexcanBase[instance];
     flexcan_state_t * state = g_flexcanStatePtr[instance];
+    volatile flexcan_rx_ring_t * ring = &state->mbs[mb_idx].rxRing;
+    uint32_t head = ring->head;
+    flexcan_msgbuff_t * frame;
+    flexcan_msgbuff_t discard;
+    bool ringFull = ((head - ring->tail) >= ring->size);
+    status_t result;
 
-    /* Disable the transmitter data register empty interrupt */
-    (void)FLEXCAN_SetMsgBuffIntCmd(base, mb_idx, false);
-    /* Disable error interrupts */
-    FLEXCAN_SetErrIntCmd(base,FLEXCAN_INT_ERR,false);
+    frame = ringFull ? &discard : &ring->buffer[head & (ring->size - 1U)];
 
-    /* Update the information of the module driver state */
-    if (state->mbs[mb_idx].isBlocking)
+    /* Lock RX message buffer and RX FIFO*/
+    result = FLEXCAN_LockRxMsgBuff(base, mb_idx, FLEXCAN_GetMsgBuffAddr(state, mb_idx));
+    if (result == STATUS_SUCCESS)
     {
-        (void)OSIF_SemaPost(&state->mbs[mb_idx].mbSema);
+        /* Get RX MB field values*/
+        result = FLEXCAN_GetMsgBuff(base, mb_idx, FLEXCAN_GetMsgBuffAddr(state, mb_idx), frame);
+    }
+    /* Unlock RX message buffer and RX FIFO*/
+    FLEXCAN_UnlockRxMsgBuff(base);
+    FLEXCAN_ClearMsgBuffIntStatusFlag(base, mb_idx);
+
+    if (result == STATUS_SUCCESS)
+    {
+        /* Frames overwritten in the MB before it was read are lost in hardware */
+        if (((frame->cs & CAN_CS_CODE_MASK) >> CAN_CS_CODE_SHIFT) == (uint32_t)FLEXCAN_RX_OVERRUN)
+        {
+            ring->hwOverruns++;
+        }
+
+        if (ringFull)
+        {
+            ring->ringOverflows++;
+        }
+        else
+        {
+            FLEXCAN_StampRxFrame(instance, mb_idx, frame);
+
+            /* Publish the frame to the consumer, once it is stored */
+            COMPILER_BARRIER();
+            ring->head = head + 1U;
+
+            /* Invoke callback */
+            if (state->callback != NULL)
+            {
+                state->callback(instance, FLEXCAN_EVENT_RX_COMPLETE, mb_idx, state);
+            }
+        }
     }
-    state->mbs[mb_idx].state = FLEXCAN_MB_IDLE;
 }
 
-#if FEATURE_CAN_HAS_DMA_ENABLE
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_DRV_CompleteRxFifoDataDMA
- * Description   : Finish up a DMA transfer (this is just a wrapper over
- * FLEXCAN_DRV_CompleteRxMessageFifoData).
+ * Function Name : FLEXCAN_CompleteRxRingFifo
+ * Description   : Moves the frame available in the Rx FIFO to the ring of a
+ * continuous reception, counts Rx FIFO overflows and clears the Rx FIFO
+ * interrupt flags. The Rx FIFO interrupts are left enabled.
  * This is not a public API as it is called from other driver functions.
  *
  *END**************************************************************************/
-static void FLEXCAN_CompleteRxFifoDataDMA(void *parameter, edma_chn_status_t status)
+static void FLEXCAN_CompleteRxRingFifo(uint8_t instance)
 {
-    uint32_t instance = (uint32_t)parameter;
-    (void)status;
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
 
-    FLEXCAN_CompleteRxMessageFifoData((uint8_t)instance);
+    CAN_Type * base = g_flexcanBase[instance];
+    flexcan_state_t * state = g_flexcanStatePtr[instance];
+    volatile flexcan_rx_ring_t * ring = &state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].rxRing;
+    uint32_t head = ring->head;
+    flexcan_msgbuff_t discard;
+
+    if (FLEXCAN_GetMsgBuffIntStatusFlag(base, FEATURE_CAN_RXFIFO_OVERFLOW) != 0U)
+    {
+        ring->hwOverruns++;
+        FLEXCAN_ClearMsgBuffIntStatusFlag(base, FEATURE_CAN_RXFIFO_OVERFLOW);
+    }
+    if (FLEXCAN_GetMsgBuffIntStatusFlag(base, FEATURE_CAN_RXFIFO_WARNING) != 0U)
+    {
+        FLEXCAN_ClearMsgBuffIntStatusFlag(base, FEATURE_CAN_RXFIFO_WARNING);
+    }
+
+    if (FLEXCAN_GetMsgBuffIntStatusFlag(base, FEATURE_CAN_RXFIFO_FRAME_AVAILABLE) != 0U)
+    {
+        /* The frame must be read out of the FIFO even if the ring is full */
+        if ((head - ring->tail) >= ring->size)
+        {
+            FLEXCAN_ReadRxFifo(base, &discard);
+            ring->ringOverflows++;
+            FLEXCAN_ClearMsgBuffIntStatusFlag(base, FEATURE_CAN_RXFIFO_FRAME_AVAILABLE);
+        }
+        else
+        {
+            FLEXCAN_ReadRxFifo(base, &ring->buffer[head & (ring->size - 1U)]);
+            FLEXCAN_ClearMsgBuffIntStatusFlag(base, FEATURE_CAN_RXFIFO_FRAME_AVAILABLE);
+            FLEXCAN_StampRxFrame(instance, FLEXCAN_MB_HANDLE_RXFIFO, &ring->buffer[head & (ring->size - 1U)]);
+
+            /* Publish the frame to the consumer, once it is stored */
+            COMPILER_BARRIER();
+            ring->head = head + 1U;
+
+            /* Invoke callback */
+            if (state->callback != NULL)
+            {
+                state->callback(instance,
+                                FLEXCAN_EVENT_RXFIFO_COMPLETE,
+                                FLEXCAN_MB_HANDLE_RXFIFO,
+                                state);
+            }
+        }
+    }
 }
-#endif
 
 /*FUNCTION**********************************************************************
  *
- * Function Name : FLEXCAN_DRV_CompleteRxMessageFifoData
- * Description   : Finish up a receive by completing the process of receiving
- * data and disabling the interrupt.
+ * Function Name : FLEXCAN_StopRxRing
+ * Description   : Stops a continuous reception by disabling the MB (or Rx FIFO)
+ * interrupts. Frames still in the ring can be read afterwards.
  * This is not a public API as it is called from other driver functions.
  *
  *END**************************************************************************/
-static void FLEXCAN_CompleteRxMessageFifoData(uint8_t instance)
+static void FLEXCAN_StopRxRing(uint8_t instance, uint32_t mb_idx)
 {
     DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
 
     CAN_Type * base = g_flexcanBase[instance];
     flexcan_state_t * state = g_flexcanStatePtr[instance];
 
-    if (state->transferType == FLEXCAN_RXFIFO_USING_INTERRUPTS)
+    if ((mb_idx == FLEXCAN_MB_HANDLE_RXFIFO) && FLEXCAN_IsRxFifoEnabled(base))
     {
         /* Disable RX FIFO interrupts*/
         (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_FRAME_AVAILABLE, false);
         (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_WARNING, false);
         (void)FLEXCAN_SetMsgBuffIntCmd(base, FEATURE_CAN_RXFIFO_OVERFLOW, false);
-
-        /* Disable error interrupts */
-        FLEXCAN_SetErrIntCmd(base,FLEXCAN_INT_ERR,false);
     }
-#if FEATURE_CAN_HAS_DMA_ENABLE
     else
     {
-        flexcan_msgbuff_t *fifo_message = state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].mb_message;
-        uint32_t *msgData_32 = (uint32_t *)fifo_message->data;
-
-        (void) EDMA_DRV_StopChannel(state->rxFifoDMAChannel);
-        /* Adjust the ID if it is not extended */
-        if (((fifo_message->cs) & CAN_CS_IDE_MASK) == 0U)
-        {
-            fifo_message->msgId = fifo_message->msgId  >> CAN_ID_STD_SHIFT;
-        }
-        /* Extract the data length */
-        fifo_message->dataLen = (uint8_t)((fifo_message->cs & CAN_CS_DLC_MASK) >> CAN_CS_DLC_SHIFT);
-        /* Reverse the endianness */
-        FlexcanSwapBytesInWord(msgData_32[0], msgData_32[0]);
-        FlexcanSwapBytesInWord(msgData_32[1], msgData_32[1]);
+        (void)FLEXCAN_SetMsgBuffIntCmd(base, mb_idx, false);
     }
-#endif
-    /* Clear fifo message*/
-    state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].mb_message = NULL;
+    /* Disable error interrupts */
+    FLEXCAN_DisableErrInt(instance);
 
-    /* Update status for receive by using fifo*/
-    if (state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].isBlocking)
-    {
-        (void)OSIF_SemaPost(&state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].mbSema);
-    }
-    state->mbs[FLEXCAN_MB_HANDLE_RXFIFO].state = FLEXCAN_MB_IDLE;
+    state->mbs[mb_idx].state = FLEXCAN_MB_IDLE;
 }
 
 /*FUNCTION**********************************************************************
@@ -1673,6 +4713,366 @@ void FLEXCAN_DRV_GetWMB(uint8_t instance, uint8_t wmbIndex, flexcan_msgbuff_t *w
     wmb->dataLen = (uint8_t)((wmb->cs & CAN_CS_DLC_MASK) >> 16);
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_CompilePNWakeRules
+ * Description   : Compiles wake rules into a Pretended Networking
+ * configuration. The ID filter is the smaller of the range spanning all the
+ * rules and of the exact match masking the ID bits which vary between them;
+ * the payload filter keeps the payload bits all the rules compare to the same
+ * value.
+ *
+ * Implements    : FLEXCAN_DRV_CompilePNWakeRules_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_CompilePNWakeRules(const flexcan_pn_wake_rule_t *rules,
+                                        uint32_t ruleCount,
+                                        uint16_t matchTimeout,
+                                        flexcan_pn_config_t *pnConfig,
+                                        bool *exact)
+{
+    DEV_ASSERT(rules != NULL);
+    DEV_ASSERT(ruleCount != 0U);
+    DEV_ASSERT(pnConfig != NULL);
+    DEV_ASSERT(exact != NULL);
+
+    bool extendedId = rules[0].extendedId;
+    uint32_t idMask = extendedId ? (CAN_ID_EXT_MASK | CAN_ID_STD_MASK) : (CAN_ID_STD_MASK >> CAN_ID_STD_SHIFT);
+    uint32_t idLow = rules[0].idLow;
+    uint32_t idHigh = rules[0].idHigh;
+    uint32_t varyingBits = 0U;
+    uint32_t spread;
+    uint32_t rangeCount;
+    uint32_t maskCount = 1U;
+    uint32_t filterCount;
+    bool anyPayload = false;
+    bool payloadExact = true;
+    bool ruleChecksPayload;
+    uint32_t i;
+    uint32_t byteIdx;
+
+    pnConfig->payloadFilter.dlcLow = rules[0].dlcLow;
+    pnConfig->payloadFilter.dlcHigh = rules[0].dlcHigh;
+    for (byteIdx = 0U; byteIdx < 8U; byteIdx++)
+    {
+        pnConfig->payloadFilter.payload2[byteIdx] = rules[0].payloadMask[byteIdx];
+    }
+
+    for (i = 0U; i < ruleCount; i++)
+    {
+        DEV_ASSERT((rules[i].idLow <= rules[i].idHigh) && (rules[i].idHigh <= idMask));
+        DEV_ASSERT((rules[i].dlcLow <= rules[i].dlcHigh) && (rules[i].dlcHigh <= 8U));
+
+        if (rules[i].extendedId != extendedId)
+        {
+            return STATUS_ERROR;
+        }
+
+        /* ID bits which vary inside the range of the rule or from the first rule */
+        spread = rules[i].idLow ^ rules[i].idHigh;
+        spread |= spread >> 1U;
+        spread |= spread >> 2U;
+        spread |= spread >> 4U;
+        spread |= spread >> 8U;
+        spread |= spread >> 16U;
+        varyingBits |= spread | (rules[i].idLow ^ rules[0].idLow);
+        if (rules[i].idLow < idLow)
+        {
+            idLow = rules[i].idLow;
+        }
+        if (rules[i].idHigh > idHigh)
+        {
+            idHigh = rules[i].idHigh;
+        }
+
+        /* Payload bits compared to the same value by all the rules */
+        ruleChecksPayload = false;
+        for (byteIdx = 0U; byteIdx < 8U; byteIdx++)
+        {
+            if (rules[i].payloadMask[byteIdx] != 0U)
+            {
+                if (byteIdx >= rules[i].dlcLow)
+                {
+                    return STATUS_ERROR;
+                }
+                ruleChecksPayload = true;
+            }
+            if ((rules[i].payloadMask[byteIdx] != rules[0].payloadMask[byteIdx]) ||
+                (((rules[i].payloadValue[byteIdx] ^ rules[0].payloadValue[byteIdx]) & rules[i].payloadMask[byteIdx]) != 0U))
+            {
+                payloadExact = false;
+            }
+            pnConfig->payloadFilter.payload2[byteIdx] &=
+                (uint8_t)(rules[i].payloadMask[byteIdx] & ~(rules[i].payloadValue[byteIdx] ^ rules[0].payloadValue[byteIdx]));
+        }
+        if (!ruleChecksPayload && (rules[i].dlcLow == 0U) && (rules[i].dlcHigh == 8U))
+        {
+            anyPayload = true;
+        }
+        if ((rules[i].dlcLow != rules[0].dlcLow) || (rules[i].dlcHigh != rules[0].dlcHigh))
+        {
+            payloadExact = false;
+        }
+        if (rules[i].dlcLow < pnConfig->payloadFilter.dlcLow)
+        {
+            pnConfig->payloadFilter.dlcLow = rules[i].dlcLow;
+        }
+        if (rules[i].dlcHigh > pnConfig->payloadFilter.dlcHigh)
+        {
+            pnConfig->payloadFilter.dlcHigh = rules[i].dlcHigh;
+        }
+    }
+
+    pnConfig->wakeUpTimeout = (matchTimeout != 0U);
+    pnConfig->wakeUpMatch = true;
+    pnConfig->numMatches = 1U;
+    pnConfig->matchTimeout = matchTimeout;
+
+    /* Data frames only */
+    pnConfig->idFilter1.extendedId = extendedId;
+    pnConfig->idFilter1.remoteFrame = false;
+
+    rangeCount = idHigh - idLow + 1U;
+    for (spread = varyingBits; spread != 0U; spread &= spread - 1U)
+    {
+        maskCount <<= 1U;
+    }
+
+    if (maskCount < rangeCount)
+    {
+        pnConfig->idFilterType = FLEXCAN_FILTER_MATCH_EXACT;
+        pnConfig->idFilter1.id = idLow & ~varyingBits;
+        /* The mask is given in the extended ID layout, so the IDE and RTR bits
+         * are compared for standard IDs too */
+        pnConfig->idFilter2.extendedId = true;
+        pnConfig->idFilter2.remoteFrame = true;
+        pnConfig->idFilter2.id = extendedId ? (~varyingBits & idMask) : ((~varyingBits & idMask) << CAN_ID_STD_SHIFT);
+        filterCount = maskCount;
+    }
+    else
+    {
+        pnConfig->idFilterType = FLEXCAN_FILTER_MATCH_RANGE;
+        pnConfig->idFilter1.id = idLow;
+        pnConfig->idFilter2.extendedId = extendedId;
+        pnConfig->idFilter2.remoteFrame = false;
+        pnConfig->idFilter2.id = idHigh;
+        filterCount = rangeCount;
+    }
+
+    if (anyPayload)
+    {
+        /* One of the rules accepts any payload */
+        pnConfig->filterComb = FLEXCAN_FILTER_ID;
+        pnConfig->payloadFilterType = FLEXCAN_FILTER_MATCH_EXACT;
+        pnConfig->payloadFilter.dlcLow = 0U;
+        pnConfig->payloadFilter.dlcHigh = 8U;
+        for (byteIdx = 0U; byteIdx < 8U; byteIdx++)
+        {
+            pnConfig->payloadFilter.payload1[byteIdx] = 0U;
+            pnConfig->payloadFilter.payload2[byteIdx] = 0U;
+        }
+    }
+    else
+    {
+        pnConfig->filterComb = FLEXCAN_FILTER_ID_PAYLOAD;
+        pnConfig->payloadFilterType = FLEXCAN_FILTER_MATCH_EXACT;
+        for (byteIdx = 0U; byteIdx < 8U; byteIdx++)
+        {
+            pnConfig->payloadFilter.payload1[byteIdx] =
+                (uint8_t)(rules[0].payloadValue[byteIdx] & pnConfig->payloadFilter.payload2[byteIdx]);
+        }
+    }
+
+    /* The filter is exact if it accepts as many IDs as the rules, all with the same payload condition */
+    *exact = payloadExact && (filterCount == FLEXCAN_CountPNWakeIds(rules, ruleCount));
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_IsPNWakeRuleMatched
+ * Description   : Checks whether a classical data frame matches one of the
+ * wake rules.
+ *
+ * Implements    : FLEXCAN_DRV_IsPNWakeRuleMatched_Activity
+ *END**************************************************************************/
+bool FLEXCAN_DRV_IsPNWakeRuleMatched(const flexcan_pn_wake_rule_t *rules,
+                                     uint32_t ruleCount,
+                                     const flexcan_msgbuff_t *frame)
+{
+    DEV_ASSERT(rules != NULL);
+    DEV_ASSERT(frame != NULL);
+
+    bool isExtended = ((frame->cs & CAN_CS_IDE_MASK) != 0U);
+    bool matched = false;
+    bool ruleMatched;
+    uint32_t i;
+    uint32_t byteIdx;
+
+    if ((frame->cs & CAN_CS_RTR_MASK) != 0U)
+    {
+        return false;
+    }
+
+    for (i = 0U; (i < ruleCount) && !matched; i++)
+    {
+        ruleMatched = (rules[i].extendedId == isExtended) &&
+                      (frame->msgId >= rules[i].idLow) && (frame->msgId <= rules[i].idHigh) &&
+                      (frame->dataLen >= rules[i].dlcLow) && (frame->dataLen <= rules[i].dlcHigh);
+        for (byteIdx = 0U; (byteIdx < 8U) && ruleMatched; byteIdx++)
+        {
+            if (((frame->data[byteIdx] ^ rules[i].payloadValue[byteIdx]) & rules[i].payloadMask[byteIdx]) != 0U)
+            {
+                ruleMatched = false;
+            }
+        }
+        matched = ruleMatched;
+    }
+
+    return matched;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_GetWakeUpFrames
+ * Description   : Reads the frames stored in the wake up message buffers.
+ *
+ * Implements    : FLEXCAN_DRV_GetWakeUpFrames_Activity
+ *END**************************************************************************/
+uint8_t FLEXCAN_DRV_GetWakeUpFrames(uint8_t instance, flexcan_msgbuff_t *frames)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(frames != NULL);
+
+    const CAN_Type * base = g_flexcanBase[instance];
+    uint8_t count = FLEXCAN_GetPNMatchCount(base);
+    uint8_t i;
+
+    if (count > CAN_WMB_COUNT)
+    {
+        count = CAN_WMB_COUNT;
+    }
+
+    for (i = 0U; i < count; i++)
+    {
+        FLEXCAN_DRV_GetWMB(instance, i, &frames[i]);
+    }
+
+    return count;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_DRV_PNPowerCallback
+ * Description   : Power manager callback enabling Pretended Networking before
+ * the system enters a stop mode and disabling it once the system is back in a
+ * run mode, or if the mode change was aborted.
+ *
+ * Implements    : FLEXCAN_DRV_PNPowerCallback_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_DRV_PNPowerCallback(power_manager_notify_struct_t *notify,
+                                     power_manager_callback_data_t *dataPtr)
+{
+    DEV_ASSERT(notify != NULL);
+    DEV_ASSERT(dataPtr != NULL);
+
+    const flexcan_pn_power_config_t *pnPower = (const flexcan_pn_power_config_t *)dataPtr;
+
+    if (FLEXCAN_IsPNStopMode(notify->targetPowerConfigPtr->powerMode))
+    {
+        if (notify->notifyType == POWER_MANAGER_NOTIFY_BEFORE)
+        {
+            FLEXCAN_DRV_ConfigPN(pnPower->instance, true, pnPower->pnConfig);
+        }
+        else
+        {
+            /* Woken up, or the stop mode was not entered */
+            FLEXCAN_DRV_ConfigPN(pnPower->instance, false, pnPower->pnConfig);
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_CountPNWakeIds
+ * Description   : Returns the number of IDs accepted by the wake rules,
+ * counting the IDs of overlapping rules once.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static uint32_t FLEXCAN_CountPNWakeIds(const flexcan_pn_wake_rule_t *rules, uint32_t ruleCount)
+{
+    uint32_t count = 0U;
+    uint32_t next = 0U;
+    uint32_t start;
+    uint32_t end;
+    bool found = true;
+    bool extended;
+    uint32_t i;
+
+    while (found)
+    {
+        /* Start of the next run of IDs, at or above the first ID not counted yet */
+        found = false;
+        start = 0U;
+        for (i = 0U; i < ruleCount; i++)
+        {
+            if (rules[i].idHigh >= next)
+            {
+                if (!found || (rules[i].idLow < start))
+                {
+                    start = (rules[i].idLow > next) ? rules[i].idLow : next;
+                    found = true;
+                }
+            }
+        }
+
+        if (found)
+        {
+            /* Extend the run with the rules touching it */
+            end = start;
+            extended = true;
+            while (extended)
+            {
+                extended = false;
+                for (i = 0U; i < ruleCount; i++)
+                {
+                    if ((rules[i].idLow <= (end + 1U)) && (rules[i].idHigh > end))
+                    {
+                        end = rules[i].idHigh;
+                        extended = true;
+                    }
+                }
+            }
+            count += end - start + 1U;
+            next = end + 1U;
+        }
+    }
+
+    return count;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_IsPNStopMode
+ * Description   : Returns whether a power mode stops the FlexCAN clocks, so
+ * Pretended Networking is needed to wake the system up.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static bool FLEXCAN_IsPNStopMode(power_manager_modes_t mode)
+{
+    bool stopMode = (mode == POWER_MANAGER_VLPS);
+
+#if FEATURE_SMC_HAS_STOPO
+    stopMode = stopMode || (mode == POWER_MANAGER_STOP1) || (mode == POWER_MANAGER_STOP2);
+#endif
+
+    return stopMode;
+}
+
 #endif /* FEATURE_CAN_HAS_PRETENDED_NETWORKING */
 
 #if FEATURE_CAN_HAS_SELF_WAKE_UP
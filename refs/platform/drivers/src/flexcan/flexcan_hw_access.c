@@ -205,6 +205,41 @@ static volatile uint32_t* FLEXCAN_GetMsgBuffRegion(
     return &(base->RAMn[mb_index]);
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_InitMsgBuffRegions
+ * Description   : Computes the start address of every MB for the current
+ * payload size. MBs that do not fit in the FlexCAN RAM get a NULL address.
+ *
+ *END**************************************************************************/
+void FLEXCAN_InitMsgBuffRegions(
+        CAN_Type * base,
+        volatile uint32_t **mbRegions,
+        uint32_t count)
+{
+    DEV_ASSERT(mbRegions != NULL);
+
+    uint32_t msgBuffIdx;
+    uint8_t can_real_payload = FLEXCAN_GetPayloadSize(base);
+    uint32_t mb_size = (uint32_t)FLEXCAN_ARBITRATION_FIELD_SIZE + can_real_payload;
+    uint32_t mbsPerBlock = 512U / mb_size;
+    uint32_t max_mb_num = (FLEXCAN_GetMaxMbNum(base) * FLEXCAN_8_BYTE_PAYLOAD_MB_SIZE) / mb_size;
+
+    for (msgBuffIdx = 0U; msgBuffIdx < count; msgBuffIdx++)
+    {
+        if (msgBuffIdx < max_mb_num)
+        {
+            /* Same layout as FLEXCAN_GetMsgBuffRegion: 128 words per RAM block */
+            mbRegions[msgBuffIdx] = &(base->RAMn[(128U * (msgBuffIdx / mbsPerBlock)) +
+                                                 ((msgBuffIdx % mbsPerBlock) * (mb_size >> 2U))]);
+        }
+        else
+        {
+            mbRegions[msgBuffIdx] = NULL;
+        }
+    }
+}
+
 /*FUNCTION**********************************************************************
  *
  * Function Name: FLEXCAN_ComputeDLCValue
@@ -483,6 +518,7 @@ void FLEXCAN_Init(CAN_Type * base)
 status_t FLEXCAN_SetTxMsgBuff(
     CAN_Type * base,
     uint32_t msgBuffIdx,
+    volatile uint32_t *flexcan_mb,
     const flexcan_msgbuff_code_status_t *cs,
     uint32_t msgId,
     const uint8_t *msgData)
@@ -495,8 +531,6 @@ status_t FLEXCAN_SetTxMsgBuff(
     uint8_t dlc_value;
     status_t stat = STATUS_SUCCESS;
 
-    volatile uint32_t *flexcan_mb = FLEXCAN_GetMsgBuffRegion(base, msgBuffIdx);
-
     volatile uint32_t *flexcan_mb_id   = &flexcan_mb[1];
     volatile uint8_t  *flexcan_mb_data = (volatile uint8_t *)(&flexcan_mb[2]);
     volatile uint32_t *flexcan_mb_data_32 = &flexcan_mb[2];
@@ -535,7 +569,37 @@ status_t FLEXCAN_SetTxMsgBuff(
         dlc_value = FLEXCAN_ComputeDLCValue((uint8_t)cs->dataLen);
 
         /* Copy user's buffer into the message buffer data area */
-        if (msgData != NULL)
+        if ((msgData != NULL) && ((((uint32_t)msgData) & 3U) == 0U))
+        {
+            uint8_t payload_size = FLEXCAN_ComputePayloadSize(dlc_value);
+            uint32_t padWord = (uint32_t)cs->fd_padding * 0x01010101U;
+            uint32_t mbWord;
+            uint32_t tailByte;
+
+            /* Aligned buffer: only whole words are written to the MB */
+            for (databyte = 0; databyte < (cs->dataLen & ~3U); databyte += 4U)
+            {
+                FlexcanSwapBytesInWord(msgData_32[databyte >> 2U], flexcan_mb_data_32[databyte >> 2U]);
+            }
+            if (databyte < cs->dataLen)
+            {
+                /* Merge the last bytes with the padding, byte 0 is the most significant one */
+                mbWord = padWord;
+                for (tailByte = 0U; (databyte + tailByte) < cs->dataLen; tailByte++)
+                {
+                    mbWord &= ~((uint32_t)0xFFU << (24U - (tailByte << 3U)));
+                    mbWord |= (uint32_t)msgData[databyte + tailByte] << (24U - (tailByte << 3U));
+                }
+                flexcan_mb_data_32[databyte >> 2U] = mbWord;
+                databyte += 4U;
+            }
+            /* Add padding, if needed */
+            for ( ; databyte < payload_size; databyte += 4U)
+            {
+                flexcan_mb_data_32[databyte >> 2U] = padWord;
+            }
+        }
+        else if (msgData != NULL)
         {
             uint8_t payload_size = FLEXCAN_ComputePayloadSize(dlc_value);
             for (databyte = 0; databyte < (cs->dataLen & ~3U); databyte += 4U)
@@ -580,6 +644,9 @@ status_t FLEXCAN_SetTxMsgBuff(
             flexcan_mb_config &= ~(CAN_CS_IDE_MASK | CAN_CS_SRR_MASK);
         }
 
+        /* Local priority, only taken into account when MCR[LPRIOEN] is set */
+        *flexcan_mb_id |= msgId & CAN_ID_PRIO_MASK;
+
         /* Set the length of data in bytes */
         flexcan_mb_config &= ~CAN_CS_DLC_MASK;
         flexcan_mb_config |= ((uint32_t)dlc_value << CAN_CS_DLC_SHIFT) & CAN_CS_DLC_MASK;
@@ -618,6 +685,75 @@ status_t FLEXCAN_SetTxMsgBuff(
     return stat;
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_BuildTxMsgBuffImage
+ * Description   : Builds in memory the words a transmission writes into a
+ * message buffer: the CODE/status word, the ID word and the payload words in
+ * the MB byte order, padded up to the payload size given by the DLC.
+ *
+ *END**************************************************************************/
+uint32_t FLEXCAN_BuildTxMsgBuffImage(
+    const flexcan_msgbuff_code_status_t *cs,
+    uint32_t msgId,
+    const uint8_t *msgData,
+    uint32_t *image)
+{
+    DEV_ASSERT(cs != NULL);
+    DEV_ASSERT(image != NULL);
+    DEV_ASSERT(cs->dataLen <= 64U);
+
+    uint8_t dlc_value = FLEXCAN_ComputeDLCValue((uint8_t)cs->dataLen);
+    uint32_t payload_words = ((uint32_t)FLEXCAN_ComputePayloadSize(dlc_value) + 3U) >> 2U;
+    uint32_t padWord = (uint32_t)cs->fd_padding * 0x01010101U;
+    uint32_t flexcan_mb_config = 0U;
+    uint32_t databyte;
+    uint32_t word;
+
+    /* Payload words, byte 0 is the most significant one */
+    for (word = 0U; word < payload_words; word++)
+    {
+        image[2U + word] = padWord;
+    }
+    for (databyte = 0U; (msgData != NULL) && (databyte < cs->dataLen); databyte++)
+    {
+        word = databyte >> 2U;
+        image[2U + word] &= ~((uint32_t)0xFFU << (24U - ((databyte & 3U) << 3U)));
+        image[2U + word] |= (uint32_t)msgData[databyte] << (24U - ((databyte & 3U) << 3U));
+    }
+
+    /* ID word, including the local priority */
+    if (cs->msgIdType == FLEXCAN_MSG_ID_EXT)
+    {
+        image[1] = msgId & (CAN_ID_STD_MASK | CAN_ID_EXT_MASK);
+        flexcan_mb_config |= CAN_CS_IDE_MASK;
+    }
+    else
+    {
+        image[1] = (msgId << CAN_ID_STD_SHIFT) & CAN_ID_STD_MASK;
+    }
+    image[1] |= msgId & CAN_ID_PRIO_MASK;
+
+    /* CODE/status word */
+    flexcan_mb_config |= ((uint32_t)dlc_value << CAN_CS_DLC_SHIFT) & CAN_CS_DLC_MASK;
+    if (cs->code == (uint32_t)FLEXCAN_TX_REMOTE)
+    {
+        flexcan_mb_config |= CAN_CS_RTR_MASK;
+    }
+    flexcan_mb_config |= (cs->code << CAN_CS_CODE_SHIFT) & CAN_CS_CODE_MASK;
+    if (cs->fd_enable)
+    {
+        flexcan_mb_config |= CAN_MB_EDL_MASK;
+    }
+    if (cs->enable_brs)
+    {
+        flexcan_mb_config |= CAN_MB_BRS_MASK;
+    }
+    image[0] = flexcan_mb_config;
+
+    return 2U + payload_words;
+}
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : FLEXCAN_SetRxMsgBuff
@@ -631,6 +767,7 @@ status_t FLEXCAN_SetTxMsgBuff(
 status_t FLEXCAN_SetRxMsgBuff(
     CAN_Type * base,
     uint32_t msgBuffIdx,
+    volatile uint32_t *flexcan_mb,
     const flexcan_msgbuff_code_status_t *cs,
     uint32_t msgId)
 {
@@ -638,7 +775,6 @@ status_t FLEXCAN_SetRxMsgBuff(
 
     uint32_t val1, val2 = 1;
 
-    volatile uint32_t *flexcan_mb = FLEXCAN_GetMsgBuffRegion(base, msgBuffIdx);
     volatile uint32_t *flexcan_mb_id = &flexcan_mb[1];
     status_t stat = STATUS_SUCCESS;
 
@@ -716,6 +852,7 @@ status_t FLEXCAN_SetRxMsgBuff(
 status_t FLEXCAN_GetMsgBuff(
     CAN_Type * base,
     uint32_t msgBuffIdx,
+    volatile const uint32_t *flexcan_mb,
     flexcan_msgbuff_t *msgBuff)
 {
     DEV_ASSERT(msgBuff != NULL);
@@ -724,17 +861,12 @@ status_t FLEXCAN_GetMsgBuff(
     uint32_t val1, val2 = 1;
     status_t stat = STATUS_SUCCESS;
 
-    volatile const uint32_t *flexcan_mb = FLEXCAN_GetMsgBuffRegion(base, msgBuffIdx);
     volatile const uint32_t *flexcan_mb_id   = &flexcan_mb[1];
-    volatile const uint8_t  *flexcan_mb_data = (volatile const uint8_t *)(&flexcan_mb[2]);
     volatile const uint32_t *flexcan_mb_data_32 = &flexcan_mb[2];
     uint32_t *msgBuff_data_32 = (uint32_t *)(msgBuff->data);
     uint32_t mbWord;
-
-    uint8_t flexcan_mb_dlc_value = (uint8_t)(((*flexcan_mb) & CAN_CS_DLC_MASK) >> 16);
-    uint8_t payload_size = FLEXCAN_ComputePayloadSize(flexcan_mb_dlc_value);
-
-    msgBuff->dataLen = payload_size;
+    uint8_t flexcan_mb_dlc_value;
+    uint8_t payload_size;
 
     if (msgBuffIdx >= (((base->MCR) & CAN_MCR_MAXMB_MASK) >> CAN_MCR_MAXMB_SHIFT))
     {
@@ -761,6 +893,10 @@ status_t FLEXCAN_GetMsgBuff(
     {
         /* Get a MB field values */
         msgBuff->cs = *flexcan_mb;
+        flexcan_mb_dlc_value = (uint8_t)((msgBuff->cs & CAN_CS_DLC_MASK) >> CAN_CS_DLC_SHIFT);
+        payload_size = FLEXCAN_ComputePayloadSize(flexcan_mb_dlc_value);
+        msgBuff->dataLen = payload_size;
+
         if ((msgBuff->cs & CAN_CS_IDE_MASK) != 0U)
         {
             msgBuff->msgId = (*flexcan_mb_id);
@@ -770,16 +906,13 @@ status_t FLEXCAN_GetMsgBuff(
             msgBuff->msgId = (*flexcan_mb_id) >> CAN_ID_STD_SHIFT;
         }
 
-        /* Copy MB data field into user's buffer */
-        for (i = 0 ; i < (payload_size & ~3U); i += 4U)
+        /* Copy MB data field into user's buffer. The user's buffer is word
+         * aligned and large enough for the maximum payload, so the last
+         * partial word is copied as a whole word as well. */
+        for (i = 0 ; i < payload_size; i += 4U)
         {
             mbWord = flexcan_mb_data_32[i >> 2U];
             FlexcanSwapBytesInWord(mbWord, msgBuff_data_32[i >> 2U]);
-
-        }
-        for ( ; i < payload_size ; i++)
-        {
-            msgBuff->data[i] = flexcan_mb_data[FlexcanSwapBytesInWordIndex(i)];
         }
     }
 
@@ -795,9 +928,9 @@ status_t FLEXCAN_GetMsgBuff(
  *END**************************************************************************/
 status_t FLEXCAN_LockRxMsgBuff(
     CAN_Type * base,
-    uint32_t msgBuffIdx)
+    uint32_t msgBuffIdx,
+    volatile const uint32_t *flexcan_mb)
 {
-    volatile const uint32_t *flexcan_mb = FLEXCAN_GetMsgBuffRegion(base, msgBuffIdx);
     status_t stat = STATUS_SUCCESS;
 
     if (msgBuffIdx >= (((base->MCR) & CAN_MCR_MAXMB_MASK) >> CAN_MCR_MAXMB_SHIFT))
@@ -1021,6 +1154,43 @@ void FLEXCAN_SetRxFifoFilter(
     }
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_SetRxFifoFilterTable
+ * Description   : Writes format A Rx FIFO ID filter table elements together
+ * with their masks. The elements covered by the individual mask registers get
+ * their own mask and the remaining ones use the Rx FIFO global mask.
+ *
+ *END**************************************************************************/
+void FLEXCAN_SetRxFifoFilterTable(
+    CAN_Type * base,
+    const uint32_t *idFilter,
+    const uint32_t *idMask,
+    uint32_t globalMask)
+{
+    DEV_ASSERT(idFilter != NULL);
+    DEV_ASSERT(idMask != NULL);
+
+    uint32_t i, numOfFilters;
+    volatile uint32_t *filterTable = &base->RAMn[RxFifoFilterTableOffset];
+
+    numOfFilters = (((base->CTRL2) & CAN_CTRL2_RFFN_MASK) >> CAN_CTRL2_RFFN_SHIFT);
+
+    /* One full ID (standard and extended) per ID Filter Table element.*/
+    (base->MCR) = (((base->MCR) & ~(CAN_MCR_IDAM_MASK)) | ( (((uint32_t)(((uint32_t)(FLEXCAN_RX_FIFO_ID_FORMAT_A))<<CAN_MCR_IDAM_SHIFT))&CAN_MCR_IDAM_MASK)));
+
+    for (i = 0; i < RxFifoFilterElementNum(numOfFilters); i++)
+    {
+        filterTable[i] = idFilter[i];
+        if (i < CAN_RXIMR_COUNT)
+        {
+            base->RXIMR[i] = idMask[i];
+        }
+    }
+
+    (base->RXFGMASK) = globalMask;
+}
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : FLEXCAN_SetMsgBuffIntCmd
@@ -136,6 +136,9 @@ typedef struct {
 #define CAN_MB_EDL_MASK                          0x80000000u
 #define CAN_MB_BRS_MASK                          0x40000000u
 
+/*! @brief Number of IFLAG/IMASK registers covering the message buffers */
+#define FLEXCAN_MB_FLAG_REG_COUNT                (((uint32_t)FEATURE_CAN_MAX_MB_NUM + 31U) / 32U)
+
 /*! @brief FlexCAN endianness handling */
 #ifdef CORE_BIG_ENDIAN
     #define FlexcanSwapBytesInWordIndex(index) (index)
@@ -186,6 +189,18 @@ static inline void FLEXCAN_SelectClock(CAN_Type * base, flexcan_clk_source_t clk
 {
     base->CTRL1 = (base->CTRL1 & ~CAN_CTRL1_CLKSRC_MASK) | CAN_CTRL1_CLKSRC(clk);
 }
+
+/*!
+ * @brief Gets the clock source selected for FlexCAN.
+ *
+ * @param   base The FlexCAN base address
+ * @return  The FlexCAN clock source
+ */
+static inline flexcan_clk_source_t FLEXCAN_GetClock(const CAN_Type * base)
+{
+    return (((base->CTRL1 & CAN_CTRL1_CLKSRC_MASK) >> CAN_CTRL1_CLKSRC_SHIFT) != 0U) ?
+           FLEXCAN_CLK_SOURCE_SYS : FLEXCAN_CLK_SOURCE_SOSCDIV2;
+}
 #endif
 
 /*!
@@ -361,6 +376,21 @@ void FLEXCAN_SetPayloadSize(
  */
 uint8_t FLEXCAN_GetPayloadSize(const CAN_Type * base);
 
+/*!
+ * @brief Computes the start address of every MB for the current payload size.
+ *
+ * The addresses only depend on the payload size, so they can be computed once
+ * after FLEXCAN_SetPayloadSize and passed to the MB accessors.
+ *
+ * @param   base       The FlexCAN base address
+ * @param   mbRegions  Array receiving the MB addresses (NULL for MBs not fitting in RAM)
+ * @param   count      Number of entries in mbRegions
+ */
+void FLEXCAN_InitMsgBuffRegions(
+    CAN_Type * base,
+    volatile uint32_t **mbRegions,
+    uint32_t count);
+
 /*@}*/
 
 /*!
@@ -373,6 +403,7 @@ uint8_t FLEXCAN_GetPayloadSize(const CAN_Type * base);
  *
  * @param   base  The FlexCAN base address
  * @param   msgBuffIdx       Index of the message buffer
+ * @param   flexcan_mb   Start address of the message buffer
  * @param   cs           CODE/status values (TX)
  * @param   msgId       ID of the message to transmit
  * @param   msgData      Bytes of the FlexCAN message
@@ -383,15 +414,38 @@ uint8_t FLEXCAN_GetPayloadSize(const CAN_Type * base);
 status_t FLEXCAN_SetTxMsgBuff(
     CAN_Type * base,
     uint32_t msgBuffIdx,
+    volatile uint32_t *flexcan_mb,
     const flexcan_msgbuff_code_status_t *cs,
     uint32_t msgId,
     const uint8_t *msgData);
 
+/*!
+ * @brief Builds the image of a message buffer loaded for transmitting.
+ *
+ * The image holds the words FLEXCAN_SetTxMsgBuff writes into the message
+ * buffer: the CODE/status word first, then the ID word and the payload words
+ * in the MB byte order, padded up to the payload size given by the DLC. It
+ * can be copied into the message buffer by another master, the CODE/status
+ * word last.
+ *
+ * @param   cs           CODE/status values (TX)
+ * @param   msgId        ID of the message to transmit
+ * @param   msgData      Bytes of the FlexCAN message
+ * @param   image        Storage for the image (up to 18 words)
+ * @return  The number of words of the image
+ */
+uint32_t FLEXCAN_BuildTxMsgBuffImage(
+    const flexcan_msgbuff_code_status_t *cs,
+    uint32_t msgId,
+    const uint8_t *msgData,
+    uint32_t *image);
+
 /*!
  * @brief Sets the FlexCAN message buffer fields for receiving.
  *
  * @param   base  The FlexCAN base address
  * @param   msgBuffIdx       Index of the message buffer
+ * @param   flexcan_mb   Start address of the message buffer
  * @param   cs           CODE/status values (RX)
  * @param   msgId       ID of the message to receive
  * @return  STATUS_SUCCESS if successful;
@@ -401,6 +455,7 @@ status_t FLEXCAN_SetTxMsgBuff(
 status_t FLEXCAN_SetRxMsgBuff(
     CAN_Type * base,
     uint32_t msgBuffIdx,
+    volatile uint32_t *flexcan_mb,
     const flexcan_msgbuff_code_status_t *cs,
     uint32_t msgId);
 
@@ -409,6 +464,7 @@ status_t FLEXCAN_SetRxMsgBuff(
  *
  * @param   base  The FlexCAN base address
  * @param   msgBuffIdx       Index of the message buffer
+ * @param   flexcan_mb   Start address of the message buffer
  * @param   msgBuff           The fields of the message buffer
  * @return  STATUS_SUCCESS if successful;
  *          STATUS_FLEXCAN_MB_OUT_OF_RANGE if the index of the
@@ -417,6 +473,7 @@ status_t FLEXCAN_SetRxMsgBuff(
 status_t FLEXCAN_GetMsgBuff(
     CAN_Type * base,
     uint32_t msgBuffIdx,
+    volatile const uint32_t *flexcan_mb,
     flexcan_msgbuff_t *msgBuff);
 
 /*!
@@ -424,13 +481,15 @@ status_t FLEXCAN_GetMsgBuff(
  *
  * @param   base  The FlexCAN base address
  * @param   msgBuffIdx       Index of the message buffer
+ * @param   flexcan_mb   Start address of the message buffer
  * @return  STATUS_SUCCESS if successful;
  *          STATUS_FLEXCAN_MB_OUT_OF_RANGE if the index of the
  *          message buffer is invalid
  */
 status_t FLEXCAN_LockRxMsgBuff(
     CAN_Type * base,
-    uint32_t msgBuffIdx);
+    uint32_t msgBuffIdx,
+    volatile const uint32_t *flexcan_mb);
 
 /*!
  * @brief Unlocks the FlexCAN Rx message buffer.
@@ -516,6 +575,23 @@ void FLEXCAN_SetRxFifoFilter(
     flexcan_rx_fifo_id_element_format_t idFormat,
     const flexcan_id_table_t *idFilterTable);
 
+/*!
+ * @brief Writes format A Rx FIFO ID filter table elements and their masks.
+ *
+ * The elements covered by the individual mask registers get their own mask,
+ * the remaining ones use the Rx FIFO global mask.
+ *
+ * @param   base        The FlexCAN base address
+ * @param   idFilter    The format A ID filter table elements
+ * @param   idMask      The mask of each element
+ * @param   globalMask  The Rx FIFO global mask
+ */
+void FLEXCAN_SetRxFifoFilterTable(
+    CAN_Type * base,
+    const uint32_t *idFilter,
+    const uint32_t *idMask,
+    uint32_t globalMask);
+
 /*!
  * @brief Gets the FlexCAN Rx FIFO data.
  *
@@ -597,6 +673,37 @@ static inline uint8_t FLEXCAN_GetMsgBuffIntStatusFlag(const CAN_Type * base, uin
     return flag;
 }
 
+/*!
+ * @brief Gets the enabled and pending MB interrupt flags of one IFLAG register.
+ *
+ * @param   base    The FlexCAN base address
+ * @param   regIdx  Index of the IFLAG register (0 for MB0-31, 1 for MB32-63, 2 for MB64-95)
+ * @return  the IFLAG register masked by the matching IMASK register
+ */
+static inline uint32_t FLEXCAN_GetMsgBuffIntStatusFlags(const CAN_Type * base, uint32_t regIdx)
+{
+    uint32_t flags = 0U;
+
+    if (regIdx == 0U)
+    {
+        flags = base->IFLAG1 & base->IMASK1 & CAN_IMASK1_BUF31TO0M_MASK;
+    }
+#if FEATURE_CAN_MAX_MB_NUM > 32U
+    if (regIdx == 1U)
+    {
+        flags = base->IFLAG2 & base->IMASK2 & CAN_IMASK2_BUF63TO32M_MASK;
+    }
+#endif
+#if FEATURE_CAN_MAX_MB_NUM > 64U
+    if (regIdx == 2U)
+    {
+        flags = base->IFLAG3 & base->IMASK3 & CAN_IMASK3_BUF95TO64M_MASK;
+    }
+#endif
+
+    return flags;
+}
+
 /*!
  * @brief Clears the interrupt flag of the message buffers.
  *
@@ -832,6 +939,92 @@ static inline void FLEXCAN_SetSelfReception(CAN_Type * base, bool enable)
     base->MCR = (base->MCR & ~CAN_MCR_SRXDIS_MASK) | CAN_MCR_SRXDIS(enable? 0UL : 1UL);
 }
 
+/*!
+ * @brief Enables/Disables the Local Priority feature.
+ *
+ * If enabled, the PRIO field of the Tx MBs is used as the most significant
+ * part of the priority during the internal Tx arbitration.
+ *
+ * @param   base  The FlexCAN base address
+ * @param   enable Enable/Disable Local Priority
+ */
+static inline void FLEXCAN_SetLocalPrio(CAN_Type * base, bool enable)
+{
+    base->MCR = (base->MCR & ~CAN_MCR_LPRIOEN_MASK) | CAN_MCR_LPRIOEN(enable? 1UL : 0UL);
+}
+
+/*!
+ * @brief Enables/Disables the automatic recovery from bus-off.
+ *
+ * If disabled, the module stays in bus-off until the automatic recovery is
+ * enabled again; it then leaves bus-off after 128 occurrences of 11
+ * consecutive recessive bits.
+ *
+ * @param   base  The FlexCAN base address
+ * @param   enable Enable/Disable the automatic recovery
+ */
+static inline void FLEXCAN_SetAutoBusOffRecovery(CAN_Type * base, bool enable)
+{
+    base->CTRL1 = (base->CTRL1 & ~CAN_CTRL1_BOFFREC_MASK) | CAN_CTRL1_BOFFREC(enable? 0UL : 1UL);
+}
+
+/*!
+ * @brief Enables/Disables the Bus Off Done interrupt.
+ *
+ * @param   base  The FlexCAN base address
+ * @param   enable Enable/Disable the interrupt
+ */
+static inline void FLEXCAN_SetBusOffDoneIntCmd(CAN_Type * base, bool enable)
+{
+    base->CTRL2 = (base->CTRL2 & ~CAN_CTRL2_BOFFDONEMSK_MASK) | CAN_CTRL2_BOFFDONEMSK(enable? 1UL : 0UL);
+}
+
+/*!
+ * @brief Reads the Error and Status 1 register.
+ *
+ * The error bits (bit, stuff, CRC, form and acknowledge errors) are cleared
+ * by the read.
+ *
+ * @param   base  The FlexCAN base address
+ * @return  The value of the ESR1 register
+ */
+static inline uint32_t FLEXCAN_GetErrStatus(CAN_Type * base)
+{
+    return base->ESR1;
+}
+
+/*!
+ * @brief Clears the Bus Off Done interrupt flag.
+ *
+ * @param   base  The FlexCAN base address
+ */
+static inline void FLEXCAN_ClearBusOffDoneIntStatusFlag(CAN_Type * base)
+{
+    base->ESR1 = CAN_ESR1_BOFFDONEINT_MASK;
+}
+
+/*!
+ * @brief Returns the transmit error counter.
+ *
+ * @param   base  The FlexCAN base address
+ * @return  The TEC value
+ */
+static inline uint8_t FLEXCAN_GetTxErrorCounter(const CAN_Type * base)
+{
+    return (uint8_t)((base->ECR & CAN_ECR_TXERRCNT_MASK) >> CAN_ECR_TXERRCNT_SHIFT);
+}
+
+/*!
+ * @brief Returns the receive error counter.
+ *
+ * @param   base  The FlexCAN base address
+ * @return  The REC value
+ */
+static inline uint8_t FLEXCAN_GetRxErrorCounter(const CAN_Type * base)
+{
+    return (uint8_t)((base->ECR & CAN_ECR_RXERRCNT_MASK) >> CAN_ECR_RXERRCNT_SHIFT);
+}
+
 /*!
  * @brief Enables/Disables the Transceiver Delay Compensation feature and sets
  * the Transceiver Delay Compensation Offset (offset value to be added to the
@@ -987,7 +1180,7 @@ static inline void FLEXCAN_SetPNDlcFilter(CAN_Type * base, uint8_t dlcLow, uint8
     uint32_t tmp;
 
     tmp = base->FLT_DLC;
-    tmp &= ~(CAN_FLT_DLC_FLT_DLC_HI_MASK | CAN_FLT_DLC_FLT_DLC_HI_MASK);
+    tmp &= ~(CAN_FLT_DLC_FLT_DLC_HI_MASK | CAN_FLT_DLC_FLT_DLC_LO_MASK);
     tmp |= CAN_FLT_DLC_FLT_DLC_HI(dlcHigh);
     tmp |= CAN_FLT_DLC_FLT_DLC_LO(dlcLow);
     base->FLT_DLC = tmp;
@@ -1122,6 +1315,17 @@ static inline void FLEXCAN_ClearWUMF(CAN_Type * base)
     base->WU_MTC |= CAN_WU_MTC_WUMF_MASK;
 }
 
+/*!
+ * @brief Gets the number of frames which matched the Pretended Networking filter.
+ *
+ * @param   base  The FlexCAN base address
+ * @return  the Number of Matches while in Pretended Networking
+ */
+static inline uint8_t FLEXCAN_GetPNMatchCount(const CAN_Type * base)
+{
+    return (uint8_t)((base->WU_MTC & CAN_WU_MTC_MCOUNTER_MASK) >> CAN_WU_MTC_MCOUNTER_SHIFT);
+}
+
 #endif /* FEATURE_CAN_HAS_PRETENDED_NETWORKING */
 
 #if FEATURE_CAN_HAS_SELF_WAKE_UP
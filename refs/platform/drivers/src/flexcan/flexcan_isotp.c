@@ -0,0 +1,899 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*!
+ * @file flexcan_isotp.c
+ *
+ * @page misra_violations MISRA-C:2012 violations
+ *
+ * @section [global]
+ * Violates MISRA 2012 Advisory Rule 15.5, Return statement before end of function.
+ * The return statement before end of function is used for simpler code structure
+ * and better readability.
+ *
+ * @section [global]
+ * Violates MISRA 2012 Advisory Rule 8.7, External could be made static.
+ * Function is defined for usage by application code.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "flexcan_isotp.h"
+#include "interrupt_manager.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/* Protocol control information of the ISO 15765-2 frames */
+#define FLEXCAN_ISOTP_PCI_MASK          0xF0U
+#define FLEXCAN_ISOTP_PCI_SF            0x00U
+#define FLEXCAN_ISOTP_PCI_FF            0x10U
+#define FLEXCAN_ISOTP_PCI_CF            0x20U
+#define FLEXCAN_ISOTP_PCI_FC            0x30U
+#define FLEXCAN_ISOTP_PCI_INFO_MASK     0x0FU
+/* Flow status of the flow control frames */
+#define FLEXCAN_ISOTP_FS_CTS            0U
+#define FLEXCAN_ISOTP_FS_WAIT           1U
+#define FLEXCAN_ISOTP_FS_OVFLW          2U
+/* Frame size of classical CAN and largest first frame length with a 12-bit field */
+#define FLEXCAN_ISOTP_CLASSIC_DL        8U
+#define FLEXCAN_ISOTP_FF_DL_12BIT       4095U
+/* Longest separation time, also used for the reserved STmin values */
+#define FLEXCAN_ISOTP_STMIN_MAX_MS      0x7FU
+/* Marks the MBs which are not used by a channel */
+#define FLEXCAN_ISOTP_NO_CHANNEL        0xFFU
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Pointer to the ISO-TP state structure of each instance. */
+static flexcan_isotp_state_t * g_flexcanIsoTpStatePtr[CAN_INSTANCE_COUNT] = { NULL };
+
+/*******************************************************************************
+ * Private Functions
+ ******************************************************************************/
+static uint32_t FLEXCAN_ISOTP_GetFrameLength(uint32_t length);
+static uint32_t FLEXCAN_ISOTP_GetSingleFrameMax(uint32_t dataLength);
+static uint32_t FLEXCAN_ISOTP_DecodeStMin(uint8_t stMin);
+static void FLEXCAN_ISOTP_Notify(flexcan_isotp_state_t *state, flexcan_isotp_event_t event, uint32_t channel);
+static status_t FLEXCAN_ISOTP_SendFrame(const flexcan_isotp_state_t *state,
+                                        flexcan_isotp_channel_t *ch,
+                                        uint32_t length);
+static void FLEXCAN_ISOTP_Pump(flexcan_isotp_state_t *state, uint32_t channel);
+static void FLEXCAN_ISOTP_CompleteTx(flexcan_isotp_state_t *state, uint32_t channel);
+static void FLEXCAN_ISOTP_ApplyFlowControl(flexcan_isotp_state_t *state, uint32_t channel, const uint8_t *fc);
+static void FLEXCAN_ISOTP_ReceiveFlowControl(flexcan_isotp_state_t *state, uint32_t channel);
+static void FLEXCAN_ISOTP_ReceiveFrame(flexcan_isotp_state_t *state, uint32_t channel);
+static void FLEXCAN_ISOTP_Callback(uint8_t instance, flexcan_event_type_t eventType,
+                                   uint32_t buffIdx, flexcan_state_t *flexcanState);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ISOTP_GetFrameLength
+ * Description   : Rounds a payload size up to the next frame size a DLC can
+ * express, padding the short frames to 8 bytes.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static uint32_t FLEXCAN_ISOTP_GetFrameLength(uint32_t length)
+{
+    static const uint8_t frameLengths[] = { 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U };
+    uint32_t i = 0U;
+
+    while ((i < ((sizeof(frameLengths) / sizeof(frameLengths[0])) - 1U)) && (length > frameLengths[i]))
+    {
+        i++;
+    }
+
+    return frameLengths[i];
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ISOTP_GetSingleFrameMax
+ * Description   : Returns the longest message a single frame of the given
+ * size can carry.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static uint32_t FLEXCAN_ISOTP_GetSingleFrameMax(uint32_t dataLength)
+{
+    /* CAN FD single frames use an escape byte and an 8-bit length */
+    return (dataLength <= FLEXCAN_ISOTP_CLASSIC_DL) ? (dataLength - 1U) : (dataLength - 2U);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ISOTP_DecodeStMin
+ * Description   : Converts a separation time of a flow control frame to
+ * milliseconds. The sub-millisecond values are rounded up to 1 ms and the
+ * reserved values are treated as the longest separation time.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static uint32_t FLEXCAN_ISOTP_DecodeStMin(uint8_t stMin)
+{
+    if (stMin <= FLEXCAN_ISOTP_STMIN_MAX_MS)
+    {
+        return stMin;
+    }
+    if ((stMin >= 0xF1U) && (stMin <= 0xF9U))
+    {
+        return 1U;
+    }
+
+    return FLEXCAN_ISOTP_STMIN_MAX_MS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ISOTP_Notify
+ * Description   : Reports an event of a channel to the application.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_ISOTP_Notify(flexcan_isotp_state_t *state, flexcan_isotp_event_t event, uint32_t channel)
+{
+    if (state->callback != NULL)
+    {
+        state->callback(state->instance, event, channel, state);
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ISOTP_SendFrame
+ * Description   : Pads the frame built in the channel Tx buffer to a valid
+ * frame size and hands it to the Tx MB.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static status_t FLEXCAN_ISOTP_SendFrame(const flexcan_isotp_state_t *state,
+                                        flexcan_isotp_channel_t *ch,
+                                        uint32_t length)
+{
+    const flexcan_isotp_channel_config_t *config = ch->config;
+    uint32_t frameLength = FLEXCAN_ISOTP_GetFrameLength(length);
+    uint32_t i;
+    status_t status;
+
+    for (i = length; i < frameLength; i++)
+    {
+        ch->txFrame[i] = config->padding;
+    }
+
+    flexcan_data_info_t txInfo = {
+        .msg_id_type = config->idType,
+        .data_length = frameLength,
+        .fd_enable = (config->txDataLength > FLEXCAN_ISOTP_CLASSIC_DL),
+        .fd_padding = config->padding,
+        .enable_brs = config->enableBrs,
+        .is_remote = false
+    };
+
+    status = FLEXCAN_DRV_Send(state->instance, config->txMb, &txInfo, config->txId, ch->txFrame);
+    if (status == STATUS_SUCCESS)
+    {
+        ch->txMbBusy = true;
+        ch->txMbTime = OSIF_GetMilliseconds();
+    }
+
+    return status;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ISOTP_Pump
+ * Description   : Loads the next frame of a channel into its Tx MB, if the MB
+ * is free. Pending flow control frames go before the consecutive frames.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_ISOTP_Pump(flexcan_isotp_state_t *state, uint32_t channel)
+{
+    flexcan_isotp_channel_t *ch = &state->channels[channel];
+    const flexcan_isotp_channel_config_t *config = ch->config;
+    uint32_t count, i;
+
+    if (ch->txMbBusy)
+    {
+        return;
+    }
+
+    if (ch->fcPending)
+    {
+        ch->txFrame[0] = (uint8_t)(FLEXCAN_ISOTP_PCI_FC | ch->fcStatus);
+        ch->txFrame[1] = config->blockSize;
+        ch->txFrame[2] = config->stMin;
+        if (FLEXCAN_ISOTP_SendFrame(state, ch, 3U) == STATUS_SUCCESS)
+        {
+            ch->fcPending = false;
+        }
+        return;
+    }
+
+    if (ch->txState == FLEXCAN_ISOTP_TX_READY)
+    {
+        /* Consecutive frame: sequence number and as much of the message as fits */
+        count = ch->txLength - ch->txOffset;
+        if (count > ((uint32_t)config->txDataLength - 1U))
+        {
+            count = (uint32_t)config->txDataLength - 1U;
+        }
+
+        ch->txFrame[0] = (uint8_t)(FLEXCAN_ISOTP_PCI_CF | ch->txSeqNum);
+        for (i = 0U; i < count; i++)
+        {
+            ch->txFrame[1U + i] = ch->txData[ch->txOffset + i];
+        }
+
+        if (FLEXCAN_ISOTP_SendFrame(state, ch, count + 1U) == STATUS_SUCCESS)
+        {
+            ch->txOffset += count;
+            ch->txSeqNum = (uint8_t)((ch->txSeqNum + 1U) & FLEXCAN_ISOTP_PCI_INFO_MASK);
+            ch->txState = FLEXCAN_ISOTP_TX_SENDING;
+        }
+        else
+        {
+            ch->txState = FLEXCAN_ISOTP_TX_IDLE;
+            FLEXCAN_ISOTP_Notify(state, FLEXCAN_ISOTP_EVENT_TX_ERROR, channel);
+        }
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ISOTP_CompleteTx
+ * Description   : Advances a channel once its Tx MB sent a frame. The first
+ * frame and the last frame of a block wait for a flow control frame, unless it
+ * already arrived, the other consecutive frames wait for the separation time,
+ * if any.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_ISOTP_CompleteTx(flexcan_isotp_state_t *state, uint32_t channel)
+{
+    flexcan_isotp_channel_t *ch = &state->channels[channel];
+
+    ch->txMbBusy = false;
+
+    /* Otherwise the frame sent was a flow control frame */
+    if (ch->txState == FLEXCAN_ISOTP_TX_SENDING)
+    {
+        if (ch->txOffset >= ch->txLength)
+        {
+            ch->txState = FLEXCAN_ISOTP_TX_IDLE;
+            FLEXCAN_ISOTP_Notify(state, FLEXCAN_ISOTP_EVENT_TX_COMPLETE, channel);
+        }
+        else if ((ch->txBlockSize != 0U) && (--ch->txBlockLeft == 0U))
+        {
+            ch->txTime = OSIF_GetMilliseconds();
+            ch->txState = FLEXCAN_ISOTP_TX_WAIT_FC;
+            if (ch->txFcLatched)
+            {
+                ch->txFcLatched = false;
+                FLEXCAN_ISOTP_ApplyFlowControl(state, channel, ch->txFc);
+            }
+        }
+        else if (ch->txStMin != 0U)
+        {
+            ch->txTime = OSIF_GetMilliseconds();
+            ch->txState = FLEXCAN_ISOTP_TX_WAIT_STMIN;
+        }
+        else
+        {
+            ch->txState = FLEXCAN_ISOTP_TX_READY;
+        }
+    }
+
+    FLEXCAN_ISOTP_Pump(state, channel);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ISOTP_ApplyFlowControl
+ * Description   : Resumes, delays or aborts the message being sent according
+ * to a flow control frame of its receiver.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_ISOTP_ApplyFlowControl(flexcan_isotp_state_t *state, uint32_t channel, const uint8_t *fc)
+{
+    flexcan_isotp_channel_t *ch = &state->channels[channel];
+
+    switch (fc[0] & FLEXCAN_ISOTP_PCI_INFO_MASK)
+    {
+        case FLEXCAN_ISOTP_FS_CTS:
+            ch->txBlockSize = fc[1];
+            ch->txBlockLeft = fc[1];
+            ch->txStMin = FLEXCAN_ISOTP_DecodeStMin(fc[2]);
+            ch->txState = FLEXCAN_ISOTP_TX_READY;
+            FLEXCAN_ISOTP_Pump(state, channel);
+            break;
+        case FLEXCAN_ISOTP_FS_WAIT:
+            /* The receiver needs more time, restart N_Bs */
+            ch->txTime = OSIF_GetMilliseconds();
+            break;
+        default:
+            /* Overflow or invalid flow status */
+            ch->txState = FLEXCAN_ISOTP_TX_IDLE;
+            FLEXCAN_ISOTP_Notify(state, FLEXCAN_ISOTP_EVENT_TX_ERROR, channel);
+            break;
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ISOTP_ReceiveFlowControl
+ * Description   : Handles a flow control frame of the receiver of the message
+ * being sent. The receiver may answer the last frame of a block before the Tx
+ * completion of that frame is handled: the flow control frame is then kept
+ * until the completion.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_ISOTP_ReceiveFlowControl(flexcan_isotp_state_t *state, uint32_t channel)
+{
+    flexcan_isotp_channel_t *ch = &state->channels[channel];
+    const uint8_t *data = ch->rxFrame.data;
+
+    if (ch->rxFrame.dataLen < 3U)
+    {
+        return;
+    }
+
+    if (ch->txState == FLEXCAN_ISOTP_TX_WAIT_FC)
+    {
+        FLEXCAN_ISOTP_ApplyFlowControl(state, channel, data);
+    }
+    else if ((ch->txState == FLEXCAN_ISOTP_TX_SENDING) && (ch->txOffset < ch->txLength) &&
+             (ch->txBlockSize != 0U) && (ch->txBlockLeft == 1U))
+    {
+        ch->txFc[0] = data[0];
+        ch->txFc[1] = data[1];
+        ch->txFc[2] = data[2];
+        ch->txFcLatched = true;
+    }
+    else
+    {
+        /* No flow control frame is expected */
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ISOTP_ReceiveFrame
+ * Description   : Handles a frame received by a channel. Single and first
+ * frames start a new message, aborting the one being received; consecutive
+ * frames are appended to the reassembly buffer and acknowledged with a flow
+ * control frame at the end of each block.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_ISOTP_ReceiveFrame(flexcan_isotp_state_t *state, uint32_t channel)
+{
+    flexcan_isotp_channel_t *ch = &state->channels[channel];
+    const flexcan_isotp_channel_config_t *config = ch->config;
+    const uint8_t *data = ch->rxFrame.data;
+    uint32_t dataLen = ch->rxFrame.dataLen;
+    uint32_t pci, length, offset, count, i;
+
+    if (dataLen == 0U)
+    {
+        return;
+    }
+
+    pci = (uint32_t)data[0] & FLEXCAN_ISOTP_PCI_MASK;
+
+    if (pci == FLEXCAN_ISOTP_PCI_FC)
+    {
+        FLEXCAN_ISOTP_ReceiveFlowControl(state, channel);
+        return;
+    }
+
+    if (pci == FLEXCAN_ISOTP_PCI_CF)
+    {
+        if (!ch->rxActive)
+        {
+            return;
+        }
+
+        count = ch->rxLength - ch->rxOffset;
+        if (((data[0] & FLEXCAN_ISOTP_PCI_INFO_MASK) != ch->rxSeqNum) ||
+            ((count > (dataLen - 1U)) && (dataLen != ch->rxDataLength)))
+        {
+            /* Lost frame or frame size changed in the middle of the message */
+            ch->rxActive = false;
+            FLEXCAN_ISOTP_Notify(state, FLEXCAN_ISOTP_EVENT_RX_ERROR, channel);
+            return;
+        }
+
+        if (count > (dataLen - 1U))
+        {
+            count = dataLen - 1U;
+        }
+        for (i = 0U; i < count; i++)
+        {
+            config->rxBuffer[ch->rxOffset + i] = data[1U + i];
+        }
+        ch->rxOffset += count;
+        ch->rxSeqNum = (uint8_t)((ch->rxSeqNum + 1U) & FLEXCAN_ISOTP_PCI_INFO_MASK);
+        ch->rxTime = OSIF_GetMilliseconds();
+
+        if (ch->rxOffset >= ch->rxLength)
+        {
+            ch->rxActive = false;
+            FLEXCAN_ISOTP_Notify(state, FLEXCAN_ISOTP_EVENT_RX_COMPLETE, channel);
+        }
+        else if ((config->blockSize != 0U) && (--ch->rxBlockLeft == 0U))
+        {
+            ch->rxBlockLeft = config->blockSize;
+            ch->fcStatus = FLEXCAN_ISOTP_FS_CTS;
+            ch->fcPending = true;
+            FLEXCAN_ISOTP_Pump(state, channel);
+        }
+        else
+        {
+            /* Wait for the next consecutive frame */
+        }
+        return;
+    }
+
+    if ((pci != FLEXCAN_ISOTP_PCI_SF) && (pci != FLEXCAN_ISOTP_PCI_FF))
+    {
+        return;
+    }
+
+    /* A new message terminates the one being received */
+    if (ch->rxActive)
+    {
+        ch->rxActive = false;
+        FLEXCAN_ISOTP_Notify(state, FLEXCAN_ISOTP_EVENT_RX_ERROR, channel);
+    }
+
+    if (pci == FLEXCAN_ISOTP_PCI_SF)
+    {
+        if (dataLen <= FLEXCAN_ISOTP_CLASSIC_DL)
+        {
+            length = (uint32_t)data[0] & FLEXCAN_ISOTP_PCI_INFO_MASK;
+            offset = 1U;
+        }
+        else if ((data[0] & FLEXCAN_ISOTP_PCI_INFO_MASK) == 0U)
+        {
+            length = data[1];
+            offset = 2U;
+        }
+        else
+        {
+            return;
+        }
+
+        if ((length == 0U) || (length > FLEXCAN_ISOTP_GetSingleFrameMax(dataLen)))
+        {
+            return;
+        }
+        if (length > config->rxBufferSize)
+        {
+            FLEXCAN_ISOTP_Notify(state, FLEXCAN_ISOTP_EVENT_RX_ERROR, channel);
+            return;
+        }
+
+        for (i = 0U; i < length; i++)
+        {
+            config->rxBuffer[i] = data[offset + i];
+        }
+        ch->rxLength = length;
+        FLEXCAN_ISOTP_Notify(state, FLEXCAN_ISOTP_EVENT_RX_COMPLETE, channel);
+        return;
+    }
+
+    /* First frame: the frame size of the sender is the size of this frame */
+    if ((dataLen < FLEXCAN_ISOTP_CLASSIC_DL) || (dataLen != FLEXCAN_ISOTP_GetFrameLength(dataLen)))
+    {
+        return;
+    }
+
+    length = (((uint32_t)data[0] & FLEXCAN_ISOTP_PCI_INFO_MASK) << 8U) | data[1];
+    offset = 2U;
+    if (length == 0U)
+    {
+        length = ((uint32_t)data[2] << 24U) | ((uint32_t)data[3] << 16U) |
+                 ((uint32_t)data[4] << 8U) | data[5];
+        offset = 6U;
+        if (length <= FLEXCAN_ISOTP_FF_DL_12BIT)
+        {
+            return;
+        }
+    }
+    if (length <= FLEXCAN_ISOTP_GetSingleFrameMax(dataLen))
+    {
+        return;
+    }
+
+    if (length > config->rxBufferSize)
+    {
+        ch->fcStatus = FLEXCAN_ISOTP_FS_OVFLW;
+        ch->fcPending = true;
+        FLEXCAN_ISOTP_Pump(state, channel);
+        return;
+    }
+
+    count = dataLen - offset;
+    for (i = 0U; i < count; i++)
+    {
+        config->rxBuffer[i] = data[offset + i];
+    }
+    ch->rxLength = length;
+    ch->rxOffset = count;
+    ch->rxDataLength = (uint8_t)dataLen;
+    ch->rxSeqNum = 1U;
+    ch->rxBlockLeft = config->blockSize;
+    ch->rxTime = OSIF_GetMilliseconds();
+    ch->rxActive = true;
+
+    ch->fcStatus = FLEXCAN_ISOTP_FS_CTS;
+    ch->fcPending = true;
+    FLEXCAN_ISOTP_Pump(state, channel);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ISOTP_Callback
+ * Description   : FlexCAN event callback of the ISO-TP layer. The events of the
+ * channel MBs drive the segmentation and the reassembly; the other events are
+ * forwarded to the application.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static void FLEXCAN_ISOTP_Callback(uint8_t instance, flexcan_event_type_t eventType,
+                                   uint32_t buffIdx, flexcan_state_t *flexcanState)
+{
+    flexcan_isotp_state_t *state = g_flexcanIsoTpStatePtr[instance];
+    uint32_t channel = FLEXCAN_ISOTP_NO_CHANNEL;
+    const flexcan_isotp_channel_config_t *config;
+
+    if ((eventType != FLEXCAN_EVENT_RXFIFO_COMPLETE) && (buffIdx < FEATURE_CAN_MAX_MB_NUM))
+    {
+        channel = state->mbChannel[buffIdx];
+    }
+
+    if (channel == FLEXCAN_ISOTP_NO_CHANNEL)
+    {
+        if (state->canCallback != NULL)
+        {
+            state->canCallback(instance, eventType, buffIdx, flexcanState);
+        }
+        return;
+    }
+
+    config = state->channels[channel].config;
+
+    if ((eventType == FLEXCAN_EVENT_RX_COMPLETE) && (buffIdx == config->rxMb))
+    {
+        FLEXCAN_ISOTP_ReceiveFrame(state, channel);
+
+        /* Re-arm the Rx MB for the next frame */
+        (void) FLEXCAN_DRV_Receive(instance, config->rxMb, &state->channels[channel].rxFrame);
+    }
+    else if ((eventType == FLEXCAN_EVENT_TX_COMPLETE) && (buffIdx == config->txMb))
+    {
+        FLEXCAN_ISOTP_CompleteTx(state, channel);
+    }
+    else
+    {
+        /* No other events are expected on the channel MBs */
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ISOTP_Init
+ * Description   : Sets up the ISO-TP channels of a FlexCAN instance.
+ * This function will configure and arm the Rx MB of every channel and install
+ * the ISO-TP layer as the FlexCAN event callback.
+ *
+ * Implements    : FLEXCAN_ISOTP_Init_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_ISOTP_Init(uint8_t instance,
+                            flexcan_isotp_state_t *state,
+                            flexcan_isotp_channel_t *channels,
+                            const flexcan_isotp_user_config_t *config)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(state != NULL);
+    DEV_ASSERT(config != NULL);
+    DEV_ASSERT((channels != NULL) || (config->channelCount == 0U));
+    DEV_ASSERT(config->channelCount < FLEXCAN_ISOTP_NO_CHANNEL);
+
+    const flexcan_isotp_channel_config_t *chConfig;
+    uint32_t i;
+    status_t status;
+
+    state->instance = instance;
+    state->channels = channels;
+    state->channelCount = config->channelCount;
+    state->callback = config->callback;
+    state->callbackParam = config->callbackParam;
+    state->canCallback = config->canCallback;
+    for (i = 0U; i < FEATURE_CAN_MAX_MB_NUM; i++)
+    {
+        state->mbChannel[i] = FLEXCAN_ISOTP_NO_CHANNEL;
+    }
+
+    for (i = 0U; i < config->channelCount; i++)
+    {
+        chConfig = &config->channelConfigs[i];
+        DEV_ASSERT(chConfig->txDataLength == FLEXCAN_ISOTP_GetFrameLength(chConfig->txDataLength));
+        DEV_ASSERT((chConfig->rxBuffer != NULL) || (chConfig->rxBufferSize == 0U));
+        DEV_ASSERT(chConfig->txMb != chConfig->rxMb);
+
+        if ((chConfig->txMb >= FEATURE_CAN_MAX_MB_NUM) || (chConfig->rxMb >= FEATURE_CAN_MAX_MB_NUM))
+        {
+            return STATUS_CAN_BUFF_OUT_OF_RANGE;
+        }
+
+        channels[i].config = chConfig;
+        channels[i].txState = FLEXCAN_ISOTP_TX_IDLE;
+        channels[i].txMbBusy = false;
+        channels[i].txFcLatched = false;
+        channels[i].fcPending = false;
+        channels[i].rxActive = false;
+        channels[i].rxLength = 0U;
+        state->mbChannel[chConfig->txMb] = (uint8_t)i;
+        state->mbChannel[chConfig->rxMb] = (uint8_t)i;
+    }
+
+    g_flexcanIsoTpStatePtr[instance] = state;
+    FLEXCAN_DRV_InstallEventCallback(instance, FLEXCAN_ISOTP_Callback, state);
+
+    for (i = 0U; i < config->channelCount; i++)
+    {
+        chConfig = channels[i].config;
+
+        flexcan_data_info_t rxInfo = {
+            .msg_id_type = chConfig->idType,
+            .data_length = chConfig->txDataLength,
+            .fd_enable = (chConfig->txDataLength > FLEXCAN_ISOTP_CLASSIC_DL),
+            .fd_padding = chConfig->padding,
+            .enable_brs = chConfig->enableBrs,
+            .is_remote = false
+        };
+
+        status = FLEXCAN_DRV_ConfigRxMb(instance, chConfig->rxMb, &rxInfo, chConfig->rxId);
+        if (status == STATUS_SUCCESS)
+        {
+            status = FLEXCAN_DRV_Receive(instance, chConfig->rxMb, &channels[i].rxFrame);
+        }
+        if (status != STATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ISOTP_Send
+ * Description   : Sends a message on an ISO-TP channel.
+ * This function will send a single frame, or the first frame of a segmented
+ * message; the consecutive frames are sent from the interrupt handler.
+ *
+ * Implements    : FLEXCAN_ISOTP_Send_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_ISOTP_Send(uint8_t instance,
+                            uint32_t channel,
+                            const uint8_t *data,
+                            uint32_t length)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(g_flexcanIsoTpStatePtr[instance] != NULL);
+    DEV_ASSERT(channel < g_flexcanIsoTpStatePtr[instance]->channelCount);
+    DEV_ASSERT((data != NULL) && (length != 0U));
+
+    flexcan_isotp_state_t *state = g_flexcanIsoTpStatePtr[instance];
+    flexcan_isotp_channel_t *ch = &state->channels[channel];
+    uint32_t txDataLength = ch->config->txDataLength;
+    uint32_t offset, count, i;
+    status_t status;
+
+    INT_SYS_DisableIRQGlobal();
+
+    if ((ch->txState != FLEXCAN_ISOTP_TX_IDLE) || ch->txMbBusy)
+    {
+        INT_SYS_EnableIRQGlobal();
+        return STATUS_BUSY;
+    }
+
+    if (length <= FLEXCAN_ISOTP_GetSingleFrameMax(txDataLength))
+    {
+        /* The escape sequence is only used by the frames longer than 8 bytes */
+        if (length < FLEXCAN_ISOTP_CLASSIC_DL)
+        {
+            ch->txFrame[0] = (uint8_t)(FLEXCAN_ISOTP_PCI_SF | length);
+            offset = 1U;
+        }
+        else
+        {
+            ch->txFrame[0] = FLEXCAN_ISOTP_PCI_SF;
+            ch->txFrame[1] = (uint8_t)length;
+            offset = 2U;
+        }
+        count = length;
+    }
+    else
+    {
+        if (length <= FLEXCAN_ISOTP_FF_DL_12BIT)
+        {
+            ch->txFrame[0] = (uint8_t)(FLEXCAN_ISOTP_PCI_FF | (length >> 8U));
+            ch->txFrame[1] = (uint8_t)length;
+            offset = 2U;
+        }
+        else
+        {
+            ch->txFrame[0] = FLEXCAN_ISOTP_PCI_FF;
+            ch->txFrame[1] = 0U;
+            ch->txFrame[2] = (uint8_t)(length >> 24U);
+            ch->txFrame[3] = (uint8_t)(length >> 16U);
+            ch->txFrame[4] = (uint8_t)(length >> 8U);
+            ch->txFrame[5] = (uint8_t)length;
+            offset = 6U;
+        }
+        count = txDataLength - offset;
+    }
+
+    for (i = 0U; i < count; i++)
+    {
+        ch->txFrame[offset + i] = data[i];
+    }
+
+    status = FLEXCAN_ISOTP_SendFrame(state, ch, offset + count);
+    if (status == STATUS_SUCCESS)
+    {
+        ch->txData = data;
+        ch->txLength = length;
+        ch->txOffset = count;
+        ch->txSeqNum = 1U;
+        /* The first frame is a block of its own, followed by a flow control frame */
+        ch->txBlockSize = 1U;
+        ch->txBlockLeft = 1U;
+        ch->txStMin = 0U;
+        ch->txFcLatched = false;
+        ch->txState = FLEXCAN_ISOTP_TX_SENDING;
+    }
+
+    INT_SYS_EnableIRQGlobal();
+
+    return status;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ISOTP_GetTransferStatus
+ * Description   : Returns whether an ISO-TP channel is sending a message.
+ *
+ * Implements    : FLEXCAN_ISOTP_GetTransferStatus_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_ISOTP_GetTransferStatus(uint8_t instance, uint32_t channel)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(g_flexcanIsoTpStatePtr[instance] != NULL);
+    DEV_ASSERT(channel < g_flexcanIsoTpStatePtr[instance]->channelCount);
+
+    const flexcan_isotp_state_t *state = g_flexcanIsoTpStatePtr[instance];
+
+    return (state->channels[channel].txState == FLEXCAN_ISOTP_TX_IDLE) ? STATUS_SUCCESS : STATUS_BUSY;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_ISOTP_MainFunction
+ * Description   : Runs the separation times and timeouts of the ISO-TP channels.
+ * This function will resume the channels whose separation time elapsed and
+ * abort the transfers whose N_As, N_Ar, N_Bs or N_Cr timeout expired.
+ *
+ * Implements    : FLEXCAN_ISOTP_MainFunction_Activity
+ *END**************************************************************************/
+void FLEXCAN_ISOTP_MainFunction(uint8_t instance)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(g_flexcanIsoTpStatePtr[instance] != NULL);
+
+    flexcan_isotp_state_t *state = g_flexcanIsoTpStatePtr[instance];
+    flexcan_isotp_channel_t *ch;
+    uint32_t now, i;
+    bool txTimeout, rxTimeout;
+
+    for (i = 0U; i < state->channelCount; i++)
+    {
+        ch = &state->channels[i];
+        txTimeout = false;
+        rxTimeout = false;
+
+        INT_SYS_DisableIRQGlobal();
+
+        now = OSIF_GetMilliseconds();
+        if (ch->txMbBusy && ((now - ch->txMbTime) >= ch->config->timeoutMs))
+        {
+            /* The frame did not leave the Tx MB: N_As for a single, first or
+             * consecutive frame, N_Ar for a flow control frame */
+            (void)FLEXCAN_DRV_AbortTransfer(instance, ch->config->txMb);
+            ch->txMbBusy = false;
+            if (ch->txState == FLEXCAN_ISOTP_TX_SENDING)
+            {
+                ch->txState = FLEXCAN_ISOTP_TX_IDLE;
+                ch->txFcLatched = false;
+                txTimeout = true;
+            }
+            else if (ch->rxActive)
+            {
+                ch->rxActive = false;
+                rxTimeout = true;
+            }
+            else
+            {
+                /* Flow control frame of a refused message */
+            }
+            FLEXCAN_ISOTP_Pump(state, i);
+        }
+
+        if ((ch->txState == FLEXCAN_ISOTP_TX_WAIT_STMIN) && ((now - ch->txTime) > ch->txStMin))
+        {
+            ch->txState = FLEXCAN_ISOTP_TX_READY;
+            FLEXCAN_ISOTP_Pump(state, i);
+        }
+        else if ((ch->txState == FLEXCAN_ISOTP_TX_WAIT_FC) && ((now - ch->txTime) >= ch->config->timeoutMs))
+        {
+            ch->txState = FLEXCAN_ISOTP_TX_IDLE;
+            txTimeout = true;
+        }
+        else
+        {
+            /* Nothing to do for the transmission */
+        }
+
+        if (ch->rxActive && ((now - ch->rxTime) >= ch->config->timeoutMs))
+        {
+            ch->rxActive = false;
+            rxTimeout = true;
+        }
+
+        INT_SYS_EnableIRQGlobal();
+
+        /* Report the timeouts outside of the critical section */
+        if (txTimeout)
+        {
+            FLEXCAN_ISOTP_Notify(state, FLEXCAN_ISOTP_EVENT_TX_ERROR, i);
+        }
+        if (rxTimeout)
+        {
+            FLEXCAN_ISOTP_Notify(state, FLEXCAN_ISOTP_EVENT_RX_ERROR, i);
+        }
+    }
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,363 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*!
+ * @file flexcan_schedule.c
+ *
+ * @page misra_violations MISRA-C:2012 violations
+ *
+ * @section [global]
+ * Violates MISRA 2012 Advisory Rule 8.7, External could be made static.
+ * Function is defined for usage by application code.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "flexcan_schedule.h"
+#include "interrupt_manager.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/* Largest CAN FD payload, in bytes */
+#define FLEXCAN_SCHED_MAX_PAYLOAD       64U
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Pointer to the schedule state structure of each instance. */
+static flexcan_sched_state_t * g_flexcanSchedStatePtr[CAN_INSTANCE_COUNT] = { NULL };
+
+/*******************************************************************************
+ * Private Functions
+ ******************************************************************************/
+static uint32_t FLEXCAN_SCHED_NextSlot(const flexcan_sched_config_t *config, uint32_t slot);
+static uint32_t FLEXCAN_SCHED_GetGap(const flexcan_sched_config_t *config, uint32_t slot);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_SCHED_NextSlot
+ * Description   : Returns the slot following a slot, wrapping at the end of
+ * the cycle.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static uint32_t FLEXCAN_SCHED_NextSlot(const flexcan_sched_config_t *config, uint32_t slot)
+{
+    return ((slot + 1U) < config->slotCount) ? (slot + 1U) : 0U;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_SCHED_GetGap
+ * Description   : Returns the time between the start of a slot and the start
+ * of the next one, in LPIT counts.
+ * This is not a public API as it is called from other driver functions.
+ *
+ *END**************************************************************************/
+static uint32_t FLEXCAN_SCHED_GetGap(const flexcan_sched_config_t *config, uint32_t slot)
+{
+    uint32_t gap;
+
+    if ((slot + 1U) < config->slotCount)
+    {
+        gap = config->slots[slot + 1U].offset - config->slots[slot].offset;
+    }
+    else
+    {
+        gap = (config->cycleLength - config->slots[slot].offset) + config->slots[0].offset;
+    }
+
+    return gap;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_SCHED_Init
+ * Description   : Sets up a time-triggered transmit schedule and configures
+ * the LPIT channel timing its slots. The channel counts the gap between two
+ * slots; each interrupt loads the gap after the next slot, which the channel
+ * takes at its next expiry.
+ *
+ * Implements    : FLEXCAN_SCHED_Init_Activity
+ *END**************************************************************************/
+status_t FLEXCAN_SCHED_Init(uint8_t instance,
+                            flexcan_sched_state_t *state,
+                            flexcan_sched_slot_t *slots,
+                            const flexcan_sched_config_t *config)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(state != NULL);
+    DEV_ASSERT(slots != NULL);
+    DEV_ASSERT(config != NULL);
+    DEV_ASSERT(config->slots != NULL);
+    DEV_ASSERT(config->slotCount != 0U);
+
+    lpit_user_channel_config_t channelConfig;
+    uint32_t i;
+
+    for (i = 0U; i < config->slotCount; i++)
+    {
+        DEV_ASSERT(config->slots[i].offset < config->cycleLength);
+        DEV_ASSERT((i == 0U) || (config->slots[i].offset > config->slots[i - 1U].offset));
+        DEV_ASSERT(config->slots[i].producer != NULL);
+        DEV_ASSERT(config->slots[i].txInfo.data_length <= FLEXCAN_SCHED_MAX_PAYLOAD);
+
+        slots[i].loaded = false;
+        slots[i].sent = 0U;
+        slots[i].empty = 0U;
+        slots[i].missed = 0U;
+        slots[i].lastLatency = 0U;
+        slots[i].minLatency = 0xFFFFFFFFU;
+        slots[i].maxLatency = 0U;
+    }
+
+    state->config = config;
+    state->slots = slots;
+    state->fireSlot = 0U;
+    state->loadSlot = 0U;
+    state->pending = 0U;
+    state->cycles = 0U;
+    g_flexcanSchedStatePtr[instance] = state;
+
+    channelConfig.timerMode = LPIT_PERIODIC_COUNTER;
+    channelConfig.periodUnits = LPIT_PERIOD_UNITS_COUNTS;
+    channelConfig.period = FLEXCAN_SCHED_GetGap(config, config->slotCount - 1U) - 1U;
+    channelConfig.triggerSource = LPIT_TRIGGER_SOURCE_INTERNAL;
+    channelConfig.triggerSelect = 0U;
+    channelConfig.enableReloadOnTrigger = false;
+    channelConfig.enableStopOnInterrupt = false;
+    channelConfig.enableStartOnTrigger = false;
+    channelConfig.chainChannel = false;
+    channelConfig.isInterruptEnabled = true;
+
+    return LPIT_DRV_InitChannel(config->lpitInstance, config->lpitChannel, &channelConfig);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_SCHED_Start
+ * Description   : Starts the LPIT channel. The channel counts the gap before
+ * the first slot, and the gap after the first slot is loaded for its expiry.
+ *
+ * Implements    : FLEXCAN_SCHED_Start_Activity
+ *END**************************************************************************/
+void FLEXCAN_SCHED_Start(uint8_t instance)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    flexcan_sched_state_t *state = g_flexcanSchedStatePtr[instance];
+    DEV_ASSERT(state != NULL);
+    const flexcan_sched_config_t *config = state->config;
+
+    state->fireSlot = 0U;
+    LPIT_DRV_SetTimerPeriodByCount(config->lpitInstance, config->lpitChannel,
+                                   FLEXCAN_SCHED_GetGap(config, config->slotCount - 1U) - 1U);
+    LPIT_DRV_StartTimerChannels(config->lpitInstance, (uint32_t)1U << config->lpitChannel);
+    LPIT_DRV_SetTimerPeriodByCount(config->lpitInstance, config->lpitChannel,
+                                   FLEXCAN_SCHED_GetGap(config, 0U) - 1U);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_SCHED_Stop
+ * Description   : Stops the LPIT channel and aborts the frames loaded into
+ * the MBs.
+ *
+ * Implements    : FLEXCAN_SCHED_Stop_Activity
+ *END**************************************************************************/
+void FLEXCAN_SCHED_Stop(uint8_t instance)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    flexcan_sched_state_t *state = g_flexcanSchedStatePtr[instance];
+    DEV_ASSERT(state != NULL);
+    const flexcan_sched_config_t *config = state->config;
+    uint32_t i;
+
+    LPIT_DRV_StopTimerChannels(config->lpitInstance, (uint32_t)1U << config->lpitChannel);
+    LPIT_DRV_ClearInterruptFlagTimerChannels(config->lpitInstance, (uint32_t)1U << config->lpitChannel);
+
+    for (i = 0U; i < config->slotCount; i++)
+    {
+        if (state->slots[i].loaded)
+        {
+            (void)FLEXCAN_DRV_AbortTransfer(instance, config->slots[i].mbIdx);
+            state->slots[i].loaded = false;
+        }
+    }
+
+    state->fireSlot = 0U;
+    state->loadSlot = 0U;
+    state->pending = 0U;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_SCHED_MainFunction
+ * Description   : Produces the frames of the next slots, in the slot order,
+ * until the frames of a whole cycle are pending or the MB of the next slot is
+ * still in use. A frame is loaded only if its slot did not start while it
+ * was produced.
+ *
+ * Implements    : FLEXCAN_SCHED_MainFunction_Activity
+ *END**************************************************************************/
+void FLEXCAN_SCHED_MainFunction(uint8_t instance)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    flexcan_sched_state_t *state = g_flexcanSchedStatePtr[instance];
+    DEV_ASSERT(state != NULL);
+    const flexcan_sched_config_t *config = state->config;
+    const flexcan_sched_slot_config_t *slotConfig;
+    uint8_t data[FLEXCAN_SCHED_MAX_PAYLOAD];
+    uint32_t slot;
+    bool produced;
+    bool more = true;
+
+    while (more)
+    {
+        INT_SYS_DisableIRQGlobal();
+        slot = state->loadSlot;
+        more = (state->pending < config->slotCount);
+        INT_SYS_EnableIRQGlobal();
+
+        slotConfig = &config->slots[slot];
+        /* The frame of the previous slot using the MB must be sent first */
+        if (more && (FLEXCAN_DRV_GetTransferStatus(instance, slotConfig->mbIdx) == STATUS_SUCCESS))
+        {
+            produced = slotConfig->producer(instance, slot, data, slotConfig->producerParam);
+
+            INT_SYS_DisableIRQGlobal();
+            if (state->loadSlot == slot)
+            {
+                if (produced)
+                {
+                    state->slots[slot].loaded = (FLEXCAN_DRV_PrepareSend(instance,
+                                                                         slotConfig->mbIdx,
+                                                                         &slotConfig->txInfo,
+                                                                         slotConfig->msgId,
+                                                                         data) == STATUS_SUCCESS);
+                }
+                state->loadSlot = FLEXCAN_SCHED_NextSlot(config, slot);
+                state->pending++;
+            }
+            INT_SYS_EnableIRQGlobal();
+        }
+        else
+        {
+            more = false;
+        }
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_SCHED_IRQHandler
+ * Description   : Starts the slot of the LPIT expiry: writes the CODE of the
+ * loaded frame first, then measures the latency and loads the gap after the
+ * next slot into the channel. A slot whose frame is not ready is skipped.
+ *
+ * Implements    : FLEXCAN_SCHED_IRQHandler_Activity
+ *END**************************************************************************/
+void FLEXCAN_SCHED_IRQHandler(uint8_t instance)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+
+    flexcan_sched_state_t *state = g_flexcanSchedStatePtr[instance];
+    DEV_ASSERT(state != NULL);
+    const flexcan_sched_config_t *config = state->config;
+    uint32_t slot = state->fireSlot;
+    uint32_t next = FLEXCAN_SCHED_NextSlot(config, slot);
+    flexcan_sched_slot_t *slotState = &state->slots[slot];
+    uint32_t latency;
+
+    if (state->pending == 0U)
+    {
+        slotState->missed++;
+        state->loadSlot = next;
+    }
+    else
+    {
+        state->pending--;
+        if (slotState->loaded)
+        {
+            (void)FLEXCAN_DRV_SendPrepared(instance, config->slots[slot].mbIdx);
+
+            /* The channel counts down from the gap after this slot since the expiry */
+            latency = (FLEXCAN_SCHED_GetGap(config, slot) - 1U) -
+                      LPIT_DRV_GetCurrentTimerCount(config->lpitInstance, config->lpitChannel);
+            slotState->loaded = false;
+            slotState->sent++;
+            slotState->lastLatency = latency;
+            if (latency < slotState->minLatency)
+            {
+                slotState->minLatency = latency;
+            }
+            if (latency > slotState->maxLatency)
+            {
+                slotState->maxLatency = latency;
+            }
+        }
+        else
+        {
+            slotState->empty++;
+        }
+    }
+
+    LPIT_DRV_ClearInterruptFlagTimerChannels(config->lpitInstance, (uint32_t)1U << config->lpitChannel);
+    /* Taken by the channel when the next slot starts */
+    LPIT_DRV_SetTimerPeriodByCount(config->lpitInstance, config->lpitChannel,
+                                   FLEXCAN_SCHED_GetGap(config, next) - 1U);
+    state->fireSlot = next;
+    if (next == 0U)
+    {
+        state->cycles++;
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : FLEXCAN_SCHED_GetSlotStats
+ * Description   : Copies the runtime information and statistics of a slot.
+ *
+ * Implements    : FLEXCAN_SCHED_GetSlotStats_Activity
+ *END**************************************************************************/
+void FLEXCAN_SCHED_GetSlotStats(uint8_t instance, uint32_t slot, flexcan_sched_slot_t *stats)
+{
+    DEV_ASSERT(instance < CAN_INSTANCE_COUNT);
+    DEV_ASSERT(stats != NULL);
+
+    const flexcan_sched_state_t *state = g_flexcanSchedStatePtr[instance];
+    DEV_ASSERT(state != NULL);
+    DEV_ASSERT(slot < state->config->slotCount);
+
+    INT_SYS_DisableIRQGlobal();
+    *stats = state->slots[slot];
+    INT_SYS_EnableIRQGlobal();
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
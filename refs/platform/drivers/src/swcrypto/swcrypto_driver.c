@@ -0,0 +1,1118 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "swcrypto_driver.h"
+
+/**
+ * @page misra_violations MISRA-C:2012 violations
+ *
+ * @section [global]
+ * Violates MISRA 2012 Required Rule 1.3, Taking address of near auto variable
+ * The code is not dynamically linked. An absolute stack address is obtained when
+ * taking the address of the near auto variable. A source of error in writing
+ * dynamic code is that the stack segment may be different from the data segment.
+ *
+ * @section [global]
+ * Violates MISRA 2012 Advisory Rule 15.5, Return statement before end of function
+ * The return statement before end of function is used for simpler code structure
+ * and better readability.
+ *
+ * @section [global]
+ * Violates MISRA 2012 Advisory Rule 8.7, External could be made static.
+ * The function is defined for use by application code.
+ */
+
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/* Represents the number of 32-bit words of an AES block */
+#define SWCRYPTO_BLOCK_WORDS           (4U)
+/* Represents the number of 32-bit words of the AES-128 key schedule */
+#define SWCRYPTO_SCHEDULE_WORDS        ((SWCRYPTO_AES_ROUNDS + 1U) * SWCRYPTO_BLOCK_WORDS)
+/* Represents the shift used for converting bytes number to/from bits number */
+#define SWCRYPTO_BYTES_TO_FROM_BITS_SHIFT (3U)
+/* Represents the reduction constant of the CMAC subkey doubling */
+#define SWCRYPTO_CMAC_RB               (0x87U)
+
+/* Pointer to runtime state structure.*/
+static swcrypto_state_t * g_swcryptoStatePtr = NULL;
+
+/* Round constants of the AES-128 key schedule */
+static const uint8_t s_swcryptoRcon[SWCRYPTO_AES_ROUNDS] = {
+    0x01U, 0x02U, 0x04U, 0x08U, 0x10U, 0x20U, 0x40U, 0x80U, 0x1BU, 0x36U
+};
+
+/*******************************************************************************
+ * Private Functions
+ ******************************************************************************/
+
+static uint32_t SWCRYPTO_DRV_ReadWord(const uint8_t * bytes);
+static void SWCRYPTO_DRV_WriteWord(uint8_t * bytes, uint32_t word);
+static void SWCRYPTO_DRV_Ortho(uint32_t * q);
+static void SWCRYPTO_DRV_Sbox(uint32_t * q);
+static void SWCRYPTO_DRV_InvSbox(uint32_t * q);
+static void SWCRYPTO_DRV_ShiftRows(uint32_t * q);
+static void SWCRYPTO_DRV_InvShiftRows(uint32_t * q);
+static void SWCRYPTO_DRV_MixColumns(uint32_t * q);
+static void SWCRYPTO_DRV_InvMixColumns(uint32_t * q);
+static void SWCRYPTO_DRV_AddRoundKey(uint32_t * q, const uint32_t * roundKey);
+static uint32_t SWCRYPTO_DRV_SubWord(uint32_t word);
+static void SWCRYPTO_DRV_ExpandKey(const uint8_t * key, uint32_t * roundKeys);
+static status_t SWCRYPTO_DRV_SelectKey(uint32_t keyId);
+static void SWCRYPTO_DRV_LoadBlocks(uint32_t * q, const uint8_t * block0, const uint8_t * block1);
+static void SWCRYPTO_DRV_StoreBlocks(uint32_t * q, uint8_t * block0, uint8_t * block1);
+static void SWCRYPTO_DRV_EncryptBlocks(uint32_t * q);
+static void SWCRYPTO_DRV_DecryptBlocks(uint32_t * q);
+static void SWCRYPTO_DRV_EncryptBlock(const uint8_t * in, uint8_t * out);
+static void SWCRYPTO_DRV_DoubleSubkey(uint8_t * subkey);
+static void SWCRYPTO_DRV_ComputeMAC(const uint8_t * msg, uint32_t msgLen, uint8_t * cmac);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_Init
+ * Description   : This function initializes the internal state of the driver,
+ * with all the key slots empty.
+ *
+ * Implements    : SWCRYPTO_DRV_Init_Activity
+ * END**************************************************************************/
+void SWCRYPTO_DRV_Init(swcrypto_state_t * state)
+{
+    DEV_ASSERT(state != NULL);
+
+    g_swcryptoStatePtr = state;
+    g_swcryptoStatePtr->loadedKeys = 0U;
+    g_swcryptoStatePtr->roundKeysValid = false;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_Deinit
+ * Description   : This function wipes the keys and clears the internal state
+ * of the driver.
+ *
+ * Implements    : SWCRYPTO_DRV_Deinit_Activity
+ * END**************************************************************************/
+void SWCRYPTO_DRV_Deinit(void)
+{
+    volatile uint8_t * bytes = (volatile uint8_t *)g_swcryptoStatePtr;
+    uint32_t i;
+
+    DEV_ASSERT(g_swcryptoStatePtr != NULL);
+
+    /* Volatile accesses, so the wiping is not optimized away */
+    for (i = 0U; i < sizeof(swcrypto_state_t); i++)
+    {
+        bytes[i] = 0U;
+    }
+
+    g_swcryptoStatePtr = NULL;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_LoadKey
+ * Description   : This function loads a plain key in a key slot.
+ *
+ * Implements    : SWCRYPTO_DRV_LoadKey_Activity
+ * END**************************************************************************/
+void SWCRYPTO_DRV_LoadKey(uint32_t keyId,
+                          const uint8_t * key)
+{
+    uint32_t i;
+
+    DEV_ASSERT(key != NULL);
+    DEV_ASSERT(keyId < SWCRYPTO_KEY_SLOTS);
+    DEV_ASSERT(g_swcryptoStatePtr != NULL);
+
+    for (i = 0U; i < SWCRYPTO_BLOCK_SIZE; i++)
+    {
+        g_swcryptoStatePtr->keys[keyId][i] = key[i];
+    }
+
+    g_swcryptoStatePtr->loadedKeys |= (uint32_t)1U << keyId;
+
+    if (g_swcryptoStatePtr->roundKeysId == keyId)
+    {
+        g_swcryptoStatePtr->roundKeysValid = false;
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_EncryptECB
+ * Description   : This function performs the AES-128 encryption in ECB mode of
+ * the input plain text buffer, two blocks at a time.
+ *
+ * Implements    : SWCRYPTO_DRV_EncryptECB_Activity
+ * END**************************************************************************/
+status_t SWCRYPTO_DRV_EncryptECB(uint32_t keyId,
+                                 const uint8_t * plainText,
+                                 uint32_t length,
+                                 uint8_t * cipherText)
+{
+    uint32_t q[8];
+    uint32_t index = 0U;
+    bool pair;
+    status_t status;
+
+    DEV_ASSERT(plainText != NULL);
+    DEV_ASSERT(cipherText != NULL);
+    DEV_ASSERT((length & (SWCRYPTO_BLOCK_SIZE - 1U)) == 0U);
+
+    status = SWCRYPTO_DRV_SelectKey(keyId);
+    if (status != STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    while (index < length)
+    {
+        pair = ((length - index) > SWCRYPTO_BLOCK_SIZE);
+
+        SWCRYPTO_DRV_LoadBlocks(q, &plainText[index], pair ? &plainText[index + SWCRYPTO_BLOCK_SIZE] : NULL);
+        SWCRYPTO_DRV_EncryptBlocks(q);
+        SWCRYPTO_DRV_StoreBlocks(q, &cipherText[index], pair ? &cipherText[index + SWCRYPTO_BLOCK_SIZE] : NULL);
+
+        index += pair ? (SWCRYPTO_BLOCK_SIZE << 1U) : SWCRYPTO_BLOCK_SIZE;
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_DecryptECB
+ * Description   : This function performs the AES-128 decryption in ECB mode of
+ * the input cipher text buffer, two blocks at a time.
+ *
+ * Implements    : SWCRYPTO_DRV_DecryptECB_Activity
+ * END**************************************************************************/
+status_t SWCRYPTO_DRV_DecryptECB(uint32_t keyId,
+                                 const uint8_t * cipherText,
+                                 uint32_t length,
+                                 uint8_t * plainText)
+{
+    uint32_t q[8];
+    uint32_t index = 0U;
+    bool pair;
+    status_t status;
+
+    DEV_ASSERT(plainText != NULL);
+    DEV_ASSERT(cipherText != NULL);
+    DEV_ASSERT((length & (SWCRYPTO_BLOCK_SIZE - 1U)) == 0U);
+
+    status = SWCRYPTO_DRV_SelectKey(keyId);
+    if (status != STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    while (index < length)
+    {
+        pair = ((length - index) > SWCRYPTO_BLOCK_SIZE);
+
+        SWCRYPTO_DRV_LoadBlocks(q, &cipherText[index], pair ? &cipherText[index + SWCRYPTO_BLOCK_SIZE] : NULL);
+        SWCRYPTO_DRV_DecryptBlocks(q);
+        SWCRYPTO_DRV_StoreBlocks(q, &plainText[index], pair ? &plainText[index + SWCRYPTO_BLOCK_SIZE] : NULL);
+
+        index += pair ? (SWCRYPTO_BLOCK_SIZE << 1U) : SWCRYPTO_BLOCK_SIZE;
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_EncryptCBC
+ * Description   : This function performs the AES-128 encryption in CBC mode of
+ * the input plain text buffer. The chaining makes it one block at a time.
+ *
+ * Implements    : SWCRYPTO_DRV_EncryptCBC_Activity
+ * END**************************************************************************/
+status_t SWCRYPTO_DRV_EncryptCBC(uint32_t keyId,
+                                 const uint8_t * plainText,
+                                 uint32_t length,
+                                 const uint8_t * iv,
+                                 uint8_t * cipherText)
+{
+    uint8_t block[SWCRYPTO_BLOCK_SIZE];
+    const uint8_t * chain = iv;
+    uint32_t index;
+    uint32_t i;
+    status_t status;
+
+    DEV_ASSERT(plainText != NULL);
+    DEV_ASSERT(cipherText != NULL);
+    DEV_ASSERT(iv != NULL);
+    DEV_ASSERT((length & (SWCRYPTO_BLOCK_SIZE - 1U)) == 0U);
+
+    status = SWCRYPTO_DRV_SelectKey(keyId);
+    if (status != STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    for (index = 0U; index < length; index += SWCRYPTO_BLOCK_SIZE)
+    {
+        for (i = 0U; i < SWCRYPTO_BLOCK_SIZE; i++)
+        {
+            block[i] = plainText[index + i] ^ chain[i];
+        }
+
+        SWCRYPTO_DRV_EncryptBlock(block, &cipherText[index]);
+        chain = &cipherText[index];
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_DecryptCBC
+ * Description   : This function performs the AES-128 decryption in CBC mode of
+ * the input cipher text buffer, two blocks at a time.
+ *
+ * Implements    : SWCRYPTO_DRV_DecryptCBC_Activity
+ * END**************************************************************************/
+status_t SWCRYPTO_DRV_DecryptCBC(uint32_t keyId,
+                                 const uint8_t * cipherText,
+                                 uint32_t length,
+                                 const uint8_t * iv,
+                                 uint8_t * plainText)
+{
+    uint32_t q[8];
+    uint8_t chain[SWCRYPTO_BLOCK_SIZE];
+    uint8_t blocks[SWCRYPTO_BLOCK_SIZE << 1U];
+    uint32_t index = 0U;
+    uint32_t numBytes;
+    uint32_t i;
+    status_t status;
+
+    DEV_ASSERT(plainText != NULL);
+    DEV_ASSERT(cipherText != NULL);
+    DEV_ASSERT(iv != NULL);
+    DEV_ASSERT((length & (SWCRYPTO_BLOCK_SIZE - 1U)) == 0U);
+
+    status = SWCRYPTO_DRV_SelectKey(keyId);
+    if (status != STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    for (i = 0U; i < SWCRYPTO_BLOCK_SIZE; i++)
+    {
+        chain[i] = iv[i];
+    }
+
+    while (index < length)
+    {
+        numBytes = ((length - index) > SWCRYPTO_BLOCK_SIZE) ? (SWCRYPTO_BLOCK_SIZE << 1U) : SWCRYPTO_BLOCK_SIZE;
+
+        /* Keep the cipher text, which may be overwritten by the plain text */
+        for (i = 0U; i < numBytes; i++)
+        {
+            blocks[i] = cipherText[index + i];
+        }
+
+        SWCRYPTO_DRV_LoadBlocks(q, blocks, (numBytes > SWCRYPTO_BLOCK_SIZE) ? &blocks[SWCRYPTO_BLOCK_SIZE] : NULL);
+        SWCRYPTO_DRV_DecryptBlocks(q);
+        SWCRYPTO_DRV_StoreBlocks(q, &plainText[index], (numBytes > SWCRYPTO_BLOCK_SIZE) ? &plainText[index + SWCRYPTO_BLOCK_SIZE] : NULL);
+
+        for (i = 0U; i < SWCRYPTO_BLOCK_SIZE; i++)
+        {
+            plainText[index + i] ^= chain[i];
+            chain[i] = blocks[numBytes - SWCRYPTO_BLOCK_SIZE + i];
+        }
+        for (i = SWCRYPTO_BLOCK_SIZE; i < numBytes; i++)
+        {
+            plainText[index + i] ^= blocks[i - SWCRYPTO_BLOCK_SIZE];
+        }
+
+        index += numBytes;
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_GenerateMAC
+ * Description   : This function calculates the MAC of a given message using
+ * CMAC with AES-128.
+ *
+ * Implements    : SWCRYPTO_DRV_GenerateMAC_Activity
+ * END**************************************************************************/
+status_t SWCRYPTO_DRV_GenerateMAC(uint32_t keyId,
+                                  const uint8_t * msg,
+                                  uint32_t msgLen,
+                                  uint8_t * cmac)
+{
+    status_t status;
+
+    DEV_ASSERT((msg != NULL) || (msgLen == 0U));
+    DEV_ASSERT(cmac != NULL);
+
+    status = SWCRYPTO_DRV_SelectKey(keyId);
+    if (status != STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    SWCRYPTO_DRV_ComputeMAC(msg, msgLen, cmac);
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_VerifyMAC
+ * Description   : This function verifies the MAC of a given message using
+ * CMAC with AES-128. The comparison does not stop at the first difference.
+ *
+ * Implements    : SWCRYPTO_DRV_VerifyMAC_Activity
+ * END**************************************************************************/
+status_t SWCRYPTO_DRV_VerifyMAC(uint32_t keyId,
+                                const uint8_t * msg,
+                                uint32_t msgLen,
+                                const uint8_t * mac,
+                                uint16_t macLen,
+                                bool * verifStatus)
+{
+    uint8_t cmac[SWCRYPTO_BLOCK_SIZE];
+    uint32_t numBits = (macLen == 0U) ? (SWCRYPTO_BLOCK_SIZE << SWCRYPTO_BYTES_TO_FROM_BITS_SHIFT) : macLen;
+    uint32_t numBytes = numBits >> SWCRYPTO_BYTES_TO_FROM_BITS_SHIFT;
+    uint8_t diff = 0U;
+    uint32_t i;
+    status_t status;
+
+    DEV_ASSERT((msg != NULL) || (msgLen == 0U));
+    DEV_ASSERT(mac != NULL);
+    DEV_ASSERT(verifStatus != NULL);
+    DEV_ASSERT(numBits <= (SWCRYPTO_BLOCK_SIZE << SWCRYPTO_BYTES_TO_FROM_BITS_SHIFT));
+
+    status = SWCRYPTO_DRV_SelectKey(keyId);
+    if (status != STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    SWCRYPTO_DRV_ComputeMAC(msg, msgLen, cmac);
+
+    for (i = 0U; i < numBytes; i++)
+    {
+        diff |= (uint8_t)(cmac[i] ^ mac[i]);
+    }
+    if ((numBits & 7U) != 0U)
+    {
+        /* Compare the leading bits of the last byte */
+        diff |= (uint8_t)((cmac[numBytes] ^ mac[numBytes]) & (uint8_t)(0xFF00U >> (numBits & 7U)));
+    }
+
+    *verifStatus = (diff == 0U);
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_ReadWord
+ * Description   : Reads a little-endian 32-bit word.
+ *
+ * END**************************************************************************/
+static uint32_t SWCRYPTO_DRV_ReadWord(const uint8_t * bytes)
+{
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8U) |
+           ((uint32_t)bytes[2] << 16U) | ((uint32_t)bytes[3] << 24U);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_WriteWord
+ * Description   : Writes a little-endian 32-bit word.
+ *
+ * END**************************************************************************/
+static void SWCRYPTO_DRV_WriteWord(uint8_t * bytes, uint32_t word)
+{
+    bytes[0] = (uint8_t)word;
+    bytes[1] = (uint8_t)(word >> 8U);
+    bytes[2] = (uint8_t)(word >> 16U);
+    bytes[3] = (uint8_t)(word >> 24U);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_Ortho
+ * Description   : Converts two blocks, interleaved word by word, to and from
+ * the bitsliced representation: afterwards, q[i] holds bit i of every byte of
+ * both blocks. The transform is its own inverse.
+ *
+ * END**************************************************************************/
+static void SWCRYPTO_DRV_Ortho(uint32_t * q)
+{
+    uint32_t a;
+    uint32_t b;
+    uint32_t i;
+    uint32_t j;
+    uint32_t shift;
+    static const uint32_t lowMasks[3] = { 0x55555555U, 0x33333333U, 0x0F0F0F0FU };
+
+    /* Swap the bit groups of 1, 2 and 4 bits between the words 1, 2 and 4 apart */
+    for (j = 0U; j < 3U; j++)
+    {
+        shift = (uint32_t)1U << j;
+        for (i = 0U; i < 8U; i++)
+        {
+            if ((i & shift) == 0U)
+            {
+                a = q[i];
+                b = q[i + shift];
+                q[i] = (a & lowMasks[j]) | ((b & lowMasks[j]) << shift);
+                q[i + shift] = ((a & ~lowMasks[j]) >> shift) | (b & ~lowMasks[j]);
+            }
+        }
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_Sbox
+ * Description   : Applies the AES S-box to the 32 bitsliced bytes, as the
+ * 113-gate circuit of Boyar and Peralta.
+ *
+ * END**************************************************************************/
+static void SWCRYPTO_DRV_Sbox(uint32_t * q)
+{
+    uint32_t x0, x1, x2, x3, x4, x5, x6, x7;
+    uint32_t y1, y2, y3, y4, y5, y6, y7, y8, y9, y10, y11;
+    uint32_t y12, y13, y14, y15, y16, y17, y18, y19, y20, y21;
+    uint32_t z0, z1, z2, z3, z4, z5, z6, z7, z8, z9, z10, z11;
+    uint32_t z12, z13, z14, z15, z16, z17;
+    uint32_t t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13;
+    uint32_t t14, t15, t16, t17, t18, t19, t20, t21, t22, t23, t24, t25;
+    uint32_t t26, t27, t28, t29, t30, t31, t32, t33, t34, t35, t36, t37;
+    uint32_t t38, t39, t40, t41, t42, t43, t44, t45, t46, t47, t48, t49;
+    uint32_t t50, t51, t52, t53, t54, t55, t56, t57, t58, t59, t60, t61;
+    uint32_t t62, t63, t64, t65, t66, t67;
+    uint32_t s0, s1, s2, s3, s4, s5, s6, s7;
+
+    x0 = q[7];
+    x1 = q[6];
+    x2 = q[5];
+    x3 = q[4];
+    x4 = q[3];
+    x5 = q[2];
+    x6 = q[1];
+    x7 = q[0];
+
+    /* Top linear transformation */
+    y14 = x3 ^ x5;
+    y13 = x0 ^ x6;
+    y9 = x0 ^ x3;
+    y8 = x0 ^ x5;
+    t0 = x1 ^ x2;
+    y1 = t0 ^ x7;
+    y4 = y1 ^ x3;
+    y12 = y13 ^ y14;
+    y2 = y1 ^ x0;
+    y5 = y1 ^ x6;
+    y3 = y5 ^ y8;
+    t1 = x4 ^ y12;
+    y15 = t1 ^ x5;
+    y20 = t1 ^ x1;
+    y6 = y15 ^ x7;
+    y10 = y15 ^ t0;
+    y11 = y20 ^ y9;
+    y7 = x7 ^ y11;
+    y17 = y10 ^ y11;
+    y19 = y10 ^ y8;
+    y16 = t0 ^ y11;
+    y21 = y13 ^ y16;
+    y18 = x0 ^ y16;
+
+    /* Non-linear section */
+    t2 = y12 & y15;
+    t3 = y3 & y6;
+    t4 = t3 ^ t2;
+    t5 = y4 & x7;
+    t6 = t5 ^ t2;
+    t7 = y13 & y16;
+    t8 = y5 & y1;
+    t9 = t8 ^ t7;
+    t10 = y2 & y7;
+    t11 = t10 ^ t7;
+    t12 = y9 & y11;
+    t13 = y14 & y17;
+    t14 = t13 ^ t12;
+    t15 = y8 & y10;
+    t16 = t15 ^ t12;
+    t17 = t4 ^ t14;
+    t18 = t6 ^ t16;
+    t19 = t9 ^ t14;
+    t20 = t11 ^ t16;
+    t21 = t17 ^ y20;
+    t22 = t18 ^ y19;
+    t23 = t19 ^ y21;
+    t24 = t20 ^ y18;
+
+    t25 = t21 ^ t22;
+    t26 = t21 & t23;
+    t27 = t24 ^ t26;
+    t28 = t25 & t27;
+    t29 = t28 ^ t22;
+    t30 = t23 ^ t24;
+    t31 = t22 ^ t26;
+    t32 = t31 & t30;
+    t33 = t32 ^ t24;
+    t34 = t23 ^ t33;
+    t35 = t27 ^ t33;
+    t36 = t24 & t35;
+    t37 = t36 ^ t34;
+    t38 = t27 ^ t36;
+    t39 = t29 & t38;
+    t40 = t25 ^ t39;
+
+    t41 = t40 ^ t37;
+    t42 = t29 ^ t33;
+    t43 = t29 ^ t40;
+    t44 = t33 ^ t37;
+    t45 = t42 ^ t41;
+    z0 = t44 & y15;
+    z1 = t37 & y6;
+    z2 = t33 & x7;
+    z3 = t43 & y16;
+    z4 = t40 & y1;
+    z5 = t29 & y7;
+    z6 = t42 & y11;
+    z7 = t45 & y17;
+    z8 = t41 & y10;
+    z9 = t44 & y12;
+    z10 = t37 & y3;
+    z11 = t33 & y4;
+    z12 = t43 & y13;
+    z13 = t40 & y5;
+    z14 = t29 & y2;
+    z15 = t42 & y9;
+    z16 = t45 & y14;
+    z17 = t41 & y8;
+
+    /* Bottom linear transformation */
+    t46 = z15 ^ z16;
+    t47 = z10 ^ z11;
+    t48 = z5 ^ z13;
+    t49 = z9 ^ z10;
+    t50 = z2 ^ z12;
+    t51 = z2 ^ z5;
+    t52 = z7 ^ z8;
+    t53 = z0 ^ z3;
+    t54 = z6 ^ z7;
+    t55 = z16 ^ z17;
+    t56 = z12 ^ t48;
+    t57 = t50 ^ t53;
+    t58 = z4 ^ t46;
+    t59 = z3 ^ t54;
+    t60 = t46 ^ t57;
+    t61 = z14 ^ t57;
+    t62 = t52 ^ t58;
+    t63 = t49 ^ t58;
+    t64 = z4 ^ t59;
+    t65 = t61 ^ t62;
+    t66 = z1 ^ t63;
+    s0 = t59 ^ t63;
+    s6 = t56 ^ ~t62;
+    s7 = t48 ^ ~t60;
+    t67 = t64 ^ t65;
+    s3 = t53 ^ t66;
+    s4 = t51 ^ t66;
+    s5 = t47 ^ t65;
+    s1 = t64 ^ ~s3;
+    s2 = t55 ^ ~t67;
+
+    q[7] = s0;
+    q[6] = s1;
+    q[5] = s2;
+    q[4] = s3;
+    q[3] = s4;
+    q[2] = s5;
+    q[1] = s6;
+    q[0] = s7;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_InvSbox
+ * Description   : Applies the inverse AES S-box to the 32 bitsliced bytes.
+ * The S-box is S(x) = A(I(x)) ^ 0x63, with I() the inversion in GF(256) and
+ * A() an affine transform, so the inverse is B(S(B(x ^ 0x63)) ^ 0x63) with B()
+ * the inverse of A(); this reuses the S-box circuit.
+ *
+ * END**************************************************************************/
+static void SWCRYPTO_DRV_InvSbox(uint32_t * q)
+{
+    uint32_t q0, q1, q2, q3, q4, q5, q6, q7;
+    uint32_t round;
+
+    for (round = 0U; round < 2U; round++)
+    {
+        if (round == 1U)
+        {
+            SWCRYPTO_DRV_Sbox(q);
+        }
+
+        /* x ^ 0x63 followed by B() */
+        q0 = ~q[0];
+        q1 = ~q[1];
+        q2 = q[2];
+        q3 = q[3];
+        q4 = q[4];
+        q5 = ~q[5];
+        q6 = ~q[6];
+        q7 = q[7];
+        q[7] = q1 ^ q4 ^ q6;
+        q[6] = q0 ^ q3 ^ q5;
+        q[5] = q7 ^ q2 ^ q4;
+        q[4] = q6 ^ q1 ^ q3;
+        q[3] = q5 ^ q0 ^ q2;
+        q[2] = q4 ^ q7 ^ q1;
+        q[1] = q3 ^ q6 ^ q0;
+        q[0] = q2 ^ q5 ^ q7;
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_ShiftRows
+ * Description   : Applies the AES ShiftRows transform to the bitsliced blocks.
+ *
+ * END**************************************************************************/
+static void SWCRYPTO_DRV_ShiftRows(uint32_t * q)
+{
+    uint32_t x;
+    uint32_t i;
+
+    for (i = 0U; i < 8U; i++)
+    {
+        x = q[i];
+        q[i] = (x & 0x000000FFU)
+               | ((x & 0x0000FC00U) >> 2U) | ((x & 0x00000300U) << 6U)
+               | ((x & 0x00F00000U) >> 4U) | ((x & 0x000F0000U) << 4U)
+               | ((x & 0xC0000000U) >> 6U) | ((x & 0x3F000000U) << 2U);
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_InvShiftRows
+ * Description   : Applies the inverse AES ShiftRows transform to the
+ * bitsliced blocks.
+ *
+ * END**************************************************************************/
+static void SWCRYPTO_DRV_InvShiftRows(uint32_t * q)
+{
+    uint32_t x;
+    uint32_t i;
+
+    for (i = 0U; i < 8U; i++)
+    {
+        x = q[i];
+        q[i] = (x & 0x000000FFU)
+               | ((x & 0x00003F00U) << 2U) | ((x & 0x0000C000U) >> 6U)
+               | ((x & 0x000F0000U) << 4U) | ((x & 0x00F00000U) >> 4U)
+               | ((x & 0x03000000U) << 6U) | ((x & 0xFC000000U) >> 2U);
+    }
+}
+
+/* Rotates a bitsliced word by two rows */
+#define SWCRYPTO_ROTR16(x)    (((x) << 16U) | ((x) >> 16U))
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_MixColumns
+ * Description   : Applies the AES MixColumns transform to the bitsliced blocks.
+ *
+ * END**************************************************************************/
+static void SWCRYPTO_DRV_MixColumns(uint32_t * q)
+{
+    uint32_t q0, q1, q2, q3, q4, q5, q6, q7;
+    uint32_t r0, r1, r2, r3, r4, r5, r6, r7;
+
+    q0 = q[0];
+    q1 = q[1];
+    q2 = q[2];
+    q3 = q[3];
+    q4 = q[4];
+    q5 = q[5];
+    q6 = q[6];
+    q7 = q[7];
+    r0 = (q0 >> 8U) | (q0 << 24U);
+    r1 = (q1 >> 8U) | (q1 << 24U);
+    r2 = (q2 >> 8U) | (q2 << 24U);
+    r3 = (q3 >> 8U) | (q3 << 24U);
+    r4 = (q4 >> 8U) | (q4 << 24U);
+    r5 = (q5 >> 8U) | (q5 << 24U);
+    r6 = (q6 >> 8U) | (q6 << 24U);
+    r7 = (q7 >> 8U) | (q7 << 24U);
+
+    q[0] = q7 ^ r7 ^ r0 ^ SWCRYPTO_ROTR16(q0 ^ r0);
+    q[1] = q0 ^ r0 ^ q7 ^ r7 ^ r1 ^ SWCRYPTO_ROTR16(q1 ^ r1);
+    q[2] = q1 ^ r1 ^ r2 ^ SWCRYPTO_ROTR16(q2 ^ r2);
+    q[3] = q2 ^ r2 ^ q7 ^ r7 ^ r3 ^ SWCRYPTO_ROTR16(q3 ^ r3);
+    q[4] = q3 ^ r3 ^ q7 ^ r7 ^ r4 ^ SWCRYPTO_ROTR16(q4 ^ r4);
+    q[5] = q4 ^ r4 ^ r5 ^ SWCRYPTO_ROTR16(q5 ^ r5);
+    q[6] = q5 ^ r5 ^ r6 ^ SWCRYPTO_ROTR16(q6 ^ r6);
+    q[7] = q6 ^ r6 ^ r7 ^ SWCRYPTO_ROTR16(q7 ^ r7);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_InvMixColumns
+ * Description   : Applies the inverse AES MixColumns transform to the
+ * bitsliced blocks.
+ *
+ * END**************************************************************************/
+static void SWCRYPTO_DRV_InvMixColumns(uint32_t * q)
+{
+    uint32_t q0, q1, q2, q3, q4, q5, q6, q7;
+    uint32_t r0, r1, r2, r3, r4, r5, r6, r7;
+
+    q0 = q[0];
+    q1 = q[1];
+    q2 = q[2];
+    q3 = q[3];
+    q4 = q[4];
+    q5 = q[5];
+    q6 = q[6];
+    q7 = q[7];
+    r0 = (q0 >> 8U) | (q0 << 24U);
+    r1 = (q1 >> 8U) | (q1 << 24U);
+    r2 = (q2 >> 8U) | (q2 << 24U);
+    r3 = (q3 >> 8U) | (q3 << 24U);
+    r4 = (q4 >> 8U) | (q4 << 24U);
+    r5 = (q5 >> 8U) | (q5 << 24U);
+    r6 = (q6 >> 8U) | (q6 << 24U);
+    r7 = (q7 >> 8U) | (q7 << 24U);
+
+    q[0] = q5 ^ q6 ^ q7 ^ r0 ^ r5 ^ r7 ^ SWCRYPTO_ROTR16(q0 ^ q5 ^ q6 ^ r0 ^ r5);
+    q[1] = q0 ^ q5 ^ r0 ^ r1 ^ r5 ^ r6 ^ r7 ^ SWCRYPTO_ROTR16(q1 ^ q5 ^ q7 ^ r1 ^ r5 ^ r6);
+    q[2] = q0 ^ q1 ^ q6 ^ r1 ^ r2 ^ r6 ^ r7 ^ SWCRYPTO_ROTR16(q0 ^ q2 ^ q6 ^ r2 ^ r6 ^ r7);
+    q[3] = q0 ^ q1 ^ q2 ^ q5 ^ q6 ^ r0 ^ r2 ^ r3 ^ r5 ^ SWCRYPTO_ROTR16(q0 ^ q1 ^ q3 ^ q5 ^ q6 ^ q7 ^ r0 ^ r3 ^ r5 ^ r7);
+    q[4] = q1 ^ q2 ^ q3 ^ q5 ^ r1 ^ r3 ^ r4 ^ r5 ^ r6 ^ r7 ^ SWCRYPTO_ROTR16(q1 ^ q2 ^ q4 ^ q5 ^ q7 ^ r1 ^ r4 ^ r5 ^ r6);
+    q[5] = q2 ^ q3 ^ q4 ^ q6 ^ r2 ^ r4 ^ r5 ^ r6 ^ r7 ^ SWCRYPTO_ROTR16(q2 ^ q3 ^ q5 ^ q6 ^ r2 ^ r5 ^ r6 ^ r7);
+    q[6] = q3 ^ q4 ^ q5 ^ q7 ^ r3 ^ r5 ^ r6 ^ r7 ^ SWCRYPTO_ROTR16(q3 ^ q4 ^ q6 ^ q7 ^ r3 ^ r6 ^ r7);
+    q[7] = q4 ^ q5 ^ q6 ^ r4 ^ r6 ^ r7 ^ SWCRYPTO_ROTR16(q4 ^ q5 ^ q7 ^ r4 ^ r7);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_AddRoundKey
+ * Description   : XORs a bitsliced round key into the bitsliced blocks.
+ *
+ * END**************************************************************************/
+static void SWCRYPTO_DRV_AddRoundKey(uint32_t * q, const uint32_t * roundKey)
+{
+    uint32_t i;
+
+    for (i = 0U; i < 8U; i++)
+    {
+        q[i] ^= roundKey[i];
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_SubWord
+ * Description   : Applies the AES S-box to the four bytes of a word, for the
+ * key schedule.
+ *
+ * END**************************************************************************/
+static uint32_t SWCRYPTO_DRV_SubWord(uint32_t word)
+{
+    uint32_t q[8] = { 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U };
+
+    q[0] = word;
+    SWCRYPTO_DRV_Ortho(q);
+    SWCRYPTO_DRV_Sbox(q);
+    SWCRYPTO_DRV_Ortho(q);
+
+    return q[0];
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_ExpandKey
+ * Description   : Computes the AES-128 key schedule and converts each round key
+ * to the bitsliced representation, duplicated for the two blocks.
+ *
+ * END**************************************************************************/
+static void SWCRYPTO_DRV_ExpandKey(const uint8_t * key, uint32_t * roundKeys)
+{
+    uint32_t word = 0U;
+    uint32_t pairs;
+    uint32_t i;
+
+    /* The words are first computed in pairs, one for each block */
+    for (i = 0U; i < SWCRYPTO_SCHEDULE_WORDS; i++)
+    {
+        if (i < SWCRYPTO_BLOCK_WORDS)
+        {
+            word = SWCRYPTO_DRV_ReadWord(&key[i << 2U]);
+        }
+        else
+        {
+            if ((i & (SWCRYPTO_BLOCK_WORDS - 1U)) == 0U)
+            {
+                word = (word << 24U) | (word >> 8U);
+                word = SWCRYPTO_DRV_SubWord(word) ^ s_swcryptoRcon[(i >> 2U) - 1U];
+            }
+            word ^= roundKeys[(i - SWCRYPTO_BLOCK_WORDS) << 1U];
+        }
+
+        roundKeys[i << 1U] = word;
+        roundKeys[(i << 1U) + 1U] = word;
+    }
+
+    for (i = 0U; i < SWCRYPTO_SCHEDULE_WORDS; i += SWCRYPTO_BLOCK_WORDS)
+    {
+        SWCRYPTO_DRV_Ortho(&roundKeys[i << 1U]);
+    }
+
+    /* Both words of a pair now hold the same bits, once for each block, in
+     * alternate positions; copy each bit to the position of the other block */
+    for (i = 0U; i < SWCRYPTO_SCHEDULE_WORDS; i++)
+    {
+        pairs = (roundKeys[i << 1U] & 0x55555555U) | (roundKeys[(i << 1U) + 1U] & 0xAAAAAAAAU);
+        roundKeys[i << 1U] = (pairs & 0x55555555U) | ((pairs & 0x55555555U) << 1U);
+        roundKeys[(i << 1U) + 1U] = (pairs & 0xAAAAAAAAU) | ((pairs & 0xAAAAAAAAU) >> 1U);
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_SelectKey
+ * Description   : Makes the round keys match a key slot, recomputing them only
+ * when the slot changes.
+ *
+ * END**************************************************************************/
+static status_t SWCRYPTO_DRV_SelectKey(uint32_t keyId)
+{
+    DEV_ASSERT(keyId < SWCRYPTO_KEY_SLOTS);
+    DEV_ASSERT(g_swcryptoStatePtr != NULL);
+
+    if ((g_swcryptoStatePtr->loadedKeys & ((uint32_t)1U << keyId)) == 0U)
+    {
+        return STATUS_SEC_KEY_EMPTY;
+    }
+
+    if ((!g_swcryptoStatePtr->roundKeysValid) || (g_swcryptoStatePtr->roundKeysId != keyId))
+    {
+        SWCRYPTO_DRV_ExpandKey(g_swcryptoStatePtr->keys[keyId], g_swcryptoStatePtr->roundKeys);
+        g_swcryptoStatePtr->roundKeysId = keyId;
+        g_swcryptoStatePtr->roundKeysValid = true;
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_LoadBlocks
+ * Description   : Loads one or two blocks in the bitsliced representation.
+ *
+ * END**************************************************************************/
+static void SWCRYPTO_DRV_LoadBlocks(uint32_t * q, const uint8_t * block0, const uint8_t * block1)
+{
+    uint32_t i;
+
+    for (i = 0U; i < SWCRYPTO_BLOCK_WORDS; i++)
+    {
+        q[i << 1U] = SWCRYPTO_DRV_ReadWord(&block0[i << 2U]);
+        q[(i << 1U) + 1U] = (block1 != NULL) ? SWCRYPTO_DRV_ReadWord(&block1[i << 2U]) : 0U;
+    }
+
+    SWCRYPTO_DRV_Ortho(q);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_StoreBlocks
+ * Description   : Stores one or two blocks from the bitsliced representation.
+ *
+ * END**************************************************************************/
+static void SWCRYPTO_DRV_StoreBlocks(uint32_t * q, uint8_t * block0, uint8_t * block1)
+{
+    uint32_t i;
+
+    SWCRYPTO_DRV_Ortho(q);
+
+    for (i = 0U; i < SWCRYPTO_BLOCK_WORDS; i++)
+    {
+        SWCRYPTO_DRV_WriteWord(&block0[i << 2U], q[i << 1U]);
+        if (block1 != NULL)
+        {
+            SWCRYPTO_DRV_WriteWord(&block1[i << 2U], q[(i << 1U) + 1U]);
+        }
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_EncryptBlocks
+ * Description   : Encrypts the bitsliced blocks with the selected key.
+ *
+ * END**************************************************************************/
+static void SWCRYPTO_DRV_EncryptBlocks(uint32_t * q)
+{
+    const uint32_t * roundKeys = g_swcryptoStatePtr->roundKeys;
+    uint32_t round;
+
+    SWCRYPTO_DRV_AddRoundKey(q, roundKeys);
+    for (round = 1U; round < SWCRYPTO_AES_ROUNDS; round++)
+    {
+        SWCRYPTO_DRV_Sbox(q);
+        SWCRYPTO_DRV_ShiftRows(q);
+        SWCRYPTO_DRV_MixColumns(q);
+        SWCRYPTO_DRV_AddRoundKey(q, &roundKeys[round << 3U]);
+    }
+    SWCRYPTO_DRV_Sbox(q);
+    SWCRYPTO_DRV_ShiftRows(q);
+    SWCRYPTO_DRV_AddRoundKey(q, &roundKeys[SWCRYPTO_AES_ROUNDS << 3U]);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_DecryptBlocks
+ * Description   : Decrypts the bitsliced blocks with the selected key.
+ *
+ * END**************************************************************************/
+static void SWCRYPTO_DRV_DecryptBlocks(uint32_t * q)
+{
+    const uint32_t * roundKeys = g_swcryptoStatePtr->roundKeys;
+    uint32_t round;
+
+    SWCRYPTO_DRV_AddRoundKey(q, &roundKeys[SWCRYPTO_AES_ROUNDS << 3U]);
+    for (round = SWCRYPTO_AES_ROUNDS - 1U; round > 0U; round--)
+    {
+        SWCRYPTO_DRV_InvShiftRows(q);
+        SWCRYPTO_DRV_InvSbox(q);
+        SWCRYPTO_DRV_AddRoundKey(q, &roundKeys[round << 3U]);
+        SWCRYPTO_DRV_InvMixColumns(q);
+    }
+    SWCRYPTO_DRV_InvShiftRows(q);
+    SWCRYPTO_DRV_InvSbox(q);
+    SWCRYPTO_DRV_AddRoundKey(q, roundKeys);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_EncryptBlock
+ * Description   : Encrypts a single block with the selected key.
+ *
+ * END**************************************************************************/
+static void SWCRYPTO_DRV_EncryptBlock(const uint8_t * in, uint8_t * out)
+{
+    uint32_t q[8];
+
+    SWCRYPTO_DRV_LoadBlocks(q, in, NULL);
+    SWCRYPTO_DRV_EncryptBlocks(q);
+    SWCRYPTO_DRV_StoreBlocks(q, out, NULL);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_DoubleSubkey
+ * Description   : Multiplies a CMAC subkey by x in GF(2^128), without
+ * branching on its value.
+ *
+ * END**************************************************************************/
+static void SWCRYPTO_DRV_DoubleSubkey(uint8_t * subkey)
+{
+    uint8_t reduction = (uint8_t)((0U - ((uint32_t)subkey[0] >> 7U)) & SWCRYPTO_CMAC_RB);
+    uint32_t i;
+
+    for (i = 0U; i < (SWCRYPTO_BLOCK_SIZE - 1U); i++)
+    {
+        subkey[i] = (uint8_t)((uint32_t)subkey[i] << 1U) | (uint8_t)(subkey[i + 1U] >> 7U);
+    }
+    subkey[SWCRYPTO_BLOCK_SIZE - 1U] = (uint8_t)((uint32_t)subkey[SWCRYPTO_BLOCK_SIZE - 1U] << 1U) ^ reduction;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SWCRYPTO_DRV_ComputeMAC
+ * Description   : Computes the CMAC of a message of any number of bits with the
+ * selected key.
+ *
+ * END**************************************************************************/
+static void SWCRYPTO_DRV_ComputeMAC(const uint8_t * msg, uint32_t msgLen, uint8_t * cmac)
+{
+    uint8_t subkey[SWCRYPTO_BLOCK_SIZE] = { 0U };
+    uint8_t block[SWCRYPTO_BLOCK_SIZE];
+    uint32_t numBytes = (msgLen + 7U) >> SWCRYPTO_BYTES_TO_FROM_BITS_SHIFT;
+    uint32_t lastIndex = (numBytes == 0U) ? 0U : ((numBytes - 1U) & ~(SWCRYPTO_BLOCK_SIZE - 1U));
+    uint32_t lastBits = msgLen - (lastIndex << SWCRYPTO_BYTES_TO_FROM_BITS_SHIFT);
+    uint32_t index;
+    uint32_t i;
+
+    /* The subkeys derive from the encryption of the zero block */
+    SWCRYPTO_DRV_EncryptBlock(subkey, subkey);
+    SWCRYPTO_DRV_DoubleSubkey(subkey);
+    if (lastBits < (SWCRYPTO_BLOCK_SIZE << SWCRYPTO_BYTES_TO_FROM_BITS_SHIFT))
+    {
+        /* The last block is padded: use the second subkey */
+        SWCRYPTO_DRV_DoubleSubkey(subkey);
+    }
+
+    for (i = 0U; i < SWCRYPTO_BLOCK_SIZE; i++)
+    {
+        cmac[i] = 0U;
+    }
+
+    for (index = 0U; index < lastIndex; index += SWCRYPTO_BLOCK_SIZE)
+    {
+        for (i = 0U; i < SWCRYPTO_BLOCK_SIZE; i++)
+        {
+            block[i] = cmac[i] ^ msg[index + i];
+        }
+        SWCRYPTO_DRV_EncryptBlock(block, cmac);
+    }
+
+    /* Last block: keep its message bits and append the padding bit, if any */
+    for (i = 0U; i < SWCRYPTO_BLOCK_SIZE; i++)
+    {
+        block[i] = ((lastIndex + i) < numBytes) ? msg[lastIndex + i] : 0U;
+    }
+    if (lastBits < (SWCRYPTO_BLOCK_SIZE << SWCRYPTO_BYTES_TO_FROM_BITS_SHIFT))
+    {
+        i = lastBits >> SWCRYPTO_BYTES_TO_FROM_BITS_SHIFT;
+        block[i] = (uint8_t)(block[i] & (uint8_t)(0xFF00U >> (lastBits & 7U))) | (uint8_t)(0x80U >> (lastBits & 7U));
+    }
+
+    for (i = 0U; i < SWCRYPTO_BLOCK_SIZE; i++)
+    {
+        block[i] ^= (uint8_t)(cmac[i] ^ subkey[i]);
+    }
+    SWCRYPTO_DRV_EncryptBlock(block, cmac);
+}
+
+/******************************************************************************
+ * EOF
+ *****************************************************************************/
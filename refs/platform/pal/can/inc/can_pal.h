@@ -105,6 +105,7 @@ typedef struct {
     uint32_t id;       /*!< ID of the message */
     uint8_t data[64];  /*!< Data bytes of the CAN message*/
     uint8_t length;    /*!< Length of payload in bytes */
+    uint64_t timestamp; /*!< Time of the frame on the bus (see FLEXCAN_DRV_InstallTimeBase) */
 } can_message_t;
 
 /*! @brief CAN controller configuration
@@ -134,6 +135,23 @@ typedef struct
 } extension_flexcan_rx_fifo_t;
 #endif
 
+/*! @brief Prepared transmit handle
+ *
+ * Filled in by CAN_PrepareTx and consumed by CAN_SendPrepared. The handle
+ * caches everything CAN_Send resolves on each call, so it must be prepared
+ * again after the buffer is reconfigured with CAN_ConfigTxBuff.
+ * Implements : can_tx_handle_t_Class
+ */
+typedef struct
+{
+    can_instance_t instance;              /*!< CAN instance the buffer belongs to */
+    uint32_t hwBuffIdx;                   /*!< Hardware buffer index, Rx FIFO offset applied */
+    uint32_t id;                          /*!< ID of the transmitted frames */
+#if (defined(CAN_OVER_FLEXCAN))
+    flexcan_data_info_t dataInfo;         /*!< Pre-built FlexCAN frame descriptor */
+#endif
+} can_tx_handle_t;
+
 /*******************************************************************************
  * API
  ******************************************************************************/
@@ -244,6 +262,46 @@ status_t CAN_Send(can_instance_t instance,
                   uint32_t buffIdx,
                   const can_message_t *message);
 
+/*!
+ * @brief Prepares a handle for repeated transmission on a buffer.
+ *
+ * This function resolves the buffer configuration, the hardware buffer index,
+ * the frame ID and the payload length once and stores them in the handle, so
+ * that CAN_SendPrepared only has to hand the payload to the driver. The buffer
+ * must have been configured for transmission with CAN_ConfigTxBuff.
+ *
+ * @param[in] instance  Instance number.
+ * @param[in] buffIdx buffer index.
+ * @param[in] id ID of the frames sent through the handle.
+ * @param[in] length payload length in bytes of the frames sent through the handle.
+ * @param[out] handle the prepared transmit handle.
+ * @return STATUS_SUCCESS if successful;
+ *         STATUS_CAN_BUFF_OUT_OF_RANGE if the buffer index is out of range;
+ *         STATUS_ERROR if invalid instance number is used;
+ */
+status_t CAN_PrepareTx(can_instance_t instance,
+                       uint32_t buffIdx,
+                       uint32_t id,
+                       uint8_t length,
+                       can_tx_handle_t *handle);
+
+/*!
+ * @brief Sends a CAN frame using a prepared handle.
+ *
+ * This function behaves like CAN_Send, but takes the buffer mapping, the ID
+ * and the frame format from a handle filled in by CAN_PrepareTx. The function
+ * returns immediately. If a callback is installed, it will be invoked after
+ * the frame was sent.
+ *
+ * @param[in] handle the prepared transmit handle.
+ * @param[in] data payload of the frame, as many bytes as given to CAN_PrepareTx.
+ * @return STATUS_SUCCESS if successful;
+ *         STATUS_BUSY if the current buffer is involved in another transfer;
+ *         STATUS_ERROR if invalid instance number is used;
+ */
+status_t CAN_SendPrepared(const can_tx_handle_t *handle,
+                          const uint8_t *data);
+
 /*!
  * @brief Sends a CAN frame using the specified buffer, in a blocking manner.
  *
@@ -557,6 +557,88 @@ status_t CAN_Send(can_instance_t instance,
     return status;
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CAN_PrepareTx
+ * Description   : Resolves the buffer mapping and frame format of a transmit
+ *                 buffer once, for use with CAN_SendPrepared.
+ *
+ * Implements    : CAN_PrepareTx_Activity
+ *END**************************************************************************/
+status_t CAN_PrepareTx(can_instance_t instance,
+                       uint32_t buffIdx,
+                       uint32_t id,
+                       uint8_t length,
+                       can_tx_handle_t *handle)
+{
+    DEV_ASSERT(handle != NULL);
+
+    status_t status = STATUS_ERROR;
+
+    /* Define CAN PAL over FLEXCAN */
+    #if defined(CAN_OVER_FLEXCAN)
+    if ((uint8_t)instance <= FLEXCAN_HIGH_INDEX)
+    {
+        /* If Rx FIFO is enabled, buffer 0 (zero) can only be used for reception */
+        DEV_ASSERT((s_flexcanRxFifoState[instance].rxFifoEn == false) || (buffIdx != 0U));
+        /* Check buffer index to avoid overflow */
+        DEV_ASSERT(buffIdx < FEATURE_CAN_MAX_MB_NUM);
+
+        const can_buff_config_t *config = s_hwObjConfigs[instance][buffIdx];
+        DEV_ASSERT(config != NULL);
+
+        handle->instance = instance;
+        handle->id = id;
+        handle->dataInfo.msg_id_type = (flexcan_msgbuff_id_type_t) config->idType;
+        handle->dataInfo.data_length = length;
+        handle->dataInfo.fd_enable = config->enableFD;
+        handle->dataInfo.fd_padding = config->fdPadding;
+        handle->dataInfo.enable_brs = config->enableBRS;
+        handle->dataInfo.is_remote = config->isRemote;
+
+        /* Compute virtual buffer index */
+        if (s_flexcanRxFifoState[instance].rxFifoEn)
+        {
+            buffIdx += CAN_GetVirtualBuffIdx(s_flexcanRxFifoState[instance].numIdFilters);
+        }
+        handle->hwBuffIdx = buffIdx;
+
+        status = STATUS_SUCCESS;
+    }
+    #endif
+
+    return status;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : CAN_SendPrepared
+ * Description   : Sends a CAN frame using a handle prepared by CAN_PrepareTx.
+ *
+ * Implements    : CAN_SendPrepared_Activity
+ *END**************************************************************************/
+status_t CAN_SendPrepared(const can_tx_handle_t *handle,
+                          const uint8_t *data)
+{
+    DEV_ASSERT(handle != NULL);
+
+    status_t status = STATUS_ERROR;
+
+    /* Define CAN PAL over FLEXCAN */
+    #if defined(CAN_OVER_FLEXCAN)
+    if ((uint8_t)handle->instance <= FLEXCAN_HIGH_INDEX)
+    {
+        status = FLEXCAN_DRV_Send((uint8_t) handle->instance,
+                                  (uint8_t) handle->hwBuffIdx,
+                                  &handle->dataInfo,
+                                  handle->id,
+                                  data);
+    }
+    #endif
+
+    return status;
+}
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : CAN_SendBlocking
@@ -38,6 +38,12 @@
  * @addtogroup security_pal_driver Security PAL
  * @ingroup security_pal
  * @brief Security Peripheral Abstraction Layer
+ *
+ * The backend is selected in security_pal_cfg.h. SECURITY_OVER_SOFTWARE runs the
+ * blocking AES-128 and CMAC operations in software, e.g. on a host; the other
+ * operations return STATUS_UNSUPPORTED. With SECURITY_OVER_CSEC, defining
+ * SECURITY_SOFTWARE_OVERFLOW lets the blocking RAM key operations run in software
+ * when the CSEc is busy, provided the key was loaded with SECURITY_LoadPlainKey.
  * @{
  */
 
@@ -76,7 +82,7 @@ typedef enum
     SECURITY_KEY_10,
 #if (defined(SECURITY_OVER_HSM))
 	SECURITY_RAM_KEY = 0xEU,
-#elif (defined(SECURITY_OVER_CSEC))
+#elif (defined(SECURITY_OVER_CSEC) || defined(SECURITY_OVER_SOFTWARE))
     SECURITY_RAM_KEY = 0xFU,
 #endif
     SECURITY_KEY_11 = 0x14U,
@@ -125,7 +131,7 @@ typedef enum {
     SECURITY_CMD_INIT_RNG,
     SECURITY_CMD_EXTEND_SEED,
     SECURITY_CMD_RND,
-#if (defined(SECURITY_OVER_CSEC))
+#if (defined(SECURITY_OVER_CSEC) || defined(SECURITY_OVER_SOFTWARE))
     SECURITY_CMD_RESERVED_1,
 #elif (defined(SECURITY_OVER_HSM))
     SECURITY_CMD_SECURE_BOOT,
@@ -133,14 +139,14 @@ typedef enum {
     SECURITY_CMD_BOOT_FAILURE,
     SECURITY_CMD_BOOT_OK,
     SECURITY_CMD_GET_ID,
-#if (defined(SECURITY_OVER_CSEC))
+#if (defined(SECURITY_OVER_CSEC) || defined(SECURITY_OVER_SOFTWARE))
 	SECURITY_CMD_BOOT_DEFINE,
 #elif (defined(SECURITY_OVER_HSM))
     SECURITY_CMD_BOOT_CANCEL,
 #endif
     SECURITY_CMD_DBG_CHAL,
     SECURITY_CMD_DBG_AUTH,
-#if (defined(SECURITY_OVER_CSEC))
+#if (defined(SECURITY_OVER_CSEC) || defined(SECURITY_OVER_SOFTWARE))
     SECURITY_CMD_RESERVED_2,
     SECURITY_CMD_RESERVED_3,
     SECURITY_CMD_MP_COMPRESS
@@ -55,6 +55,12 @@
     #include "csec_driver.h"
 #elif (defined (SECURITY_OVER_HSM))
     #include "hsm_driver.h"
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    #include "swcrypto_driver.h"
+#endif
+
+#if (defined (SECURITY_OVER_CSEC) && defined (SECURITY_SOFTWARE_OVERFLOW))
+    #include "swcrypto_driver.h"
 #endif
 
 #if (defined (SECURITY_OVER_CSEC))
@@ -65,6 +71,17 @@
     #define NO_OF_INSTS_FOR_SECURITY_PAL    NO_OF_HSM_INSTS_FOR_SECURITY
     static bool g_bHsmStateIsAllocated[NO_OF_INSTS_FOR_SECURITY_PAL];
     static security_instance_t g_tHsmInstance[NO_OF_INSTS_FOR_SECURITY_PAL];
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    #define NO_OF_INSTS_FOR_SECURITY_PAL    NO_OF_SOFTWARE_INSTS_FOR_SECURITY
+    static bool g_bSwcryptoStateIsAllocated[NO_OF_INSTS_FOR_SECURITY_PAL];
+    static security_instance_t g_tSwcryptoInstance[NO_OF_INSTS_FOR_SECURITY_PAL];
+#endif
+
+#if (defined (SECURITY_OVER_CSEC) && defined (SECURITY_SOFTWARE_OVERFLOW))
+    /* Software engine taking over the RAM key operations while the CSEc is busy */
+    static swcrypto_state_t g_tOverflowState;
+    /* Specifies if the RAM key of the CSEc is also loaded in the software engine */
+    static bool g_bRamKeyMirrored;
 #endif
 
 /*FUNCTION**********************************************************************
@@ -145,6 +162,24 @@ static status_t SecurityGetInstance(const bool * isAllocated,
     return STATUS_ERROR;
 }
 
+#if (defined (SECURITY_OVER_CSEC) && defined (SECURITY_SOFTWARE_OVERFLOW))
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : SecurityUseSoftware
+ * Description   : Checks if an operation rejected by the CSEc can be performed
+ *                 by the software engine instead. Only the RAM key is mirrored,
+ *                 the other keys never leave the CSEc.
+ *
+ *END**************************************************************************/
+static bool SecurityUseSoftware(status_t status,
+                                security_key_id_t keyId)
+{
+    return ((STATUS_BUSY == status) &&
+            (SECURITY_RAM_KEY == keyId) &&
+            g_bRamKeyMirrored);
+}
+#endif
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : SECURITY_Init
@@ -175,6 +210,10 @@ status_t SECURITY_Init(security_instance_t instance,
     }
     (void)CSEC_DRV_Init(&s_tCsecState[stateInsts]);
     (void)CSEC_DRV_InstallCallback(config->callback, config->callbackParam);
+#if (defined (SECURITY_SOFTWARE_OVERFLOW))
+    SWCRYPTO_DRV_Init(&g_tOverflowState);
+    g_bRamKeyMirrored = false;
+#endif
 #elif (defined (SECURITY_OVER_HSM))
 	static hsm_state_t s_tHsmState[NO_OF_INSTS_FOR_SECURITY_PAL];
 
@@ -194,6 +233,21 @@ status_t SECURITY_Init(security_instance_t instance,
         return STATUS_ERROR;
     }
     (void)HSM_DRV_InstallCallback(config->callback, config->callbackParam);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    static swcrypto_state_t s_tSwcryptoState[NO_OF_INSTS_FOR_SECURITY_PAL];
+
+    status = SecurityAllocateInstance(g_bSwcryptoStateIsAllocated, g_tSwcryptoInstance, SECURITY_INSTANCE0, NO_OF_INSTS_FOR_SECURITY_PAL);
+    if (STATUS_SUCCESS != status)
+    {
+        return STATUS_ERROR;
+    }
+    status = SecurityGetInstance(g_bSwcryptoStateIsAllocated, g_tSwcryptoInstance, SECURITY_INSTANCE0, NO_OF_INSTS_FOR_SECURITY_PAL, &stateInsts);
+    if (STATUS_SUCCESS != status)
+    {
+        return STATUS_ERROR;
+    }
+    SWCRYPTO_DRV_Init(&s_tSwcryptoState[stateInsts]);
+    (void)config;
 #endif
 
     return status;
@@ -216,6 +270,10 @@ status_t SECURITY_Deinit(security_instance_t instance)
 #if (defined (SECURITY_OVER_CSEC))
     (void)instance;
     (void)CSEC_DRV_Deinit();
+#if (defined (SECURITY_SOFTWARE_OVERFLOW))
+    SWCRYPTO_DRV_Deinit();
+    g_bRamKeyMirrored = false;
+#endif
     status = SecurityFreeInstance(g_bCsecStateIsAllocated, g_tCsecInstance, SECURITY_INSTANCE0, NO_OF_INSTS_FOR_SECURITY_PAL);
     if (STATUS_SUCCESS != status)
     {
@@ -233,6 +291,14 @@ status_t SECURITY_Deinit(security_instance_t instance)
     {
         return STATUS_ERROR;
     }
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    SWCRYPTO_DRV_Deinit();
+    status = SecurityFreeInstance(g_bSwcryptoStateIsAllocated, g_tSwcryptoInstance, SECURITY_INSTANCE0, NO_OF_INSTS_FOR_SECURITY_PAL);
+    if (STATUS_SUCCESS != status)
+    {
+        return STATUS_ERROR;
+    }
 #endif
 
     return status;
@@ -260,9 +326,19 @@ status_t SECURITY_EncryptEcbBlocking(security_instance_t instance,
 #if (defined (SECURITY_OVER_CSEC))
     (void)instance;
     status = CSEC_DRV_EncryptECB((csec_key_id_t)keyId, plainText, msgLen, cipherText, timeout);
+#if (defined (SECURITY_SOFTWARE_OVERFLOW))
+    if (SecurityUseSoftware(status, keyId))
+    {
+        status = SWCRYPTO_DRV_EncryptECB((uint32_t)keyId, plainText, msgLen, cipherText);
+    }
+#endif
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_EncryptECB((hsm_key_id_t)keyId, plainText, msgLen, cipherText, timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)timeout;
+    status = SWCRYPTO_DRV_EncryptECB((uint32_t)keyId, plainText, msgLen, cipherText);
 #endif
 
     return status;
@@ -290,9 +366,19 @@ status_t SECURITY_DecryptEcbBlocking(security_instance_t instance,
 #if (defined (SECURITY_OVER_CSEC))
     (void)instance;
     status = CSEC_DRV_DecryptECB((csec_key_id_t)keyId, cipherText, msgLen, plainText, timeout);
+#if (defined (SECURITY_SOFTWARE_OVERFLOW))
+    if (SecurityUseSoftware(status, keyId))
+    {
+        status = SWCRYPTO_DRV_DecryptECB((uint32_t)keyId, cipherText, msgLen, plainText);
+    }
+#endif
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_DecryptECB((hsm_key_id_t)keyId, cipherText, msgLen, plainText, timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)timeout;
+    status = SWCRYPTO_DRV_DecryptECB((uint32_t)keyId, cipherText, msgLen, plainText);
 #endif
 
     return status;
@@ -321,9 +407,19 @@ status_t SECURITY_EncryptCbcBlocking(security_instance_t instance,
 #if (defined (SECURITY_OVER_CSEC))
     (void)instance;
     status = CSEC_DRV_EncryptCBC((csec_key_id_t)keyId, plainText, msgLen, iv, cipherText, timeout);
+#if (defined (SECURITY_SOFTWARE_OVERFLOW))
+    if (SecurityUseSoftware(status, keyId))
+    {
+        status = SWCRYPTO_DRV_EncryptCBC((uint32_t)keyId, plainText, msgLen, iv, cipherText);
+    }
+#endif
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_EncryptCBC((hsm_key_id_t)keyId, plainText, msgLen, iv, cipherText, timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)timeout;
+    status = SWCRYPTO_DRV_EncryptCBC((uint32_t)keyId, plainText, msgLen, iv, cipherText);
 #endif
 
     return status;
@@ -352,9 +448,19 @@ status_t SECURITY_DecryptCbcBlocking(security_instance_t instance,
 #if (defined (SECURITY_OVER_CSEC))
     (void)instance;
     status = CSEC_DRV_DecryptCBC((csec_key_id_t)keyId, cipherText, msgLen, iv, plainText, timeout);
+#if (defined (SECURITY_SOFTWARE_OVERFLOW))
+    if (SecurityUseSoftware(status, keyId))
+    {
+        status = SWCRYPTO_DRV_DecryptCBC((uint32_t)keyId, cipherText, msgLen, iv, plainText);
+    }
+#endif
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_DecryptCBC((hsm_key_id_t)keyId, cipherText, msgLen, iv, plainText, timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)timeout;
+    status = SWCRYPTO_DRV_DecryptCBC((uint32_t)keyId, cipherText, msgLen, iv, plainText);
 #endif
 
     return status;
@@ -375,7 +481,7 @@ status_t SECURITY_GenerateMacBlocking(security_instance_t instance,
                                       uint32_t timeout)
 {
     DEV_ASSERT((uint32_t)NO_OF_INSTS_FOR_SECURITY_PAL > ((uint32_t)instance));
-#if (defined (SECURITY_OVER_CSEC))
+#if (defined (SECURITY_OVER_CSEC) || defined (SECURITY_OVER_SOFTWARE))
 	DEV_ASSERT((uint64_t)0xFFFFFFFFU >= msgLen);
 #endif
 
@@ -384,9 +490,19 @@ status_t SECURITY_GenerateMacBlocking(security_instance_t instance,
 #if (defined (SECURITY_OVER_CSEC))
     (void)instance;
     status = CSEC_DRV_GenerateMAC((csec_key_id_t)keyId, msg, (uint32_t)msgLen, cmac, timeout);
+#if (defined (SECURITY_SOFTWARE_OVERFLOW))
+    if (SecurityUseSoftware(status, keyId))
+    {
+        status = SWCRYPTO_DRV_GenerateMAC((uint32_t)keyId, msg, (uint32_t)msgLen, cmac);
+    }
+#endif
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_GenerateMAC((hsm_key_id_t)keyId, msg, msgLen, cmac, timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)timeout;
+    status = SWCRYPTO_DRV_GenerateMAC((uint32_t)keyId, msg, (uint32_t)msgLen, cmac);
 #endif
 
     return status;
@@ -409,7 +525,7 @@ status_t SECURITY_VerifyMacBlocking(security_instance_t instance,
                                     uint32_t timeout)
 {
     DEV_ASSERT((uint32_t)NO_OF_INSTS_FOR_SECURITY_PAL > ((uint32_t)instance));
-#if (defined (SECURITY_OVER_CSEC))
+#if (defined (SECURITY_OVER_CSEC) || defined (SECURITY_OVER_SOFTWARE))
 	DEV_ASSERT((uint64_t)0xFFFFFFFFU >= msgLen);
 #endif
 
@@ -418,9 +534,19 @@ status_t SECURITY_VerifyMacBlocking(security_instance_t instance,
 #if (defined (SECURITY_OVER_CSEC))
     (void)instance;
     status = CSEC_DRV_VerifyMAC((csec_key_id_t)keyId, msg, (uint32_t)msgLen, mac, macLen, verifStatus, timeout);
+#if (defined (SECURITY_SOFTWARE_OVERFLOW))
+    if (SecurityUseSoftware(status, keyId))
+    {
+        status = SWCRYPTO_DRV_VerifyMAC((uint32_t)keyId, msg, (uint32_t)msgLen, mac, macLen, verifStatus);
+    }
+#endif
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_VerifyMAC((hsm_key_id_t)keyId, msg, msgLen, mac, macLen, verifStatus, timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)timeout;
+    status = SWCRYPTO_DRV_VerifyMAC((uint32_t)keyId, msg, (uint32_t)msgLen, mac, macLen, verifStatus);
 #endif
 
     return status;
@@ -450,9 +576,26 @@ status_t SECURITY_LoadKey(security_instance_t instance,
     (void)instance;
     (void)timeout;
     status = CSEC_DRV_LoadKey((csec_key_id_t)keyId, m1, m2, m3, m4, m5);
+#if (defined (SECURITY_SOFTWARE_OVERFLOW))
+    if ((STATUS_SUCCESS == status) && (SECURITY_RAM_KEY == keyId))
+    {
+        /* The new RAM key is only known to the CSEc */
+        g_bRamKeyMirrored = false;
+    }
+#endif
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_LoadKey((hsm_key_id_t)keyId, m1, m2, m3, m4, m5, timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)keyId;
+    (void)m1;
+    (void)m2;
+    (void)m3;
+    (void)m4;
+    (void)m5;
+    (void)timeout;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -477,9 +620,21 @@ status_t SECURITY_LoadPlainKey(security_instance_t instance,
     (void)instance;
     (void)timeout;
     status = CSEC_DRV_LoadPlainKey(plainKey);
+#if (defined (SECURITY_SOFTWARE_OVERFLOW))
+    if (STATUS_SUCCESS == status)
+    {
+        SWCRYPTO_DRV_LoadKey(SWCRYPTO_RAM_KEY, plainKey);
+        g_bRamKeyMirrored = true;
+    }
+#endif
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_LoadPlainKey(plainKey, timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)timeout;
+    SWCRYPTO_DRV_LoadKey(SWCRYPTO_RAM_KEY, plainKey);
+    status = STATUS_SUCCESS;
 #endif
 
     return status;
@@ -511,6 +666,15 @@ status_t SECURITY_ExportRamKey(security_instance_t instance,
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_ExportRAMKey(m1, m2, m3, m4, m5, timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)m1;
+    (void)m2;
+    (void)m3;
+    (void)m4;
+    (void)m5;
+    (void)timeout;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -538,6 +702,11 @@ status_t SECURITY_ExtendSeed(security_instance_t instance,
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_ExtendSeed(entropy, timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)entropy;
+    (void)timeout;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -564,6 +733,10 @@ status_t SECURITY_InitRng(security_instance_t instance,
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_InitRNG(timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)timeout;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -591,6 +764,11 @@ status_t SECURITY_GenerateRnd(security_instance_t instance,
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_GenerateRND(rnd, timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)rnd;
+    (void)timeout;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -622,6 +800,14 @@ status_t SECURITY_GetId(security_instance_t instance,
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_GetID(challenge, uid, sreg, mac, timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)challenge;
+    (void)uid;
+    (void)sreg;
+    (void)mac;
+    (void)timeout;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -649,6 +835,10 @@ status_t SECURITY_BootFailure(security_instance_t instance,
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_BootFailure(timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)timeout;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -676,6 +866,10 @@ status_t SECURITY_BootOk(security_instance_t instance,
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_BootOK(timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)timeout;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -708,6 +902,12 @@ status_t SECURITY_BootDefine(security_instance_t instance,
     (void)bootFlavor;
     (void)timeout;
     status = STATUS_UNSUPPORTED;
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)bootSize;
+    (void)bootFlavor;
+    (void)timeout;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -737,6 +937,11 @@ status_t SECURITY_DbgChal(security_instance_t instance,
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_DbgChal(challenge, timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)challenge;
+    (void)timeout;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -765,6 +970,11 @@ status_t SECURITY_DbgAuth(security_instance_t instance,
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_DbgAuth(authorization, timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)authorization;
+    (void)timeout;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -798,6 +1008,13 @@ status_t SECURITY_MPCompress(security_instance_t instance,
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_MPCompress(msg, (uint16_t)msgLen, mpCompress, timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)msg;
+    (void)msgLen;
+    (void)mpCompress;
+    (void)timeout;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -826,6 +1043,11 @@ status_t SECURITY_GenerateTrnd(security_instance_t instance,
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_GenerateTRND(trnd, timeout);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)trnd;
+    (void)timeout;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -851,6 +1073,9 @@ status_t SECURITY_CancelCommand(security_instance_t instance)
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_CancelCommand();
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    status = STATUS_SUCCESS;
 #endif
 
     return status;
@@ -875,6 +1100,9 @@ status_t SECURITY_GetAsyncCmdStatus(security_instance_t instance)
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_GetAsyncCmdStatus();
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -904,6 +1132,13 @@ status_t SECURITY_EncryptEcb(security_instance_t instance,
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_EncryptECBAsync((hsm_key_id_t)keyId, plainText, msgLen, cipherText);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)keyId;
+    (void)plainText;
+    (void)msgLen;
+    (void)cipherText;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -933,6 +1168,13 @@ status_t SECURITY_DecryptEcb(security_instance_t instance,
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_DecryptECBAsync((hsm_key_id_t)keyId, cipherText, msgLen, plainText);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)keyId;
+    (void)cipherText;
+    (void)msgLen;
+    (void)plainText;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -963,6 +1205,14 @@ status_t SECURITY_EncryptCbc(security_instance_t instance,
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_EncryptCBCAsync((hsm_key_id_t)keyId, plainText, msgLen, iv, cipherText);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)keyId;
+    (void)plainText;
+    (void)msgLen;
+    (void)iv;
+    (void)cipherText;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -993,6 +1243,14 @@ status_t SECURITY_DecryptCbc(security_instance_t instance,
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_DecryptCBCAsync((hsm_key_id_t)keyId, cipherText, msgLen, iv, plainText);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)keyId;
+    (void)cipherText;
+    (void)msgLen;
+    (void)iv;
+    (void)plainText;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -1013,7 +1271,7 @@ status_t SECURITY_GenerateMac(security_instance_t instance,
                               uint8_t *cmac)
 {
     DEV_ASSERT((uint32_t)NO_OF_INSTS_FOR_SECURITY_PAL > ((uint32_t)instance));
-#if (defined (SECURITY_OVER_CSEC))
+#if (defined (SECURITY_OVER_CSEC) || defined (SECURITY_OVER_SOFTWARE))
 	DEV_ASSERT((uint64_t)0xFFFFFFFFU >= msgLen);
 #endif
 
@@ -1025,6 +1283,13 @@ status_t SECURITY_GenerateMac(security_instance_t instance,
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_GenerateMACAsync((hsm_key_id_t)keyId, msg, msgLen, cmac);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)keyId;
+    (void)msg;
+    (void)msgLen;
+    (void)cmac;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -1047,7 +1312,7 @@ status_t SECURITY_VerifyMac(security_instance_t instance,
                             bool *verifStatus)
 {
     DEV_ASSERT((uint32_t)NO_OF_INSTS_FOR_SECURITY_PAL > ((uint32_t)instance));
-#if (defined (SECURITY_OVER_CSEC))
+#if (defined (SECURITY_OVER_CSEC) || defined (SECURITY_OVER_SOFTWARE))
 	DEV_ASSERT((uint64_t)0xFFFFFFFFU >= msgLen);
 #endif
 
@@ -1059,6 +1324,15 @@ status_t SECURITY_VerifyMac(security_instance_t instance,
 #elif (defined (SECURITY_OVER_HSM))
     (void)instance;
     status = HSM_DRV_VerifyMACAsync((hsm_key_id_t)keyId, msg, msgLen, mac, macLen, verifStatus);
+#elif (defined (SECURITY_OVER_SOFTWARE))
+    (void)instance;
+    (void)keyId;
+    (void)msg;
+    (void)msgLen;
+    (void)mac;
+    (void)macLen;
+    (void)verifStatus;
+    status = STATUS_UNSUPPORTED;
 #endif
 
     return status;
@@ -0,0 +1,565 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * Tests of the CSEc driver on the CSEc model, whose cipher is the software
+ * AES-128: the commands are checked against the NIST SP 800-38A/38B vectors,
+ * and the seal operation is checked to chain its three commands and to
+ * produce a payload that the CSEc decrypts and authenticates.
+ */
+
+#include <string.h>
+#include "host.h"
+#include "host_csec.h"
+#include "csec_driver.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define TIMEOUT_MS      100U
+#define SEAL_SIZE       64U
+#define IMAGE_SIZE      512U
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static csec_state_t s_state;
+static uint32_t s_callbacks;
+static uint32_t s_lastCmd;
+
+/* Jobs in their order of completion */
+static csec_job_t *s_done[8];
+static uint32_t s_doneCount;
+
+/* Image check results */
+static uint8_t s_image[IMAGE_SIZE];
+static uint32_t s_checks;
+static status_t s_checkStatus;
+static bool s_checkVerified;
+
+/* NIST SP 800-38A, F.1.1/F.2.1, and SP 800-38B, D.1 */
+static const uint8_t s_key[16] = {
+    0x2BU, 0x7EU, 0x15U, 0x16U, 0x28U, 0xAEU, 0xD2U, 0xA6U, 0xABU, 0xF7U, 0x15U, 0x88U, 0x09U, 0xCFU, 0x4FU, 0x3CU
+};
+static const uint8_t s_iv[16] = {
+    0x00U, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U, 0x07U, 0x08U, 0x09U, 0x0AU, 0x0BU, 0x0CU, 0x0DU, 0x0EU, 0x0FU
+};
+static const uint8_t s_plain[64] = {
+    0x6BU, 0xC1U, 0xBEU, 0xE2U, 0x2EU, 0x40U, 0x9FU, 0x96U, 0xE9U, 0x3DU, 0x7EU, 0x11U, 0x73U, 0x93U, 0x17U, 0x2AU,
+    0xAEU, 0x2DU, 0x8AU, 0x57U, 0x1EU, 0x03U, 0xACU, 0x9CU, 0x9EU, 0xB7U, 0x6FU, 0xACU, 0x45U, 0xAFU, 0x8EU, 0x51U,
+    0x30U, 0xC8U, 0x1CU, 0x46U, 0xA3U, 0x5CU, 0xE4U, 0x11U, 0xE5U, 0xFBU, 0xC1U, 0x19U, 0x1AU, 0x0AU, 0x52U, 0xEFU,
+    0xF6U, 0x9FU, 0x24U, 0x45U, 0xDFU, 0x4FU, 0x9BU, 0x17U, 0xADU, 0x2BU, 0x41U, 0x7BU, 0xE6U, 0x6CU, 0x37U, 0x10U
+};
+static const uint8_t s_ecb[64] = {
+    0x3AU, 0xD7U, 0x7BU, 0xB4U, 0x0DU, 0x7AU, 0x36U, 0x60U, 0xA8U, 0x9EU, 0xCAU, 0xF3U, 0x24U, 0x66U, 0xEFU, 0x97U,
+    0xF5U, 0xD3U, 0xD5U, 0x85U, 0x03U, 0xB9U, 0x69U, 0x9DU, 0xE7U, 0x85U, 0x89U, 0x5AU, 0x96U, 0xFDU, 0xBAU, 0xAFU,
+    0x43U, 0xB1U, 0xCDU, 0x7FU, 0x59U, 0x8EU, 0xCEU, 0x23U, 0x88U, 0x1BU, 0x00U, 0xE3U, 0xEDU, 0x03U, 0x06U, 0x88U,
+    0x7BU, 0x0CU, 0x78U, 0x5EU, 0x27U, 0xE8U, 0xADU, 0x3FU, 0x82U, 0x23U, 0x20U, 0x71U, 0x04U, 0x72U, 0x5DU, 0xD4U
+};
+static const uint8_t s_cbc[64] = {
+    0x76U, 0x49U, 0xABU, 0xACU, 0x81U, 0x19U, 0xB2U, 0x46U, 0xCEU, 0xE9U, 0x8EU, 0x9BU, 0x12U, 0xE9U, 0x19U, 0x7DU,
+    0x50U, 0x86U, 0xCBU, 0x9BU, 0x50U, 0x72U, 0x19U, 0xEEU, 0x95U, 0xDBU, 0x11U, 0x3AU, 0x91U, 0x76U, 0x78U, 0xB2U,
+    0x73U, 0xBEU, 0xD6U, 0xB8U, 0xE3U, 0xC1U, 0x74U, 0x3BU, 0x71U, 0x16U, 0xE6U, 0x9EU, 0x22U, 0x22U, 0x95U, 0x16U,
+    0x3FU, 0xF1U, 0xCAU, 0xA1U, 0x68U, 0x1FU, 0xACU, 0x09U, 0x12U, 0x0EU, 0xCAU, 0x30U, 0x75U, 0x86U, 0xE1U, 0xA7U
+};
+static const uint8_t s_cmac64[16] = {
+    0x51U, 0xF0U, 0xBEU, 0xBFU, 0x7EU, 0x3BU, 0x9DU, 0x92U, 0xFCU, 0x49U, 0x74U, 0x17U, 0x79U, 0x36U, 0x3CU, 0xFEU
+};
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+
+/* Starts the driver with the NIST key as RAM key and the RNG seeded */
+static void StartCsec(void)
+{
+    CSEC_DRV_Init(&s_state);
+    HOST_CHECK_EQ(CSEC_DRV_LoadPlainKey(s_key), STATUS_SUCCESS);
+    HOST_CHECK_EQ(CSEC_DRV_InitRNG(), STATUS_SUCCESS);
+    s_callbacks = 0U;
+    s_lastCmd = 0U;
+}
+
+static void CountCallback(uint32_t completedCmd, void *callbackParam)
+{
+    (void)callbackParam;
+    s_callbacks++;
+    s_lastCmd = completedCmd;
+}
+
+static void JobCallback(csec_job_t *job, void *callbackParam)
+{
+    (void)callbackParam;
+    if (s_doneCount < 8U)
+    {
+        s_done[s_doneCount] = job;
+    }
+    s_doneCount++;
+}
+
+/* Submits the job of the parameter from the callback of the first one */
+static void ChainCallback(csec_job_t *job, void *callbackParam)
+{
+    JobCallback(job, NULL);
+    CSEC_DRV_SubmitJob((csec_job_t *)callbackParam);
+}
+
+static void InitJob(csec_job_t *job, csec_cmd_t cmd, csec_job_priority_t priority,
+                    const uint8_t *input, uint32_t length, uint8_t *output)
+{
+    memset(job, 0, sizeof(*job));
+    job->cmd = cmd;
+    job->keyId = CSEC_RAM_KEY;
+    job->priority = priority;
+    job->input = input;
+    job->length = length;
+    job->output = output;
+    job->iv = s_iv;
+    job->callback = JobCallback;
+}
+
+static void ImageCheckCallback(status_t status, bool verifStatus, void *callbackParam)
+{
+    (void)callbackParam;
+    s_checks++;
+    s_checkStatus = status;
+    s_checkVerified = verifStatus;
+}
+
+/* Sets up the check of s_image against the MAC */
+static void InitImageCheck(csec_image_check_t *check, const uint8_t *mac, uint32_t maxCalls)
+{
+    csec_image_check_config_t config;
+    uint32_t i;
+
+    for (i = 0U; i < IMAGE_SIZE; i++)
+    {
+        s_image[i] = (uint8_t)(i * 7U);
+    }
+
+    memset(&config, 0, sizeof(config));
+    config.keyId = CSEC_RAM_KEY;
+    config.image = s_image;
+    config.msgLen = IMAGE_SIZE * 8U;
+    config.mac = mac;
+    config.sliceSize = 32U;
+    config.period = 2U;
+    config.maxCalls = maxCalls;
+    config.callback = ImageCheckCallback;
+    CSEC_DRV_InitImageCheck(check, &config);
+    s_checks = 0U;
+}
+
+/* Calls CSEC_DRV_RunImageCheck, with the CSEc running in between, until a
+ * verification completes; returns the number of calls */
+static uint32_t RunImageCheck(csec_image_check_t *check)
+{
+    uint32_t checks = s_checks;
+    uint32_t calls = 0U;
+
+    while ((s_checks == checks) && (calls < 1000U))
+    {
+        CSEC_DRV_RunImageCheck(check);
+        HOST_RunUntilIdle();
+        calls++;
+    }
+
+    return calls;
+}
+
+/* Completes the commands one at a time, delivering the FTFC interrupt after each */
+static void StepCommands(uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        HOST_CHECK(HOST_CSEC_CompleteCommand());
+        HOST_RunUntilIdle();
+    }
+}
+
+/* Checks that the payload decrypts to the plain text and authenticates */
+static void CheckPayload(const uint8_t *payload, const uint8_t *plainText, uint32_t length)
+{
+    uint8_t decrypted[CSEC_SEAL_MAX_DATA_SIZE];
+    bool verified = false;
+
+    HOST_CHECK_EQ(CSEC_DRV_DecryptCBC(CSEC_RAM_KEY, &payload[CSEC_SEAL_OVERHEAD_SIZE], length, &payload[16],
+                                      decrypted, TIMEOUT_MS), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(decrypted, plainText, length) == 0);
+    HOST_CHECK_EQ(CSEC_DRV_VerifyMAC(CSEC_RAM_KEY, &payload[16], (length + 16U) * 8U, payload, 0U,
+                                     &verified, TIMEOUT_MS), STATUS_SUCCESS);
+    HOST_CHECK(verified);
+}
+
+/* Checks the commands logged from the given index */
+static void CheckCommands(uint32_t first, const uint8_t *cmds, uint32_t count)
+{
+    uint32_t i;
+
+    HOST_CHECK_EQ(HOST_CSEC_CommandCount() - first, count);
+    for (i = 0U; i < count; i++)
+    {
+        HOST_CHECK_EQ(HOST_CSEC_GetCommand(first + i), cmds[i]);
+    }
+}
+
+/*******************************************************************************
+ * Model
+ ******************************************************************************/
+
+/* The commands of the model against the NIST vectors, over several calls */
+static void TestModelVectors(void)
+{
+    uint8_t out[64];
+    bool verified = false;
+
+    StartCsec();
+
+    HOST_CHECK_EQ(CSEC_DRV_EncryptECB(CSEC_RAM_KEY, s_plain, 64U, out, TIMEOUT_MS), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(out, s_ecb, 64U) == 0);
+    HOST_CHECK_EQ(CSEC_DRV_DecryptECB(CSEC_RAM_KEY, s_ecb, 64U, out, TIMEOUT_MS), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(out, s_plain, 64U) == 0);
+    HOST_CHECK_EQ(CSEC_DRV_EncryptCBC(CSEC_RAM_KEY, s_plain, 64U, s_iv, out, TIMEOUT_MS), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(out, s_cbc, 64U) == 0);
+    HOST_CHECK_EQ(CSEC_DRV_DecryptCBC(CSEC_RAM_KEY, s_cbc, 64U, s_iv, out, TIMEOUT_MS), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(out, s_plain, 64U) == 0);
+    HOST_CHECK_EQ(CSEC_DRV_GenerateMAC(CSEC_RAM_KEY, s_plain, 64U * 8U, out, TIMEOUT_MS), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(out, s_cmac64, 16U) == 0);
+    HOST_CHECK_EQ(CSEC_DRV_VerifyMAC(CSEC_RAM_KEY, s_plain, 64U * 8U, s_cmac64, 0U, &verified, TIMEOUT_MS),
+                  STATUS_SUCCESS);
+    HOST_CHECK(verified);
+
+    /* An empty key slot and an unseeded RNG are reported */
+    HOST_CHECK_EQ(CSEC_DRV_EncryptECB(CSEC_KEY_1, s_plain, 16U, out, TIMEOUT_MS), STATUS_SEC_KEY_EMPTY);
+    HOST_Init();
+    CSEC_DRV_Init(&s_state);
+    HOST_CHECK_EQ(CSEC_DRV_GenerateRND(out), STATUS_SEC_RNG_SEED);
+
+    CSEC_DRV_Deinit();
+}
+
+/*******************************************************************************
+ * Seal
+ ******************************************************************************/
+
+/* The seal runs RND, ENC_CBC and GENERATE_MAC back to back */
+static void TestSeal(void)
+{
+    static const uint8_t cmds[] = { CSEC_CMD_RND, CSEC_CMD_ENC_CBC, CSEC_CMD_GENERATE_MAC };
+    uint8_t payload[CSEC_SEAL_OVERHEAD_SIZE + SEAL_SIZE];
+    uint8_t iv[16];
+    uint32_t first;
+
+    StartCsec();
+
+    first = HOST_CSEC_CommandCount();
+    HOST_CHECK_EQ(CSEC_DRV_Seal(CSEC_RAM_KEY, s_plain, SEAL_SIZE, payload, TIMEOUT_MS), STATUS_SUCCESS);
+    CheckCommands(first, cmds, 3U);
+    CheckPayload(payload, s_plain, SEAL_SIZE);
+
+    /* A fresh IV for each payload */
+    memcpy(iv, &payload[16], 16U);
+    HOST_CHECK_EQ(CSEC_DRV_Seal(CSEC_RAM_KEY, s_plain, 16U, payload, TIMEOUT_MS), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(iv, &payload[16], 16U) != 0);
+    CheckPayload(payload, s_plain, 16U);
+
+    CSEC_DRV_Deinit();
+}
+
+/* The asynchronous seal chains its commands from the FTFC interrupt and calls
+ * the callback once, at the end */
+static void TestSealAsync(void)
+{
+    static const uint8_t cmds[] = { CSEC_CMD_RND, CSEC_CMD_ENC_CBC, CSEC_CMD_GENERATE_MAC };
+    uint8_t payload[CSEC_SEAL_OVERHEAD_SIZE + CSEC_SEAL_MAX_DATA_SIZE];
+    uint8_t plainText[CSEC_SEAL_MAX_DATA_SIZE];
+    host_stats_t stats;
+    uint32_t first;
+
+    StartCsec();
+    CSEC_DRV_InstallCallback(CountCallback, NULL);
+    memcpy(plainText, s_plain, 64U);
+    memcpy(&plainText[64], s_plain, 32U);
+
+    first = HOST_CSEC_CommandCount();
+    HOST_ResetStats();
+    HOST_CHECK_EQ(CSEC_DRV_SealAsync(CSEC_RAM_KEY, plainText, CSEC_SEAL_MAX_DATA_SIZE, payload), STATUS_SUCCESS);
+    HOST_CHECK_EQ(CSEC_DRV_GetAsyncCmdStatus(), STATUS_BUSY);
+    HOST_RunUntilIdle();
+    HOST_GetStats(&stats);
+
+    HOST_CHECK_EQ(stats.irqs, 3U);
+    HOST_CHECK_EQ(s_callbacks, 1U);
+    HOST_CHECK_EQ(s_lastCmd, CSEC_CMD_GENERATE_MAC);
+    HOST_CHECK_EQ(CSEC_DRV_GetAsyncCmdStatus(), STATUS_SUCCESS);
+    CheckCommands(first, cmds, 3U);
+    CheckPayload(payload, plainText, CSEC_SEAL_MAX_DATA_SIZE);
+
+    CSEC_DRV_Deinit();
+}
+
+/*******************************************************************************
+ * Job queue
+ ******************************************************************************/
+
+/* Queued jobs start by priority class, then in submission order, after the
+ * job in execution */
+static void TestJobPriority(void)
+{
+    static const uint8_t cmds[] = {
+        CSEC_CMD_ENC_ECB, CSEC_CMD_VERIFY_MAC, CSEC_CMD_GENERATE_MAC, CSEC_CMD_DEC_ECB
+    };
+    csec_job_t low1, low2, normal, high;
+    uint8_t encrypted[64];
+    uint8_t decrypted[64];
+    uint8_t mac[16];
+    bool verified = false;
+    uint32_t first;
+
+    StartCsec();
+    s_doneCount = 0U;
+    HOST_CSEC_SetAutoRun(false);
+
+    InitJob(&low1, CSEC_CMD_ENC_ECB, CSEC_JOB_PRIORITY_LOW, s_plain, 64U, encrypted);
+    InitJob(&low2, CSEC_CMD_DEC_ECB, CSEC_JOB_PRIORITY_LOW, s_ecb, 64U, decrypted);
+    InitJob(&normal, CSEC_CMD_GENERATE_MAC, CSEC_JOB_PRIORITY_NORMAL, s_plain, 64U * 8U, mac);
+    InitJob(&high, CSEC_CMD_VERIFY_MAC, CSEC_JOB_PRIORITY_HIGH, s_plain, 64U * 8U, NULL);
+    high.mac = s_cmac64;
+    high.verifStatus = &verified;
+
+    first = HOST_CSEC_CommandCount();
+    CSEC_DRV_SubmitJob(&low1);
+    HOST_CHECK(HOST_CSEC_IsBusy());
+    CSEC_DRV_SubmitJob(&low2);
+    CSEC_DRV_SubmitJob(&normal);
+    CSEC_DRV_SubmitJob(&high);
+    HOST_CHECK_EQ(HOST_CSEC_CommandCount() - first, 1U);
+    HOST_CHECK_EQ(high.status, STATUS_BUSY);
+
+    StepCommands(4U);
+    HOST_CHECK(!HOST_CSEC_IsBusy());
+    CheckCommands(first, cmds, 4U);
+
+    HOST_CHECK_EQ(s_doneCount, 4U);
+    HOST_CHECK(s_done[0] == &low1);
+    HOST_CHECK(s_done[1] == &high);
+    HOST_CHECK(s_done[2] == &normal);
+    HOST_CHECK(s_done[3] == &low2);
+    HOST_CHECK_EQ(low1.status, STATUS_SUCCESS);
+    HOST_CHECK_EQ(low2.status, STATUS_SUCCESS);
+    HOST_CHECK_EQ(normal.status, STATUS_SUCCESS);
+    HOST_CHECK_EQ(high.status, STATUS_SUCCESS);
+    HOST_CHECK(memcmp(encrypted, s_ecb, 64U) == 0);
+    HOST_CHECK(memcmp(decrypted, s_plain, 64U) == 0);
+    HOST_CHECK(memcmp(mac, s_cmac64, 16U) == 0);
+    HOST_CHECK(verified);
+
+    CSEC_DRV_Deinit();
+}
+
+/* A job submitted from the callback of another one starts from the same
+ * interrupt */
+static void TestSubmitFromCallback(void)
+{
+    csec_job_t first, second;
+    uint8_t encrypted[64];
+    uint8_t mac[16];
+    host_stats_t stats;
+
+    StartCsec();
+    s_doneCount = 0U;
+
+    InitJob(&first, CSEC_CMD_ENC_CBC, CSEC_JOB_PRIORITY_NORMAL, s_plain, 64U, encrypted);
+    InitJob(&second, CSEC_CMD_GENERATE_MAC, CSEC_JOB_PRIORITY_LOW, s_plain, 64U * 8U, mac);
+    first.callback = ChainCallback;
+    first.callbackParam = &second;
+
+    HOST_ResetStats();
+    CSEC_DRV_SubmitJob(&first);
+    HOST_RunUntilIdle();
+    HOST_GetStats(&stats);
+
+    HOST_CHECK_EQ(stats.irqs, 2U);
+    HOST_CHECK_EQ(s_doneCount, 2U);
+    HOST_CHECK(s_done[0] == &first);
+    HOST_CHECK(s_done[1] == &second);
+    HOST_CHECK_EQ(first.status, STATUS_SUCCESS);
+    HOST_CHECK_EQ(second.status, STATUS_SUCCESS);
+    HOST_CHECK(memcmp(encrypted, s_cbc, 64U) == 0);
+    HOST_CHECK(memcmp(mac, s_cmac64, 16U) == 0);
+
+    CSEC_DRV_Deinit();
+}
+
+/* Cancelling a job in the middle of its sequence breaks the sequence, fails
+ * the job and starts the next one */
+static void TestCancelJob(void)
+{
+    static const uint8_t cmds[] = {
+        CSEC_CMD_ENC_CBC, CSEC_CMD_ENC_CBC, CSEC_CMD_ENC_CBC, CSEC_CMD_ENC_ECB
+    };
+    csec_job_t bulk, next;
+    uint8_t bulkText[256];
+    uint8_t encrypted[256];
+    uint32_t first;
+    uint32_t i;
+
+    StartCsec();
+    s_doneCount = 0U;
+    HOST_CSEC_SetAutoRun(false);
+    for (i = 0U; i < 256U; i += 64U)
+    {
+        memcpy(&bulkText[i], s_plain, 64U);
+    }
+
+    /* The 256 bytes take three CBC commands */
+    InitJob(&bulk, CSEC_CMD_ENC_CBC, CSEC_JOB_PRIORITY_LOW, bulkText, 256U, encrypted);
+    InitJob(&next, CSEC_CMD_ENC_ECB, CSEC_JOB_PRIORITY_LOW, s_plain, 64U, &encrypted[128]);
+
+    first = HOST_CSEC_CommandCount();
+    CSEC_DRV_SubmitJob(&bulk);
+    CSEC_DRV_SubmitJob(&next);
+    StepCommands(1U);
+    HOST_CHECK_EQ(HOST_CSEC_CommandCount() - first, 2U);
+
+    CSEC_DRV_CancelCommand();
+    HOST_CHECK_EQ(bulk.status, STATUS_ERROR);
+    HOST_CHECK_EQ(next.status, STATUS_BUSY);
+
+    StepCommands(1U);
+    CheckCommands(first, cmds, 4U);
+    HOST_CHECK_EQ(next.status, STATUS_SUCCESS);
+    HOST_CHECK(memcmp(&encrypted[128], s_ecb, 64U) == 0);
+    HOST_CHECK_EQ(s_doneCount, 1U);
+    HOST_CHECK(s_done[0] == &next);
+
+    /* The CSEc accepts a new sequence afterwards */
+    HOST_CSEC_SetAutoRun(true);
+    HOST_CHECK_EQ(CSEC_DRV_EncryptCBC(CSEC_RAM_KEY, s_plain, 64U, s_iv, encrypted, TIMEOUT_MS), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(encrypted, s_cbc, 64U) == 0);
+
+    CSEC_DRV_Deinit();
+}
+
+/*******************************************************************************
+ * Image check
+ ******************************************************************************/
+
+/* The image is verified slice by slice, then again after the period */
+static void TestImageCheck(void)
+{
+    csec_image_check_t check;
+    uint8_t mac[16];
+    uint32_t calls;
+
+    StartCsec();
+    InitImageCheck(&check, mac, 0U);
+    HOST_CHECK_EQ(CSEC_DRV_GenerateMAC(CSEC_RAM_KEY, s_image, IMAGE_SIZE * 8U, mac, TIMEOUT_MS), STATUS_SUCCESS);
+
+    calls = RunImageCheck(&check);
+    HOST_CHECK_EQ(s_checks, 1U);
+    HOST_CHECK_EQ(s_checkStatus, STATUS_SUCCESS);
+    HOST_CHECK(s_checkVerified);
+    HOST_CHECK(calls > (IMAGE_SIZE / 32U));
+
+    /* The period, then a verification of the modified image */
+    s_image[100] ^= 0x01U;
+    HOST_CHECK_EQ(RunImageCheck(&check), calls + 2U);
+    HOST_CHECK_EQ(s_checks, 2U);
+    HOST_CHECK_EQ(s_checkStatus, STATUS_SUCCESS);
+    HOST_CHECK(!s_checkVerified);
+    HOST_CHECK_EQ(check.passed, 1U);
+    HOST_CHECK_EQ(check.failed, 1U);
+
+    CSEC_DRV_Deinit();
+}
+
+/* A verification which spans too many calls gives the CSEc back, to the job
+ * waiting for it and to the next sequence */
+static void TestImageCheckBound(void)
+{
+    csec_image_check_t check;
+    csec_job_t job;
+    uint8_t mac[16];
+    uint8_t encrypted[64];
+    uint32_t i;
+
+    StartCsec();
+    InitImageCheck(&check, mac, 6U);
+    HOST_CHECK_EQ(CSEC_DRV_GenerateMAC(CSEC_RAM_KEY, s_image, IMAGE_SIZE * 8U, mac, TIMEOUT_MS), STATUS_SUCCESS);
+    s_doneCount = 0U;
+
+    /* The session holds the CSEc between the calls */
+    for (i = 0U; i < 3U; i++)
+    {
+        CSEC_DRV_RunImageCheck(&check);
+        HOST_RunUntilIdle();
+    }
+    InitJob(&job, CSEC_CMD_ENC_ECB, CSEC_JOB_PRIORITY_HIGH, s_plain, 64U, encrypted);
+    CSEC_DRV_SubmitJob(&job);
+    HOST_RunUntilIdle();
+    HOST_CHECK_EQ(job.status, STATUS_BUSY);
+    HOST_CHECK_EQ(CSEC_DRV_EncryptECBAsync(CSEC_RAM_KEY, s_plain, 16U, encrypted), STATUS_BUSY);
+
+    HOST_CHECK_EQ(RunImageCheck(&check), 4U);
+    HOST_CHECK_EQ(s_checks, 1U);
+    HOST_CHECK_EQ(s_checkStatus, STATUS_TIMEOUT);
+    HOST_CHECK(!s_checkVerified);
+    HOST_CHECK_EQ(check.passed, 0U);
+    HOST_CHECK_EQ(check.failed, 0U);
+
+    HOST_CHECK_EQ(job.status, STATUS_SUCCESS);
+    HOST_CHECK(memcmp(encrypted, s_ecb, 64U) == 0);
+    HOST_CHECK_EQ(CSEC_DRV_EncryptCBC(CSEC_RAM_KEY, s_plain, 64U, s_iv, encrypted, TIMEOUT_MS), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(encrypted, s_cbc, 64U) == 0);
+
+    /* A verification within the bound passes */
+    check.config.maxCalls = 100U;
+    (void)RunImageCheck(&check);
+    HOST_CHECK_EQ(s_checks, 2U);
+    HOST_CHECK_EQ(s_checkStatus, STATUS_SUCCESS);
+    HOST_CHECK(s_checkVerified);
+
+    CSEC_DRV_Deinit();
+}
+
+/*******************************************************************************
+ * Main
+ ******************************************************************************/
+
+static const host_test_t s_tests[] = {
+    { "ModelVectors", TestModelVectors },
+    { "Seal", TestSeal },
+    { "SealAsync", TestSealAsync },
+    { "JobPriority", TestJobPriority },
+    { "SubmitFromCallback", TestSubmitFromCallback },
+    { "CancelJob", TestCancelJob },
+    { "ImageCheck", TestImageCheck },
+    { "ImageCheckBound", TestImageCheckBound },
+};
+
+int main(void)
+{
+    return HOST_RunTests("csec", s_tests, sizeof(s_tests) / sizeof(s_tests[0]));
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,216 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * Benchmarks of the eDMA driver.
+ *
+ * The register accesses and interrupt entries are counted with the models
+ * enabled; the time is measured with the models disabled, the interrupt
+ * requests the handler depends on being primed by the benchmark. The time does
+ * not include the exception entries, which the interrupt count stands for: the
+ * entries and the register accesses are also costed in Cortex-M4 cycles, which
+ * gives the number of channels completing together from which the coalesced
+ * handling pays off.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "host.h"
+#include "host_dma.h"
+#include "edma_driver.h"
+#include "edma_irq.h"
+#include "interrupt_manager.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_BLOCK_SIZE  32U
+#define BENCH_ROUNDS      200000U
+
+/* Cortex-M4 costs in core cycles: the exception entry and exit, the tail-chain
+ * of an interrupt taken back to back, a read of a peripheral register through
+ * the bridge and a buffered write of a peripheral or NVIC register */
+#define CM4_ENTRY_CYCLES       12U
+#define CM4_EXIT_CYCLES        10U
+#define CM4_TAIL_CHAIN_CYCLES  6U
+#define CM4_READ_CYCLES        4U
+#define CM4_WRITE_CYCLES       2U
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static edma_state_t s_dmaState;
+static edma_chn_state_t s_chnStates[FEATURE_DMA_CHANNELS];
+static uint8_t s_src[BENCH_BLOCK_SIZE] __attribute__((aligned(4)));
+static uint8_t s_dest[BENCH_BLOCK_SIZE] __attribute__((aligned(4)));
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+
+static void StartChannels(uint32_t chnCount, bool coalesced)
+{
+    edma_user_config_t userConfig;
+    edma_channel_config_t chnConfig;
+    uint32_t channel;
+
+    memset(&userConfig, 0, sizeof(userConfig));
+    userConfig.chnArbitration = EDMA_ARBITRATION_FIXED_PRIORITY;
+    (void)EDMA_DRV_Init(&s_dmaState, &userConfig, NULL, NULL, 0U);
+    EDMA_DRV_SetCoalescedInterrupts(coalesced);
+
+    memset(&chnConfig, 0, sizeof(chnConfig));
+    chnConfig.channelPriority = EDMA_CHN_DEFAULT_PRIORITY;
+    chnConfig.source = EDMA_REQ_DISABLED;
+    for (channel = 0U; channel < chnCount; channel++)
+    {
+        chnConfig.virtChnConfig = (uint8_t)channel;
+        (void)EDMA_DRV_ChannelInit(&s_chnStates[channel], &chnConfig);
+        (void)EDMA_DRV_ConfigSingleBlockTransfer((uint8_t)channel, EDMA_TRANSFER_MEM2MEM, (uint32_t)s_src,
+                                                 (uint32_t)s_dest, EDMA_TRANSFER_SIZE_4B, BENCH_BLOCK_SIZE);
+        (void)EDMA_DRV_StartChannel((uint8_t)channel);
+    }
+}
+
+/* Register accesses and interrupt entries of chnCount channels completed
+ * together, every channel complete before the handler runs */
+static void CountIsr(uint32_t chnCount, bool coalesced, host_stats_t *stats)
+{
+    uint32_t channel;
+
+    HOST_Init();
+    StartChannels(chnCount, coalesced);
+
+    INT_SYS_DisableIRQGlobal();
+    for (channel = 0U; channel < chnCount; channel++)
+    {
+        EDMA_DRV_TriggerSwRequest((uint8_t)channel);
+        (void)HOST_DMA_ServiceNext(channel);
+    }
+    HOST_ResetStats();
+    INT_SYS_EnableIRQGlobal();
+    HOST_GetStats(stats);
+
+    (void)EDMA_DRV_Deinit();
+}
+
+/* Cortex-M4 cycles of the exception entries, tail-chained, and of the register
+ * accesses */
+static uint32_t ModelCycles(const host_stats_t *stats)
+{
+    return CM4_ENTRY_CYCLES + CM4_EXIT_CYCLES + ((uint32_t)(stats->irqs - 1U) * CM4_TAIL_CHAIN_CYCLES) +
+           ((uint32_t)stats->reads * CM4_READ_CYCLES) + ((uint32_t)stats->writes * CM4_WRITE_CYCLES);
+}
+
+/*******************************************************************************
+ * Interrupt handler
+ ******************************************************************************/
+
+/* Cost of servicing chnCount channels completed together, per channel line or
+ * coalesced on the line of the first channel */
+static void BenchIsr(uint32_t chnCount, bool coalesced)
+{
+    host_stats_t stats;
+    uint32_t pending = (1UL << chnCount) - 1U;
+    uint64_t elapsed;
+    uint64_t start;
+    uint32_t round;
+    uint32_t channel;
+
+    CountIsr(chnCount, coalesced, &stats);
+    HOST_Init();
+    StartChannels(chnCount, coalesced);
+
+    /* Time, the handler servicing the requests primed in INT; the lines of the
+     * channels serviced by a coalesced entry are no longer pending */
+    HOST_SetModelsEnabled(false);
+    start = HOST_NowNs();
+    for (round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        DMA->INT = pending;
+        if (coalesced)
+        {
+            EDMA_DRV_ChannelIRQHandler(0U);
+        }
+        else
+        {
+            for (channel = 0U; channel < chnCount; channel++)
+            {
+                EDMA_DRV_ChannelIRQHandler((uint8_t)channel);
+            }
+        }
+    }
+    elapsed = HOST_NowNs() - start;
+
+    HOST_SetModelsEnabled(true);
+    (void)EDMA_DRV_Deinit();
+
+    printf("isr %2u channels %-11s %3u irq, %4u reads, %4u writes, %4u cm4 cycles, %7.1f ns/burst, %5.1f ns/channel\n",
+           (unsigned)chnCount, coalesced ? "coalesced:" : "per line:", (unsigned)stats.irqs,
+           (unsigned)stats.reads, (unsigned)stats.writes, (unsigned)ModelCycles(&stats),
+           (double)elapsed / BENCH_ROUNDS, (double)elapsed / BENCH_ROUNDS / chnCount);
+}
+
+/* Smallest number of channels completing together whose coalesced handling
+ * costs fewer Cortex-M4 cycles of entries and accesses than the per line one */
+static void BenchBreakEven(void)
+{
+    host_stats_t perLine;
+    host_stats_t coalesced;
+    uint32_t chnCount;
+
+    for (chnCount = 1U; chnCount <= FEATURE_DMA_CHANNELS; chnCount++)
+    {
+        CountIsr(chnCount, false, &perLine);
+        CountIsr(chnCount, true, &coalesced);
+        if (ModelCycles(&coalesced) < ModelCycles(&perLine))
+        {
+            break;
+        }
+    }
+
+    if (chnCount <= FEATURE_DMA_CHANNELS)
+    {
+        printf("isr coalesced handling pays off from %u channels completing together\n", (unsigned)chnCount);
+    }
+    else
+    {
+        printf("isr coalesced handling never pays off\n");
+    }
+}
+
+/*******************************************************************************
+ * Main
+ ******************************************************************************/
+
+int main(void)
+{
+    BenchIsr(1U, false);
+    BenchIsr(1U, true);
+    BenchIsr(4U, false);
+    BenchIsr(4U, true);
+    BenchIsr(16U, false);
+    BenchIsr(16U, true);
+    BenchBreakEven();
+
+    return 0;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
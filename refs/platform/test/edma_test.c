@@ -0,0 +1,763 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Tests of the eDMA driver on the eDMA model, which interprets the TCDs the
+ * driver loads: the pipelines are run stage by stage and their results
+ * checked in memory, the pooled descriptor chains are run, stopped and
+ * reconfigured, a stream is fed from the ADC request, the channel
+ * accounting and allocation are checked, and the completions of several
+ * channels are serviced by coalesced interrupts, grouped by line priority.
+ */
+
+#include <string.h>
+#include "host.h"
+#include "host_dma.h"
+#include "edma_driver.h"
+#include "interrupt_manager.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define RING_WORDS      16U
+#define SAMPLES         (2U * RING_WORDS)
+#define BLOCK_SIZE      32U
+#define MB_DATA_ADDR    (CAN0_BASE + 0x80U + (8U * 16U) + 8U)
+#define POOL_SIZE       4U
+#define CHAIN_BLOCKS    2U
+#define HALF_WORDS      4U
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static edma_state_t s_dmaState;
+static edma_chn_state_t s_chnStates[4];
+static edma_pipeline_t s_pipeline;
+
+/* ADC result register stand-in and ring of the last 16 results */
+static volatile uint32_t s_adcResult;
+static uint32_t s_ring[RING_WORDS] __attribute__((aligned(64)));
+static uint32_t s_snapshot[RING_WORDS];
+
+static uint8_t s_src[BLOCK_SIZE] __attribute__((aligned(4)));
+static uint8_t s_copy[BLOCK_SIZE] __attribute__((aligned(4)));
+static uint8_t s_repacked[BLOCK_SIZE];
+
+static uint8_t s_poolBuffer[POOL_SIZE * sizeof(edma_software_tcd_t)] __attribute__((aligned(32)));
+static edma_stcd_pool_t s_pool;
+static edma_stcd_chain_t s_chain;
+static uint32_t s_completions;
+
+static edma_stream_t s_stream;
+static uint32_t s_streamBuffer[2U * HALF_WORDS];
+static uint32_t s_streamEvents[3];
+static uint8_t *s_lastHalf;
+
+static edma_chn_state_t s_allChnStates[FEATURE_DMA_CHANNELS];
+static uint32_t s_channelCompletions[FEATURE_DMA_CHANNELS];
+static uint8_t s_callbackPriorities[FEATURE_DMA_CHANNELS];
+static uint8_t s_completionOrder[FEATURE_DMA_CHANNELS];
+static uint32_t s_completionCount;
+static uint8_t s_lateChannel;
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+
+static void StartDma(void)
+{
+    edma_user_config_t userConfig;
+
+    memset(&userConfig, 0, sizeof(userConfig));
+    userConfig.chnArbitration = EDMA_ARBITRATION_FIXED_PRIORITY;
+    userConfig.notHaltOnError = false;
+    HOST_CHECK_EQ(EDMA_DRV_Init(&s_dmaState, &userConfig, NULL, NULL, 0U), STATUS_SUCCESS);
+}
+
+static edma_pipeline_stage_t Stage(uint32_t srcAddr, uint32_t destAddr, edma_transfer_size_t size,
+                                   uint32_t minorBytes, uint32_t majorCount)
+{
+    edma_pipeline_stage_t stage;
+
+    memset(&stage, 0, sizeof(stage));
+    stage.srcAddr = srcAddr;
+    stage.destAddr = destAddr;
+    stage.srcTransferSize = size;
+    stage.destTransferSize = size;
+    stage.srcOffset = (int16_t)(1U << (uint32_t)size);
+    stage.destOffset = (int16_t)(1U << (uint32_t)size);
+    stage.srcModulo = EDMA_MODULO_OFF;
+    stage.destModulo = EDMA_MODULO_OFF;
+    stage.minorByteTransferCount = minorBytes;
+    stage.majorLoopIterationCount = majorCount;
+    stage.source = EDMA_REQ_DISABLED;
+    stage.minorLinkStage = EDMA_PIPELINE_NO_LINK;
+    stage.majorLinkStage = EDMA_PIPELINE_NO_LINK;
+    stage.disableReqOnCompletion = false;
+    stage.interruptEnable = false;
+
+    return stage;
+}
+
+static void CountCompletion(void *parameter, edma_chn_status_t status)
+{
+    (void)parameter;
+    if (status == EDMA_CHN_NORMAL)
+    {
+        s_completions++;
+    }
+}
+
+/* Channel 0 with a pool of descriptors and a chain of two blocks of the
+ * source, copied by software requests */
+static void StartChain(void)
+{
+    edma_channel_config_t chnConfig;
+    edma_scatter_gather_list_t srcList[CHAIN_BLOCKS];
+    edma_scatter_gather_list_t destList[CHAIN_BLOCKS];
+    uint32_t i;
+
+    StartDma();
+    memset(&chnConfig, 0, sizeof(chnConfig));
+    chnConfig.channelPriority = EDMA_CHN_DEFAULT_PRIORITY;
+    chnConfig.virtChnConfig = 0U;
+    chnConfig.source = EDMA_REQ_DISABLED;
+    chnConfig.callback = CountCompletion;
+    HOST_CHECK_EQ(EDMA_DRV_ChannelInit(&s_chnStates[0], &chnConfig), STATUS_SUCCESS);
+    s_completions = 0U;
+
+    for (i = 0U; i < BLOCK_SIZE; i++)
+    {
+        s_src[i] = (uint8_t)(0x40U + i);
+    }
+    memset(s_copy, 0, sizeof(s_copy));
+    for (i = 0U; i < CHAIN_BLOCKS; i++)
+    {
+        srcList[i].address = (uint32_t)&s_src[i * (BLOCK_SIZE / CHAIN_BLOCKS)];
+        srcList[i].length = BLOCK_SIZE / CHAIN_BLOCKS;
+        srcList[i].type = EDMA_TRANSFER_MEM2MEM;
+        destList[i] = srcList[i];
+        destList[i].address = (uint32_t)&s_copy[i * (BLOCK_SIZE / CHAIN_BLOCKS)];
+    }
+
+    EDMA_DRV_InitSTCDPool(&s_pool, s_poolBuffer, sizeof(s_poolBuffer));
+    HOST_CHECK_EQ(s_pool.count, POOL_SIZE);
+    HOST_CHECK_EQ(EDMA_DRV_AllocSTCDChain(&s_pool, &s_chain, CHAIN_BLOCKS), STATUS_SUCCESS);
+    s_chain.releaseOnComplete = true;
+    HOST_CHECK_EQ(EDMA_DRV_ConfigPooledScatterGather(0U, &s_chain, EDMA_TRANSFER_SIZE_4B,
+                                                     BLOCK_SIZE / CHAIN_BLOCKS, srcList, destList),
+                  STATUS_SUCCESS);
+    HOST_CHECK(s_chnStates[0].stcdChain == &s_chain);
+}
+
+/* Runs channel 0 with one software request per block */
+static void RunChannel(uint32_t blocks)
+{
+    uint32_t i;
+
+    HOST_CHECK_EQ(EDMA_DRV_StartChannel(0U), STATUS_SUCCESS);
+    for (i = 0U; i < blocks; i++)
+    {
+        EDMA_DRV_TriggerSwRequest(0U);
+        HOST_RunUntilIdle();
+    }
+}
+
+static void CountStreamEvent(void *parameter, edma_stream_event_t event, uint8_t *half)
+{
+    (void)parameter;
+    s_streamEvents[event]++;
+    if (event == EDMA_STREAM_HALF_COMPLETE)
+    {
+        s_lastHalf = half;
+    }
+}
+
+/* Channel 0 streams the ADC results into the two halves of the buffer */
+static void StartAdcStream(void)
+{
+    edma_channel_config_t chnConfig;
+    edma_stream_config_t streamConfig;
+
+    StartDma();
+    memset(&chnConfig, 0, sizeof(chnConfig));
+    chnConfig.channelPriority = EDMA_CHN_DEFAULT_PRIORITY;
+    chnConfig.virtChnConfig = 0U;
+    chnConfig.source = EDMA_REQ_ADC0;
+    HOST_CHECK_EQ(EDMA_DRV_ChannelInit(&s_chnStates[0], &chnConfig), STATUS_SUCCESS);
+
+    memset(&streamConfig, 0, sizeof(streamConfig));
+    streamConfig.periphAddr = (uint32_t)&s_adcResult;
+    streamConfig.transferSize = EDMA_TRANSFER_SIZE_4B;
+    streamConfig.toPeripheral = false;
+    streamConfig.buffer = (uint8_t *)s_streamBuffer;
+    streamConfig.halfSize = HALF_WORDS * 4U;
+    streamConfig.callback = CountStreamEvent;
+    memset(s_streamEvents, 0, sizeof(s_streamEvents));
+    s_lastHalf = NULL;
+    HOST_CHECK_EQ(EDMA_DRV_StartStream(0U, &s_stream, &streamConfig), STATUS_SUCCESS);
+}
+
+/* Feeds the stream a half worth of ADC results */
+static void ConvertHalf(uint32_t first)
+{
+    uint32_t i;
+
+    for (i = 0U; i < HALF_WORDS; i++)
+    {
+        s_adcResult = first + i;
+        HOST_DMA_SetSourceRequest(EDMA_REQ_ADC0, true);
+        HOST_CHECK(HOST_DMA_ServiceNext(0U));
+        HOST_DMA_SetSourceRequest(EDMA_REQ_ADC0, false);
+        HOST_RunUntilIdle();
+    }
+}
+
+/* Raises the ADC request for one conversion result */
+static void Convert(uint32_t sample)
+{
+    s_adcResult = sample;
+    HOST_DMA_SetSourceRequest(EDMA_REQ_ADC0, true);
+    HOST_CHECK(HOST_DMA_ServiceNext(s_pipeline.virtChannels[0]));
+    HOST_DMA_SetSourceRequest(EDMA_REQ_ADC0, false);
+    HOST_RunUntilIdle();
+}
+
+/*******************************************************************************
+ * Pipelines
+ ******************************************************************************/
+
+/* ADC results go to a RAM ring; every full ring is copied to a snapshot, whose
+ * first two words are loaded into the payload of a FlexCAN MB */
+static void TestPipelineRingToMb(void)
+{
+    edma_pipeline_stage_t stages[3];
+    const volatile uint32_t *mbData = (const volatile uint32_t *)MB_DATA_ADDR;
+    uint32_t i;
+
+    StartDma();
+
+    stages[0] = Stage((uint32_t)&s_adcResult, (uint32_t)s_ring, EDMA_TRANSFER_SIZE_4B, 4U, RING_WORDS);
+    stages[0].srcOffset = 0;
+    stages[0].destModulo = EDMA_MODULO_64B;
+    stages[0].source = EDMA_REQ_ADC0;
+    stages[0].majorLinkStage = 1U;
+    stages[1] = Stage((uint32_t)s_ring, (uint32_t)s_snapshot, EDMA_TRANSFER_SIZE_4B, sizeof(s_ring), 1U);
+    stages[1].srcLastAddrAdjust = -(int32_t)sizeof(s_ring);
+    stages[1].destLastAddrAdjust = -(int32_t)sizeof(s_snapshot);
+    stages[1].majorLinkStage = 2U;
+    stages[2] = Stage((uint32_t)s_snapshot, MB_DATA_ADDR, EDMA_TRANSFER_SIZE_4B, 8U, 1U);
+    stages[2].srcLastAddrAdjust = -8;
+    stages[2].destLastAddrAdjust = -8;
+
+    HOST_CHECK_EQ(EDMA_DRV_BuildPipeline(&s_pipeline, s_chnStates, stages, 3U), STATUS_SUCCESS);
+    HOST_CHECK_EQ(s_pipeline.stageCount, 3U);
+    HOST_CHECK_EQ(EDMA_DRV_StartPipeline(&s_pipeline), STATUS_SUCCESS);
+
+    for (i = 0U; i < SAMPLES; i++)
+    {
+        Convert(0x1000U + i);
+
+        /* The ring wraps without CPU help and the later stages run on each full ring */
+        HOST_CHECK_EQ(s_ring[i % RING_WORDS], 0x1000U + i);
+        if ((i % RING_WORDS) == (RING_WORDS - 1U))
+        {
+            HOST_CHECK_EQ(memcmp(s_snapshot, s_ring, sizeof(s_ring)), 0);
+            HOST_CHECK_EQ(mbData[0], 0x1000U + (i + 1U - RING_WORDS));
+            HOST_CHECK_EQ(mbData[1], 0x1001U + (i + 1U - RING_WORDS));
+        }
+    }
+    HOST_CHECK_EQ(HOST_DMA_MinorLoops(s_pipeline.virtChannels[0]), SAMPLES);
+    HOST_CHECK_EQ(HOST_DMA_MinorLoops(s_pipeline.virtChannels[1]), SAMPLES / RING_WORDS);
+    HOST_CHECK_EQ(HOST_DMA_MinorLoops(s_pipeline.virtChannels[2]), SAMPLES / RING_WORDS);
+
+    /* Once stopped, the requests of the head stage are ignored */
+    HOST_CHECK_EQ(EDMA_DRV_StopPipeline(&s_pipeline), STATUS_SUCCESS);
+    HOST_DMA_SetSourceRequest(EDMA_REQ_ADC0, true);
+    HOST_CHECK(!HOST_DMA_ServiceNext(s_pipeline.virtChannels[0]));
+    HOST_DMA_SetSourceRequest(EDMA_REQ_ADC0, false);
+
+    HOST_CHECK_EQ(EDMA_DRV_ReleasePipeline(&s_pipeline), STATUS_SUCCESS);
+    (void)EDMA_DRV_Deinit();
+}
+
+/* A self minor linked copy runs its whole major loop from one software start,
+ * then starts a stage which reads 16-bit words and writes bytes */
+static void TestPipelineMinorLink(void)
+{
+    edma_pipeline_stage_t stages[2];
+    uint32_t i;
+
+    StartDma();
+    for (i = 0U; i < BLOCK_SIZE; i++)
+    {
+        s_src[i] = (uint8_t)(0xA0U + i);
+    }
+    memset(s_copy, 0, sizeof(s_copy));
+    memset(s_repacked, 0, sizeof(s_repacked));
+
+    stages[0] = Stage((uint32_t)s_src, (uint32_t)s_copy, EDMA_TRANSFER_SIZE_4B, 4U, BLOCK_SIZE / 4U);
+    stages[0].minorLinkStage = 0U;
+    stages[0].majorLinkStage = 1U;
+    stages[1] = Stage((uint32_t)s_copy, (uint32_t)s_repacked, EDMA_TRANSFER_SIZE_2B, BLOCK_SIZE, 1U);
+    stages[1].destTransferSize = EDMA_TRANSFER_SIZE_1B;
+    stages[1].destOffset = 1;
+
+    HOST_CHECK_EQ(EDMA_DRV_BuildPipeline(&s_pipeline, s_chnStates, stages, 2U), STATUS_SUCCESS);
+    HOST_CHECK_EQ(EDMA_DRV_StartPipeline(&s_pipeline), STATUS_SUCCESS);
+    HOST_RunUntilIdle();
+
+    HOST_CHECK_EQ(memcmp(s_copy, s_src, BLOCK_SIZE), 0);
+    HOST_CHECK_EQ(memcmp(s_repacked, s_src, BLOCK_SIZE), 0);
+    HOST_CHECK_EQ(HOST_DMA_MinorLoops(s_pipeline.virtChannels[0]), BLOCK_SIZE / 4U);
+    HOST_CHECK_EQ(HOST_DMA_MinorLoops(s_pipeline.virtChannels[1]), 1U);
+
+    HOST_CHECK_EQ(EDMA_DRV_ReleasePipeline(&s_pipeline), STATUS_SUCCESS);
+    (void)EDMA_DRV_Deinit();
+}
+
+/* The stages breaking a hardware constraint are rejected */
+static void TestPipelineConstraints(void)
+{
+    edma_pipeline_stage_t stage;
+    edma_software_tcd_t stcd;
+    const uint8_t channels[1] = { 0U };
+
+    stage = Stage((uint32_t)s_src, (uint32_t)s_copy, EDMA_TRANSFER_SIZE_4B, 4U, 8U);
+    HOST_CHECK_EQ(EDMA_DRV_ComputePipelineTcds(&stage, 1U, channels, &stcd), STATUS_SUCCESS);
+
+    stage.srcAddr = (uint32_t)&s_src[2];
+    HOST_CHECK_EQ(EDMA_DRV_ComputePipelineTcds(&stage, 1U, channels, &stcd), STATUS_ERROR);
+
+    stage = Stage((uint32_t)s_src, (uint32_t)s_copy, EDMA_TRANSFER_SIZE_4B, 6U, 8U);
+    HOST_CHECK_EQ(EDMA_DRV_ComputePipelineTcds(&stage, 1U, channels, &stcd), STATUS_ERROR);
+
+    stage = Stage((uint32_t)s_src, (uint32_t)&s_ring[4], EDMA_TRANSFER_SIZE_4B, 4U, 8U);
+    stage.destModulo = EDMA_MODULO_64B;
+    HOST_CHECK_EQ(EDMA_DRV_ComputePipelineTcds(&stage, 1U, channels, &stcd), STATUS_ERROR);
+
+    stage = Stage((uint32_t)s_src, (uint32_t)s_copy, EDMA_TRANSFER_SIZE_4B, 4U, 512U);
+    HOST_CHECK_EQ(EDMA_DRV_ComputePipelineTcds(&stage, 1U, channels, &stcd), STATUS_SUCCESS);
+    stage.minorLinkStage = 0U;
+    HOST_CHECK_EQ(EDMA_DRV_ComputePipelineTcds(&stage, 1U, channels, &stcd), STATUS_ERROR);
+
+    stage = Stage((uint32_t)s_src, (uint32_t)s_copy, EDMA_TRANSFER_SIZE_4B, 4U, 8U);
+    stage.majorLinkStage = 1U;
+    HOST_CHECK_EQ(EDMA_DRV_ComputePipelineTcds(&stage, 1U, channels, &stcd), STATUS_ERROR);
+}
+
+/*******************************************************************************
+ * Pooled descriptor chains
+ ******************************************************************************/
+
+/* A chain released on completion goes back to the pool once */
+static void TestPooledChainRelease(void)
+{
+    StartChain();
+    HOST_CHECK_EQ(s_pool.freeMask, 0xCU);
+
+    RunChannel(CHAIN_BLOCKS);
+    HOST_CHECK_EQ(memcmp(s_copy, s_src, BLOCK_SIZE), 0);
+    HOST_CHECK_EQ(s_completions, 1U);
+    HOST_CHECK_EQ(s_pool.freeMask, 0xFU);
+    HOST_CHECK_EQ(s_chain.count, 0U);
+    HOST_CHECK(s_chnStates[0].stcdChain == NULL);
+
+    (void)EDMA_DRV_Deinit();
+}
+
+/* A channel given another transfer forgets the chain: its next interrupt does
+ * not free the chain again once the caller freed it and allocated it anew */
+static void TestPooledChainReconfigured(void)
+{
+    StartChain();
+    HOST_CHECK_EQ(EDMA_DRV_ConfigSingleBlockTransfer(0U, EDMA_TRANSFER_MEM2MEM, (uint32_t)s_src,
+                                                     (uint32_t)s_repacked, EDMA_TRANSFER_SIZE_4B, BLOCK_SIZE),
+                  STATUS_SUCCESS);
+    HOST_CHECK(s_chnStates[0].stcdChain == NULL);
+
+    EDMA_DRV_FreeSTCDChain(&s_chain);
+    HOST_CHECK_EQ(EDMA_DRV_AllocSTCDChain(&s_pool, &s_chain, CHAIN_BLOCKS), STATUS_SUCCESS);
+
+    memset(s_repacked, 0, sizeof(s_repacked));
+    RunChannel(1U);
+    HOST_CHECK_EQ(memcmp(s_repacked, s_src, BLOCK_SIZE), 0);
+    HOST_CHECK_EQ(s_completions, 1U);
+    HOST_CHECK_EQ(s_chain.count, CHAIN_BLOCKS);
+    HOST_CHECK_EQ(s_pool.freeMask, 0xCU);
+
+    (void)EDMA_DRV_Deinit();
+}
+
+/* A chain stopped halfway is left to the caller; freed, it can be reused */
+static void TestPooledChainStopped(void)
+{
+    StartChain();
+    HOST_CHECK_EQ(EDMA_DRV_StartChannel(0U), STATUS_SUCCESS);
+    EDMA_DRV_TriggerSwRequest(0U);
+    HOST_CHECK(HOST_DMA_ServiceNext(0U));
+    HOST_CHECK_EQ(EDMA_DRV_StopChannel(0U), STATUS_SUCCESS);
+    HOST_CHECK(s_chnStates[0].stcdChain == NULL);
+    HOST_CHECK_EQ(s_completions, 0U);
+    HOST_CHECK_EQ(s_pool.freeMask, 0xCU);
+
+    EDMA_DRV_FreeSTCDChain(&s_chain);
+    HOST_CHECK_EQ(s_pool.freeMask, 0xFU);
+    (void)EDMA_DRV_Deinit();
+
+    StartChain();
+    RunChannel(CHAIN_BLOCKS);
+    HOST_CHECK_EQ(memcmp(s_copy, s_src, BLOCK_SIZE), 0);
+    HOST_CHECK_EQ(s_completions, 1U);
+    HOST_CHECK_EQ(s_pool.freeMask, 0xFU);
+
+    (void)EDMA_DRV_Deinit();
+}
+
+/* Freeing a chain still loaded in a stopped channel detaches it */
+static void TestPooledChainFreedAttached(void)
+{
+    StartChain();
+    EDMA_DRV_FreeSTCDChain(&s_chain);
+    HOST_CHECK(s_chnStates[0].stcdChain == NULL);
+    HOST_CHECK_EQ(s_pool.freeMask, 0xFU);
+
+    (void)EDMA_DRV_Deinit();
+}
+
+/*******************************************************************************
+ * Streams
+ ******************************************************************************/
+
+/* A half the application keeps too long is reported overrun but stays with
+ * it: its late release does not give away a later hand-over of the half */
+static void TestStreamOverrun(void)
+{
+    uint8_t *half0 = (uint8_t *)s_streamBuffer;
+    uint8_t *half1 = (uint8_t *)&s_streamBuffer[HALF_WORDS];
+
+    StartAdcStream();
+
+    ConvertHalf(0x100U);
+    HOST_CHECK_EQ(s_streamEvents[EDMA_STREAM_HALF_COMPLETE], 1U);
+    HOST_CHECK(s_lastHalf == half0);
+    HOST_CHECK_EQ(s_streamBuffer[HALF_WORDS - 1U], 0x100U + HALF_WORDS - 1U);
+
+    /* Half 0 is still held when the eDMA comes back to it */
+    ConvertHalf(0x200U);
+    HOST_CHECK_EQ(s_streamEvents[EDMA_STREAM_HALF_COMPLETE], 2U);
+    HOST_CHECK(s_lastHalf == half1);
+    HOST_CHECK_EQ(s_streamEvents[EDMA_STREAM_OVERRUN], 1U);
+    HOST_CHECK_EQ(s_stream.overruns, 1U);
+    HOST_CHECK_EQ(s_stream.owned, 3U);
+    EDMA_DRV_ReleaseStreamHalf(&s_stream, half1);
+
+    /* The overwritten half is not handed over a second time */
+    ConvertHalf(0x300U);
+    HOST_CHECK_EQ(s_streamEvents[EDMA_STREAM_HALF_COMPLETE], 2U);
+    HOST_CHECK_EQ(s_streamEvents[EDMA_STREAM_OVERRUN], 1U);
+    HOST_CHECK_EQ(s_stream.owned, 1U);
+
+    EDMA_DRV_ReleaseStreamHalf(&s_stream, half0);
+    HOST_CHECK_EQ(s_stream.owned, 0U);
+    HOST_CHECK_ASSERT(EDMA_DRV_ReleaseStreamHalf(&s_stream, half0));
+    HOST_CHECK_ASSERT(EDMA_DRV_ReleaseStreamHalf(&s_stream, &half0[4]));
+
+    /* Both halves released, the stream runs on without overruns */
+    ConvertHalf(0x400U);
+    HOST_CHECK_EQ(s_streamEvents[EDMA_STREAM_HALF_COMPLETE], 3U);
+    HOST_CHECK(s_lastHalf == half1);
+    HOST_CHECK_EQ(s_streamEvents[EDMA_STREAM_OVERRUN], 1U);
+    HOST_CHECK_EQ(s_streamBuffer[HALF_WORDS], 0x400U);
+
+    HOST_CHECK_EQ(EDMA_DRV_StopStream(0U), STATUS_SUCCESS);
+    (void)EDMA_DRV_Deinit();
+}
+
+/*******************************************************************************
+ * Channel accounting and allocation
+ ******************************************************************************/
+
+/* The transfers are counted once per chain, whose last descriptor is loaded
+ * without setting DONE, and once per stream major loop */
+static void TestChannelStats(void)
+{
+    edma_chn_stats_t stats;
+
+    StartChain();
+    RunChannel(CHAIN_BLOCKS);
+    EDMA_DRV_GetChannelStats(0U, &stats);
+    HOST_CHECK_EQ(stats.transfers, 1U);
+    HOST_CHECK_EQ(stats.bytes, BLOCK_SIZE);
+
+    HOST_CHECK_EQ(EDMA_DRV_ConfigMultiBlockTransfer(0U, EDMA_TRANSFER_MEM2MEM, (uint32_t)s_src, (uint32_t)s_copy,
+                                                    EDMA_TRANSFER_SIZE_4B, BLOCK_SIZE / 4U, 4U, true),
+                  STATUS_SUCCESS);
+    RunChannel(4U);
+    EDMA_DRV_GetChannelStats(0U, &stats);
+    HOST_CHECK_EQ(stats.transfers, 2U);
+    HOST_CHECK_EQ(stats.bytes, 2U * BLOCK_SIZE);
+    (void)EDMA_DRV_Deinit();
+
+    StartAdcStream();
+    ConvertHalf(0U);
+    EDMA_DRV_GetChannelStats(0U, &stats);
+    HOST_CHECK_EQ(stats.transfers, 0U);
+    EDMA_DRV_ReleaseStreamHalf(&s_stream, s_lastHalf);
+    ConvertHalf(HALF_WORDS);
+    EDMA_DRV_GetChannelStats(0U, &stats);
+    HOST_CHECK_EQ(stats.transfers, 1U);
+    HOST_CHECK_EQ(stats.bytes, sizeof(s_streamBuffer));
+    HOST_CHECK_EQ(s_streamEvents[EDMA_STREAM_HALF_COMPLETE], 2U);
+
+    HOST_CHECK_EQ(EDMA_DRV_StopStream(0U), STATUS_SUCCESS);
+    (void)EDMA_DRV_Deinit();
+}
+
+/* The normal channels grow from the middle downwards and only take the upper
+ * half once the lower one is full */
+static void TestAllocChannelLatency(void)
+{
+    static edma_chn_state_t states[FEATURE_DMA_CHANNELS];
+    edma_channel_config_t chnConfig;
+    uint8_t channel;
+    uint32_t i;
+
+    StartDma();
+    memset(&chnConfig, 0, sizeof(chnConfig));
+    chnConfig.source = EDMA_REQ_DISABLED;
+
+    HOST_CHECK_EQ(EDMA_DRV_AllocChannel(&states[0], &chnConfig, EDMA_LATENCY_CRITICAL, &channel), STATUS_SUCCESS);
+    HOST_CHECK_EQ(channel, FEATURE_DMA_CHANNELS - 1U);
+    HOST_CHECK_EQ(EDMA_DRV_AllocChannel(&states[1], &chnConfig, EDMA_LATENCY_BULK, &channel), STATUS_SUCCESS);
+    HOST_CHECK_EQ(channel, 0U);
+
+    for (i = 0U; i < ((FEATURE_DMA_CHANNELS / 2U) - 1U); i++)
+    {
+        HOST_CHECK_EQ(EDMA_DRV_AllocChannel(&states[2U + i], &chnConfig, EDMA_LATENCY_NORMAL, &channel),
+                      STATUS_SUCCESS);
+        HOST_CHECK_EQ(channel, (FEATURE_DMA_CHANNELS / 2U) - 1U - i);
+    }
+    HOST_CHECK_EQ(EDMA_DRV_AllocChannel(&states[2U + i], &chnConfig, EDMA_LATENCY_NORMAL, &channel),
+                  STATUS_SUCCESS);
+    HOST_CHECK_EQ(channel, FEATURE_DMA_CHANNELS / 2U);
+
+    (void)EDMA_DRV_Deinit();
+}
+
+/*******************************************************************************
+ * Coalesced interrupts
+ ******************************************************************************/
+
+/* Counts the completions of each channel, in order, with the priority of the
+ * line they are called from; the completion of channel 0 starts the late
+ * channel, if any, whose interrupt preempts the handler */
+static void CountChannelCompletion(void *parameter, edma_chn_status_t status)
+{
+    uint32_t channel = (uint32_t)(uintptr_t)parameter;
+
+    if (status == EDMA_CHN_NORMAL)
+    {
+        s_channelCompletions[channel]++;
+    }
+    s_callbackPriorities[channel] = INT_SYS_GetPriority((IRQn_Type)(HOST_ActiveIrq() - 16));
+    if (s_completionCount < FEATURE_DMA_CHANNELS)
+    {
+        s_completionOrder[s_completionCount] = (uint8_t)channel;
+        s_completionCount++;
+    }
+    if ((channel == 0U) && (s_lateChannel != 0U))
+    {
+        EDMA_DRV_TriggerSwRequest(s_lateChannel);
+        HOST_CHECK(HOST_DMA_ServiceNext(s_lateChannel));
+    }
+}
+
+/* Configures a single block copy on a channel */
+static void StartCopyChannel(uint8_t channel)
+{
+    edma_channel_config_t chnConfig;
+
+    memset(&chnConfig, 0, sizeof(chnConfig));
+    chnConfig.channelPriority = EDMA_CHN_DEFAULT_PRIORITY;
+    chnConfig.virtChnConfig = channel;
+    chnConfig.source = EDMA_REQ_DISABLED;
+    chnConfig.callback = CountChannelCompletion;
+    chnConfig.callbackParam = (void *)(uintptr_t)channel;
+    HOST_CHECK_EQ(EDMA_DRV_ChannelInit(&s_allChnStates[channel], &chnConfig), STATUS_SUCCESS);
+    HOST_CHECK_EQ(EDMA_DRV_ConfigSingleBlockTransfer(channel, EDMA_TRANSFER_MEM2MEM, (uint32_t)s_src,
+                                                     (uint32_t)s_copy, EDMA_TRANSFER_SIZE_4B, BLOCK_SIZE),
+                  STATUS_SUCCESS);
+    HOST_CHECK_EQ(EDMA_DRV_StartChannel(channel), STATUS_SUCCESS);
+}
+
+/* Runs a channel to completion with the interrupts masked */
+static void CompleteMasked(uint8_t channel)
+{
+    EDMA_DRV_TriggerSwRequest(channel);
+    HOST_CHECK(HOST_DMA_ServiceNext(channel));
+}
+
+/* Channels completed together enter the handler once: the flags are cleared
+ * before the pending interrupts of the level-sensitive lines */
+static void TestCoalescedInterrupts(void)
+{
+    host_stats_t stats;
+    uint8_t channel;
+
+    StartDma();
+    EDMA_DRV_SetCoalescedInterrupts(true);
+    memset(s_channelCompletions, 0, sizeof(s_channelCompletions));
+    s_lateChannel = 0U;
+
+    INT_SYS_DisableIRQGlobal();
+    for (channel = 0U; channel < 4U; channel++)
+    {
+        StartCopyChannel(channel);
+        CompleteMasked(channel);
+    }
+    HOST_ResetStats();
+    INT_SYS_EnableIRQGlobal();
+    HOST_GetStats(&stats);
+
+    HOST_CHECK_EQ(stats.irqs, 1U);
+    for (channel = 0U; channel < 4U; channel++)
+    {
+        HOST_CHECK_EQ(s_channelCompletions[channel], 1U);
+        HOST_CHECK(!HOST_IsIrqPending((IRQn_Type)(DMA0_IRQn + channel)));
+    }
+
+    (void)EDMA_DRV_Deinit();
+}
+
+/* A channel completing on a preempting line after the flags were read is
+ * serviced once, from its own line, and each callback runs at the priority of
+ * its own line */
+static void TestCoalescedPreemption(void)
+{
+    StartDma();
+    memset(s_channelCompletions, 0, sizeof(s_channelCompletions));
+    s_completionCount = 0U;
+    s_lateChannel = 5U;
+
+    INT_SYS_DisableIRQGlobal();
+    StartCopyChannel(0U);
+    StartCopyChannel(3U);
+    StartCopyChannel(5U);
+    INT_SYS_SetPriority(DMA0_IRQn, 2U);
+    INT_SYS_SetPriority(DMA3_IRQn, 3U);
+    INT_SYS_SetPriority(DMA5_IRQn, 1U);
+    EDMA_DRV_SetCoalescedInterrupts(true);
+    CompleteMasked(0U);
+    CompleteMasked(3U);
+    INT_SYS_EnableIRQGlobal();
+
+    HOST_CHECK_EQ(s_channelCompletions[0], 1U);
+    HOST_CHECK_EQ(s_channelCompletions[3], 1U);
+    HOST_CHECK_EQ(s_channelCompletions[5], 1U);
+    HOST_CHECK_EQ(s_callbackPriorities[0], 2U);
+    HOST_CHECK_EQ(s_callbackPriorities[3], 3U);
+    HOST_CHECK_EQ(s_callbackPriorities[5], 1U);
+    HOST_CHECK_EQ(s_completionCount, 3U);
+    HOST_CHECK_EQ(s_completionOrder[0], 0U);
+    HOST_CHECK_EQ(s_completionOrder[1], 5U);
+    HOST_CHECK_EQ(s_completionOrder[2], 3U);
+
+    INT_SYS_SetPriority(DMA0_IRQn, 0U);
+    INT_SYS_SetPriority(DMA3_IRQn, 0U);
+    INT_SYS_SetPriority(DMA5_IRQn, 0U);
+    (void)EDMA_DRV_Deinit();
+}
+
+/* The channels completed together are serviced by one entry per line priority,
+ * the group of the higher priority first, and never from a line of a lower
+ * priority than their own */
+static void TestCoalescedPriorityGroups(void)
+{
+    host_stats_t stats;
+    uint8_t channel;
+
+    StartDma();
+    memset(s_channelCompletions, 0, sizeof(s_channelCompletions));
+    s_completionCount = 0U;
+    s_lateChannel = 0U;
+
+    INT_SYS_DisableIRQGlobal();
+    INT_SYS_SetPriority(DMA0_IRQn, 2U);
+    INT_SYS_SetPriority(DMA1_IRQn, 2U);
+    INT_SYS_SetPriority(DMA2_IRQn, 1U);
+    INT_SYS_SetPriority(DMA3_IRQn, 1U);
+    EDMA_DRV_SetCoalescedInterrupts(true);
+    for (channel = 0U; channel < 4U; channel++)
+    {
+        StartCopyChannel(channel);
+        CompleteMasked(channel);
+    }
+    HOST_ResetStats();
+    INT_SYS_EnableIRQGlobal();
+    HOST_GetStats(&stats);
+
+    HOST_CHECK_EQ(stats.irqs, 2U);
+    HOST_CHECK_EQ(s_completionCount, 4U);
+    HOST_CHECK_EQ(s_completionOrder[0], 2U);
+    HOST_CHECK_EQ(s_completionOrder[1], 3U);
+    HOST_CHECK_EQ(s_completionOrder[2], 0U);
+    HOST_CHECK_EQ(s_completionOrder[3], 1U);
+    for (channel = 0U; channel < 4U; channel++)
+    {
+        HOST_CHECK_EQ(s_channelCompletions[channel], 1U);
+        HOST_CHECK_EQ(s_callbackPriorities[channel], (channel < 2U) ? 2U : 1U);
+        HOST_CHECK(!HOST_IsIrqPending((IRQn_Type)(DMA0_IRQn + channel)));
+    }
+
+    for (channel = 0U; channel < 4U; channel++)
+    {
+        INT_SYS_SetPriority((IRQn_Type)(DMA0_IRQn + channel), 0U);
+    }
+    (void)EDMA_DRV_Deinit();
+}
+
+/*******************************************************************************
+ * Main
+ ******************************************************************************/
+
+static const host_test_t s_tests[] = {
+    { "PipelineRingToMb", TestPipelineRingToMb },
+    { "PipelineMinorLink", TestPipelineMinorLink },
+    { "PipelineConstraints", TestPipelineConstraints },
+    { "PooledChainRelease", TestPooledChainRelease },
+    { "PooledChainReconfigured", TestPooledChainReconfigured },
+    { "PooledChainStopped", TestPooledChainStopped },
+    { "PooledChainFreedAttached", TestPooledChainFreedAttached },
+    { "StreamOverrun", TestStreamOverrun },
+    { "ChannelStats", TestChannelStats },
+    { "AllocChannelLatency", TestAllocChannelLatency },
+    { "CoalescedInterrupts", TestCoalescedInterrupts },
+    { "CoalescedPreemption", TestCoalescedPreemption },
+    { "CoalescedPriorityGroups", TestCoalescedPriorityGroups },
+};
+
+int main(void)
+{
+    return HOST_RunTests("edma", s_tests, sizeof(s_tests) / sizeof(s_tests[0]));
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
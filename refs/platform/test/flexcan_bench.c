@@ -0,0 +1,562 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Benchmarks of the FlexCAN driver.
+ *
+ * The register accesses and interrupt entries are counted with the models
+ * enabled; the time is measured with the models disabled, the registers the
+ * driver depends on being primed by the benchmark.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "host.h"
+#include "host_can.h"
+#include "host_dma.h"
+#include "edma_driver.h"
+#include "flexcan_driver.h"
+#include "flexcan_irq.h"
+#include "flexcan_hw_access.h"
+#include "can_pal.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_RING_SIZE   64U
+#define BENCH_ROUNDS      20000U
+#define BENCH_ID          0x100U
+#define BENCH_LOOKUPS     1000000U
+#define BENCH_COPIES      200000U
+#define BENCH_PAL_BUFFS   16U
+#define BENCH_SENDS       200000U
+#define BENCH_DMA_CHANNEL 3U
+#define BENCH_DMA_MB      8U
+#define BENCH_DMA_MBS     FLEXCAN_TX_DMA_MAX_MBS
+#define BENCH_BURST       64U
+#define BENCH_BURSTS      20000U
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static flexcan_state_t s_state;
+static flexcan_msgbuff_t s_rings[32U][BENCH_RING_SIZE];
+static flexcan_msgbuff_t s_frames[BENCH_RING_SIZE];
+static volatile uintptr_t s_sink;
+static edma_state_t s_dmaState;
+static edma_chn_state_t s_dmaChnState;
+static uint8_t s_txDmaStcd[FLEXCAN_TX_DMA_STCD_SIZE(BENCH_DMA_MBS)];
+static flexcan_tx_dma_frame_t s_txDmaFrames[BENCH_BURST];
+static uint8_t s_burstData[BENCH_BURST][8];
+
+static const flexcan_data_info_t s_stdInfo = {
+    .msg_id_type = FLEXCAN_MSG_ID_STD,
+    .data_length = 8U,
+    .fd_enable = false,
+    .fd_padding = 0U,
+    .enable_brs = false,
+    .is_remote = false,
+};
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+
+static void StartRings(uint32_t mbCount)
+{
+    flexcan_user_config_t config;
+    uint32_t mb;
+
+    FLEXCAN_DRV_GetDefaultConfig(&config);
+    config.max_num_mb = 32U;
+    config.flexcanMode = FLEXCAN_NORMAL_MODE;
+    (void)FLEXCAN_DRV_Init(0U, &s_state, &config);
+    FLEXCAN_DRV_SetRxMaskType(0U, FLEXCAN_RX_MASK_GLOBAL);
+    FLEXCAN_DRV_SetRxMbGlobalMask(0U, FLEXCAN_MSG_ID_STD, 0x7FFU);
+    for (mb = 0U; mb < mbCount; mb++)
+    {
+        (void)FLEXCAN_DRV_ConfigRxMb(0U, (uint8_t)mb, &s_stdInfo, BENCH_ID + mb);
+        (void)FLEXCAN_DRV_ReceiveContinuous(0U, (uint8_t)mb, s_rings[mb], BENCH_RING_SIZE);
+    }
+}
+
+static void DrainRings(uint32_t mbCount)
+{
+    uint32_t mb;
+
+    for (mb = 0U; mb < mbCount; mb++)
+    {
+        while (FLEXCAN_DRV_ReadRxRing(0U, (uint8_t)mb, s_frames, BENCH_RING_SIZE) != 0U)
+        {
+        }
+    }
+}
+
+/*******************************************************************************
+ * Interrupt handler
+ ******************************************************************************/
+
+/* Cost of one entry of the handler with mbCount MBs pending */
+static void BenchIsr(uint32_t mbCount)
+{
+    host_can_frame_t frame;
+    host_stats_t stats;
+    uint32_t pending = (mbCount == 32U) ? 0xFFFFFFFFU : ((1UL << mbCount) - 1U);
+    uint64_t elapsed = 0U;
+    uint64_t start;
+    uint32_t round;
+    uint32_t mb;
+
+    HOST_Init();
+    StartRings(mbCount);
+
+    /* Register accesses, with every frame pending before the handler runs */
+    memset(&frame, 0, sizeof(frame));
+    frame.length = 8U;
+    HOST_CpuDisableIrq();
+    for (mb = 0U; mb < mbCount; mb++)
+    {
+        frame.id = BENCH_ID + mb;
+        HOST_CAN_Inject(0U, &frame);
+    }
+    HOST_ResetStats();
+    HOST_CpuEnableIrq();
+    HOST_GetStats(&stats);
+    DrainRings(mbCount);
+
+    /* Time, the handler servicing the flags primed in IFLAG1 */
+    HOST_SetModelsEnabled(false);
+    for (round = 0U; round < BENCH_ROUNDS; round += BENCH_RING_SIZE)
+    {
+        start = HOST_NowNs();
+        for (mb = 0U; mb < BENCH_RING_SIZE; mb++)
+        {
+            CAN0->IFLAG1 = pending;
+            FLEXCAN_IRQHandler(0U);
+        }
+        elapsed += HOST_NowNs() - start;
+        DrainRings(mbCount);
+    }
+
+    round = (BENCH_ROUNDS / BENCH_RING_SIZE) * BENCH_RING_SIZE;
+    printf("isr %2u MBs pending: %3u irq, %4u reads, %4u writes, %6.1f ns/isr, %5.1f ns/MB\n",
+           (unsigned)mbCount, (unsigned)stats.irqs, (unsigned)stats.reads, (unsigned)stats.writes,
+           (double)elapsed / round, (double)elapsed / round / mbCount);
+}
+
+/*******************************************************************************
+ * Message buffer addresses
+ ******************************************************************************/
+
+/* The address computation the MB address table replaced */
+static volatile uint32_t *ComputeMsgBuffRegion(CAN_Type * base, uint32_t msgBuffIdx)
+{
+    uint32_t mbSize = 8U + FLEXCAN_GetPayloadSize(base);
+    uint32_t perBlock = 512U / mbSize;
+
+    return &(base->RAMn[(128U * (msgBuffIdx / perBlock)) + ((msgBuffIdx % perBlock) * (mbSize >> 2U))]);
+}
+
+/* Cost of finding a MB address, alone and followed by the MB access of a
+ * full frame, the address computed from FDCTRL or read from the table */
+static void BenchMsgBuffAddr(flexcan_fd_payload_size_t payload)
+{
+    static uint32_t data[16];
+    flexcan_user_config_t config;
+    flexcan_msgbuff_code_status_t cs;
+    flexcan_msgbuff_t frame;
+    uint32_t payloadBytes = 8UL << (uint32_t)payload;
+    uint32_t mbCount = (FEATURE_CAN0_MAX_MB_NUM * 16U) / (8U + payloadBytes);
+    volatile uint32_t *region;
+    uint64_t elapsed[2][3];
+    uint64_t start;
+    uint32_t mb = 0U;
+    uint32_t i;
+    uint32_t j;
+
+    HOST_Init();
+    FLEXCAN_DRV_GetDefaultConfig(&config);
+    config.fd_enable = true;
+    config.payload = payload;
+    config.max_num_mb = mbCount;
+    (void)FLEXCAN_DRV_Init(0U, &s_state, &config);
+    HOST_SetModelsEnabled(false);
+
+    cs.code = (uint32_t)FLEXCAN_TX_DATA;
+    cs.msgIdType = FLEXCAN_MSG_ID_STD;
+    cs.dataLen = payloadBytes;
+    cs.fd_enable = true;
+    cs.fd_padding = 0U;
+    cs.enable_brs = false;
+
+    /* j = 0: address computed, j = 1: address from the table */
+    for (j = 0U; j < 2U; j++)
+    {
+        start = HOST_NowNs();
+        for (i = 0U; i < BENCH_LOOKUPS; i++)
+        {
+            region = (j == 0U) ? ComputeMsgBuffRegion(CAN0, mb) : s_state.mbRegions[mb];
+            s_sink = (uintptr_t)region;
+            mb = ((mb + 1U) == mbCount) ? 0U : (mb + 1U);
+        }
+        elapsed[j][0] = HOST_NowNs() - start;
+
+        start = HOST_NowNs();
+        for (i = 0U; i < BENCH_LOOKUPS; i++)
+        {
+            region = (j == 0U) ? ComputeMsgBuffRegion(CAN0, mb) : s_state.mbRegions[mb];
+            (void)FLEXCAN_SetTxMsgBuff(CAN0, mb, region, &cs, BENCH_ID, (const uint8_t *)data);
+            mb = ((mb + 1U) == mbCount) ? 0U : (mb + 1U);
+        }
+        elapsed[j][1] = HOST_NowNs() - start;
+
+        /* Every MB holds a full frame left by the writes */
+        start = HOST_NowNs();
+        for (i = 0U; i < BENCH_LOOKUPS; i++)
+        {
+            region = (j == 0U) ? ComputeMsgBuffRegion(CAN0, mb) : s_state.mbRegions[mb];
+            (void)FLEXCAN_GetMsgBuff(CAN0, mb, region, &frame);
+            mb = ((mb + 1U) == mbCount) ? 0U : (mb + 1U);
+        }
+        elapsed[j][2] = HOST_NowNs() - start;
+    }
+
+    printf("mb address %2u byte payload: %5.2f ns computed, %5.2f ns from the table\n",
+           (unsigned)payloadBytes, (double)elapsed[0][0] / BENCH_LOOKUPS, (double)elapsed[1][0] / BENCH_LOOKUPS);
+    printf("  FLEXCAN_SetTxMsgBuff: %6.2f ns computed, %6.2f ns from the table\n",
+           (double)elapsed[0][1] / BENCH_LOOKUPS, (double)elapsed[1][1] / BENCH_LOOKUPS);
+    printf("  FLEXCAN_GetMsgBuff:   %6.2f ns computed, %6.2f ns from the table\n",
+           (double)elapsed[0][2] / BENCH_LOOKUPS, (double)elapsed[1][2] / BENCH_LOOKUPS);
+}
+
+/*******************************************************************************
+ * Payload copy
+ ******************************************************************************/
+
+/* Cost of moving a 64 byte CAN FD payload to and from a MB */
+static void BenchPayloadCopy(void)
+{
+    static uint32_t source[17];
+    flexcan_user_config_t config;
+    flexcan_msgbuff_code_status_t cs;
+    flexcan_msgbuff_t frame;
+    const uint8_t *buffers[2];
+    uint64_t elapsed[3];
+    uint64_t start;
+    uint32_t i;
+    uint32_t j;
+
+    HOST_Init();
+    FLEXCAN_DRV_GetDefaultConfig(&config);
+    config.fd_enable = true;
+    config.payload = FLEXCAN_PAYLOAD_SIZE_64;
+    config.max_num_mb = 7U;
+    (void)FLEXCAN_DRV_Init(0U, &s_state, &config);
+    HOST_SetModelsEnabled(false);
+
+    cs.code = (uint32_t)FLEXCAN_TX_DATA;
+    cs.msgIdType = FLEXCAN_MSG_ID_STD;
+    cs.dataLen = 64U;
+    cs.fd_enable = true;
+    cs.fd_padding = 0U;
+    cs.enable_brs = true;
+    buffers[0] = (const uint8_t *)source;
+    buffers[1] = (const uint8_t *)source + 1U;
+
+    for (j = 0U; j < 2U; j++)
+    {
+        start = HOST_NowNs();
+        for (i = 0U; i < BENCH_COPIES; i++)
+        {
+            (void)FLEXCAN_SetTxMsgBuff(CAN0, 1U, s_state.mbRegions[1], &cs, BENCH_ID, buffers[j]);
+        }
+        elapsed[j] = HOST_NowNs() - start;
+    }
+
+    /* The CS word left by the last write reads back with a 64 byte DLC */
+    start = HOST_NowNs();
+    for (i = 0U; i < BENCH_COPIES; i++)
+    {
+        (void)FLEXCAN_GetMsgBuff(CAN0, 1U, s_state.mbRegions[1], &frame);
+    }
+    elapsed[2] = HOST_NowNs() - start;
+
+    printf("64 byte payload: %5.1f ns to the MB aligned, %5.1f ns unaligned, %5.1f ns from the MB\n",
+           (double)elapsed[0] / BENCH_COPIES, (double)elapsed[1] / BENCH_COPIES, (double)elapsed[2] / BENCH_COPIES);
+}
+
+/*******************************************************************************
+ * CAN PAL transmission
+ ******************************************************************************/
+
+/* Cost of a CAN PAL send, resolved on each call or prepared once. The Rx FIFO
+ * is enabled, so that CAN_Send also has to translate the buffer index. */
+static void BenchPalSend(void)
+{
+    static uint32_t ids[8];
+    static const can_buff_config_t buffConfig = {
+        .enableFD = false,
+        .enableBRS = false,
+        .fdPadding = 0U,
+        .idType = CAN_MSG_ID_STD,
+        .isRemote = false,
+    };
+    static const uint8_t data[8] = { 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U };
+    can_tx_handle_t handles[BENCH_PAL_BUFFS];
+    flexcan_id_table_t table;
+    extension_flexcan_rx_fifo_t fifo;
+    can_user_config_t config;
+    can_message_t message;
+    uint64_t elapsed[2] = { 0U, 0U };
+    uint64_t start;
+    uint32_t failures = 0U;
+    uint32_t pending = 0U;
+    uint32_t hwBuffIdx;
+    uint32_t round;
+    uint32_t buff;
+    uint32_t j;
+
+    HOST_Init();
+    table.isRemoteFrame = false;
+    table.isExtendedFrame = false;
+    table.idFilter = ids;
+    fifo.numIdFilters = FLEXCAN_RX_FIFO_ID_FILTERS_8;
+    fifo.idFormat = FLEXCAN_RX_FIFO_ID_FORMAT_A;
+    fifo.idFilterTable = &table;
+    memset(&config, 0, sizeof(config));
+    config.maxBuffNum = BENCH_PAL_BUFFS + 1U;
+    config.mode = CAN_NORMAL_MODE;
+    config.payloadSize = CAN_PAYLOAD_SIZE_8;
+    config.nominalBitrate.propSeg = 7U;
+    config.nominalBitrate.phaseSeg1 = 4U;
+    config.nominalBitrate.phaseSeg2 = 1U;
+    config.nominalBitrate.rJumpwidth = 1U;
+    config.extension = &fifo;
+    (void)CAN_Init(CAN_OVER_FLEXCAN00_INSTANCE, &config);
+
+    memset(&message, 0, sizeof(message));
+    message.id = BENCH_ID;
+    message.length = 8U;
+    memcpy(message.data, data, sizeof(data));
+    for (buff = 1U; buff <= BENCH_PAL_BUFFS; buff++)
+    {
+        (void)CAN_ConfigTxBuff(CAN_OVER_FLEXCAN00_INSTANCE, buff, &buffConfig);
+        (void)CAN_PrepareTx(CAN_OVER_FLEXCAN00_INSTANCE, buff, BENCH_ID, 8U, &handles[buff - 1U]);
+        hwBuffIdx = handles[buff - 1U].hwBuffIdx;
+        pending |= 1UL << hwBuffIdx;
+    }
+    HOST_SetModelsEnabled(false);
+
+    /* Only the sends are timed; the handler completes them between the rounds */
+    for (round = 0U; round < BENCH_SENDS; round += BENCH_PAL_BUFFS)
+    {
+        for (j = 0U; j < 2U; j++)
+        {
+            start = HOST_NowNs();
+            for (buff = 1U; buff <= BENCH_PAL_BUFFS; buff++)
+            {
+                if (j == 0U)
+                {
+                    failures += (CAN_Send(CAN_OVER_FLEXCAN00_INSTANCE, buff, &message) != STATUS_SUCCESS) ? 1U : 0U;
+                }
+                else
+                {
+                    failures += (CAN_SendPrepared(&handles[buff - 1U], data) != STATUS_SUCCESS) ? 1U : 0U;
+                }
+            }
+            elapsed[j] += HOST_NowNs() - start;
+            CAN0->IFLAG1 = pending;
+            FLEXCAN_IRQHandler(0U);
+        }
+    }
+
+    HOST_SetModelsEnabled(true);
+    (void)CAN_Deinit(CAN_OVER_FLEXCAN00_INSTANCE);
+
+    round = (BENCH_SENDS / BENCH_PAL_BUFFS) * BENCH_PAL_BUFFS;
+    printf("can pal send: %5.1f ns CAN_Send, %5.1f ns CAN_SendPrepared, %u failed\n",
+           (double)elapsed[0] / round, (double)elapsed[1] / round, (unsigned)failures);
+}
+
+/*******************************************************************************
+ * eDMA transmission
+ ******************************************************************************/
+
+/* Sets up CAN0 with a pool of MBs loaded by the eDMA and prepares a burst of
+ * frames of the same ID */
+static void StartTxDma(void)
+{
+    edma_user_config_t userConfig;
+    edma_channel_config_t chnConfig;
+    edma_chn_state_t * const chnStates[] = { &s_dmaChnState };
+    const edma_channel_config_t * const chnConfigs[] = { &chnConfig };
+    flexcan_user_config_t config;
+    uint32_t i;
+
+    FLEXCAN_DRV_GetDefaultConfig(&config);
+    config.max_num_mb = 32U;
+    config.flexcanMode = FLEXCAN_NORMAL_MODE;
+    (void)FLEXCAN_DRV_Init(0U, &s_state, &config);
+
+    memset(&userConfig, 0, sizeof(userConfig));
+    userConfig.chnArbitration = EDMA_ARBITRATION_FIXED_PRIORITY;
+    memset(&chnConfig, 0, sizeof(chnConfig));
+    chnConfig.channelPriority = EDMA_CHN_DEFAULT_PRIORITY;
+    chnConfig.virtChnConfig = BENCH_DMA_CHANNEL;
+    chnConfig.source = EDMA_REQ_DMAMUX_ALWAYS_ENABLED0;
+    (void)EDMA_DRV_Init(&s_dmaState, &userConfig, chnStates, chnConfigs, 1U);
+    (void)FLEXCAN_DRV_ConfigTxDma(0U, BENCH_DMA_CHANNEL, BENCH_DMA_MB, BENCH_DMA_MBS,
+                                  (edma_software_tcd_t *)s_txDmaStcd);
+
+    for (i = 0U; i < BENCH_BURST; i++)
+    {
+        s_burstData[i][0] = (uint8_t)i;
+        FLEXCAN_DRV_PrepareTxDmaFrame(0U, &s_stdInfo, BENCH_ID, s_burstData[i], &s_txDmaFrames[i]);
+    }
+}
+
+/* Sends a burst frame by frame over the MBs of the pool, in rounds of one
+ * frame per MB; the handler completes each MB, one entry per frame */
+static void SendBurstPerFrame(bool modelsEnabled)
+{
+    uint32_t frame;
+    uint32_t mb;
+
+    for (frame = 0U; frame < BENCH_BURST; frame += BENCH_DMA_MBS)
+    {
+        for (mb = 0U; mb < BENCH_DMA_MBS; mb++)
+        {
+            (void)FLEXCAN_DRV_Send(0U, (uint8_t)(BENCH_DMA_MB + mb), &s_stdInfo, BENCH_ID,
+                                   s_burstData[frame + mb]);
+        }
+        if (modelsEnabled)
+        {
+            HOST_RunUntilIdle();
+        }
+        else
+        {
+            for (mb = 0U; mb < BENCH_DMA_MBS; mb++)
+            {
+                CAN0->IFLAG1 = 1UL << (BENCH_DMA_MB + mb);
+                FLEXCAN_IRQHandler(0U);
+            }
+        }
+    }
+}
+
+/* Sends a burst as an eDMA chain; the handler starts each next batch from the
+ * interrupt of the last MB of the pool */
+static void SendBurstDmaChain(bool modelsEnabled)
+{
+    uint32_t batch;
+
+    (void)FLEXCAN_DRV_SendDmaChain(0U, s_txDmaFrames, BENCH_BURST);
+    if (modelsEnabled)
+    {
+        HOST_RunUntilIdle();
+    }
+    else
+    {
+        for (batch = 0U; batch < (BENCH_BURST / BENCH_DMA_MBS); batch++)
+        {
+            CAN0->IFLAG1 = 1UL << (BENCH_DMA_MB + BENCH_DMA_MBS - 1U);
+            FLEXCAN_IRQHandler(0U);
+        }
+    }
+}
+
+/* CPU cost of a burst of frames of the same ID, sent frame by frame with
+ * FLEXCAN_DRV_Send or as a chain with FLEXCAN_DRV_SendDmaChain over the same
+ * pool of MBs. The time covers the calls and the handler entries; the copies
+ * of the eDMA chain are left to the eDMA. */
+static void BenchTxDmaChain(bool chain)
+{
+    host_stats_t stats;
+    uint64_t elapsed;
+    uint64_t start;
+    uint32_t round;
+
+    HOST_Init();
+    StartTxDma();
+
+    /* Register accesses, with the frames sent on the bus as they are loaded */
+    HOST_ResetStats();
+    if (chain)
+    {
+        SendBurstDmaChain(true);
+    }
+    else
+    {
+        SendBurstPerFrame(true);
+    }
+    HOST_GetStats(&stats);
+
+    /* Time, the handler servicing the flags primed in IFLAG1 */
+    HOST_SetModelsEnabled(false);
+    start = HOST_NowNs();
+    for (round = 0U; round < BENCH_BURSTS; round++)
+    {
+        if (chain)
+        {
+            SendBurstDmaChain(false);
+        }
+        else
+        {
+            SendBurstPerFrame(false);
+        }
+    }
+    elapsed = HOST_NowNs() - start;
+
+    HOST_SetModelsEnabled(true);
+    (void)EDMA_DRV_Deinit();
+
+    printf("tx burst of %u frames %-16s %3u irq, %4u reads, %4u writes, %7.1f ns/burst, %5.1f ns/frame\n",
+           (unsigned)BENCH_BURST, chain ? "SendDmaChain:" : "Send per frame:", (unsigned)stats.irqs,
+           (unsigned)stats.reads, (unsigned)stats.writes, (double)elapsed / BENCH_BURSTS,
+           (double)elapsed / BENCH_BURSTS / BENCH_BURST);
+}
+
+/*******************************************************************************
+ * Main
+ ******************************************************************************/
+
+int main(void)
+{
+    BenchIsr(1U);
+    BenchIsr(8U);
+    BenchIsr(32U);
+
+    BenchMsgBuffAddr(FLEXCAN_PAYLOAD_SIZE_8);
+    BenchMsgBuffAddr(FLEXCAN_PAYLOAD_SIZE_16);
+    BenchMsgBuffAddr(FLEXCAN_PAYLOAD_SIZE_32);
+    BenchMsgBuffAddr(FLEXCAN_PAYLOAD_SIZE_64);
+
+    BenchPayloadCopy();
+
+    BenchPalSend();
+
+    BenchTxDmaChain(false);
+    BenchTxDmaChain(true);
+
+    return 0;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,352 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Tests of the ISO-TP layer on the FlexCAN model. Two ISO-TP ends talk to
+ * each other, either as two channels of CAN0 in loopback mode or as two
+ * modules on the bus; end 0 sends, end 1 receives.
+ */
+
+#include <string.h>
+#include "host.h"
+#include "host_can.h"
+#include "flexcan_isotp.h"
+#include "interrupt_manager.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define ENDS        2U
+#define REQUEST_ID  0x7E0U
+#define RESPONSE_ID 0x7E8U
+/* The Rx MB goes before the Tx MB, so a flow control frame received together
+ * with the Tx completion of the frame it answers is serviced first */
+#define RX_MB       1U
+#define TX_MB       2U
+#define BUFFER_SIZE 8192U
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static flexcan_state_t s_can[ENDS];
+static flexcan_isotp_state_t s_isotp[ENDS];
+static flexcan_isotp_channel_t s_channels[ENDS];
+static flexcan_isotp_channel_config_t s_configs[ENDS];
+static uint8_t s_buffers[ENDS][BUFFER_SIZE];
+static uint8_t s_message[BUFFER_SIZE];
+static uint32_t s_events[ENDS][4];
+static uint32_t s_busBits;
+static uint32_t s_busFrames;
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+
+static void IsoTpCallback(uint8_t instance, flexcan_isotp_event_t eventType,
+                          uint32_t channel, flexcan_isotp_state_t *isotpState)
+{
+    (void)isotpState;
+    /* End 1 is either CAN1 or the second channel of CAN0 */
+    s_events[instance + channel][eventType]++;
+}
+
+/* Nominal length of the frames on the bus, counted as the model does */
+static void BusHook(uint32_t instance, const host_can_frame_t *frame)
+{
+    (void)instance;
+    s_busBits += (frame->extended ? 67U : 47U) + (8U * frame->length);
+    s_busFrames++;
+}
+
+static void InitEnd(uint8_t instance, uint8_t txDataLength, bool loopback)
+{
+    flexcan_user_config_t config;
+
+    FLEXCAN_DRV_GetDefaultConfig(&config);
+    config.flexcanMode = loopback ? FLEXCAN_LOOPBACK_MODE : FLEXCAN_NORMAL_MODE;
+    config.fd_enable = (txDataLength > 8U);
+    config.payload = (txDataLength > 8U) ? FLEXCAN_PAYLOAD_SIZE_64 : FLEXCAN_PAYLOAD_SIZE_8;
+    config.max_num_mb = (txDataLength > 8U) ? 7U : 16U;
+    HOST_CHECK_EQ(FLEXCAN_DRV_Init(instance, &s_can[instance], &config), STATUS_SUCCESS);
+    FLEXCAN_DRV_SetRxMaskType(instance, FLEXCAN_RX_MASK_GLOBAL);
+    FLEXCAN_DRV_SetRxMbGlobalMask(instance, FLEXCAN_MSG_ID_STD, 0x7FFU);
+}
+
+static void ConfigEnd(uint32_t end, uint8_t txDataLength, uint8_t blockSize, uint8_t mbOffset)
+{
+    flexcan_isotp_channel_config_t *config = &s_configs[end];
+
+    memset(config, 0, sizeof(*config));
+    config->txId = (end == 0U) ? REQUEST_ID : RESPONSE_ID;
+    config->rxId = (end == 0U) ? RESPONSE_ID : REQUEST_ID;
+    config->idType = FLEXCAN_MSG_ID_STD;
+    config->txMb = TX_MB + mbOffset;
+    config->rxMb = RX_MB + mbOffset;
+    config->txDataLength = txDataLength;
+    config->enableBrs = (txDataLength > 8U);
+    config->padding = 0xCCU;
+    config->blockSize = blockSize;
+    config->stMin = 0U;
+    config->rxBuffer = s_buffers[end];
+    config->rxBufferSize = BUFFER_SIZE;
+    config->timeoutMs = FLEXCAN_ISOTP_TIMEOUT_MS;
+}
+
+static void StartIsoTp(uint8_t instance, uint32_t end, uint32_t channelCount)
+{
+    flexcan_isotp_user_config_t isotpConfig;
+
+    isotpConfig.channelConfigs = &s_configs[end];
+    isotpConfig.channelCount = channelCount;
+    isotpConfig.callback = IsoTpCallback;
+    isotpConfig.callbackParam = NULL;
+    isotpConfig.canCallback = NULL;
+    HOST_CHECK_EQ(FLEXCAN_ISOTP_Init(instance, &s_isotp[instance], &s_channels[end], &isotpConfig),
+                  STATUS_SUCCESS);
+}
+
+static void ResetCounters(void)
+{
+    memset(s_events, 0, sizeof(s_events));
+    s_busBits = 0U;
+    s_busFrames = 0U;
+    HOST_CAN_SetTxHook(BusHook);
+}
+
+/* Both ends are channels of CAN0, which receives its own frames */
+static void StartLoopback(uint8_t txDataLength, uint8_t blockSize)
+{
+    ResetCounters();
+    InitEnd(0U, txDataLength, true);
+    ConfigEnd(0U, txDataLength, blockSize, 0U);
+    ConfigEnd(1U, txDataLength, blockSize, 2U);
+    StartIsoTp(0U, 0U, ENDS);
+}
+
+/* CAN0 sends to CAN1 over the bus, with classical CAN frames */
+static void StartNodes(uint8_t blockSize)
+{
+    uint8_t node;
+
+    ResetCounters();
+    for (node = 0U; node < ENDS; node++)
+    {
+        InitEnd(node, 8U, false);
+        HOST_CAN_Connect(node, true);
+        ConfigEnd(node, 8U, blockSize, 0U);
+        StartIsoTp(node, node, 1U);
+    }
+}
+
+static void FillMessage(uint32_t length)
+{
+    uint32_t i;
+
+    for (i = 0U; i < length; i++)
+    {
+        s_message[i] = (uint8_t)((i * 7U) + (i >> 8U));
+    }
+}
+
+/* Frames of a segmented message: first frame, consecutive frames and one flow
+ * control frame after the first frame and after each full block */
+static uint32_t SegmentedFrames(uint32_t length, uint32_t txDataLength, uint32_t blockSize)
+{
+    uint32_t first = txDataLength - ((length > 4095U) ? 6U : 2U);
+    uint32_t consecutive = ((length - first) + (txDataLength - 2U)) / (txDataLength - 1U);
+    uint32_t flowControls = 1U + ((blockSize != 0U) ? ((consecutive - 1U) / blockSize) : 0U);
+
+    return 1U + consecutive + flowControls;
+}
+
+static void CheckReceived(uint32_t length)
+{
+    HOST_CHECK_EQ(s_events[0][FLEXCAN_ISOTP_EVENT_TX_COMPLETE], 1U);
+    HOST_CHECK_EQ(s_events[0][FLEXCAN_ISOTP_EVENT_TX_ERROR], 0U);
+    HOST_CHECK_EQ(s_events[1][FLEXCAN_ISOTP_EVENT_RX_COMPLETE], 1U);
+    HOST_CHECK_EQ(s_events[1][FLEXCAN_ISOTP_EVENT_RX_ERROR], 0U);
+    HOST_CHECK_EQ(s_channels[1].rxLength, length);
+    HOST_CHECK(memcmp(s_buffers[1], s_message, length) == 0);
+}
+
+/*******************************************************************************
+ * Goodput
+ ******************************************************************************/
+
+/* A message crosses the loopback in the fewest frames the frame size and block
+ * size allow, driven by the interrupts alone; returns the goodput in percent
+ * of the nominal bus bits */
+static uint32_t RunGoodput(uint32_t length, uint8_t txDataLength, uint8_t blockSize)
+{
+    StartLoopback(txDataLength, blockSize);
+    FillMessage(length);
+
+    HOST_CHECK_EQ(FLEXCAN_ISOTP_Send(0U, 0U, s_message, length), STATUS_SUCCESS);
+    HOST_RunUntilIdle();
+
+    CheckReceived(length);
+    HOST_CHECK_EQ(s_busFrames, SegmentedFrames(length, txDataLength, blockSize));
+    HOST_CHECK_EQ(FLEXCAN_ISOTP_GetTransferStatus(0U, 0U), STATUS_SUCCESS);
+
+    return (length * 8U * 100U) / s_busBits;
+}
+
+static void TestGoodputClassic(void)
+{
+    /* 7 payload bytes per 111-bit frame, less one flow control frame per block */
+    HOST_CHECK(RunGoodput(4095U, 8U, 8U) >= 44U);
+    HOST_CHECK(RunGoodput(4095U, 8U, 0U) >= 44U);
+    HOST_CHECK(RunGoodput(100U, 8U, 1U) >= 24U);
+}
+
+static void TestGoodputFd(void)
+{
+    /* 63 payload bytes per 559-bit frame */
+    HOST_CHECK(RunGoodput(4095U, 64U, 0U) >= 87U);
+    HOST_CHECK(RunGoodput(6000U, 64U, 4U) >= 85U);
+    HOST_CHECK(RunGoodput(1000U, 16U, 2U) >= 50U);
+}
+
+/*******************************************************************************
+ * Flow control
+ ******************************************************************************/
+
+/* A flow control frame received before the Tx completion of the frame ending
+ * the block is applied at the completion */
+static void TestFlowControlBeforeTxComplete(void)
+{
+    uint32_t rounds = 0U;
+
+    StartNodes(2U);
+    FillMessage(100U);
+    HOST_CAN_SetAutoTransmit(false);
+    HOST_CHECK_EQ(FLEXCAN_ISOTP_Send(0U, 0U, s_message, 100U), STATUS_SUCCESS);
+
+    while ((FLEXCAN_ISOTP_GetTransferStatus(0U, 0U) == STATUS_BUSY) && (rounds < 100U))
+    {
+        /* CAN0 services the completion of its frame only after the answer */
+        INT_SYS_DisableIRQ(CAN0_ORed_0_15_MB_IRQn);
+        (void)HOST_CAN_TransmitNext(0U);
+        HOST_DispatchIrqs();
+        (void)HOST_CAN_TransmitNext(1U);
+        INT_SYS_EnableIRQ(CAN0_ORed_0_15_MB_IRQn);
+        HOST_DispatchIrqs();
+        rounds++;
+    }
+
+    CheckReceived(100U);
+    HOST_CHECK_EQ(s_busFrames, SegmentedFrames(100U, 8U, 2U));
+}
+
+/* Wait and overflow flow statuses latched the same way */
+static void TestFlowControlLatchedOverflow(void)
+{
+    StartNodes(0U);
+    s_configs[1].rxBufferSize = 50U;
+    FillMessage(100U);
+    HOST_CAN_SetAutoTransmit(false);
+    HOST_CHECK_EQ(FLEXCAN_ISOTP_Send(0U, 0U, s_message, 100U), STATUS_SUCCESS);
+
+    INT_SYS_DisableIRQ(CAN0_ORed_0_15_MB_IRQn);
+    HOST_CHECK(HOST_CAN_TransmitNext(0U));
+    HOST_DispatchIrqs();
+    HOST_CHECK(HOST_CAN_TransmitNext(1U));
+    INT_SYS_EnableIRQ(CAN0_ORed_0_15_MB_IRQn);
+    HOST_DispatchIrqs();
+
+    HOST_CHECK_EQ(s_events[0][FLEXCAN_ISOTP_EVENT_TX_ERROR], 1U);
+    HOST_CHECK_EQ(FLEXCAN_ISOTP_GetTransferStatus(0U, 0U), STATUS_SUCCESS);
+    HOST_CHECK_EQ(HOST_CAN_PendingCount(0U), 0U);
+}
+
+/*******************************************************************************
+ * Timeouts
+ ******************************************************************************/
+
+/* N_As: a frame which cannot leave the Tx MB is taken back and the message
+ * aborted; the channel then sends again */
+static void TestTxMbTimeout(void)
+{
+    StartNodes(0U);
+    FillMessage(20U);
+    HOST_CAN_SetAutoTransmit(false);
+    HOST_CHECK_EQ(FLEXCAN_ISOTP_Send(0U, 0U, s_message, 20U), STATUS_SUCCESS);
+    HOST_CHECK_EQ(HOST_CAN_PendingCount(0U), 1U);
+
+    HOST_AdvanceMs(FLEXCAN_ISOTP_TIMEOUT_MS - 1U);
+    FLEXCAN_ISOTP_MainFunction(0U);
+    HOST_CHECK_EQ(s_events[0][FLEXCAN_ISOTP_EVENT_TX_ERROR], 0U);
+    HOST_CHECK_EQ(FLEXCAN_ISOTP_Send(0U, 0U, s_message, 20U), STATUS_BUSY);
+
+    HOST_AdvanceMs(1U);
+    FLEXCAN_ISOTP_MainFunction(0U);
+    HOST_CHECK_EQ(s_events[0][FLEXCAN_ISOTP_EVENT_TX_ERROR], 1U);
+    HOST_CHECK_EQ(HOST_CAN_PendingCount(0U), 0U);
+    HOST_CHECK_EQ(FLEXCAN_ISOTP_GetTransferStatus(0U, 0U), STATUS_SUCCESS);
+
+    HOST_CAN_SetAutoTransmit(true);
+    s_events[0][FLEXCAN_ISOTP_EVENT_TX_ERROR] = 0U;
+    HOST_CHECK_EQ(FLEXCAN_ISOTP_Send(0U, 0U, s_message, 20U), STATUS_SUCCESS);
+    HOST_RunUntilIdle();
+    CheckReceived(20U);
+}
+
+/* N_Ar: a flow control frame which cannot leave the Tx MB aborts the
+ * reception; the sender then runs into N_Bs */
+static void TestFlowControlTimeout(void)
+{
+    StartNodes(0U);
+    FillMessage(20U);
+    HOST_CAN_SetAutoTransmit(false);
+    HOST_CHECK_EQ(FLEXCAN_ISOTP_Send(0U, 0U, s_message, 20U), STATUS_SUCCESS);
+    HOST_CHECK(HOST_CAN_TransmitNext(0U));
+    HOST_RunUntilIdle();
+    HOST_CHECK_EQ(HOST_CAN_PendingCount(1U), 1U);
+
+    HOST_AdvanceMs(FLEXCAN_ISOTP_TIMEOUT_MS);
+    FLEXCAN_ISOTP_MainFunction(1U);
+    HOST_CHECK_EQ(s_events[1][FLEXCAN_ISOTP_EVENT_RX_ERROR], 1U);
+    HOST_CHECK_EQ(HOST_CAN_PendingCount(1U), 0U);
+
+    FLEXCAN_ISOTP_MainFunction(0U);
+    HOST_CHECK_EQ(s_events[0][FLEXCAN_ISOTP_EVENT_TX_ERROR], 1U);
+    HOST_CHECK_EQ(FLEXCAN_ISOTP_GetTransferStatus(0U, 0U), STATUS_SUCCESS);
+}
+
+/*******************************************************************************
+ * Main
+ ******************************************************************************/
+
+static const host_test_t s_tests[] = {
+    { "GoodputClassic", TestGoodputClassic },
+    { "GoodputFd", TestGoodputFd },
+    { "FlowControlBeforeTxComplete", TestFlowControlBeforeTxComplete },
+    { "FlowControlLatchedOverflow", TestFlowControlLatchedOverflow },
+    { "TxMbTimeout", TestTxMbTimeout },
+    { "FlowControlTimeout", TestFlowControlTimeout },
+};
+
+int main(void)
+{
+    return HOST_RunTests("flexcan_isotp", s_tests, sizeof(s_tests) / sizeof(s_tests[0]));
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,294 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Tests of the time-triggered transmit schedule on the FlexCAN and LPIT
+ * models. The tests move the time of the LPIT forward slot by slot, holding
+ * the interrupts off for a random latency after each expiry.
+ */
+
+#include <string.h>
+#include "host.h"
+#include "host_can.h"
+#include "host_lpit.h"
+#include "flexcan_schedule.h"
+#include "interrupt_manager.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define SLOTS           4U
+#define CYCLE_LENGTH    6000U
+#define LPIT_CHANNEL    0U
+#define SLOT_ID         0x100U
+#define MAX_LATENCY     200U
+#define CYCLES          50U
+/* Slot 2 leaves its frame empty every third cycle */
+#define EMPTY_SLOT      2U
+#define EMPTY_PERIOD    3U
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static flexcan_state_t s_state;
+static flexcan_sched_state_t s_sched;
+static flexcan_sched_slot_t s_slots[SLOTS];
+static flexcan_sched_slot_config_t s_slotConfigs[SLOTS];
+static flexcan_sched_config_t s_config;
+static uint32_t s_produced[SLOTS];
+static uint32_t s_seed;
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+
+static uint32_t Random(void)
+{
+    s_seed = (s_seed * 1103515245U) + 12345U;
+    return s_seed >> 8;
+}
+
+/* Sends the slot number and the number of frames produced for the slot */
+static bool Producer(uint8_t instance, uint32_t slot, uint8_t *data, void *param)
+{
+    uint32_t count = s_produced[slot]++;
+
+    (void)instance;
+    (void)param;
+    memset(data, 0, 8U);
+    data[0] = (uint8_t)slot;
+    data[1] = (uint8_t)count;
+
+    return !((slot == EMPTY_SLOT) && ((count % EMPTY_PERIOD) == (EMPTY_PERIOD - 1U)));
+}
+
+static void LpitHandler(void)
+{
+    FLEXCAN_SCHED_IRQHandler(0U);
+}
+
+/* Slots at 0, 1000, 2500 and 4000 counts; the last one shares the MB of the first */
+static void StartSchedule(void)
+{
+    static const uint32_t offsets[SLOTS] = { 0U, 1000U, 2500U, 4000U };
+    static const uint8_t mbs[SLOTS] = { 8U, 9U, 10U, 8U };
+    flexcan_user_config_t canConfig;
+    lpit_user_config_t lpitConfig = { false, false };
+    uint32_t i;
+
+    FLEXCAN_DRV_GetDefaultConfig(&canConfig);
+    canConfig.flexcanMode = FLEXCAN_NORMAL_MODE;
+    HOST_CHECK_EQ(FLEXCAN_DRV_Init(0U, &s_state, &canConfig), STATUS_SUCCESS);
+    LPIT_DRV_Init(0U, &lpitConfig);
+    INT_SYS_InstallHandler(LPIT0_Ch0_IRQn, LpitHandler, NULL);
+
+    for (i = 0U; i < SLOTS; i++)
+    {
+        s_slotConfigs[i].offset = offsets[i];
+        s_slotConfigs[i].mbIdx = mbs[i];
+        s_slotConfigs[i].msgId = SLOT_ID + i;
+        s_slotConfigs[i].txInfo.msg_id_type = FLEXCAN_MSG_ID_STD;
+        s_slotConfigs[i].txInfo.data_length = 8U;
+        s_slotConfigs[i].txInfo.fd_enable = false;
+        s_slotConfigs[i].txInfo.fd_padding = 0U;
+        s_slotConfigs[i].txInfo.enable_brs = false;
+        s_slotConfigs[i].txInfo.is_remote = false;
+        s_slotConfigs[i].producer = Producer;
+        s_slotConfigs[i].producerParam = NULL;
+        s_produced[i] = 0U;
+    }
+    s_config.slots = s_slotConfigs;
+    s_config.slotCount = SLOTS;
+    s_config.cycleLength = CYCLE_LENGTH;
+    s_config.lpitInstance = 0U;
+    s_config.lpitChannel = LPIT_CHANNEL;
+    HOST_CHECK_EQ(FLEXCAN_SCHED_Init(0U, &s_sched, s_slots, &s_config), STATUS_SUCCESS);
+    s_seed = 1U;
+}
+
+/* Time from the start of a slot to the start of the next one */
+static uint32_t Gap(uint32_t slot)
+{
+    return (slot == (SLOTS - 1U)) ? (CYCLE_LENGTH - s_slotConfigs[slot].offset) + s_slotConfigs[0].offset
+                                  : s_slotConfigs[slot + 1U].offset - s_slotConfigs[slot].offset;
+}
+
+/* Runs up to the next expiry, then holds the interrupt off for latency counts */
+static void FireSlot(uint32_t latency)
+{
+    uint32_t counts = HOST_LPIT_CountsToExpiry(LPIT_CHANNEL);
+
+    HOST_CpuDisableIrq();
+    HOST_LPIT_Advance(counts + latency);
+    HOST_CpuEnableIrq();
+    HOST_RunUntilIdle();
+}
+
+static void CheckTx(uint32_t index, uint32_t slot, uint32_t count)
+{
+    host_can_frame_t frame;
+
+    HOST_CHECK(HOST_CAN_GetTx(0U, index, &frame));
+    HOST_CHECK_EQ(frame.id, SLOT_ID + slot);
+    HOST_CHECK_EQ(frame.mb, s_slotConfigs[slot].mbIdx);
+    HOST_CHECK_EQ(frame.data[0], slot);
+    HOST_CHECK_EQ(frame.data[1], (uint8_t)count);
+}
+
+/*******************************************************************************
+ * Tests
+ ******************************************************************************/
+
+/* The slots start at their offsets whatever the interrupt latency, the frames
+ * leave in the slot order and the latency of every slot is measured */
+static void TestSlotOrderAndJitter(void)
+{
+    uint32_t minLatency[SLOTS], maxLatency[SLOTS], lastLatency[SLOTS], sent[SLOTS];
+    flexcan_sched_slot_t stats;
+    uint32_t latency = 0U;
+    uint32_t tx = 0U;
+    uint32_t cycle, slot;
+
+    StartSchedule();
+    for (slot = 0U; slot < SLOTS; slot++)
+    {
+        minLatency[slot] = 0xFFFFFFFFU;
+        maxLatency[slot] = 0U;
+        lastLatency[slot] = 0U;
+        sent[slot] = 0U;
+    }
+
+    FLEXCAN_SCHED_MainFunction(0U);
+    FLEXCAN_SCHED_Start(0U);
+    HOST_CHECK_EQ(HOST_LPIT_CountsToExpiry(LPIT_CHANNEL), Gap(SLOTS - 1U));
+
+    for (cycle = 0U; cycle < CYCLES; cycle++)
+    {
+        for (slot = 0U; slot < SLOTS; slot++)
+        {
+            /* The expiry comes one gap after the previous one */
+            if ((cycle != 0U) || (slot != 0U))
+            {
+                HOST_CHECK_EQ(latency + HOST_LPIT_CountsToExpiry(LPIT_CHANNEL), Gap((slot + SLOTS - 1U) % SLOTS));
+            }
+
+            latency = Random() % MAX_LATENCY;
+            FireSlot(latency);
+
+            if ((slot != EMPTY_SLOT) || ((cycle % EMPTY_PERIOD) != (EMPTY_PERIOD - 1U)))
+            {
+                CheckTx(tx, slot, cycle);
+                tx++;
+                sent[slot]++;
+                lastLatency[slot] = latency;
+                minLatency[slot] = (latency < minLatency[slot]) ? latency : minLatency[slot];
+                maxLatency[slot] = (latency > maxLatency[slot]) ? latency : maxLatency[slot];
+            }
+            HOST_CHECK_EQ(HOST_CAN_TxCount(0U), tx);
+
+            FLEXCAN_SCHED_MainFunction(0U);
+        }
+    }
+
+    for (slot = 0U; slot < SLOTS; slot++)
+    {
+        FLEXCAN_SCHED_GetSlotStats(0U, slot, &stats);
+        HOST_CHECK_EQ(stats.sent, sent[slot]);
+        HOST_CHECK_EQ(stats.empty, CYCLES - sent[slot]);
+        HOST_CHECK_EQ(stats.missed, 0U);
+        HOST_CHECK_EQ(stats.lastLatency, lastLatency[slot]);
+        HOST_CHECK_EQ(stats.minLatency, minLatency[slot]);
+        HOST_CHECK_EQ(stats.maxLatency, maxLatency[slot]);
+    }
+    HOST_CHECK_EQ(s_sched.cycles, CYCLES);
+
+    FLEXCAN_SCHED_Stop(0U);
+}
+
+/* A slot whose frame is not ready at its time is skipped, the next ones are sent */
+static void TestMissedSlot(void)
+{
+    flexcan_sched_slot_t stats;
+    uint32_t slot;
+
+    StartSchedule();
+    FLEXCAN_SCHED_Start(0U);
+
+    FireSlot(0U);
+    HOST_CHECK_EQ(HOST_CAN_TxCount(0U), 0U);
+    FLEXCAN_SCHED_GetSlotStats(0U, 0U, &stats);
+    HOST_CHECK_EQ(stats.missed, 1U);
+
+    FLEXCAN_SCHED_MainFunction(0U);
+    for (slot = 1U; slot < SLOTS; slot++)
+    {
+        FireSlot(0U);
+        CheckTx(slot - 1U, slot, 0U);
+        FLEXCAN_SCHED_MainFunction(0U);
+    }
+    FireSlot(0U);
+    CheckTx(SLOTS - 1U, 0U, 0U);
+
+    FLEXCAN_SCHED_GetSlotStats(0U, 0U, &stats);
+    HOST_CHECK_EQ(stats.sent, 1U);
+    HOST_CHECK_EQ(stats.missed, 1U);
+
+    FLEXCAN_SCHED_Stop(0U);
+}
+
+/* Stopping the schedule discards the loaded frames and stops the timer */
+static void TestStop(void)
+{
+    uint32_t slot;
+
+    StartSchedule();
+    FLEXCAN_SCHED_MainFunction(0U);
+    FLEXCAN_SCHED_Start(0U);
+    FLEXCAN_SCHED_Stop(0U);
+
+    for (slot = 0U; slot < SLOTS; slot++)
+    {
+        HOST_CHECK(!s_slots[slot].loaded);
+        HOST_CHECK_EQ(FLEXCAN_DRV_GetTransferStatus(0U, s_slotConfigs[slot].mbIdx), STATUS_SUCCESS);
+    }
+
+    HOST_LPIT_Advance(2U * CYCLE_LENGTH);
+    HOST_RunUntilIdle();
+    HOST_CHECK_EQ(HOST_CAN_TxCount(0U), 0U);
+    HOST_CHECK_EQ(s_sched.cycles, 0U);
+}
+
+/*******************************************************************************
+ * Main
+ ******************************************************************************/
+
+static const host_test_t s_tests[] = {
+    { "SlotOrderAndJitter", TestSlotOrderAndJitter },
+    { "MissedSlot", TestMissedSlot },
+    { "Stop", TestStop },
+};
+
+int main(void)
+{
+    return HOST_RunTests("flexcan_schedule", s_tests, sizeof(s_tests) / sizeof(s_tests[0]));
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
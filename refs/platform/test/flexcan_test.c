@@ -0,0 +1,2210 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Tests of the FlexCAN driver against the FlexCAN model.
+ */
+
+#include <string.h>
+#include "host.h"
+#include "host_can.h"
+#include "host_dma.h"
+#include "flexcan_driver.h"
+#include "flexcan_hw_access.h"
+#include "edma_driver.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define RING_SIZE   8U
+#define RX_MB       4U
+#define RX_ID       0x123U
+#define QUEUE_MB    8U
+#define QUEUE_SIZE  8U
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static flexcan_state_t s_state;
+static flexcan_msgbuff_t s_ring[RING_SIZE];
+static flexcan_tx_frame_t s_queue[QUEUE_SIZE];
+
+static const flexcan_data_info_t s_stdInfo = {
+    .msg_id_type = FLEXCAN_MSG_ID_STD,
+    .data_length = 8U,
+    .fd_enable = false,
+    .fd_padding = 0U,
+    .enable_brs = false,
+    .is_remote = false,
+};
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+
+static void InitCanMbs(uint8_t instance, flexcan_state_t *state, uint32_t maxMb)
+{
+    flexcan_user_config_t config;
+
+    FLEXCAN_DRV_GetDefaultConfig(&config);
+    config.max_num_mb = maxMb;
+    config.flexcanMode = FLEXCAN_NORMAL_MODE;
+    HOST_CHECK_EQ(FLEXCAN_DRV_Init(instance, state, &config), STATUS_SUCCESS);
+}
+
+static void InitCan(uint8_t instance, flexcan_state_t *state)
+{
+    InitCanMbs(instance, state, 16U);
+}
+
+static void InjectStd(uint32_t instance, uint32_t id, uint8_t seq)
+{
+    host_can_frame_t frame;
+
+    memset(&frame, 0, sizeof(frame));
+    frame.id = id;
+    frame.length = 8U;
+    frame.data[0] = seq;
+    frame.data[7] = (uint8_t)~seq;
+    HOST_CAN_Inject(instance, &frame);
+}
+
+static void StartRing(void)
+{
+    InitCan(0U, &s_state);
+    FLEXCAN_DRV_SetRxMaskType(0U, FLEXCAN_RX_MASK_GLOBAL);
+    FLEXCAN_DRV_SetRxMbGlobalMask(0U, FLEXCAN_MSG_ID_STD, 0x7FFU);
+    HOST_CHECK_EQ(FLEXCAN_DRV_ConfigRxMb(0U, RX_MB, &s_stdInfo, RX_ID), STATUS_SUCCESS);
+    HOST_CHECK_EQ(FLEXCAN_DRV_ReceiveContinuous(0U, RX_MB, s_ring, RING_SIZE), STATUS_SUCCESS);
+}
+
+/*******************************************************************************
+ * Continuous reception
+ ******************************************************************************/
+
+/* A burst longer than the ring keeps the oldest frames and counts the rest */
+static void TestRxRingBurstOverflow(void)
+{
+    flexcan_msgbuff_t frames[RING_SIZE];
+    uint32_t ringOverflows;
+    uint32_t hwOverruns;
+    uint32_t count;
+    uint32_t i;
+
+    StartRing();
+
+    for (i = 0U; i < 20U; i++)
+    {
+        InjectStd(0U, RX_ID, (uint8_t)i);
+    }
+
+    FLEXCAN_DRV_GetRxRingOverflows(0U, RX_MB, &ringOverflows, &hwOverruns);
+    HOST_CHECK_EQ(ringOverflows, 12U);
+    HOST_CHECK_EQ(hwOverruns, 0U);
+
+    count = FLEXCAN_DRV_ReadRxRing(0U, RX_MB, frames, RING_SIZE);
+    HOST_CHECK_EQ(count, RING_SIZE);
+    for (i = 0U; i < count; i++)
+    {
+        HOST_CHECK_EQ(frames[i].msgId, RX_ID);
+        HOST_CHECK_EQ(frames[i].dataLen, 8U);
+        HOST_CHECK_EQ(frames[i].data[0], i);
+        HOST_CHECK_EQ(frames[i].data[7], (uint8_t)~i);
+    }
+    HOST_CHECK_EQ(FLEXCAN_DRV_ReadRxRing(0U, RX_MB, frames, RING_SIZE), 0U);
+}
+
+/* A consumer draining the ring between bursts loses nothing, across the
+ * wrap-around of the indexes */
+static void TestRxRingBurstDrained(void)
+{
+    flexcan_msgbuff_t frames[RING_SIZE];
+    uint32_t ringOverflows;
+    uint32_t expected = 0U;
+    uint32_t burst;
+    uint32_t i;
+
+    StartRing();
+
+    for (burst = 0U; burst < 50U; burst++)
+    {
+        uint32_t length = 1U + (burst % RING_SIZE);
+        uint32_t count;
+
+        for (i = 0U; i < length; i++)
+        {
+            InjectStd(0U, RX_ID, (uint8_t)(expected + i));
+        }
+
+        /* Drain in two reads, the first one partial */
+        count = FLEXCAN_DRV_ReadRxRing(0U, RX_MB, frames, length / 2U);
+        count += FLEXCAN_DRV_ReadRxRing(0U, RX_MB, &frames[count], RING_SIZE - count);
+        HOST_CHECK_EQ(count, length);
+        for (i = 0U; i < count; i++)
+        {
+            HOST_CHECK_EQ(frames[i].data[0], (uint8_t)(expected + i));
+        }
+        expected += length;
+    }
+
+    FLEXCAN_DRV_GetRxRingOverflows(0U, RX_MB, &ringOverflows, NULL);
+    HOST_CHECK_EQ(ringOverflows, 0U);
+}
+
+/* Frames overwritten in the MB while the interrupts are masked are counted */
+static void TestRxRingHwOverrun(void)
+{
+    flexcan_msgbuff_t frames[RING_SIZE];
+    uint32_t hwOverruns;
+
+    StartRing();
+
+    HOST_CpuDisableIrq();
+    InjectStd(0U, RX_ID, 1U);
+    InjectStd(0U, RX_ID, 2U);
+    InjectStd(0U, RX_ID, 3U);
+    HOST_CpuEnableIrq();
+
+    FLEXCAN_DRV_GetRxRingOverflows(0U, RX_MB, NULL, &hwOverruns);
+    HOST_CHECK_EQ(hwOverruns, 1U);
+    HOST_CHECK_EQ(FLEXCAN_DRV_ReadRxRing(0U, RX_MB, frames, RING_SIZE), 1U);
+    HOST_CHECK_EQ(frames[0].data[0], 3U);
+}
+
+/* Aborting stops the ring; the frames already in it can still be read */
+static void TestRxRingAbort(void)
+{
+    flexcan_msgbuff_t frames[RING_SIZE];
+
+    StartRing();
+
+    InjectStd(0U, RX_ID, 1U);
+    InjectStd(0U, RX_ID, 2U);
+    HOST_CHECK_EQ(FLEXCAN_DRV_AbortTransfer(0U, RX_MB), STATUS_SUCCESS);
+    InjectStd(0U, RX_ID, 3U);
+
+    HOST_CHECK_EQ(FLEXCAN_DRV_ReadRxRing(0U, RX_MB, frames, RING_SIZE), 2U);
+    HOST_CHECK_EQ(frames[1].data[0], 2U);
+    HOST_CHECK_EQ(FLEXCAN_DRV_ReceiveContinuous(0U, RX_MB, s_ring, RING_SIZE), STATUS_SUCCESS);
+}
+
+static void TestRxRingArguments(void)
+{
+    InitCan(0U, &s_state);
+
+    HOST_CHECK_ASSERT((void)FLEXCAN_DRV_ReceiveContinuous(0U, FEATURE_CAN_MAX_MB_NUM, s_ring, RING_SIZE));
+    HOST_CHECK_ASSERT((void)FLEXCAN_DRV_ReceiveContinuous(0U, RX_MB, s_ring, 6U));
+    HOST_CHECK_ASSERT((void)FLEXCAN_DRV_ReceiveContinuous(0U, RX_MB, NULL, RING_SIZE));
+}
+
+/*******************************************************************************
+ * Interrupt handler
+ ******************************************************************************/
+
+static void TestCountLeadingZeros(void)
+{
+    uint32_t zeros;
+
+    COUNT_LEADING_ZEROS_32(0U, zeros);
+    HOST_CHECK_EQ(zeros, 32U);
+    COUNT_LEADING_ZEROS_32(1U, zeros);
+    HOST_CHECK_EQ(zeros, 31U);
+    COUNT_LEADING_ZEROS_32(0x00010000U, zeros);
+    HOST_CHECK_EQ(zeros, 15U);
+    COUNT_LEADING_ZEROS_32(0x80000000U, zeros);
+    HOST_CHECK_EQ(zeros, 0U);
+}
+
+/* Frames pending in several MBs, on both MB interrupt lines, are all serviced
+ * by a single entry of the handler */
+static void TestIsrServicesAllPendingMbs(void)
+{
+    static flexcan_msgbuff_t frames[32];
+    host_stats_t stats;
+    uint32_t mb;
+
+    InitCanMbs(0U, &s_state, 32U);
+    FLEXCAN_DRV_SetRxMaskType(0U, FLEXCAN_RX_MASK_GLOBAL);
+    FLEXCAN_DRV_SetRxMbGlobalMask(0U, FLEXCAN_MSG_ID_STD, 0x7FFU);
+    for (mb = 0U; mb < 32U; mb++)
+    {
+        HOST_CHECK_EQ(FLEXCAN_DRV_ConfigRxMb(0U, (uint8_t)mb, &s_stdInfo, 0x100U + mb), STATUS_SUCCESS);
+        HOST_CHECK_EQ(FLEXCAN_DRV_Receive(0U, (uint8_t)mb, &frames[mb]), STATUS_SUCCESS);
+    }
+
+    /* Frames arrive in the reverse order of the MBs */
+    HOST_CpuDisableIrq();
+    for (mb = 32U; mb > 0U; mb--)
+    {
+        InjectStd(0U, 0x100U + (mb - 1U), (uint8_t)(mb - 1U));
+    }
+    HOST_ResetStats();
+    HOST_CpuEnableIrq();
+
+    HOST_GetStats(&stats);
+    HOST_CHECK_EQ(stats.irqs, 1U);
+    for (mb = 0U; mb < 32U; mb++)
+    {
+        HOST_CHECK_EQ(FLEXCAN_DRV_GetTransferStatus(0U, (uint8_t)mb), STATUS_SUCCESS);
+        HOST_CHECK_EQ(frames[mb].msgId, 0x100U + mb);
+        HOST_CHECK_EQ(frames[mb].data[0], mb);
+    }
+    HOST_CHECK(!HOST_IsIrqPending(CAN0_ORed_0_15_MB_IRQn));
+    HOST_CHECK(!HOST_IsIrqPending(CAN0_ORed_16_31_MB_IRQn));
+}
+
+/*******************************************************************************
+ * Message buffer addresses
+ ******************************************************************************/
+
+/* The MB address table follows the RAM layout for every payload size: 512 byte
+ * blocks holding as many whole MBs as fit, the MBs past the RAM having none.
+ * A full frame sent from the last MB in loopback lands in the first one. */
+static void TestMsgBuffRegions(void)
+{
+    static const uint32_t payloads[] = { 8U, 16U, 32U, 64U };
+    flexcan_user_config_t config;
+    flexcan_data_info_t info;
+    flexcan_msgbuff_t frame;
+    uint8_t data[64];
+    uint32_t sizeIdx;
+    uint32_t mb;
+    uint32_t i;
+
+    for (sizeIdx = 0U; sizeIdx < 4U; sizeIdx++)
+    {
+        uint32_t mbSize = 8U + payloads[sizeIdx];
+        uint32_t perBlock = 512U / mbSize;
+        uint32_t mbCount = (FEATURE_CAN0_MAX_MB_NUM * 16U) / mbSize;
+        uint32_t lastMb = mbCount - 1U;
+
+        HOST_Init();
+        FLEXCAN_DRV_GetDefaultConfig(&config);
+        config.fd_enable = true;
+        config.payload = (flexcan_fd_payload_size_t)sizeIdx;
+        config.max_num_mb = mbCount;
+        config.flexcanMode = FLEXCAN_LOOPBACK_MODE;
+        HOST_CHECK_EQ(FLEXCAN_DRV_Init(0U, &s_state, &config), STATUS_SUCCESS);
+
+        for (mb = 0U; mb < FEATURE_CAN_MAX_MB_NUM; mb++)
+        {
+            volatile uint32_t *expected = NULL;
+
+            if (mb < mbCount)
+            {
+                expected = &CAN0->RAMn[(128U * (mb / perBlock)) + ((mb % perBlock) * (mbSize / 4U))];
+            }
+            HOST_CHECK(s_state.mbRegions[mb] == expected);
+        }
+
+        info = s_stdInfo;
+        info.fd_enable = true;
+        info.data_length = (uint8_t)payloads[sizeIdx];
+        for (i = 0U; i < payloads[sizeIdx]; i++)
+        {
+            data[i] = (uint8_t)(sizeIdx + (i * 7U));
+        }
+        FLEXCAN_DRV_SetRxMaskType(0U, FLEXCAN_RX_MASK_GLOBAL);
+        FLEXCAN_DRV_SetRxMbGlobalMask(0U, FLEXCAN_MSG_ID_STD, 0x7FFU);
+        HOST_CHECK_EQ(FLEXCAN_DRV_ConfigRxMb(0U, 0U, &info, RX_ID), STATUS_SUCCESS);
+        HOST_CHECK_EQ(FLEXCAN_DRV_Receive(0U, 0U, &frame), STATUS_SUCCESS);
+        HOST_CHECK_EQ(FLEXCAN_DRV_Send(0U, (uint8_t)lastMb, &info, RX_ID, data), STATUS_SUCCESS);
+        HOST_RunUntilIdle();
+
+        HOST_CHECK_EQ(FLEXCAN_DRV_GetTransferStatus(0U, (uint8_t)lastMb), STATUS_SUCCESS);
+        HOST_CHECK_EQ(FLEXCAN_DRV_GetTransferStatus(0U, 0U), STATUS_SUCCESS);
+        HOST_CHECK_EQ(frame.msgId, RX_ID);
+        HOST_CHECK_EQ(frame.dataLen, payloads[sizeIdx]);
+        HOST_CHECK(memcmp(frame.data, data, payloads[sizeIdx]) == 0);
+        HOST_CHECK_EQ(FLEXCAN_DRV_ConfigRxMb(0U, (uint8_t)mbCount, &info, RX_ID), STATUS_CAN_BUFF_OUT_OF_RANGE);
+    }
+}
+
+/*******************************************************************************
+ * Payload copy
+ ******************************************************************************/
+
+/* Payload size of a CAN FD frame carrying length bytes */
+static uint32_t FdPayloadSize(uint32_t length)
+{
+    static const uint32_t sizes[] = { 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U };
+    uint32_t i = 0U;
+
+    if (length <= 8U)
+    {
+        return length;
+    }
+    while (sizes[i] < length)
+    {
+        i++;
+    }
+    return sizes[i];
+}
+
+/* Every length up to 64 bytes is sent from word aligned and unaligned buffers:
+ * the payload and the padding reach the MB in bus order and are received
+ * intact */
+static void TestPayloadCopy(void)
+{
+    static uint32_t source[17];
+    uint8_t *bytes = (uint8_t *)source;
+    flexcan_user_config_t config;
+    flexcan_data_info_t info;
+    flexcan_msgbuff_t frame;
+    volatile uint32_t *txMb;
+    uint32_t length;
+    uint32_t offset;
+    uint32_t i;
+
+    FLEXCAN_DRV_GetDefaultConfig(&config);
+    config.fd_enable = true;
+    config.payload = FLEXCAN_PAYLOAD_SIZE_64;
+    config.max_num_mb = 7U;
+    config.flexcanMode = FLEXCAN_LOOPBACK_MODE;
+    HOST_CHECK_EQ(FLEXCAN_DRV_Init(0U, &s_state, &config), STATUS_SUCCESS);
+    FLEXCAN_DRV_SetRxMaskType(0U, FLEXCAN_RX_MASK_GLOBAL);
+    FLEXCAN_DRV_SetRxMbGlobalMask(0U, FLEXCAN_MSG_ID_STD, 0x7FFU);
+    txMb = HOST_Reg32((uint32_t)(uintptr_t)s_state.mbRegions[1]);
+
+    info = s_stdInfo;
+    info.fd_enable = true;
+    info.fd_padding = 0xA5U;
+    for (i = 0U; i < sizeof(source); i++)
+    {
+        bytes[i] = (uint8_t)(0x11U * i + 3U);
+    }
+
+    for (offset = 0U; offset < 4U; offset++)
+    {
+        for (length = 0U; length <= 64U; length++)
+        {
+            info.data_length = (uint8_t)length;
+            memset(&frame, 0, sizeof(frame));
+            HOST_CHECK_EQ(FLEXCAN_DRV_ConfigRxMb(0U, 0U, &info, RX_ID), STATUS_SUCCESS);
+            HOST_CHECK_EQ(FLEXCAN_DRV_Receive(0U, 0U, &frame), STATUS_SUCCESS);
+            HOST_CHECK_EQ(FLEXCAN_DRV_Send(0U, 1U, &info, RX_ID, &bytes[offset]), STATUS_SUCCESS);
+            HOST_RunUntilIdle();
+            HOST_CHECK_EQ(FLEXCAN_DRV_GetTransferStatus(0U, 0U), STATUS_SUCCESS);
+
+            /* The MB holds the payload then the padding, the first byte being
+             * the most significant one of the first data word */
+            for (i = 0U; i < FdPayloadSize(length); i++)
+            {
+                uint8_t mbByte = (uint8_t)(txMb[2U + (i >> 2U)] >> (24U - ((i & 3U) << 3U)));
+
+                HOST_CHECK_EQ(mbByte, (i < length) ? bytes[offset + i] : 0xA5U);
+            }
+            HOST_CHECK_EQ(frame.dataLen, FdPayloadSize(length));
+            HOST_CHECK(memcmp(frame.data, &bytes[offset], length) == 0);
+            for (i = length; i < FdPayloadSize(length); i++)
+            {
+                HOST_CHECK_EQ(frame.data[i], 0xA5U);
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+ * Transmit queue
+ ******************************************************************************/
+
+/* Sets up a queue served by MBs 8 and 9, the frames being sent on demand */
+static void StartTxQueue(void)
+{
+    InitCan(0U, &s_state);
+    HOST_CAN_SetAutoTransmit(false);
+    HOST_CHECK_EQ(FLEXCAN_DRV_ConfigTxQueue(0U, QUEUE_MB, 2U, s_queue, QUEUE_SIZE), STATUS_SUCCESS);
+}
+
+static void SendQueued(uint32_t id, uint8_t seq)
+{
+    uint8_t data[8] = { seq, 0U, 0U, 0U, 0U, 0U, 0U, (uint8_t)~seq };
+
+    HOST_CHECK_EQ(FLEXCAN_DRV_SendQueued(0U, &s_stdInfo, id, data), STATUS_SUCCESS);
+}
+
+static void TransmitNext(void)
+{
+    HOST_CHECK(HOST_CAN_TransmitNext(0U));
+    HOST_DispatchIrqs();
+}
+
+/* Checks the ID and the sequence number of a transmitted frame */
+static void CheckTx(uint32_t index, uint32_t id, uint8_t seq)
+{
+    host_can_frame_t frame;
+
+    HOST_CHECK(HOST_CAN_GetTx(0U, index, &frame));
+    HOST_CHECK_EQ(frame.id, id);
+    HOST_CHECK_EQ(frame.data[0], seq);
+    HOST_CHECK_EQ(frame.data[7], (uint8_t)~seq);
+}
+
+/* Streams the frames through the queue, which is kept full, and checks that
+ * they leave in the order they were queued */
+static void StreamTxQueue(const uint32_t *ids, uint32_t count)
+{
+    uint32_t sent = 0U;
+    uint32_t done;
+
+    for (done = 0U; done < count; done++)
+    {
+        while ((sent < count) && (FLEXCAN_DRV_GetTxQueuePending(0U) < QUEUE_SIZE))
+        {
+            SendQueued(ids[sent], (uint8_t)sent);
+            sent++;
+        }
+        TransmitNext();
+        CheckTx(done, ids[done], (uint8_t)done);
+    }
+    HOST_CHECK(!HOST_CAN_TransmitNext(0U));
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxQueueStatus(0U), STATUS_SUCCESS);
+}
+
+/* Frames beyond the pool wait in the queue and leave in order */
+static void TestTxQueueOrder(void)
+{
+    uint32_t i;
+
+    StartTxQueue();
+    HOST_CHECK((CAN0->MCR & CAN_MCR_LPRIOEN_MASK) != 0U);
+
+    for (i = 0U; i < 6U; i++)
+    {
+        SendQueued(0x200U + i, (uint8_t)i);
+    }
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxQueuePending(0U), 4U);
+    HOST_CHECK_EQ(HOST_CAN_PendingCount(0U), 2U);
+
+    HOST_RunUntilIdle();
+    HOST_CHECK_EQ(HOST_CAN_TxCount(0U), 0U);
+    for (i = 0U; i < 6U; i++)
+    {
+        TransmitNext();
+        CheckTx(i, 0x200U + i, (uint8_t)i);
+    }
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxQueuePending(0U), 0U);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxQueueStatus(0U), STATUS_SUCCESS);
+}
+
+/* Frames of the same ID leave in the order they were queued, not in MB
+ * order, over several PRIO wraps */
+static void TestTxQueueSameId(void)
+{
+    uint32_t ids[24];
+    uint32_t i;
+
+    for (i = 0U; i < 24U; i++)
+    {
+        ids[i] = 0x100U;
+    }
+
+    StartTxQueue();
+    StreamTxQueue(ids, 24U);
+}
+
+/* Frames of descending IDs leave in the order they were queued, not in ID
+ * order */
+static void TestTxQueueDescendingIds(void)
+{
+    uint32_t ids[24];
+    uint32_t i;
+
+    for (i = 0U; i < 24U; i++)
+    {
+        ids[i] = 0x2FFU - i;
+    }
+
+    StartTxQueue();
+    StreamTxQueue(ids, 24U);
+}
+
+/* A queued frame that fails to load into the MB that completed stays at the
+ * head of the queue, and is loaded into the next MB that completes */
+static void TestTxQueueFailedLoad(void)
+{
+    StartTxQueue();
+    SendQueued(0x300U, 1U);
+    SendQueued(0x100U, 2U);
+    SendQueued(0x200U, 3U);
+    SendQueued(0x050U, 4U);
+
+    /* MB 8 takes the third frame */
+    TransmitNext();
+    CheckTx(0U, 0x300U, 1U);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxQueuePending(0U), 1U);
+
+    /* MB 9 is now out of the range accepted by the driver */
+    CAN0->MCR = (CAN0->MCR & ~CAN_MCR_MAXMB_MASK) | (QUEUE_MB + 1U);
+
+    TransmitNext();
+    CheckTx(1U, 0x100U, 2U);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxQueueStatus(0U), STATUS_CAN_BUFF_OUT_OF_RANGE);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxQueuePending(0U), 1U);
+
+    TransmitNext();
+    CheckTx(2U, 0x200U, 3U);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxQueueStatus(0U), STATUS_SUCCESS);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxQueuePending(0U), 0U);
+
+    TransmitNext();
+    CheckTx(3U, 0x050U, 4U);
+    HOST_CHECK(!HOST_CAN_TransmitNext(0U));
+}
+
+/* A pool MB left idle with frames queued is reloaded by the abort and by the
+ * next frame queued */
+static void TestTxQueueKick(void)
+{
+    StartTxQueue();
+    SendQueued(0x100U, 1U);
+    SendQueued(0x101U, 2U);
+    SendQueued(0x102U, 3U);
+    SendQueued(0x103U, 4U);
+
+    /* The aborted MB takes the oldest queued frame at once */
+    HOST_CHECK_EQ(FLEXCAN_DRV_AbortTransfer(0U, QUEUE_MB), STATUS_SUCCESS);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxQueuePending(0U), 1U);
+    HOST_CHECK_EQ(HOST_CAN_PendingCount(0U), 2U);
+
+    /* A failed load leaves MB 9 idle, the next frame queued retries it */
+    CAN0->MCR = (CAN0->MCR & ~CAN_MCR_MAXMB_MASK) | (QUEUE_MB + 1U);
+    TransmitNext();
+    CheckTx(0U, 0x101U, 2U);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxQueueStatus(0U), STATUS_CAN_BUFF_OUT_OF_RANGE);
+    CAN0->MCR = (CAN0->MCR & ~CAN_MCR_MAXMB_MASK) | 16U;
+    SendQueued(0x104U, 5U);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxQueueStatus(0U), STATUS_SUCCESS);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxQueuePending(0U), 1U);
+
+    HOST_RunUntilIdle();
+    TransmitNext();
+    TransmitNext();
+    TransmitNext();
+    CheckTx(1U, 0x102U, 3U);
+    CheckTx(2U, 0x103U, 4U);
+    CheckTx(3U, 0x104U, 5U);
+    HOST_CHECK_EQ(HOST_CAN_TxCount(0U), 4U);
+}
+
+/* Releasing the queue drops its frames, frees the pool and clears LPRIOEN */
+static void TestTxQueueRelease(void)
+{
+    StartTxQueue();
+    SendQueued(0x100U, 1U);
+    SendQueued(0x101U, 2U);
+    SendQueued(0x102U, 3U);
+
+    FLEXCAN_DRV_ReleaseTxQueue(0U);
+    HOST_CHECK((CAN0->MCR & CAN_MCR_LPRIOEN_MASK) == 0U);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxQueuePending(0U), 0U);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTransferStatus(0U, QUEUE_MB), STATUS_SUCCESS);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTransferStatus(0U, QUEUE_MB + 1U), STATUS_SUCCESS);
+    HOST_CHECK_ASSERT((void)FLEXCAN_DRV_SendQueued(0U, &s_stdInfo, 0x100U, NULL));
+
+    HOST_CHECK_EQ(FLEXCAN_DRV_ConfigTxQueue(0U, QUEUE_MB, 2U, s_queue, QUEUE_SIZE), STATUS_SUCCESS);
+    HOST_CHECK((CAN0->MCR & CAN_MCR_LPRIOEN_MASK) != 0U);
+}
+
+/*******************************************************************************
+ * Rx FIFO
+ ******************************************************************************/
+
+/* Enables the Rx FIFO with 8 format A filters, all accepting RX_ID */
+static void StartRxFifo(void)
+{
+    static uint32_t ids[8];
+    flexcan_user_config_t config;
+    flexcan_id_table_t table;
+    uint32_t i;
+
+    FLEXCAN_DRV_GetDefaultConfig(&config);
+    config.flexcanMode = FLEXCAN_NORMAL_MODE;
+    config.is_rx_fifo_needed = true;
+    config.num_id_filters = FLEXCAN_RX_FIFO_ID_FILTERS_8;
+    HOST_CHECK_EQ(FLEXCAN_DRV_Init(0U, &s_state, &config), STATUS_SUCCESS);
+
+    for (i = 0U; i < 8U; i++)
+    {
+        ids[i] = RX_ID;
+    }
+    table.isRemoteFrame = false;
+    table.isExtendedFrame = false;
+    table.idFilter = ids;
+    FLEXCAN_DRV_SetRxMaskType(0U, FLEXCAN_RX_MASK_GLOBAL);
+    FLEXCAN_DRV_SetRxFifoGlobalMask(0U, FLEXCAN_MSG_ID_STD, 0x7FFU);
+    FLEXCAN_DRV_ConfigRxFifo(0U, FLEXCAN_RX_FIFO_ID_FORMAT_A, &table);
+}
+
+/* The frames waiting in the FIFO are received as one batch by one interrupt */
+static void TestRxFifoBatch(void)
+{
+    static flexcan_msgbuff_t frames[8];
+    host_stats_t stats;
+    uint32_t count = 0xFFFFFFFFU;
+    uint32_t i;
+
+    StartRxFifo();
+    HOST_CHECK_ASSERT((void)FLEXCAN_DRV_RxFifoBatch(0U, frames, FLEXCAN_RX_FIFO_BATCH_MAX + 1U, &count));
+    HOST_CHECK_ASSERT((void)FLEXCAN_DRV_RxFifoBatch(0U, frames, 0U, &count));
+
+    HOST_CpuDisableIrq();
+    HOST_CHECK_EQ(FLEXCAN_DRV_RxFifoBatch(0U, frames, 8U, &count), STATUS_SUCCESS);
+    for (i = 0U; i < 5U; i++)
+    {
+        InjectStd(0U, RX_ID, (uint8_t)i);
+    }
+    HOST_ResetStats();
+    HOST_CpuEnableIrq();
+
+    HOST_GetStats(&stats);
+    HOST_CHECK_EQ(stats.irqs, 1U);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTransferStatus(0U, FLEXCAN_MB_HANDLE_RXFIFO), STATUS_SUCCESS);
+    HOST_CHECK_EQ(count, 5U);
+    for (i = 0U; i < count; i++)
+    {
+        HOST_CHECK_EQ(frames[i].msgId, RX_ID);
+        HOST_CHECK_EQ(frames[i].data[0], i);
+    }
+    HOST_CHECK_EQ(HOST_CAN_FifoCount(0U), 0U);
+}
+
+/*******************************************************************************
+ * eDMA
+ ******************************************************************************/
+
+#define TX_DMA_CHANNEL  3U
+#define TX_DMA_MB       8U
+#define TX_DMA_MBS      4U
+#define TX_DMA_FRAMES   10U
+#define TX_DMA_ID       0x200U
+#define RX_DMA_CHANNEL  1U
+
+static edma_state_t s_dmaState;
+static edma_chn_state_t s_dmaChnState;
+static uint8_t s_txDmaStcd[FLEXCAN_TX_DMA_STCD_SIZE(TX_DMA_MBS)];
+static flexcan_tx_dma_frame_t s_txDmaFrames[TX_DMA_FRAMES];
+static uint32_t s_txDmaEvents;
+
+static void StartDma(uint8_t channel, dma_request_source_t source)
+{
+    edma_user_config_t userConfig;
+    edma_channel_config_t chnConfig;
+    edma_chn_state_t * const chnStates[] = { &s_dmaChnState };
+    const edma_channel_config_t * const chnConfigs[] = { &chnConfig };
+
+    memset(&userConfig, 0, sizeof(userConfig));
+    userConfig.chnArbitration = EDMA_ARBITRATION_FIXED_PRIORITY;
+    userConfig.notHaltOnError = false;
+    memset(&chnConfig, 0, sizeof(chnConfig));
+    chnConfig.channelPriority = EDMA_CHN_DEFAULT_PRIORITY;
+    chnConfig.virtChnConfig = channel;
+    chnConfig.source = source;
+    HOST_CHECK_EQ(EDMA_DRV_Init(&s_dmaState, &userConfig, chnStates, chnConfigs, 1U), STATUS_SUCCESS);
+}
+
+static void CountTxDmaEvent(uint8_t instance, flexcan_event_type_t eventType, uint32_t buffIdx,
+                            flexcan_state_t *flexcanState)
+{
+    (void)instance;
+    (void)flexcanState;
+    if (eventType == FLEXCAN_EVENT_TX_COMPLETE)
+    {
+        HOST_CHECK_EQ(buffIdx, TX_DMA_MB + 1U);
+        s_txDmaEvents++;
+    }
+}
+
+/* Sets up CAN0 with a pool of 4 MBs loaded by the eDMA and prepares the frames,
+ * all of the same ID: only their local priority keeps them in order */
+static void StartTxDma(void)
+{
+    uint8_t data[8] = { 0U };
+    uint32_t i;
+
+    InitCan(0U, &s_state);
+    StartDma(TX_DMA_CHANNEL, EDMA_REQ_DMAMUX_ALWAYS_ENABLED0);
+    HOST_CHECK_EQ(FLEXCAN_DRV_ConfigTxDma(0U, TX_DMA_CHANNEL, TX_DMA_MB, TX_DMA_MBS,
+                                          (edma_software_tcd_t *)s_txDmaStcd), STATUS_SUCCESS);
+    FLEXCAN_DRV_InstallEventCallback(0U, CountTxDmaEvent, NULL);
+    s_txDmaEvents = 0U;
+
+    for (i = 0U; i < TX_DMA_FRAMES; i++)
+    {
+        data[0] = (uint8_t)i;
+        data[7] = (uint8_t)~i;
+        FLEXCAN_DRV_PrepareTxDmaFrame(0U, &s_stdInfo, TX_DMA_ID, data, &s_txDmaFrames[i]);
+    }
+}
+
+/* Sends the chain and checks that all its frames left in order */
+static void CheckTxDmaChain(uint32_t firstTx)
+{
+    uint32_t i;
+
+    HOST_CHECK_EQ(FLEXCAN_DRV_SendDmaChain(0U, s_txDmaFrames, TX_DMA_FRAMES), STATUS_SUCCESS);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxDmaChainStatus(0U), STATUS_BUSY);
+    HOST_RunUntilIdle();
+
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxDmaChainStatus(0U), STATUS_SUCCESS);
+    HOST_CHECK_EQ(HOST_CAN_TxCount(0U), firstTx + TX_DMA_FRAMES);
+    for (i = 0U; i < TX_DMA_FRAMES; i++)
+    {
+        CheckTx(firstTx + i, TX_DMA_ID, (uint8_t)i);
+    }
+}
+
+/* Stalls the chain once the first frame of a batch is pending */
+static void StallTxDmaChain(void)
+{
+    uint32_t i;
+
+    HOST_DMA_SetAutoRun(false);
+    HOST_CAN_SetAutoTransmit(false);
+    HOST_CHECK_EQ(FLEXCAN_DRV_SendDmaChain(0U, s_txDmaFrames, TX_DMA_FRAMES), STATUS_SUCCESS);
+
+    /* ID and payload words, then the CODE/status word */
+    for (i = 0U; i < 4U; i++)
+    {
+        HOST_CHECK(HOST_DMA_ServiceNext(TX_DMA_CHANNEL));
+    }
+    HOST_CHECK_EQ(HOST_CAN_PendingCount(0U), 1U);
+}
+
+static void CheckTxDmaPoolIdle(void)
+{
+    uint32_t i;
+
+    HOST_CHECK_EQ(HOST_CAN_PendingCount(0U), 0U);
+    HOST_CHECK_EQ(DMA->ERQ & (1UL << TX_DMA_CHANNEL), 0U);
+    for (i = TX_DMA_MB; i < (TX_DMA_MB + TX_DMA_MBS); i++)
+    {
+        HOST_CHECK_EQ(FLEXCAN_DRV_GetTransferStatus(0U, (uint8_t)i), STATUS_SUCCESS);
+    }
+}
+
+/* A chain longer than the pool leaves in order, with one event at its end */
+static void TestTxDmaChain(void)
+{
+    StartTxDma();
+
+    CheckTxDmaChain(0U);
+    HOST_CHECK_EQ(s_txDmaEvents, 1U);
+    HOST_CHECK_EQ(HOST_DMA_MinorLoops(TX_DMA_CHANNEL), TX_DMA_FRAMES * 4U);
+
+    (void)EDMA_DRV_Deinit();
+}
+
+/* An eDMA error ends the chain: the pool is released and a new chain can be sent */
+static void TestTxDmaError(void)
+{
+    StartTxDma();
+    StallTxDmaChain();
+
+    HOST_DMA_InjectError(TX_DMA_CHANNEL, DMA_ES_SBE_MASK);
+    HOST_CHECK(HOST_DMA_ServiceNext(TX_DMA_CHANNEL));
+    HOST_DispatchIrqs();
+
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxDmaChainStatus(0U), STATUS_ERROR);
+    HOST_CHECK_EQ(s_txDmaEvents, 0U);
+    CheckTxDmaPoolIdle();
+
+    HOST_DMA_SetAutoRun(true);
+    HOST_CAN_SetAutoTransmit(true);
+    CheckTxDmaChain(0U);
+    HOST_CHECK_EQ(s_txDmaEvents, 1U);
+
+    (void)EDMA_DRV_Deinit();
+}
+
+/* Aborting a MB of the pool ends the whole chain */
+static void TestTxDmaAbort(void)
+{
+    StartTxDma();
+    StallTxDmaChain();
+
+    HOST_CHECK_EQ(FLEXCAN_DRV_AbortTransfer(0U, TX_DMA_MB + 1U), STATUS_SUCCESS);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxDmaChainStatus(0U), STATUS_SUCCESS);
+    CheckTxDmaPoolIdle();
+    HOST_CHECK_EQ(FLEXCAN_DRV_AbortTransfer(0U, TX_DMA_MB + 1U), STATUS_CAN_NO_TRANSFER_IN_PROGRESS);
+
+    HOST_DMA_SetAutoRun(true);
+    HOST_CAN_SetAutoTransmit(true);
+    HOST_RunUntilIdle();
+    HOST_CHECK_EQ(HOST_CAN_TxCount(0U), 0U);
+    CheckTxDmaChain(0U);
+    HOST_CHECK_EQ(s_txDmaEvents, 1U);
+
+    (void)EDMA_DRV_Deinit();
+}
+
+/*******************************************************************************
+ * Timestamps and latency
+ ******************************************************************************/
+
+#define TICKS_PER_BIT   10U
+#define LATENCY_MBS     10U
+
+static uint64_t s_now;
+static flexcan_latency_hist_t s_latencyHist[LATENCY_MBS];
+
+static uint64_t GetTestTime(void *param)
+{
+    (void)param;
+    return s_now;
+}
+
+/* The frames of a DMA batch are dated from the next one, even when the batch
+ * spans more than a wrap of the free running timer */
+static void TestRxFifoDmaBatch(void)
+{
+    static flexcan_msgbuff_t frames[4];
+    static const flexcan_time_base_t timeBase = { GetTestTime, NULL, TICKS_PER_BIT };
+    static uint32_t ids[8];
+    flexcan_user_config_t config;
+    flexcan_id_table_t table;
+    uint64_t expected[4];
+    uint32_t count = 0U;
+    uint32_t i;
+
+    StartDma(RX_DMA_CHANNEL, EDMA_REQ_FLEXCAN0);
+    FLEXCAN_DRV_GetDefaultConfig(&config);
+    config.flexcanMode = FLEXCAN_NORMAL_MODE;
+    config.is_rx_fifo_needed = true;
+    config.num_id_filters = FLEXCAN_RX_FIFO_ID_FILTERS_8;
+    config.transfer_type = FLEXCAN_RXFIFO_USING_DMA;
+    config.rxFifoDMAChannel = RX_DMA_CHANNEL;
+    HOST_CHECK_EQ(FLEXCAN_DRV_Init(0U, &s_state, &config), STATUS_SUCCESS);
+    for (i = 0U; i < 8U; i++)
+    {
+        ids[i] = RX_ID;
+    }
+    table.isRemoteFrame = false;
+    table.isExtendedFrame = false;
+    table.idFilter = ids;
+    FLEXCAN_DRV_SetRxMaskType(0U, FLEXCAN_RX_MASK_GLOBAL);
+    FLEXCAN_DRV_SetRxFifoGlobalMask(0U, FLEXCAN_MSG_ID_STD, 0x7FFU);
+    FLEXCAN_DRV_ConfigRxFifo(0U, FLEXCAN_RX_FIFO_ID_FORMAT_A, &table);
+    FLEXCAN_DRV_InstallTimeBase(0U, &timeBase);
+
+    s_now = 1000000U;
+    HOST_CHECK_EQ(FLEXCAN_DRV_RxFifoBatch(0U, frames, 4U, &count), STATUS_SUCCESS);
+    for (i = 0U; i < 4U; i++)
+    {
+        /* 30000 idle bits, then a standard frame of 8 bytes */
+        CAN0->TIMER = (CAN0->TIMER + 30000U) & CAN_TIMER_TIMER_MASK;
+        s_now += 30000U * TICKS_PER_BIT;
+        InjectStd(0U, RX_ID, (uint8_t)i);
+        s_now += (47U + 64U) * TICKS_PER_BIT;
+        expected[i] = s_now;
+        HOST_RunUntilIdle();
+    }
+
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTransferStatus(0U, FLEXCAN_MB_HANDLE_RXFIFO), STATUS_SUCCESS);
+    HOST_CHECK_EQ(count, 4U);
+    for (i = 0U; i < 4U; i++)
+    {
+        HOST_CHECK_EQ(frames[i].msgId, RX_ID);
+        HOST_CHECK_EQ(frames[i].data[0], i);
+        HOST_CHECK_EQ(frames[i].data[7], (uint8_t)~i);
+        HOST_CHECK_EQ(frames[i].timestamp, expected[i]);
+    }
+    HOST_CHECK_EQ(HOST_DMA_MinorLoops(RX_DMA_CHANNEL), 4U);
+
+    (void)EDMA_DRV_Deinit();
+}
+
+/* Checks the number of frames of each bin of a latency histogram */
+static void CheckLatencyHistogram(uint8_t mb_idx, const uint32_t *bins, uint64_t maxLatency)
+{
+    flexcan_latency_hist_t hist;
+    uint32_t count = 0U;
+    uint32_t bin;
+
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetLatencyHistogram(0U, mb_idx, &hist), STATUS_SUCCESS);
+    for (bin = 0U; bin < FLEXCAN_LATENCY_BINS; bin++)
+    {
+        HOST_CHECK_EQ(hist.bins[bin], bins[bin]);
+        count += bins[bin];
+    }
+    HOST_CHECK_EQ(hist.count, count);
+    HOST_CHECK_EQ(hist.maxLatency, maxLatency);
+}
+
+static void StartLatencyHistograms(void)
+{
+    static const flexcan_time_base_t timeBase = { GetTestTime, NULL, TICKS_PER_BIT };
+
+    s_now = 0U;
+    FLEXCAN_DRV_InstallEventCallback(0U, NULL, NULL);
+    FLEXCAN_DRV_InstallTimeBase(0U, &timeBase);
+    FLEXCAN_DRV_ConfigLatencyHistograms(0U, s_latencyHist, LATENCY_MBS);
+}
+
+/* The queue-to-wire latency of a frame sent from a MB goes to the bin of its
+ * most significant bit, the longest ones to the last bin */
+static void TestLatencyHistogramTx(void)
+{
+    static const uint64_t latencies[] = {
+        0U, 1U, 2U, 3U, 4U, 7U, 8U, 1023U, 1024U, 0x7FFFFFU, 0x800000U, 0x10000000000U
+    };
+    uint32_t bins[FLEXCAN_LATENCY_BINS] = { 0U };
+    flexcan_latency_hist_t hist;
+    uint8_t data[8] = { 0U };
+    uint32_t i;
+
+    InitCan(0U, &s_state);
+    HOST_CAN_SetAutoTransmit(false);
+    StartLatencyHistograms();
+    HOST_CHECK_EQ(FLEXCAN_DRV_ConfigTxMb(0U, QUEUE_MB, &s_stdInfo, 0x300U), STATUS_SUCCESS);
+
+    for (i = 0U; i < (sizeof(latencies) / sizeof(latencies[0])); i++)
+    {
+        s_now += 1000U;
+        HOST_CHECK_EQ(FLEXCAN_DRV_Send(0U, QUEUE_MB, &s_stdInfo, 0x300U, data), STATUS_SUCCESS);
+        s_now += latencies[i];
+        TransmitNext();
+        HOST_CHECK_EQ(FLEXCAN_DRV_GetMsgBuffTimestamp(0U, QUEUE_MB), s_now);
+    }
+
+    bins[0] = 2U;
+    bins[1] = 2U;
+    bins[2] = 2U;
+    bins[3] = 1U;
+    bins[9] = 1U;
+    bins[10] = 1U;
+    bins[22] = 1U;
+    bins[23] = 2U;
+    CheckLatencyHistogram(QUEUE_MB, bins, 0x10000000000U);
+
+    /* Only the first MBs have a histogram */
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetLatencyHistogram(0U, LATENCY_MBS, &hist), STATUS_ERROR);
+    FLEXCAN_DRV_ConfigLatencyHistograms(0U, NULL, 0U);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetLatencyHistogram(0U, QUEUE_MB, &hist), STATUS_ERROR);
+}
+
+/* The wire-to-callback latency of a received frame is the age of the frame
+ * in the free running timer when the interrupt is serviced */
+static void TestLatencyHistogramRx(void)
+{
+    static const uint32_t ageBits[] = { 0U, 1U, 100U, 7000U };
+    uint32_t bins[FLEXCAN_LATENCY_BINS] = { 0U };
+    flexcan_msgbuff_t frame;
+    uint32_t i;
+
+    InitCan(0U, &s_state);
+    StartLatencyHistograms();
+    FLEXCAN_DRV_SetRxMaskType(0U, FLEXCAN_RX_MASK_GLOBAL);
+    FLEXCAN_DRV_SetRxMbGlobalMask(0U, FLEXCAN_MSG_ID_STD, 0x7FFU);
+    HOST_CHECK_EQ(FLEXCAN_DRV_ConfigRxMb(0U, RX_MB, &s_stdInfo, RX_ID), STATUS_SUCCESS);
+
+    for (i = 0U; i < (sizeof(ageBits) / sizeof(ageBits[0])); i++)
+    {
+        HOST_CHECK_EQ(FLEXCAN_DRV_Receive(0U, RX_MB, &frame), STATUS_SUCCESS);
+        s_now += 100000U;
+
+        /* The frame waits for the interrupt while the timer runs */
+        HOST_CpuDisableIrq();
+        InjectStd(0U, RX_ID, (uint8_t)i);
+        CAN0->TIMER = (CAN0->TIMER + ageBits[i]) & CAN_TIMER_TIMER_MASK;
+        s_now += (uint64_t)ageBits[i] * TICKS_PER_BIT;
+        HOST_CpuEnableIrq();
+
+        HOST_CHECK_EQ(FLEXCAN_DRV_GetTransferStatus(0U, RX_MB), STATUS_SUCCESS);
+        HOST_CHECK_EQ(frame.data[0], i);
+        HOST_CHECK_EQ(frame.timestamp, s_now - ((uint64_t)ageBits[i] * TICKS_PER_BIT));
+    }
+
+    /* 0, 10, 1000 and 70000 ticks */
+    bins[0] = 1U;
+    bins[3] = 1U;
+    bins[9] = 1U;
+    bins[16] = 1U;
+    CheckLatencyHistogram(RX_MB, bins, 70000U);
+}
+
+/* The latency of a frame loaded from the transmit queue starts when it was
+ * queued, not when a pool MB took it */
+static void TestLatencyHistogramTxQueue(void)
+{
+    uint32_t bins[FLEXCAN_LATENCY_BINS] = { 0U };
+    uint32_t i;
+
+    StartTxQueue();
+    StartLatencyHistograms();
+
+    /* Two frames into the pool, two into the queue */
+    s_now = 100U;
+    SendQueued(0x200U, 0U);
+    SendQueued(0x201U, 1U);
+    s_now = 200U;
+    SendQueued(0x202U, 2U);
+    SendQueued(0x203U, 3U);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetTxQueuePending(0U), 2U);
+    HOST_CHECK_EQ(s_queue[0].queuedTime, 200U);
+    HOST_CHECK_EQ(s_queue[1].queuedTime, 200U);
+
+    /* MB 8 then MB 9 send their frame and take one from the queue */
+    s_now = 1100U;
+    TransmitNext();
+    s_now = 1150U;
+    TransmitNext();
+    s_now = 2300U;
+    TransmitNext();
+    s_now = 2400U;
+    TransmitNext();
+    for (i = 0U; i < 4U; i++)
+    {
+        CheckTx(i, 0x200U + i, (uint8_t)i);
+    }
+
+    /* 1000 and 2100 ticks on MB 8, 1050 and 2200 ticks on MB 9 */
+    bins[9] = 1U;
+    bins[11] = 1U;
+    CheckLatencyHistogram(QUEUE_MB, bins, 2100U);
+    bins[9] = 0U;
+    bins[10] = 1U;
+    CheckLatencyHistogram(QUEUE_MB + 1U, bins, 2200U);
+}
+
+/*******************************************************************************
+ * Rx FIFO filter compiler
+ ******************************************************************************/
+
+#define MAX_RANGES  160U
+
+static flexcan_id_range_t s_ranges[MAX_RANGES];
+static flexcan_rx_filter_program_t s_program;
+static uint32_t s_seed;
+
+static uint32_t Random(void)
+{
+    s_seed = (s_seed * 1664525U) + 1013904223U;
+    return s_seed >> 3U;
+}
+
+static bool InRanges(uint32_t count, bool isExtended, uint32_t id)
+{
+    uint32_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        if (((s_ranges[i].idType == FLEXCAN_MSG_ID_EXT) == isExtended) &&
+            (id >= s_ranges[i].firstId) && (id <= s_ranges[i].lastId))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Format A element of a data frame, as compared by the Rx FIFO */
+static uint32_t RxFifoKey(bool isExtended, uint32_t id)
+{
+    return isExtended ? (0x40000000U | (id << 1U)) : (id << 19U);
+}
+
+/* Hardware stage: the elements past the individual masks use the global mask,
+ * which the program sets to compare every bit */
+static bool IsHwAccepted(bool isExtended, uint32_t id)
+{
+    uint32_t key = RxFifoKey(isExtended, id);
+    uint32_t count = ((uint32_t)s_program.num_id_filters + 1U) * 8U;
+    uint32_t mask;
+    uint32_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        mask = (i < CAN_RXIMR_COUNT) ? s_program.idMask[i] : 0xFFFFFFFEU;
+        if ((key & mask) == (s_program.idFilter[i] & mask))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool IsAccepted(bool isExtended, uint32_t id)
+{
+    flexcan_msgbuff_t frame;
+
+    frame.cs = isExtended ? CAN_CS_IDE_MASK : 0U;
+    frame.msgId = id;
+
+    return IsHwAccepted(isExtended, id) && FLEXCAN_DRV_IsRxFifoIdAccepted(&s_program, &frame);
+}
+
+/* Returns the number of IDs on which the program and the ranges disagree: every
+ * standard ID, the bounds of the extended ranges and random extended IDs */
+static uint32_t CountFilterErrors(uint32_t count)
+{
+    uint32_t errors = 0U;
+    uint32_t id;
+    uint32_t i;
+
+    for (id = 0U; id <= 0x7FFU; id++)
+    {
+        errors += (IsAccepted(false, id) != InRanges(count, false, id)) ? 1U : 0U;
+    }
+    for (i = 0U; i < count; i++)
+    {
+        if (s_ranges[i].idType == FLEXCAN_MSG_ID_EXT)
+        {
+            id = s_ranges[i].firstId - 1U;
+            errors += ((id <= 0x1FFFFFFFU) && (IsAccepted(true, id) != InRanges(count, true, id))) ? 1U : 0U;
+            id = s_ranges[i].firstId;
+            errors += (IsAccepted(true, id) != InRanges(count, true, id)) ? 1U : 0U;
+            id = s_ranges[i].lastId;
+            errors += (IsAccepted(true, id) != InRanges(count, true, id)) ? 1U : 0U;
+            id = s_ranges[i].lastId + 1U;
+            errors += ((id <= 0x1FFFFFFFU) && (IsAccepted(true, id) != InRanges(count, true, id))) ? 1U : 0U;
+        }
+    }
+    for (i = 0U; i < 1000U; i++)
+    {
+        id = Random() & 0x1FFFFFFFU;
+        errors += (IsAccepted(true, id) != InRanges(count, true, id)) ? 1U : 0U;
+    }
+
+    return errors;
+}
+
+/* The masked elements use the individual masks, and the table fits the FIFO */
+static void CheckProgramLayout(void)
+{
+    uint32_t i;
+
+    HOST_CHECK(s_program.numElements <= FLEXCAN_RX_FIFO_MAX_FILTER_ELEMENTS);
+    HOST_CHECK_EQ((s_program.numElements + 7U) / 8U, (uint32_t)s_program.num_id_filters + 1U);
+    for (i = CAN_RXIMR_COUNT; i < s_program.numElements; i++)
+    {
+        bool isExtended = ((s_program.idFilter[i] & 0x40000000U) != 0U);
+
+        HOST_CHECK_EQ(s_program.idMask[i], isExtended ? 0xFFFFFFFEU : 0xFFF80000U);
+    }
+}
+
+/* Random sets of standard and extended ranges and single IDs */
+static void TestRxFilterRandomSets(void)
+{
+    uint32_t compiled = 0U;
+    uint32_t set;
+    uint32_t count;
+    uint32_t i;
+
+    s_seed = 1U;
+    for (set = 0U; set < 200U; set++)
+    {
+        count = 1U + (Random() % 32U);
+        for (i = 0U; i < count; i++)
+        {
+            bool isExtended = ((Random() % 4U) == 0U);
+            uint32_t idMax = isExtended ? 0x1FFFFFFFU : 0x7FFU;
+            uint32_t length = ((Random() % 2U) == 0U) ? 0U : (Random() % 32U);
+
+            s_ranges[i].idType = isExtended ? FLEXCAN_MSG_ID_EXT : FLEXCAN_MSG_ID_STD;
+            s_ranges[i].firstId = Random() & idMax;
+            s_ranges[i].lastId = ((idMax - s_ranges[i].firstId) < length) ? idMax : (s_ranges[i].firstId + length);
+        }
+
+        if (FLEXCAN_DRV_CompileRxFifoFilters(s_ranges, count, &s_program) == STATUS_SUCCESS)
+        {
+            compiled++;
+            CheckProgramLayout();
+            HOST_CHECK_EQ(CountFilterErrors(count), 0U);
+        }
+    }
+
+    /* A few sets may hold too many scattered IDs for the hash set */
+    HOST_CHECK(compiled >= 190U);
+}
+
+/* More single IDs than filter elements: the last ones are checked in software */
+static void TestRxFilterManySingles(void)
+{
+    uint32_t i;
+
+    s_seed = 7U;
+    for (i = 0U; i < 130U; i++)
+    {
+        s_ranges[i].idType = FLEXCAN_MSG_ID_STD;
+        s_ranges[i].firstId = i * 13U;
+        s_ranges[i].lastId = i * 13U;
+    }
+    HOST_CHECK_EQ(FLEXCAN_DRV_CompileRxFifoFilters(s_ranges, 130U, &s_program), STATUS_SUCCESS);
+    HOST_CHECK(s_program.numSwIds != 0U);
+    CheckProgramLayout();
+    HOST_CHECK_EQ(CountFilterErrors(130U), 0U);
+}
+
+/* More masked ranges than individual masks: the narrowest are checked in
+ * software */
+static void TestRxFilterManyMasks(void)
+{
+    uint32_t i;
+
+    s_seed = 9U;
+    for (i = 0U; i < 40U; i++)
+    {
+        /* Pairs of IDs that do not merge with each other */
+        s_ranges[i].idType = FLEXCAN_MSG_ID_STD;
+        s_ranges[i].firstId = i * 50U;
+        s_ranges[i].lastId = (i * 50U) + ((i < 10U) ? 1U : 3U);
+    }
+    HOST_CHECK_EQ(FLEXCAN_DRV_CompileRxFifoFilters(s_ranges, 40U, &s_program), STATUS_SUCCESS);
+    HOST_CHECK(s_program.numSwIds != 0U);
+    CheckProgramLayout();
+    HOST_CHECK_EQ(CountFilterErrors(40U), 0U);
+}
+
+/* A compiled program programmed in the FIFO accepts the same frames as the
+ * compiler's own view of the hardware stage */
+static void TestRxFilterFifo(void)
+{
+    flexcan_user_config_t config;
+    uint32_t received = 0U;
+    uint32_t expected = 0U;
+    uint32_t id;
+
+    s_seed = 3U;
+    for (id = 0U; id < 30U; id++)
+    {
+        s_ranges[id].idType = FLEXCAN_MSG_ID_STD;
+        s_ranges[id].firstId = Random() & 0x7FFU;
+        s_ranges[id].lastId = s_ranges[id].firstId + (((id % 3U) == 0U) ? 0U : (Random() % 9U));
+        if (s_ranges[id].lastId > 0x7FFU)
+        {
+            s_ranges[id].lastId = 0x7FFU;
+        }
+    }
+    HOST_CHECK_EQ(FLEXCAN_DRV_CompileRxFifoFilters(s_ranges, 30U, &s_program), STATUS_SUCCESS);
+
+    FLEXCAN_DRV_GetDefaultConfig(&config);
+    config.flexcanMode = FLEXCAN_NORMAL_MODE;
+    config.is_rx_fifo_needed = true;
+    config.num_id_filters = s_program.num_id_filters;
+    config.max_num_mb = 32U;
+    HOST_CHECK_EQ(FLEXCAN_DRV_Init(0U, &s_state, &config), STATUS_SUCCESS);
+    HOST_CHECK_EQ(FLEXCAN_DRV_ConfigRxFifoFilters(0U, &s_program), STATUS_SUCCESS);
+
+    for (id = 0U; id <= 0x7FFU; id++)
+    {
+        InjectStd(0U, id, 0U);
+        if (HOST_CAN_FifoCount(0U) != 0U)
+        {
+            received++;
+            /* Pop the frame */
+            CAN0->IFLAG1 = CAN_IFLAG1_BUF5I_MASK;
+        }
+        expected += IsHwAccepted(false, id) ? 1U : 0U;
+        HOST_CHECK(IsHwAccepted(false, id) || !InRanges(30U, false, id));
+    }
+    HOST_CHECK_EQ(received, expected);
+}
+
+/*******************************************************************************
+ * Bit timing
+ ******************************************************************************/
+
+/* Register ranges of a bit timing, from the CTRL1, CBT and FDCBT field widths */
+typedef struct {
+    uint32_t maxPreDivider;
+    uint32_t minQuanta;
+    uint32_t maxQuanta;
+    uint32_t minPropSeg;
+    uint32_t maxPropSeg;
+    uint32_t maxPhaseSeg1;
+    uint32_t maxPhaseSeg2;
+    uint32_t maxRJumpwidth;
+    uint32_t propSegOffset;
+} bit_limits_t;
+
+#define NO_TIMING   0xFFFFFFFFU
+
+static const bit_limits_t s_nominalLimits = {
+    1UL << CAN_CTRL1_PRESDIV_WIDTH, 8U, 25U, 1U, 1UL << CAN_CTRL1_PROPSEG_WIDTH,
+    1UL << CAN_CTRL1_PSEG1_WIDTH, 1UL << CAN_CTRL1_PSEG2_WIDTH, 1UL << CAN_CTRL1_RJW_WIDTH, 1U
+};
+static const bit_limits_t s_extendedLimits = {
+    1UL << CAN_CBT_EPRESDIV_WIDTH, 8U, 129U, 1U, 1UL << CAN_CBT_EPROPSEG_WIDTH,
+    1UL << CAN_CBT_EPSEG1_WIDTH, 1UL << CAN_CBT_EPSEG2_WIDTH, 1UL << CAN_CBT_ERJW_WIDTH, 1U
+};
+static const bit_limits_t s_dataLimits = {
+    1UL << CAN_FDCBT_FPRESDIV_WIDTH, 5U, 48U, 0U, (1UL << CAN_FDCBT_FPROPSEG_WIDTH) - 1UL,
+    1UL << CAN_FDCBT_FPSEG1_WIDTH, 1UL << CAN_FDCBT_FPSEG2_WIDTH, 1UL << CAN_FDCBT_FRJW_WIDTH, 0U
+};
+
+/* Distance from the requested sample point, in thousandths of a percent */
+static uint32_t SamplePointError(uint32_t tseg1, uint32_t quanta, uint32_t samplePoint)
+{
+    uint32_t achieved = ((tseg1 + 1U) * 100000U) / quanta;
+
+    return (achieved > (samplePoint * 100U)) ? (achieved - (samplePoint * 100U)) :
+                                               ((samplePoint * 100U) - achieved);
+}
+
+/* Smallest sample point error of any legal split of the bit for a prescaler */
+static uint32_t BestErrorAt(const bit_limits_t *limits, uint32_t clocks, uint32_t preDivider, uint32_t samplePoint)
+{
+    uint32_t best = NO_TIMING;
+    uint32_t quanta, tseg1, phaseSeg2, error;
+
+    if ((preDivider > limits->maxPreDivider) || ((clocks % preDivider) != 0U))
+    {
+        return NO_TIMING;
+    }
+    quanta = clocks / preDivider;
+    if ((quanta < limits->minQuanta) || (quanta > limits->maxQuanta))
+    {
+        return NO_TIMING;
+    }
+    for (phaseSeg2 = 2U; phaseSeg2 <= limits->maxPhaseSeg2; phaseSeg2++)
+    {
+        if ((phaseSeg2 + 1U) >= quanta)
+        {
+            break;
+        }
+        tseg1 = quanta - 1U - phaseSeg2;
+        if ((tseg1 >= (limits->minPropSeg + 1U)) && (tseg1 <= (limits->maxPropSeg + limits->maxPhaseSeg1)))
+        {
+            error = SamplePointError(tseg1, quanta, samplePoint);
+            best = (error < best) ? error : best;
+        }
+    }
+    return best;
+}
+
+static uint32_t BestError(const bit_limits_t *limits, uint32_t clocks, uint32_t samplePoint)
+{
+    uint32_t best = NO_TIMING;
+    uint32_t preDivider, error;
+
+    for (preDivider = 1U; preDivider <= limits->maxPreDivider; preDivider++)
+    {
+        error = BestErrorAt(limits, clocks, preDivider, samplePoint);
+        best = (error < best) ? error : best;
+    }
+    return best;
+}
+
+/* Checks the register ranges and the bitrate of a phase; returns its sample point error */
+static uint32_t CheckPhase(const bit_limits_t *limits, const flexcan_time_segment_t *seg,
+                           uint32_t clocks, uint32_t samplePoint)
+{
+    uint32_t preDivider = seg->preDivider + 1U;
+    uint32_t propSeg = seg->propSeg + limits->propSegOffset;
+    uint32_t phaseSeg1 = seg->phaseSeg1 + 1U;
+    uint32_t phaseSeg2 = seg->phaseSeg2 + 1U;
+    uint32_t rJumpwidth = seg->rJumpwidth + 1U;
+    uint32_t quanta = 1U + propSeg + phaseSeg1 + phaseSeg2;
+
+    HOST_CHECK(preDivider <= limits->maxPreDivider);
+    HOST_CHECK((propSeg >= limits->minPropSeg) && (propSeg <= limits->maxPropSeg));
+    HOST_CHECK(phaseSeg1 <= limits->maxPhaseSeg1);
+    HOST_CHECK((phaseSeg2 >= 2U) && (phaseSeg2 <= limits->maxPhaseSeg2));
+    HOST_CHECK((rJumpwidth <= limits->maxRJumpwidth) && (rJumpwidth <= phaseSeg1) && (rJumpwidth <= phaseSeg2));
+    HOST_CHECK((quanta >= limits->minQuanta) && (quanta <= limits->maxQuanta));
+    HOST_CHECK_EQ(preDivider * quanta, clocks);
+
+    return SamplePointError(propSeg + phaseSeg1, quanta, samplePoint);
+}
+
+/* Every result of the solver is legal, exact and has the smallest sample point
+ * error; a shared prescaler is used whenever it is as good */
+static void TestBitTimingExhaustive(void)
+{
+    static const uint32_t clocks[] = { 8000000U, 16000000U, 20000000U, 24000000U, 32000000U,
+                                       40000000U, 48000000U, 60000000U, 64000000U, 80000000U };
+    static const uint32_t nominalRates[] = { 50000U, 83333U, 100000U, 125000U, 250000U, 500000U, 800000U, 1000000U };
+    static const uint32_t dataRates[] = { 0U, 1000000U, 2000000U, 2500000U, 4000000U, 5000000U, 8000000U, 10000000U };
+    static const uint32_t samplePoints[] = { 600U, 700U, 750U, 800U, 825U, 850U, 875U, 900U, 950U };
+    flexcan_bit_timing_t timing;
+    const bit_limits_t *nominalLimits;
+    uint32_t c, n, d, s, preDivider, offset;
+    uint32_t nominalClocks, dataClocks, nominalBest, dataBest, nominalError, dataError;
+    uint32_t solved = 0U;
+    bool shared;
+    status_t status;
+
+    for (c = 0U; c < (sizeof(clocks) / sizeof(clocks[0])); c++)
+    {
+        for (n = 0U; n < (sizeof(nominalRates) / sizeof(nominalRates[0])); n++)
+        {
+            for (d = 0U; d < (sizeof(dataRates) / sizeof(dataRates[0])); d++)
+            {
+                for (s = 0U; s < (sizeof(samplePoints) / sizeof(samplePoints[0])); s++)
+                {
+                    nominalLimits = (dataRates[d] != 0U) ? &s_extendedLimits : &s_nominalLimits;
+                    nominalClocks = clocks[c] / nominalRates[n];
+                    dataClocks = (dataRates[d] != 0U) ? (clocks[c] / dataRates[d]) : 0U;
+                    nominalBest = ((clocks[c] % nominalRates[n]) == 0U) ?
+                                  BestError(nominalLimits, nominalClocks, samplePoints[s]) : NO_TIMING;
+                    dataBest = 0U;
+                    if (dataRates[d] != 0U)
+                    {
+                        dataBest = ((clocks[c] % dataRates[d]) == 0U) ?
+                                   BestError(&s_dataLimits, dataClocks, samplePoints[s]) : NO_TIMING;
+                    }
+
+                    status = FLEXCAN_DRV_ComputeBitTiming(clocks[c], nominalRates[n], dataRates[d],
+                                                          samplePoints[s], &timing);
+                    if ((nominalBest == NO_TIMING) || (dataBest == NO_TIMING))
+                    {
+                        HOST_CHECK_EQ(status, STATUS_ERROR);
+                        continue;
+                    }
+                    HOST_CHECK_EQ(status, STATUS_SUCCESS);
+                    if (status != STATUS_SUCCESS)
+                    {
+                        continue;
+                    }
+                    solved++;
+
+                    nominalError = CheckPhase(nominalLimits, &timing.bitrate, nominalClocks, samplePoints[s]);
+                    if (dataRates[d] == 0U)
+                    {
+                        HOST_CHECK_EQ(nominalError, nominalBest);
+                        HOST_CHECK(!timing.tdcEnable);
+                        continue;
+                    }
+                    dataError = CheckPhase(&s_dataLimits, &timing.bitrate_cbt, dataClocks, samplePoints[s]);
+                    HOST_CHECK_EQ(nominalError + dataError, nominalBest + dataBest);
+
+                    /* Equal prescalers in both phases whenever they reach the optimum */
+                    shared = false;
+                    for (preDivider = 1U; (preDivider <= s_dataLimits.maxPreDivider) && !shared; preDivider++)
+                    {
+                        shared = ((BestErrorAt(nominalLimits, nominalClocks, preDivider, samplePoints[s]) == nominalBest) &&
+                                  (BestErrorAt(&s_dataLimits, dataClocks, preDivider, samplePoints[s]) == dataBest));
+                    }
+                    HOST_CHECK(!shared || (timing.bitrate.preDivider == timing.bitrate_cbt.preDivider));
+
+                    /* The secondary sample point is the data sample point, saturated */
+                    HOST_CHECK_EQ(timing.tdcEnable, dataRates[d] > 1000000U);
+                    if (timing.tdcEnable)
+                    {
+                        offset = (timing.bitrate_cbt.preDivider + 1U) *
+                                 (timing.bitrate_cbt.propSeg + timing.bitrate_cbt.phaseSeg1 + 2U);
+                        offset = (offset > ((1UL << CAN_FDCTRL_TDCOFF_WIDTH) - 1UL)) ?
+                                 ((1UL << CAN_FDCTRL_TDCOFF_WIDTH) - 1UL) : offset;
+                        HOST_CHECK_EQ(timing.tdcOffset, offset);
+                    }
+                }
+            }
+        }
+    }
+
+    /* Most of the combinations are reachable */
+    HOST_CHECK(solved > 2000U);
+}
+
+static bool SameSegments(const flexcan_time_segment_t *a, const flexcan_time_segment_t *b)
+{
+    return (a->preDivider == b->preDivider) && (a->propSeg == b->propSeg) &&
+           (a->phaseSeg1 == b->phaseSeg1) && (a->phaseSeg2 == b->phaseSeg2) &&
+           (a->rJumpwidth == b->rJumpwidth);
+}
+
+/* ConfigBitTiming programs what ComputeBitTiming returns for the PE clock */
+static void TestBitTimingConfig(void)
+{
+    flexcan_user_config_t config;
+    flexcan_bit_timing_t expected;
+    flexcan_bit_timing_t timing;
+    flexcan_time_segment_t seg;
+
+    HOST_SetClockFreq(80000000U);
+    FLEXCAN_DRV_GetDefaultConfig(&config);
+    config.fd_enable = true;
+    config.payload = FLEXCAN_PAYLOAD_SIZE_64;
+    config.max_num_mb = 7U;
+    HOST_CHECK_EQ(FLEXCAN_DRV_Init(0U, &s_state, &config), STATUS_SUCCESS);
+
+    HOST_CHECK_EQ(FLEXCAN_DRV_ComputeBitTiming(80000000U, 500000U, 2000000U, 800U, &expected), STATUS_SUCCESS);
+    HOST_CHECK_EQ(FLEXCAN_DRV_ConfigBitTiming(0U, 500000U, 2000000U, 800U, &timing), STATUS_SUCCESS);
+    HOST_CHECK(SameSegments(&timing.bitrate, &expected.bitrate));
+    HOST_CHECK(SameSegments(&timing.bitrate_cbt, &expected.bitrate_cbt));
+    HOST_CHECK_EQ(timing.tdcEnable, expected.tdcEnable);
+    HOST_CHECK_EQ(timing.tdcOffset, expected.tdcOffset);
+
+    /* The arbitration phase of FD frames is in CBT */
+    seg.preDivider = (CAN0->CBT & CAN_CBT_EPRESDIV_MASK) >> CAN_CBT_EPRESDIV_SHIFT;
+    seg.propSeg = (CAN0->CBT & CAN_CBT_EPROPSEG_MASK) >> CAN_CBT_EPROPSEG_SHIFT;
+    seg.phaseSeg1 = (CAN0->CBT & CAN_CBT_EPSEG1_MASK) >> CAN_CBT_EPSEG1_SHIFT;
+    seg.phaseSeg2 = (CAN0->CBT & CAN_CBT_EPSEG2_MASK) >> CAN_CBT_EPSEG2_SHIFT;
+    seg.rJumpwidth = (CAN0->CBT & CAN_CBT_ERJW_MASK) >> CAN_CBT_ERJW_SHIFT;
+    HOST_CHECK(SameSegments(&seg, &expected.bitrate));
+    FLEXCAN_DRV_GetBitrateFD(0U, &seg);
+    HOST_CHECK(SameSegments(&seg, &expected.bitrate_cbt));
+    HOST_CHECK((CAN0->FDCTRL & CAN_FDCTRL_TDCEN_MASK) != 0U);
+    HOST_CHECK_EQ((CAN0->FDCTRL & CAN_FDCTRL_TDCOFF_MASK) >> CAN_FDCTRL_TDCOFF_SHIFT, expected.tdcOffset);
+
+    /* No legal timing for a bitrate the clock does not divide */
+    HOST_CHECK_EQ(FLEXCAN_DRV_ConfigBitTiming(0U, 500000U, 3000000U, 800U, &timing), STATUS_ERROR);
+    HOST_SetClockFreq(0U);
+    HOST_CHECK_EQ(FLEXCAN_DRV_ConfigBitTiming(0U, 500000U, 2000000U, 800U, &timing), STATUS_ERROR);
+}
+
+/*******************************************************************************
+ * Error manager
+ ******************************************************************************/
+
+#define FAULT_LOG_SIZE  8U
+
+typedef struct {
+    flexcan_fault_state_t previousState;
+    flexcan_fault_state_t newState;
+    uint32_t timeMs;
+} fault_transition_t;
+
+static fault_transition_t s_faultLog[FAULT_LOG_SIZE];
+static uint32_t s_faultCount;
+
+static void LogFaultTransition(uint8_t instance, flexcan_fault_state_t previousState,
+                               flexcan_fault_state_t newState, void *param)
+{
+    HOST_CHECK_EQ(instance, 0U);
+    HOST_CHECK(param == &s_faultCount);
+    if (s_faultCount < FAULT_LOG_SIZE)
+    {
+        s_faultLog[s_faultCount].previousState = previousState;
+        s_faultLog[s_faultCount].newState = newState;
+        s_faultLog[s_faultCount].timeMs = HOST_GetMs();
+    }
+    s_faultCount++;
+}
+
+static void CheckFaultTransition(uint32_t index, flexcan_fault_state_t previousState,
+                                 flexcan_fault_state_t newState)
+{
+    HOST_CHECK(index < s_faultCount);
+    HOST_CHECK_EQ(s_faultLog[index].previousState, previousState);
+    HOST_CHECK_EQ(s_faultLog[index].newState, newState);
+}
+
+static void StartErrorManager(bool autoRecovery, uint32_t delayMs, uint32_t maxDelayMs)
+{
+    flexcan_error_config_t config;
+
+    InitCan(0U, &s_state);
+    config.autoRecovery = autoRecovery;
+    config.recoveryDelayMs = delayMs;
+    config.maxRecoveryDelayMs = maxDelayMs;
+    config.callback = LogFaultTransition;
+    config.callbackParam = &s_faultCount;
+    s_faultCount = 0U;
+    FLEXCAN_DRV_ConfigErrorManager(0U, &config);
+}
+
+/* Goes bus-off and returns the time the error manager takes to enable the
+ * recovery, calling it every ms; the node then recovers at once */
+static uint32_t BusOffRecoveryDelay(void)
+{
+    uint32_t elapsed = 0U;
+
+    HOST_CAN_SetErrorCounters(0U, 255U, 0U, true);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetFaultState(0U), FLEXCAN_FAULT_BUS_OFF);
+    while (!HOST_CAN_RecoverBusOff(0U) && (elapsed < 1000U))
+    {
+        HOST_AdvanceMs(1U);
+        elapsed++;
+        FLEXCAN_DRV_ErrorMainFunction(0U);
+    }
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetFaultState(0U), FLEXCAN_FAULT_ERROR_ACTIVE);
+
+    return elapsed;
+}
+
+/* The error kinds are counted once per interrupt which finds them, the error
+ * counters and their peaks follow ECR, and the node goes error-passive, then
+ * bus-off, and back to error-active once the application lets it recover */
+static void TestErrorManagerStates(void)
+{
+    flexcan_error_counters_t counters;
+
+    HOST_AdvanceMs(1000U);
+    StartErrorManager(false, 10U, 100U);
+    HOST_CHECK((CAN0->CTRL1 & CAN_CTRL1_BOFFREC_MASK) != 0U);
+    HOST_CHECK((CAN0->CTRL1 & (CAN_CTRL1_ERRMSK_MASK | CAN_CTRL1_BOFFMSK_MASK)) ==
+               (CAN_CTRL1_ERRMSK_MASK | CAN_CTRL1_BOFFMSK_MASK));
+    HOST_CHECK((CAN0->CTRL2 & CAN_CTRL2_BOFFDONEMSK_MASK) != 0U);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetFaultState(0U), FLEXCAN_FAULT_ERROR_ACTIVE);
+
+    /* Error kinds */
+    HOST_CAN_SetErrorFlags(0U, CAN_ESR1_ERRINT_MASK | CAN_ESR1_BIT0ERR_MASK | CAN_ESR1_STFERR_MASK);
+    HOST_CAN_SetErrorFlags(0U, CAN_ESR1_ERRINT_MASK | CAN_ESR1_CRCERR_MASK | CAN_ESR1_FRMERR_MASK |
+                               CAN_ESR1_ACKERR_MASK);
+    HOST_CAN_SetErrorFlags(0U, CAN_ESR1_ERRINT_MASK | CAN_ESR1_BIT1ERR_MASK);
+    FLEXCAN_DRV_ErrorMainFunction(0U);
+    FLEXCAN_DRV_GetErrorCounters(0U, &counters);
+    HOST_CHECK_EQ(counters.bitErrors, 2U);
+    HOST_CHECK_EQ(counters.stuffErrors, 1U);
+    HOST_CHECK_EQ(counters.crcErrors, 1U);
+    HOST_CHECK_EQ(counters.formErrors, 1U);
+    HOST_CHECK_EQ(counters.ackErrors, 1U);
+    HOST_CHECK_EQ(CAN0->ESR1 & CAN_ESR1_ERRINT_MASK, 0U);
+
+    /* Error counters, read without interrupt */
+    HOST_CAN_SetErrorCounters(0U, 100U, 20U, false);
+    FLEXCAN_DRV_ErrorMainFunction(0U);
+    HOST_CAN_SetErrorCounters(0U, 130U, 10U, false);
+    FLEXCAN_DRV_ErrorMainFunction(0U);
+    FLEXCAN_DRV_GetErrorCounters(0U, &counters);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetFaultState(0U), FLEXCAN_FAULT_ERROR_PASSIVE);
+    HOST_CHECK_EQ(counters.txErrorCount, 130U);
+    HOST_CHECK_EQ(counters.rxErrorCount, 10U);
+    HOST_CHECK_EQ(counters.txErrorPeak, 130U);
+    HOST_CHECK_EQ(counters.rxErrorPeak, 20U);
+    HOST_CHECK_EQ(counters.errorPassiveCount, 1U);
+    HOST_CHECK_EQ(s_faultCount, 1U);
+    CheckFaultTransition(0U, FLEXCAN_FAULT_ERROR_ACTIVE, FLEXCAN_FAULT_ERROR_PASSIVE);
+
+    /* Bus-off is reported by its interrupt; the node is held there */
+    HOST_CHECK_EQ(FLEXCAN_DRV_RecoverBusOff(0U), STATUS_ERROR);
+    HOST_CAN_SetErrorCounters(0U, 255U, 10U, true);
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetFaultState(0U), FLEXCAN_FAULT_BUS_OFF);
+    HOST_CHECK_EQ(s_faultCount, 2U);
+    CheckFaultTransition(1U, FLEXCAN_FAULT_ERROR_PASSIVE, FLEXCAN_FAULT_BUS_OFF);
+    HOST_AdvanceMs(500U);
+    FLEXCAN_DRV_ErrorMainFunction(0U);
+    HOST_CHECK(!HOST_CAN_RecoverBusOff(0U));
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetFaultState(0U), FLEXCAN_FAULT_BUS_OFF);
+
+    /* The recovery of the application; bus-off done is reported by its
+     * interrupt and the node is held in bus-off again for the next one */
+    HOST_CHECK_EQ(FLEXCAN_DRV_RecoverBusOff(0U), STATUS_SUCCESS);
+    HOST_AdvanceMs(3U);
+    HOST_CHECK(HOST_CAN_RecoverBusOff(0U));
+    HOST_CHECK_EQ(FLEXCAN_DRV_GetFaultState(0U), FLEXCAN_FAULT_ERROR_ACTIVE);
+    HOST_CHECK((CAN0->CTRL1 & CAN_CTRL1_BOFFREC_MASK) != 0U);
+    HOST_CHECK_EQ(s_faultCount, 3U);
+    CheckFaultTransition(2U, FLEXCAN_FAULT_BUS_OFF, FLEXCAN_FAULT_ERROR_ACTIVE);
+    FLEXCAN_DRV_GetErrorCounters(0U, &counters);
+    HOST_CHECK_EQ(counters.busOffCount, 1U);
+    HOST_CHECK_EQ(counters.lastBusOffTimeMs, 503U);
+    HOST_CHECK_EQ(counters.busOffTimeMs, 503U);
+    HOST_CHECK_EQ(counters.txErrorCount, 0U);
+    HOST_CHECK_EQ(counters.txErrorPeak, 255U);
+    HOST_CHECK_EQ(counters.errorPassiveCount, 1U);
+
+    /* Error-passive and back, both without interrupt */
+    HOST_CAN_SetErrorCounters(0U, 0U, 128U, false);
+    FLEXCAN_DRV_ErrorMainFunction(0U);
+    HOST_CAN_SetErrorCounters(0U, 0U, 90U, false);
+    FLEXCAN_DRV_ErrorMainFunction(0U);
+    HOST_CHECK_EQ(s_faultCount, 5U);
+    CheckFaultTransition(3U, FLEXCAN_FAULT_ERROR_ACTIVE, FLEXCAN_FAULT_ERROR_PASSIVE);
+    CheckFaultTransition(4U, FLEXCAN_FAULT_ERROR_PASSIVE, FLEXCAN_FAULT_ERROR_ACTIVE);
+    FLEXCAN_DRV_GetErrorCounters(0U, &counters);
+    HOST_CHECK_EQ(counters.errorPassiveCount, 2U);
+    HOST_CHECK_EQ(counters.rxErrorPeak, 128U);
+
+    (void)FLEXCAN_DRV_Deinit(0U);
+}
+
+/* The automatic recovery waits for the delay, doubled at each bus-off up to
+ * its bound, and back to the first delay once the node stayed error-active
+ * for the bound */
+static void TestErrorManagerBackoff(void)
+{
+    static const uint32_t delays[] = { 10U, 20U, 40U, 80U, 80U };
+    flexcan_error_counters_t counters;
+    uint32_t total = 0U;
+    uint32_t i;
+
+    StartErrorManager(true, 10U, 80U);
+
+    for (i = 0U; i < (sizeof(delays) / sizeof(delays[0])); i++)
+    {
+        HOST_CHECK_EQ(BusOffRecoveryDelay(), delays[i]);
+        total += delays[i];
+        /* Error-active for less than the bound */
+        HOST_AdvanceMs(79U);
+        FLEXCAN_DRV_ErrorMainFunction(0U);
+    }
+
+    /* Error-active for the bound */
+    HOST_AdvanceMs(1U);
+    FLEXCAN_DRV_ErrorMainFunction(0U);
+    HOST_CHECK_EQ(BusOffRecoveryDelay(), 10U);
+    total += 10U;
+
+    FLEXCAN_DRV_GetErrorCounters(0U, &counters);
+    HOST_CHECK_EQ(counters.busOffCount, 6U);
+    HOST_CHECK_EQ(counters.busOffTimeMs, total);
+    HOST_CHECK_EQ(counters.lastBusOffTimeMs, 10U);
+    HOST_CHECK_EQ(counters.errorPassiveCount, 0U);
+    HOST_CHECK_EQ(s_faultCount, 12U);
+    CheckFaultTransition(0U, FLEXCAN_FAULT_ERROR_ACTIVE, FLEXCAN_FAULT_BUS_OFF);
+    CheckFaultTransition(1U, FLEXCAN_FAULT_BUS_OFF, FLEXCAN_FAULT_ERROR_ACTIVE);
+    HOST_CHECK_EQ(s_faultLog[1].timeMs - s_faultLog[0].timeMs, 10U);
+    HOST_CHECK_EQ(s_faultLog[3].timeMs - s_faultLog[2].timeMs, 20U);
+
+    (void)FLEXCAN_DRV_Deinit(0U);
+}
+
+/*******************************************************************************
+ * Pretended Networking wake rules
+ ******************************************************************************/
+
+#define PN_RULE_SETS       80U
+#define PN_MAX_RULES       4U
+#define PN_EXT_FRAMES      4096U
+#define PN_FRAMES_PER_ID   4U
+#define PN_ID_FLAGS        (CAN_FLT_ID1_FLT_IDE_MASK | CAN_FLT_ID1_FLT_RTR_MASK)
+
+typedef struct {
+    uint32_t mismatches;    /* FLEXCAN_DRV_IsPNWakeRuleMatched disagrees with the rules */
+    uint32_t missed;        /* The hardware filter drops a frame matching the rules */
+    uint32_t inexact;       /* The filter is reported exact but accepts other frames */
+    uint32_t matched;       /* Frames matching the rules */
+    uint32_t rejected;      /* Frames the hardware filter drops */
+} pn_errors_t;
+
+/* Pretended Networking filter registers of CAN0 */
+typedef struct {
+    uint32_t ctrl1;
+    uint32_t id1;
+    uint32_t id2;
+    uint32_t dlc;
+    uint32_t pl1[2];
+    uint32_t pl2[2];
+} pn_filter_regs_t;
+
+static flexcan_pn_wake_rule_t s_pnRules[PN_MAX_RULES];
+static uint8_t s_pnValues[8];
+static pn_filter_regs_t s_pnRegs;
+
+/* Byte of a payload register pair, byte 0 in the top byte of the low word */
+static uint8_t PNPayloadByte(uint32_t lo, uint32_t hi, uint32_t byteIdx)
+{
+    uint32_t word = (byteIdx < 4U) ? lo : hi;
+
+    return (uint8_t)(word >> (24U - (8U * (byteIdx & 3U))));
+}
+
+/* Reads the filter registers once they are programmed */
+static void ReadPNFilter(void)
+{
+    s_pnRegs.ctrl1 = CAN0->CTRL1_PN;
+    s_pnRegs.id1 = CAN0->FLT_ID1;
+    s_pnRegs.id2 = CAN0->FLT_ID2_IDMASK;
+    s_pnRegs.dlc = CAN0->FLT_DLC;
+    s_pnRegs.pl1[0] = CAN0->PL1_LO;
+    s_pnRegs.pl1[1] = CAN0->PL1_HI;
+    s_pnRegs.pl2[0] = CAN0->PL2_PLMASK_LO;
+    s_pnRegs.pl2[1] = CAN0->PL2_PLMASK_HI;
+}
+
+/* Hardware stage: the Pretended Networking filter as programmed in the CAN0
+ * registers read by ReadPNFilter, the ID filter then the DLC and payload
+ * filter if it is combined */
+static bool IsPNHwMatched(const flexcan_msgbuff_t *frame)
+{
+    bool isExtended = ((frame->cs & CAN_CS_IDE_MASK) != 0U);
+    bool isRemote = ((frame->cs & CAN_CS_RTR_MASK) != 0U);
+    uint32_t key = (isExtended ? frame->msgId : (frame->msgId << CAN_ID_STD_SHIFT)) |
+                   CAN_FLT_ID1_FLT_IDE(isExtended ? 1UL : 0UL) | CAN_FLT_ID1_FLT_RTR(isRemote ? 1UL : 0UL);
+    uint32_t filter1 = s_pnRegs.id1;
+    uint32_t filter2 = s_pnRegs.id2;
+    uint32_t filterComb = (s_pnRegs.ctrl1 & CAN_CTRL1_PN_FCS_MASK) >> CAN_CTRL1_PN_FCS_SHIFT;
+    uint32_t idFilterType = (s_pnRegs.ctrl1 & CAN_CTRL1_PN_IDFS_MASK) >> CAN_CTRL1_PN_IDFS_SHIFT;
+    uint32_t dlcLow = (s_pnRegs.dlc & CAN_FLT_DLC_FLT_DLC_LO_MASK) >> CAN_FLT_DLC_FLT_DLC_LO_SHIFT;
+    uint32_t dlcHigh = (s_pnRegs.dlc & CAN_FLT_DLC_FLT_DLC_HI_MASK) >> CAN_FLT_DLC_FLT_DLC_HI_SHIFT;
+    bool matched;
+    uint32_t byteIdx;
+
+    if (idFilterType == (uint32_t)FLEXCAN_FILTER_MATCH_EXACT)
+    {
+        /* The mask holds the ID bits and the IDE and RTR bits compared */
+        matched = (((key ^ filter1) & filter2) == 0U);
+    }
+    else
+    {
+        /* The IDE and RTR bits of a range are those of the first filter */
+        matched = (((key ^ filter1) & PN_ID_FLAGS) == 0U) &&
+                  ((key & CAN_FLT_ID1_FLT_ID1_MASK) >= (filter1 & CAN_FLT_ID1_FLT_ID1_MASK)) &&
+                  ((key & CAN_FLT_ID1_FLT_ID1_MASK) <= (filter2 & CAN_FLT_ID1_FLT_ID1_MASK));
+    }
+
+    if (matched && (filterComb == (uint32_t)FLEXCAN_FILTER_ID_PAYLOAD))
+    {
+        matched = (frame->dataLen >= dlcLow) && (frame->dataLen <= dlcHigh);
+        for (byteIdx = 0U; (byteIdx < 8U) && matched; byteIdx++)
+        {
+            matched = (((frame->data[byteIdx] ^ PNPayloadByte(s_pnRegs.pl1[0], s_pnRegs.pl1[1], byteIdx)) &
+                        PNPayloadByte(s_pnRegs.pl2[0], s_pnRegs.pl2[1], byteIdx)) == 0U);
+        }
+    }
+
+    return matched;
+}
+
+/* Brute force: the frame against each rule, field by field */
+static bool IsPNRuleMatched(uint32_t ruleCount, const flexcan_msgbuff_t *frame)
+{
+    const flexcan_pn_wake_rule_t *rule;
+    bool matched;
+    uint32_t byteIdx;
+    uint32_t i;
+
+    for (i = 0U; i < ruleCount; i++)
+    {
+        rule = &s_pnRules[i];
+        matched = ((frame->cs & CAN_CS_RTR_MASK) == 0U) &&
+                  (((frame->cs & CAN_CS_IDE_MASK) != 0U) == rule->extendedId) &&
+                  (frame->msgId >= rule->idLow) && (frame->msgId <= rule->idHigh) &&
+                  (frame->dataLen >= rule->dlcLow) && (frame->dataLen <= rule->dlcHigh);
+        for (byteIdx = 0U; byteIdx < 8U; byteIdx++)
+        {
+            if ((frame->data[byteIdx] & rule->payloadMask[byteIdx]) !=
+                (rule->payloadValue[byteIdx] & rule->payloadMask[byteIdx]))
+            {
+                matched = false;
+            }
+        }
+        if (matched)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Rules on IDs close to each other, each with a DLC range and, for most, a
+ * payload condition on its lowest payload size, mostly on shared values. In
+ * half of the sets, all the rules share one payload condition, so that only
+ * their IDs and DLC ranges differ. */
+static void RandomPNRules(uint32_t ruleCount, bool isExtended)
+{
+    static const uint8_t masks[4] = { 0xFFU, 0xF0U, 0x01U, 0x00U };
+    uint32_t idSpace = isExtended ? CAN_ID_EXT_MASK | CAN_ID_STD_MASK : 0x7FFU;
+    uint32_t base = Random() & idSpace;
+    uint32_t spans[4] = { 0U, 3U, 40U, isExtended ? 0x3FFFFU : 0x1FFU };
+    uint8_t sharedMasks[8];
+    uint32_t sharedLow = Random() % 9U;
+    bool shared = ((Random() % 2U) == 0U);
+    flexcan_pn_wake_rule_t *rule;
+    bool checksPayload;
+    uint32_t byteIdx;
+    uint32_t i;
+
+    for (byteIdx = 0U; byteIdx < 8U; byteIdx++)
+    {
+        s_pnValues[byteIdx] = (uint8_t)Random();
+        sharedMasks[byteIdx] = (byteIdx < sharedLow) ? masks[Random() % 4U] : 0U;
+    }
+
+    for (i = 0U; i < ruleCount; i++)
+    {
+        rule = &s_pnRules[i];
+        rule->extendedId = isExtended;
+        rule->idLow = (base + (Random() % 100U)) & idSpace;
+        rule->idHigh = rule->idLow + (Random() % (spans[Random() % 4U] + 1U));
+        if (rule->idHigh > idSpace)
+        {
+            rule->idHigh = idSpace;
+        }
+        rule->dlcLow = (uint8_t)(Random() % 9U);
+        if (shared)
+        {
+            rule->dlcLow = (uint8_t)(sharedLow + (Random() % (9U - sharedLow)));
+        }
+        rule->dlcHigh = (uint8_t)(rule->dlcLow + (Random() % (9U - rule->dlcLow)));
+        checksPayload = ((Random() % 4U) != 0U);
+        for (byteIdx = 0U; byteIdx < 8U; byteIdx++)
+        {
+            rule->payloadMask[byteIdx] = 0U;
+            rule->payloadValue[byteIdx] = (uint8_t)Random();
+            if (shared)
+            {
+                rule->payloadMask[byteIdx] = sharedMasks[byteIdx];
+                rule->payloadValue[byteIdx] = s_pnValues[byteIdx];
+            }
+            else if (checksPayload && (byteIdx < rule->dlcLow))
+            {
+                rule->payloadMask[byteIdx] = masks[Random() % 4U];
+                if ((Random() % 4U) != 0U)
+                {
+                    rule->payloadValue[byteIdx] = s_pnValues[byteIdx];
+                }
+            }
+        }
+    }
+}
+
+/* Frame near the rules: the shared payload values with a byte changed at
+ * times, sometimes of the other ID type or remote */
+static void RandomPNFrame(bool isExtended, uint32_t id, flexcan_msgbuff_t *frame)
+{
+    uint32_t byteIdx;
+
+    frame->cs = 0U;
+    if ((Random() % 16U) == 0U)
+    {
+        isExtended = !isExtended;
+    }
+    if (isExtended)
+    {
+        frame->cs |= CAN_CS_IDE_MASK;
+    }
+    if ((Random() % 16U) == 0U)
+    {
+        frame->cs |= CAN_CS_RTR_MASK;
+    }
+    frame->msgId = id & (isExtended ? (CAN_ID_EXT_MASK | CAN_ID_STD_MASK) : 0x7FFU);
+    frame->dataLen = (uint8_t)(Random() % 9U);
+    for (byteIdx = 0U; byteIdx < 8U; byteIdx++)
+    {
+        frame->data[byteIdx] = s_pnValues[byteIdx];
+    }
+    if ((Random() % 2U) == 0U)
+    {
+        frame->data[Random() % 8U] ^= (uint8_t)(1U << (Random() % 8U));
+    }
+}
+
+static void CheckPNFrame(uint32_t ruleCount, bool exact, const flexcan_msgbuff_t *frame, pn_errors_t *errors)
+{
+    bool ruleMatched = IsPNRuleMatched(ruleCount, frame);
+    bool hwMatched = IsPNHwMatched(frame);
+
+    errors->mismatches += (FLEXCAN_DRV_IsPNWakeRuleMatched(s_pnRules, ruleCount, frame) != ruleMatched) ? 1U : 0U;
+    errors->missed += (ruleMatched && !hwMatched) ? 1U : 0U;
+    errors->inexact += (exact && hwMatched && !ruleMatched) ? 1U : 0U;
+    errors->matched += ruleMatched ? 1U : 0U;
+    errors->rejected += hwMatched ? 0U : 1U;
+}
+
+/* Compiles and programs the rules, then checks the filter and the software
+ * check on every standard ID, or on the bounds of the extended rules and IDs
+ * around them */
+static void CheckPNRuleSet(uint32_t ruleCount, bool isExtended, pn_errors_t *errors)
+{
+    flexcan_pn_config_t pnConfig;
+    flexcan_msgbuff_t frame;
+    uint32_t lowest = s_pnRules[0].idLow;
+    uint32_t dlcLow = 8U;
+    uint32_t dlcHigh = 0U;
+    bool exact;
+    uint32_t id;
+    uint32_t i;
+    uint32_t j;
+
+    HOST_CHECK_EQ(FLEXCAN_DRV_CompilePNWakeRules(s_pnRules, ruleCount, 0U, &pnConfig, &exact), STATUS_SUCCESS);
+    FLEXCAN_DRV_ConfigPN(0U, true, &pnConfig);
+    ReadPNFilter();
+    HOST_CHECK((pnConfig.idFilterType == FLEXCAN_FILTER_MATCH_EXACT) ||
+               (pnConfig.idFilterType == FLEXCAN_FILTER_MATCH_RANGE));
+    HOST_CHECK_EQ(pnConfig.payloadFilterType, FLEXCAN_FILTER_MATCH_EXACT);
+
+    /* The DLC filter spans the payload sizes of all the rules */
+    for (i = 0U; i < ruleCount; i++)
+    {
+        dlcLow = (s_pnRules[i].dlcLow < dlcLow) ? s_pnRules[i].dlcLow : dlcLow;
+        dlcHigh = (s_pnRules[i].dlcHigh > dlcHigh) ? s_pnRules[i].dlcHigh : dlcHigh;
+        lowest = (s_pnRules[i].idLow < lowest) ? s_pnRules[i].idLow : lowest;
+    }
+    if (pnConfig.filterComb == FLEXCAN_FILTER_ID_PAYLOAD)
+    {
+        HOST_CHECK_EQ((s_pnRegs.dlc & CAN_FLT_DLC_FLT_DLC_LO_MASK) >> CAN_FLT_DLC_FLT_DLC_LO_SHIFT, dlcLow);
+        HOST_CHECK_EQ((s_pnRegs.dlc & CAN_FLT_DLC_FLT_DLC_HI_MASK) >> CAN_FLT_DLC_FLT_DLC_HI_SHIFT, dlcHigh);
+    }
+    else
+    {
+        HOST_CHECK_EQ(pnConfig.filterComb, FLEXCAN_FILTER_ID);
+    }
+
+    if (!isExtended)
+    {
+        for (id = 0U; id <= 0x7FFU; id++)
+        {
+            for (j = 0U; j < PN_FRAMES_PER_ID; j++)
+            {
+                RandomPNFrame(false, id, &frame);
+                CheckPNFrame(ruleCount, exact, &frame, errors);
+            }
+        }
+    }
+    else
+    {
+        for (j = 0U; j < PN_EXT_FRAMES; j++)
+        {
+            i = Random() % ruleCount;
+            switch (j % 4U)
+            {
+                case 0U:
+                    id = s_pnRules[i].idLow - 1U + (Random() % 3U);
+                    break;
+                case 1U:
+                    id = s_pnRules[i].idHigh - 1U + (Random() % 3U);
+                    break;
+                case 2U:
+                    id = lowest + (Random() % 0x400U);
+                    break;
+                default:
+                    id = Random();
+                    break;
+            }
+            RandomPNFrame(true, id, &frame);
+            CheckPNFrame(ruleCount, exact, &frame, errors);
+        }
+    }
+}
+
+/* The compiled filter never drops a frame matching the rules and, when
+ * reported exact, accepts no other; FLEXCAN_DRV_IsPNWakeRuleMatched agrees
+ * with the rules */
+static void TestPNWakeRulesRandom(void)
+{
+    pn_errors_t errors;
+    uint32_t set;
+
+    InitCan(0U, &s_state);
+    memset(&errors, 0, sizeof(errors));
+    s_seed = 0x2545F491U;
+
+    for (set = 0U; set < PN_RULE_SETS; set++)
+    {
+        RandomPNRules(1U + (set % PN_MAX_RULES), (set % 3U) == 2U);
+        CheckPNRuleSet(1U + (set % PN_MAX_RULES), (set % 3U) == 2U, &errors);
+    }
+
+    HOST_CHECK_EQ(errors.mismatches, 0U);
+    HOST_CHECK_EQ(errors.missed, 0U);
+    HOST_CHECK_EQ(errors.inexact, 0U);
+    /* Both outcomes are exercised */
+    HOST_CHECK(errors.matched > 1000U);
+    HOST_CHECK(errors.rejected > 1000U);
+
+    (void)FLEXCAN_DRV_Deinit(0U);
+}
+
+/* The DLC filter takes the payload sizes of all the rules, the payload filter
+ * the bytes they compare to the same value; rules mixing ID types or comparing
+ * bytes past their lowest payload size are refused */
+static void TestPNWakeRulesDlc(void)
+{
+    flexcan_pn_config_t pnConfig;
+    flexcan_msgbuff_t frame;
+    bool exact;
+
+    InitCan(0U, &s_state);
+    memset(s_pnRules, 0, sizeof(s_pnRules));
+    s_pnRules[0].idLow = 0x100U;
+    s_pnRules[0].idHigh = 0x100U;
+    s_pnRules[0].dlcLow = 2U;
+    s_pnRules[0].dlcHigh = 4U;
+    s_pnRules[0].payloadMask[0] = 0xFFU;
+    s_pnRules[0].payloadValue[0] = 0x5AU;
+    s_pnRules[0].payloadMask[1] = 0x0FU;
+    s_pnRules[0].payloadValue[1] = 0x03U;
+    s_pnRules[1] = s_pnRules[0];
+    s_pnRules[1].idLow = 0x102U;
+    s_pnRules[1].idHigh = 0x102U;
+    s_pnRules[1].dlcLow = 3U;
+    s_pnRules[1].dlcHigh = 6U;
+    s_pnRules[1].payloadValue[1] = 0x04U;
+
+    HOST_CHECK_EQ(FLEXCAN_DRV_CompilePNWakeRules(s_pnRules, 2U, 0U, &pnConfig, &exact), STATUS_SUCCESS);
+    FLEXCAN_DRV_ConfigPN(0U, true, &pnConfig);
+    ReadPNFilter();
+    HOST_CHECK(!exact);
+    HOST_CHECK_EQ(pnConfig.filterComb, FLEXCAN_FILTER_ID_PAYLOAD);
+    HOST_CHECK_EQ(pnConfig.idFilterType, FLEXCAN_FILTER_MATCH_EXACT);
+    HOST_CHECK_EQ(CAN0->FLT_DLC, CAN_FLT_DLC_FLT_DLC_LO(2U) | CAN_FLT_DLC_FLT_DLC_HI(6U));
+    HOST_CHECK_EQ(CAN0->PL1_LO, 0x5A000000U);
+    HOST_CHECK_EQ(CAN0->PL2_PLMASK_LO, 0xFF080000U);
+    HOST_CHECK_EQ(CAN0->PL2_PLMASK_HI, 0U);
+
+    memset(&frame, 0, sizeof(frame));
+    frame.msgId = 0x102U;
+    frame.data[0] = 0x5AU;
+    frame.data[1] = 0x04U;
+    frame.dataLen = 2U;
+    HOST_CHECK(IsPNHwMatched(&frame));
+    HOST_CHECK(!FLEXCAN_DRV_IsPNWakeRuleMatched(s_pnRules, 2U, &frame));
+    frame.dataLen = 6U;
+    HOST_CHECK(IsPNHwMatched(&frame));
+    HOST_CHECK(FLEXCAN_DRV_IsPNWakeRuleMatched(s_pnRules, 2U, &frame));
+    frame.dataLen = 7U;
+    HOST_CHECK(!IsPNHwMatched(&frame));
+    frame.dataLen = 1U;
+    HOST_CHECK(!IsPNHwMatched(&frame));
+
+    /* One rule: the filter is exact */
+    HOST_CHECK_EQ(FLEXCAN_DRV_CompilePNWakeRules(s_pnRules, 1U, 0U, &pnConfig, &exact), STATUS_SUCCESS);
+    FLEXCAN_DRV_ConfigPN(0U, true, &pnConfig);
+    HOST_CHECK(exact);
+    HOST_CHECK_EQ(CAN0->FLT_DLC, CAN_FLT_DLC_FLT_DLC_LO(2U) | CAN_FLT_DLC_FLT_DLC_HI(4U));
+    HOST_CHECK_EQ(CAN0->PL2_PLMASK_LO, 0xFF0F0000U);
+
+    s_pnRules[1].extendedId = true;
+    HOST_CHECK_EQ(FLEXCAN_DRV_CompilePNWakeRules(s_pnRules, 2U, 0U, &pnConfig, &exact), STATUS_ERROR);
+    s_pnRules[1].extendedId = false;
+    s_pnRules[1].payloadMask[3] = 0x01U;
+    HOST_CHECK_EQ(FLEXCAN_DRV_CompilePNWakeRules(s_pnRules, 2U, 0U, &pnConfig, &exact), STATUS_ERROR);
+
+    (void)FLEXCAN_DRV_Deinit(0U);
+}
+
+/*******************************************************************************
+ * Main
+ ******************************************************************************/
+
+static const host_test_t s_tests[] = {
+    { "RxRingBurstOverflow", TestRxRingBurstOverflow },
+    { "RxRingBurstDrained", TestRxRingBurstDrained },
+    { "RxRingHwOverrun", TestRxRingHwOverrun },
+    { "RxRingAbort", TestRxRingAbort },
+    { "RxRingArguments", TestRxRingArguments },
+    { "CountLeadingZeros", TestCountLeadingZeros },
+    { "IsrServicesAllPendingMbs", TestIsrServicesAllPendingMbs },
+    { "MsgBuffRegions", TestMsgBuffRegions },
+    { "PayloadCopy", TestPayloadCopy },
+    { "TxQueueOrder", TestTxQueueOrder },
+    { "TxQueueSameId", TestTxQueueSameId },
+    { "TxQueueDescendingIds", TestTxQueueDescendingIds },
+    { "TxQueueFailedLoad", TestTxQueueFailedLoad },
+    { "TxQueueKick", TestTxQueueKick },
+    { "TxQueueRelease", TestTxQueueRelease },
+    { "RxFifoBatch", TestRxFifoBatch },
+    { "TxDmaChain", TestTxDmaChain },
+    { "TxDmaError", TestTxDmaError },
+    { "TxDmaAbort", TestTxDmaAbort },
+    { "RxFifoDmaBatch", TestRxFifoDmaBatch },
+    { "LatencyHistogramTx", TestLatencyHistogramTx },
+    { "LatencyHistogramRx", TestLatencyHistogramRx },
+    { "LatencyHistogramTxQueue", TestLatencyHistogramTxQueue },
+    { "RxFilterRandomSets", TestRxFilterRandomSets },
+    { "RxFilterManySingles", TestRxFilterManySingles },
+    { "RxFilterManyMasks", TestRxFilterManyMasks },
+    { "RxFilterFifo", TestRxFilterFifo },
+    { "BitTimingExhaustive", TestBitTimingExhaustive },
+    { "BitTimingConfig", TestBitTimingConfig },
+    { "ErrorManagerStates", TestErrorManagerStates },
+    { "ErrorManagerBackoff", TestErrorManagerBackoff },
+    { "PNWakeRulesRandom", TestPNWakeRulesRandom },
+    { "PNWakeRulesDlc", TestPNWakeRulesDlc },
+};
+
+int main(void)
+{
+    return HOST_RunTests("flexcan", s_tests, sizeof(s_tests) / sizeof(s_tests[0]));
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOST_DEVICE_REGISTERS_H
+#define HOST_DEVICE_REGISTERS_H
+
+/*
+ * Wraps the device header: the register map is the real one, only the core
+ * intrinsics written in ARM assembly are replaced with their effect on the
+ * host model of the CPU.
+ */
+
+#include "../../devices/device_registers.h"
+
+#include <stdbool.h>
+
+void HOST_CpuEnableIrq(void);
+void HOST_CpuDisableIrq(void);
+bool HOST_Idle(void);
+
+#undef BKPT_ASM
+#define BKPT_ASM __builtin_trap()
+
+#undef ENABLE_INTERRUPTS
+#define ENABLE_INTERRUPTS() HOST_CpuEnableIrq()
+
+#undef DISABLE_INTERRUPTS
+#define DISABLE_INTERRUPTS() HOST_CpuDisableIrq()
+
+#undef STANDBY
+#define STANDBY() ((void)HOST_Idle())
+
+#undef REV_BYTES_32
+#define REV_BYTES_32(a, b) ((b) = __builtin_bswap32(a))
+
+#undef REV_BYTES_16
+#define REV_BYTES_16(a, b) ((b) = ((((uint32_t)(a)) & 0xFF00FF00U) >> 8U) | ((((uint32_t)(a)) & 0x00FF00FFU) << 8U))
+
+#endif /* HOST_DEVICE_REGISTERS_H */
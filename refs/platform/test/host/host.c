@@ -0,0 +1,853 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * The peripheral windows live in a memfd mapped twice: at the device address,
+ * where the drivers access it, and at an alias used by the models. While the
+ * models are enabled the device mapping is PROT_NONE; an access faults, the
+ * fault handler lets the model update the registers, opens the page and sets
+ * the trap flag, and after the single instruction has run the trap handler
+ * closes the page, hands the written value to the model and delivers the
+ * interrupts the access made pending.
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "host.h"
+#include "host_can.h"
+#include "host_csec.h"
+#include "host_dma.h"
+#include "host_lpit.h"
+#include "interrupt_manager.h"
+#include "clock_manager.h"
+#include "osif.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define HOST_PAGE_SIZE          (0x1000U)
+#define HOST_TRAP_FLAG          (0x100)
+#define HOST_MAX_ACCESSES       (4U)
+#define HOST_MAX_HOOKS          (8U)
+#define HOST_IRQ_COUNT          ((uint32_t)FEATURE_INTERRUPT_IRQ_MAX + 1U)
+#define HOST_IRQ_WORDS          ((HOST_IRQ_COUNT + 31U) >> 5U)
+#define HOST_THREAD_PRIORITY    (256)
+#define HOST_DEADLOCK_MS        (3600000U)
+
+typedef struct {
+    uint32_t base;
+    uint32_t size;
+    uint32_t offset;                /* Offset in the memfd */
+    host_read_hook_t read;
+    host_write_hook_t write;
+} host_window_t;
+
+typedef struct {
+    host_window_t *window;
+    uint32_t addr;
+    bool write;
+    uint32_t oldValue;
+} host_access_t;
+
+/* The S32K144 peripherals the drivers under test use. The ones without a
+ * model are plain RAM. */
+static host_window_t s_windows[] = {
+    { 0x14001000U, 0x1000U, 0U, NULL, NULL },   /* CSE_PRAM */
+    { 0x40008000U, 0x2000U, 0U, NULL, NULL },   /* DMA, TCDs */
+    { 0x40020000U, 0x1000U, 0U, NULL, NULL },   /* FTFC */
+    { 0x40021000U, 0x1000U, 0U, NULL, NULL },   /* DMAMUX */
+    { 0x40024000U, 0x1000U, 0U, NULL, NULL },   /* CAN0 */
+    { 0x40025000U, 0x1000U, 0U, NULL, NULL },   /* CAN1 */
+    { 0x4002B000U, 0x1000U, 0U, NULL, NULL },   /* CAN2 */
+    { 0x40037000U, 0x1000U, 0U, NULL, NULL },   /* LPIT0 */
+    { 0x40064000U, 0x2000U, 0U, NULL, NULL },   /* SCG, PCC */
+    { 0xE000E000U, 0x1000U, 0U, NULL, NULL },   /* SCS: SysTick, NVIC, SCB */
+};
+
+#define HOST_WINDOW_COUNT (sizeof(s_windows) / sizeof(s_windows[0]))
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Vector table in RAM, as expected by INT_SYS_InstallHandler */
+uint32_t __VECTOR_RAM[HOST_IRQ_COUNT + 16U];
+
+jmp_buf g_hostAssertJump;
+volatile bool g_hostAssertArmed = false;
+
+static uint8_t *s_alias = NULL;
+static bool s_mapped = false;
+static bool s_modelsEnabled = true;
+
+static host_access_t s_accesses[HOST_MAX_ACCESSES];
+static volatile uint32_t s_accessCount = 0U;
+
+static host_idle_hook_t s_idleHooks[HOST_MAX_HOOKS];
+static uint32_t s_idleHookCount = 0U;
+
+/* NVIC state. The pending state of an IRQ is the latched pending bit or the
+ * level of its line, as for the level-sensitive peripheral interrupts. The
+ * rising edge of a line latches the pending bit, which stays set once the line
+ * drops, until the exception entry or a clear made after the drop. */
+static uint32_t s_irqEnabled[HOST_IRQ_WORDS];
+static uint32_t s_irqLatched[HOST_IRQ_WORDS];
+static uint32_t s_irqLevel[HOST_IRQ_WORDS];
+static uint32_t s_irqActive[HOST_IRQ_WORDS];
+static volatile bool s_primask = false;
+static int32_t s_execPriority = HOST_THREAD_PRIORITY;
+static int32_t s_activeIrq = 0;
+
+static uint32_t s_ms = 0U;
+static uint32_t s_clockFreq = 80000000U;
+static host_stats_t s_stats;
+
+static uint32_t s_checks = 0U;
+static uint32_t s_failures = 0U;
+
+/* Vector table of the test image, see host_vectors.c */
+extern void HOST_InstallVectors(uint32_t *vectors);
+
+static void HOST_NvicRead(uint32_t addr);
+static void HOST_NvicWrite(uint32_t addr, uint32_t oldValue, uint32_t newValue);
+
+/*******************************************************************************
+ * Memory map and traps
+ ******************************************************************************/
+
+static host_window_t *HOST_FindWindow(uintptr_t addr)
+{
+    uint32_t i;
+
+    for (i = 0U; i < HOST_WINDOW_COUNT; i++)
+    {
+        if ((addr >= s_windows[i].base) && (addr < ((uintptr_t)s_windows[i].base + s_windows[i].size)))
+        {
+            return &s_windows[i];
+        }
+    }
+
+    return NULL;
+}
+
+volatile uint32_t *HOST_Reg32(uint32_t addr)
+{
+    host_window_t *window = HOST_FindWindow(addr);
+
+    if (window == NULL)
+    {
+        fprintf(stderr, "host: no peripheral at 0x%08x\n", (unsigned)addr);
+        abort();
+    }
+
+    return (volatile uint32_t *)(void *)&s_alias[window->offset + ((addr & ~3U) - window->base)];
+}
+
+uint8_t *HOST_BusPtr(uint32_t addr)
+{
+    host_window_t *window = HOST_FindWindow(addr);
+
+    if (window != NULL)
+    {
+        return &s_alias[window->offset + (addr - window->base)];
+    }
+
+    return (uint8_t *)(uintptr_t)addr;
+}
+
+void HOST_BusRead(uint32_t addr, void *data, uint32_t size)
+{
+    host_window_t *window = HOST_FindWindow(addr);
+
+    if ((window != NULL) && s_modelsEnabled && (window->read != NULL))
+    {
+        window->read(addr);
+    }
+    memcpy(data, HOST_BusPtr(addr), size);
+}
+
+void HOST_BusWrite(uint32_t addr, const void *data, uint32_t size)
+{
+    host_window_t *window = HOST_FindWindow(addr);
+    uint32_t oldValue = 0U;
+
+    if (window != NULL)
+    {
+        oldValue = *HOST_Reg32(addr);
+    }
+    memcpy(HOST_BusPtr(addr), data, size);
+    if ((window != NULL) && s_modelsEnabled && (window->write != NULL))
+    {
+        window->write(addr, oldValue, *HOST_Reg32(addr));
+    }
+}
+
+static void HOST_ProtectWindows(int prot)
+{
+    uint32_t i;
+
+    for (i = 0U; i < HOST_WINDOW_COUNT; i++)
+    {
+        (void)mprotect((void *)(uintptr_t)s_windows[i].base, s_windows[i].size, prot);
+    }
+}
+
+static void HOST_FaultHandler(int sig, siginfo_t *info, void *context)
+{
+    ucontext_t *uc = (ucontext_t *)context;
+    host_window_t *window = HOST_FindWindow((uintptr_t)info->si_addr);
+    uint32_t addr = (uint32_t)(uintptr_t)info->si_addr;
+    host_access_t *access;
+
+    (void)sig;
+
+    if ((window == NULL) || (s_accessCount >= HOST_MAX_ACCESSES))
+    {
+        /* A genuine crash: let it happen with the default action */
+        (void)signal(SIGSEGV, SIG_DFL);
+        return;
+    }
+
+    if (window->read != NULL)
+    {
+        window->read(addr);
+    }
+
+    access = &s_accesses[s_accessCount++];
+    access->window = window;
+    access->addr = addr;
+    access->write = ((uc->uc_mcontext.gregs[REG_ERR] & 2) != 0);
+    access->oldValue = *HOST_Reg32(addr);
+
+    (void)mprotect((void *)(uintptr_t)(addr & ~(HOST_PAGE_SIZE - 1U)), HOST_PAGE_SIZE, PROT_READ | PROT_WRITE);
+    uc->uc_mcontext.gregs[REG_EFL] |= HOST_TRAP_FLAG;
+}
+
+static void HOST_StepHandler(int sig, siginfo_t *info, void *context)
+{
+    ucontext_t *uc = (ucontext_t *)context;
+    host_access_t accesses[HOST_MAX_ACCESSES];
+    uint32_t count = s_accessCount;
+    uint32_t i;
+
+    (void)sig;
+    (void)info;
+
+    uc->uc_mcontext.gregs[REG_EFL] &= ~HOST_TRAP_FLAG;
+
+    memcpy(accesses, s_accesses, sizeof(accesses));
+    s_accessCount = 0U;
+
+    for (i = 0U; i < count; i++)
+    {
+        (void)mprotect((void *)(uintptr_t)(accesses[i].addr & ~(HOST_PAGE_SIZE - 1U)), HOST_PAGE_SIZE, PROT_NONE);
+    }
+
+    for (i = 0U; i < count; i++)
+    {
+        if (accesses[i].write)
+        {
+            s_stats.writes++;
+            if (accesses[i].window->write != NULL)
+            {
+                accesses[i].window->write(accesses[i].addr, accesses[i].oldValue, *HOST_Reg32(accesses[i].addr));
+            }
+        }
+        else
+        {
+            s_stats.reads++;
+        }
+    }
+
+    /* The access may have made an interrupt pending */
+    HOST_DispatchIrqs();
+}
+
+static void HOST_Map(void)
+{
+    struct sigaction sa;
+    uint32_t total = 0U;
+    uint32_t i;
+    int fd;
+
+    for (i = 0U; i < HOST_WINDOW_COUNT; i++)
+    {
+        s_windows[i].offset = total;
+        total += s_windows[i].size;
+    }
+
+    fd = memfd_create("s32k144", 0);
+    if ((fd < 0) || (ftruncate(fd, (off_t)total) != 0))
+    {
+        perror("host: memfd");
+        exit(2);
+    }
+
+    s_alias = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (s_alias == MAP_FAILED)
+    {
+        perror("host: alias mapping");
+        exit(2);
+    }
+
+    for (i = 0U; i < HOST_WINDOW_COUNT; i++)
+    {
+        void *p = mmap((void *)(uintptr_t)s_windows[i].base, s_windows[i].size, PROT_NONE,
+                       MAP_SHARED | MAP_FIXED_NOREPLACE, fd, (off_t)s_windows[i].offset);
+        if (p != (void *)(uintptr_t)s_windows[i].base)
+        {
+            fprintf(stderr, "host: cannot map the peripheral window at 0x%08x\n", (unsigned)s_windows[i].base);
+            exit(2);
+        }
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_flags = SA_SIGINFO | SA_NODEFER;
+    sa.sa_sigaction = HOST_FaultHandler;
+    (void)sigaction(SIGSEGV, &sa, NULL);
+    sa.sa_sigaction = HOST_StepHandler;
+    (void)sigaction(SIGTRAP, &sa, NULL);
+
+    HOST_AttachModel(S32_NVIC_BASE, HOST_NvicRead, HOST_NvicWrite);
+    s_mapped = true;
+}
+
+void HOST_AttachModel(uint32_t base, host_read_hook_t read, host_write_hook_t write)
+{
+    host_window_t *window = HOST_FindWindow(base);
+
+    window->read = read;
+    window->write = write;
+}
+
+void HOST_AddIdleHook(host_idle_hook_t hook)
+{
+    uint32_t i;
+
+    for (i = 0U; i < s_idleHookCount; i++)
+    {
+        if (s_idleHooks[i] == hook)
+        {
+            return;
+        }
+    }
+    s_idleHooks[s_idleHookCount++] = hook;
+}
+
+void HOST_SetModelsEnabled(bool enable)
+{
+    s_modelsEnabled = enable;
+    HOST_ProtectWindows(enable ? PROT_NONE : (PROT_READ | PROT_WRITE));
+}
+
+/*******************************************************************************
+ * NVIC and CPU
+ ******************************************************************************/
+
+static uint32_t HOST_NvicRegOffset(uint32_t addr)
+{
+    return addr - S32_NVIC_BASE;
+}
+
+static void HOST_NvicRefresh(void)
+{
+    uint32_t i;
+
+    for (i = 0U; i < HOST_IRQ_WORDS; i++)
+    {
+        *HOST_Reg32(S32_NVIC_BASE + 0x000U + (i * 4U)) = s_irqEnabled[i];
+        *HOST_Reg32(S32_NVIC_BASE + 0x080U + (i * 4U)) = s_irqEnabled[i];
+        *HOST_Reg32(S32_NVIC_BASE + 0x100U + (i * 4U)) = s_irqLatched[i] | s_irqLevel[i];
+        *HOST_Reg32(S32_NVIC_BASE + 0x180U + (i * 4U)) = s_irqLatched[i] | s_irqLevel[i];
+        *HOST_Reg32(S32_NVIC_BASE + 0x200U + (i * 4U)) = s_irqActive[i];
+    }
+}
+
+static void HOST_NvicRead(uint32_t addr)
+{
+    (void)addr;
+    HOST_NvicRefresh();
+}
+
+static void HOST_NvicWrite(uint32_t addr, uint32_t oldValue, uint32_t newValue)
+{
+    uint32_t offset = HOST_NvicRegOffset(addr & ~3U);
+    uint32_t word = (offset & 0x7FU) >> 2U;
+
+    (void)oldValue;
+
+    if (addr < S32_NVIC_BASE)
+    {
+        /* SysTick and SCB registers are plain RAM */
+        return;
+    }
+
+    if ((offset < 0x280U) && (word < HOST_IRQ_WORDS))
+    {
+        switch (offset & ~0x7FU)
+        {
+        case 0x000U:
+            s_irqEnabled[word] |= newValue;
+            break;
+        case 0x080U:
+            s_irqEnabled[word] &= ~newValue;
+            break;
+        case 0x100U:
+            s_irqLatched[word] |= newValue;
+            break;
+        case 0x180U:
+            /* Clearing has no effect while the line is still asserted */
+            s_irqLatched[word] &= ~(newValue & ~s_irqLevel[word]);
+            break;
+        default:
+            /* IABR is read-only */
+            break;
+        }
+    }
+    else if (offset == 0xE00U)
+    {
+        HOST_PendIrq((IRQn_Type)(newValue & 0x1FFU));
+    }
+    else
+    {
+        /* Priority registers are plain RAM */
+    }
+
+    HOST_NvicRefresh();
+}
+
+static bool HOST_IrqBit(const uint32_t *bits, uint32_t irq)
+{
+    return ((bits[irq >> 5U] >> (irq & 31U)) & 1U) != 0U;
+}
+
+static int32_t HOST_IrqPriority(uint32_t irq)
+{
+    const volatile uint8_t *ip = (const volatile uint8_t *)(const volatile void *)HOST_Reg32(S32_NVIC_BASE + 0x300U);
+
+    return (int32_t)(ip[irq] >> (8U - FEATURE_NVIC_PRIO_BITS));
+}
+
+void HOST_SetIrqLine(IRQn_Type irq, bool level)
+{
+    uint32_t n = (uint32_t)irq;
+
+    if (level)
+    {
+        if (!HOST_IrqBit(s_irqLevel, n))
+        {
+            s_irqLatched[n >> 5U] |= (1UL << (n & 31U));
+        }
+        s_irqLevel[n >> 5U] |= (1UL << (n & 31U));
+    }
+    else
+    {
+        s_irqLevel[n >> 5U] &= ~(1UL << (n & 31U));
+    }
+    HOST_NvicRefresh();
+}
+
+void HOST_PendIrq(IRQn_Type irq)
+{
+    uint32_t n = (uint32_t)irq;
+
+    s_irqLatched[n >> 5U] |= (1UL << (n & 31U));
+    HOST_NvicRefresh();
+}
+
+bool HOST_IsIrqPending(IRQn_Type irq)
+{
+    uint32_t n = (uint32_t)irq;
+
+    return HOST_IrqBit(s_irqLatched, n) || HOST_IrqBit(s_irqLevel, n);
+}
+
+void HOST_DispatchIrqs(void)
+{
+    for (;;)
+    {
+        int32_t bestPriority = s_execPriority;
+        int32_t best = -1;
+        uint32_t irq;
+
+        if (s_primask || (!s_modelsEnabled))
+        {
+            return;
+        }
+
+        for (irq = 0U; irq < HOST_IRQ_COUNT; irq++)
+        {
+            if (HOST_IrqBit(s_irqEnabled, irq) && (!HOST_IrqBit(s_irqActive, irq)) &&
+                (HOST_IrqBit(s_irqLatched, irq) || HOST_IrqBit(s_irqLevel, irq)) &&
+                (HOST_IrqPriority(irq) < bestPriority))
+            {
+                bestPriority = HOST_IrqPriority(irq);
+                best = (int32_t)irq;
+            }
+        }
+
+        if (best < 0)
+        {
+            return;
+        }
+
+        {
+            uint32_t n = (uint32_t)best;
+            int32_t savedPriority = s_execPriority;
+            int32_t savedIrq = s_activeIrq;
+            isr_t handler = (isr_t)(uintptr_t)__VECTOR_RAM[n + 16U];
+
+            /* Exception entry clears the pending state */
+            s_irqLatched[n >> 5U] &= ~(1UL << (n & 31U));
+            s_irqActive[n >> 5U] |= (1UL << (n & 31U));
+            s_execPriority = bestPriority;
+            s_activeIrq = best + 16;
+            s_stats.irqs++;
+
+            if (handler == NULL)
+            {
+                fprintf(stderr, "host: no handler for IRQ %d\n", best);
+                abort();
+            }
+            handler();
+
+            /* Unbalanced masking in a handler is a driver bug */
+            if (s_primask)
+            {
+                fprintf(stderr, "host: IRQ %d returned with the interrupts masked\n", best);
+                abort();
+            }
+
+            s_activeIrq = savedIrq;
+            s_execPriority = savedPriority;
+            s_irqActive[n >> 5U] &= ~(1UL << (n & 31U));
+        }
+    }
+}
+
+void HOST_CpuEnableIrq(void)
+{
+    s_primask = false;
+    HOST_DispatchIrqs();
+}
+
+void HOST_CpuDisableIrq(void)
+{
+    s_primask = true;
+}
+
+bool HOST_CpuIrqMasked(void)
+{
+    return s_primask;
+}
+
+int32_t HOST_ActiveIrq(void)
+{
+    return s_activeIrq;
+}
+
+bool HOST_Idle(void)
+{
+    bool progress = false;
+    uint32_t before = s_stats.irqs;
+    uint32_t i;
+
+    for (i = 0U; i < s_idleHookCount; i++)
+    {
+        if (s_idleHooks[i]())
+        {
+            progress = true;
+        }
+    }
+
+    HOST_DispatchIrqs();
+
+    return progress || (s_stats.irqs != before);
+}
+
+void HOST_RunUntilIdle(void)
+{
+    uint32_t rounds = 0U;
+
+    while (HOST_Idle())
+    {
+        if (++rounds > 100000U)
+        {
+            fprintf(stderr, "host: the hardware does not settle\n");
+            abort();
+        }
+    }
+}
+
+/*******************************************************************************
+ * Platform services: OSIF, clocks, DEV_ASSERT
+ ******************************************************************************/
+
+uint32_t HOST_GetMs(void)
+{
+    return s_ms;
+}
+
+void HOST_AdvanceMs(uint32_t ms)
+{
+    s_ms += ms;
+}
+
+void HOST_SetClockFreq(uint32_t freq)
+{
+    s_clockFreq = freq;
+}
+
+status_t CLOCK_SYS_GetFreq(clock_names_t clockName, uint32_t *frequency)
+{
+    (void)clockName;
+    *frequency = s_clockFreq;
+
+    return STATUS_SUCCESS;
+}
+
+uint32_t OSIF_GetMilliseconds(void)
+{
+    /* The blocking calls poll the time: let the hardware make progress, but
+     * not from a handler, which the hardware could not preempt */
+    if (s_activeIrq == 0)
+    {
+        (void)HOST_Idle();
+    }
+
+    return s_ms;
+}
+
+void OSIF_TimeDelay(const uint32_t delay)
+{
+    HOST_RunUntilIdle();
+    s_ms += delay;
+}
+
+status_t OSIF_SemaCreate(semaphore_t * const pSem, const uint8_t initValue)
+{
+    *pSem = initValue;
+
+    return STATUS_SUCCESS;
+}
+
+status_t OSIF_SemaDestroy(const semaphore_t * const pSem)
+{
+    (void)pSem;
+
+    return STATUS_SUCCESS;
+}
+
+status_t OSIF_SemaPost(semaphore_t * const pSem)
+{
+    if (*pSem == 0xFFU)
+    {
+        return STATUS_ERROR;
+    }
+    (*pSem)++;
+
+    return STATUS_SUCCESS;
+}
+
+status_t OSIF_SemaWait(semaphore_t * const pSem, const uint32_t timeout)
+{
+    uint32_t start = s_ms;
+
+    while (*pSem == 0U)
+    {
+        if (!HOST_Idle())
+        {
+            /* Nothing left to do before the timeout: let the time pass */
+            if ((timeout != OSIF_WAIT_FOREVER) && ((s_ms - start) >= timeout))
+            {
+                return STATUS_TIMEOUT;
+            }
+            if ((s_ms - start) >= HOST_DEADLOCK_MS)
+            {
+                fprintf(stderr, "host: nothing can post the semaphore any more\n");
+                abort();
+            }
+            s_ms++;
+        }
+    }
+    (*pSem)--;
+
+    return STATUS_SUCCESS;
+}
+
+status_t OSIF_MutexCreate(mutex_t * const pMutex)
+{
+    *pMutex = 0U;
+
+    return STATUS_SUCCESS;
+}
+
+status_t OSIF_MutexDestroy(const mutex_t * const pMutex)
+{
+    (void)pMutex;
+
+    return STATUS_SUCCESS;
+}
+
+status_t OSIF_MutexLock(const mutex_t * const pMutex, const uint32_t timeout)
+{
+    (void)pMutex;
+    (void)timeout;
+
+    return STATUS_SUCCESS;
+}
+
+status_t OSIF_MutexUnlock(const mutex_t * const pMutex)
+{
+    (void)pMutex;
+
+    return STATUS_SUCCESS;
+}
+
+void HOST_DevAssert(const char *text, const char *file, int line)
+{
+    if (g_hostAssertArmed)
+    {
+        g_hostAssertArmed = false;
+        s_primask = false;
+        longjmp(g_hostAssertJump, 1);
+    }
+
+    fprintf(stderr, "%s:%d: DEV_ASSERT(%s) failed\n", file, line, text);
+    abort();
+}
+
+/*******************************************************************************
+ * Test runner
+ ******************************************************************************/
+
+void HOST_GetStats(host_stats_t *stats)
+{
+    *stats = s_stats;
+}
+
+void HOST_ResetStats(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+uint64_t HOST_NowNs(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+void HOST_Init(void)
+{
+    uint32_t i;
+
+    if (!s_mapped)
+    {
+        HOST_Map();
+    }
+
+    HOST_ProtectWindows(PROT_READ | PROT_WRITE);
+    for (i = 0U; i < HOST_WINDOW_COUNT; i++)
+    {
+        memset(&s_alias[s_windows[i].offset], 0, s_windows[i].size);
+    }
+
+    memset(s_irqEnabled, 0, sizeof(s_irqEnabled));
+    memset(s_irqLatched, 0, sizeof(s_irqLatched));
+    memset(s_irqLevel, 0, sizeof(s_irqLevel));
+    memset(s_irqActive, 0, sizeof(s_irqActive));
+    s_primask = false;
+    s_execPriority = HOST_THREAD_PRIORITY;
+    s_activeIrq = 0;
+    s_ms = 0U;
+    s_clockFreq = 80000000U;
+    s_idleHookCount = 0U;
+    s_accessCount = 0U;
+    HOST_ResetStats();
+
+    memset(__VECTOR_RAM, 0, sizeof(__VECTOR_RAM));
+    HOST_InstallVectors(__VECTOR_RAM);
+    *HOST_Reg32((uint32_t)(uintptr_t)&S32_SCB->VTOR) = (uint32_t)(uintptr_t)__VECTOR_RAM;
+
+    HOST_CAN_Reset();
+    HOST_DMA_Reset();
+    HOST_LPIT_Reset();
+    HOST_CSEC_Reset();
+
+    s_modelsEnabled = true;
+    HOST_ProtectWindows(PROT_NONE);
+}
+
+void HOST_Check(bool cond, const char *text, const char *file, int line)
+{
+    s_checks++;
+    if (!cond)
+    {
+        s_failures++;
+        fprintf(stderr, "%s:%d: check failed: %s\n", file, line, text);
+    }
+}
+
+void HOST_CheckEq(uint64_t actual, uint64_t expected, const char *text, const char *file, int line)
+{
+    s_checks++;
+    if (actual != expected)
+    {
+        s_failures++;
+        fprintf(stderr, "%s:%d: check failed: %s is %llu, expected %llu\n", file, line, text,
+                (unsigned long long)actual, (unsigned long long)expected);
+    }
+}
+
+int HOST_RunTests(const char *suite, const host_test_t *tests, uint32_t count)
+{
+    uint32_t failedTests = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        uint32_t before = s_failures;
+
+        HOST_Init();
+        tests[i].run();
+        HOST_SetModelsEnabled(false);
+
+        if (s_failures != before)
+        {
+            failedTests++;
+        }
+        printf("%-6s %s.%s\n", (s_failures != before) ? "FAIL" : "ok", suite, tests[i].name);
+    }
+
+    printf("%s: %u/%u tests passed, %u checks\n", suite, (unsigned)(count - failedTests), (unsigned)count, (unsigned)s_checks);
+
+    return (failedTests == 0U) ? 0 : 1;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,190 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOST_H
+#define HOST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <setjmp.h>
+#include "device_registers.h"
+
+/*!
+ * @file host.h
+ *
+ * @brief Host stand-in for the S32K144 used by the driver tests.
+ *
+ * The peripheral windows are mapped at their device addresses, so the drivers
+ * run unmodified. Every access to a window traps into a model of the
+ * peripheral (write-1-to-clear flags, command registers, mode handshakes,
+ * level-sensitive interrupt lines), and the NVIC model delivers the interrupts
+ * at the access boundaries, with the Cortex-M4 priority and masking rules.
+ *
+ * The tests must be linked with -no-pie, so that the static buffers handed to
+ * the drivers (and to the eDMA) have 32-bit addresses.
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Test case descriptor */
+typedef struct {
+    const char *name;      /*!< Name printed in the report */
+    void (*run)(void);     /*!< Test body; uses the HOST_CHECK macros */
+} host_test_t;
+
+/*! @brief Checks a condition, reporting the location when it does not hold */
+#define HOST_CHECK(cond) HOST_Check((cond), #cond, __FILE__, __LINE__)
+
+/*! @brief Checks that two unsigned values are equal */
+#define HOST_CHECK_EQ(actual, expected) \
+    HOST_CheckEq((uint64_t)(actual), (uint64_t)(expected), #actual, __FILE__, __LINE__)
+
+/*! @brief Checks that the statement fails a DEV_ASSERT */
+#define HOST_CHECK_ASSERT(stmt)                             \
+    do {                                                    \
+        g_hostAssertArmed = true;                           \
+        if (setjmp(g_hostAssertJump) == 0)                  \
+        {                                                   \
+            stmt;                                           \
+            g_hostAssertArmed = false;                      \
+            HOST_Check(false, "DEV_ASSERT in " #stmt,       \
+                       __FILE__, __LINE__);                 \
+        }                                                   \
+    } while (false)
+
+/*! @brief Counters of the accesses the drivers made to the peripherals */
+typedef struct {
+    uint32_t reads;        /*!< Number of trapped register reads */
+    uint32_t writes;       /*!< Number of trapped register writes */
+    uint32_t irqs;         /*!< Number of interrupt handlers entered */
+} host_stats_t;
+
+/*! @brief Model hook called before a trapped read or write of a window */
+typedef void (*host_read_hook_t)(uint32_t addr);
+
+/*! @brief Model hook called after a trapped write of a window */
+typedef void (*host_write_hook_t)(uint32_t addr, uint32_t oldValue, uint32_t newValue);
+
+/*! @brief Handler run from HOST_Idle on behalf of a peripheral model */
+typedef bool (*host_idle_hook_t)(void);
+
+extern jmp_buf g_hostAssertJump;
+extern volatile bool g_hostAssertArmed;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*! @brief Maps the peripherals, installs the traps and resets every model */
+void HOST_Init(void);
+
+/*! @brief Runs a test suite; returns the process exit status */
+int HOST_RunTests(const char *suite, const host_test_t *tests, uint32_t count);
+
+void HOST_Check(bool cond, const char *text, const char *file, int line);
+void HOST_CheckEq(uint64_t actual, uint64_t expected, const char *text, const char *file, int line);
+
+/*!
+ * @brief Enables or disables the register models.
+ *
+ * With the models disabled the windows behave as plain RAM and the accesses
+ * cost no more than on the target, which is what the benchmarks need; the
+ * benchmark then primes the registers it depends on itself.
+ */
+void HOST_SetModelsEnabled(bool enable);
+
+/*! @brief Returns a pointer through which a model accesses a register */
+volatile uint32_t *HOST_Reg32(uint32_t addr);
+
+/*! @brief Translates a bus address (device or host RAM) to a host pointer */
+uint8_t *HOST_BusPtr(uint32_t addr);
+
+/*!
+ * @brief Accesses the bus on behalf of a bus master model (the eDMA): the
+ * access to a peripheral window goes through its model, as a CPU access does.
+ * The access is 1, 2 or 4 bytes wide and aligned on its size.
+ */
+void HOST_BusRead(uint32_t addr, void *data, uint32_t size);
+void HOST_BusWrite(uint32_t addr, const void *data, uint32_t size);
+
+/*! @brief Attaches a peripheral model to the window containing base */
+void HOST_AttachModel(uint32_t base, host_read_hook_t read, host_write_hook_t write);
+
+/*! @brief Registers a background step of a peripheral model */
+void HOST_AddIdleHook(host_idle_hook_t hook);
+
+/*!
+ * @brief Lets the hardware make progress: runs the background steps of the
+ * models (frame transmission, command completion, ...) and delivers the
+ * pending interrupts. Returns true if anything happened.
+ */
+bool HOST_Idle(void);
+
+/*! @brief Calls HOST_Idle until nothing happens any more */
+void HOST_RunUntilIdle(void);
+
+/*! @brief Sets the level of an interrupt line; a high level makes the IRQ pending */
+void HOST_SetIrqLine(IRQn_Type irq, bool level);
+
+/*! @brief Pends an interrupt as a pulse on its line */
+void HOST_PendIrq(IRQn_Type irq);
+
+/*! @brief Returns true if the interrupt is pending in the NVIC */
+bool HOST_IsIrqPending(IRQn_Type irq);
+
+/*! @brief Delivers the pending interrupts that may preempt the running code */
+void HOST_DispatchIrqs(void);
+
+/*! @brief CPU interrupt masking, used by ENABLE/DISABLE_INTERRUPTS */
+void HOST_CpuEnableIrq(void);
+void HOST_CpuDisableIrq(void);
+bool HOST_CpuIrqMasked(void);
+
+/*! @brief Returns the number of the running exception handler (0 in thread mode) */
+int32_t HOST_ActiveIrq(void);
+
+/*! @brief Virtual time, as returned by OSIF_GetMilliseconds */
+uint32_t HOST_GetMs(void);
+void HOST_AdvanceMs(uint32_t ms);
+
+/*! @brief Frequency returned by CLOCK_SYS_GetFreq */
+void HOST_SetClockFreq(uint32_t freq);
+
+void HOST_GetStats(host_stats_t *stats);
+void HOST_ResetStats(void);
+
+/*! @brief Monotonic host time, for the benchmarks */
+uint64_t HOST_NowNs(void);
+
+/*! @brief Reports a failed DEV_ASSERT (see host_devassert.h) */
+void HOST_DevAssert(const char *text, const char *file, int line) __attribute__((noreturn));
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* HOST_H */
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,949 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host.h"
+#include "host_can.h"
+#include "flexcan_hw_access.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define HOST_CAN_COUNT              (3U)
+#define HOST_CAN_RAM_OFFSET         (0x80U)
+#define HOST_CAN_RAM_SIZE           (0x200U)
+#define HOST_CAN_FILTER_TABLE       (0x18U)     /* Word offset of the Rx FIFO filters */
+
+#define HOST_CAN_MCR_RESET          (0xD890000FU)
+#define HOST_CAN_MCR_SOFT_RESET     (0x5980000FU)
+
+#define HOST_CAN_CODE_RX_INACTIVE   (0x0U)
+#define HOST_CAN_CODE_RX_FULL       (0x2U)
+#define HOST_CAN_CODE_RX_EMPTY      (0x4U)
+#define HOST_CAN_CODE_RX_OVERRUN    (0x6U)
+#define HOST_CAN_CODE_TX_INACTIVE   (0x8U)
+#define HOST_CAN_CODE_TX_ABORT      (0x9U)
+#define HOST_CAN_CODE_TX_DATA       (0xCU)
+
+#define HOST_CAN_CS_EDL             (0x80000000U)
+#define HOST_CAN_CS_BRS             (0x40000000U)
+
+#define HOST_CAN_FIFO_AVAILABLE     (0x20U)
+#define HOST_CAN_FIFO_WARNING       (0x40U)
+#define HOST_CAN_FIFO_OVERFLOW      (0x80U)
+
+/* Write-1-to-clear flags of ESR1 */
+#define HOST_CAN_ESR1_W1C           (CAN_ESR1_ERRINT_MASK | CAN_ESR1_BOFFINT_MASK | CAN_ESR1_RWRNINT_MASK | \
+                                     CAN_ESR1_TWRNINT_MASK | CAN_ESR1_BOFFDONEINT_MASK | \
+                                     CAN_ESR1_ERRINT_FAST_MASK | CAN_ESR1_ERROVR_MASK)
+
+/* Error bits of ESR1 cleared by reading the register */
+#define HOST_CAN_ESR1_COR           (CAN_ESR1_BIT1ERR_MASK | CAN_ESR1_BIT0ERR_MASK | CAN_ESR1_ACKERR_MASK | \
+                                     CAN_ESR1_CRCERR_MASK | CAN_ESR1_FRMERR_MASK | CAN_ESR1_STFERR_MASK | \
+                                     CAN_ESR1_BIT1ERR_FAST_MASK | CAN_ESR1_BIT0ERR_FAST_MASK | \
+                                     CAN_ESR1_CRCERR_FAST_MASK | CAN_ESR1_FRMERR_FAST_MASK | \
+                                     CAN_ESR1_STFERR_FAST_MASK)
+
+/* Fault confinement states of ESR1 FLTCONF */
+#define HOST_CAN_FLTCONF_PASSIVE    (1U)
+#define HOST_CAN_FLTCONF_BUS_OFF    (2U)
+
+#define HOST_CAN_REG(can, reg)      (*HOST_Reg32((can)->base + (uint32_t)offsetof(CAN_Type, reg)))
+
+typedef struct {
+    uint32_t base;
+    IRQn_Type mbIrqLow;             /* MBs 0-15 */
+    IRQn_Type mbIrqHigh;            /* MBs 16-31, NotAvail_IRQn if none */
+    IRQn_Type oredIrq;
+    IRQn_Type errorIrq;
+    uint32_t pending;               /* Tx MBs waiting for the bus */
+    uint32_t serviced;              /* Full Rx MBs read by the CPU since the last frame */
+    uint32_t esr1Read;              /* Error bits of ESR1 the CPU read, cleared before its next access */
+    bool connected;
+    host_can_frame_t fifo[HOST_CAN_FIFO_DEPTH];
+    uint16_t fifoHit[HOST_CAN_FIFO_DEPTH];
+    uint32_t fifoCount;
+    uint32_t txCount;
+    host_can_frame_t log[HOST_CAN_LOG_SIZE];
+} host_can_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static host_can_t s_can[HOST_CAN_COUNT];
+static bool s_autoTransmit = true;
+static host_can_tx_hook_t s_txHook = NULL;
+
+static const uint8_t s_dlcToLength[16] = { 0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U };
+
+/*******************************************************************************
+ * Module state
+ ******************************************************************************/
+
+static host_can_t *HOST_CAN_FromAddr(uint32_t addr)
+{
+    uint32_t i;
+
+    for (i = 0U; i < HOST_CAN_COUNT; i++)
+    {
+        if ((addr & ~0xFFFU) == s_can[i].base)
+        {
+            return &s_can[i];
+        }
+    }
+
+    return NULL;
+}
+
+static bool HOST_CAN_Running(const host_can_t *can)
+{
+    uint32_t mcr = HOST_CAN_REG(can, MCR);
+
+    return ((mcr & (CAN_MCR_MDIS_MASK | CAN_MCR_FRZACK_MASK | CAN_MCR_SOFTRST_MASK)) == 0U);
+}
+
+static uint32_t HOST_CAN_Payload(const host_can_t *can)
+{
+    if ((HOST_CAN_REG(can, MCR) & CAN_MCR_FDEN_MASK) == 0U)
+    {
+        return 8U;
+    }
+
+    return 8UL << ((HOST_CAN_REG(can, FDCTRL) & CAN_FDCTRL_MBDSR0_MASK) >> CAN_FDCTRL_MBDSR0_SHIFT);
+}
+
+/* Number of MBs taking part in the matching and the arbitration */
+static uint32_t HOST_CAN_MbCount(const host_can_t *can)
+{
+    uint32_t fit = HOST_CAN_RAM_SIZE / (8U + HOST_CAN_Payload(can));
+    uint32_t maxMb = (HOST_CAN_REG(can, MCR) & CAN_MCR_MAXMB_MASK) + 1U;
+
+    return (maxMb < fit) ? maxMb : fit;
+}
+
+/* First MB after the Rx FIFO and its filter table */
+static uint32_t HOST_CAN_FirstMb(const host_can_t *can)
+{
+    uint32_t rffn = (HOST_CAN_REG(can, CTRL2) & CAN_CTRL2_RFFN_MASK) >> CAN_CTRL2_RFFN_SHIFT;
+
+    if ((HOST_CAN_REG(can, MCR) & CAN_MCR_RFEN_MASK) == 0U)
+    {
+        return 0U;
+    }
+
+    return 6U + (((rffn + 1U) * 8U) / 4U);
+}
+
+static uint32_t HOST_CAN_MbAddr(const host_can_t *can, uint32_t mb)
+{
+    uint32_t size = 8U + HOST_CAN_Payload(can);
+    uint32_t perBlock = 512U / size;
+
+    return can->base + HOST_CAN_RAM_OFFSET + (512U * (mb / perBlock)) + ((mb % perBlock) * size);
+}
+
+/* Returns the MB whose C/S word is at addr, or -1 */
+static int32_t HOST_CAN_MbFromCsAddr(const host_can_t *can, uint32_t addr)
+{
+    uint32_t mb;
+
+    for (mb = 0U; mb < HOST_CAN_MbCount(can); mb++)
+    {
+        if (HOST_CAN_MbAddr(can, mb) == addr)
+        {
+            return (int32_t)mb;
+        }
+    }
+
+    return -1;
+}
+
+static void HOST_CAN_UpdateLines(const host_can_t *can)
+{
+    uint32_t flags = HOST_CAN_REG(can, IFLAG1) & HOST_CAN_REG(can, IMASK1);
+    uint32_t esr1 = HOST_CAN_REG(can, ESR1);
+    uint32_t ctrl1 = HOST_CAN_REG(can, CTRL1);
+    uint32_t ctrl2 = HOST_CAN_REG(can, CTRL2);
+    bool ored;
+    bool error;
+
+    if (((HOST_CAN_REG(can, MCR) & CAN_MCR_DMA_MASK) != 0U) && ((HOST_CAN_REG(can, MCR) & CAN_MCR_RFEN_MASK) != 0U))
+    {
+        /* The frame available flag is the DMA request */
+        flags &= ~HOST_CAN_FIFO_AVAILABLE;
+    }
+
+    ored = (((esr1 & CAN_ESR1_BOFFINT_MASK) != 0U) && ((ctrl1 & CAN_CTRL1_BOFFMSK_MASK) != 0U)) ||
+           (((esr1 & CAN_ESR1_TWRNINT_MASK) != 0U) && ((ctrl1 & CAN_CTRL1_TWRNMSK_MASK) != 0U)) ||
+           (((esr1 & CAN_ESR1_RWRNINT_MASK) != 0U) && ((ctrl1 & CAN_CTRL1_RWRNMSK_MASK) != 0U)) ||
+           (((esr1 & CAN_ESR1_BOFFDONEINT_MASK) != 0U) && ((ctrl2 & CAN_CTRL2_BOFFDONEMSK_MASK) != 0U));
+    error = (((esr1 & CAN_ESR1_ERRINT_MASK) != 0U) && ((ctrl1 & CAN_CTRL1_ERRMSK_MASK) != 0U)) ||
+            (((esr1 & CAN_ESR1_ERRINT_FAST_MASK) != 0U) && ((ctrl2 & CAN_CTRL2_ERRMSK_FAST_MASK) != 0U));
+
+    HOST_SetIrqLine(can->mbIrqLow, (flags & 0xFFFFU) != 0U);
+    if (can->mbIrqHigh != NotAvail_IRQn)
+    {
+        HOST_SetIrqLine(can->mbIrqHigh, (flags >> 16U) != 0U);
+    }
+    HOST_SetIrqLine(can->oredIrq, ored);
+    HOST_SetIrqLine(can->errorIrq, error);
+}
+
+static void HOST_CAN_SetFlags(const host_can_t *can, uint32_t flags)
+{
+    HOST_CAN_REG(can, IFLAG1) |= flags;
+}
+
+/*******************************************************************************
+ * Frames
+ ******************************************************************************/
+
+static uint32_t HOST_CAN_LengthToDlc(uint32_t length)
+{
+    uint32_t dlc = 0U;
+
+    while ((dlc < 15U) && (s_dlcToLength[dlc] < length))
+    {
+        dlc++;
+    }
+
+    return dlc;
+}
+
+/* Nominal length of a frame in bit times, without stuff bits */
+static uint32_t HOST_CAN_FrameBits(const host_can_frame_t *frame)
+{
+    uint32_t bits = frame->extended ? 67U : 47U;
+
+    if (!frame->remote)
+    {
+        bits += 8U * frame->length;
+    }
+
+    return bits;
+}
+
+static void HOST_CAN_ReadFrame(const host_can_t *can, uint32_t mb, host_can_frame_t *frame)
+{
+    uint32_t addr = HOST_CAN_MbAddr(can, mb);
+    uint32_t cs = *HOST_Reg32(addr);
+    uint32_t id = *HOST_Reg32(addr + 4U);
+    uint32_t i;
+
+    memset(frame, 0, sizeof(*frame));
+    frame->extended = ((cs & CAN_CS_IDE_MASK) != 0U);
+    frame->remote = ((cs & CAN_CS_RTR_MASK) != 0U);
+    frame->fd = ((cs & HOST_CAN_CS_EDL) != 0U);
+    frame->brs = ((cs & HOST_CAN_CS_BRS) != 0U);
+    frame->id = frame->extended ? (id & 0x1FFFFFFFU) : ((id >> 18U) & 0x7FFU);
+    frame->length = s_dlcToLength[(cs & CAN_CS_DLC_MASK) >> CAN_CS_DLC_SHIFT];
+    if ((!frame->fd) && (frame->length > 8U))
+    {
+        frame->length = 8U;
+    }
+    if (frame->length > HOST_CAN_Payload(can))
+    {
+        frame->length = (uint8_t)HOST_CAN_Payload(can);
+    }
+    frame->mb = (uint8_t)mb;
+
+    for (i = 0U; i < frame->length; i++)
+    {
+        uint32_t word = *HOST_Reg32(addr + 8U + (i & ~3U));
+
+        frame->data[i] = (uint8_t)(word >> (24U - (8U * (i & 3U))));
+    }
+}
+
+static void HOST_CAN_WriteFrame(uint32_t addr, uint32_t code, const host_can_frame_t *frame, uint32_t payload)
+{
+    uint32_t length = (frame->length < payload) ? frame->length : payload;
+    uint32_t cs;
+    uint32_t i;
+
+    for (i = 0U; i < payload; i += 4U)
+    {
+        *HOST_Reg32(addr + 8U + i) = 0U;
+    }
+    for (i = 0U; i < length; i++)
+    {
+        *HOST_Reg32(addr + 8U + (i & ~3U)) |= (uint32_t)frame->data[i] << (24U - (8U * (i & 3U)));
+    }
+
+    *HOST_Reg32(addr + 4U) = frame->extended ? (frame->id & 0x1FFFFFFFU) : ((frame->id & 0x7FFU) << 18U);
+
+    cs = (code << CAN_CS_CODE_SHIFT) | (HOST_CAN_LengthToDlc(frame->length) << CAN_CS_DLC_SHIFT) | frame->timestamp;
+    cs |= frame->extended ? (CAN_CS_IDE_MASK | CAN_CS_SRR_MASK) : 0U;
+    cs |= frame->remote ? CAN_CS_RTR_MASK : 0U;
+    cs |= frame->fd ? HOST_CAN_CS_EDL : 0U;
+    cs |= frame->brs ? HOST_CAN_CS_BRS : 0U;
+    *HOST_Reg32(addr) = cs;
+}
+
+/*******************************************************************************
+ * Reception
+ ******************************************************************************/
+
+static void HOST_CAN_LoadFifoOutput(const host_can_t *can)
+{
+    HOST_CAN_WriteFrame(can->base + HOST_CAN_RAM_OFFSET, 0U, &can->fifo[0], 8U);
+    HOST_CAN_REG(can, RXFIR) = can->fifoHit[0];
+    HOST_CAN_SetFlags(can, HOST_CAN_FIFO_AVAILABLE);
+}
+
+static void HOST_CAN_PopFifo(host_can_t *can)
+{
+    if (can->fifoCount == 0U)
+    {
+        return;
+    }
+
+    can->fifoCount--;
+    memmove(&can->fifo[0], &can->fifo[1], can->fifoCount * sizeof(can->fifo[0]));
+    memmove(&can->fifoHit[0], &can->fifoHit[1], can->fifoCount * sizeof(can->fifoHit[0]));
+    HOST_CAN_REG(can, IFLAG1) &= ~HOST_CAN_FIFO_AVAILABLE;
+    if (can->fifoCount > 0U)
+    {
+        HOST_CAN_LoadFifoOutput(can);
+    }
+}
+
+/* Returns the filter element accepting the frame, or -1 */
+static int32_t HOST_CAN_MatchFifo(const host_can_t *can, const host_can_frame_t *frame)
+{
+    uint32_t mcr = HOST_CAN_REG(can, MCR);
+    uint32_t rffn = (HOST_CAN_REG(can, CTRL2) & CAN_CTRL2_RFFN_MASK) >> CAN_CTRL2_RFFN_SHIFT;
+    uint32_t elements = (rffn + 1U) * 8U;
+    uint32_t word;
+    uint32_t i;
+
+    if (frame->fd)
+    {
+        return -1;
+    }
+
+    switch ((mcr & CAN_MCR_IDAM_MASK) >> CAN_MCR_IDAM_SHIFT)
+    {
+    case 0U:
+        break;
+    case 3U:
+        /* Format D rejects all the frames */
+        return -1;
+    default:
+        fprintf(stderr, "host: Rx FIFO filter formats B and C are not modelled\n");
+        abort();
+    }
+
+    /* Format A: RTR, IDE, then the full identifier */
+    word = (frame->remote ? 0x80000000U : 0U) | (frame->extended ? 0x40000000U : 0U);
+    word |= frame->extended ? ((frame->id & 0x1FFFFFFFU) << 1U) : ((frame->id & 0x7FFU) << 19U);
+
+    for (i = 0U; i < elements; i++)
+    {
+        uint32_t element = *HOST_Reg32(can->base + HOST_CAN_RAM_OFFSET + ((HOST_CAN_FILTER_TABLE + i) * 4U));
+        uint32_t mask = (((mcr & CAN_MCR_IRMQ_MASK) != 0U) && (i < CAN_RXIMR_COUNT)) ?
+                        HOST_CAN_REG(can, RXIMR[i]) : HOST_CAN_REG(can, RXFGMASK);
+
+        if (((word ^ element) & mask) == 0U)
+        {
+            return (int32_t)i;
+        }
+    }
+
+    return -1;
+}
+
+static bool HOST_CAN_MatchMb(const host_can_t *can, uint32_t mb, const host_can_frame_t *frame)
+{
+    uint32_t addr = HOST_CAN_MbAddr(can, mb);
+    uint32_t cs = *HOST_Reg32(addr);
+    uint32_t mbId = *HOST_Reg32(addr + 4U);
+    uint32_t frameId = frame->extended ? (frame->id & 0x1FFFFFFFU) : ((frame->id & 0x7FFU) << 18U);
+    uint32_t mask;
+
+    if (((cs & CAN_CS_IDE_MASK) != 0U) != frame->extended)
+    {
+        return false;
+    }
+
+    if ((HOST_CAN_REG(can, MCR) & CAN_MCR_IRMQ_MASK) != 0U)
+    {
+        mask = HOST_CAN_REG(can, RXIMR[mb]);
+    }
+    else if (mb == 14U)
+    {
+        mask = HOST_CAN_REG(can, RX14MASK);
+    }
+    else if (mb == 15U)
+    {
+        mask = HOST_CAN_REG(can, RX15MASK);
+    }
+    else
+    {
+        mask = HOST_CAN_REG(can, RXMGMASK);
+    }
+
+    return (((frameId ^ mbId) & mask & 0x1FFFFFFFU) == 0U);
+}
+
+static void HOST_CAN_StoreFrame(host_can_t *can, uint32_t mb, uint32_t code, const host_can_frame_t *frame)
+{
+    HOST_CAN_WriteFrame(HOST_CAN_MbAddr(can, mb), code, frame, HOST_CAN_Payload(can));
+    can->serviced &= ~(1UL << mb);
+    HOST_CAN_SetFlags(can, 1UL << mb);
+    HOST_CAN_UpdateLines(can);
+}
+
+static void HOST_CAN_Receive(host_can_t *can, const host_can_frame_t *frame, uint16_t timestamp)
+{
+    host_can_frame_t rx = *frame;
+    int32_t overwrite = -1;
+    uint32_t mb;
+
+    if (!HOST_CAN_Running(can))
+    {
+        return;
+    }
+    rx.timestamp = timestamp;
+
+    if ((HOST_CAN_REG(can, MCR) & CAN_MCR_RFEN_MASK) != 0U)
+    {
+        int32_t hit = HOST_CAN_MatchFifo(can, &rx);
+
+        if (hit >= 0)
+        {
+            if (can->fifoCount == HOST_CAN_FIFO_DEPTH)
+            {
+                HOST_CAN_SetFlags(can, HOST_CAN_FIFO_OVERFLOW);
+            }
+            else
+            {
+                can->fifo[can->fifoCount] = rx;
+                can->fifoHit[can->fifoCount] = (uint16_t)hit;
+                can->fifoCount++;
+                if (can->fifoCount == 1U)
+                {
+                    HOST_CAN_LoadFifoOutput(can);
+                }
+                if (can->fifoCount == (HOST_CAN_FIFO_DEPTH - 1U))
+                {
+                    HOST_CAN_SetFlags(can, HOST_CAN_FIFO_WARNING);
+                }
+            }
+            HOST_CAN_UpdateLines(can);
+            return;
+        }
+    }
+
+    for (mb = HOST_CAN_FirstMb(can); mb < HOST_CAN_MbCount(can); mb++)
+    {
+        uint32_t code = (*HOST_Reg32(HOST_CAN_MbAddr(can, mb)) & CAN_CS_CODE_MASK) >> CAN_CS_CODE_SHIFT;
+
+        if (((code == HOST_CAN_CODE_RX_EMPTY) || (code == HOST_CAN_CODE_RX_FULL) ||
+             (code == HOST_CAN_CODE_RX_OVERRUN)) && HOST_CAN_MatchMb(can, mb, &rx))
+        {
+            /* A full MB whose C/S word was read is free again */
+            if ((code == HOST_CAN_CODE_RX_EMPTY) || (((can->serviced >> mb) & 1U) != 0U))
+            {
+                HOST_CAN_StoreFrame(can, mb, HOST_CAN_CODE_RX_FULL, &rx);
+                return;
+            }
+            overwrite = (int32_t)mb;
+        }
+    }
+
+    /* No free MB: the last matching full MB is overwritten */
+    if (overwrite >= 0)
+    {
+        HOST_CAN_StoreFrame(can, (uint32_t)overwrite, HOST_CAN_CODE_RX_OVERRUN, &rx);
+    }
+}
+
+/*******************************************************************************
+ * Transmission
+ ******************************************************************************/
+
+/* Arbitration value of a pending MB: the lowest value wins the bus */
+static uint64_t HOST_CAN_Arbitration(const host_can_t *can, uint32_t mb)
+{
+    uint32_t addr = HOST_CAN_MbAddr(can, mb);
+    uint32_t cs = *HOST_Reg32(addr);
+    uint32_t id = *HOST_Reg32(addr + 4U);
+    uint64_t prio = 0U;
+    uint64_t key;
+
+    if ((HOST_CAN_REG(can, CTRL1) & CAN_CTRL1_LBUF_MASK) != 0U)
+    {
+        return mb;
+    }
+    if ((HOST_CAN_REG(can, MCR) & CAN_MCR_LPRIOEN_MASK) != 0U)
+    {
+        prio = id >> 29U;
+    }
+
+    /* Bit order on the bus: base ID, then SRR/RTR, IDE, extended ID, RTR */
+    key = (uint64_t)((id >> 18U) & 0x7FFU) << 22U;
+    if ((cs & CAN_CS_IDE_MASK) != 0U)
+    {
+        key |= (3ULL << 20U) | ((uint64_t)(id & 0x3FFFFU) << 2U) | (((cs & CAN_CS_RTR_MASK) != 0U) ? 2U : 0U);
+    }
+    else
+    {
+        key |= ((cs & CAN_CS_RTR_MASK) != 0U) ? (1ULL << 21U) : 0U;
+    }
+
+    return (prio << 40U) | (key << 6U) | mb;
+}
+
+static void HOST_CAN_Deliver(host_can_t *from, const host_can_frame_t *frame, uint32_t bits)
+{
+    uint32_t i;
+
+    if ((HOST_CAN_REG(from, CTRL1) & CAN_CTRL1_LPB_MASK) != 0U)
+    {
+        if ((HOST_CAN_REG(from, MCR) & CAN_MCR_SRXDIS_MASK) == 0U)
+        {
+            HOST_CAN_Receive(from, frame, frame->timestamp);
+        }
+        return;
+    }
+
+    if (!from->connected)
+    {
+        return;
+    }
+
+    for (i = 0U; i < HOST_CAN_COUNT; i++)
+    {
+        host_can_t *to = &s_can[i];
+
+        if ((to != from) && to->connected)
+        {
+            HOST_CAN_REG(to, TIMER) = (HOST_CAN_REG(to, TIMER) + bits) & 0xFFFFU;
+            HOST_CAN_Receive(to, frame, (uint16_t)HOST_CAN_REG(to, TIMER));
+        }
+    }
+}
+
+bool HOST_CAN_TransmitNext(uint32_t instance)
+{
+    host_can_t *can = &s_can[instance];
+    host_can_frame_t frame;
+    uint64_t best = UINT64_MAX;
+    uint32_t winner = 0U;
+    uint32_t bits;
+    uint32_t mb;
+    uint32_t addr;
+    uint32_t cs;
+
+    if ((can->pending == 0U) || (!HOST_CAN_Running(can)))
+    {
+        return false;
+    }
+
+    for (mb = 0U; mb < HOST_CAN_MbCount(can); mb++)
+    {
+        if (((can->pending >> mb) & 1U) != 0U)
+        {
+            uint64_t key = HOST_CAN_Arbitration(can, mb);
+
+            if (key < best)
+            {
+                best = key;
+                winner = mb;
+            }
+        }
+    }
+    if (best == UINT64_MAX)
+    {
+        /* The pending MBs are beyond MAXMB */
+        return false;
+    }
+
+    HOST_CAN_ReadFrame(can, winner, &frame);
+    bits = HOST_CAN_FrameBits(&frame);
+    HOST_CAN_REG(can, TIMER) = (HOST_CAN_REG(can, TIMER) + bits) & 0xFFFFU;
+    frame.timestamp = (uint16_t)HOST_CAN_REG(can, TIMER);
+
+    /* A remote request turns into an Rx MB waiting for the answer */
+    addr = HOST_CAN_MbAddr(can, winner);
+    cs = *HOST_Reg32(addr) & ~(CAN_CS_CODE_MASK | CAN_CS_TIME_STAMP_MASK);
+    cs |= (frame.remote ? HOST_CAN_CODE_RX_EMPTY : HOST_CAN_CODE_TX_INACTIVE) << CAN_CS_CODE_SHIFT;
+    *HOST_Reg32(addr) = cs | frame.timestamp;
+    can->pending &= ~(1UL << winner);
+
+    can->log[can->txCount % HOST_CAN_LOG_SIZE] = frame;
+    can->txCount++;
+    if (s_txHook != NULL)
+    {
+        s_txHook(instance, &frame);
+    }
+
+    HOST_CAN_SetFlags(can, 1UL << winner);
+    HOST_CAN_UpdateLines(can);
+    HOST_CAN_Deliver(can, &frame, bits);
+
+    return true;
+}
+
+/*******************************************************************************
+ * Register model
+ ******************************************************************************/
+
+static void HOST_CAN_SoftReset(host_can_t *can)
+{
+    HOST_CAN_REG(can, MCR) = HOST_CAN_MCR_SOFT_RESET;
+    HOST_CAN_REG(can, TIMER) = 0U;
+    HOST_CAN_REG(can, ECR) = 0U;
+    HOST_CAN_REG(can, ESR1) = 0U;
+    can->esr1Read = 0U;
+    HOST_CAN_REG(can, IMASK1) = 0U;
+    HOST_CAN_REG(can, IFLAG1) = 0U;
+    HOST_CAN_REG(can, RXFIR) = 0U;
+    can->pending = 0U;
+    can->serviced = 0U;
+    can->fifoCount = 0U;
+}
+
+static void HOST_CAN_WriteMcr(host_can_t *can, uint32_t oldValue, uint32_t newValue)
+{
+    uint32_t mcr = newValue;
+
+    if ((newValue & CAN_MCR_SOFTRST_MASK) != 0U)
+    {
+        HOST_CAN_SoftReset(can);
+        return;
+    }
+
+    /* Acknowledge bits follow the requested mode at once */
+    mcr &= ~(CAN_MCR_LPMACK_MASK | CAN_MCR_FRZACK_MASK | CAN_MCR_NOTRDY_MASK);
+    if ((mcr & CAN_MCR_MDIS_MASK) != 0U)
+    {
+        mcr |= CAN_MCR_LPMACK_MASK | CAN_MCR_NOTRDY_MASK;
+    }
+    else if (((mcr & CAN_MCR_FRZ_MASK) != 0U) && ((mcr & CAN_MCR_HALT_MASK) != 0U))
+    {
+        mcr |= CAN_MCR_FRZACK_MASK | CAN_MCR_NOTRDY_MASK;
+    }
+    else
+    {
+        /* Running */
+    }
+
+    if (((oldValue & CAN_MCR_RFEN_MASK) != 0U) && ((mcr & CAN_MCR_RFEN_MASK) == 0U))
+    {
+        can->fifoCount = 0U;
+    }
+
+    HOST_CAN_REG(can, MCR) = mcr;
+}
+
+static void HOST_CAN_WriteCs(host_can_t *can, uint32_t mb, uint32_t newValue)
+{
+    uint32_t code = (newValue & CAN_CS_CODE_MASK) >> CAN_CS_CODE_SHIFT;
+    uint32_t bit = 1UL << mb;
+
+    can->serviced &= ~bit;
+    if (code == HOST_CAN_CODE_TX_DATA)
+    {
+        can->pending |= bit;
+    }
+    else if ((code == HOST_CAN_CODE_TX_ABORT) && ((can->pending & bit) != 0U))
+    {
+        /* A successful abort is reported through the MB flag */
+        can->pending &= ~bit;
+        HOST_CAN_SetFlags(can, bit);
+    }
+    else
+    {
+        can->pending &= ~bit;
+    }
+}
+
+static void HOST_CAN_Read(uint32_t addr)
+{
+    host_can_t *can = HOST_CAN_FromAddr(addr);
+    uint32_t offset = (addr & 0xFFCU);
+
+    /* The error bits are cleared once read: the hook runs before the access,
+     * so the bits of the previous read are cleared and those of this one kept */
+    HOST_CAN_REG(can, ESR1) &= ~can->esr1Read;
+    can->esr1Read = 0U;
+    if (offset == offsetof(CAN_Type, ESR1))
+    {
+        can->esr1Read = HOST_CAN_REG(can, ESR1) & HOST_CAN_ESR1_COR;
+    }
+
+    /* Reading the C/S word services a full Rx MB (a write clears it again) */
+    if ((offset >= HOST_CAN_RAM_OFFSET) && (offset < (HOST_CAN_RAM_OFFSET + HOST_CAN_RAM_SIZE)))
+    {
+        int32_t mb = HOST_CAN_MbFromCsAddr(can, addr & ~3U);
+
+        if (mb >= 0)
+        {
+            can->serviced |= 1UL << (uint32_t)mb;
+        }
+    }
+}
+
+static void HOST_CAN_Write(uint32_t addr, uint32_t oldValue, uint32_t newValue)
+{
+    host_can_t *can = HOST_CAN_FromAddr(addr);
+    uint32_t offset = (addr & 0xFFCU);
+
+    if (offset == offsetof(CAN_Type, MCR))
+    {
+        HOST_CAN_WriteMcr(can, oldValue, newValue);
+    }
+    else if (offset == offsetof(CAN_Type, IFLAG1))
+    {
+        uint32_t cleared = oldValue & newValue;
+
+        HOST_CAN_REG(can, IFLAG1) = oldValue & ~newValue;
+        if (((cleared & HOST_CAN_FIFO_AVAILABLE) != 0U) &&
+            ((HOST_CAN_REG(can, MCR) & (CAN_MCR_RFEN_MASK | CAN_MCR_DMA_MASK)) == CAN_MCR_RFEN_MASK))
+        {
+            /* Clearing the frame available flag moves the FIFO forward */
+            HOST_CAN_PopFifo(can);
+        }
+    }
+    else if (offset == offsetof(CAN_Type, ESR1))
+    {
+        HOST_CAN_REG(can, ESR1) = oldValue & ~(newValue & HOST_CAN_ESR1_W1C);
+    }
+    else if ((offset == offsetof(CAN_Type, ESR2)) || (offset == offsetof(CAN_Type, RXFIR)) ||
+             (offset == offsetof(CAN_Type, CRCR)))
+    {
+        /* Read-only */
+        *HOST_Reg32(addr) = oldValue;
+    }
+    else if ((offset >= HOST_CAN_RAM_OFFSET) && (offset < (HOST_CAN_RAM_OFFSET + HOST_CAN_RAM_SIZE)))
+    {
+        int32_t mb = HOST_CAN_MbFromCsAddr(can, addr & ~3U);
+
+        if ((mb >= 0) && ((uint32_t)mb >= HOST_CAN_FirstMb(can)))
+        {
+            HOST_CAN_WriteCs(can, (uint32_t)mb, newValue);
+        }
+    }
+    else
+    {
+        /* Plain register */
+    }
+
+    HOST_CAN_UpdateLines(can);
+}
+
+static bool HOST_CAN_IdleStep(void)
+{
+    bool progress = false;
+    uint32_t i;
+
+    if (!s_autoTransmit)
+    {
+        return false;
+    }
+
+    /* One frame per module and step, so the handlers run between frames */
+    for (i = 0U; i < HOST_CAN_COUNT; i++)
+    {
+        if (HOST_CAN_TransmitNext(i))
+        {
+            progress = true;
+        }
+    }
+
+    return progress;
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+void HOST_CAN_Reset(void)
+{
+    static const uint32_t bases[HOST_CAN_COUNT] = CAN_BASE_ADDRS;
+    static const IRQn_Type mbIrqLow[HOST_CAN_COUNT] = CAN_ORed_0_15_MB_IRQS;
+    static const IRQn_Type mbIrqHigh[HOST_CAN_COUNT] = CAN_ORed_16_31_MB_IRQS;
+    static const IRQn_Type oredIrq[HOST_CAN_COUNT] = CAN_Bus_Off_IRQS;
+    static const IRQn_Type errorIrq[HOST_CAN_COUNT] = CAN_Error_IRQS;
+    uint32_t i;
+
+    memset(s_can, 0, sizeof(s_can));
+    s_autoTransmit = true;
+    s_txHook = NULL;
+
+    for (i = 0U; i < HOST_CAN_COUNT; i++)
+    {
+        host_can_t *can = &s_can[i];
+
+        can->base = bases[i];
+        can->mbIrqLow = mbIrqLow[i];
+        can->mbIrqHigh = mbIrqHigh[i];
+        can->oredIrq = oredIrq[i];
+        can->errorIrq = errorIrq[i];
+
+        HOST_CAN_REG(can, MCR) = HOST_CAN_MCR_RESET;
+        HOST_CAN_REG(can, RXMGMASK) = 0xFFFFFFFFU;
+        HOST_CAN_REG(can, RX14MASK) = 0xFFFFFFFFU;
+        HOST_CAN_REG(can, RX15MASK) = 0xFFFFFFFFU;
+        HOST_CAN_REG(can, RXFGMASK) = 0xFFFFFFFFU;
+
+        HOST_AttachModel(can->base, HOST_CAN_Read, HOST_CAN_Write);
+    }
+
+    HOST_AddIdleHook(HOST_CAN_IdleStep);
+}
+
+void HOST_CAN_Connect(uint32_t instance, bool connected)
+{
+    s_can[instance].connected = connected;
+}
+
+void HOST_CAN_SetAutoTransmit(bool enable)
+{
+    s_autoTransmit = enable;
+}
+
+uint32_t HOST_CAN_PendingCount(uint32_t instance)
+{
+    return (uint32_t)__builtin_popcount(s_can[instance].pending);
+}
+
+void HOST_CAN_Inject(uint32_t instance, const host_can_frame_t *frame)
+{
+    host_can_t *can = &s_can[instance];
+    uint32_t bits = HOST_CAN_FrameBits(frame);
+
+    HOST_CAN_REG(can, TIMER) = (HOST_CAN_REG(can, TIMER) + bits) & 0xFFFFU;
+    HOST_CAN_Receive(can, frame, (uint16_t)HOST_CAN_REG(can, TIMER));
+    HOST_DispatchIrqs();
+}
+
+uint32_t HOST_CAN_TxCount(uint32_t instance)
+{
+    return s_can[instance].txCount;
+}
+
+bool HOST_CAN_GetTx(uint32_t instance, uint32_t index, host_can_frame_t *frame)
+{
+    const host_can_t *can = &s_can[instance];
+
+    if ((index >= can->txCount) || ((can->txCount - index) > HOST_CAN_LOG_SIZE))
+    {
+        return false;
+    }
+    *frame = can->log[index % HOST_CAN_LOG_SIZE];
+
+    return true;
+}
+
+void HOST_CAN_SetTxHook(host_can_tx_hook_t hook)
+{
+    s_txHook = hook;
+}
+
+void HOST_CAN_SetErrorFlags(uint32_t instance, uint32_t flags)
+{
+    host_can_t *can = &s_can[instance];
+
+    HOST_CAN_REG(can, ESR1) = (HOST_CAN_REG(can, ESR1) & ~can->esr1Read) | flags;
+    can->esr1Read = 0U;
+    HOST_CAN_UpdateLines(can);
+    HOST_DispatchIrqs();
+}
+
+void HOST_CAN_SetErrorCounters(uint32_t instance, uint8_t txErrors, uint8_t rxErrors, bool busOff)
+{
+    host_can_t *can = &s_can[instance];
+    uint32_t esr1 = HOST_CAN_REG(can, ESR1);
+    uint32_t fltConf = 0U;
+
+    if (busOff)
+    {
+        fltConf = HOST_CAN_FLTCONF_BUS_OFF;
+        if (((esr1 & CAN_ESR1_FLTCONF_MASK) >> CAN_ESR1_FLTCONF_SHIFT) < HOST_CAN_FLTCONF_BUS_OFF)
+        {
+            esr1 |= CAN_ESR1_BOFFINT_MASK;
+        }
+    }
+    else if ((txErrors >= 128U) || (rxErrors >= 128U))
+    {
+        fltConf = HOST_CAN_FLTCONF_PASSIVE;
+    }
+    else
+    {
+        /* Error-active */
+    }
+
+    HOST_CAN_REG(can, ECR) = CAN_ECR_TXERRCNT(txErrors) | CAN_ECR_RXERRCNT(rxErrors);
+    HOST_CAN_REG(can, ESR1) = (esr1 & ~CAN_ESR1_FLTCONF_MASK) | CAN_ESR1_FLTCONF(fltConf);
+    HOST_CAN_UpdateLines(can);
+    HOST_DispatchIrqs();
+}
+
+bool HOST_CAN_RecoverBusOff(uint32_t instance)
+{
+    host_can_t *can = &s_can[instance];
+    uint32_t esr1 = HOST_CAN_REG(can, ESR1);
+
+    if ((((esr1 & CAN_ESR1_FLTCONF_MASK) >> CAN_ESR1_FLTCONF_SHIFT) < HOST_CAN_FLTCONF_BUS_OFF) ||
+        ((HOST_CAN_REG(can, CTRL1) & CAN_CTRL1_BOFFREC_MASK) != 0U))
+    {
+        return false;
+    }
+
+    HOST_CAN_REG(can, ECR) = 0U;
+    HOST_CAN_REG(can, ESR1) = (esr1 & ~CAN_ESR1_FLTCONF_MASK) | CAN_ESR1_BOFFDONEINT_MASK;
+    HOST_CAN_UpdateLines(can);
+    HOST_DispatchIrqs();
+
+    return true;
+}
+
+uint32_t HOST_CAN_FifoCount(uint32_t instance)
+{
+    return s_can[instance].fifoCount;
+}
+
+bool HOST_CAN_FifoDmaRequest(uint32_t instance)
+{
+    const host_can_t *can = &s_can[instance];
+
+    return ((HOST_CAN_REG(can, MCR) & (CAN_MCR_RFEN_MASK | CAN_MCR_DMA_MASK)) ==
+            (CAN_MCR_RFEN_MASK | CAN_MCR_DMA_MASK)) && (can->fifoCount > 0U);
+}
+
+void HOST_CAN_FifoDmaAck(uint32_t instance)
+{
+    HOST_CAN_PopFifo(&s_can[instance]);
+    HOST_CAN_UpdateLines(&s_can[instance]);
+}
+
+uint32_t HOST_CAN_FifoOutputAddr(uint32_t instance)
+{
+    return s_can[instance].base + HOST_CAN_RAM_OFFSET;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOST_CAN_H
+#define HOST_CAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*!
+ * @file host_can.h
+ *
+ * @brief Model of the FlexCAN modules and of the bus between them.
+ *
+ * The model implements the module mode handshakes, the message buffer codes
+ * (Tx pending, abort, Rx empty/full/overrun), the Rx FIFO with format A
+ * filters, the write-1-to-clear flags, the clear-on-read error bits, the fault
+ * confinement state and its bus-off recovery, and the interrupt lines. A frame is
+ * transmitted when the hardware is given time (HOST_Idle) or explicitly with
+ * HOST_CAN_TransmitNext: the pending MB that wins the arbitration is sent,
+ * logged, and received by the other modules connected to the bus (by the
+ * module itself in loopback mode). The free running timer advances by the
+ * length of every frame on the bus, in nominal bit times.
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Number of transmitted frames kept in the log of each module */
+#define HOST_CAN_LOG_SIZE   (1024U)
+
+/*! @brief Depth of the Rx FIFO */
+#define HOST_CAN_FIFO_DEPTH (6U)
+
+/*! @brief A frame on the bus */
+typedef struct {
+    uint32_t id;           /*!< Standard or extended identifier */
+    bool extended;         /*!< Extended identifier */
+    bool remote;           /*!< Remote frame */
+    bool fd;               /*!< CAN FD frame */
+    bool brs;              /*!< Bit rate switch */
+    uint8_t length;        /*!< Payload length in bytes */
+    uint8_t data[64];      /*!< Payload */
+    uint16_t timestamp;    /*!< Free running timer at the end of the frame */
+    uint8_t mb;            /*!< Transmitting message buffer */
+} host_can_frame_t;
+
+/*! @brief Observer of the transmitted frames */
+typedef void (*host_can_tx_hook_t)(uint32_t instance, const host_can_frame_t *frame);
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*! @brief Puts the modules in their reset state; called by HOST_Init */
+void HOST_CAN_Reset(void);
+
+/*! @brief Connects a module to the bus shared by the connected modules */
+void HOST_CAN_Connect(uint32_t instance, bool connected);
+
+/*! @brief Enables the transmission of the pending frames from HOST_Idle (default) */
+void HOST_CAN_SetAutoTransmit(bool enable);
+
+/*! @brief Transmits the pending frame that wins the arbitration; false if none */
+bool HOST_CAN_TransmitNext(uint32_t instance);
+
+/*! @brief Number of pending Tx message buffers */
+uint32_t HOST_CAN_PendingCount(uint32_t instance);
+
+/*! @brief Delivers a frame sent by another node on the bus */
+void HOST_CAN_Inject(uint32_t instance, const host_can_frame_t *frame);
+
+/*! @brief Number of frames transmitted since the reset */
+uint32_t HOST_CAN_TxCount(uint32_t instance);
+
+/*! @brief Returns a logged Tx frame; false once it left the log */
+bool HOST_CAN_GetTx(uint32_t instance, uint32_t index, host_can_frame_t *frame);
+
+/*! @brief Installs an observer of the transmitted frames */
+void HOST_CAN_SetTxHook(host_can_tx_hook_t hook);
+
+/*! @brief Raises error and status flags in ESR1 */
+void HOST_CAN_SetErrorFlags(uint32_t instance, uint32_t flags);
+
+/*! @brief Sets the error counters and the fault confinement state they lead
+ * to: error-passive from 128, bus-off if busOff. Entering bus-off raises
+ * BOFFINT. */
+void HOST_CAN_SetErrorCounters(uint32_t instance, uint8_t txErrors, uint8_t rxErrors, bool busOff);
+
+/*! @brief Ends a bus-off whose recovery is enabled (BOFFREC clear): the node
+ * is error-active again with cleared counters and BOFFDONEINT is raised.
+ * Returns false if the node is not in bus-off or held there. */
+bool HOST_CAN_RecoverBusOff(uint32_t instance);
+
+/*! @brief Number of frames waiting in the Rx FIFO, the output included */
+uint32_t HOST_CAN_FifoCount(uint32_t instance);
+
+/*! @brief Rx FIFO DMA request: DMA mode and a frame in the output */
+bool HOST_CAN_FifoDmaRequest(uint32_t instance);
+
+/*! @brief Acknowledges the read of the Rx FIFO output by the eDMA */
+void HOST_CAN_FifoDmaAck(uint32_t instance);
+
+/*! @brief Base address of the Rx FIFO output, the eDMA request source */
+uint32_t HOST_CAN_FifoOutputAddr(uint32_t instance);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* HOST_CAN_H */
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
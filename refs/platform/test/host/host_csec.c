@@ -0,0 +1,555 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host.h"
+#include "host_csec.h"
+#include "swcrypto_driver.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define HOST_CSEC_FSTAT             (*HOST_BusPtr(FTFC_BASE + (uint32_t)offsetof(FTFC_Type, FSTAT)))
+#define HOST_CSEC_FCNFG             (*HOST_BusPtr(FTFC_BASE + (uint32_t)offsetof(FTFC_Type, FCNFG)))
+#define HOST_CSEC_FSTAT_W1C         (FTFC_FSTAT_RDCOLERR_MASK | FTFC_FSTAT_ACCERR_MASK | FTFC_FSTAT_FPVIOL_MASK)
+
+/* Command IDs and formats, as written in the header by the driver */
+#define HOST_CSEC_CMD_ENC_ECB       (0x1U)
+#define HOST_CSEC_CMD_ENC_CBC       (0x2U)
+#define HOST_CSEC_CMD_DEC_ECB       (0x3U)
+#define HOST_CSEC_CMD_DEC_CBC       (0x4U)
+#define HOST_CSEC_CMD_GENERATE_MAC  (0x5U)
+#define HOST_CSEC_CMD_VERIFY_MAC    (0x6U)
+#define HOST_CSEC_CMD_LOAD_PLAIN_KEY (0x8U)
+#define HOST_CSEC_CMD_INIT_RNG      (0xAU)
+#define HOST_CSEC_CMD_EXTEND_SEED   (0xBU)
+#define HOST_CSEC_CMD_RND           (0xCU)
+#define HOST_CSEC_FORMAT_ADDR       (0x1U)
+#define HOST_CSEC_SEQ_SUBSEQUENT    (0x1U)
+
+/* Error bits, see csec_hw_access.h */
+#define HOST_CSEC_NO_ERROR          (0x1U)
+#define HOST_CSEC_SEQUENCE_ERROR    (0x2U)
+#define HOST_CSEC_KEY_INVALID       (0x8U)
+#define HOST_CSEC_KEY_EMPTY         (0x10U)
+#define HOST_CSEC_RNG_SEED          (0x100U)
+#define HOST_CSEC_GENERAL_ERROR     (0x800U)
+
+#define HOST_CSEC_PAGE_SIZE         (16U)
+#define HOST_CSEC_DATA_SIZE         (112U)
+#define HOST_CSEC_PAGE_1            (0x10U)
+#define HOST_CSEC_PAGE_2            (0x20U)
+#define HOST_CSEC_ERROR_BITS        (0x4U)
+#define HOST_CSEC_MAC_LENGTH        (0x8U)
+#define HOST_CSEC_MESSAGE_LENGTH    (0xCU)
+#define HOST_CSEC_PAGE_LENGTH       (0xEU)
+#define HOST_CSEC_FLASH_START       (0x10U)
+#define HOST_CSEC_VERIF_STATUS      (0x14U)
+
+/* The CBC pages of the first call follow the IV */
+#define HOST_CSEC_CBC_FIRST_PAGES   (6U)
+#define HOST_CSEC_DATA_PAGES        (7U)
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static swcrypto_state_t s_crypto;
+static bool s_autoRun = true;
+static bool s_busy = false;
+
+/* Open call sequence of the copy method: command, remaining bytes and, for the
+ * MACs, the message gathered so far */
+static uint8_t s_seqCmd = 0U;
+static uint32_t s_seqLeft = 0U;
+static uint8_t s_chain[HOST_CSEC_PAGE_SIZE];
+static uint8_t s_message[HOST_CSEC_MAC_MAX_SIZE];
+static uint32_t s_messageLen = 0U;
+static uint32_t s_messageBits = 0U;
+static bool s_macPending = false;
+
+static bool s_rngSeeded = false;
+static uint64_t s_rng = 0U;
+
+static uint8_t s_log[HOST_CSEC_LOG_SIZE];
+static uint32_t s_commandCount = 0U;
+
+/*******************************************************************************
+ * CSE_PRAM
+ ******************************************************************************/
+
+/* Byte 0 of a CSE_PRAM word is its most significant byte */
+static uint8_t HOST_CSEC_GetByte(uint32_t offset)
+{
+    return (uint8_t)(*HOST_Reg32(CSE_PRAM_BASE + offset) >> (24U - ((offset & 3U) * 8U)));
+}
+
+static void HOST_CSEC_SetByte(uint32_t offset, uint8_t byte)
+{
+    volatile uint32_t *word = HOST_Reg32(CSE_PRAM_BASE + offset);
+    uint32_t shift = 24U - ((offset & 3U) * 8U);
+
+    *word = (*word & ~(0xFFUL << shift)) | ((uint32_t)byte << shift);
+}
+
+static void HOST_CSEC_GetBytes(uint32_t offset, uint8_t *bytes, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        bytes[i] = HOST_CSEC_GetByte(offset + i);
+    }
+}
+
+static void HOST_CSEC_SetBytes(uint32_t offset, const uint8_t *bytes, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        HOST_CSEC_SetByte(offset + i, bytes[i]);
+    }
+}
+
+static uint16_t HOST_CSEC_GetHalfWord(uint32_t offset)
+{
+    return (uint16_t)(((uint32_t)HOST_CSEC_GetByte(offset) << 8U) | HOST_CSEC_GetByte(offset + 1U));
+}
+
+static void HOST_CSEC_SetHalfWord(uint32_t offset, uint16_t halfWord)
+{
+    HOST_CSEC_SetByte(offset, (uint8_t)(halfWord >> 8U));
+    HOST_CSEC_SetByte(offset + 1U, (uint8_t)halfWord);
+}
+
+/*******************************************************************************
+ * Commands
+ ******************************************************************************/
+
+static uint16_t HOST_CSEC_ErrorBits(status_t stat)
+{
+    return (stat == STATUS_SUCCESS) ? HOST_CSEC_NO_ERROR :
+           (stat == STATUS_SEC_KEY_EMPTY) ? HOST_CSEC_KEY_EMPTY : HOST_CSEC_GENERAL_ERROR;
+}
+
+static uint16_t HOST_CSEC_RunECB(uint8_t cmd, uint8_t keyId)
+{
+    uint8_t data[HOST_CSEC_DATA_SIZE];
+    uint32_t pages = HOST_CSEC_GetHalfWord(HOST_CSEC_PAGE_LENGTH);
+    status_t stat;
+
+    if ((pages == 0U) || (pages > HOST_CSEC_DATA_PAGES))
+    {
+        return HOST_CSEC_GENERAL_ERROR;
+    }
+
+    HOST_CSEC_GetBytes(HOST_CSEC_PAGE_1, data, pages * HOST_CSEC_PAGE_SIZE);
+    stat = (cmd == HOST_CSEC_CMD_ENC_ECB) ?
+           SWCRYPTO_DRV_EncryptECB(keyId, data, pages * HOST_CSEC_PAGE_SIZE, data) :
+           SWCRYPTO_DRV_DecryptECB(keyId, data, pages * HOST_CSEC_PAGE_SIZE, data);
+    if (stat == STATUS_SUCCESS)
+    {
+        HOST_CSEC_SetBytes(HOST_CSEC_PAGE_1, data, pages * HOST_CSEC_PAGE_SIZE);
+    }
+
+    return HOST_CSEC_ErrorBits(stat);
+}
+
+/* The first call carries the IV in page 1 and the text from page 2, the
+ * following ones the text from page 1; the page length is the total one */
+static uint16_t HOST_CSEC_RunCBC(uint8_t cmd, uint8_t keyId, bool first)
+{
+    uint8_t data[HOST_CSEC_DATA_SIZE];
+    uint8_t lastInput[HOST_CSEC_PAGE_SIZE];
+    uint32_t offset = first ? HOST_CSEC_PAGE_2 : HOST_CSEC_PAGE_1;
+    uint32_t maxBytes = (first ? HOST_CSEC_CBC_FIRST_PAGES : HOST_CSEC_DATA_PAGES) * HOST_CSEC_PAGE_SIZE;
+    uint32_t numBytes;
+    status_t stat;
+
+    if (first)
+    {
+        s_seqLeft = (uint32_t)HOST_CSEC_GetHalfWord(HOST_CSEC_PAGE_LENGTH) * HOST_CSEC_PAGE_SIZE;
+        HOST_CSEC_GetBytes(HOST_CSEC_PAGE_1, s_chain, HOST_CSEC_PAGE_SIZE);
+    }
+    if (s_seqLeft == 0U)
+    {
+        return HOST_CSEC_GENERAL_ERROR;
+    }
+
+    numBytes = (s_seqLeft > maxBytes) ? maxBytes : s_seqLeft;
+    HOST_CSEC_GetBytes(offset, data, numBytes);
+    memcpy(lastInput, &data[numBytes - HOST_CSEC_PAGE_SIZE], HOST_CSEC_PAGE_SIZE);
+
+    if (cmd == HOST_CSEC_CMD_ENC_CBC)
+    {
+        stat = SWCRYPTO_DRV_EncryptCBC(keyId, data, numBytes, s_chain, data);
+        memcpy(s_chain, &data[numBytes - HOST_CSEC_PAGE_SIZE], HOST_CSEC_PAGE_SIZE);
+    }
+    else
+    {
+        stat = SWCRYPTO_DRV_DecryptCBC(keyId, data, numBytes, s_chain, data);
+        memcpy(s_chain, lastInput, HOST_CSEC_PAGE_SIZE);
+    }
+    if (stat != STATUS_SUCCESS)
+    {
+        return HOST_CSEC_ErrorBits(stat);
+    }
+
+    HOST_CSEC_SetBytes(offset, data, numBytes);
+    s_seqLeft -= numBytes;
+    if (s_seqLeft > 0U)
+    {
+        s_seqCmd = cmd;
+    }
+
+    return HOST_CSEC_NO_ERROR;
+}
+
+/* The message is gathered up to its length; the MAC to be verified follows the
+ * last bytes, at the next page, if there is room left, or comes alone in page 1
+ * of the next call */
+static uint16_t HOST_CSEC_RunMAC(uint8_t cmd, uint8_t keyId, bool first)
+{
+    uint8_t mac[HOST_CSEC_PAGE_SIZE];
+    uint32_t numBytes;
+    uint32_t macOffset;
+    bool verified = false;
+    status_t stat;
+
+    if (first)
+    {
+        s_messageBits = *HOST_Reg32(CSE_PRAM_BASE + HOST_CSEC_MESSAGE_LENGTH);
+        s_messageLen = 0U;
+        s_seqLeft = (s_messageBits + 7U) >> 3U;
+        s_macPending = false;
+        if (s_seqLeft > HOST_CSEC_MAC_MAX_SIZE)
+        {
+            fprintf(stderr, "host: CSEc MAC messages over %u bytes are not modelled\n", (unsigned)HOST_CSEC_MAC_MAX_SIZE);
+            abort();
+        }
+    }
+
+    if (s_macPending)
+    {
+        /* Only the MAC to be verified is left */
+        macOffset = HOST_CSEC_PAGE_1;
+    }
+    else
+    {
+        numBytes = (s_seqLeft > HOST_CSEC_DATA_SIZE) ? HOST_CSEC_DATA_SIZE : s_seqLeft;
+        HOST_CSEC_GetBytes(HOST_CSEC_PAGE_1, &s_message[s_messageLen], numBytes);
+        s_messageLen += numBytes;
+        s_seqLeft -= numBytes;
+        macOffset = HOST_CSEC_PAGE_1 + ((numBytes + HOST_CSEC_PAGE_SIZE - 1U) & ~(HOST_CSEC_PAGE_SIZE - 1U));
+
+        if (s_seqLeft > 0U)
+        {
+            s_seqCmd = cmd;
+            return HOST_CSEC_NO_ERROR;
+        }
+        if ((cmd == HOST_CSEC_CMD_VERIFY_MAC) &&
+            ((macOffset - HOST_CSEC_PAGE_1 + HOST_CSEC_PAGE_SIZE) >= HOST_CSEC_DATA_SIZE))
+        {
+            s_macPending = true;
+            s_seqCmd = cmd;
+            return HOST_CSEC_NO_ERROR;
+        }
+    }
+
+    if (cmd == HOST_CSEC_CMD_GENERATE_MAC)
+    {
+        stat = SWCRYPTO_DRV_GenerateMAC(keyId, s_message, s_messageBits, mac);
+        if (stat == STATUS_SUCCESS)
+        {
+            HOST_CSEC_SetBytes(HOST_CSEC_PAGE_2, mac, HOST_CSEC_PAGE_SIZE);
+        }
+    }
+    else
+    {
+        HOST_CSEC_GetBytes(macOffset, mac, HOST_CSEC_PAGE_SIZE);
+        stat = SWCRYPTO_DRV_VerifyMAC(keyId, s_message, s_messageBits, mac,
+                                      HOST_CSEC_GetHalfWord(HOST_CSEC_MAC_LENGTH), &verified);
+        if (stat == STATUS_SUCCESS)
+        {
+            HOST_CSEC_SetHalfWord(HOST_CSEC_VERIF_STATUS, verified ? 0U : 1U);
+        }
+    }
+    s_macPending = false;
+
+    return HOST_CSEC_ErrorBits(stat);
+}
+
+/* The pointer method reads the message where it is, in a single call */
+static uint16_t HOST_CSEC_RunAddrModeMAC(uint8_t cmd, uint8_t keyId)
+{
+    const uint8_t *msg = (const uint8_t *)(uintptr_t)*HOST_Reg32(CSE_PRAM_BASE + HOST_CSEC_FLASH_START);
+    uint32_t msgBits = *HOST_Reg32(CSE_PRAM_BASE + HOST_CSEC_MESSAGE_LENGTH);
+    uint8_t mac[HOST_CSEC_PAGE_SIZE];
+    bool verified = false;
+    status_t stat;
+
+    if (cmd == HOST_CSEC_CMD_GENERATE_MAC)
+    {
+        stat = SWCRYPTO_DRV_GenerateMAC(keyId, msg, msgBits, mac);
+        if (stat == STATUS_SUCCESS)
+        {
+            HOST_CSEC_SetBytes(HOST_CSEC_PAGE_2, mac, HOST_CSEC_PAGE_SIZE);
+        }
+    }
+    else
+    {
+        HOST_CSEC_GetBytes(HOST_CSEC_PAGE_2, mac, HOST_CSEC_PAGE_SIZE);
+        stat = SWCRYPTO_DRV_VerifyMAC(keyId, msg, msgBits, mac, HOST_CSEC_GetHalfWord(HOST_CSEC_MAC_LENGTH), &verified);
+        if (stat == STATUS_SUCCESS)
+        {
+            HOST_CSEC_SetHalfWord(HOST_CSEC_VERIF_STATUS, verified ? 0U : 1U);
+        }
+    }
+
+    return HOST_CSEC_ErrorBits(stat);
+}
+
+/* A reproducible stand-in for the TRNG seeded PRNG */
+static uint16_t HOST_CSEC_RunRND(void)
+{
+    uint32_t i;
+
+    if (!s_rngSeeded)
+    {
+        return HOST_CSEC_RNG_SEED;
+    }
+
+    for (i = 0U; i < HOST_CSEC_PAGE_SIZE; i++)
+    {
+        s_rng ^= s_rng << 13U;
+        s_rng ^= s_rng >> 7U;
+        s_rng ^= s_rng << 17U;
+        HOST_CSEC_SetByte(HOST_CSEC_PAGE_1 + i, (uint8_t)(s_rng >> 32U));
+    }
+
+    return HOST_CSEC_NO_ERROR;
+}
+
+static uint16_t HOST_CSEC_Run(uint32_t header)
+{
+    uint8_t cmd = (uint8_t)(header >> 24U);
+    uint8_t format = (uint8_t)(header >> 16U);
+    bool first = ((uint8_t)(header >> 8U) != HOST_CSEC_SEQ_SUBSEQUENT);
+    uint8_t keyId = (uint8_t)header;
+    uint8_t key[HOST_CSEC_PAGE_SIZE];
+    uint8_t seqCmd = s_seqCmd;
+    uint32_t i;
+
+    /* A command closes the open sequence, unless it continues it */
+    s_seqCmd = 0U;
+    if (first && (seqCmd != 0U))
+    {
+        return HOST_CSEC_SEQUENCE_ERROR;
+    }
+    if ((!first) && (seqCmd != cmd))
+    {
+        return HOST_CSEC_SEQUENCE_ERROR;
+    }
+    if (keyId >= SWCRYPTO_KEY_SLOTS)
+    {
+        return HOST_CSEC_KEY_INVALID;
+    }
+
+    switch (cmd)
+    {
+    case HOST_CSEC_CMD_ENC_ECB:
+    case HOST_CSEC_CMD_DEC_ECB:
+        return HOST_CSEC_RunECB(cmd, keyId);
+    case HOST_CSEC_CMD_ENC_CBC:
+    case HOST_CSEC_CMD_DEC_CBC:
+        return HOST_CSEC_RunCBC(cmd, keyId, first);
+    case HOST_CSEC_CMD_GENERATE_MAC:
+    case HOST_CSEC_CMD_VERIFY_MAC:
+        return (format == HOST_CSEC_FORMAT_ADDR) ? HOST_CSEC_RunAddrModeMAC(cmd, keyId) :
+                                                   HOST_CSEC_RunMAC(cmd, keyId, first);
+    case HOST_CSEC_CMD_LOAD_PLAIN_KEY:
+        HOST_CSEC_GetBytes(HOST_CSEC_PAGE_1, key, HOST_CSEC_PAGE_SIZE);
+        SWCRYPTO_DRV_LoadKey(SWCRYPTO_RAM_KEY, key);
+        return HOST_CSEC_NO_ERROR;
+    case HOST_CSEC_CMD_INIT_RNG:
+        s_rngSeeded = true;
+        s_rng = 0x9E3779B97F4A7C15ULL;
+        return HOST_CSEC_NO_ERROR;
+    case HOST_CSEC_CMD_EXTEND_SEED:
+        if (!s_rngSeeded)
+        {
+            return HOST_CSEC_RNG_SEED;
+        }
+        for (i = 0U; i < HOST_CSEC_PAGE_SIZE; i++)
+        {
+            s_rng = (s_rng * 0x100000001B3ULL) ^ HOST_CSEC_GetByte(HOST_CSEC_PAGE_1 + i);
+        }
+        s_rng |= 1U;
+        return HOST_CSEC_NO_ERROR;
+    case HOST_CSEC_CMD_RND:
+        return HOST_CSEC_RunRND();
+    default:
+        return HOST_CSEC_GENERAL_ERROR;
+    }
+}
+
+/*******************************************************************************
+ * Register model
+ ******************************************************************************/
+
+static void HOST_CSEC_UpdateLine(void)
+{
+    HOST_SetIrqLine(FTFC_IRQn, ((HOST_CSEC_FSTAT & FTFC_FSTAT_CCIF_MASK) != 0U) &&
+                               ((HOST_CSEC_FCNFG & FTFC_FCNFG_CCIE_MASK) != 0U));
+}
+
+static void HOST_CSEC_PramWrite(uint32_t addr, uint32_t oldValue, uint32_t newValue)
+{
+    (void)oldValue;
+
+    if ((addr & ~3U) != CSE_PRAM_BASE)
+    {
+        return;
+    }
+
+    /* The header starts the command */
+    if (s_busy)
+    {
+        fprintf(stderr, "host: CSEc command 0x%08x written while another one runs\n", (unsigned)newValue);
+        abort();
+    }
+    s_busy = true;
+    s_log[s_commandCount % HOST_CSEC_LOG_SIZE] = (uint8_t)(newValue >> 24U);
+    s_commandCount++;
+
+    HOST_CSEC_FSTAT &= (uint8_t)~FTFC_FSTAT_CCIF_MASK;
+    HOST_CSEC_UpdateLine();
+}
+
+/* The CPU polling CCIF waits for the command to complete */
+static void HOST_CSEC_FtfcRead(uint32_t addr)
+{
+    if ((addr == (FTFC_BASE + (uint32_t)offsetof(FTFC_Type, FSTAT))) && s_busy)
+    {
+        (void)HOST_CSEC_CompleteCommand();
+    }
+}
+
+static void HOST_CSEC_FtfcWrite(uint32_t addr, uint32_t oldValue, uint32_t newValue)
+{
+    uint8_t written = (uint8_t)newValue;
+
+    if (addr == (FTFC_BASE + (uint32_t)offsetof(FTFC_Type, FSTAT)))
+    {
+        /* Flash commands are not modelled: CCIF is only driven by the CSEc */
+        HOST_CSEC_FSTAT = (uint8_t)((uint8_t)oldValue & ~(written & HOST_CSEC_FSTAT_W1C));
+    }
+
+    HOST_CSEC_UpdateLine();
+}
+
+static bool HOST_CSEC_IdleStep(void)
+{
+    return s_autoRun && HOST_CSEC_CompleteCommand();
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+void HOST_CSEC_Reset(void)
+{
+    SWCRYPTO_DRV_Init(&s_crypto);
+    s_autoRun = true;
+    s_busy = false;
+    s_seqCmd = 0U;
+    s_seqLeft = 0U;
+    s_messageLen = 0U;
+    s_macPending = false;
+    s_rngSeeded = false;
+    s_rng = 0U;
+    s_commandCount = 0U;
+
+    HOST_CSEC_FSTAT = FTFC_FSTAT_CCIF_MASK;
+    HOST_CSEC_FCNFG = 0U;
+
+    HOST_AttachModel(CSE_PRAM_BASE, NULL, HOST_CSEC_PramWrite);
+    HOST_AttachModel(FTFC_BASE, HOST_CSEC_FtfcRead, HOST_CSEC_FtfcWrite);
+    HOST_AddIdleHook(HOST_CSEC_IdleStep);
+}
+
+void HOST_CSEC_SetAutoRun(bool enable)
+{
+    s_autoRun = enable;
+}
+
+bool HOST_CSEC_CompleteCommand(void)
+{
+    uint16_t errorBits;
+
+    if (!s_busy)
+    {
+        return false;
+    }
+
+    errorBits = HOST_CSEC_Run(*HOST_Reg32(CSE_PRAM_BASE));
+    if (errorBits != HOST_CSEC_NO_ERROR)
+    {
+        s_seqCmd = 0U;
+    }
+    HOST_CSEC_SetHalfWord(HOST_CSEC_ERROR_BITS, errorBits);
+
+    s_busy = false;
+    HOST_CSEC_FSTAT |= FTFC_FSTAT_CCIF_MASK;
+    HOST_CSEC_UpdateLine();
+
+    return true;
+}
+
+bool HOST_CSEC_IsBusy(void)
+{
+    return s_busy;
+}
+
+void HOST_CSEC_LoadKey(uint32_t keyId, const uint8_t *key)
+{
+    SWCRYPTO_DRV_LoadKey(keyId, key);
+}
+
+uint32_t HOST_CSEC_CommandCount(void)
+{
+    return s_commandCount;
+}
+
+uint8_t HOST_CSEC_GetCommand(uint32_t index)
+{
+    if ((index >= s_commandCount) || ((s_commandCount - index) > HOST_CSEC_LOG_SIZE))
+    {
+        return 0U;
+    }
+
+    return s_log[index % HOST_CSEC_LOG_SIZE];
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
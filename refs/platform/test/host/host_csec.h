@@ -0,0 +1,92 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOST_CSEC_H
+#define HOST_CSEC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*!
+ * @file host_csec.h
+ *
+ * @brief Model of the CSEc, seen through CSE_PRAM and the FTFC.
+ *
+ * Writing the command header to CSE_PRAM starts a command: CCIF drops until
+ * the command completes, and the FTFC interrupt line is raised while CCIF and
+ * CCIE are both set. A command completes when the hardware is given time
+ * (HOST_Idle), when the CPU polls FSTAT, or explicitly with
+ * HOST_CSEC_CompleteCommand; it then reads its inputs from CSE_PRAM and writes
+ * its results and error bits back.
+ *
+ * The commands modelled are ENC/DEC_ECB, ENC/DEC_CBC, GENERATE/VERIFY_MAC (copy
+ * and pointer methods), LOAD_PLAIN_KEY, INIT_RNG, EXTEND_SEED and RND, with
+ * the call sequences of the copy method: a first call while a sequence is open
+ * breaks it with a sequence error. The cipher is the software AES-128 of the
+ * swcrypto driver, whose state the model owns: the tests which use the model
+ * do not initialize that driver themselves. The random numbers are
+ * reproducible from one reset to the next.
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Number of commands kept in the log */
+#define HOST_CSEC_LOG_SIZE      (256U)
+
+/*! @brief Largest message of a MAC command using the copy method, in bytes */
+#define HOST_CSEC_MAC_MAX_SIZE  (0x10000U)
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*! @brief Puts the CSEc in its reset state, keys wiped; called by HOST_Init */
+void HOST_CSEC_Reset(void);
+
+/*! @brief Enables the completion of the commands from HOST_Idle (default) */
+void HOST_CSEC_SetAutoRun(bool enable);
+
+/*! @brief Completes the command in execution; false if the CSEc is idle */
+bool HOST_CSEC_CompleteCommand(void);
+
+/*! @brief Returns true while a command is in execution */
+bool HOST_CSEC_IsBusy(void);
+
+/*! @brief Provisions a key slot (KEY_1 to KEY_10 or the RAM key) with a plain key */
+void HOST_CSEC_LoadKey(uint32_t keyId, const uint8_t *key);
+
+/*! @brief Number of commands started since the reset */
+uint32_t HOST_CSEC_CommandCount(void);
+
+/*! @brief Returns the command ID of a logged command; 0 once it left the log */
+uint8_t HOST_CSEC_GetCommand(uint32_t index);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* HOST_CSEC_H */
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
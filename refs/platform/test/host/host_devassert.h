@@ -0,0 +1,31 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOST_DEVASSERT_H
+#define HOST_DEVASSERT_H
+
+/*
+ * DEV_ASSERT for the host tests, selected with CUSTOM_DEVASSERT. A failed
+ * check aborts the test, unless the test expects it (HOST_CHECK_ASSERT).
+ */
+
+/* Never returns, so that the compiler takes the checked conditions as facts */
+void HOST_DevAssert(const char *text, const char *file, int line) __attribute__((noreturn));
+
+#define DEV_ASSERT(x) ((x) ? (void)0 : HOST_DevAssert(#x, __FILE__, __LINE__))
+
+#endif /* HOST_DEVASSERT_H */
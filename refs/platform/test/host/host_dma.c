@@ -0,0 +1,614 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host.h"
+#include "host_can.h"
+#include "host_dma.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define HOST_DMA_TCD_OFFSET         (0x1000U)
+#define HOST_DMA_TCD_SIZE           (0x20U)
+
+#define HOST_DMA_CMD_NOP            (0x80U)
+#define HOST_DMA_CMD_ALL            (0x40U)
+
+#define HOST_DMA_CSR_ACTIVE         (0x40U)
+#define HOST_DMA_CSR_DONE           (0x80U)
+#define HOST_DMA_CSR_LINKCH_SHIFT   (8U)
+
+#define HOST_DMA_ITER_ELINK         (0x8000U)
+#define HOST_DMA_ITER_LINKCH_SHIFT  (9U)
+
+#define HOST_DMA_SOURCE_COUNT       (64U)
+
+#define HOST_DMA_REG(reg)           (*HOST_Reg32(DMA_BASE + (uint32_t)offsetof(DMA_Type, reg)))
+
+/* Transfer control descriptor, with the layout of the TCD registers */
+typedef struct {
+    uint32_t saddr;
+    int16_t soff;
+    uint16_t attr;
+    uint32_t nbytes;
+    int32_t slast;
+    uint32_t daddr;
+    int16_t doff;
+    uint16_t citer;
+    int32_t dlastSga;
+    uint16_t csr;
+    uint16_t biter;
+} host_dma_tcd_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static bool s_autoRun = true;
+static uint64_t s_sourceLevel = 0U;
+static uint32_t s_injectedErrors[HOST_DMA_CHANNELS];
+static uint32_t s_minorLoops[HOST_DMA_CHANNELS];
+
+/*******************************************************************************
+ * Channel state
+ ******************************************************************************/
+
+static host_dma_tcd_t *HOST_DMA_Tcd(uint32_t channel)
+{
+    return (host_dma_tcd_t *)(void *)HOST_BusPtr(DMA_BASE + HOST_DMA_TCD_OFFSET + (channel * HOST_DMA_TCD_SIZE));
+}
+
+static uint32_t HOST_DMA_Bit(uint32_t channel)
+{
+    return 1UL << channel;
+}
+
+static uint32_t HOST_DMA_Priority(uint32_t channel)
+{
+    const volatile uint8_t *dchpri = HOST_BusPtr(DMA_BASE + (uint32_t)offsetof(DMA_Type, DCHPRI[0]));
+
+    return dchpri[channel ^ 3U] & DMA_DCHPRI_CHPRI_MASK;
+}
+
+/* Major loop count of a CITER or BITER field */
+static uint32_t HOST_DMA_IterCount(uint16_t iter)
+{
+    return ((iter & HOST_DMA_ITER_ELINK) != 0U) ? (iter & 0x1FFU) : (iter & 0x7FFFU);
+}
+
+static void HOST_DMA_UpdateLines(void)
+{
+    uint32_t flags = HOST_DMA_REG(INT);
+    uint32_t channel;
+
+    for (channel = 0U; channel < HOST_DMA_CHANNELS; channel++)
+    {
+        HOST_SetIrqLine((IRQn_Type)((uint32_t)DMA0_IRQn + channel), (flags & HOST_DMA_Bit(channel)) != 0U);
+    }
+    HOST_SetIrqLine(DMA_Error_IRQn, (HOST_DMA_REG(ERR) & HOST_DMA_REG(EEI)) != 0U);
+}
+
+/* State of the DMAMUX request source routed to the channel */
+static bool HOST_DMA_SourceRequest(uint32_t channel)
+{
+    uint8_t chcfg = *HOST_BusPtr(DMAMUX_BASE + channel);
+    uint32_t source = chcfg & DMAMUX_CHCFG_SOURCE_MASK;
+
+    if ((chcfg & DMAMUX_CHCFG_ENBL_MASK) == 0U)
+    {
+        return false;
+    }
+
+    switch (source)
+    {
+    case EDMA_REQ_DMAMUX_ALWAYS_ENABLED0:
+    case EDMA_REQ_DMAMUX_ALWAYS_ENABLED1:
+        return true;
+    case EDMA_REQ_FLEXCAN0:
+    case EDMA_REQ_FLEXCAN1:
+    case EDMA_REQ_FLEXCAN2:
+        return HOST_CAN_FifoDmaRequest(source - (uint32_t)EDMA_REQ_FLEXCAN0);
+    default:
+        return ((s_sourceLevel >> source) & 1U) != 0U;
+    }
+}
+
+static bool HOST_DMA_HasRequest(uint32_t channel)
+{
+    const host_dma_tcd_t *tcd = HOST_DMA_Tcd(channel);
+
+    /* A channel in error is not serviced until the error is cleared */
+    if (((HOST_DMA_REG(CR) & DMA_CR_HALT_MASK) != 0U) || ((HOST_DMA_REG(ERR) & HOST_DMA_Bit(channel)) != 0U))
+    {
+        return false;
+    }
+    if ((tcd->csr & DMA_TCD_CSR_START_MASK) != 0U)
+    {
+        return true;
+    }
+
+    return ((HOST_DMA_REG(ERQ) & HOST_DMA_Bit(channel)) != 0U) && HOST_DMA_SourceRequest(channel);
+}
+
+/*******************************************************************************
+ * Transfer engine
+ ******************************************************************************/
+
+static void HOST_DMA_Error(uint32_t channel, uint32_t errors)
+{
+    *HOST_Reg32(DMA_BASE + (uint32_t)offsetof(DMA_Type, ES)) = DMA_ES_VLD_MASK | DMA_ES_ERRCHN(channel) | errors;
+    HOST_DMA_REG(ERR) |= HOST_DMA_Bit(channel);
+    if ((HOST_DMA_REG(CR) & DMA_CR_HOE_MASK) != 0U)
+    {
+        HOST_DMA_REG(CR) |= DMA_CR_HALT_MASK;
+    }
+}
+
+/* Size in bytes of a SSIZE/DSIZE code, 0 if the code is reserved */
+static uint32_t HOST_DMA_TransferSize(uint32_t code)
+{
+    static const uint32_t sizes[8] = { 1U, 2U, 4U, 0U, 16U, 32U, 0U, 0U };
+
+    return sizes[code & 7U];
+}
+
+static uint32_t HOST_DMA_Advance(uint32_t addr, int32_t offset, uint32_t modulo)
+{
+    uint32_t mask;
+
+    if (modulo == 0U)
+    {
+        return addr + (uint32_t)offset;
+    }
+    mask = (1UL << modulo) - 1U;
+
+    return (addr & ~mask) | ((addr + (uint32_t)offset) & mask);
+}
+
+/* Minor loop byte count and offset of the NBYTES field */
+static uint32_t HOST_DMA_MinorLoop(const host_dma_tcd_t *tcd, int32_t *srcOffset, int32_t *destOffset)
+{
+    uint32_t nbytes = tcd->nbytes;
+    int32_t mloff;
+
+    *srcOffset = 0;
+    *destOffset = 0;
+
+    if ((HOST_DMA_REG(CR) & DMA_CR_EMLM_MASK) == 0U)
+    {
+        return nbytes;
+    }
+    if ((nbytes & (DMA_TCD_NBYTES_MLOFFYES_SMLOE_MASK | DMA_TCD_NBYTES_MLOFFYES_DMLOE_MASK)) == 0U)
+    {
+        return nbytes & 0x3FFFFFFFU;
+    }
+
+    /* 20-bit signed offset */
+    mloff = (int32_t)((nbytes & DMA_TCD_NBYTES_MLOFFYES_MLOFF_MASK) << 2U) >> (2 + DMA_TCD_NBYTES_MLOFFYES_MLOFF_SHIFT);
+    if ((nbytes & DMA_TCD_NBYTES_MLOFFYES_SMLOE_MASK) != 0U)
+    {
+        *srcOffset = mloff;
+    }
+    if ((nbytes & DMA_TCD_NBYTES_MLOFFYES_DMLOE_MASK) != 0U)
+    {
+        *destOffset = mloff;
+    }
+
+    return nbytes & DMA_TCD_NBYTES_MLOFFYES_NBYTES_MASK;
+}
+
+/* Returns the ES bits of the configuration errors of the TCD */
+static uint32_t HOST_DMA_CheckTcd(const host_dma_tcd_t *tcd)
+{
+    uint32_t ssize = HOST_DMA_TransferSize((tcd->attr & DMA_TCD_ATTR_SSIZE_MASK) >> DMA_TCD_ATTR_SSIZE_SHIFT);
+    uint32_t dsize = HOST_DMA_TransferSize(tcd->attr & DMA_TCD_ATTR_DSIZE_MASK);
+    uint32_t unit = (ssize > dsize) ? ssize : dsize;
+    int32_t srcOffset, destOffset;
+    uint32_t nbytes = HOST_DMA_MinorLoop(tcd, &srcOffset, &destOffset);
+    uint32_t errors = 0U;
+
+    if ((ssize == 0U) || ((tcd->saddr % ssize) != 0U))
+    {
+        errors |= DMA_ES_SAE_MASK;
+    }
+    else if (((uint32_t)(int32_t)tcd->soff % ssize) != 0U)
+    {
+        errors |= DMA_ES_SOE_MASK;
+    }
+    else
+    {
+        /* Source settings are consistent */
+    }
+
+    if ((dsize == 0U) || ((tcd->daddr % dsize) != 0U))
+    {
+        errors |= DMA_ES_DAE_MASK;
+    }
+    else if (((uint32_t)(int32_t)tcd->doff % dsize) != 0U)
+    {
+        errors |= DMA_ES_DOE_MASK;
+    }
+    else
+    {
+        /* Destination settings are consistent */
+    }
+
+    if ((nbytes == 0U) || ((unit != 0U) && ((nbytes % unit) != 0U)) || (HOST_DMA_IterCount(tcd->citer) == 0U) ||
+        ((tcd->citer & HOST_DMA_ITER_ELINK) != (tcd->biter & HOST_DMA_ITER_ELINK)))
+    {
+        errors |= DMA_ES_NCE_MASK;
+    }
+
+    if (((tcd->csr & DMA_TCD_CSR_ESG_MASK) != 0U) && (((uint32_t)tcd->dlastSga & 0x1FU) != 0U))
+    {
+        errors |= DMA_ES_SGE_MASK;
+    }
+
+    return errors;
+}
+
+/* Moves one unit: reads of the source size, then writes of the destination size */
+static void HOST_DMA_MoveUnit(host_dma_tcd_t *tcd, uint32_t ssize, uint32_t dsize, uint32_t unit)
+{
+    uint32_t smod = (tcd->attr & DMA_TCD_ATTR_SMOD_MASK) >> DMA_TCD_ATTR_SMOD_SHIFT;
+    uint32_t dmod = (tcd->attr & DMA_TCD_ATTR_DMOD_MASK) >> DMA_TCD_ATTR_DMOD_SHIFT;
+    uint8_t data[32];
+    uint32_t i, j;
+
+    for (i = 0U; i < unit; i += ssize)
+    {
+        /* Bursts are read as words */
+        for (j = 0U; j < ssize; j += ((ssize > 4U) ? 4U : ssize))
+        {
+            HOST_BusRead(tcd->saddr + j, &data[i + j], (ssize > 4U) ? 4U : ssize);
+        }
+        tcd->saddr = HOST_DMA_Advance(tcd->saddr, tcd->soff, smod);
+    }
+
+    for (i = 0U; i < unit; i += dsize)
+    {
+        for (j = 0U; j < dsize; j += ((dsize > 4U) ? 4U : dsize))
+        {
+            HOST_BusWrite(tcd->daddr + j, &data[i + j], (dsize > 4U) ? 4U : dsize);
+        }
+        tcd->daddr = HOST_DMA_Advance(tcd->daddr, tcd->doff, dmod);
+    }
+}
+
+static void HOST_DMA_StartLinked(uint32_t channel)
+{
+    HOST_DMA_Tcd(channel)->csr |= DMA_TCD_CSR_START_MASK;
+}
+
+/* End of the major loop: adjustments or scatter/gather, flags and links */
+static void HOST_DMA_CompleteMajorLoop(uint32_t channel, host_dma_tcd_t *tcd)
+{
+    uint16_t csr = tcd->csr;
+
+    if ((csr & DMA_TCD_CSR_ESG_MASK) != 0U)
+    {
+        uint32_t sga = (uint32_t)tcd->dlastSga;
+        uint32_t i;
+
+        /* The next descriptor replaces the whole TCD, its DONE bit clear */
+        for (i = 0U; i < sizeof(*tcd); i += 4U)
+        {
+            HOST_BusRead(sga + i, (uint8_t *)tcd + i, 4U);
+        }
+    }
+    else
+    {
+        tcd->saddr += (uint32_t)tcd->slast;
+        tcd->daddr += (uint32_t)tcd->dlastSga;
+        tcd->citer = tcd->biter;
+        tcd->csr |= HOST_DMA_CSR_DONE;
+    }
+
+    if ((csr & DMA_TCD_CSR_INTMAJOR_MASK) != 0U)
+    {
+        HOST_DMA_REG(INT) |= HOST_DMA_Bit(channel);
+    }
+    if ((csr & DMA_TCD_CSR_DREQ_MASK) != 0U)
+    {
+        HOST_DMA_REG(ERQ) &= ~HOST_DMA_Bit(channel);
+    }
+    if ((csr & DMA_TCD_CSR_MAJORELINK_MASK) != 0U)
+    {
+        HOST_DMA_StartLinked((csr & DMA_TCD_CSR_MAJORLINKCH_MASK) >> HOST_DMA_CSR_LINKCH_SHIFT);
+    }
+}
+
+static void HOST_DMA_Service(uint32_t channel)
+{
+    host_dma_tcd_t *tcd = HOST_DMA_Tcd(channel);
+    uint32_t ssize = HOST_DMA_TransferSize((tcd->attr & DMA_TCD_ATTR_SSIZE_MASK) >> DMA_TCD_ATTR_SSIZE_SHIFT);
+    uint32_t dsize = HOST_DMA_TransferSize(tcd->attr & DMA_TCD_ATTR_DSIZE_MASK);
+    uint32_t unit = (ssize > dsize) ? ssize : dsize;
+    uint32_t errors = HOST_DMA_CheckTcd(tcd) | s_injectedErrors[channel];
+    uint16_t citer = tcd->citer;
+    bool hwRequest = ((tcd->csr & DMA_TCD_CSR_START_MASK) == 0U);
+    int32_t srcOffset, destOffset;
+    uint32_t nbytes;
+    uint32_t count;
+    uint32_t i;
+
+    s_injectedErrors[channel] = 0U;
+    if (errors != 0U)
+    {
+        HOST_DMA_Error(channel, errors);
+        return;
+    }
+
+    /* Activation clears START and DONE */
+    tcd->csr = (uint16_t)((tcd->csr & ~(DMA_TCD_CSR_START_MASK | HOST_DMA_CSR_DONE)) | HOST_DMA_CSR_ACTIVE);
+
+    nbytes = HOST_DMA_MinorLoop(tcd, &srcOffset, &destOffset);
+    for (i = 0U; i < nbytes; i += unit)
+    {
+        HOST_DMA_MoveUnit(tcd, ssize, dsize, unit);
+    }
+    s_minorLoops[channel]++;
+
+    /* The FIFO moves forward once its output was read */
+    if (hwRequest)
+    {
+        uint32_t source = *HOST_BusPtr(DMAMUX_BASE + channel) & DMAMUX_CHCFG_SOURCE_MASK;
+
+        if ((source >= (uint32_t)EDMA_REQ_FLEXCAN0) && (source <= (uint32_t)EDMA_REQ_FLEXCAN2))
+        {
+            HOST_CAN_FifoDmaAck(source - (uint32_t)EDMA_REQ_FLEXCAN0);
+        }
+    }
+
+    /* The minor loop offsets apply to the last minor loop too */
+    tcd->saddr += (uint32_t)srcOffset;
+    tcd->daddr += (uint32_t)destOffset;
+    tcd->csr &= (uint16_t)~HOST_DMA_CSR_ACTIVE;
+    count = HOST_DMA_IterCount(citer) - 1U;
+    if (count == 0U)
+    {
+        HOST_DMA_CompleteMajorLoop(channel, tcd);
+    }
+    else
+    {
+        tcd->citer = (uint16_t)((citer & ~(((citer & HOST_DMA_ITER_ELINK) != 0U) ? 0x1FFU : 0x7FFFU)) | count);
+
+        if (((tcd->csr & DMA_TCD_CSR_INTHALF_MASK) != 0U) && (count == (HOST_DMA_IterCount(tcd->biter) / 2U)))
+        {
+            HOST_DMA_REG(INT) |= HOST_DMA_Bit(channel);
+        }
+        if ((citer & HOST_DMA_ITER_ELINK) != 0U)
+        {
+            HOST_DMA_StartLinked((citer >> HOST_DMA_ITER_LINKCH_SHIFT) & 0xFU);
+        }
+    }
+}
+
+/* Channels by decreasing priority; round robin arbitration uses the channel order */
+static void HOST_DMA_ServiceOrder(uint32_t *order)
+{
+    bool roundRobin = ((HOST_DMA_REG(CR) & DMA_CR_ERCA_MASK) != 0U);
+    uint32_t i, j;
+
+    for (i = 0U; i < HOST_DMA_CHANNELS; i++)
+    {
+        order[i] = i;
+    }
+    if (roundRobin)
+    {
+        return;
+    }
+    for (i = 1U; i < HOST_DMA_CHANNELS; i++)
+    {
+        uint32_t channel = order[i];
+
+        for (j = i; (j > 0U) && (HOST_DMA_Priority(order[j - 1U]) < HOST_DMA_Priority(channel)); j--)
+        {
+            order[j] = order[j - 1U];
+        }
+        order[j] = channel;
+    }
+}
+
+/*******************************************************************************
+ * Register model
+ ******************************************************************************/
+
+/* Applies a command (CEEI to CINT) to one or all channels */
+static void HOST_DMA_Command(uint32_t offset, uint8_t value)
+{
+    uint32_t bits = ((value & HOST_DMA_CMD_ALL) != 0U) ? 0xFFFFU : HOST_DMA_Bit(value & 0xFU);
+    uint32_t channel;
+
+    if ((value & HOST_DMA_CMD_NOP) != 0U)
+    {
+        return;
+    }
+
+    switch (offset)
+    {
+    case offsetof(DMA_Type, CEEI):
+        HOST_DMA_REG(EEI) &= ~bits;
+        break;
+    case offsetof(DMA_Type, SEEI):
+        HOST_DMA_REG(EEI) |= bits;
+        break;
+    case offsetof(DMA_Type, CERQ):
+        HOST_DMA_REG(ERQ) &= ~bits;
+        break;
+    case offsetof(DMA_Type, SERQ):
+        HOST_DMA_REG(ERQ) |= bits;
+        break;
+    case offsetof(DMA_Type, CERR):
+        HOST_DMA_REG(ERR) &= ~bits;
+        if (HOST_DMA_REG(ERR) == 0U)
+        {
+            *HOST_Reg32(DMA_BASE + (uint32_t)offsetof(DMA_Type, ES)) = 0U;
+        }
+        break;
+    case offsetof(DMA_Type, CINT):
+        HOST_DMA_REG(INT) &= ~bits;
+        break;
+    default:
+        /* CDNE and SSRT act on the TCDs */
+        for (channel = 0U; channel < HOST_DMA_CHANNELS; channel++)
+        {
+            if ((bits & HOST_DMA_Bit(channel)) != 0U)
+            {
+                if (offset == offsetof(DMA_Type, CDNE))
+                {
+                    HOST_DMA_Tcd(channel)->csr &= (uint16_t)~HOST_DMA_CSR_DONE;
+                }
+                else
+                {
+                    HOST_DMA_Tcd(channel)->csr |= DMA_TCD_CSR_START_MASK;
+                }
+            }
+        }
+        break;
+    }
+}
+
+static void HOST_DMA_Write(uint32_t addr, uint32_t oldValue, uint32_t newValue)
+{
+    uint32_t offset = addr - DMA_BASE;
+    uint32_t word = offset & ~3U;
+
+    if ((word == offsetof(DMA_Type, CEEI)) || (word == offsetof(DMA_Type, CDNE)))
+    {
+        /* Write-only command bytes, read as zero */
+        HOST_DMA_Command(offset, (uint8_t)(newValue >> (8U * (offset & 3U))));
+        *HOST_Reg32(addr) = 0U;
+    }
+    else if ((word == offsetof(DMA_Type, INT)) || (word == offsetof(DMA_Type, ERR)))
+    {
+        *HOST_Reg32(addr) = oldValue & ~newValue;
+    }
+    else if ((word == offsetof(DMA_Type, ES)) || (word == offsetof(DMA_Type, HRS)))
+    {
+        /* Read-only */
+        *HOST_Reg32(addr) = oldValue;
+    }
+    else if (word == offsetof(DMA_Type, CR))
+    {
+        /* Nothing is in flight between two accesses: a cancel completes at once */
+        HOST_DMA_REG(CR) = newValue & ~(DMA_CR_CX_MASK | DMA_CR_ECX_MASK);
+    }
+    else
+    {
+        /* Plain register or TCD word */
+    }
+
+    HOST_DMA_UpdateLines();
+}
+
+static bool HOST_DMA_IdleStep(void)
+{
+    uint32_t order[HOST_DMA_CHANNELS];
+    bool progress = false;
+    uint32_t i;
+
+    if (!s_autoRun)
+    {
+        return false;
+    }
+
+    /* One minor loop per channel and step, so the handlers run in between */
+    HOST_DMA_ServiceOrder(order);
+    for (i = 0U; i < HOST_DMA_CHANNELS; i++)
+    {
+        if (HOST_DMA_ServiceNext(order[i]))
+        {
+            progress = true;
+        }
+    }
+
+    return progress;
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+void HOST_DMA_Reset(void)
+{
+    volatile uint8_t *dchpri = HOST_BusPtr(DMA_BASE + (uint32_t)offsetof(DMA_Type, DCHPRI[0]));
+    uint32_t channel;
+
+    s_autoRun = true;
+    s_sourceLevel = 0U;
+    memset(s_injectedErrors, 0, sizeof(s_injectedErrors));
+    memset(s_minorLoops, 0, sizeof(s_minorLoops));
+
+    /* Each channel has its own number as priority */
+    for (channel = 0U; channel < HOST_DMA_CHANNELS; channel++)
+    {
+        dchpri[channel ^ 3U] = (uint8_t)channel;
+    }
+
+    HOST_AttachModel(DMA_BASE, NULL, HOST_DMA_Write);
+    HOST_AddIdleHook(HOST_DMA_IdleStep);
+}
+
+void HOST_DMA_SetAutoRun(bool enable)
+{
+    s_autoRun = enable;
+}
+
+bool HOST_DMA_ServiceNext(uint32_t channel)
+{
+    if (!HOST_DMA_HasRequest(channel))
+    {
+        return false;
+    }
+
+    HOST_DMA_Service(channel);
+    HOST_DMA_UpdateLines();
+
+    return true;
+}
+
+void HOST_DMA_SetSourceRequest(uint32_t source, bool level)
+{
+    if (level)
+    {
+        s_sourceLevel |= (1ULL << source);
+    }
+    else
+    {
+        s_sourceLevel &= ~(1ULL << source);
+    }
+}
+
+void HOST_DMA_InjectError(uint32_t channel, uint32_t errors)
+{
+    s_injectedErrors[channel] = errors;
+}
+
+uint32_t HOST_DMA_MinorLoops(uint32_t channel)
+{
+    return s_minorLoops[channel];
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOST_DMA_H
+#define HOST_DMA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*!
+ * @file host_dma.h
+ *
+ * @brief Model of the eDMA and of the DMAMUX.
+ *
+ * The model implements the command registers, the write-1-to-clear flags, the
+ * TCD engine (minor loops with offsets and modulos, minor loop mapping, major
+ * loop adjustments, scatter/gather, channel linking, DREQ) and the channel
+ * and error interrupt lines. A channel is serviced when the hardware is given
+ * time (HOST_Idle) or explicitly with HOST_DMA_ServiceNext: a channel with a
+ * request (START bit, or enabled request of its DMAMUX source) runs one minor
+ * loop, the channels being visited in the fixed priority order. The sources
+ * modelled are the always enabled ones, the Rx FIFO of the FlexCAN modules and
+ * the ones raised by the tests with HOST_DMA_SetSourceRequest.
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Number of channels of the eDMA */
+#define HOST_DMA_CHANNELS   (16U)
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*! @brief Puts the eDMA and the DMAMUX in their reset state; called by HOST_Init */
+void HOST_DMA_Reset(void);
+
+/*! @brief Enables the service of the channels from HOST_Idle (default) */
+void HOST_DMA_SetAutoRun(bool enable);
+
+/*! @brief Runs one minor loop of the channel if it has a request; false if not */
+bool HOST_DMA_ServiceNext(uint32_t channel);
+
+/*! @brief Sets the level of a DMAMUX request source the model does not drive */
+void HOST_DMA_SetSourceRequest(uint32_t source, bool level);
+
+/*! @brief Makes the next minor loop of the channel fail with the ES error bits */
+void HOST_DMA_InjectError(uint32_t channel, uint32_t errors);
+
+/*! @brief Number of minor loops run by the channel since the reset */
+uint32_t HOST_DMA_MinorLoops(uint32_t channel);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* HOST_DMA_H */
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,215 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stddef.h>
+#include "host.h"
+#include "host_lpit.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define HOST_LPIT_REG(reg)          (*HOST_Reg32(LPIT0_BASE + (uint32_t)offsetof(LPIT_Type, reg)))
+#define HOST_LPIT_TMR(ch, reg)      (*HOST_Reg32(LPIT0_BASE + (uint32_t)offsetof(LPIT_Type, TMR[0].reg) + \
+                                                 ((ch) * (uint32_t)sizeof(LPIT0->TMR[0]))))
+
+/* Registers of the channels other than TMR[n] */
+#define HOST_LPIT_TMR_BASE          ((uint32_t)offsetof(LPIT_Type, TMR[0]))
+#define HOST_LPIT_TMR_SIZE          ((uint32_t)sizeof(LPIT0->TMR[0]))
+
+/*******************************************************************************
+ * Channel state
+ ******************************************************************************/
+
+static bool HOST_LPIT_IsRunning(uint32_t channel)
+{
+    return ((HOST_LPIT_REG(MCR) & LPIT_MCR_M_CEN_MASK) != 0U) &&
+           ((HOST_LPIT_TMR(channel, TCTRL) & LPIT_TMR_TCTRL_T_EN_MASK) != 0U);
+}
+
+static void HOST_LPIT_UpdateLines(void)
+{
+    uint32_t flags = HOST_LPIT_REG(MSR) & HOST_LPIT_REG(MIER);
+    uint32_t channel;
+
+    for (channel = 0U; channel < HOST_LPIT_CHANNELS; channel++)
+    {
+        HOST_SetIrqLine((IRQn_Type)((uint32_t)LPIT0_Ch0_IRQn + channel), ((flags >> channel) & 1U) != 0U);
+    }
+}
+
+/* Enables a channel: the counter starts from TVAL */
+static void HOST_LPIT_Enable(uint32_t channel)
+{
+    HOST_LPIT_TMR(channel, TCTRL) |= LPIT_TMR_TCTRL_T_EN_MASK;
+    HOST_LPIT_TMR(channel, CVAL) = HOST_LPIT_TMR(channel, TVAL);
+}
+
+/* The counters of the stopped channels keep their value */
+static void HOST_LPIT_ResetChannels(void)
+{
+    uint32_t channel;
+
+    HOST_LPIT_REG(MSR) = 0U;
+    HOST_LPIT_REG(MIER) = 0U;
+    for (channel = 0U; channel < HOST_LPIT_CHANNELS; channel++)
+    {
+        HOST_LPIT_TMR(channel, TVAL) = 0U;
+        HOST_LPIT_TMR(channel, CVAL) = 0xFFFFFFFFU;
+        HOST_LPIT_TMR(channel, TCTRL) = 0U;
+    }
+}
+
+/*******************************************************************************
+ * Register model
+ ******************************************************************************/
+
+static void HOST_LPIT_Write(uint32_t addr, uint32_t oldValue, uint32_t newValue)
+{
+    uint32_t offset = addr - LPIT0_BASE;
+    uint32_t channel;
+
+    if (offset == offsetof(LPIT_Type, MCR))
+    {
+        if ((newValue & LPIT_MCR_SW_RST_MASK) != 0U)
+        {
+            HOST_LPIT_ResetChannels();
+        }
+    }
+    else if (offset == offsetof(LPIT_Type, MSR))
+    {
+        HOST_LPIT_REG(MSR) = oldValue & ~newValue;
+    }
+    else if ((offset == offsetof(LPIT_Type, SETTEN)) || (offset == offsetof(LPIT_Type, CLRTEN)))
+    {
+        /* Write-only commands, read as zero */
+        for (channel = 0U; channel < HOST_LPIT_CHANNELS; channel++)
+        {
+            if (((newValue >> channel) & 1U) == 0U)
+            {
+                continue;
+            }
+            if (offset == offsetof(LPIT_Type, CLRTEN))
+            {
+                HOST_LPIT_TMR(channel, TCTRL) &= ~LPIT_TMR_TCTRL_T_EN_MASK;
+            }
+            else if ((HOST_LPIT_TMR(channel, TCTRL) & LPIT_TMR_TCTRL_T_EN_MASK) == 0U)
+            {
+                HOST_LPIT_Enable(channel);
+            }
+            else
+            {
+                /* Already running */
+            }
+        }
+        *HOST_Reg32(addr) = 0U;
+    }
+    else if (offset >= HOST_LPIT_TMR_BASE)
+    {
+        channel = (offset - HOST_LPIT_TMR_BASE) / HOST_LPIT_TMR_SIZE;
+        offset = (offset - HOST_LPIT_TMR_BASE) % HOST_LPIT_TMR_SIZE;
+        if (offset == offsetof(LPIT_Type, TMR[0].CVAL) - HOST_LPIT_TMR_BASE)
+        {
+            /* Read-only */
+            *HOST_Reg32(addr) = oldValue;
+        }
+        else if ((offset == offsetof(LPIT_Type, TMR[0].TCTRL) - HOST_LPIT_TMR_BASE) &&
+                 ((oldValue & LPIT_TMR_TCTRL_T_EN_MASK) == 0U) && ((newValue & LPIT_TMR_TCTRL_T_EN_MASK) != 0U))
+        {
+            HOST_LPIT_Enable(channel);
+        }
+        else
+        {
+            /* TVAL, or TCTRL without start */
+        }
+    }
+    else
+    {
+        /* VERID and PARAM are read-only, MIER is a plain register */
+        if (offset < offsetof(LPIT_Type, MCR))
+        {
+            *HOST_Reg32(addr) = oldValue;
+        }
+    }
+
+    HOST_LPIT_UpdateLines();
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+void HOST_LPIT_Reset(void)
+{
+    HOST_LPIT_REG(VERID) = 0x01000000U;
+    HOST_LPIT_REG(PARAM) = LPIT_PARAM_EXT_TRIG(4U) | LPIT_PARAM_CHANNEL(HOST_LPIT_CHANNELS);
+    HOST_LPIT_REG(MCR) = 0U;
+    HOST_LPIT_ResetChannels();
+
+    HOST_AttachModel(LPIT0_BASE, NULL, HOST_LPIT_Write);
+}
+
+void HOST_LPIT_Advance(uint32_t counts)
+{
+    uint32_t step;
+    uint32_t channel;
+
+    while (counts > 0U)
+    {
+        /* Up to the next expiry */
+        step = counts;
+        for (channel = 0U; channel < HOST_LPIT_CHANNELS; channel++)
+        {
+            if (HOST_LPIT_IsRunning(channel) && (HOST_LPIT_CountsToExpiry(channel) < step))
+            {
+                step = HOST_LPIT_CountsToExpiry(channel);
+            }
+        }
+
+        for (channel = 0U; channel < HOST_LPIT_CHANNELS; channel++)
+        {
+            if (!HOST_LPIT_IsRunning(channel))
+            {
+                continue;
+            }
+            if (HOST_LPIT_CountsToExpiry(channel) == step)
+            {
+                HOST_LPIT_TMR(channel, CVAL) = HOST_LPIT_TMR(channel, TVAL);
+                HOST_LPIT_REG(MSR) |= 1UL << channel;
+            }
+            else
+            {
+                HOST_LPIT_TMR(channel, CVAL) -= step;
+            }
+        }
+        counts -= step;
+
+        HOST_LPIT_UpdateLines();
+        HOST_DispatchIrqs();
+    }
+}
+
+uint32_t HOST_LPIT_CountsToExpiry(uint32_t channel)
+{
+    uint64_t counts = (uint64_t)HOST_LPIT_TMR(channel, CVAL) + 1U;
+
+    return (counts > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (uint32_t)counts;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
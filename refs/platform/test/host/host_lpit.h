@@ -0,0 +1,74 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HOST_LPIT_H
+#define HOST_LPIT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*!
+ * @file host_lpit.h
+ *
+ * @brief Model of the LPIT module.
+ *
+ * The model implements the timer enable commands, the write-1-to-clear
+ * interrupt flags and the interrupt lines of the channels, which all run as
+ * 32-bit periodic counters. The time does not pass by itself: the tests
+ * advance it with HOST_LPIT_Advance. A running channel counts down from its
+ * TVAL, and when it expires after TVAL + 1 counts it sets its flag and reloads
+ * TVAL, so a TVAL written while the channel runs is taken at the next expiry.
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Number of channels of the LPIT */
+#define HOST_LPIT_CHANNELS  (4U)
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*! @brief Puts the LPIT in its reset state; called by HOST_Init */
+void HOST_LPIT_Reset(void);
+
+/*!
+ * @brief Advances the time by a number of counts of the functional clock.
+ *
+ * The pending interrupts are delivered at every expiry, so the handlers run
+ * when their channel expires unless the CPU masks them.
+ */
+void HOST_LPIT_Advance(uint32_t counts);
+
+/*! @brief Number of counts until the next expiry of a running channel */
+uint32_t HOST_LPIT_CountsToExpiry(uint32_t channel);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* HOST_LPIT_H */
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stddef.h>
+#include "host.h"
+#include "interrupt_manager.h"
+
+/*
+ * Vector table of the test image: the interrupt handlers the drivers under
+ * test define, as the startup code of an application would list them.
+ */
+
+void DMA0_IRQHandler(void);
+void DMA1_IRQHandler(void);
+void DMA2_IRQHandler(void);
+void DMA3_IRQHandler(void);
+void DMA4_IRQHandler(void);
+void DMA5_IRQHandler(void);
+void DMA6_IRQHandler(void);
+void DMA7_IRQHandler(void);
+void DMA8_IRQHandler(void);
+void DMA9_IRQHandler(void);
+void DMA10_IRQHandler(void);
+void DMA11_IRQHandler(void);
+void DMA12_IRQHandler(void);
+void DMA13_IRQHandler(void);
+void DMA14_IRQHandler(void);
+void DMA15_IRQHandler(void);
+void DMA_Error_IRQHandler(void);
+void FTFC_IRQHandler(void);
+void CAN0_ORed_IRQHandler(void);
+void CAN0_Error_IRQHandler(void);
+void CAN0_Wake_Up_IRQHandler(void);
+void CAN0_ORed_0_15_MB_IRQHandler(void);
+void CAN0_ORed_16_31_MB_IRQHandler(void);
+void CAN1_ORed_IRQHandler(void);
+void CAN1_Error_IRQHandler(void);
+void CAN1_ORed_0_15_MB_IRQHandler(void);
+void CAN2_ORed_IRQHandler(void);
+void CAN2_Error_IRQHandler(void);
+void CAN2_ORed_0_15_MB_IRQHandler(void);
+
+static const struct {
+    IRQn_Type irq;
+    isr_t handler;
+} s_vectors[] = {
+    { DMA0_IRQn, DMA0_IRQHandler },
+    { DMA1_IRQn, DMA1_IRQHandler },
+    { DMA2_IRQn, DMA2_IRQHandler },
+    { DMA3_IRQn, DMA3_IRQHandler },
+    { DMA4_IRQn, DMA4_IRQHandler },
+    { DMA5_IRQn, DMA5_IRQHandler },
+    { DMA6_IRQn, DMA6_IRQHandler },
+    { DMA7_IRQn, DMA7_IRQHandler },
+    { DMA8_IRQn, DMA8_IRQHandler },
+    { DMA9_IRQn, DMA9_IRQHandler },
+    { DMA10_IRQn, DMA10_IRQHandler },
+    { DMA11_IRQn, DMA11_IRQHandler },
+    { DMA12_IRQn, DMA12_IRQHandler },
+    { DMA13_IRQn, DMA13_IRQHandler },
+    { DMA14_IRQn, DMA14_IRQHandler },
+    { DMA15_IRQn, DMA15_IRQHandler },
+    { DMA_Error_IRQn, DMA_Error_IRQHandler },
+    { FTFC_IRQn, FTFC_IRQHandler },
+    { CAN0_ORed_IRQn, CAN0_ORed_IRQHandler },
+    { CAN0_Error_IRQn, CAN0_Error_IRQHandler },
+    { CAN0_Wake_Up_IRQn, CAN0_Wake_Up_IRQHandler },
+    { CAN0_ORed_0_15_MB_IRQn, CAN0_ORed_0_15_MB_IRQHandler },
+    { CAN0_ORed_16_31_MB_IRQn, CAN0_ORed_16_31_MB_IRQHandler },
+    { CAN1_ORed_IRQn, CAN1_ORed_IRQHandler },
+    { CAN1_Error_IRQn, CAN1_Error_IRQHandler },
+    { CAN1_ORed_0_15_MB_IRQn, CAN1_ORed_0_15_MB_IRQHandler },
+    { CAN2_ORed_IRQn, CAN2_ORed_IRQHandler },
+    { CAN2_Error_IRQn, CAN2_Error_IRQHandler },
+    { CAN2_ORed_0_15_MB_IRQn, CAN2_ORed_0_15_MB_IRQHandler },
+};
+
+void HOST_InstallVectors(uint32_t *vectors)
+{
+    uint32_t i;
+
+    for (i = 0U; i < (sizeof(s_vectors) / sizeof(s_vectors[0])); i++)
+    {
+        vectors[(uint32_t)s_vectors[i].irq + 16U] = (uint32_t)(uintptr_t)s_vectors[i].handler;
+    }
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OSIF_H
+#define OSIF_H
+
+#include <stdint.h>
+#include "status.h"
+
+/*!
+ * @file osif.h
+ *
+ * @brief OS interface of the bare-metal SDK, implemented by the host stand-in:
+ * the time is virtual and advanced by the tests, and waiting on a semaphore
+ * lets the peripheral models make progress until it is posted.
+ */
+
+/*! @brief Used for blocking without a timeout */
+#define OSIF_WAIT_FOREVER 0xFFFFFFFFu
+
+/*! @brief Type for a mutex */
+typedef uint8_t mutex_t;
+
+/*! @brief Type for a semaphore */
+typedef volatile uint8_t semaphore_t;
+
+void OSIF_TimeDelay(const uint32_t delay);
+uint32_t OSIF_GetMilliseconds(void);
+status_t OSIF_MutexLock(const mutex_t * const pMutex, const uint32_t timeout);
+status_t OSIF_MutexUnlock(const mutex_t * const pMutex);
+status_t OSIF_MutexCreate(mutex_t * const pMutex);
+status_t OSIF_MutexDestroy(const mutex_t * const pMutex);
+status_t OSIF_SemaWait(semaphore_t * const pSem, const uint32_t timeout);
+status_t OSIF_SemaPost(semaphore_t * const pSem);
+status_t OSIF_SemaCreate(semaphore_t * const pSem, const uint8_t initValue);
+status_t OSIF_SemaDestroy(const semaphore_t * const pSem);
+
+#endif /* OSIF_H */
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * Benchmarks of the software AES-128: throughput of each mode over a buffer
+ * of a few CAN FD frames and over a bulk buffer, and cost of a key switch,
+ * which rebuilds the round keys.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "host.h"
+#include "swcrypto_driver.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_BULK_SIZE  4096U
+#define BENCH_BYTES      (16UL * 1024UL * 1024UL)
+
+typedef enum {
+    BENCH_ENC_ECB,
+    BENCH_DEC_ECB,
+    BENCH_ENC_CBC,
+    BENCH_DEC_CBC,
+    BENCH_CMAC
+} bench_op_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static swcrypto_state_t s_state;
+static uint8_t s_in[BENCH_BULK_SIZE];
+static uint8_t s_out[BENCH_BULK_SIZE];
+static const uint8_t s_key[16] = {
+    0x2BU, 0x7EU, 0x15U, 0x16U, 0x28U, 0xAEU, 0xD2U, 0xA6U, 0xABU, 0xF7U, 0x15U, 0x88U, 0x09U, 0xCFU, 0x4FU, 0x3CU
+};
+static const uint8_t s_iv[16];
+static const char *const s_opNames[] = { "enc ecb", "dec ecb", "enc cbc", "dec cbc", "cmac" };
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+
+static void RunOp(bench_op_t op, uint32_t keyId, uint32_t length)
+{
+    switch (op)
+    {
+        case BENCH_ENC_ECB:
+            (void)SWCRYPTO_DRV_EncryptECB(keyId, s_in, length, s_out);
+            break;
+        case BENCH_DEC_ECB:
+            (void)SWCRYPTO_DRV_DecryptECB(keyId, s_in, length, s_out);
+            break;
+        case BENCH_ENC_CBC:
+            (void)SWCRYPTO_DRV_EncryptCBC(keyId, s_in, length, s_iv, s_out);
+            break;
+        case BENCH_DEC_CBC:
+            (void)SWCRYPTO_DRV_DecryptCBC(keyId, s_in, length, s_iv, s_out);
+            break;
+        default:
+            (void)SWCRYPTO_DRV_GenerateMAC(keyId, s_in, length * 8U, s_out);
+            break;
+    }
+}
+
+/*******************************************************************************
+ * Throughput
+ ******************************************************************************/
+
+/* Throughput of an operation on buffers of the given size, with the round keys
+ * of the slot cached */
+static void BenchThroughput(bench_op_t op, uint32_t length)
+{
+    uint32_t rounds = (uint32_t)(BENCH_BYTES / length);
+    uint64_t elapsed;
+    uint64_t start;
+    uint32_t round;
+
+    RunOp(op, SWCRYPTO_RAM_KEY, length);
+    start = HOST_NowNs();
+    for (round = 0U; round < rounds; round++)
+    {
+        RunOp(op, SWCRYPTO_RAM_KEY, length);
+    }
+    elapsed = HOST_NowNs() - start;
+
+    printf("%-8s %4u bytes: %7.1f ns/call, %6.1f MB/s\n", s_opNames[op], (unsigned)length,
+           (double)elapsed / rounds, (double)length * rounds * 1000.0 / (double)elapsed);
+}
+
+/* Cost of a one block operation alternating between two slots, each call
+ * rebuilding the round keys */
+static void BenchKeySwitch(void)
+{
+    uint32_t rounds = (uint32_t)(BENCH_BYTES / SWCRYPTO_BLOCK_SIZE);
+    uint64_t elapsed;
+    uint64_t start;
+    uint32_t round;
+
+    start = HOST_NowNs();
+    for (round = 0U; round < rounds; round++)
+    {
+        RunOp(BENCH_ENC_ECB, 1U + (round & 1U), SWCRYPTO_BLOCK_SIZE);
+    }
+    elapsed = HOST_NowNs() - start;
+
+    printf("enc ecb   16 bytes, key switch: %7.1f ns/call\n", (double)elapsed / rounds);
+}
+
+/*******************************************************************************
+ * Main
+ ******************************************************************************/
+
+int main(void)
+{
+    bench_op_t op;
+    uint32_t i;
+
+    for (i = 0U; i < BENCH_BULK_SIZE; i++)
+    {
+        s_in[i] = (uint8_t)(i * 31U);
+    }
+
+    SWCRYPTO_DRV_Init(&s_state);
+    SWCRYPTO_DRV_LoadKey(SWCRYPTO_RAM_KEY, s_key);
+    SWCRYPTO_DRV_LoadKey(1U, s_key);
+    SWCRYPTO_DRV_LoadKey(2U, s_iv);
+
+    for (op = BENCH_ENC_ECB; op <= BENCH_CMAC; op++)
+    {
+        BenchThroughput(op, 64U);
+        BenchThroughput(op, BENCH_BULK_SIZE);
+    }
+    BenchKeySwitch();
+
+    SWCRYPTO_DRV_Deinit();
+
+    return 0;
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -0,0 +1,220 @@
+/*
+ * Copyright 2017 NXP
+ * All rights reserved.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NXP "AS IS" AND ANY EXPRESSED OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL NXP OR ITS CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * Tests of the software AES-128 against the NIST vectors: ECB and CBC from
+ * SP 800-38A (F.1.1, F.1.2, F.2.1, F.2.2) and CMAC from SP 800-38B (D.1).
+ */
+
+#include <string.h>
+#include "host.h"
+#include "swcrypto_driver.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define KEY_SLOT    (SWCRYPTO_RAM_KEY)
+#define OTHER_SLOT  (1U)
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static swcrypto_state_t s_state;
+
+static const uint8_t s_key[16] = {
+    0x2BU, 0x7EU, 0x15U, 0x16U, 0x28U, 0xAEU, 0xD2U, 0xA6U, 0xABU, 0xF7U, 0x15U, 0x88U, 0x09U, 0xCFU, 0x4FU, 0x3CU
+};
+static const uint8_t s_otherKey[16] = {
+    0x00U, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U, 0x07U, 0x08U, 0x09U, 0x0AU, 0x0BU, 0x0CU, 0x0DU, 0x0EU, 0x0FU
+};
+static const uint8_t s_iv[16] = {
+    0x00U, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U, 0x07U, 0x08U, 0x09U, 0x0AU, 0x0BU, 0x0CU, 0x0DU, 0x0EU, 0x0FU
+};
+static const uint8_t s_plain[64] = {
+    0x6BU, 0xC1U, 0xBEU, 0xE2U, 0x2EU, 0x40U, 0x9FU, 0x96U, 0xE9U, 0x3DU, 0x7EU, 0x11U, 0x73U, 0x93U, 0x17U, 0x2AU,
+    0xAEU, 0x2DU, 0x8AU, 0x57U, 0x1EU, 0x03U, 0xACU, 0x9CU, 0x9EU, 0xB7U, 0x6FU, 0xACU, 0x45U, 0xAFU, 0x8EU, 0x51U,
+    0x30U, 0xC8U, 0x1CU, 0x46U, 0xA3U, 0x5CU, 0xE4U, 0x11U, 0xE5U, 0xFBU, 0xC1U, 0x19U, 0x1AU, 0x0AU, 0x52U, 0xEFU,
+    0xF6U, 0x9FU, 0x24U, 0x45U, 0xDFU, 0x4FU, 0x9BU, 0x17U, 0xADU, 0x2BU, 0x41U, 0x7BU, 0xE6U, 0x6CU, 0x37U, 0x10U
+};
+static const uint8_t s_ecb[64] = {
+    0x3AU, 0xD7U, 0x7BU, 0xB4U, 0x0DU, 0x7AU, 0x36U, 0x60U, 0xA8U, 0x9EU, 0xCAU, 0xF3U, 0x24U, 0x66U, 0xEFU, 0x97U,
+    0xF5U, 0xD3U, 0xD5U, 0x85U, 0x03U, 0xB9U, 0x69U, 0x9DU, 0xE7U, 0x85U, 0x89U, 0x5AU, 0x96U, 0xFDU, 0xBAU, 0xAFU,
+    0x43U, 0xB1U, 0xCDU, 0x7FU, 0x59U, 0x8EU, 0xCEU, 0x23U, 0x88U, 0x1BU, 0x00U, 0xE3U, 0xEDU, 0x03U, 0x06U, 0x88U,
+    0x7BU, 0x0CU, 0x78U, 0x5EU, 0x27U, 0xE8U, 0xADU, 0x3FU, 0x82U, 0x23U, 0x20U, 0x71U, 0x04U, 0x72U, 0x5DU, 0xD4U
+};
+static const uint8_t s_cbc[64] = {
+    0x76U, 0x49U, 0xABU, 0xACU, 0x81U, 0x19U, 0xB2U, 0x46U, 0xCEU, 0xE9U, 0x8EU, 0x9BU, 0x12U, 0xE9U, 0x19U, 0x7DU,
+    0x50U, 0x86U, 0xCBU, 0x9BU, 0x50U, 0x72U, 0x19U, 0xEEU, 0x95U, 0xDBU, 0x11U, 0x3AU, 0x91U, 0x76U, 0x78U, 0xB2U,
+    0x73U, 0xBEU, 0xD6U, 0xB8U, 0xE3U, 0xC1U, 0x74U, 0x3BU, 0x71U, 0x16U, 0xE6U, 0x9EU, 0x22U, 0x22U, 0x95U, 0x16U,
+    0x3FU, 0xF1U, 0xCAU, 0xA1U, 0x68U, 0x1FU, 0xACU, 0x09U, 0x12U, 0x0EU, 0xCAU, 0x30U, 0x75U, 0x86U, 0xE1U, 0xA7U
+};
+
+/* CMAC of the first 0, 16, 40 and 64 bytes of the plain text */
+static const uint32_t s_cmacLengths[4] = { 0U, 16U, 40U, 64U };
+static const uint8_t s_cmac[4][16] = {
+    { 0xBBU, 0x1DU, 0x69U, 0x29U, 0xE9U, 0x59U, 0x37U, 0x28U, 0x7FU, 0xA3U, 0x7DU, 0x12U, 0x9BU, 0x75U, 0x67U, 0x46U },
+    { 0x07U, 0x0AU, 0x16U, 0xB4U, 0x6BU, 0x4DU, 0x41U, 0x44U, 0xF7U, 0x9BU, 0xDDU, 0x9DU, 0xD0U, 0x4AU, 0x28U, 0x7CU },
+    { 0xDFU, 0xA6U, 0x67U, 0x47U, 0xDEU, 0x9AU, 0xE6U, 0x30U, 0x30U, 0xCAU, 0x32U, 0x61U, 0x14U, 0x97U, 0xC8U, 0x27U },
+    { 0x51U, 0xF0U, 0xBEU, 0xBFU, 0x7EU, 0x3BU, 0x9DU, 0x92U, 0xFCU, 0x49U, 0x74U, 0x17U, 0x79U, 0x36U, 0x3CU, 0xFEU }
+};
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+
+static void StartSwcrypto(void)
+{
+    SWCRYPTO_DRV_Init(&s_state);
+    SWCRYPTO_DRV_LoadKey(KEY_SLOT, s_key);
+}
+
+/*******************************************************************************
+ * Vectors
+ ******************************************************************************/
+
+static void TestECB(void)
+{
+    uint8_t out[64];
+
+    StartSwcrypto();
+
+    HOST_CHECK_EQ(SWCRYPTO_DRV_EncryptECB(KEY_SLOT, s_plain, 64U, out), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(out, s_ecb, 64U) == 0);
+    HOST_CHECK_EQ(SWCRYPTO_DRV_DecryptECB(KEY_SLOT, s_ecb, 64U, out), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(out, s_plain, 64U) == 0);
+
+    /* In place */
+    HOST_CHECK_EQ(SWCRYPTO_DRV_EncryptECB(KEY_SLOT, out, 64U, out), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(out, s_ecb, 64U) == 0);
+    HOST_CHECK_EQ(SWCRYPTO_DRV_DecryptECB(KEY_SLOT, out, 64U, out), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(out, s_plain, 64U) == 0);
+
+    SWCRYPTO_DRV_Deinit();
+}
+
+static void TestCBC(void)
+{
+    uint8_t out[64];
+
+    StartSwcrypto();
+
+    HOST_CHECK_EQ(SWCRYPTO_DRV_EncryptCBC(KEY_SLOT, s_plain, 64U, s_iv, out), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(out, s_cbc, 64U) == 0);
+    HOST_CHECK_EQ(SWCRYPTO_DRV_DecryptCBC(KEY_SLOT, s_cbc, 64U, s_iv, out), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(out, s_plain, 64U) == 0);
+
+    /* In place, and chained over two calls through the last cipher block */
+    memcpy(out, s_plain, 64U);
+    HOST_CHECK_EQ(SWCRYPTO_DRV_EncryptCBC(KEY_SLOT, out, 32U, s_iv, out), STATUS_SUCCESS);
+    HOST_CHECK_EQ(SWCRYPTO_DRV_EncryptCBC(KEY_SLOT, &out[32], 32U, &out[16], &out[32]), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(out, s_cbc, 64U) == 0);
+    HOST_CHECK_EQ(SWCRYPTO_DRV_DecryptCBC(KEY_SLOT, out, 64U, s_iv, out), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(out, s_plain, 64U) == 0);
+
+    SWCRYPTO_DRV_Deinit();
+}
+
+static void TestCMAC(void)
+{
+    uint8_t mac[16];
+    uint8_t tampered[16];
+    bool verified;
+    uint32_t i;
+
+    StartSwcrypto();
+
+    for (i = 0U; i < 4U; i++)
+    {
+        HOST_CHECK_EQ(SWCRYPTO_DRV_GenerateMAC(KEY_SLOT, s_plain, s_cmacLengths[i] * 8U, mac), STATUS_SUCCESS);
+        HOST_CHECK(memcmp(mac, s_cmac[i], 16U) == 0);
+
+        verified = false;
+        HOST_CHECK_EQ(SWCRYPTO_DRV_VerifyMAC(KEY_SLOT, s_plain, s_cmacLengths[i] * 8U, s_cmac[i], 0U, &verified),
+                      STATUS_SUCCESS);
+        HOST_CHECK(verified);
+    }
+
+    /* A truncated MAC only compares its leading bits */
+    memcpy(tampered, s_cmac[3], 16U);
+    tampered[15] ^= 0x01U;
+    HOST_CHECK_EQ(SWCRYPTO_DRV_VerifyMAC(KEY_SLOT, s_plain, 64U * 8U, tampered, 64U, &verified), STATUS_SUCCESS);
+    HOST_CHECK(verified);
+    HOST_CHECK_EQ(SWCRYPTO_DRV_VerifyMAC(KEY_SLOT, s_plain, 64U * 8U, tampered, 0U, &verified), STATUS_SUCCESS);
+    HOST_CHECK(!verified);
+    tampered[0] ^= 0x80U;
+    HOST_CHECK_EQ(SWCRYPTO_DRV_VerifyMAC(KEY_SLOT, s_plain, 64U * 8U, tampered, 64U, &verified), STATUS_SUCCESS);
+    HOST_CHECK(!verified);
+
+    SWCRYPTO_DRV_Deinit();
+}
+
+/*******************************************************************************
+ * Key slots
+ ******************************************************************************/
+
+/* The round keys cached for a slot are not used for another one, nor after
+ * the slot is reloaded */
+static void TestKeySlots(void)
+{
+    uint8_t out[16];
+    uint8_t other[16];
+
+    StartSwcrypto();
+
+    HOST_CHECK_EQ(SWCRYPTO_DRV_EncryptECB(OTHER_SLOT, s_plain, 16U, out), STATUS_SEC_KEY_EMPTY);
+    SWCRYPTO_DRV_LoadKey(OTHER_SLOT, s_otherKey);
+
+    HOST_CHECK_EQ(SWCRYPTO_DRV_EncryptECB(OTHER_SLOT, s_plain, 16U, other), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(other, s_ecb, 16U) != 0);
+    HOST_CHECK_EQ(SWCRYPTO_DRV_EncryptECB(KEY_SLOT, s_plain, 16U, out), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(out, s_ecb, 16U) == 0);
+    HOST_CHECK_EQ(SWCRYPTO_DRV_EncryptECB(OTHER_SLOT, s_plain, 16U, out), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(out, other, 16U) == 0);
+
+    SWCRYPTO_DRV_LoadKey(OTHER_SLOT, s_key);
+    HOST_CHECK_EQ(SWCRYPTO_DRV_EncryptECB(OTHER_SLOT, s_plain, 16U, out), STATUS_SUCCESS);
+    HOST_CHECK(memcmp(out, s_ecb, 16U) == 0);
+
+    /* The keys do not survive the deinitialization */
+    SWCRYPTO_DRV_Deinit();
+    SWCRYPTO_DRV_Init(&s_state);
+    HOST_CHECK_EQ(SWCRYPTO_DRV_EncryptECB(KEY_SLOT, s_plain, 16U, out), STATUS_SEC_KEY_EMPTY);
+    HOST_CHECK_EQ(SWCRYPTO_DRV_GenerateMAC(KEY_SLOT, s_plain, 128U, out), STATUS_SEC_KEY_EMPTY);
+
+    SWCRYPTO_DRV_Deinit();
+}
+
+/*******************************************************************************
+ * Main
+ ******************************************************************************/
+
+static const host_test_t s_tests[] = {
+    { "ECB", TestECB },
+    { "CBC", TestCBC },
+    { "CMAC", TestCMAC },
+    { "KeySlots", TestKeySlots },
+};
+
+int main(void)
+{
+    return HOST_RunTests("swcrypto", s_tests, sizeof(s_tests) / sizeof(s_tests[0]));
+}
+
+/*******************************************************************************
+ * EOF
+ ******************************************************************************/
@@ -107,7 +107,28 @@ impl CAN {
         CAN { can: can }
     }
 
+    /// Sends `payload` (truncated to `MAX_MSG_LENGTH` bytes) from message buffer 0.
+    ///
+    /// The bytes are packed into big-endian words, the layout of the message buffer RAM, and
+    /// written with `transmit_words`. Missing bytes of the last word are zero.
     pub fn transmit(&self, payload: &[u8]) {
+        let mut words = [0u32; MAX_MSG_LENGTH / 4];
+
+        for (word, chunk) in words.iter_mut().zip(payload.chunks(4)) {
+            let mut bytes = [0u8; 4];
+            bytes[..chunk.len()].copy_from_slice(chunk);
+            *word = u32::from_be_bytes(bytes);
+        }
+
+        self.transmit_words(&words);
+    }
+
+    /// Sends `payload` (truncated to `MAX_MSG_LENGTH / 4` words) from message buffer 0.
+    ///
+    /// Each word is stored as-is in the message buffer, so its most significant byte is the
+    /// first one on the bus. Unlike `transmit`, no byte-granular access to the message buffer
+    /// RAM is made.
+    pub fn transmit_words(&self, payload: &[u32]) {
         unsafe {
             // Clear interrupt flag
             self.can.iflag1.write(|w| w.bits(0x1));
@@ -115,15 +136,9 @@ impl CAN {
             // Write headers?
             self.can.embedded_ram[(0 * MSG_BUF_SIZE) + 1].write(|w| w.bits(0x15540000));
 
-            // Write the payload into [u8; 4] sections
-            for i in 0..core::cmp::min(MAX_MSG_LENGTH, payload.len()) {
-                self.can.embedded_ram[2 + (i / 4)].modify(|_, w| match i % 4 {
-                    0 => w.data_byte_0().bits(payload[i]),
-                    1 => w.data_byte_1().bits(payload[i]),
-                    2 => w.data_byte_2().bits(payload[i]),
-                    3 => w.data_byte_3().bits(payload[i]),
-                    _ => unreachable!(),
-                });
+            // Write the payload, one word at a time
+            for (i, word) in payload.iter().take(MAX_MSG_LENGTH / 4).enumerate() {
+                self.can.embedded_ram[(0 * MSG_BUF_SIZE) + 2 + i].write(|w| w.bits(*word));
             }
 
             // send frame
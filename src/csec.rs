@@ -6,8 +6,10 @@
 //! A range of functions are silicon-supported, but this module currently implements
 //! * random number generation,
 //! * plainkey loading into RAM slot,
-//! * AES-CBC-128 encryption/decryption, and
-//! * MAC generation and verification.
+//! * AES-CBC-128 encryption/decryption,
+//! * MAC generation and verification,
+//! * sealing (random IV, AES-CBC-128 encryption and MAC generation in one call), and
+//! * a pool of random blocks to take initialization vectors from.
 //!
 //! Hardware used in this module is documented in the reference manual, § 35.6.13, p. 847.
 //!
@@ -85,6 +87,31 @@
 //! assert!(csec.verify_mac(&plaintext, &cmac).unwrap());
 //! ```
 //!
+//! - Sealing
+//!
+//! This module can produce the `[MAC | IV | ciphertext]` payload of a `[u8; 16]` in one call.
+//! The random bytes are left in `CSE_PRAM` where the encryption expects its initialization
+//! vector, and the ciphertext where the MAC generation expects the end of its message, so the
+//! three commands run back-to-back with only the plaintext and the initialization vector written
+//! in between.
+//! ```rust
+//! mod csec;
+//!
+//! const PLAINKEY: [u8; 16] = [
+//!     0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f,
+//!     0x3c,
+//! ];
+//!
+//! let csec = csec::CSEc::init(&p.FTFC, &p.CSE_PRAM);
+//! csec.init_rng().unwrap();
+//! csec.load_plainkey(&PLAINKEY).unwrap();
+//!
+//! let payload = csec.seal(b"Key:0123456789ab").unwrap();
+//! let mut cmac: [u8; 16] = [0; 16];
+//! cmac.clone_from_slice(&payload[..16]);
+//! assert!(csec.verify_mac(&payload[16..], &cmac).unwrap());
+//! ```
+//!
 //! ## Security
 //! During encryption the initialization vector must be random and unpredictable (for each
 //! message), and may be made public after encryption. It is then recommended to use the output of
@@ -262,6 +289,81 @@ const MAC_MESSAGE_LENGTH_OFFSET: usize = 0xc;
 const MAC_VERIFICATION_BITS_OFFSET: usize = PAGE_1_OFFSET + 0x4;
 const MAC_LENGTH_OFFSET: usize = 0x8;
 
+/// Size of a sealed payload: MAC, initialization vector and ciphertext.
+pub const SEALED_PAYLOAD_SIZE: usize = 3 * PAGE_SIZE_IN_BYTES;
+
+/// Number of random blocks kept ready by an `RngPool`.
+pub const RNG_POOL_SIZE: usize = 4;
+
+/// A pool of random blocks, so that an initialization vector can be taken without waiting on the
+/// CSEc.
+///
+/// `take` returns a block in O(1) while the pool is not empty, and falls back to `generate_rnd`
+/// otherwise. `refill_one` adds a single block, so that the pool can be topped up from the idle
+/// loop without holding the CSEc for more than one RND command; `refill` fills it up at once,
+/// e.g. during initialization.
+pub struct RngPool {
+    blocks: [[u8; PAGE_SIZE_IN_BYTES]; RNG_POOL_SIZE],
+    head: usize,
+    count: usize,
+    /// Blocks served from the pool.
+    pub hits: u32,
+    /// Requests which found the pool empty.
+    pub misses: u32,
+}
+
+impl RngPool {
+    pub const fn new() -> Self {
+        RngPool {
+            blocks: [[0; PAGE_SIZE_IN_BYTES]; RNG_POOL_SIZE],
+            head: 0,
+            count: 0,
+            hits: 0,
+            misses: 0,
+        }
+    }
+
+    /// Number of blocks ready in the pool.
+    pub fn available(&self) -> usize {
+        self.count
+    }
+
+    /// Takes a block from the pool, or generates one if the pool is empty.
+    pub fn take(&mut self, csec: &CSEc) -> Result<[u8; PAGE_SIZE_IN_BYTES], CommandResult> {
+        if self.count > 0 {
+            let block = self.blocks[self.head];
+            self.head = (self.head + 1) % RNG_POOL_SIZE;
+            self.count -= 1;
+            self.hits += 1;
+            Ok(block)
+        } else {
+            self.misses += 1;
+            csec.generate_rnd()
+        }
+    }
+
+    /// Adds a block to the pool unless it is full. Returns whether a block was added.
+    /// `CSEc::init_rng` must have been called.
+    pub fn refill_one(&mut self, csec: &CSEc) -> Result<bool, CommandResult> {
+        if self.count == RNG_POOL_SIZE {
+            return Ok(false);
+        }
+
+        let tail = (self.head + self.count) % RNG_POOL_SIZE;
+        self.blocks[tail] = csec.generate_rnd()?;
+        self.count += 1;
+
+        Ok(true)
+    }
+
+    /// Fills the pool up. `CSEc::init_rng` must have been called.
+    pub fn refill(&mut self, csec: &CSEc) -> Result<(), CommandResult> {
+        while self.refill_one(csec)? {}
+
+        Ok(())
+    }
+}
+
 impl CSEc {
     pub fn init(ftfc: s32k144::FTFC, cse_pram: s32k144::CSE_PRAM) -> Self {
         CSEc {
@@ -367,6 +469,84 @@ impl CSEc {
         Ok(cmac)
     }
 
+    /// Encrypts a 16B `plaintext` under a fresh initialization vector and authenticates the
+    /// result, returning `[MAC | IV | ciphertext]`. The MAC covers `payload[16..48]`.
+    ///
+    /// This function must be called after `init_rng` and `load_plainkey`.
+    pub fn seal(
+        &self,
+        plaintext: &[u8; PAGE_SIZE_IN_BYTES],
+    ) -> Result<[u8; SEALED_PAYLOAD_SIZE], CommandResult> {
+        let mut payload: [u8; SEALED_PAYLOAD_SIZE] = [0; SEALED_PAYLOAD_SIZE];
+
+        // The random bytes are left on page 1, where the encryption expects the initialization
+        // vector.
+        self.write_command_header(
+            Command::Rng,
+            Format::Copy,
+            Sequence::First,
+            KeyID::SecretKey,
+        )?;
+        self.read_command_bytes(PAGE_1_OFFSET, &mut payload[16..32]);
+
+        self.seal_pages(plaintext, &mut payload)?;
+        Ok(payload)
+    }
+
+    /// Same as `seal`, with an initialization vector provided by the caller, e.g. taken from an
+    /// `RngPool`.
+    pub fn seal_with_iv(
+        &self,
+        plaintext: &[u8; PAGE_SIZE_IN_BYTES],
+        init_vec: &[u8; PAGE_SIZE_IN_BYTES],
+    ) -> Result<[u8; SEALED_PAYLOAD_SIZE], CommandResult> {
+        let mut payload: [u8; SEALED_PAYLOAD_SIZE] = [0; SEALED_PAYLOAD_SIZE];
+        payload[16..32].clone_from_slice(init_vec);
+
+        self.write_command_bytes(PAGE_1_OFFSET, init_vec);
+        self.seal_pages(plaintext, &mut payload)?;
+        Ok(payload)
+    }
+
+    /// Encrypts `plaintext` under the initialization vector on page 1 (and in `payload[16..32]`),
+    /// then authenticates both, filling the rest of `payload`.
+    fn seal_pages(
+        &self,
+        plaintext: &[u8; PAGE_SIZE_IN_BYTES],
+        payload: &mut [u8; SEALED_PAYLOAD_SIZE],
+    ) -> Result<(), CommandResult> {
+        let (cmac, rest) = payload.split_at_mut(PAGE_SIZE_IN_BYTES);
+        let (init_vec, ciphertext) = rest.split_at_mut(PAGE_SIZE_IN_BYTES);
+
+        // Encrypt a single page, in place on page 2.
+        self.write_command_bytes(PAGE_2_OFFSET, plaintext);
+        self.write_command_halfword(PAGE_LENGTH_OFFSET, 1);
+        self.write_command_header(
+            Command::EncCbc,
+            Format::Copy,
+            Sequence::First,
+            KeyID::RamKey,
+        )?;
+        self.read_command_bytes(PAGE_2_OFFSET, ciphertext);
+
+        // Page 1 is only an input of the encryption, so put the initialization vector back in
+        // front of the ciphertext and authenticate both pages.
+        self.write_command_bytes(PAGE_1_OFFSET, init_vec);
+        self.write_command_words(
+            MAC_MESSAGE_LENGTH_OFFSET,
+            &[(2 * PAGE_SIZE_IN_BYTES * 8) as u32],
+        );
+        self.write_command_header(
+            Command::GenerateMac,
+            Format::Copy,
+            Sequence::First,
+            KeyID::RamKey,
+        )?;
+        self.read_command_bytes(PAGE_2_OFFSET, cmac);
+
+        Ok(())
+    }
+
     /// Verify a message against a 128-bit Message Authentication Code.
     pub fn verify_mac(&self, message: &[u8], cmac: &[u8; 16]) -> Result<bool, CommandResult> {
         // A length of 0 is interpreted by SHE to compare all bits of `mac`.
@@ -3,7 +3,8 @@
 //! This crate constitutes the embedded application of the sensor array module for the Daredevil
 //! project, acting as the EVITA *light/small* compliant module. Once every 1/8 second this application:
 //! 1. reads ultrasonic range sensor data from four ADC (analog-to-digital converter) channels;
-//! 2. randomizes a `[u8; 16]` initialization vector in preparation for AES-CBC-128 encryption;
+//! 2. takes a random `[u8; 16]` initialization vector from a pool, in preparation for AES-CBC-128
+//!    encryption (the pool is topped up from the idle loop, between two periods);
 //! 3. encrypts the sensor data for the `PLAINKEY: [u8; 16]` constant;
 //! 4. generates a MAC (message authentication code) of the initialization vector and encrypted
 //!    sensor data, and
@@ -144,7 +145,7 @@
 #![no_std]
 
 use panic_halt;
-use rtfm::{app, Instant};
+use rtfm::{app, Instant, Mutex};
 use s32k144::Interrupt;
 use s32k144evb::wdog;
 
@@ -167,6 +168,7 @@ const APP: () = {
     static mut ADC: adc::ADC = ();
     static mut CSEC: csec::CSEc = ();
     static mut CAN: can::CAN = ();
+    static mut RNG_POOL: csec::RngPool = csec::RngPool::new();
 
     #[init(schedule = [poll_sensor])]
     fn init() -> init::LateResources {
@@ -206,42 +208,35 @@ const APP: () = {
         }
     }
 
-    #[idle]
+    #[idle(resources = [CSEC, RNG_POOL])]
     fn idle() -> ! {
-        // Sleep
+        let mut csec = resources.CSEC;
+        let mut rng_pool = resources.RNG_POOL;
+
         loop {
+            // Top the initialization vector pool up, one RND command per lock, so that
+            // poll_sensor waits on at most one command.
+            csec.lock(|csec| rng_pool.lock(|rng_pool| rng_pool.refill_one(csec)))
+                .unwrap();
+
             rtfm::pend(Interrupt::DMA0);
         }
     }
 
-    #[task(resources = [ADC, CAN, CSEC], schedule = [poll_sensor])]
+    #[task(resources = [ADC, CAN, CSEC, RNG_POOL], schedule = [poll_sensor])]
     fn poll_sensor() {
         let adc = resources.ADC;
         let can = resources.CAN;
         let csec = resources.CSEC;
-
-        let mut payload: [u8;
-            16 + // message Authentication code
-            16 + // initialization vector
-            16 // encrypted sensor data
-        ] = [0; 48];
+        let rng_pool = resources.RNG_POOL;
 
         let mut sensor_bytes = [0u8; 16];
         u8_array_from_16_array(&adc.read(), &mut sensor_bytes);
 
-        // Randomize our initialization vector.
-        let init_vec = csec.generate_rnd().unwrap();
-        payload[16..32].clone_from_slice(&init_vec);
-
-        // Encrypt the sensor data.
-        let mut encrypted = [0u8; 16];
-        csec.encrypt_cbc(&sensor_bytes, &init_vec, &mut encrypted[..])
-            .unwrap();
-        payload[32..48].clone_from_slice(&encrypted);
-
-        // Generate a MAC (Message Authentication Code) for our payload
-        let cmac = csec.generate_mac(&payload[16..]).unwrap();
-        payload[..16].clone_from_slice(&cmac);
+        // Encrypt the sensor data under a random initialization vector and generate a MAC
+        // (Message Authentication Code) of both: [MAC | IV | encrypted sensor data].
+        let init_vec = rng_pool.take(csec).unwrap();
+        let payload = csec.seal_with_iv(&sensor_bytes, &init_vec).unwrap();
 
         can.transmit(&payload);
 